@@ -19,7 +19,7 @@
  */
 
 #include "key_derivation.h"
-#include "sha256.h"
+#include "../../src/common/sha256.h"
 #include "../../src/quantum_rng/quantum_rng.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -11,7 +11,7 @@
  */
 
 #include "key_exchange.h"
-#include "sha256.h"
+#include "../../src/common/sha256.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -3,7 +3,7 @@
 #include <string.h>
 #include "../../src/quantum_rng/quantum_rng.h"
 #include "quantum_chain.h"
-#include "sha256.h"
+#include "../../src/common/sha256.h"
 
 // Compute the hash of a block's contents into `out` (does not modify the
 // block). Uses real SHA-256 over exactly the bytes that are meaningful.
@@ -16,8 +16,9 @@
 #include <ctype.h>
 #include <time.h>
 #include "../../src/quantum_rng/quantum_rng.h"
+#include "../../src/quantum_rng/simd_ops.h"
 #include "secure_token.h"
-#include "sha256.h"
+#include "../../src/common/sha256.h"
 
 #define DEFAULT_TOKEN_LENGTH 32
 #define DEFAULT_EXPIRATION_TIME 3600 // 1 hour
@@ -182,9 +183,8 @@ int token_to_string(const TokenMetadata* metadata, char* str, size_t str_size) {
     if (str_size - offset < 64 * 2 + 1) {
         return -2;
     }
-    for (size_t i = 0; i < 64; i++) {
-        snprintf(str + offset + i * 2, 3, "%02x", metadata->signature[i]);
-    }
+    offset += simd_encode_hex(metadata->signature, 64, str + offset);
+    str[offset] = '\0';
 
     return 0;
 }
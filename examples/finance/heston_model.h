@@ -4,10 +4,19 @@
 #include "../../src/quantum_rng/quantum_rng.h"
 #include "options_pricing.h"
 
+#define HESTON_PATH_BLOCK 256   // Paths per block (one RNG substream each)
+
 // Function declarations
 void init_heston_params(heston_params_t *params);
 pricing_results_t run_heston_simulation(const pricing_config_t *config, const heston_params_t *heston);
 
+/*
+ * Semi-analytic Heston price of a European call or put (characteristic
+ * function integrated numerically).  Reference for the Monte Carlo
+ * schemes; NaN for other option types or sigma <= 0.
+ */
+double heston_analytic_price(const option_params_t *option, const heston_params_t *params);
+
 /*
  * Advance one Euler step of the Heston model.  Returns the new spot price
  * and updates *variance in place with the new variance level.
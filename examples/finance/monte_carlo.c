@@ -4,30 +4,31 @@
 #include <math.h>
 #include "monte_carlo.h"
 #include "../../src/quantum_rng/quantum_rng.h"
+#include "../../src/scheduler/task_pool.h"
+#include "../../src/qmc/sobol.h"
 
 /*
- * Draw a standard normal variate N(0,1) from the quantum RNG using the
- * Box-Muller transform.  Two uniforms produce two independent normals;
- * the second one is cached so consecutive calls consume one uniform each
- * on average.  The cache lives at the call site so it is always tied to
- * a single qrng context.
+ * Fill z[0..n) (n even) with standard normal variates N(0,1) from ctx.
+ *
+ * One bulk qrng_bytes call supplies n uniforms; the Box-Muller transform
+ * then turns the pair (bits[i], bits[n/2 + i]) into z[i] and z[n/2 + i].
+ * u1 is mapped to (0,1] rather than [0,1) so log() never sees 0 without a
+ * rejection loop, which keeps the loop branch-free and lets the compiler
+ * vectorize it (vector log/sin/cos under -ffast-math).
  */
-static double generate_normal(qrng_ctx *ctx, double *cache, int *has_cache) {
-    if (*has_cache) {
-        *has_cache = 0;
-        return *cache;
-    }
-
-    double u1;
-    do {
-        u1 = qrng_double(ctx);      /* qrng_double is in [0,1); reject 0 for log() */
-    } while (u1 <= 0.0);
-    double u2 = qrng_double(ctx);
-
-    double r = sqrt(-2.0 * log(u1));
-    *cache = r * sin(2.0 * M_PI * u2);
-    *has_cache = 1;
-    return r * cos(2.0 * M_PI * u2);
+static void generate_normals(qrng_ctx *ctx, uint64_t *restrict bits,
+                             double *restrict z, size_t n) {
+    qrng_bytes(ctx, (uint8_t *)bits, n * sizeof(uint64_t));
+
+    size_t half = n / 2;
+    for (size_t i = 0; i < half; i++) {
+        double u1 = (double)((bits[i] >> 11) + 1) * (1.0 / 9007199254740992.0);
+        double u2 = (double)(bits[half + i] >> 11) * (1.0 / 9007199254740992.0);
+        double r = sqrt(-2.0 * log(u1));
+        double theta = 2.0 * M_PI * u2;
+        z[i] = r * cos(theta);
+        z[half + i] = r * sin(theta);
+    }
 }
 
 /* Convert a confidence z-score (e.g. 1.96) to its nominal two-sided
@@ -49,6 +50,8 @@ void init_simulation_config(simulation_config_t *config) {
     config->show_progress = 1;
     config->seed_length = 0;
     config->confidence_level = CONFIDENCE_95;
+    config->num_threads = 0;
+    config->quasi_random = 0;
     memset(config->seed, 0, sizeof(config->seed));
     memset(config->output_file, 0, sizeof(config->output_file));
 }
@@ -76,12 +79,156 @@ void parse_simulation_args(int argc, char *argv[], simulation_config_t *config)
         } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
             strncpy(config->seed, argv[++i], sizeof(config->seed) - 1);
             config->seed_length = strlen(config->seed);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            config->num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-q") == 0) {
+            config->quasi_random = 1;
         } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
             strncpy(config->output_file, argv[++i], sizeof(config->output_file) - 1);
         }
     }
 }
 
+/*
+ * Path engine.
+ *
+ * Paths are split into blocks of MC_PATH_BLOCK. Block b draws from its own
+ * qrng substream, seeded deterministically with (master seed, b), and keeps
+ * its paths in a path-major structure-of-arrays: one log-price per path.
+ * Each time step generates the whole block's normals in bulk and advances
+ * every path with one vectorizable loop; exp() runs once per path at the
+ * end instead of once per step. Blocks run in parallel on the task pool and
+ * write per-block statistics, which are then reduced in block order. Block
+ * contents and reduction order never depend on the thread count, so the
+ * results are bit-identical at any thread count.
+ *
+ * In quasi-random mode path i is point i of a Sobol sequence with one
+ * dimension per trading day, scrambled with a key drawn from the master
+ * seed. Block b clones the sequence and skips to its first path; the
+ * normals are laid out with a Brownian bridge, so the first (best
+ * stratified) coordinate fixes the terminal price.
+ */
+
+#define MC_MASTER_SEED_SIZE 32
+
+typedef struct {
+    double sum;
+    double sum_squared;
+    double min_price;
+    double max_price;
+} mc_block_stats_t;
+
+typedef struct {
+    const simulation_config_t *config;
+    uint8_t master_seed[MC_MASTER_SEED_SIZE];
+    double drift;
+    double vol;
+    size_t num_blocks;
+    double *prices;
+    mc_block_stats_t *block_stats;
+    const sobol_ctx_t *sobol;        // Quasi-random mode: sequence at index 0
+    const sobol_bridge_t *bridge;
+    size_t blocks_done;   // Progress (atomic)
+    int failed;           // A substream failed to initialize (atomic)
+} mc_job_t;
+
+/* Quasi-random log-prices of paths [first, first + count). Returns 0 on success. */
+static int run_sobol_block(const mc_job_t *job, size_t first, size_t count,
+                           double *log_price) {
+    int days = job->config->trading_days;
+    sobol_ctx_t *seq;
+    if (sobol_clone(job->sobol, &seq) != SOBOL_SUCCESS) return -1;
+
+    double *z = malloc(2 * (size_t)days * sizeof(double));
+    if (!z || sobol_skip_to(seq, first) != SOBOL_SUCCESS) {
+        free(z);
+        sobol_free(seq);
+        return -1;
+    }
+    double *dw = z + days;
+
+    for (size_t i = 0; i < count; i++) {
+        sobol_next_normal(seq, z);
+        sobol_bridge_transform(job->bridge, z, dw);
+        double w = 0.0;
+        for (int t = 0; t < days; t++) w += dw[t];
+        log_price[i] = job->drift * days + job->vol * w;
+    }
+
+    free(z);
+    sobol_free(seq);
+    return 0;
+}
+
+static void run_path_block(mc_job_t *job, size_t block) {
+    const simulation_config_t *config = job->config;
+    size_t first = block * MC_PATH_BLOCK;
+    size_t count = (size_t)config->num_simulations - first;
+    if (count > MC_PATH_BLOCK) count = MC_PATH_BLOCK;
+    size_t draws = (count + 1) & ~(size_t)1;  // Box-Muller makes pairs
+
+    // Substream seed: master seed followed by the block index
+    uint8_t seed[MC_MASTER_SEED_SIZE + 8];
+    memcpy(seed, job->master_seed, MC_MASTER_SEED_SIZE);
+    for (int i = 0; i < 8; i++) {
+        seed[MC_MASTER_SEED_SIZE + i] = (uint8_t)((uint64_t)block >> (8 * i));
+    }
+
+    double log_price[MC_PATH_BLOCK] = {0};
+    double drift = job->drift;
+    double vol = job->vol;
+
+    if (job->sobol) {
+        if (run_sobol_block(job, first, count, log_price) != 0) {
+            __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } else {
+        qrng_ctx *ctx;
+        if (qrng_init(&ctx, seed, sizeof(seed)) != QRNG_SUCCESS) {
+            __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+            return;
+        }
+
+        uint64_t bits[MC_PATH_BLOCK];
+        double z[MC_PATH_BLOCK];
+        for (int t = 0; t < config->trading_days; t++) {
+            // Geometric Brownian motion requires standard normal variates;
+            // a raw uniform would bias the drift upward.
+            generate_normals(ctx, bits, z, draws);
+            for (size_t i = 0; i < count; i++) {
+                log_price[i] += drift + vol * z[i];
+            }
+        }
+        qrng_free(ctx);
+    }
+
+    mc_block_stats_t stats = { 0.0, 0.0, INFINITY, -INFINITY };
+    double *prices = job->prices + first;
+    for (size_t i = 0; i < count; i++) {
+        double price = config->asset.initial_price * exp(log_price[i]);
+        prices[i] = price;
+        stats.sum += price;
+        stats.sum_squared += price * price;
+        if (price < stats.min_price) stats.min_price = price;
+        if (price > stats.max_price) stats.max_price = price;
+    }
+    job->block_stats[block] = stats;
+
+    if (config->show_progress) {
+        size_t done = __atomic_add_fetch(&job->blocks_done, 1, __ATOMIC_RELAXED);
+        if (done * 100 / job->num_blocks != (done - 1) * 100 / job->num_blocks) {
+            fprintf(stderr, "\rProgress: %zu%%", done * 100 / job->num_blocks);
+        }
+    }
+}
+
+static void run_path_blocks(void *arg, size_t begin, size_t end) {
+    for (size_t block = begin; block < end; block++) {
+        run_path_block((mc_job_t *)arg, block);
+    }
+}
+
 simulation_results_t run_simulation(const simulation_config_t *config) {
     simulation_results_t results = {0};
     
@@ -92,15 +239,23 @@ simulation_results_t run_simulation(const simulation_config_t *config) {
         config->trading_days < 1 ||
         config->asset.initial_price <= 0.0 ||
         config->asset.volatility < 0.0 ||
-        config->confidence_level <= 0.0) {
+        config->confidence_level <= 0.0 ||
+        config->num_threads < 0 ||
+        (config->quasi_random && config->trading_days > SOBOL_MAX_DIMENSION)) {
         results.prices = NULL;
         return results;
     }
 
-    // Initialize QRNG.  Pass NULL when no seed was provided: qrng_init
-    // indexes the seed with (i % seed_len) whenever the pointer is
-    // non-NULL, so a non-NULL pointer with seed_len == 0 would crash
-    // with a division by zero.
+    mc_job_t job = {0};
+    job.config = config;
+    job.num_blocks = ((size_t)config->num_simulations + MC_PATH_BLOCK - 1) / MC_PATH_BLOCK;
+
+    // Master seed. With a seed string every substream, and so the whole
+    // result, is a function of that string. Without one the master seed
+    // comes from an unseeded (hardware/runtime entropy) qrng context.
+    // Pass NULL when no seed was provided: qrng_init indexes the seed
+    // with (i % seed_len) whenever the pointer is non-NULL, so a non-NULL
+    // pointer with seed_len == 0 would crash with a division by zero.
     qrng_ctx *ctx;
     qrng_error err = qrng_init(&ctx,
                               config->seed_length > 0 ? (uint8_t*)config->seed : NULL,
@@ -109,56 +264,87 @@ simulation_results_t run_simulation(const simulation_config_t *config) {
         results.prices = NULL;
         return results;
     }
+    qrng_bytes(ctx, job.master_seed, sizeof(job.master_seed));
+    qrng_free(ctx);
+
+    // Quasi-random mode: the scrambling key is the master seed
+    sobol_ctx_t *sobol = NULL;
+    sobol_bridge_t *bridge = NULL;
+    if (config->quasi_random &&
+        (sobol_init(&sobol, (uint32_t)config->trading_days,
+                    job.master_seed, sizeof(job.master_seed)) != SOBOL_SUCCESS ||
+         sobol_bridge_init(&bridge, (uint32_t)config->trading_days) != SOBOL_SUCCESS)) {
+        sobol_free(sobol);
+        results.prices = NULL;
+        return results;
+    }
+    job.sobol = sobol;
+    job.bridge = bridge;
     
-    // Allocate memory for price paths
+    // Allocate memory for price paths and per-block statistics
     results.prices = malloc(config->num_simulations * sizeof(double));
-    if (!results.prices) {
-        qrng_free(ctx);
+    job.block_stats = malloc(job.num_blocks * sizeof(mc_block_stats_t));
+    if (!results.prices || !job.block_stats) {
+        free(results.prices);
+        free(job.block_stats);
+        sobol_free(sobol);
+        sobol_bridge_free(bridge);
+        results.prices = NULL;
         return results;
     }
+    job.prices = results.prices;
     
-    // Run simulations
+    // Per-step log-price increment of risk-neutral GBM
     double dt = 1.0 / config->trading_days;
-    double drift = (config->asset.risk_free_rate - 
-                   config->asset.dividend_yield - 
-                   0.5 * config->asset.volatility * config->asset.volatility) * dt;
-    double vol = config->asset.volatility * sqrt(dt);
-    
-    double sum = 0.0;
-    double sum_squared = 0.0;
-    results.min_price = INFINITY;
-    results.max_price = -INFINITY;
-
-    double normal_cache = 0.0;
-    int has_normal_cache = 0;
-    int progress_step = config->num_simulations / 100;
-    if (progress_step < 1) progress_step = 1;
-
-    for (int i = 0; i < config->num_simulations; i++) {
-        double price = config->asset.initial_price;
+    job.drift = (config->asset.risk_free_rate - 
+                 config->asset.dividend_yield - 
+                 0.5 * config->asset.volatility * config->asset.volatility) * dt;
+    job.vol = config->asset.volatility * sqrt(dt);
 
-        for (int t = 0; t < config->trading_days; t++) {
-            // Geometric Brownian motion requires a standard normal
-            // variate; a raw uniform would bias the drift upward.
-            double z = generate_normal(ctx, &normal_cache, &has_normal_cache);
-            price *= exp(drift + vol * z);
-        }
-
-        results.prices[i] = price;
-        sum += price;
-        sum_squared += price * price;
-
-        if (price < results.min_price) results.min_price = price;
-        if (price > results.max_price) results.max_price = price;
-
-        if (config->show_progress && i % progress_step == 0) {
-            fprintf(stderr, "\rProgress: %d%%", i * 100 / config->num_simulations);
+    // Run the blocks: inline, on a private pool of num_threads, or on the
+    // shared task pool
+    if (config->num_threads == 1) {
+        run_path_blocks(&job, 0, job.num_blocks);
+    } else {
+        task_pool_t *pool = NULL;
+        if (config->num_threads > 1) {
+            task_pool_config_t pool_config;
+            task_pool_get_default_config(&pool_config);
+            pool_config.num_threads = (size_t)config->num_threads;
+            pool_config.affinity = TASK_POOL_AFFINITY_NONE;
+            if (task_pool_create(&pool, &pool_config) != TASK_POOL_SUCCESS) {
+                pool = NULL;  // Fall back to the shared pool
+            }
         }
+        task_pool_parallel_for(pool, job.num_blocks, 1, run_path_blocks, &job);
+        if (pool) task_pool_free(pool);
     }
 
     if (config->show_progress) {
         fprintf(stderr, "\rProgress: 100%%\n");
     }
+    sobol_free(sobol);
+    sobol_bridge_free(bridge);
+
+    if (job.failed) {
+        free(job.block_stats);
+        free(results.prices);
+        results.prices = NULL;
+        return results;
+    }
+
+    // Reduce block statistics in block order (independent of thread count)
+    double sum = 0.0;
+    double sum_squared = 0.0;
+    results.min_price = INFINITY;
+    results.max_price = -INFINITY;
+    for (size_t b = 0; b < job.num_blocks; b++) {
+        sum += job.block_stats[b].sum;
+        sum_squared += job.block_stats[b].sum_squared;
+        if (job.block_stats[b].min_price < results.min_price) results.min_price = job.block_stats[b].min_price;
+        if (job.block_stats[b].max_price > results.max_price) results.max_price = job.block_stats[b].max_price;
+    }
+    free(job.block_stats);
 
     // Calculate statistics
     results.mean_price = sum / config->num_simulations;
@@ -171,7 +357,6 @@ simulation_results_t run_simulation(const simulation_config_t *config) {
     results.confidence_lower = results.mean_price - margin;
     results.confidence_upper = results.mean_price + margin;
     
-    qrng_free(ctx);
     return results;
 }
 
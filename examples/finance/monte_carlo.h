@@ -9,6 +9,10 @@
 #define MAX_SIMULATIONS 10000000
 #define DEFAULT_TRADING_DAYS 252  // Standard trading days in a year
 
+// Path engine: paths are simulated in fixed blocks, each drawing from its own
+// RNG substream, so results do not depend on how blocks map to threads
+#define MC_PATH_BLOCK 256
+
 // Default asset parameters
 #define DEFAULT_INITIAL_PRICE 100.0
 #define DEFAULT_VOLATILITY 0.2     // 20% annual volatility
@@ -47,6 +51,8 @@ typedef struct {
     int show_progress;
     char output_file[1024];
     double confidence_level;
+    int num_threads;  // 0 = shared task pool, 1 = calling thread only, N = N threads
+    int quasi_random; // Drive paths with a scrambled Sobol sequence (one dimension per day)
 } simulation_config_t;
 
 // Simulation results
@@ -7,7 +7,8 @@
  * monte_carlo.h:
  *
  *   init_simulation_config()   - fill a config with sensible defaults
- *   run_simulation()           - geometric Brownian motion over trading days
+ *   run_simulation()           - geometric Brownian motion over trading days,
+ *                                in parallel blocks of paths
  *   print_results() / output_results_json() / output_results_csv()
  *
  * The simulator evolves the underlying under the risk-neutral measure, so the
@@ -25,6 +26,7 @@
 #include <getopt.h>
 
 #include "monte_carlo.h"
+#include "../../src/qmc/sobol.h"
 
 static void usage(const char *prog) {
     printf(
@@ -41,10 +43,15 @@ static void usage(const char *prog) {
 "  -y <yield>    Continuous dividend yield               (default %.2f)\n"
 "  -o <mode>     Output: normal, json or csv             (default normal)\n"
 "  -s <seed>     Seed string for the RNG (omit for hardware entropy)\n"
+"  -t <threads>  Worker threads: 0 = shared pool, 1 = none (default 0);\n"
+"                results with -s are identical at any thread count\n"
+"  -q            Quasi-random paths: scrambled Sobol sequence with a\n"
+"                Brownian bridge (at most %d trading days)\n"
 "  -h            Show this help and exit\n",
         prog,
         DEFAULT_NUM_SIMULATIONS, DEFAULT_TRADING_DAYS, DEFAULT_INITIAL_PRICE,
-        DEFAULT_VOLATILITY, DEFAULT_RISK_FREE_RATE, DEFAULT_DIVIDEND_YIELD);
+        DEFAULT_VOLATILITY, DEFAULT_RISK_FREE_RATE, DEFAULT_DIVIDEND_YIELD,
+        SOBOL_MAX_DIMENSION);
 }
 
 /* Map an output-mode name to the enum; returns -1 on an unknown name. */
@@ -61,7 +68,7 @@ int main(int argc, char *argv[]) {
     init_simulation_config(&config);
 
     int opt;
-    while ((opt = getopt(argc, argv, "n:d:p:v:r:y:o:s:h")) != -1) {
+    while ((opt = getopt(argc, argv, "n:d:p:v:r:y:o:s:t:qh")) != -1) {
         switch (opt) {
             case 'n': config.num_simulations = atoi(optarg); break;
             case 'd': config.trading_days = atoi(optarg); break;
@@ -81,6 +88,8 @@ int main(int argc, char *argv[]) {
                 config.seed[sizeof(config.seed) - 1] = '\0';
                 config.seed_length = (int)strlen(config.seed);
                 break;
+            case 't': config.num_threads = atoi(optarg); break;
+            case 'q': config.quasi_random = 1; break;
             case 'h': usage(argv[0]); return 0;
             default:  usage(argv[0]); return 1;
         }
@@ -105,6 +114,15 @@ int main(int argc, char *argv[]) {
         fprintf(stderr, "Error: volatility (-v) must be non-negative.\n");
         return 1;
     }
+    if (config.num_threads < 0) {
+        fprintf(stderr, "Error: threads (-t) must be non-negative.\n");
+        return 1;
+    }
+    if (config.quasi_random && config.trading_days > SOBOL_MAX_DIMENSION) {
+        fprintf(stderr, "Error: quasi-random mode (-q) supports at most %d trading days.\n",
+                SOBOL_MAX_DIMENSION);
+        return 1;
+    }
 
     /* The progress bar goes to stderr, but keep it off for machine output. */
     if (config.output_mode == OUTPUT_JSON || config.output_mode == OUTPUT_CSV) {
@@ -2,31 +2,57 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
+#include <time.h>
 #include "options_pricing.h"
 #include "heston_model.h"
 #include "../../src/quantum_rng/quantum_rng.h"
+#include "../../src/qmc/sobol.h"
 
 /*
- * Draw a standard normal variate N(0,1) using the Box-Muller transform.
- * Two uniforms produce two independent normals; the second is cached so
- * consecutive calls consume one uniform each on average.
+ * Fill z[0..n) (n even) with standard normal variates N(0,1) from ctx.
+ *
+ * One bulk qrng_bytes call supplies n uniforms; the Box-Muller transform
+ * then turns the pair (bits[i], bits[n/2 + i]) into z[i] and z[n/2 + i].
+ * u1 is mapped to (0,1] so log() never sees 0 without a rejection loop,
+ * which keeps the loop branch-free and vectorizable.
  */
-static double generate_normal(qrng_ctx *ctx, double *cache, int *has_cache) {
-    if (*has_cache) {
-        *has_cache = 0;
-        return *cache;
-    }
-
-    double u1;
-    do {
-        u1 = qrng_double(ctx);   /* qrng_double is in [0,1); reject 0 for log() */
-    } while (u1 <= 0.0);
-    double u2 = qrng_double(ctx);
-
-    double r = sqrt(-2.0 * log(u1));
-    *cache = r * sin(2.0 * M_PI * u2);
-    *has_cache = 1;
-    return r * cos(2.0 * M_PI * u2);
+static void generate_normals(qrng_ctx *ctx, uint64_t *restrict bits,
+                             double *restrict z, size_t n) {
+    qrng_bytes(ctx, (uint8_t *)bits, n * sizeof(uint64_t));
+
+    size_t half = n / 2;
+    for (size_t i = 0; i < half; i++) {
+        double u1 = (double)((bits[i] >> 11) + 1) * (1.0 / 9007199254740992.0);
+        double u2 = (double)(bits[half + i] >> 11) * (1.0 / 9007199254740992.0);
+        double r = sqrt(-2.0 * log(u1));
+        double theta = 2.0 * M_PI * u2;
+        z[i] = r * cos(theta);
+        z[half + i] = r * sin(theta);
+    }
+}
+
+/*
+ * Moment matching: shift and scale z[0..n) so its sample mean is exactly 0
+ * and its sample variance exactly 1.  Removes the first two moments of the
+ * sampling error in each time step of a batch.
+ */
+static void moment_match(double *z, int n) {
+    double mean = 0.0;
+    for (int i = 0; i < n; i++) mean += z[i];
+    mean /= n;
+
+    double sq = 0.0;
+    for (int i = 0; i < n; i++) sq += (z[i] - mean) * (z[i] - mean);
+    double scale = sq > 0.0 ? 1.0 / sqrt(sq / n) : 1.0;
+
+    for (int i = 0; i < n; i++) z[i] = (z[i] - mean) * scale;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
 }
 
 // Standard normal cumulative distribution function
@@ -153,50 +179,154 @@ double calculate_payoff(double spot, double strike, option_type_t type) {
     }
 }
 
-static void simulate_path(double *path, int steps, const pricing_config_t *config,
-                          qrng_ctx *ctx, double *cache, int *has_cache) {
-    double dt = config->option.time_to_maturity / steps;
-    double drift = (config->option.risk_free_rate - config->option.dividend_yield
-                   - 0.5 * config->option.volatility * config->option.volatility) * dt;
-    double vol_sqrt_dt = config->option.volatility * sqrt(dt);
-
-    path[0] = config->option.spot_price;
-    for (int i = 1; i <= steps; i++) {
-        double z = generate_normal(ctx, cache, has_cache);
-        path[i] = path[i-1] * exp(drift + vol_sqrt_dt * z);
+/*
+ * Per-run constants of the batched GBM kernel.
+ */
+typedef struct {
+    int steps;
+    int flags;              // VR_* techniques in effect
+    int path_dependent;     // Needs S at every step (exotics or show_paths)
+    option_type_t type;
+    option_type_t control_type;  // European payoff used as control variate
+    double spot;
+    double strike;
+    double drift;           // (r - q - sigma^2/2) dt
+    double vol_sqrt_dt;
+    double discount;
+} pricing_kernel_t;
+
+// European call or put with the same direction as type, used as control.
+static option_type_t control_option_type(option_type_t type) {
+    switch (type) {
+        case OPTION_PUT:
+        case OPTION_BINARY_PUT:
+        case OPTION_ASIAN_PUT:
+        case OPTION_LOOKBACK_PUT:
+            return OPTION_PUT;
+        default:
+            return OPTION_CALL;
     }
 }
 
 /*
- * Payoff for a full simulated path.  Vanilla and binary payoffs only need
- * the terminal price; Asian payoffs use the arithmetic average and
- * lookback payoffs the path extremes (fixed strike).
+ * Advance PRICING_BATCH_LANES paths together.  State is held per lane
+ * (log price, running average, extremes) and every time step draws one row
+ * of normals and updates all lanes with the same straight-line code, so
+ * the inner loops vectorize across paths.  Under VR_ANTITHETIC the upper
+ * half of the lanes mirror the lower half.
+ *
+ * payoff[] and control[] receive the discounted payoff and discounted
+ * European control payoff of every lane.  lane_path maps lanes to path
+ * indices for show_paths storage (NULL when paths are not stored; -1 for
+ * lanes that are not stored).  qmc_z, when not NULL, supplies the normals
+ * instead of ctx: row t - 1 holds step t's draws (see fill_qmc_normals).
  */
-static double path_payoff(const double *path, int steps, const pricing_config_t *config) {
-    double strike = config->option.strike_price;
+static void simulate_batch(const pricing_kernel_t *k, qrng_ctx *ctx, const double *qmc_z,
+                           const int *lane_path, double *all_paths,
+                           double *restrict payoff, double *restrict control) {
+    enum { L = PRICING_BATCH_LANES };
+    int draws = (k->flags & VR_ANTITHETIC) ? L / 2 : L;
+    uint64_t bits[L];
+    double z[L];
+    double log_s[L], s[L], sum[L], s_max[L], s_min[L];
+    size_t stride = (size_t)k->steps + 1;
+
+    for (int i = 0; i < L; i++) {
+        log_s[i] = 0.0;
+        s[i] = k->spot;
+        sum[i] = 0.0;
+        s_max[i] = k->spot;
+        s_min[i] = k->spot;
+    }
+    if (lane_path) {
+        for (int i = 0; i < L; i++)
+            if (lane_path[i] >= 0) all_paths[(size_t)lane_path[i] * stride] = k->spot;
+    }
 
-    switch (config->option.type) {
-        case OPTION_ASIAN_CALL:
-        case OPTION_ASIAN_PUT: {
-            double avg = 0.0;
-            for (int i = 1; i <= steps; i++) avg += path[i];
-            avg /= steps;
-            return config->option.type == OPTION_ASIAN_CALL
-                   ? fmax(avg - strike, 0.0)
-                   : fmax(strike - avg, 0.0);
+    for (int t = 1; t <= k->steps; t++) {
+        if (qmc_z) {
+            memcpy(z, qmc_z + (size_t)(t - 1) * draws, (size_t)draws * sizeof(double));
+        } else {
+            generate_normals(ctx, bits, z, (size_t)draws);
         }
-        case OPTION_LOOKBACK_CALL: {
-            double s_max = path[0];
-            for (int i = 1; i <= steps; i++) if (path[i] > s_max) s_max = path[i];
-            return fmax(s_max - strike, 0.0);
+        if (k->flags & VR_MOMENT_MATCHING) moment_match(z, draws);
+        if (k->flags & VR_ANTITHETIC) {
+            for (int i = 0; i < draws; i++) z[draws + i] = -z[i];
         }
-        case OPTION_LOOKBACK_PUT: {
-            double s_min = path[0];
-            for (int i = 1; i <= steps; i++) if (path[i] < s_min) s_min = path[i];
-            return fmax(strike - s_min, 0.0);
+
+        for (int i = 0; i < L; i++) log_s[i] += k->drift + k->vol_sqrt_dt * z[i];
+        if (!k->path_dependent) continue;
+
+        for (int i = 0; i < L; i++) s[i] = k->spot * exp(log_s[i]);
+        switch (k->type) {
+            case OPTION_ASIAN_CALL:
+            case OPTION_ASIAN_PUT:
+                for (int i = 0; i < L; i++) sum[i] += s[i];
+                break;
+            case OPTION_LOOKBACK_CALL:
+                for (int i = 0; i < L; i++) s_max[i] = fmax(s_max[i], s[i]);
+                break;
+            case OPTION_LOOKBACK_PUT:
+                for (int i = 0; i < L; i++) s_min[i] = fmin(s_min[i], s[i]);
+                break;
+            default:
+                break;
+        }
+        if (lane_path) {
+            for (int i = 0; i < L; i++)
+                if (lane_path[i] >= 0) all_paths[(size_t)lane_path[i] * stride + t] = s[i];
         }
+    }
+
+    for (int i = 0; i < L; i++) s[i] = k->spot * exp(log_s[i]);
+
+    /*
+     * Asian payoffs use the arithmetic average over steps 1..n and
+     * lookback payoffs the path extremes including S0 (fixed strike);
+     * vanilla and binary payoffs only need the terminal price.
+     */
+    double strike = k->strike;
+    switch (k->type) {
+        case OPTION_ASIAN_CALL:
+            for (int i = 0; i < L; i++) payoff[i] = fmax(sum[i] / k->steps - strike, 0.0);
+            break;
+        case OPTION_ASIAN_PUT:
+            for (int i = 0; i < L; i++) payoff[i] = fmax(strike - sum[i] / k->steps, 0.0);
+            break;
+        case OPTION_LOOKBACK_CALL:
+            for (int i = 0; i < L; i++) payoff[i] = fmax(s_max[i] - strike, 0.0);
+            break;
+        case OPTION_LOOKBACK_PUT:
+            for (int i = 0; i < L; i++) payoff[i] = fmax(strike - s_min[i], 0.0);
+            break;
         default:
-            return calculate_payoff(path[steps], strike, config->option.type);
+            for (int i = 0; i < L; i++) payoff[i] = calculate_payoff(s[i], strike, k->type);
+            break;
+    }
+    for (int i = 0; i < L; i++) {
+        payoff[i] *= k->discount;
+        control[i] = k->discount * calculate_payoff(s[i], strike, k->control_type);
+    }
+}
+
+/*
+ * Quasi-random normals for one batch: lane j takes the next point of seq
+ * (one dimension per time step), laid out with the Brownian bridge so the
+ * best-stratified first coordinates set the coarse shape of the path.
+ * Stored time-major, qmc_z[t * lanes + j], for simulate_batch; lanes past
+ * count are zero.  work holds 2 * steps doubles.
+ */
+static void fill_qmc_normals(sobol_ctx_t *seq, const sobol_bridge_t *bridge, int steps,
+                             int lanes, int count, double *qmc_z, double *work) {
+    double *point = work, *dw = work + steps;
+    for (int j = 0; j < lanes; j++) {
+        if (j < count) {
+            sobol_next_normal(seq, point);
+            sobol_bridge_transform(bridge, point, dw);
+        } else {
+            memset(dw, 0, (size_t)steps * sizeof(double));
+        }
+        for (int t = 0; t < steps; t++) qmc_z[(size_t)t * lanes + j] = dw[t];
     }
 }
 
@@ -209,14 +339,18 @@ static int validate_pricing_config(const pricing_config_t *config, pricing_resul
              config->option.volatility >= 0.0 &&
              config->num_paths >= MIN_PATHS &&
              config->num_paths <= MAX_PATHS &&
-             config->time_steps >= 1;
+             config->time_steps >= 1 &&
+             config->num_threads >= 0 &&
+             !(config->quasi_random && config->vol_model == VOL_CONSTANT &&
+               config->time_steps > SOBOL_MAX_DIMENSION);
 
     if (ok && config->vol_model == VOL_HESTON) {
         ok = config->heston.kappa > 0.0 &&
              config->heston.theta >= 0.0 &&
              config->heston.sigma >= 0.0 &&
              config->heston.v0 >= 0.0 &&
-             fabs(config->heston.rho) <= 1.0;
+             fabs(config->heston.rho) <= 1.0 &&
+             (config->heston.scheme == HESTON_EULER || config->heston.scheme == HESTON_QE);
     }
 
     if (!ok && results) {
@@ -237,9 +371,14 @@ pricing_results_t run_pricing_simulation(const pricing_config_t *config) {
 
     // Stochastic volatility model is handled by the Heston engine
     if (config->vol_model == VOL_HESTON) {
-        return run_heston_simulation(config, &config->heston);
+        double start = now_seconds();
+        results = run_heston_simulation(config, &config->heston);
+        results.elapsed_seconds = now_seconds() - start;
+        return results;
     }
 
+    double start = now_seconds();
+
     // Pass NULL when unseeded: qrng_init indexes the seed with
     // (i % seed_len) for any non-NULL pointer, so seed_len == 0 with a
     // non-NULL pointer would divide by zero.
@@ -267,49 +406,143 @@ pricing_results_t run_pricing_simulation(const pricing_config_t *config) {
         }
     }
 
-    double sum = 0.0, sum_squared = 0.0;
-    double discount = exp(-config->option.risk_free_rate * config->option.time_to_maturity);
-    double normal_cache = 0.0;
-    int has_normal_cache = 0;
-    int progress_step = config->num_paths / 10;
-    if (progress_step < 1) progress_step = 1;
-
-    double *path = (double *)malloc((steps + 1) * sizeof(double));
-    if (!path) {
-        fprintf(stderr, "Failed to allocate path buffer\n");
-        free(all_paths);
-        qrng_free(ctx);
-        results.price = NAN;
-        results.std_error = NAN;
-        return results;
+    /*
+     * Quasi-random mode: a Sobol sequence scrambled with a key drawn from
+     * ctx, so a seeded run is reproducible and an unseeded one gets a fresh
+     * randomization.  The reported standard error is the usual sample
+     * estimate, which does not capture the faster QMC convergence.
+     */
+    sobol_ctx_t *seq = NULL;
+    sobol_bridge_t *bridge = NULL;
+    double *qmc_z = NULL;
+    if (config->quasi_random) {
+        uint8_t key[32];
+        qrng_bytes(ctx, key, sizeof(key));
+        qmc_z = malloc(((size_t)steps * PRICING_BATCH_LANES + 2 * (size_t)steps) * sizeof(double));
+        if (!qmc_z ||
+            sobol_init(&seq, (uint32_t)steps, key, sizeof(key)) != SOBOL_SUCCESS ||
+            sobol_bridge_init(&bridge, (uint32_t)steps) != SOBOL_SUCCESS) {
+            fprintf(stderr, "Failed to initialize Sobol sequence\n");
+            free(qmc_z);
+            sobol_free(seq);
+            free(all_paths);
+            qrng_free(ctx);
+            results.price = NAN;
+            results.std_error = NAN;
+            return results;
+        }
     }
 
-    for (int i = 0; i < config->num_paths; i++) {
-        simulate_path(path, steps, config, ctx, &normal_cache, &has_normal_cache);
+    const option_params_t *opt = &config->option;
+    double dt = opt->time_to_maturity / steps;
+    pricing_kernel_t kernel = {
+        .steps = steps,
+        .flags = config->variance_reduction,
+        .path_dependent = config->show_paths ||
+                          (opt->type >= OPTION_ASIAN_CALL && opt->type <= OPTION_LOOKBACK_PUT),
+        .type = opt->type,
+        .control_type = control_option_type(opt->type),
+        .spot = opt->spot_price,
+        .strike = opt->strike_price,
+        .drift = (opt->risk_free_rate - opt->dividend_yield
+                  - 0.5 * opt->volatility * opt->volatility) * dt,
+        .vol_sqrt_dt = opt->volatility * sqrt(dt),
+        .discount = exp(-opt->risk_free_rate * opt->time_to_maturity)
+    };
+
+    // The control's expectation is known only where Black-Scholes is defined
+    // (sigma > 0).  Test that explicitly: isnan() is unreliable under
+    // -ffast-math.
+    int use_control = (kernel.flags & VR_CONTROL_VARIATE) && opt->volatility > 0.0;
+    double control_mean = 0.0;
+    if (use_control) {
+        option_params_t control_params = *opt;
+        control_params.type = kernel.control_type;
+        control_mean = black_scholes_price(&control_params);
+    }
 
-        if (config->show_paths) {
-            memcpy(&all_paths[(size_t)i * (steps + 1)], path, (steps + 1) * sizeof(double));
+    /*
+     * Under VR_ANTITHETIC one sample is the average of a path and its mirror,
+     * so num_paths paths give (num_paths + 1) / 2 independent samples.
+     */
+    int antithetic = (kernel.flags & VR_ANTITHETIC) != 0;
+    int per_batch = antithetic ? PRICING_BATCH_LANES / 2 : PRICING_BATCH_LANES;
+    int num_samples = antithetic ? (config->num_paths + 1) / 2 : config->num_paths;
+    int lane_path[PRICING_BATCH_LANES];
+    double payoff[PRICING_BATCH_LANES], control[PRICING_BATCH_LANES];
+
+    double sum_y = 0.0, sum_yy = 0.0, sum_x = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+    int next_report = 1;
+
+    for (int done = 0; done < num_samples; done += per_batch) {
+        int count = num_samples - done < per_batch ? num_samples - done : per_batch;
+
+        if (all_paths) {
+            for (int i = 0; i < PRICING_BATCH_LANES; i++) lane_path[i] = -1;
+            for (int j = 0; j < count; j++) {
+                int path = antithetic ? 2 * (done + j) : done + j;
+                lane_path[j] = path;
+                if (antithetic && path + 1 < config->num_paths) lane_path[per_batch + j] = path + 1;
+            }
         }
 
-        double payoff = path_payoff(path, steps, config);
-        double discounted_payoff = payoff * discount;
-
-        sum += discounted_payoff;
-        sum_squared += discounted_payoff * discounted_payoff;
+        if (qmc_z) {
+            fill_qmc_normals(seq, bridge, steps, per_batch, count, qmc_z,
+                             qmc_z + (size_t)steps * PRICING_BATCH_LANES);
+        }
+        simulate_batch(&kernel, ctx, qmc_z, all_paths ? lane_path : NULL, all_paths,
+                       payoff, control);
+
+        for (int j = 0; j < count; j++) {
+            double y = payoff[j], x = control[j];
+            if (antithetic) {
+                y = 0.5 * (y + payoff[per_batch + j]);
+                x = 0.5 * (x + control[per_batch + j]);
+            }
+            sum_y += y;
+            sum_yy += y * y;
+            sum_x += x;
+            sum_xx += x * x;
+            sum_xy += x * y;
+        }
 
-        if (config->show_progress && (i + 1) % progress_step == 0) {
-            printf("Progress: %d%%\n", (i + 1) * 100 / config->num_paths);
-            fflush(stdout);
+        if (config->show_progress) {
+            int percent = (done + count) * 100 / num_samples;
+            if (percent >= next_report * 10) {
+                printf("Progress: %d%%\n", percent / 10 * 10);
+                fflush(stdout);
+                next_report = percent / 10 + 1;
+            }
         }
     }
 
-    free(path);
     qrng_free(ctx);
+    free(qmc_z);
+    sobol_free(seq);
+    sobol_bridge_free(bridge);
 
     // Calculate price and error statistics
-    results.price = sum / config->num_paths;
-    double variance = (sum_squared / config->num_paths - results.price * results.price);
-    results.std_error = sqrt(fmax(variance, 0.0) / config->num_paths);
+    double n = num_samples;
+    double mean_y = sum_y / n;
+    double variance = sum_yy / n - mean_y * mean_y;
+    results.price = mean_y;
+
+    if (use_control) {
+        /*
+         * Control variate: price = mean(Y) - b (mean(X) - E[X]) with the
+         * variance-minimising b = cov(X,Y) / var(X).  The residual variance
+         * is var(Y) - b cov(X,Y).
+         */
+        double mean_x = sum_x / n;
+        double var_x = sum_xx / n - mean_x * mean_x;
+        double cov_xy = sum_xy / n - mean_x * mean_y;
+        if (var_x > 0.0) {
+            double b = cov_xy / var_x;
+            results.price = mean_y - b * (mean_x - control_mean);
+            variance -= b * cov_xy;
+        }
+    }
+    results.std_error = sqrt(fmax(variance, 0.0) / n);
 
     // 95% confidence interval
     double confidence_width = 1.96 * results.std_error;
@@ -320,6 +553,7 @@ pricing_results_t run_pricing_simulation(const pricing_config_t *config) {
         results.paths = all_paths;
         results.paths_size = config->num_paths * (steps + 1);
     }
+    results.elapsed_seconds = now_seconds() - start;
 
     return results;
 }
@@ -437,8 +671,22 @@ void print_results(FILE *output, const pricing_results_t *results, const pricing
     fprintf(output, "--------\n");
     fprintf(output, "Option Price:      %.4f\n", results->price);
     fprintf(output, "Standard Error:    %.4f\n", results->std_error);
-    fprintf(output, "95%% CI:           [%.4f, %.4f]\n\n", 
+    fprintf(output, "95%% CI:           [%.4f, %.4f]\n",
             results->confidence_lower, results->confidence_upper);
+    if (config->variance_reduction) {
+        fprintf(output, "Variance Reduction:%s%s%s\n",
+                (config->variance_reduction & VR_ANTITHETIC) ? " antithetic" : "",
+                (config->variance_reduction & VR_CONTROL_VARIATE) ? " control-variate" : "",
+                (config->variance_reduction & VR_MOMENT_MATCHING) ? " moment-matching" : "");
+    }
+    if (config->quasi_random && config->vol_model == VOL_CONSTANT) {
+        fprintf(output, "Sampling:          quasi-random (scrambled Sobol, Brownian bridge)\n");
+    }
+    if (results->elapsed_seconds > 0.0) {
+        fprintf(output, "Simulation Time:   %.3f s (%.0f paths/s)\n",
+                results->elapsed_seconds, config->num_paths / results->elapsed_seconds);
+    }
+    fprintf(output, "\n");
     
     if (config->greek_flags) {
         fprintf(output, "Greeks:\n");
@@ -490,7 +738,10 @@ void output_results_json(FILE *output, const pricing_results_t *results, const p
     fprintf(output, "    \"confidence_interval\": {\n");
     fprintf(output, "      \"lower\": %.4f,\n", results->confidence_lower);
     fprintf(output, "      \"upper\": %.4f\n", results->confidence_upper);
-    fprintf(output, "    }");
+    fprintf(output, "    },\n");
+    fprintf(output, "    \"variance_reduction\": %d,\n", config->variance_reduction);
+    fprintf(output, "    \"quasi_random\": %s,\n", config->quasi_random ? "true" : "false");
+    fprintf(output, "    \"elapsed_seconds\": %.6f", results->elapsed_seconds);
 
     if (config->greek_flags) {
         fprintf(output, ",\n    \"greeks\": {\n");
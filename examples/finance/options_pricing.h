@@ -9,6 +9,7 @@
 #define MAX_PATHS 1000000       // Reduced from 10000000
 #define DEFAULT_TIME_STEPS 252   // Daily steps for a year
 #define GREEK_PATHS_MULTIPLIER 0.2  // Use 20% of paths for Greeks
+#define PRICING_BATCH_LANES 64   // Paths advanced together, one vector lane each
 
 // Default option parameters
 #define DEFAULT_SPOT_PRICE 100.0
@@ -34,6 +35,13 @@
 #define GREEK_RHO   0x10
 #define GREEK_ALL   0x1F
 
+// Variance reduction flags (constant-volatility engine)
+#define VR_NONE             0x00
+#define VR_ANTITHETIC       0x01  // Pair every path with its mirror image (-z)
+#define VR_CONTROL_VARIATE  0x02  // Regress on the European payoff (black_scholes_price)
+#define VR_MOMENT_MATCHING  0x04  // Rescale each step's normals to mean 0, variance 1
+#define VR_ALL              0x07
+
 // Option types
 typedef enum {
     OPTION_CALL,
@@ -52,6 +60,12 @@ typedef enum {
     VOL_HESTON       // Heston stochastic volatility
 } volatility_model_t;
 
+// Heston discretization schemes
+typedef enum {
+    HESTON_EULER,    // Full-truncation Euler
+    HESTON_QE        // Andersen quadratic-exponential
+} heston_scheme_t;
+
 // Output modes
 typedef enum {
     OUTPUT_NORMAL,
@@ -68,6 +82,7 @@ typedef struct {
     double sigma;        // Volatility of variance
     double rho;         // Correlation between asset and variance
     double v0;          // Initial variance
+    heston_scheme_t scheme;  // Variance discretization
 } heston_params_t;
 
 // Option parameters structure
@@ -104,6 +119,9 @@ typedef struct {
     int show_paths;       // Show individual price paths
     volatility_model_t vol_model;  // Volatility model selection
     heston_params_t heston;        // Heston model parameters (if used)
+    int variance_reduction;        // Bitmask of VR_* techniques
+    int num_threads;      // Heston engine: 0 = shared task pool, 1 = calling thread only, N = N threads
+    int quasi_random;     // Constant vol: scrambled Sobol paths (time_steps <= SOBOL_MAX_DIMENSION)
 } pricing_config_t;
 
 // Simulation results
@@ -115,6 +133,7 @@ typedef struct {
     greeks_t greeks;
     double *paths;  // Array of price paths for analysis
     int paths_size;
+    double elapsed_seconds;  // Wall time of the simulation
 } pricing_results_t;
 
 // Function declarations
@@ -7,6 +7,7 @@
  * options_pricing.h:
  *
  *   black_scholes_price()      - analytic European call/put reference
+ *   heston_analytic_price()    - semi-analytic Heston call/put reference
  *   run_pricing_simulation()   - Monte Carlo pricing (constant vol or Heston)
  *   calculate_greeks()         - closed-form or finite-difference Greeks
  *   print_results() / output_results_json() / output_results_csv()
@@ -30,7 +31,8 @@ enum {
     OPT_HESTON_THETA,
     OPT_HESTON_SIGMA,
     OPT_HESTON_RHO,
-    OPT_HESTON_V0
+    OPT_HESTON_V0,
+    OPT_HESTON_SCHEME
 };
 
 static void usage(const char *prog) {
@@ -38,8 +40,8 @@ static void usage(const char *prog) {
 "Usage: %s [options]\n"
 "\n"
 "Prices an option with the quantum-RNG Monte Carlo engine.  For European\n"
-"calls and puts under constant volatility the Black-Scholes analytic price\n"
-"is printed alongside the Monte Carlo estimate.\n"
+"calls and puts the Black-Scholes analytic price (constant volatility) or\n"
+"the semi-analytic Heston price is printed alongside the Monte Carlo estimate.\n"
 "\n"
 "Contract parameters:\n"
 "  -S <spot>        Spot price of the underlying        (default %.2f)\n"
@@ -59,9 +61,18 @@ static void usage(const char *prog) {
 "  --heston-sigma <s>   Vol of variance          (default %.2f)\n"
 "  --heston-rho <r>     Spot/vol correlation     (default %.2f)\n"
 "  --heston-v0 <v>      Initial variance         (default %.2f)\n"
+"  --heston-scheme <s>  Discretization: euler (full truncation) or qe\n"
+"                       (Andersen quadratic-exponential) (default euler)\n"
 "\n"
 "Simulation / output:\n"
 "  -n <paths>       Number of Monte Carlo paths          (default %d)\n"
+"  -R <methods>     Variance reduction (constant vol): any of a,c,m\n"
+"                   (antithetic, control variate against Black-Scholes,\n"
+"                   moment matching), or 'all', or 'none' (default none)\n"
+"  -Q               Quasi-random paths (constant vol): scrambled Sobol\n"
+"                   sequence with a Brownian bridge\n"
+"  -t <threads>     Heston engine threads: 0 = shared pool, 1 = inline,\n"
+"                   N = private pool of N                (default 0)\n"
 "  -G <greeks>      Greeks to compute: any of d,g,t,v,r (delta,gamma,\n"
 "                   theta,vega,rho), or 'all', or 'none'  (default none)\n"
 "  -o <mode>        Output: normal, quiet, verbose, json, csv (default normal)\n"
@@ -132,6 +143,29 @@ static int parse_greeks(const char *s) {
     return flags;
 }
 
+/*
+ * Parse a variance-reduction selector such as "all", "none" or "ac" /
+ * "a,c".  Returns the VR_* bitmask, or -1 on an unknown letter.
+ */
+static int parse_variance_reduction(const char *s) {
+    if (strcmp(s, "all") == 0)  return VR_ALL;
+    if (strcmp(s, "none") == 0) return VR_NONE;
+
+    int flags = VR_NONE;
+    for (const char *p = s; *p; p++) {
+        switch (*p) {
+            case 'a': case 'A': flags |= VR_ANTITHETIC;      break;
+            case 'c': case 'C': flags |= VR_CONTROL_VARIATE; break;
+            case 'm': case 'M': flags |= VR_MOMENT_MATCHING; break;
+            case ',': case ' ': break;
+            default:
+                fprintf(stderr, "Unknown variance reduction '%c' (use a,c,m or 'all')\n", *p);
+                return -1;
+        }
+    }
+    return flags;
+}
+
 int main(int argc, char *argv[]) {
     pricing_config_t config;
     init_pricing_config(&config);
@@ -143,12 +177,13 @@ int main(int argc, char *argv[]) {
         { "heston-sigma", required_argument, 0, OPT_HESTON_SIGMA },
         { "heston-rho",   required_argument, 0, OPT_HESTON_RHO },
         { "heston-v0",    required_argument, 0, OPT_HESTON_V0 },
+        { "heston-scheme", required_argument, 0, OPT_HESTON_SCHEME },
         { "help",         no_argument,       0, 'h' },
         { 0, 0, 0, 0 }
     };
 
     int opt;
-    while ((opt = getopt_long(argc, argv, "S:K:T:v:r:q:M:y:n:G:o:ps:h",
+    while ((opt = getopt_long(argc, argv, "S:K:T:v:r:q:M:y:n:R:Qt:G:o:ps:h",
                               long_opts, NULL)) != -1) {
         switch (opt) {
             case 'S': config.option.spot_price = atof(optarg); break;
@@ -174,6 +209,13 @@ int main(int argc, char *argv[]) {
                 }
                 break;
             case 'n': config.num_paths = atoi(optarg); break;
+            case 'R': {
+                int vr = parse_variance_reduction(optarg);
+                if (vr < 0) return 1;
+                config.variance_reduction = vr;
+                break;
+            }
+            case 'Q': config.quasi_random = 1; break;
             case 'G': {
                 int g = parse_greeks(optarg);
                 if (g < 0) return 1;
@@ -186,6 +228,22 @@ int main(int argc, char *argv[]) {
                     return 1;
                 }
                 break;
+            case 't': config.num_threads = atoi(optarg); break;
+            case OPT_HESTON_KAPPA: config.heston.kappa = atof(optarg); break;
+            case OPT_HESTON_THETA: config.heston.theta = atof(optarg); break;
+            case OPT_HESTON_SIGMA: config.heston.sigma = atof(optarg); break;
+            case OPT_HESTON_RHO:   config.heston.rho = atof(optarg); break;
+            case OPT_HESTON_V0:    config.heston.v0 = atof(optarg); break;
+            case OPT_HESTON_SCHEME:
+                if (strcmp(optarg, "euler") == 0) {
+                    config.heston.scheme = HESTON_EULER;
+                } else if (strcmp(optarg, "qe") == 0) {
+                    config.heston.scheme = HESTON_QE;
+                } else {
+                    fprintf(stderr, "Unknown Heston scheme '%s' (use euler or qe)\n", optarg);
+                    return 1;
+                }
+                break;
             case 'p': config.show_paths = 1; break;
             case 's':
                 strncpy(config.seed, optarg, sizeof(config.seed) - 1);
@@ -210,21 +268,37 @@ int main(int argc, char *argv[]) {
         fprintf(stderr, "Error: volatility (-v) must be non-negative.\n");
         return 1;
     }
+    if (config.num_threads < 0) {
+        fprintf(stderr, "Error: thread count (-t) must be non-negative.\n");
+        return 1;
+    }
     if (config.num_paths < MIN_PATHS || config.num_paths > MAX_PATHS) {
         fprintf(stderr, "Error: number of paths (-n) must be between %d and %d.\n",
                 MIN_PATHS, MAX_PATHS);
         return 1;
     }
 
+    if (config.variance_reduction && config.vol_model == VOL_HESTON) {
+        fprintf(stderr, "Warning: variance reduction (-R) applies to the "
+                        "constant-volatility model only; ignored.\n");
+        config.variance_reduction = VR_NONE;
+    }
+    if (config.quasi_random && config.vol_model == VOL_HESTON) {
+        fprintf(stderr, "Warning: quasi-random paths (-Q) apply to the "
+                        "constant-volatility model only; ignored.\n");
+        config.quasi_random = 0;
+    }
+
     /* Progress and human-readable chatter would corrupt machine formats. */
     int machine_output = (config.output_mode == OUTPUT_JSON ||
                           config.output_mode == OUTPUT_CSV ||
                           config.output_mode == OUTPUT_QUIET);
     config.show_progress = machine_output ? 0 : config.show_progress;
 
-    int has_analytic = (config.vol_model == VOL_CONSTANT &&
-                        (config.option.type == OPTION_CALL ||
-                         config.option.type == OPTION_PUT));
+    int vanilla = (config.option.type == OPTION_CALL ||
+                   config.option.type == OPTION_PUT);
+    int has_analytic = vanilla && (config.vol_model == VOL_CONSTANT ||
+                                   config.heston.sigma > 0.0);
 
     pricing_results_t results = run_pricing_simulation(&config);
 
@@ -259,7 +333,12 @@ int main(int argc, char *argv[]) {
         case OUTPUT_NORMAL:
         default:
             print_results(stdout, &results, &config);
-            if (has_analytic) {
+            if (has_analytic && config.vol_model == VOL_HESTON) {
+                double exact = heston_analytic_price(&config.option, &config.heston);
+                printf("Heston (semi-analytic):   %.4f\n", exact);
+                printf("Monte Carlo - Analytic:   %+.4f\n", results.price - exact);
+                printf("\n");
+            } else if (has_analytic) {
                 double bs = black_scholes_price(&config.option);
                 printf("Black-Scholes (analytic): %.4f\n", bs);
                 printf("Monte Carlo - Analytic:   %+.4f\n", results.price - bs);
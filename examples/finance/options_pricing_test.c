@@ -2,11 +2,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
 #include <time.h>
 #include <assert.h>
 #include "options_pricing.h"
 #include "heston_model.h"
 #include "../../src/quantum_rng/quantum_rng.h"
+#include "../../src/qmc/sobol.h"
 
 #define EPSILON 0.01  // For deterministic (closed-form) comparisons
 
@@ -36,6 +38,15 @@ static int double_equals(double a, double b, double epsilon) {
     return fabs(a - b) < epsilon;
 }
 
+/* NaN check on the bit pattern: the build uses -ffast-math, under which
+ * the compiler may assume isnan() is always false. */
+static int is_nan_bits(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x7FF0000000000000ULL) == 0x7FF0000000000000ULL &&
+           (bits & 0x000FFFFFFFFFFFFFULL) != 0;
+}
+
 static void init_test_config(pricing_config_t *config) {
     init_pricing_config(config);
     config->num_paths = TEST_NUM_PATHS;
@@ -151,6 +162,102 @@ static void test_heston_simulation() {
     print_test_result("Heston simulation", 1);
 }
 
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Path-at-a-time Euler reference built on calculate_heston_price_path
+static double heston_scalar_price(const pricing_config_t *config, double *seconds) {
+    qrng_ctx *ctx;
+    assert(qrng_init(&ctx, (const uint8_t *)config->seed, config->seed_length) == QRNG_SUCCESS);
+
+    double start = wall_seconds();
+    double dt = config->option.time_to_maturity / config->time_steps;
+    double drift_dt = (config->option.risk_free_rate - config->option.dividend_yield) * dt;
+    double sum = 0.0;
+    for (int i = 0; i < config->num_paths; i++) {
+        double spot = config->option.spot_price;
+        double variance = config->heston.v0;
+        for (int j = 0; j < config->time_steps; j++) {
+            spot = calculate_heston_price_path(spot, &variance, dt, drift_dt, &config->heston, ctx);
+        }
+        sum += calculate_payoff(spot, config->option.strike_price, config->option.type);
+    }
+    *seconds = wall_seconds() - start;
+    qrng_free(ctx);
+    return sum / config->num_paths *
+           exp(-config->option.risk_free_rate * config->option.time_to_maturity);
+}
+
+/*
+ * Heston schemes against the semi-analytic price, on a stress case with
+ * strong vol-of-vol and correlation (sigma = 1, rho = -0.9) where the
+ * variance often hits zero.  Benchmarks the path-at-a-time reference, the
+ * batched Euler engine and the batched QE engine, and checks that QE is
+ * unbiased at 4 steps and that results do not depend on the thread count.
+ */
+static void test_heston_schemes() {
+    print_test_header("Heston Schemes");
+
+    pricing_config_t config;
+    init_test_config(&config);
+    strcpy(config.seed, "heston-schemes");
+    config.seed_length = (int)strlen(config.seed);
+    config.vol_model = VOL_HESTON;
+    config.option.dividend_yield = 0.0;
+
+    // Semi-analytic price reduces to Black-Scholes as vol-of-vol -> 0
+    config.heston = (heston_params_t){ 2.0, 0.04, 1e-4, -0.7, 0.04, HESTON_EULER };
+    double limit = heston_analytic_price(&config.option, &config.heston);
+    double bs = black_scholes_price(&config.option);
+    printf("Analytic Heston (sigma -> 0): %.4f, Black-Scholes: %.4f\n", limit, bs);
+    assert(double_equals(limit, bs, 1e-3));
+
+    config.heston = (heston_params_t){ 0.5, 0.04, 1.0, -0.9, 0.04, HESTON_EULER };
+    double exact = heston_analytic_price(&config.option, &config.heston);
+    printf("Analytic Heston (stress case): %.4f\n", exact);
+    printf("%-22s %6s %9s %9s %9s %12s\n", "engine", "steps", "price", "bias", "std err", "paths/s");
+
+    double seconds;
+    config.time_steps = 32;
+    double scalar = heston_scalar_price(&config, &seconds);
+    printf("%-22s %6d %9.4f %+9.4f %9s %12.0f\n", "path-at-a-time Euler", config.time_steps,
+           scalar, scalar - exact, "-", config.num_paths / seconds);
+
+    static const struct { heston_scheme_t scheme; int steps; const char *name; } runs[] = {
+        { HESTON_EULER, 32, "batched Euler" },
+        { HESTON_QE,     4, "batched QE" },
+        { HESTON_QE,    32, "batched QE" },
+    };
+    for (size_t i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+        config.heston.scheme = runs[i].scheme;
+        config.time_steps = runs[i].steps;
+        pricing_results_t r = run_pricing_simulation(&config);
+        printf("%-22s %6d %9.4f %+9.4f %9.4f %12.0f\n", runs[i].name, runs[i].steps,
+               r.price, r.price - exact, r.std_error, config.num_paths / r.elapsed_seconds);
+        if (runs[i].scheme == HESTON_QE) {
+            // Allow 5 standard errors plus a small discretization bias
+            assert(fabs(r.price - exact) < TEST_Z_BOUND * r.std_error + 0.05);
+        }
+        free_pricing_results(&r);
+    }
+
+    // Per-block substreams make the result independent of the thread count
+    config.heston.scheme = HESTON_QE;
+    config.time_steps = 8;
+    config.num_paths = 2000;
+    config.num_threads = 1;
+    pricing_results_t one = run_pricing_simulation(&config);
+    config.num_threads = 4;
+    pricing_results_t four = run_pricing_simulation(&config);
+    printf("1 thread: %.10f, 4 threads: %.10f\n", one.price, four.price);
+    assert(memcmp(&one.price, &four.price, sizeof(double)) == 0);
+
+    print_test_result("Heston schemes", 1);
+}
+
 // Test option Greeks (closed form under constant volatility)
 static void test_option_greeks() {
     print_test_header("Option Greeks");
@@ -250,6 +357,121 @@ static void test_monte_carlo_pricing() {
     print_test_result("Monte Carlo pricing", 1);
 }
 
+/*
+ * Variance reduction: the control variate reproduces Black-Scholes exactly
+ * for a European call (the payoff is its own control), and on an Asian call
+ * every technique must agree with plain Monte Carlo while antithetic and
+ * control-variate sampling cut the standard error.  Time-to-accuracy is
+ * reported as the wall time needed to reach a 0.01 standard error, scaled
+ * from each run as t * (se / 0.01)^2.
+ */
+static void test_variance_reduction() {
+    print_test_header("Variance Reduction");
+
+    pricing_config_t config;
+    init_test_config(&config);
+    strcpy(config.seed, "variance-reduction");
+    config.seed_length = (int)strlen(config.seed);
+
+    config.variance_reduction = VR_CONTROL_VARIATE;
+    pricing_results_t cv = run_pricing_simulation(&config);
+    double bs = black_scholes_price(&config.option);
+    printf("European call with control variate: %.6f (BS %.6f, std error %.2e)\n",
+           cv.price, bs, cv.std_error);
+    assert(fabs(cv.price - bs) < 1e-6);
+    free_pricing_results(&cv);
+
+    static const struct { int flags; const char *name; } runs[] = {
+        { VR_NONE,            "none" },
+        { VR_ANTITHETIC,      "antithetic" },
+        { VR_CONTROL_VARIATE, "control variate" },
+        { VR_MOMENT_MATCHING, "moment matching" },
+        { VR_ALL,             "all" },
+    };
+    const double target = 0.01;
+    pricing_results_t r[sizeof(runs) / sizeof(runs[0])];
+
+    config.option.type = OPTION_ASIAN_CALL;
+    printf("%-16s %9s %9s %12s %16s\n",
+           "Asian call", "price", "std err", "paths/s", "time to 0.01 SE");
+    for (size_t i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) {
+        config.variance_reduction = runs[i].flags;
+        r[i] = run_pricing_simulation(&config);
+        double t = r[i].elapsed_seconds * pow(r[i].std_error / target, 2.0);
+        printf("%-16s %9.4f %9.4f %12.0f %14.1f s\n", runs[i].name, r[i].price,
+               r[i].std_error, config.num_paths / r[i].elapsed_seconds, t);
+
+        double combined = sqrt(r[0].std_error * r[0].std_error +
+                               r[i].std_error * r[i].std_error);
+        assert(fabs(r[i].price - r[0].price) < TEST_Z_BOUND * combined);
+    }
+
+    assert(r[1].std_error < r[0].std_error);          // antithetic
+    assert(r[2].std_error < 0.8 * r[0].std_error);    // control variate
+    assert(r[4].std_error < 0.7 * r[0].std_error);    // all combined
+
+    double plain_cost = r[0].elapsed_seconds * r[0].std_error * r[0].std_error;
+    double all_cost = r[4].elapsed_seconds * r[4].std_error * r[4].std_error;
+    printf("Time-to-accuracy speedup with all techniques: %.1fx\n", plain_cost / all_cost);
+
+    for (size_t i = 0; i < sizeof(runs) / sizeof(runs[0]); i++) free_pricing_results(&r[i]);
+    print_test_result("Variance reduction", 1);
+}
+
+// Quasi-random paths: the spread of prices over independent scramblings is
+// the honest error of a QMC estimate; compare it with the Monte Carlo error
+static void test_quasi_random() {
+    print_test_header("Quasi-Random Paths");
+
+    static const char *seeds[] = { "qmc-1", "qmc-2", "qmc-3", "qmc-4", "qmc-5", "qmc-6" };
+    enum { RUNS = sizeof(seeds) / sizeof(seeds[0]) };
+    static const option_type_t types[] = { OPTION_CALL, OPTION_ASIAN_CALL };
+
+    pricing_config_t config;
+    init_test_config(&config);
+    double bs = black_scholes_price(&config.option);
+
+    printf("%-12s %12s %12s %12s\n", "Option", "QMC mean", "QMC spread", "MC std err");
+    for (size_t k = 0; k < sizeof(types) / sizeof(types[0]); k++) {
+        config.option.type = types[k];
+        double sum = 0.0, sum_sq = 0.0, mc_error = 0.0;
+        for (int i = 0; i < RUNS; i++) {
+            strcpy(config.seed, seeds[i]);
+            config.seed_length = (int)strlen(config.seed);
+            config.quasi_random = 1;
+            pricing_results_t q = run_pricing_simulation(&config);
+            config.quasi_random = 0;
+            pricing_results_t p = run_pricing_simulation(&config);
+            assert(!is_nan_bits(q.price));
+            sum += q.price;
+            sum_sq += q.price * q.price;
+            mc_error += p.std_error / RUNS;
+
+            // Same seed, same scrambling, same price
+            config.quasi_random = 1;
+            pricing_results_t again = run_pricing_simulation(&config);
+            assert(again.price == q.price);
+            free_pricing_results(&q);
+            free_pricing_results(&p);
+            free_pricing_results(&again);
+        }
+        double mean = sum / RUNS;
+        double spread = sqrt(fmax(sum_sq / RUNS - mean * mean, 0.0) * RUNS / (RUNS - 1));
+        printf("%-12s %12.4f %12.2e %12.2e\n", get_option_type_name(types[k]),
+               mean, spread, mc_error);
+        assert(spread < 0.25 * mc_error);
+        if (types[k] == OPTION_CALL) assert(fabs(mean - bs) < 0.25 * mc_error);
+    }
+
+    // Too many steps for the direction-number table
+    config.quasi_random = 1;
+    config.time_steps = SOBOL_MAX_DIMENSION + 1;
+    pricing_results_t invalid = run_pricing_simulation(&config);
+    assert(is_nan_bits(invalid.price));
+
+    print_test_result("Quasi-random paths", 1);
+}
+
 // Test error handling
 static void test_error_handling() {
     print_test_header("Error Handling");
@@ -260,19 +482,19 @@ static void test_error_handling() {
     // Test invalid spot price
     config.option.spot_price = -100.0;
     pricing_results_t results = run_pricing_simulation(&config);
-    assert(isnan(results.price));
+    assert(is_nan_bits(results.price));
 
     // Test invalid strike price
     config.option.spot_price = 100.0;
     config.option.strike_price = -100.0;
     results = run_pricing_simulation(&config);
-    assert(isnan(results.price));
+    assert(is_nan_bits(results.price));
 
     // Test invalid volatility
     config.option.strike_price = 100.0;
     config.option.volatility = -0.2;
     results = run_pricing_simulation(&config);
-    assert(isnan(results.price));
+    assert(is_nan_bits(results.price));
 
     // Test invalid Heston parameters
     config.vol_model = VOL_HESTON;
@@ -280,7 +502,7 @@ static void test_error_handling() {
     init_heston_params(&config.heston);
     config.heston.kappa = -1.0;  // Invalid mean reversion
     results = run_pricing_simulation(&config);
-    assert(isnan(results.price));
+    assert(is_nan_bits(results.price));
 
     print_test_result("Error handling", 1);
 }
@@ -328,8 +550,11 @@ int main() {
 
     test_black_scholes();
     test_heston_simulation();
+    test_heston_schemes();
     test_option_greeks();
     test_monte_carlo_pricing();
+    test_variance_reduction();
+    test_quasi_random();
     test_error_handling();
     test_performance();
 
@@ -0,0 +1,300 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <time.h>
+#include "qae_pricing.h"
+#include "../../src/quantum_rng/quantum_rng.h"
+#include "../../src/quantum_rng/quantum_state.h"
+#include "../../src/quantum_rng/grover.h"
+#include "../../src/quantum_rng/simd_ops.h"
+#include "../../src/qmc/sobol.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double norm_cdf(double x) {
+    return 0.5 * erfc(-x * M_SQRT1_2);
+}
+
+void init_qae_config(qae_config_t *config) {
+    memset(config, 0, sizeof(qae_config_t));
+    config->option.spot_price = DEFAULT_SPOT_PRICE;
+    config->option.strike_price = DEFAULT_STRIKE_PRICE;
+    config->option.time_to_maturity = DEFAULT_TIME_TO_MATURITY;
+    config->option.volatility = DEFAULT_VOLATILITY;
+    config->option.risk_free_rate = DEFAULT_RISK_FREE_RATE;
+    config->option.dividend_yield = DEFAULT_DIVIDEND_YIELD;
+    config->option.type = OPTION_CALL;
+    config->num_qubits = QAE_DEFAULT_QUBITS;
+    config->std_devs = QAE_DEFAULT_STD_DEVS;
+    config->epsilon = QAE_DEFAULT_EPSILON;
+    config->alpha = QAE_DEFAULT_ALPHA;
+    config->shots = QAE_DEFAULT_SHOTS;
+}
+
+static int validate_qae_config(const qae_config_t *config) {
+    if (!config) return 0;
+    const option_params_t *opt = &config->option;
+    int terminal_payoff = opt->type == OPTION_CALL || opt->type == OPTION_PUT ||
+                          opt->type == OPTION_BINARY_CALL || opt->type == OPTION_BINARY_PUT;
+    return terminal_payoff &&
+           opt->spot_price > 0.0 &&
+           opt->strike_price > 0.0 &&
+           opt->time_to_maturity > 0.0 &&
+           opt->volatility > 0.0 &&
+           config->num_qubits >= QAE_MIN_QUBITS &&
+           config->num_qubits <= QAE_MAX_QUBITS &&
+           config->std_devs > 0.0 &&
+           config->epsilon > 0.0 && config->epsilon < 0.5 &&
+           config->alpha > 0.0 && config->alpha < 1.0 &&
+           config->shots >= 1;
+}
+
+/*
+ * Load A|0> into psi: price register in qubits 0..n-1, payoff qubit n.
+ * Grid point i is the midpoint of the i-th of 2^n equal bins of ln S_T
+ * over mean +/- std_devs standard deviations, weighted by the normal
+ * probability of its bin (renormalized over the truncated range).  A
+ * simulator can write the amplitudes directly; on hardware A would be a
+ * distribution-loading circuit followed by controlled Y rotations.
+ *
+ * Returns payoff_max, the scale that maps f_i back to the payoff, and
+ * stores the exact amplitude and the discounted payoff's std deviation.
+ */
+static double load_payoff_state(const qae_config_t *config, quantum_state_t *psi,
+                                double *exact_amplitude, double *payoff_std_dev) {
+    const option_params_t *opt = &config->option;
+    size_t points = (size_t)1 << config->num_qubits;
+    double t = opt->time_to_maturity;
+    double mean = log(opt->spot_price) +
+                  (opt->risk_free_rate - opt->dividend_yield - 0.5 * opt->volatility * opt->volatility) * t;
+    double sd = opt->volatility * sqrt(t);
+    double lo = -config->std_devs, width = 2.0 * config->std_devs / (double)points;
+    double mass = norm_cdf(config->std_devs) - norm_cdf(-config->std_devs);
+
+    // First pass: largest payoff on the grid, the scale for f_i
+    double payoff_max = 0.0;
+    for (size_t i = 0; i < points; i++) {
+        double s = exp(mean + sd * (lo + (i + 0.5) * width));
+        double payoff = calculate_payoff(s, opt->strike_price, opt->type);
+        if (payoff > payoff_max) payoff_max = payoff;
+    }
+
+    double discount = exp(-opt->risk_free_rate * t);
+    double a = 0.0, second = 0.0;
+    complex_t *amp = psi->amplitudes;
+    for (size_t i = 0; i < points; i++) {
+        double p = (norm_cdf(lo + (i + 1) * width) - norm_cdf(lo + i * width)) / mass;
+        double s = exp(mean + sd * (lo + (i + 0.5) * width));
+        double f = payoff_max > 0.0 ? calculate_payoff(s, opt->strike_price, opt->type) / payoff_max : 0.0;
+        amp[i] = sqrt(p * (1.0 - f));
+        amp[points + i] = sqrt(p * f);
+        a += p * f;
+        second += p * f * f;
+    }
+
+    double scale = discount * payoff_max;
+    *exact_amplitude = a;
+    *payoff_std_dev = scale * sqrt(fmax(second - a * a, 0.0));
+    return payoff_max;
+}
+
+// Probability that the payoff (top) qubit reads 1
+static double good_probability(const quantum_state_t *state) {
+    size_t half = state->state_dim / 2;
+    return simd_sum_squared_magnitudes(state->amplitudes + half, half);
+}
+
+// Number of 1 outcomes in shots measurements of a qubit with P(1) = p
+static long measure_ones(qrng_ctx *rng, double p, int shots) {
+    uint64_t bits[256];
+    long ones = 0;
+    for (int done = 0; done < shots; done += 256) {
+        int n = shots - done < 256 ? shots - done : 256;
+        qrng_bytes(rng, (uint8_t *)bits, (size_t)n * sizeof(uint64_t));
+        for (int i = 0; i < n; i++) {
+            ones += (double)(bits[i] >> 11) * (1.0 / 9007199254740992.0) < p;
+        }
+    }
+    return ones;
+}
+
+/*
+ * Next Grover power (Grinko et al., Algorithm 2).  Angles are in cycles:
+ * theta in [0, 1/4] with a = sin^2(2 pi theta).  After k iterations the
+ * measured angle is (4k + 2) theta; choose the largest such scaling, at
+ * least twice the current one, that maps the whole interval into one
+ * half circle so the measured probability inverts uniquely.
+ */
+static void find_next_k(int *k, int *upper, double theta_l, double theta_u) {
+    long old_scaling = 4L * *k + 2;
+    double span = theta_u - theta_l;
+    long max_scaling = span > 0.0 ? (long)(1.0 / (2.0 * span)) : old_scaling;
+    if (max_scaling < 2) return;
+    long scaling = max_scaling - ((max_scaling - 2) % 4 + 4) % 4;
+
+    while (scaling >= 2 * old_scaling) {
+        double lo = scaling * theta_l - floor(scaling * theta_l);
+        double hi = scaling * theta_u - floor(scaling * theta_u);
+        if (lo <= hi && hi <= 0.5) {
+            *k = (int)((scaling - 2) / 4);
+            *upper = 1;
+            return;
+        }
+        if (hi >= 0.5 && lo >= 0.5 && lo <= hi) {
+            *k = (int)((scaling - 2) / 4);
+            *upper = 0;
+            return;
+        }
+        scaling -= 4;
+    }
+}
+
+qae_results_t run_qae_pricing(const qae_config_t *config) {
+    qae_results_t results = {0};
+    results.price = NAN;
+    results.price_lower = NAN;
+    results.price_upper = NAN;
+    if (!validate_qae_config(config)) return results;
+
+    double start = now_seconds();
+
+    // Measurement outcomes come from the quantum RNG.  Pass NULL when
+    // unseeded: qrng_init divides by seed_len for any non-NULL seed.
+    qrng_ctx *rng;
+    if (qrng_init(&rng, config->seed_length > 0 ? (const uint8_t *)config->seed : NULL,
+                  config->seed_length) != QRNG_SUCCESS) {
+        return results;
+    }
+
+    size_t good_qubit = (size_t)config->num_qubits;
+    quantum_state_t psi, state;
+    if (quantum_state_init(&psi, good_qubit + 1) != QS_SUCCESS) {
+        qrng_free(rng);
+        return results;
+    }
+    double payoff_max = load_payoff_state(config, &psi, &results.exact_amplitude,
+                                          &results.payoff_std_dev);
+    if (quantum_state_clone(&state, &psi) != QS_SUCCESS) {
+        quantum_state_free(&psi);
+        qrng_free(rng);
+        return results;
+    }
+
+    /*
+     * Iterative amplitude estimation.  Each round runs the circuit Q^k A
+     * for `shots` measurements; outcomes at the same k are pooled.  The
+     * Chernoff-Hoeffding interval on the measured probability, at level
+     * alpha split over the maximum number of rounds, is mapped back to an
+     * interval on theta.  The simulator keeps Q^k |psi> between rounds
+     * because k never decreases, so it runs max k iterations in total,
+     * while the oracle count charges every shot its full 2k + 1 calls of A.
+     */
+    double eps = config->epsilon;
+    int max_rounds = (int)(log(2.0 * M_PI / 8.0 / eps) / log(2.0)) + 1;
+    double theta_l = 0.0, theta_u = 0.25;
+    int k = 0, upper = 1, power = 0;
+    long ones = 0, pooled_shots = 0;
+    int ok = 1;
+
+    while (theta_u - theta_l > eps / M_PI && results.rounds < QAE_MAX_ROUNDS) {
+        int prev_k = k;
+        find_next_k(&k, &upper, theta_l, theta_u);
+        if (k != prev_k) {
+            ones = 0;
+            pooled_shots = 0;
+        }
+        for (; power < k; power++) {
+            if (grover_amplification_iteration(&state, &psi, good_qubit) != QS_SUCCESS) {
+                ok = 0;
+                break;
+            }
+            results.grover_iterations++;
+        }
+        if (!ok) break;
+
+        ones += measure_ones(rng, good_probability(&state), config->shots);
+        pooled_shots += config->shots;
+        results.oracle_calls += (size_t)config->shots * (2 * (size_t)k + 1);
+        results.rounds++;
+
+        double prob = (double)ones / (double)pooled_shots;
+        double half_width = sqrt(log(2.0 * max_rounds / config->alpha) / (2.0 * pooled_shots));
+        double a_min = fmax(0.0, prob - half_width);
+        double a_max = fmin(1.0, prob + half_width);
+        double t_min, t_max;
+        if (upper) {
+            t_min = acos(1.0 - 2.0 * a_min) / (2.0 * M_PI);
+            t_max = acos(1.0 - 2.0 * a_max) / (2.0 * M_PI);
+        } else {
+            t_min = 1.0 - acos(1.0 - 2.0 * a_max) / (2.0 * M_PI);
+            t_max = 1.0 - acos(1.0 - 2.0 * a_min) / (2.0 * M_PI);
+        }
+        // find_next_k put the scaled interval inside one half circle, so
+        // both ends share one whole number of cycles.  Take it from the
+        // midpoint: an end can sit exactly on a cycle boundary, where
+        // rounding would add a whole cycle.
+        double scaling = 4.0 * k + 2.0;
+        double cycles = floor(0.5 * scaling * (theta_l + theta_u));
+        theta_u = (cycles + t_max) / scaling;
+        theta_l = (cycles + t_min) / scaling;
+    }
+    results.max_power = k;
+
+    quantum_state_free(&state);
+    quantum_state_free(&psi);
+    qrng_free(rng);
+    if (!ok) return results;
+
+    double a_lower = pow(sin(2.0 * M_PI * theta_l), 2.0);
+    double a_upper = pow(sin(2.0 * M_PI * theta_u), 2.0);
+    double scale = exp(-config->option.risk_free_rate * config->option.time_to_maturity) * payoff_max;
+    results.amplitude = 0.5 * (a_lower + a_upper);
+    results.price = scale * results.amplitude;
+    results.price_lower = scale * a_lower;
+    results.price_upper = scale * a_upper;
+    results.exact_price = scale * results.exact_amplitude;
+
+    // Classical Monte Carlo on the same grid reaches the same half-width
+    // at the same confidence after (z sigma / h)^2 paths
+    double price_half_width = 0.5 * (results.price_upper - results.price_lower);
+    double z = sobol_inverse_normal(1.0 - 0.5 * config->alpha);
+    if (price_half_width > 0.0) {
+        results.classical_paths = pow(z * results.payoff_std_dev / price_half_width, 2.0);
+    }
+
+    results.elapsed_seconds = now_seconds() - start;
+    return results;
+}
+
+void print_qae_results(FILE *output, const qae_results_t *results, const qae_config_t *config) {
+    fprintf(output, "\nQuantum Amplitude Estimation Pricing\n");
+    fprintf(output, "====================================\n\n");
+    fprintf(output, "Option Type:       %s\n", get_option_type_name(config->option.type));
+    fprintf(output, "Spot / Strike:     %.2f / %.2f\n",
+            config->option.spot_price, config->option.strike_price);
+    fprintf(output, "Price Grid:        %d qubits (%zu points, +/- %.1f sd)\n",
+            config->num_qubits, (size_t)1 << config->num_qubits, config->std_devs);
+    fprintf(output, "Target Epsilon:    %.2e (confidence %.1f%%)\n\n",
+            config->epsilon, 100.0 * (1.0 - config->alpha));
+
+    fprintf(output, "QAE Price:         %.4f\n", results->price);
+    fprintf(output, "Confidence Int.:   [%.4f, %.4f]\n", results->price_lower, results->price_upper);
+    fprintf(output, "Grid Price:        %.4f (exact expectation on the grid)\n", results->exact_price);
+    fprintf(output, "Amplitude:         %.6f (exact %.6f)\n",
+            results->amplitude, results->exact_amplitude);
+    fprintf(output, "Rounds:            %d (max Grover power %d)\n",
+            results->rounds, results->max_power);
+    fprintf(output, "Oracle Calls:      %zu\n", results->oracle_calls);
+    fprintf(output, "Classical Paths:   %.0f for the same interval (%.1fx more)\n",
+            results->classical_paths,
+            results->oracle_calls ? results->classical_paths / results->oracle_calls : 0.0);
+    fprintf(output, "Simulator:         %zu fused iterations on %d qubits in %.3f s\n\n",
+            results->grover_iterations, config->num_qubits + 1, results->elapsed_seconds);
+    fflush(output);
+}
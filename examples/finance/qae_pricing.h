@@ -0,0 +1,75 @@
+#ifndef QAE_PRICING_H
+#define QAE_PRICING_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "options_pricing.h"
+
+/*
+ * Quantum amplitude estimation (QAE) pricing on the state-vector simulator.
+ *
+ * The terminal price distribution of a Black-Scholes underlying is
+ * discretized onto 2^n grid points and loaded into an (n+1)-qubit state
+ *
+ *   |psi> = A|0> = sum_i sqrt(p_i) |i> ( sqrt(1 - f_i)|0> + sqrt(f_i)|1> )
+ *
+ * where f_i is the payoff at grid point i scaled into [0, 1].  The
+ * probability of measuring the top (payoff) qubit as 1 is then
+ * a = sum_i p_i f_i, the scaled expected payoff.  Iterative amplitude
+ * estimation (Grinko et al., QFT-free) measures that qubit after k
+ * fused Grover iterations Q = D_psi S_chi for a growing schedule of k
+ * and narrows a confidence interval on a, reaching half-width eps with
+ * O(1/eps) applications of A where classical Monte Carlo needs O(1/eps^2)
+ * paths.
+ */
+
+#define QAE_MIN_QUBITS 2
+#define QAE_MAX_QUBITS 24          // Price register; the state adds the payoff qubit
+#define QAE_DEFAULT_QUBITS 8
+#define QAE_DEFAULT_STD_DEVS 4.0   // Grid spans mean +/- 4 standard deviations of ln S_T
+#define QAE_DEFAULT_EPSILON 1e-3   // Target half-width on the amplitude a
+#define QAE_DEFAULT_ALPHA 0.05     // Confidence level 1 - alpha
+#define QAE_DEFAULT_SHOTS 100      // Measurements per round
+#define QAE_MAX_ROUNDS 100000      // Safety cap on estimation rounds
+
+// QAE pricing configuration
+typedef struct {
+    option_params_t option;  // Call, put, binary call or binary put; volatility > 0
+    int num_qubits;          // Price grid of 2^num_qubits points
+    double std_devs;         // Grid half-width in standard deviations of ln S_T
+    double epsilon;          // Target half-width on the amplitude, in (0, 0.5)
+    double alpha;            // Confidence level 1 - alpha, alpha in (0, 1)
+    int shots;               // Measurements per round
+    char seed[256];          // Seed for the measurement outcomes (empty = entropy)
+    int seed_length;
+} qae_config_t;
+
+// QAE pricing results
+typedef struct {
+    double price;              // Estimated discounted expected payoff
+    double price_lower;        // Confidence interval at level 1 - alpha
+    double price_upper;
+    double exact_price;        // Exact expectation over the discretized distribution
+    double amplitude;          // Estimated a
+    double exact_amplitude;    // Exact a of the loaded state
+    double payoff_std_dev;     // Std deviation of the discounted payoff on the grid
+    size_t oracle_calls;       // Applications of A, sum over shots of 2k + 1
+    size_t grover_iterations;  // Fused Q iterations run on the simulator
+    int rounds;                // Estimation rounds
+    int max_power;             // Largest k used
+    double classical_paths;    // Monte Carlo paths for the same half-width and confidence
+    double elapsed_seconds;    // Wall time
+} qae_results_t;
+
+// Function declarations
+void init_qae_config(qae_config_t *config);
+
+/*
+ * Price config->option by iterative amplitude estimation.  Returns NaN
+ * prices for invalid input (including path-dependent option types).
+ */
+qae_results_t run_qae_pricing(const qae_config_t *config);
+
+void print_qae_results(FILE *output, const qae_results_t *results, const qae_config_t *config);
+
+#endif /* QAE_PRICING_H */
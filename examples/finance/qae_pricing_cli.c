@@ -0,0 +1,187 @@
+/*
+ * qae_pricing_cli.c - Command-line front end for the quantum amplitude
+ * estimation pricer (qae_pricing.c).
+ *
+ * This file only provides main(), argument parsing and the benchmark
+ * tables.  All numerical work is done by the functions declared in
+ * qae_pricing.h:
+ *
+ *   init_qae_config()    - fill a config with sensible defaults
+ *   run_qae_pricing()    - load the payoff state and run iterative QAE
+ *   print_qae_results()  - human-readable report
+ *
+ * Build (see the finance README / Makefile target `qae_pricing`):
+ *   links against qae_pricing.o, options_pricing.o, heston_model.o and the
+ *   quantum RNG lib.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <getopt.h>
+
+#include "qae_pricing.h"
+
+static void usage(const char *prog) {
+    printf(
+"Usage: %s [options]\n"
+"\n"
+"Prices a European option by quantum amplitude estimation on the state-vector\n"
+"simulator and compares the oracle calls it needs with the Monte Carlo paths\n"
+"that reach the same confidence interval.\n"
+"\n"
+"Option:\n"
+"  -S <spot>        Spot price                           (default %.2f)\n"
+"  -K <strike>      Strike price                         (default %.2f)\n"
+"  -T <years>       Time to maturity                     (default %.2f)\n"
+"  -v <vol>         Volatility, e.g. 0.2                 (default %.2f)\n"
+"  -r <rate>        Risk-free rate                       (default %.2f)\n"
+"  -q <yield>       Dividend yield                       (default %.2f)\n"
+"  -y <type>        call, put, binary_call, binary_put   (default call)\n"
+"\n"
+"Estimation:\n"
+"  -n <qubits>      Price register qubits, %d..%d          (default %d)\n"
+"  -e <epsilon>     Target half-width on the amplitude   (default %.0e)\n"
+"  -a <alpha>       Confidence level 1 - alpha           (default %.2f)\n"
+"  -N <shots>       Measurements per round               (default %d)\n"
+"  -s <seed>        Seed for measurement outcomes (omit for hardware entropy)\n"
+"  -b               Benchmark: oracle calls vs Monte Carlo paths over a range\n"
+"                   of epsilon, then simulator throughput up to -n qubits\n"
+"  -h               Show this help and exit\n",
+        prog,
+        DEFAULT_SPOT_PRICE, DEFAULT_STRIKE_PRICE, DEFAULT_TIME_TO_MATURITY,
+        DEFAULT_VOLATILITY, DEFAULT_RISK_FREE_RATE, DEFAULT_DIVIDEND_YIELD,
+        QAE_MIN_QUBITS, QAE_MAX_QUBITS, QAE_DEFAULT_QUBITS,
+        QAE_DEFAULT_EPSILON, QAE_DEFAULT_ALPHA, QAE_DEFAULT_SHOTS);
+}
+
+/* Map an option-type name to the enum; returns -1 on an unknown name. */
+static int parse_option_type(const char *s, option_type_t *out) {
+    static const struct { const char *name; option_type_t type; } table[] = {
+        { "call",        OPTION_CALL },
+        { "put",         OPTION_PUT },
+        { "binary_call", OPTION_BINARY_CALL },
+        { "binary_put",  OPTION_BINARY_PUT },
+    };
+    for (size_t i = 0; i < sizeof(table) / sizeof(table[0]); i++) {
+        if (strcmp(s, table[i].name) == 0) {
+            *out = table[i].type;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Oracle calls against Monte Carlo paths as epsilon shrinks: QAE cost grows
+ * as 1/eps and Monte Carlo as 1/eps^2, so the ratio widens tenfold for
+ * every tenfold tightening.  Then the simulator stress test: fused Grover
+ * iterations per second as the state grows.
+ */
+static int run_benchmark(const qae_config_t *base) {
+    static const double epsilons[] = { 1e-2, 3e-3, 1e-3, 3e-4, 1e-4 };
+    qae_config_t config = *base;
+
+    printf("\nOracle calls vs Monte Carlo paths (%d qubits, %.0f%% confidence)\n",
+           config.num_qubits, 100.0 * (1.0 - config.alpha));
+    printf("%10s %10s %10s %12s %14s %8s\n",
+           "epsilon", "price", "half-width", "oracle calls", "MC paths", "ratio");
+    for (size_t i = 0; i < sizeof(epsilons) / sizeof(epsilons[0]); i++) {
+        config.epsilon = epsilons[i];
+        qae_results_t r = run_qae_pricing(&config);
+        if (r.rounds == 0) return 1;
+        printf("%10.0e %10.4f %10.4f %12zu %14.0f %7.1fx\n", epsilons[i], r.price,
+               0.5 * (r.price_upper - r.price_lower), r.oracle_calls, r.classical_paths,
+               r.classical_paths / r.oracle_calls);
+    }
+
+    printf("\nSimulator throughput (epsilon %.0e)\n", base->epsilon);
+    printf("%8s %12s %12s %14s %12s\n", "qubits", "iterations", "seconds", "iterations/s", "GB/s");
+    config.epsilon = base->epsilon;
+    for (int n = QAE_MIN_QUBITS + 6; n <= base->num_qubits; n += 2) {
+        config.num_qubits = n;
+        qae_results_t r = run_qae_pricing(&config);
+        if (r.rounds == 0) return 1;
+        double rate = r.grover_iterations / r.elapsed_seconds;
+        // Two passes per iteration: read psi and the state, then write the state
+        double bytes = 5.0 * 16.0 * (double)((size_t)2 << n);
+        printf("%8d %12zu %12.3f %14.1f %12.2f\n", n + 1, r.grover_iterations,
+               r.elapsed_seconds, rate, rate * bytes / 1e9);
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    qae_config_t config;
+    init_qae_config(&config);
+    int benchmark = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "S:K:T:v:r:q:y:n:e:a:N:s:bh")) != -1) {
+        switch (opt) {
+            case 'S': config.option.spot_price = atof(optarg); break;
+            case 'K': config.option.strike_price = atof(optarg); break;
+            case 'T': config.option.time_to_maturity = atof(optarg); break;
+            case 'v': config.option.volatility = atof(optarg); break;
+            case 'r': config.option.risk_free_rate = atof(optarg); break;
+            case 'q': config.option.dividend_yield = atof(optarg); break;
+            case 'y':
+                if (parse_option_type(optarg, &config.option.type) != 0) {
+                    fprintf(stderr, "Unknown option type '%s' (use call, put, "
+                                    "binary_call or binary_put)\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'n': config.num_qubits = atoi(optarg); break;
+            case 'e': config.epsilon = atof(optarg); break;
+            case 'a': config.alpha = atof(optarg); break;
+            case 'N': config.shots = atoi(optarg); break;
+            case 's':
+                strncpy(config.seed, optarg, sizeof(config.seed) - 1);
+                config.seed[sizeof(config.seed) - 1] = '\0';
+                config.seed_length = (int)strlen(config.seed);
+                break;
+            case 'b': benchmark = 1; break;
+            case 'h': usage(argv[0]); return 0;
+            default:  usage(argv[0]); return 1;
+        }
+    }
+
+    /* Validate before touching the engine so errors are actionable. */
+    if (config.option.spot_price <= 0.0 || config.option.strike_price <= 0.0) {
+        fprintf(stderr, "Error: spot (-S) and strike (-K) must be positive.\n");
+        return 1;
+    }
+    if (config.option.time_to_maturity <= 0.0 || config.option.volatility <= 0.0) {
+        fprintf(stderr, "Error: maturity (-T) and volatility (-v) must be positive.\n");
+        return 1;
+    }
+    if (config.num_qubits < QAE_MIN_QUBITS || config.num_qubits > QAE_MAX_QUBITS) {
+        fprintf(stderr, "Error: qubits (-n) must be between %d and %d.\n",
+                QAE_MIN_QUBITS, QAE_MAX_QUBITS);
+        return 1;
+    }
+    if (config.epsilon <= 0.0 || config.epsilon >= 0.5 ||
+        config.alpha <= 0.0 || config.alpha >= 1.0 || config.shots < 1) {
+        fprintf(stderr, "Error: need 0 < epsilon (-e) < 0.5, 0 < alpha (-a) < 1 "
+                        "and shots (-N) >= 1.\n");
+        return 1;
+    }
+
+    if (benchmark) return run_benchmark(&config);
+
+    qae_results_t results = run_qae_pricing(&config);
+    if (results.rounds == 0) {
+        fprintf(stderr, "Error: amplitude estimation failed (out of memory?).\n");
+        return 1;
+    }
+    print_qae_results(stdout, &results, &config);
+
+    if (config.option.type == OPTION_CALL || config.option.type == OPTION_PUT) {
+        double bs = black_scholes_price(&config.option);
+        printf("Black-Scholes:     %.4f (grid discretization error %.4f)\n",
+               bs, results.exact_price - bs);
+    }
+    return 0;
+}
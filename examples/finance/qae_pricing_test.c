@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <assert.h>
+#include "qae_pricing.h"
+#include "../../src/quantum_rng/quantum_state.h"
+#include "../../src/quantum_rng/quantum_gates.h"
+#include "../../src/quantum_rng/grover.h"
+
+// Helper functions
+static void print_test_header(const char* test_name) {
+    printf("\n=== %s ===\n", test_name);
+}
+
+static void print_test_result(const char* test_name, int success) {
+    printf("%s: %s\n", test_name, success ? "PASS" : "FAIL");
+}
+
+// NaN test that survives -ffast-math (which folds isnan() to 0)
+static int is_nan_bits(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (bits & 0x7ff0000000000000ULL) == 0x7ff0000000000000ULL &&
+           (bits & 0x000fffffffffffffULL) != 0;
+}
+
+static void set_seed(qae_config_t *config, const char *seed) {
+    strncpy(config->seed, seed, sizeof(config->seed) - 1);
+    config->seed_length = (int)strlen(config->seed);
+}
+
+// The fused iteration rotates by 2 theta: P(good) = sin^2((2k+1) theta),
+// and matches the unfused oracle (Z on the good qubit) plus reflection
+static void test_fused_iteration() {
+    print_test_header("Fused Amplitude Amplification");
+
+    const size_t qubits = 7, good = 6;
+    quantum_state_t psi, fused, unfused;
+    assert(quantum_state_init(&psi, qubits) == QS_SUCCESS);
+    double norm = 0.0;
+    for (size_t i = 0; i < psi.state_dim; i++) {
+        double w = 1.0 + 0.5 * sin(0.37 * i) + ((i >> good) & 1 ? 0.0 : 2.0);
+        psi.amplitudes[i] = w;
+        norm += w * w;
+    }
+    double a = 0.0;
+    for (size_t i = 0; i < psi.state_dim; i++) {
+        psi.amplitudes[i] /= sqrt(norm);
+        if ((i >> good) & 1) a += creal(psi.amplitudes[i]) * creal(psi.amplitudes[i]);
+    }
+    double theta = asin(sqrt(a));
+    assert(quantum_state_clone(&fused, &psi) == QS_SUCCESS);
+    assert(quantum_state_clone(&unfused, &psi) == QS_SUCCESS);
+
+    double worst = 0.0, worst_diff = 0.0;
+    for (int k = 1; k <= 40; k++) {
+        assert(grover_amplification_iteration(&fused, &psi, good) == QS_SUCCESS);
+        assert(gate_pauli_z(&unfused, (int)good) == QS_SUCCESS);
+        assert(grover_reflect_about(&unfused, &psi) == QS_SUCCESS);
+
+        double p = 0.0;
+        for (size_t i = 0; i < fused.state_dim; i++) {
+            if ((i >> good) & 1) p += cabs(fused.amplitudes[i]) * cabs(fused.amplitudes[i]);
+            double d = cabs(fused.amplitudes[i] - unfused.amplitudes[i]);
+            if (d > worst_diff) worst_diff = d;
+        }
+        double expected = pow(sin((2 * k + 1) * theta), 2.0);
+        if (fabs(p - expected) > worst) worst = fabs(p - expected);
+    }
+    printf("a = %.6f, max |P - sin^2((2k+1)theta)| over 40 iterations: %.2e\n", a, worst);
+    printf("Max fused/unfused amplitude difference: %.2e\n", worst_diff);
+    assert(worst < 1e-10);
+    assert(worst_diff < 1e-10);
+    assert(quantum_state_is_normalized(&fused, 1e-10));
+
+    assert(grover_amplification_iteration(&fused, &psi, qubits) == QS_ERROR_INVALID_QUBIT);
+
+    quantum_state_free(&psi);
+    quantum_state_free(&fused);
+    quantum_state_free(&unfused);
+    print_test_result("Fused amplitude amplification", 1);
+}
+
+// The loaded distribution converges to Black-Scholes as the grid refines,
+// down to the error of truncating ln S_T at +/- std_devs
+static void test_payoff_loading() {
+    print_test_header("Payoff Loading");
+
+    qae_config_t config;
+    init_qae_config(&config);
+    set_seed(&config, "qae-loading");
+    config.epsilon = 0.01;
+    double bs = black_scholes_price(&config.option);
+
+    double first = 0.0, error = 0.0;
+    printf("%8s %10s %12s %12s\n", "qubits", "std devs", "grid price", "BS error");
+    for (int n = 4; n <= 12; n += 2) {
+        config.num_qubits = n;
+        qae_results_t r = run_qae_pricing(&config);
+        assert(!is_nan_bits(r.price));
+        error = fabs(r.exact_price - bs);
+        if (n == 4) first = error;
+        printf("%8d %10.1f %12.6f %12.2e\n", n, config.std_devs, r.exact_price, error);
+    }
+    assert(error < 1e-2 && error < 0.1 * first);
+
+    config.std_devs = 6.0;
+    qae_results_t wide = run_qae_pricing(&config);
+    printf("%8d %10.1f %12.6f %12.2e\n", config.num_qubits, config.std_devs,
+           wide.exact_price, fabs(wide.exact_price - bs));
+    assert(fabs(wide.exact_price - bs) < error);
+    config.std_devs = QAE_DEFAULT_STD_DEVS;
+
+    // Put-call parity holds on the grid up to the truncated tails
+    config.num_qubits = 10;
+    qae_results_t call = run_qae_pricing(&config);
+    config.option.type = OPTION_PUT;
+    qae_results_t put = run_qae_pricing(&config);
+    const option_params_t *o = &config.option;
+    double parity = o->spot_price * exp(-o->dividend_yield * o->time_to_maturity) -
+                    o->strike_price * exp(-o->risk_free_rate * o->time_to_maturity);
+    printf("Grid C - P = %.6f, S e^-qT - K e^-rT = %.6f\n",
+           call.exact_price - put.exact_price, parity);
+    assert(fabs(call.exact_price - put.exact_price - parity) < 1e-2);
+
+    print_test_result("Payoff loading", 1);
+}
+
+// Iterative QAE: the interval covers the exact amplitude and meets epsilon
+static void test_estimation_accuracy() {
+    print_test_header("Estimation Accuracy");
+
+    static const option_type_t types[] = { OPTION_CALL, OPTION_PUT, OPTION_BINARY_CALL };
+    static const char *seeds[] = { "qae-1", "qae-2", "qae-3", "qae-4" };
+    qae_config_t config;
+    init_qae_config(&config);
+
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        config.option.type = types[t];
+        for (size_t s = 0; s < sizeof(seeds) / sizeof(seeds[0]); s++) {
+            set_seed(&config, seeds[s]);
+            qae_results_t r = run_qae_pricing(&config);
+            double half = 0.5 * (r.price_upper - r.price_lower);
+            printf("%-12s %-6s price %.5f in [%.5f, %.5f], exact %.5f, a err %.1e, k max %d\n",
+                   get_option_type_name(types[t]), seeds[s], r.price, r.price_lower,
+                   r.price_upper, r.exact_price, fabs(r.amplitude - r.exact_amplitude),
+                   r.max_power);
+            assert(r.price_lower <= r.exact_price && r.exact_price <= r.price_upper);
+            assert(fabs(r.amplitude - r.exact_amplitude) <= config.epsilon);
+            assert(half > 0.0);
+            assert(r.oracle_calls > 0 && r.grover_iterations == (size_t)r.max_power);
+        }
+    }
+
+    // Same seed, same measurement record
+    set_seed(&config, "qae-repeat");
+    qae_results_t first = run_qae_pricing(&config);
+    qae_results_t second = run_qae_pricing(&config);
+    assert(first.price == second.price && first.oracle_calls == second.oracle_calls);
+
+    print_test_result("Estimation accuracy", 1);
+}
+
+// Oracle calls grow as 1/eps, Monte Carlo paths as 1/eps^2
+static void test_query_scaling() {
+    print_test_header("Query Scaling");
+
+    qae_config_t config;
+    init_qae_config(&config);
+    set_seed(&config, "qae-scaling");
+
+    config.epsilon = 1e-2;
+    qae_results_t coarse = run_qae_pricing(&config);
+    config.epsilon = 1e-4;
+    qae_results_t fine = run_qae_pricing(&config);
+
+    double qae_growth = (double)fine.oracle_calls / coarse.oracle_calls;
+    double mc_growth = fine.classical_paths / coarse.classical_paths;
+    printf("eps 1e-2: %zu oracle calls vs %.0f MC paths\n", coarse.oracle_calls, coarse.classical_paths);
+    printf("eps 1e-4: %zu oracle calls vs %.0f MC paths\n", fine.oracle_calls, fine.classical_paths);
+    printf("100x tighter: oracle calls x%.0f, MC paths x%.0f\n", qae_growth, mc_growth);
+    assert(qae_growth < 400.0);        // ~100 for O(1/eps), up to interval luck
+    assert(mc_growth > 2000.0);        // ~10000 for O(1/eps^2)
+    assert(fine.classical_paths > 10.0 * fine.oracle_calls);
+
+    print_test_result("Query scaling", 1);
+}
+
+static void test_error_handling() {
+    print_test_header("Error Handling");
+
+    qae_config_t config;
+    init_qae_config(&config);
+
+    config.option.type = OPTION_ASIAN_CALL;   // Path-dependent: not a terminal payoff
+    assert(is_nan_bits(run_qae_pricing(&config).price));
+    config.option.type = OPTION_CALL;
+
+    config.option.volatility = 0.0;
+    assert(is_nan_bits(run_qae_pricing(&config).price));
+    config.option.volatility = 0.2;
+
+    config.num_qubits = QAE_MAX_QUBITS + 1;
+    assert(is_nan_bits(run_qae_pricing(&config).price));
+    config.num_qubits = QAE_DEFAULT_QUBITS;
+
+    config.epsilon = 0.0;
+    assert(is_nan_bits(run_qae_pricing(&config).price));
+    config.epsilon = QAE_DEFAULT_EPSILON;
+
+    config.shots = 0;
+    assert(is_nan_bits(run_qae_pricing(&config).price));
+
+    print_test_result("Error handling", 1);
+}
+
+int main() {
+    printf("=== QAE Pricing Test Suite ===\n");
+
+    test_fused_iteration();
+    test_payoff_loading();
+    test_estimation_accuracy();
+    test_query_scaling();
+    test_error_handling();
+
+    printf("\nAll tests completed successfully!\n");
+    return 0;
+}
@@ -1,10 +1,14 @@
 #include "quantum_portfolio.h"
 #include "../../src/quantum_rng/quantum_rng.h"
+#include "../../src/scheduler/task_pool.h"
+#include "../../src/common/keyed_stream.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <getopt.h>
 #include <math.h>
+#include <time.h>
 
 // Sample asset data for demonstration
 const char *DEFAULT_ASSET_NAMES[] = {
@@ -23,6 +27,12 @@ const double DEFAULT_VOLATILITIES[] = {
     0.35, 0.30, 0.18, 0.16, 0.15
 };
 
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
 /*
  * Draw a standard normal variate N(0,1) using the Box-Muller transform.
  * Two uniforms produce two independent normals; the second is cached so
@@ -95,6 +105,8 @@ void init_portfolio_config(portfolio_config_t *config) {
     config->output_file[0] = '\0';
     config->show_efficient_frontier = 0;
     config->show_rebalancing = 0;
+    config->num_candidates = DEFAULT_NUM_CANDIDATES;
+    config->num_threads = 0;
 }
 
 void free_portfolio_config(portfolio_config_t *config) {
@@ -130,6 +142,9 @@ void print_portfolio_usage(const char *program_name) {
     printf("  -P, --no-progress     Hide progress bar\n");
     printf("  -E, --frontier        Show efficient frontier\n");
     printf("  -B, --rebalance       Show rebalancing suggestions\n");
+    printf("  -C, --candidates N    Random portfolios screened before the GA (0-%d, default: %d)\n",
+           MAX_CANDIDATES, DEFAULT_NUM_CANDIDATES);
+    printf("  -p, --threads N       Worker threads (0 = shared pool, default: 0)\n");
     printf("  -o, --output FILE     Write output to file\n");
     printf("  -h, --help            Show this help message\n");
 }
@@ -150,6 +165,8 @@ void parse_portfolio_args(int argc, char *argv[], portfolio_config_t *config) {
         {"no-progress", no_argument,       0, 'P'},
         {"frontier",    no_argument,       0, 'E'},
         {"rebalance",   no_argument,       0, 'B'},
+        {"candidates",  required_argument, 0, 'C'},
+        {"threads",     required_argument, 0, 'p'},
         {"output",      required_argument, 0, 'o'},
         {"help",        no_argument,       0, 'h'},
         {0, 0, 0, 0}
@@ -158,7 +175,7 @@ void parse_portfolio_args(int argc, char *argv[], portfolio_config_t *config) {
     int option_index = 0;
     int c;
 
-    while ((c = getopt_long(argc, argv, "n:s:t:r:R:T:S:qvjcPEBo:h",
+    while ((c = getopt_long(argc, argv, "n:s:t:r:R:T:S:qvjcPEBC:p:o:h",
            long_options, &option_index)) != -1) {
         switch (c) {
             case 'n':
@@ -241,6 +258,23 @@ void parse_portfolio_args(int argc, char *argv[], portfolio_config_t *config) {
                 config->show_rebalancing = 1;
                 break;
 
+            case 'C':
+                config->num_candidates = atoi(optarg);
+                if (config->num_candidates < 0 || config->num_candidates > MAX_CANDIDATES) {
+                    fprintf(stderr, "Error: Number of candidates must be between 0 and %d\n",
+                            MAX_CANDIDATES);
+                    exit(1);
+                }
+                break;
+
+            case 'p':
+                config->num_threads = atoi(optarg);
+                if (config->num_threads < 0) {
+                    fprintf(stderr, "Error: Number of threads must not be negative\n");
+                    exit(1);
+                }
+                break;
+
             case 'o':
                 strncpy(config->output_file, optarg, sizeof(config->output_file) - 1);
                 config->output_file[sizeof(config->output_file) - 1] = '\0';
@@ -287,20 +321,123 @@ void calculate_portfolio_metrics(portfolio_metrics_t *metrics,
         : 0.0;
 }
 
-// Generate random portfolio weights using quantum randomness
-static void generate_random_weights(qrng_ctx *ctx, double *weights, int num_assets) {
-    double sum = 0;
-    for (int i = 0; i < num_assets; i++) {
-        weights[i] = qrng_double(ctx);
-        sum += weights[i];
+/*
+ * Covariance in one contiguous row-major block, Sigma_ij = s_i s_j rho_ij,
+ * with rows padded with zeros to a multiple of PORTFOLIO_LANES so every
+ * row starts aligned and the inner loops need no remainder.  Candidate
+ * weight vectors use the same stride.
+ */
+typedef struct {
+    int n;
+    int stride;
+    double *cov;   // n x stride
+    double *mu;    // stride expected returns
+} packed_covariance_t;
+
+static void pack_covariance(packed_covariance_t *pc, const portfolio_config_t *config) {
+    int n = config->num_assets;
+    pc->n = n;
+    pc->stride = (n + PORTFOLIO_LANES - 1) / PORTFOLIO_LANES * PORTFOLIO_LANES;
+    pc->cov = calloc((size_t)n * pc->stride, sizeof(double));
+    pc->mu = calloc(pc->stride, sizeof(double));
+    if (!pc->cov || !pc->mu) {
+        fprintf(stderr, "Error: out of memory packing covariance\n");
+        exit(1);
     }
-    if (sum <= 0.0) {           // All-zero draw is astronomically unlikely; be safe
-        for (int i = 0; i < num_assets; i++) weights[i] = 1.0 / num_assets;
-        return;
+    for (int i = 0; i < n; i++) {
+        pc->mu[i] = config->assets[i].expected_return;
+        for (int j = 0; j < n; j++) {
+            pc->cov[(size_t)i * pc->stride + j] = config->assets[i].volatility *
+                config->assets[j].volatility * config->assets[i].correlations[j];
+        }
+    }
+}
+
+static void free_packed_covariance(packed_covariance_t *pc) {
+    free(pc->cov);
+    free(pc->mu);
+}
+
+/*
+ * Expected return and variance w' Sigma w of count candidates, the rows
+ * of w.  Four candidates share each pass over a covariance row, so Sigma
+ * is read once per four portfolios (a GEMV over four right-hand sides);
+ * the unit-stride inner loops vectorize.
+ */
+static void evaluate_candidates(const packed_covariance_t *pc, const double *w,
+                                size_t count, double *ret, double *var) {
+    size_t stride = (size_t)pc->stride;
+    size_t full = count & ~(size_t)3;
+    for (size_t b = 0; b < full; b += 4) {
+        const double *w0 = w + b * stride, *w1 = w0 + stride;
+        const double *w2 = w1 + stride, *w3 = w2 + stride;
+        double v0 = 0.0, v1 = 0.0, v2 = 0.0, v3 = 0.0;
+        for (int i = 0; i < pc->n; i++) {
+            const double *row = pc->cov + (size_t)i * stride;
+            double y0 = 0.0, y1 = 0.0, y2 = 0.0, y3 = 0.0;
+            for (size_t j = 0; j < stride; j++) {
+                y0 += row[j] * w0[j];
+                y1 += row[j] * w1[j];
+                y2 += row[j] * w2[j];
+                y3 += row[j] * w3[j];
+            }
+            v0 += w0[i] * y0;
+            v1 += w1[i] * y1;
+            v2 += w2[i] * y2;
+            v3 += w3[i] * y3;
+        }
+        double r0 = 0.0, r1 = 0.0, r2 = 0.0, r3 = 0.0;
+        for (size_t j = 0; j < stride; j++) {
+            r0 += pc->mu[j] * w0[j];
+            r1 += pc->mu[j] * w1[j];
+            r2 += pc->mu[j] * w2[j];
+            r3 += pc->mu[j] * w3[j];
+        }
+        var[b] = v0;
+        var[b + 1] = v1;
+        var[b + 2] = v2;
+        var[b + 3] = v3;
+        ret[b] = r0;
+        ret[b + 1] = r1;
+        ret[b + 2] = r2;
+        ret[b + 3] = r3;
     }
-    // Normalize weights
-    for (int i = 0; i < num_assets; i++) {
-        weights[i] /= sum;
+    for (size_t b = full; b < count; b++) {
+        const double *wb = w + b * stride;
+        double v = 0.0;
+        for (int i = 0; i < pc->n; i++) {
+            const double *row = pc->cov + (size_t)i * stride;
+            double y = 0.0;
+            for (size_t j = 0; j < stride; j++) y += row[j] * wb[j];
+            v += wb[i] * y;
+        }
+        double r = 0.0;
+        for (size_t j = 0; j < stride; j++) r += pc->mu[j] * wb[j];
+        var[b] = v;
+        ret[b] = r;
+    }
+}
+
+/*
+ * count weight vectors uniform on the simplex, i.e. Dirichlet(1, ..., 1):
+ * normalized Exp(1) draws.  (Normalizing plain uniforms, as the GA used
+ * to, crowds the samples toward equal weights.)  u is mapped to (0, 1] so
+ * log() never sees 0; padding lanes stay zero.
+ */
+static void sample_simplex(keyed_stream_t *ws, double *w, size_t count, int n, int stride) {
+    for (size_t b = 0; b < count; b++) {
+        double *wb = w + b * (size_t)stride;
+        for (int j = 0; j < n; j++) {
+            wb[j] = (double)((keyed_stream_next(ws) >> 11) + 1) * (1.0 / 9007199254740992.0);
+        }
+        double sum = 0.0;
+        for (int j = 0; j < n; j++) {
+            wb[j] = -log(wb[j]);
+            sum += wb[j];
+        }
+        double inv = 1.0 / sum;
+        for (int j = 0; j < n; j++) wb[j] *= inv;
+        for (int j = n; j < stride; j++) wb[j] = 0.0;
     }
 }
 
@@ -312,45 +449,47 @@ static void generate_random_weights(qrng_ctx *ctx, double *weights, int num_asse
  */
 #define TARGET_RETURN_PENALTY 25.0
 
-static double ga_fitness(const portfolio_metrics_t *m, double target_return, int target_mode) {
+static double ga_fitness(double ret, double var, double risk_free_rate,
+                         double target_return, int target_mode) {
+    double vol = sqrt(fmax(var, 0.0));
     if (target_mode) {
-        return -(m->volatility + TARGET_RETURN_PENALTY * fabs(m->expected_return - target_return));
+        return -(vol + TARGET_RETURN_PENALTY * fabs(ret - target_return));
     }
-    return m->sharpe_ratio;
+    return vol > 0.0 ? (ret - risk_free_rate) / vol : 0.0;
 }
 
-// Pick the fitter of two quantum-randomly chosen population members
-static int tournament_select(qrng_ctx *ctx, const double *fitness) {
-    int a = (int)(qrng_uint64(ctx) % POPULATION_SIZE);
-    int b = (int)(qrng_uint64(ctx) % POPULATION_SIZE);
+// Pick the fitter of two randomly chosen population members
+static int tournament_select(keyed_stream_t *ws, const double *fitness) {
+    int a = (int)(keyed_stream_next(ws) % POPULATION_SIZE);
+    int b = (int)(keyed_stream_next(ws) % POPULATION_SIZE);
     return fitness[a] >= fitness[b] ? a : b;
 }
 
 /*
- * Quantum-enhanced genetic algorithm over the weight simplex.
- * Writes the best weights found into best_weights and returns their fitness.
+ * Genetic algorithm over the weight simplex.  The first num_seeds members
+ * of the initial population are copied from seeds (stride doubles each);
+ * the rest are sampled uniformly on the simplex.  Each generation is
+ * evaluated as one batch.  Writes the best weights found into best_weights
+ * (num_assets doubles) and returns their fitness.
  */
-static double ga_optimize(const portfolio_config_t *config, qrng_ctx *ctx,
-                          int iterations, int target_mode, double target_return,
+static double ga_optimize(const portfolio_config_t *config, const packed_covariance_t *pc,
+                          keyed_stream_t *ws, int iterations, int target_mode,
+                          double target_return, const double *seeds, int num_seeds,
                           double *best_weights, int show_progress) {
-    int n = config->num_assets;
-
-    double **population = malloc(POPULATION_SIZE * sizeof(double*));
-    double **next_population = malloc(POPULATION_SIZE * sizeof(double*));
-    double *fitness = malloc(POPULATION_SIZE * sizeof(double));
-    if (!population || !next_population || !fitness) {
+    int n = pc->n;
+    size_t stride = (size_t)pc->stride;
+
+    double *population = malloc(POPULATION_SIZE * stride * sizeof(double));
+    double *next_population = malloc(POPULATION_SIZE * stride * sizeof(double));
+    double *best = malloc(stride * sizeof(double));
+    double ret[POPULATION_SIZE], var[POPULATION_SIZE], fitness[POPULATION_SIZE];
+    if (!population || !next_population || !best) {
         fprintf(stderr, "Error: out of memory in optimizer\n");
         exit(1);
     }
-    for (int i = 0; i < POPULATION_SIZE; i++) {
-        population[i] = malloc(n * sizeof(double));
-        next_population[i] = malloc(n * sizeof(double));
-        if (!population[i] || !next_population[i]) {
-            fprintf(stderr, "Error: out of memory in optimizer\n");
-            exit(1);
-        }
-        generate_random_weights(ctx, population[i], n);
-    }
+    if (num_seeds > POPULATION_SIZE) num_seeds = POPULATION_SIZE;
+    if (num_seeds > 0) memcpy(population, seeds, num_seeds * stride * sizeof(double));
+    sample_simplex(ws, population + num_seeds * stride, POPULATION_SIZE - num_seeds, n, pc->stride);
 
     double best_fitness = -INFINITY;
     int progress_step = iterations / 100;
@@ -358,14 +497,13 @@ static double ga_optimize(const portfolio_config_t *config, qrng_ctx *ctx,
 
     for (int gen = 0; gen < iterations; gen++) {
         // Evaluate fitness
+        evaluate_candidates(pc, population, POPULATION_SIZE, ret, var);
         for (int i = 0; i < POPULATION_SIZE; i++) {
-            portfolio_metrics_t metrics = {0};
-            calculate_portfolio_metrics(&metrics, population[i], config);
-            fitness[i] = ga_fitness(&metrics, target_return, target_mode);
-
+            fitness[i] = ga_fitness(ret[i], var[i], config->risk_free_rate,
+                                    target_return, target_mode);
             if (fitness[i] > best_fitness) {
                 best_fitness = fitness[i];
-                memcpy(best_weights, population[i], n * sizeof(double));
+                memcpy(best, population + i * stride, stride * sizeof(double));
             }
         }
 
@@ -375,37 +513,37 @@ static double ga_optimize(const portfolio_config_t *config, qrng_ctx *ctx,
         }
 
         // Elitism: carry the best-so-far portfolio into the next generation
-        memcpy(next_population[0], best_weights, n * sizeof(double));
+        memcpy(next_population, best, stride * sizeof(double));
 
         // Tournament selection + blend crossover + mutation
         for (int i = 1; i < POPULATION_SIZE; i++) {
-            const double *parent1 = population[tournament_select(ctx, fitness)];
-            const double *parent2 = population[tournament_select(ctx, fitness)];
+            const double *parent1 = population + tournament_select(ws, fitness) * stride;
+            const double *parent2 = population + tournament_select(ws, fitness) * stride;
 
-            double alpha = qrng_double(ctx);
-            double *child = next_population[i];
-            for (int j = 0; j < n; j++) {
+            double alpha = keyed_stream_double(ws);
+            double *child = next_population + i * stride;
+            for (size_t j = 0; j < stride; j++) {
                 child[j] = alpha * parent1[j] + (1.0 - alpha) * parent2[j];
             }
 
             // Mutation
-            if (qrng_double(ctx) < MUTATION_RATE) {
-                int asset = (int)(qrng_uint64(ctx) % n);
-                child[asset] = qrng_double(ctx);
+            if (keyed_stream_double(ws) < MUTATION_RATE) {
+                int asset = (int)(keyed_stream_next(ws) % n);
+                child[asset] = keyed_stream_double(ws);
             }
 
             // Renormalize onto the weight simplex
             double sum = 0.0;
             for (int j = 0; j < n; j++) sum += child[j];
             if (sum <= 0.0) {
-                generate_random_weights(ctx, child, n);
+                sample_simplex(ws, child, 1, n, pc->stride);
             } else {
                 for (int j = 0; j < n; j++) child[j] /= sum;
             }
         }
 
         // Swap generations
-        double **tmp = population;
+        double *tmp = population;
         population = next_population;
         next_population = tmp;
     }
@@ -414,17 +552,140 @@ static double ga_optimize(const portfolio_config_t *config, qrng_ctx *ctx,
         printf("\rOptimization progress: 100%%\n");
     }
 
-    for (int i = 0; i < POPULATION_SIZE; i++) {
-        free(population[i]);
-        free(next_population[i]);
-    }
+    memcpy(best_weights, best, n * sizeof(double));
     free(population);
     free(next_population);
-    free(fitness);
+    free(best);
 
     return best_fitness;
 }
 
+// Run fn over [0, n) inline, on a private pool of num_threads, or on the
+// shared task pool (the num_threads convention of monte_carlo.c)
+static void run_parallel(int num_threads, size_t n, task_range_fn fn, void *arg) {
+    if (num_threads == 1) {
+        fn(arg, 0, n);
+        return;
+    }
+    task_pool_t *pool = NULL;
+    if (num_threads > 1) {
+        task_pool_config_t pool_config;
+        task_pool_get_default_config(&pool_config);
+        pool_config.num_threads = (size_t)num_threads;
+        pool_config.affinity = TASK_POOL_AFFINITY_NONE;
+        if (task_pool_create(&pool, &pool_config) != TASK_POOL_SUCCESS) {
+            pool = NULL;  // Fall back to the shared pool
+        }
+    }
+    task_pool_parallel_for(pool, n, 1, fn, arg);
+    if (pool) task_pool_free(pool);
+}
+
+/*
+ * Candidate screening.  Block b samples CANDIDATE_BLOCK portfolios from
+ * its own keyed stream, evaluates them as one batch and keeps its best by
+ * Sharpe ratio; the block winners seed the GA population.
+ */
+typedef struct {
+    const portfolio_config_t *config;
+    const packed_covariance_t *pc;
+    const keyed_stream_t *keys;   // One per block
+    size_t num_candidates;
+    double *winners;               // num_blocks x stride
+    double *winner_fitness;        // num_blocks
+} screen_job_t;
+
+static void screen_blocks(void *arg, size_t begin, size_t end) {
+    screen_job_t *job = arg;
+    size_t stride = (size_t)job->pc->stride;
+    double *w = malloc(CANDIDATE_BLOCK * stride * sizeof(double));
+    double ret[CANDIDATE_BLOCK], var[CANDIDATE_BLOCK];
+    if (!w) {
+        fprintf(stderr, "Error: out of memory screening candidates\n");
+        exit(1);
+    }
+
+    for (size_t block = begin; block < end; block++) {
+        size_t count = job->num_candidates - block * CANDIDATE_BLOCK;
+        if (count > CANDIDATE_BLOCK) count = CANDIDATE_BLOCK;
+
+        keyed_stream_t ws = job->keys[block];
+        sample_simplex(&ws, w, count, job->pc->n, job->pc->stride);
+        evaluate_candidates(job->pc, w, count, ret, var);
+
+        size_t best = 0;
+        double best_fitness = -INFINITY;
+        for (size_t i = 0; i < count; i++) {
+            double f = ga_fitness(ret[i], var[i], job->config->risk_free_rate, 0.0, 0);
+            if (f > best_fitness) {
+                best_fitness = f;
+                best = i;
+            }
+        }
+        memcpy(job->winners + block * stride, w + best * stride, stride * sizeof(double));
+        job->winner_fitness[block] = best_fitness;
+    }
+    free(w);
+}
+
+/*
+ * Screen config->num_candidates random portfolios in parallel and write
+ * the fittest block winners (up to POPULATION_SIZE, best first) to seeds.
+ * Returns the number written; *err is set if the quantum RNG fails.
+ */
+static int screen_candidates(const portfolio_config_t *config, const packed_covariance_t *pc,
+                             qrng_ctx *ctx, double *seeds, qrng_error *err) {
+    *err = QRNG_SUCCESS;
+    size_t num_blocks = ((size_t)config->num_candidates + CANDIDATE_BLOCK - 1) / CANDIDATE_BLOCK;
+    if (num_blocks == 0) return 0;
+    size_t stride = (size_t)pc->stride;
+
+    screen_job_t job = {0};
+    job.config = config;
+    job.pc = pc;
+    job.num_candidates = (size_t)config->num_candidates;
+    keyed_stream_t *keys = malloc(num_blocks * sizeof(keyed_stream_t));
+    job.winners = malloc(num_blocks * stride * sizeof(double));
+    job.winner_fitness = malloc(num_blocks * sizeof(double));
+    if (!keys || !job.winners || !job.winner_fitness) {
+        fprintf(stderr, "Error: out of memory screening candidates\n");
+        exit(1);
+    }
+    // One quantum key per block, drawn in a fixed order from the seeded
+    // context, so results do not depend on the thread count
+    for (size_t b = 0; b < num_blocks; b++) {
+        *err = keyed_stream_key(&keys[b], ctx);
+        if (*err != QRNG_SUCCESS) {
+            free(keys);
+            free(job.winners);
+            free(job.winner_fitness);
+            return 0;
+        }
+    }
+    job.keys = keys;
+
+    run_parallel(config->num_threads, num_blocks, screen_blocks, &job);
+
+    // Partial selection sort: the few best of a few hundred winners
+    int num_seeds = num_blocks < POPULATION_SIZE ? (int)num_blocks : POPULATION_SIZE;
+    for (int s = 0; s < num_seeds; s++) {
+        size_t best = s;
+        for (size_t b = s + 1; b < num_blocks; b++) {
+            if (job.winner_fitness[b] > job.winner_fitness[best]) best = b;
+        }
+        double f = job.winner_fitness[best];
+        job.winner_fitness[best] = job.winner_fitness[s];
+        job.winner_fitness[s] = f;
+        memcpy(seeds + s * stride, job.winners + best * stride, stride * sizeof(double));
+        memcpy(job.winners + best * stride, job.winners + s * stride, stride * sizeof(double));
+    }
+
+    free(keys);
+    free(job.winners);
+    free(job.winner_fitness);
+    return num_seeds;
+}
+
 /*
  * Cholesky factorization (in place, row-major, lower triangle).
  * Returns 1 on success, 0 if the matrix is not positive definite.
@@ -448,6 +709,32 @@ static int cholesky_decompose(double *a, int n) {
     return 1;
 }
 
+/*
+ * Partial quickselect: reorder x so that x[k] is the value a full sort
+ * would put there, with x[0..k) all <= x[k] (in no particular order).
+ */
+static void select_smallest(double *x, int count, int k) {
+    int lo = 0, hi = count - 1;
+    while (lo < hi) {
+        double pivot = x[lo + (hi - lo) / 2];
+        int i = lo, j = hi;
+        while (i <= j) {
+            while (x[i] < pivot) i++;
+            while (x[j] > pivot) j--;
+            if (i <= j) {
+                double t = x[i];
+                x[i] = x[j];
+                x[j] = t;
+                i++;
+                j--;
+            }
+        }
+        if (k <= j) hi = j;
+        else if (k >= i) lo = i;
+        else return;
+    }
+}
+
 // Optimize portfolio using quantum-enhanced genetic algorithm
 portfolio_results_t optimize_portfolio(const portfolio_config_t *config) {
     portfolio_results_t results = {0};
@@ -470,9 +757,35 @@ portfolio_results_t optimize_portfolio(const portfolio_config_t *config) {
         exit(1);
     }
 
-    // Maximize the Sharpe ratio with the genetic algorithm
-    ga_optimize(config, ctx, MAX_ITERATIONS, 0, config->target_return,
-                results.weights, config->show_progress);
+    // Screen random portfolios, then maximize the Sharpe ratio with the
+    // genetic algorithm seeded by the best of them
+    packed_covariance_t pc;
+    pack_covariance(&pc, config);
+    double *seeds = malloc(POPULATION_SIZE * (size_t)pc.stride * sizeof(double));
+    if (!seeds) {
+        fprintf(stderr, "Error: out of memory allocating results\n");
+        exit(1);
+    }
+    double start = now_seconds();
+    int num_seeds = screen_candidates(config, &pc, ctx, seeds, &err);
+    keyed_stream_t ws;
+    if (err == QRNG_SUCCESS) err = keyed_stream_key(&ws, ctx);
+    if (err != QRNG_SUCCESS) {
+        fprintf(stderr, "Error: quantum RNG failed keying the optimizer: %s\n",
+                qrng_error_string(err));
+        free(seeds);
+        free_packed_covariance(&pc);
+        free_portfolio_results(&results);
+        qrng_free(ctx);
+        return (portfolio_results_t){0};
+    }
+    ga_optimize(config, &pc, &ws, MAX_ITERATIONS, 0, config->target_return,
+                seeds, num_seeds, results.weights, config->show_progress);
+    results.optimizer_seconds = now_seconds() - start;
+    results.candidates_evaluated = (long)config->num_candidates +
+                                   (long)MAX_ITERATIONS * POPULATION_SIZE;
+    free(seeds);
+    free_packed_covariance(&pc);
 
     // Calculate final metrics
     calculate_portfolio_metrics(&results.metrics, results.weights, config);
@@ -551,11 +864,11 @@ portfolio_results_t optimize_portfolio(const portfolio_config_t *config) {
     // Expected maximum drawdown over the horizon (mean across paths)
     results.metrics.max_drawdown = drawdown_sum / config->num_simulations;
 
-    // Calculate VaR and CVaR from the sorted return distribution
-    qsort(results.simulated_returns, config->num_simulations,
-          sizeof(double), compare_doubles);
+    // Calculate VaR and CVaR from the return distribution: only the 5%
+    // tail has to be ordered, so select it instead of sorting everything
     int var_index = (int)(0.05 * config->num_simulations);
     if (var_index < 1) var_index = 1;
+    select_smallest(results.simulated_returns, config->num_simulations, var_index);
     results.metrics.var_95 = -results.simulated_returns[var_index];
 
     double cvar_sum = 0;
@@ -574,15 +887,67 @@ portfolio_results_t optimize_portfolio(const portfolio_config_t *config) {
     return results;
 }
 
+/*
+ * Efficient frontier.  Each target return is an independent GA run in
+ * target mode with its own keyed weight stream, so the points are solved
+ * in parallel on the task pool.
+ */
+typedef struct {
+    const portfolio_config_t *config;
+    const packed_covariance_t *pc;
+    const keyed_stream_t *keys;   // One per point
+    double min_return;
+    double max_return;
+    int num_points;
+    double *returns;
+    double *risks;
+    size_t points_done;            // Progress (atomic)
+} frontier_job_t;
+
+static void solve_frontier_points(void *arg, size_t begin, size_t end) {
+    frontier_job_t *job = arg;
+    const portfolio_config_t *config = job->config;
+    double *weights = malloc(config->num_assets * sizeof(double));
+    if (!weights) {
+        fprintf(stderr, "Error: out of memory generating frontier\n");
+        exit(1);
+    }
+
+    for (size_t i = begin; i < end; i++) {
+        double target_return = job->min_return +
+                             (job->max_return - job->min_return) * i / (job->num_points - 1);
+
+        // Minimum-variance portfolio for this target return (GA in target
+        // mode, no Monte Carlo needed for the frontier itself)
+        keyed_stream_t ws = job->keys[i];
+        ga_optimize(config, job->pc, &ws, FRONTIER_ITERATIONS, 1, target_return,
+                    NULL, 0, weights, 0);
+
+        portfolio_metrics_t metrics = {0};
+        calculate_portfolio_metrics(&metrics, weights, config);
+        job->returns[i] = metrics.expected_return;
+        job->risks[i] = metrics.volatility;
+
+        if (config->show_progress) {
+            size_t done = __atomic_add_fetch(&job->points_done, 1, __ATOMIC_RELAXED);
+            if (done % 10 == 0) {
+                printf("\rFrontier progress: %zu%%", done * 100 / job->num_points);
+                fflush(stdout);
+            }
+        }
+    }
+    free(weights);
+}
+
 void generate_efficient_frontier(portfolio_results_t *results,
                                const portfolio_config_t *config) {
     const int num_points = 100;
     results->metrics.frontier_points = num_points;
     results->metrics.efficient_frontier_returns = malloc(num_points * sizeof(double));
     results->metrics.efficient_frontier_risks = malloc(num_points * sizeof(double));
-    double *weights = malloc(config->num_assets * sizeof(double));
+    keyed_stream_t *keys = malloc(num_points * sizeof(keyed_stream_t));
     if (!results->metrics.efficient_frontier_returns ||
-        !results->metrics.efficient_frontier_risks || !weights) {
+        !results->metrics.efficient_frontier_risks || !keys) {
         fprintf(stderr, "Error: out of memory generating frontier\n");
         exit(1);
     }
@@ -593,19 +958,37 @@ void generate_efficient_frontier(portfolio_results_t *results,
                                config->seed_length);
     if (err != QRNG_SUCCESS) {
         fprintf(stderr, "Failed to initialize quantum RNG: %s\n", qrng_error_string(err));
-        free(weights);
+        free(keys);
         results->metrics.frontier_points = 0;
         return;
     }
+    for (int i = 0; i < num_points; i++) {
+        err = keyed_stream_key(&keys[i], ctx);
+        if (err != QRNG_SUCCESS) {
+            fprintf(stderr, "Error: quantum RNG failed keying the frontier: %s\n",
+                    qrng_error_string(err));
+            qrng_free(ctx);
+            free(keys);
+            results->metrics.frontier_points = 0;
+            return;
+        }
+    }
+    qrng_free(ctx);
 
-    double min_return = INFINITY;
-    double max_return = -INFINITY;
+    frontier_job_t job = {0};
+    job.config = config;
+    job.keys = keys;
+    job.num_points = num_points;
+    job.returns = results->metrics.efficient_frontier_returns;
+    job.risks = results->metrics.efficient_frontier_risks;
+    job.min_return = INFINITY;
+    job.max_return = -INFINITY;
     for (int i = 0; i < config->num_assets; i++) {
-        if (config->assets[i].expected_return < min_return) {
-            min_return = config->assets[i].expected_return;
+        if (config->assets[i].expected_return < job.min_return) {
+            job.min_return = config->assets[i].expected_return;
         }
-        if (config->assets[i].expected_return > max_return) {
-            max_return = config->assets[i].expected_return;
+        if (config->assets[i].expected_return > job.max_return) {
+            job.max_return = config->assets[i].expected_return;
         }
     }
 
@@ -613,30 +996,17 @@ void generate_efficient_frontier(portfolio_results_t *results,
         printf("Generating efficient frontier (%d points)...\n", num_points);
     }
 
-    for (int i = 0; i < num_points; i++) {
-        double target_return = min_return +
-                             (max_return - min_return) * i / (num_points - 1);
-
-        // Minimum-variance portfolio for this target return (GA in target
-        // mode, no Monte Carlo needed for the frontier itself)
-        ga_optimize(config, ctx, FRONTIER_ITERATIONS, 1, target_return, weights, 0);
+    packed_covariance_t pc;
+    pack_covariance(&pc, config);
+    job.pc = &pc;
+    run_parallel(config->num_threads, num_points, solve_frontier_points, &job);
 
-        portfolio_metrics_t metrics = {0};
-        calculate_portfolio_metrics(&metrics, weights, config);
-        results->metrics.efficient_frontier_returns[i] = metrics.expected_return;
-        results->metrics.efficient_frontier_risks[i] = metrics.volatility;
-
-        if (config->show_progress && (i + 1) % 10 == 0) {
-            printf("\rFrontier progress: %d%%", (i + 1) * 100 / num_points);
-            fflush(stdout);
-        }
-    }
     if (config->show_progress) {
         printf("\rFrontier progress: 100%%\n");
     }
 
-    free(weights);
-    qrng_free(ctx);
+    free_packed_covariance(&pc);
+    free(keys);
 }
 
 void output_results_json(FILE *output, const portfolio_results_t *results,
@@ -772,6 +1142,10 @@ void print_results(FILE *output, const portfolio_results_t *results,
                        config->target_return * 100);
                 fprintf(output, "Risk Tolerance: %.2f\n",
                        config->risk_tolerance);
+                fprintf(output, "Candidates Evaluated: %ld (%.0f per second)\n",
+                       results->candidates_evaluated,
+                       results->optimizer_seconds > 0.0
+                           ? results->candidates_evaluated / results->optimizer_seconds : 0.0);
             }
             break;
     }
@@ -806,6 +1180,11 @@ int main(int argc, char *argv[]) {
     }
 
     portfolio_results_t results = optimize_portfolio(&config);
+    if (!results.weights) {
+        if (output != stdout) fclose(output);
+        free_portfolio_config(&config);
+        return 1;
+    }
     print_results(output, &results, &config);
 
     free_portfolio_results(&results);
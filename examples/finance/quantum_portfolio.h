@@ -25,6 +25,10 @@
 #define CONVERGENCE_THRESHOLD 1e-6
 #define POPULATION_SIZE 100
 #define MUTATION_RATE 0.1
+#define DEFAULT_NUM_CANDIDATES 100000  // Random portfolios screened to seed the GA
+#define MAX_CANDIDATES 100000000
+#define CANDIDATE_BLOCK 256            // Candidates per parallel task
+#define PORTFOLIO_LANES 4              // Covariance rows are padded to a multiple of this
 
 // Output modes
 typedef enum {
@@ -60,6 +64,8 @@ typedef struct {
     char output_file[1024];
     int show_efficient_frontier;
     int show_rebalancing;
+    int num_candidates;    // Random portfolios screened before the GA (0 = none)
+    int num_threads;       // 0 = shared task pool, 1 = calling thread only, N = N threads
 } portfolio_config_t;
 
 // Portfolio metrics
@@ -81,6 +87,8 @@ typedef struct {
     portfolio_metrics_t metrics;
     double *simulated_returns;
     int num_simulations;
+    long candidates_evaluated;     // Screened candidates plus GA fitness evaluations
+    double optimizer_seconds;      // Wall time of screening and the GA
 } portfolio_results_t;
 
 // Function declarations
@@ -0,0 +1,185 @@
+#include "chunk_cache.h"
+#include "../../src/scheduler/task_pool.h"
+#include <stdlib.h>
+
+/*
+ * Slots are indices into parallel arrays. Resident slots sit on a doubly
+ * linked LRU list (head = most recently used) and on a hash chain for
+ * their bucket; slots [resident, capacity) have never been used.
+ */
+struct chunk_cache {
+    size_t capacity;
+    size_t chunk_bytes;
+    chunk_generate_fn generate;
+    void *user;
+
+    unsigned char *data;        // capacity x chunk_bytes
+    int64_t *key_x, *key_y;
+    int32_t *lru_prev, *lru_next;
+    int32_t *hash_next;
+    int32_t *buckets;           // bucket_mask + 1 chain heads
+    int32_t *pending;           // Slots awaiting generation in a prefetch
+    size_t bucket_mask;
+    int32_t head, tail;
+
+    size_t resident;
+    uint64_t hits, misses, evictions;
+};
+
+static size_t bucket_of(const chunk_cache_t *cache, int64_t x, int64_t y) {
+    uint64_t h = (uint64_t)x * 0x9E3779B97F4A7C15ULL ^ (uint64_t)y * 0xC2B2AE3D27D4EB4FULL;
+    h ^= h >> 29;
+    return (size_t)h & cache->bucket_mask;
+}
+
+static int32_t find_slot(const chunk_cache_t *cache, int64_t x, int64_t y) {
+    int32_t s = cache->buckets[bucket_of(cache, x, y)];
+    while (s >= 0 && (cache->key_x[s] != x || cache->key_y[s] != y)) {
+        s = cache->hash_next[s];
+    }
+    return s;
+}
+
+static void lru_unlink(chunk_cache_t *cache, int32_t s) {
+    int32_t p = cache->lru_prev[s], n = cache->lru_next[s];
+    if (p >= 0) cache->lru_next[p] = n; else cache->head = n;
+    if (n >= 0) cache->lru_prev[n] = p; else cache->tail = p;
+}
+
+static void lru_push_front(chunk_cache_t *cache, int32_t s) {
+    cache->lru_prev[s] = -1;
+    cache->lru_next[s] = cache->head;
+    if (cache->head >= 0) cache->lru_prev[cache->head] = s;
+    cache->head = s;
+    if (cache->tail < 0) cache->tail = s;
+}
+
+static void hash_remove(chunk_cache_t *cache, int32_t s) {
+    int32_t *link = &cache->buckets[bucket_of(cache, cache->key_x[s], cache->key_y[s])];
+    while (*link != s) link = &cache->hash_next[*link];
+    *link = cache->hash_next[s];
+}
+
+/* Claim a slot for (x, y): a fresh one while there are any, else the LRU
+ * tail. The slot is keyed and at the front, but not yet generated. */
+static int32_t claim_slot(chunk_cache_t *cache, int64_t x, int64_t y) {
+    int32_t s;
+    if (cache->resident < cache->capacity) {
+        s = (int32_t)cache->resident++;
+    } else {
+        s = cache->tail;
+        lru_unlink(cache, s);
+        hash_remove(cache, s);
+        cache->evictions++;
+    }
+    cache->key_x[s] = x;
+    cache->key_y[s] = y;
+    size_t b = bucket_of(cache, x, y);
+    cache->hash_next[s] = cache->buckets[b];
+    cache->buckets[b] = s;
+    lru_push_front(cache, s);
+    cache->misses++;
+    return s;
+}
+
+static void *slot_data(const chunk_cache_t *cache, int32_t s) {
+    return cache->data + (size_t)s * cache->chunk_bytes;
+}
+
+chunk_cache_t *chunk_cache_create(size_t capacity, size_t chunk_bytes,
+                                  chunk_generate_fn generate, void *user) {
+    if (capacity == 0 || capacity > INT32_MAX / 2 || chunk_bytes == 0 || !generate) {
+        return NULL;
+    }
+    chunk_cache_t *cache = calloc(1, sizeof(*cache));
+    if (!cache) return NULL;
+
+    size_t buckets = 1;
+    while (buckets < 2 * capacity) buckets <<= 1;
+
+    cache->capacity = capacity;
+    cache->chunk_bytes = chunk_bytes;
+    cache->generate = generate;
+    cache->user = user;
+    cache->bucket_mask = buckets - 1;
+    cache->head = cache->tail = -1;
+    cache->data = malloc(capacity * chunk_bytes);
+    cache->key_x = malloc(capacity * sizeof(int64_t));
+    cache->key_y = malloc(capacity * sizeof(int64_t));
+    cache->lru_prev = malloc(capacity * sizeof(int32_t));
+    cache->lru_next = malloc(capacity * sizeof(int32_t));
+    cache->hash_next = malloc(capacity * sizeof(int32_t));
+    cache->pending = malloc(capacity * sizeof(int32_t));
+    cache->buckets = malloc(buckets * sizeof(int32_t));
+    if (!cache->data || !cache->key_x || !cache->key_y || !cache->lru_prev ||
+        !cache->lru_next || !cache->hash_next || !cache->pending || !cache->buckets) {
+        chunk_cache_free(cache);
+        return NULL;
+    }
+    for (size_t b = 0; b < buckets; b++) cache->buckets[b] = -1;
+    return cache;
+}
+
+void chunk_cache_free(chunk_cache_t *cache) {
+    if (!cache) return;
+    free(cache->data);
+    free(cache->key_x);
+    free(cache->key_y);
+    free(cache->lru_prev);
+    free(cache->lru_next);
+    free(cache->hash_next);
+    free(cache->pending);
+    free(cache->buckets);
+    free(cache);
+}
+
+const void *chunk_cache_get(chunk_cache_t *cache, int64_t chunk_x, int64_t chunk_y) {
+    int32_t s = find_slot(cache, chunk_x, chunk_y);
+    if (s >= 0) {
+        cache->hits++;
+        if (s != cache->head) {
+            lru_unlink(cache, s);
+            lru_push_front(cache, s);
+        }
+        return slot_data(cache, s);
+    }
+    s = claim_slot(cache, chunk_x, chunk_y);
+    cache->generate(cache->user, chunk_x, chunk_y, slot_data(cache, s));
+    return slot_data(cache, s);
+}
+
+static void generate_pending(void *arg, size_t begin, size_t end) {
+    chunk_cache_t *cache = arg;
+    for (size_t i = begin; i < end; i++) {
+        int32_t s = cache->pending[i];
+        cache->generate(cache->user, cache->key_x[s], cache->key_y[s], slot_data(cache, s));
+    }
+}
+
+void chunk_cache_prefetch(chunk_cache_t *cache, int64_t x0, int64_t y0,
+                          int64_t x1, int64_t y1) {
+    // Every chunk touched here moves to the front, so while no more than
+    // capacity are touched the LRU tail is never one of them
+    size_t touched = 0, num_pending = 0;
+    for (int64_t y = y0; y <= y1 && touched < cache->capacity; y++) {
+        for (int64_t x = x0; x <= x1 && touched < cache->capacity; x++, touched++) {
+            int32_t s = find_slot(cache, x, y);
+            if (s >= 0) {
+                lru_unlink(cache, s);
+                lru_push_front(cache, s);
+            } else {
+                cache->pending[num_pending++] = claim_slot(cache, x, y);
+            }
+        }
+    }
+    if (num_pending > 0) {
+        task_pool_parallel_for(NULL, num_pending, 1, generate_pending, cache);
+    }
+}
+
+void chunk_cache_get_stats(const chunk_cache_t *cache, chunk_cache_stats_t *stats) {
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->evictions = cache->evictions;
+    stats->resident = cache->resident;
+}
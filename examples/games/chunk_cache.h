@@ -0,0 +1,65 @@
+#ifndef CHUNK_CACHE_H
+#define CHUNK_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file chunk_cache.h
+ * @brief LRU cache of generated world chunks, keyed by chunk coordinates
+ *
+ * Streams an unbounded world: chunks are generated on first access by a
+ * caller-supplied function and kept until the cache is full, then the least
+ * recently used chunk is recycled. Chunk storage is allocated once up front
+ * (capacity x chunk_bytes), so lookups never allocate.
+ *
+ * The generate function must depend only on the chunk coordinates (and its
+ * own read-only state): chunk_cache_prefetch() calls it for several chunks
+ * at once on the shared task pool, and an evicted chunk is regenerated
+ * identically when it is visited again.
+ *
+ * The cache itself is not thread-safe; use it from one thread.
+ */
+
+typedef void (*chunk_generate_fn)(void *user, int64_t chunk_x, int64_t chunk_y, void *chunk);
+
+typedef struct chunk_cache chunk_cache_t;
+
+typedef struct {
+    uint64_t hits;          /**< Lookups served from the cache */
+    uint64_t misses;        /**< Lookups and prefetches that had to generate */
+    uint64_t evictions;     /**< Chunks recycled to make room */
+    size_t resident;        /**< Chunks currently cached */
+} chunk_cache_stats_t;
+
+/**
+ * Create a cache holding up to capacity chunks of chunk_bytes each
+ *
+ * @return Cache, or NULL on bad arguments or allocation failure
+ */
+chunk_cache_t *chunk_cache_create(size_t capacity, size_t chunk_bytes,
+                                  chunk_generate_fn generate, void *user);
+
+void chunk_cache_free(chunk_cache_t *cache);
+
+/**
+ * Chunk at (chunk_x, chunk_y), generating it on a miss
+ *
+ * The pointer stays valid until the next chunk_cache_get() or
+ * chunk_cache_prefetch() call, which may recycle its storage.
+ */
+const void *chunk_cache_get(chunk_cache_t *cache, int64_t chunk_x, int64_t chunk_y);
+
+/**
+ * Make every chunk in [x0, x1] x [y0, y1] resident, generating the missing
+ * ones in parallel
+ *
+ * At most capacity chunks are loaded; a larger rectangle is cut off in
+ * row-major order.
+ */
+void chunk_cache_prefetch(chunk_cache_t *cache, int64_t x0, int64_t y0,
+                          int64_t x1, int64_t y1);
+
+void chunk_cache_get_stats(const chunk_cache_t *cache, chunk_cache_stats_t *stats);
+
+#endif /* CHUNK_CACHE_H */
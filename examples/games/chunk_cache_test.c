@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "chunk_cache.h"
+
+#define CHUNK_WORDS 64      // 512-byte chunks
+
+static int failures = 0;
+
+// Generator calls, counted atomically since prefetch runs on the task pool
+static unsigned long generated = 0;
+
+static void check(const char *name, int ok) {
+    printf("%-62s %s\n", name, ok ? "PASS" : "FAIL");
+    if (!ok) failures++;
+}
+
+// Deterministic chunk contents, a pure function of the coordinates
+static void expected_chunk(int64_t x, int64_t y, uint64_t *words) {
+    uint64_t h = (uint64_t)x * 0x9E3779B97F4A7C15ULL + (uint64_t)y * 0xBF58476D1CE4E5B9ULL;
+    for (int i = 0; i < CHUNK_WORDS; i++) {
+        h += 0x94D049BB133111EBULL;
+        uint64_t z = h;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        words[i] = z ^ (z >> 31);
+    }
+}
+
+static void generate(void *user, int64_t x, int64_t y, void *chunk) {
+    (void)user;
+    __atomic_fetch_add(&generated, 1, __ATOMIC_RELAXED);
+    expected_chunk(x, y, chunk);
+}
+
+static int chunk_ok(const void *chunk, int64_t x, int64_t y) {
+    uint64_t words[CHUNK_WORDS];
+    expected_chunk(x, y, words);
+    return chunk && memcmp(chunk, words, sizeof(words)) == 0;
+}
+
+static chunk_cache_t *new_cache(size_t capacity) {
+    generated = 0;
+    return chunk_cache_create(capacity, CHUNK_WORDS * sizeof(uint64_t), generate, NULL);
+}
+
+static void test_arguments(void) {
+    int ok = chunk_cache_create(0, 64, generate, NULL) == NULL &&
+             chunk_cache_create(4, 0, generate, NULL) == NULL &&
+             chunk_cache_create(4, 64, NULL, NULL) == NULL;
+    check("Argument checks", ok);
+}
+
+static void test_hits_and_misses(void) {
+    chunk_cache_t *cache = new_cache(4);
+    chunk_cache_stats_t stats;
+
+    int ok = chunk_ok(chunk_cache_get(cache, 0, 0), 0, 0) &&
+             chunk_ok(chunk_cache_get(cache, 0, 0), 0, 0) &&
+             chunk_ok(chunk_cache_get(cache, -3, 9), -3, 9) &&
+             chunk_ok(chunk_cache_get(cache, 0, 0), 0, 0);
+    chunk_cache_get_stats(cache, &stats);
+    check("Hits and misses counted, contents correct",
+          ok && stats.hits == 2 && stats.misses == 2 && stats.evictions == 0 &&
+          stats.resident == 2 && generated == 2);
+
+    chunk_cache_free(cache);
+}
+
+static void test_lru_order(void) {
+    chunk_cache_t *cache = new_cache(3);
+    chunk_cache_stats_t stats;
+
+    // A, B, C resident; touching A leaves B least recently used
+    chunk_cache_get(cache, 1, 0);
+    chunk_cache_get(cache, 2, 0);
+    chunk_cache_get(cache, 3, 0);
+    chunk_cache_get(cache, 1, 0);
+    chunk_cache_get(cache, 4, 0);       // Evicts B
+
+    unsigned long before = generated;
+    int ok = chunk_ok(chunk_cache_get(cache, 1, 0), 1, 0) &&
+             chunk_ok(chunk_cache_get(cache, 3, 0), 3, 0) &&
+             chunk_ok(chunk_cache_get(cache, 4, 0), 4, 0) &&
+             generated == before;
+    chunk_cache_get_stats(cache, &stats);
+    check("Least recently used chunk evicted first",
+          ok && stats.evictions == 1 && stats.resident == 3);
+
+    // Now the order is D, C, A (most recent first): B's return evicts A
+    chunk_cache_get(cache, 2, 0);
+    before = generated;
+    ok = chunk_ok(chunk_cache_get(cache, 3, 0), 3, 0) &&
+         chunk_ok(chunk_cache_get(cache, 4, 0), 4, 0) &&
+         generated == before;
+    chunk_cache_get(cache, 1, 0);
+    check("Eviction follows the updated recency order",
+          ok && generated == before + 1);
+
+    chunk_cache_free(cache);
+}
+
+static void test_regeneration(void) {
+    chunk_cache_t *cache = new_cache(2);
+    chunk_cache_stats_t stats;
+    uint64_t first[CHUNK_WORDS];
+
+    memcpy(first, chunk_cache_get(cache, 5, -7), sizeof(first));
+    chunk_cache_get(cache, 6, -7);
+    chunk_cache_get(cache, 7, -7);      // Evicts (5, -7)
+    chunk_cache_get(cache, 8, -7);      // Recycles its slot for another chunk
+
+    const void *again = chunk_cache_get(cache, 5, -7);
+    chunk_cache_get_stats(cache, &stats);
+    check("Evicted chunk regenerates identically",
+          again && memcmp(again, first, sizeof(first)) == 0 &&
+          chunk_ok(again, 5, -7) && stats.misses == 5 && stats.hits == 0);
+
+    chunk_cache_free(cache);
+}
+
+static void test_prefetch(void) {
+    const size_t capacity = 8;
+    chunk_cache_t *cache = new_cache(capacity);
+    chunk_cache_stats_t stats;
+
+    // Two chunks of the prefetch rectangle are already resident but least
+    // recently used; the rest of the cache holds unrelated chunks
+    chunk_cache_get(cache, 1, 0);
+    chunk_cache_get(cache, 2, 1);
+    for (int64_t i = 0; i < 6; i++) chunk_cache_get(cache, 100 + i, 100);
+
+    // 4 x 4 = 16 chunks, twice the capacity: the first 8 in row-major
+    // order, rows 0 and 1, are loaded and the rest cut off
+    chunk_cache_prefetch(cache, 0, 0, 3, 3);
+    chunk_cache_get_stats(cache, &stats);
+    uint64_t misses = stats.misses;
+
+    unsigned long before = generated;
+    int ok = stats.resident == capacity;
+    for (int64_t y = 0; y <= 1; y++) {
+        for (int64_t x = 0; x <= 3; x++) {
+            ok = ok && chunk_ok(chunk_cache_get(cache, x, y), x, y);
+        }
+    }
+    chunk_cache_get_stats(cache, &stats);
+    check("Prefetch beyond capacity keeps every chunk it loaded",
+          ok && generated == before && stats.misses == misses);
+
+    chunk_cache_get(cache, 0, 2);
+    chunk_cache_get_stats(cache, &stats);
+    check("Prefetch stops at capacity in row-major order",
+          stats.misses == misses + 1 && generated == before + 1);
+
+    // Parallel generation must not cross slots: a fresh, larger prefetch
+    // into an empty cache yields correct contents everywhere
+    chunk_cache_free(cache);
+    cache = new_cache(64);
+    chunk_cache_prefetch(cache, -4, -4, 3, 3);
+    before = generated;
+    ok = before == 64;
+    for (int64_t y = -4; y <= 3; y++) {
+        for (int64_t x = -4; x <= 3; x++) {
+            ok = ok && chunk_ok(chunk_cache_get(cache, x, y), x, y);
+        }
+    }
+    check("Prefetched chunks generated in parallel are correct",
+          ok && generated == before);
+
+    chunk_cache_free(cache);
+}
+
+int main() {
+    printf("=== Chunk Cache Test Suite ===\n\n");
+
+    test_arguments();
+    test_hits_and_misses();
+    test_lru_order();
+    test_regeneration();
+    test_prefetch();
+
+    if (failures) {
+        printf("\n%d chunk cache test(s) FAILED.\n", failures);
+        return 1;
+    }
+    printf("\nAll tests passed.\n");
+    return 0;
+}
@@ -1,10 +1,20 @@
 #include "../../src/quantum_rng/quantum_rng.h"
+#include "loot_table.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <getopt.h>
 
 #define MAX_ITEMS 100
 #define MAX_AFFIXES 5
 #define MAX_NAME_LEN 64
+#define DEMO_ITEMS_PER_TIER 3
+
+#define BENCH_ENTRIES 5000
+#define BENCH_DROPS 10000000
+#define BENCH_BATCH 65536        // Drops per audited batch
+#define BENCH_EDITS 1000
 
 typedef enum {
     RARITY_COMMON,
@@ -75,17 +85,9 @@ const affix_t affix_pool[] = {
     {"of the Dragon", 4.0, 4.0, 4.0, 4.0, 0.4}
 };
 
-// Generate item rarity using quantum randomness
-item_rarity generate_rarity(qrng_ctx *ctx) {
-    double roll = qrng_double(ctx);
-    double cumulative = 0;
-    
-    for(int i = 0; i < NUM_RARITIES; i++) {
-        cumulative += rarity_weights[i];
-        if(roll < cumulative) return i;
-    }
-    
-    return RARITY_COMMON;
+// Rarity table compiled once; every rarity roll resolves against it
+loot_table_t *create_rarity_table(void) {
+    return loot_table_create(rarity_weights, NUM_RARITIES);
 }
 
 // Generate random affixes for an item
@@ -132,13 +134,13 @@ void generate_item_name(qrng_ctx *ctx, item_t *item) {
     }
 }
 
-// Generate complete random item
-item_t generate_item(qrng_ctx *ctx, double item_level) {
+// Generate complete random item of a rolled rarity
+item_t generate_item(qrng_ctx *ctx, double item_level, item_rarity rarity) {
     item_t item = {0};
     item.item_level = item_level;
     
     // Generate basic properties
-    item.rarity = generate_rarity(ctx);
+    item.rarity = rarity;
     item.slot = qrng_uint64(ctx) % NUM_SLOTS;
     
     // Base value scales with item level and rarity
@@ -202,35 +204,38 @@ void print_item(const item_t *item) {
     printf("\n");
 }
 
+// Roll one tier's rarities as an audited batch, then build and print the items
+static void demonstrate_tier(qrng_ctx *ctx, loot_table_t *rarities, const char *title,
+                             double min_level, double max_level) {
+    uint32_t drops[DEMO_ITEMS_PER_TIER];
+    loot_audit_t audit;
+
+    printf("%s:\n", title);
+    loot_table_roll_batch(rarities, ctx, drops, DEMO_ITEMS_PER_TIER, &audit);
+    for(int i = 0; i < DEMO_ITEMS_PER_TIER; i++) {
+        double level = min_level + qrng_double(ctx) * (max_level - min_level);
+        item_t item = generate_item(ctx, level, (item_rarity)drops[i]);
+        print_item(&item);
+    }
+    printf("Rarity audit: key %016llx..., digest %016llx, replay %s\n\n",
+           (unsigned long long)audit.key[0], (unsigned long long)audit.digest,
+           loot_table_replay(rarities, &audit, NULL) == 0 ? "verified" : "FAILED");
+}
+
 // Demonstrate loot system
 void demonstrate_loot_system() {
     qrng_ctx *ctx;
     qrng_init(&ctx, (uint8_t*)"loot", 4);
+    loot_table_t *rarities = create_rarity_table();
     
     printf("Quantum Loot System Demo\n");
     printf("=======================\n\n");
     
     // Generate items at different levels
-    printf("Low Level Items (Level 1-10):\n");
-    for(int i = 0; i < 3; i++) {
-        double level = 1.0 + qrng_double(ctx) * 9.0;
-        item_t item = generate_item(ctx, level);
-        print_item(&item);
-    }
-    
-    printf("\nMid Level Items (Level 40-50):\n");
-    for(int i = 0; i < 3; i++) {
-        double level = 40.0 + qrng_double(ctx) * 10.0;
-        item_t item = generate_item(ctx, level);
-        print_item(&item);
-    }
-    
-    printf("\nHigh Level Items (Level 90-100):\n");
-    for(int i = 0; i < 3; i++) {
-        double level = 90.0 + qrng_double(ctx) * 10.0;
-        item_t item = generate_item(ctx, level);
-        print_item(&item);
-    }
+    demonstrate_tier(ctx, rarities, "Low Level Items (Level 1-10)", 1.0, 10.0);
+    demonstrate_tier(ctx, rarities, "Mid Level Items (Level 40-50)", 40.0, 50.0);
+    demonstrate_tier(ctx, rarities, "High Level Items (Level 90-100)", 90.0, 100.0);
+    loot_table_free(rarities);
     
     // Demonstrate critical hit system
     printf("\nCritical Hit System Demo\n");
@@ -259,7 +264,142 @@ void demonstrate_loot_system() {
     qrng_free(ctx);
 }
 
-int main() {
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Keeps the timed loops from being optimized away
+static volatile uint64_t bench_sink;
+
+// Drop by walking the cumulative weights: the per-roll cost the alias table removes
+static uint32_t walk_weights(const double *weights, size_t n, double total, double u) {
+    double roll = u * total, cumulative = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        cumulative += weights[i];
+        if (roll < cumulative) return (uint32_t)i;
+    }
+    return (uint32_t)(n - 1);
+}
+
+/*
+ * Throughput of a live-ops sized table: linear weight walk against audited
+ * alias batches, plus full compile, single-weight edit and replay costs.
+ */
+static int run_benchmark(size_t entries, size_t drops) {
+    qrng_ctx *ctx;
+    if (qrng_init(&ctx, NULL, 0) != QRNG_SUCCESS) {
+        fprintf(stderr, "Failed to initialize QRNG\n");
+        return 1;
+    }
+
+    // Long-tailed weights: a few common entries, many rare ones
+    double *weights = malloc(entries * sizeof(double));
+    uint32_t *batch = malloc(BENCH_BATCH * sizeof(uint32_t));
+    if (!weights || !batch) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    double total = 0.0;
+    for (size_t i = 0; i < entries; i++) {
+        weights[i] = 1000.0 / (1.0 + (double)(i % 1000)) + (double)(i % 7);
+        total += weights[i];
+    }
+
+    // Linear walk over a fraction of the drops; its cost grows with the table
+    keyed_stream_t stream;
+    if (keyed_stream_key(&stream, ctx) != QRNG_SUCCESS) {
+        fprintf(stderr, "Failed to key the benchmark stream\n");
+        return 1;
+    }
+    size_t walk_drops = drops / 100 > 0 ? drops / 100 : 1;
+    uint64_t walk_sum = 0;
+    double t0 = now_seconds();
+    for (size_t i = 0; i < walk_drops; i++) {
+        double u = keyed_stream_double(&stream);
+        walk_sum += walk_weights(weights, entries, total, u);
+    }
+    double walk_rate = walk_drops / (now_seconds() - t0);
+    bench_sink = walk_sum;
+
+    t0 = now_seconds();
+    loot_table_t *table = loot_table_create(weights, entries);
+    double compile_seconds = now_seconds() - t0;
+    if (!table) {
+        fprintf(stderr, "Failed to compile loot table\n");
+        return 1;
+    }
+
+    loot_audit_t audit = {0};
+    uint64_t alias_sum = 0;
+    t0 = now_seconds();
+    for (size_t done = 0; done < drops; done += BENCH_BATCH) {
+        size_t n = drops - done < BENCH_BATCH ? drops - done : BENCH_BATCH;
+        loot_table_roll_batch(table, ctx, batch, n, &audit);
+        alias_sum += batch[n - 1];
+    }
+    double alias_rate = drops / (now_seconds() - t0);
+    bench_sink = alias_sum;
+
+    // The last batch must replay exactly, before the edits below change the table
+    int replay_ok = loot_table_replay(table, &audit, NULL) == 0;
+
+    t0 = now_seconds();
+    for (int e = 0; e < BENCH_EDITS; e++) {
+        size_t index = (size_t)e * 7919 % entries;
+        loot_table_set_weight(table, index, weights[index] * 1.5);
+        loot_table_rebuild(table);
+    }
+    double edit_seconds = (now_seconds() - t0) / BENCH_EDITS;
+
+    printf("Benchmark: %zu-entry table, %zu drops in audited batches of %d\n",
+           entries, drops, BENCH_BATCH);
+    printf("  Linear weight walk: %10.2f M drops/s (%zu drops)\n", walk_rate / 1e6, walk_drops);
+    printf("  Alias batches:      %10.2f M drops/s (%.1fx)\n", alias_rate / 1e6,
+           alias_rate / walk_rate);
+    printf("  Full compile:       %10.2f us\n", compile_seconds * 1e6);
+    printf("  Edit one weight:    %10.2f us incl. rebuild\n", edit_seconds * 1e6);
+    printf("  Last batch replay:  %s\n", replay_ok ? "verified" : "FAILED");
+
+    loot_table_free(table);
+    free(batch);
+    free(weights);
+    qrng_free(ctx);
+    return replay_ok ? 0 : 1;
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [options]\n\n", prog);
+    printf("Without -b, runs the item and critical hit demo.\n\n");
+    printf("  -b              Benchmark drop resolution on a large table\n");
+    printf("  -n <entries>    Benchmark table entries (default %d)\n", BENCH_ENTRIES);
+    printf("  -d <drops>      Benchmark drops (default %d)\n", BENCH_DROPS);
+    printf("  -h              Show this help and exit\n");
+}
+
+int main(int argc, char *argv[]) {
+    int benchmark = 0;
+    long entries = BENCH_ENTRIES, drops = BENCH_DROPS;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "bn:d:h")) != -1) {
+        switch (opt) {
+            case 'b': benchmark = 1; break;
+            case 'n': entries = atol(optarg); break;
+            case 'd': drops = atol(optarg); break;
+            case 'h': usage(argv[0]); return 0;
+            default:  usage(argv[0]); return 1;
+        }
+    }
+    if (entries < 1 || entries > (long)LOOT_TABLE_MAX_ENTRIES || drops < 1) {
+        fprintf(stderr, "Error: need entries (-n) in 1..%u and drops (-d) >= 1.\n",
+                LOOT_TABLE_MAX_ENTRIES);
+        return 1;
+    }
+
+    if (benchmark) return run_benchmark((size_t)entries, (size_t)drops);
+
     demonstrate_loot_system();
     return 0;
 }
@@ -0,0 +1,322 @@
+#include "loot_table.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ROLL_CHUNK 256      // Drops resolved per substream fill
+
+#define FNV_OFFSET 0xCBF29CE484222325ULL
+#define FNV_PRIME 0x100000001B3ULL
+
+/*
+ * Inner alias tables are stored flat, entry-aligned: prob[i] and alias[i]
+ * belong to the column of entry i in its block, and alias[i] is a global
+ * entry index. The outer table has one column per block.
+ */
+struct loot_table {
+    size_t n;
+    uint32_t num_blocks;
+    uint32_t last_block_size;
+
+    double *weights;
+    uint32_t *prob;             // Acceptance threshold per column, scaled to 2^32
+    uint32_t *alias;
+
+    double *block_total;
+    uint64_t *block_digest;
+    uint8_t *dirty;
+    int any_dirty;
+    uint32_t *outer_prob;
+    uint32_t *outer_alias;
+    uint64_t digest;
+
+    double *scaled;             // Vose work lists, max(LOOT_TABLE_BLOCK, num_blocks)
+    uint32_t *small, *large;
+};
+
+static uint32_t block_size(const loot_table_t *table, uint32_t b) {
+    return b + 1 == table->num_blocks ? table->last_block_size : LOOT_TABLE_BLOCK;
+}
+
+static uint32_t threshold(double p) {
+    return p >= 1.0 ? UINT32_MAX : (uint32_t)(p * 4294967296.0);
+}
+
+/*
+ * Vose's alias method over m weights summing to total: column i keeps its
+ * own entry with probability prob[i] / 2^32, else yields alias[i]. Indices
+ * written to alias are offset by base.
+ */
+static void build_alias(loot_table_t *table, const double *w, uint32_t m, double total,
+                        uint32_t base, uint32_t *prob, uint32_t *alias) {
+    double *scaled = table->scaled;
+    uint32_t *small = table->small, *large = table->large;
+    uint32_t num_small = 0, num_large = 0;
+
+    if (total <= 0.0) {
+        // Never selected by the outer table; any valid layout will do
+        for (uint32_t i = 0; i < m; i++) {
+            prob[i] = UINT32_MAX;
+            alias[i] = base + i;
+        }
+        return;
+    }
+
+    double scale = (double)m / total;
+    for (uint32_t i = 0; i < m; i++) {
+        scaled[i] = w[i] * scale;
+        if (scaled[i] < 1.0) small[num_small++] = i;
+        else large[num_large++] = i;
+    }
+    while (num_small > 0 && num_large > 0) {
+        uint32_t s = small[--num_small], l = large[--num_large];
+        prob[s] = threshold(scaled[s]);
+        alias[s] = base + l;
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        if (scaled[l] < 1.0) small[num_small++] = l;
+        else large[num_large++] = l;
+    }
+    // Whatever is left is full up to rounding
+    while (num_large > 0) {
+        uint32_t l = large[--num_large];
+        prob[l] = UINT32_MAX;
+        alias[l] = base + l;
+    }
+    while (num_small > 0) {
+        uint32_t s = small[--num_small];
+        prob[s] = UINT32_MAX;
+        alias[s] = base + s;
+    }
+}
+
+static double block_sum(const loot_table_t *table, uint32_t b) {
+    const double *w = table->weights + (size_t)b * LOOT_TABLE_BLOCK;
+    double sum = 0.0;
+    for (uint32_t i = 0; i < block_size(table, b); i++) sum += w[i];
+    return sum;
+}
+
+static uint64_t block_hash(const loot_table_t *table, uint32_t b) {
+    const double *w = table->weights + (size_t)b * LOOT_TABLE_BLOCK;
+    uint64_t h = FNV_OFFSET;
+    for (uint32_t i = 0; i < block_size(table, b); i++) {
+        uint64_t bits;
+        memcpy(&bits, &w[i], sizeof(bits));
+        h = (h ^ bits) * FNV_PRIME;
+    }
+    return h;
+}
+
+// Bit tests: under -ffast-math the compiler may assume no NaN, infinity or -0.0
+static int valid_weight(double w) {
+    uint64_t bits;
+    memcpy(&bits, &w, sizeof(bits));
+    if ((bits & 0x7FF0000000000000ULL) == 0x7FF0000000000000ULL) return 0;
+    return (bits >> 63) == 0 || (bits << 1) == 0;
+}
+
+// -0.0 as 0.0, so equal weights always digest equally
+static double canonical_weight(double w) {
+    uint64_t bits;
+    memcpy(&bits, &w, sizeof(bits));
+    return (bits << 1) == 0 ? 0.0 : w;
+}
+
+loot_table_t *loot_table_create(const double *weights, size_t n) {
+    if (!weights || n == 0 || n > LOOT_TABLE_MAX_ENTRIES) {
+        return NULL;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (!valid_weight(weights[i])) return NULL;
+    }
+
+    loot_table_t *table = calloc(1, sizeof(*table));
+    if (!table) return NULL;
+
+    uint32_t num_blocks = (uint32_t)((n + LOOT_TABLE_BLOCK - 1) / LOOT_TABLE_BLOCK);
+    size_t work = num_blocks > LOOT_TABLE_BLOCK ? num_blocks : LOOT_TABLE_BLOCK;
+    table->n = n;
+    table->num_blocks = num_blocks;
+    table->last_block_size = (uint32_t)(n - (size_t)(num_blocks - 1) * LOOT_TABLE_BLOCK);
+    table->weights = malloc(n * sizeof(double));
+    table->prob = malloc(n * sizeof(uint32_t));
+    table->alias = malloc(n * sizeof(uint32_t));
+    table->block_total = malloc(num_blocks * sizeof(double));
+    table->block_digest = malloc(num_blocks * sizeof(uint64_t));
+    table->dirty = malloc(num_blocks);
+    table->outer_prob = malloc(num_blocks * sizeof(uint32_t));
+    table->outer_alias = malloc(num_blocks * sizeof(uint32_t));
+    table->scaled = malloc(work * sizeof(double));
+    table->small = malloc(work * sizeof(uint32_t));
+    table->large = malloc(work * sizeof(uint32_t));
+    if (!table->weights || !table->prob || !table->alias || !table->block_total ||
+        !table->block_digest || !table->dirty || !table->outer_prob ||
+        !table->outer_alias || !table->scaled || !table->small || !table->large) {
+        loot_table_free(table);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        table->weights[i] = canonical_weight(weights[i]);
+    }
+    memset(table->dirty, 1, num_blocks);
+    table->any_dirty = 1;
+    if (loot_table_rebuild(table) != 0) {
+        loot_table_free(table);
+        return NULL;
+    }
+    return table;
+}
+
+void loot_table_free(loot_table_t *table) {
+    if (!table) return;
+    free(table->weights);
+    free(table->prob);
+    free(table->alias);
+    free(table->block_total);
+    free(table->block_digest);
+    free(table->dirty);
+    free(table->outer_prob);
+    free(table->outer_alias);
+    free(table->scaled);
+    free(table->small);
+    free(table->large);
+    free(table);
+}
+
+size_t loot_table_size(const loot_table_t *table) {
+    return table->n;
+}
+
+double loot_table_weight(const loot_table_t *table, size_t index) {
+    return index < table->n ? table->weights[index] : 0.0;
+}
+
+int loot_table_set_weight(loot_table_t *table, size_t index, double weight) {
+    if (!table || index >= table->n || !valid_weight(weight)) {
+        return -1;
+    }
+    table->weights[index] = canonical_weight(weight);
+    table->dirty[index / LOOT_TABLE_BLOCK] = 1;
+    table->any_dirty = 1;
+    return 0;
+}
+
+int loot_table_rebuild(loot_table_t *table) {
+    if (!table) return -1;
+    if (!table->any_dirty) return 0;
+
+    // Refuse an all-zero table before touching the current compilation
+    double total = 0.0;
+    for (uint32_t b = 0; b < table->num_blocks; b++) {
+        total += table->dirty[b] ? block_sum(table, b) : table->block_total[b];
+    }
+    if (!(total > 0.0)) return -1;
+
+    for (uint32_t b = 0; b < table->num_blocks; b++) {
+        if (!table->dirty[b]) continue;
+        size_t base = (size_t)b * LOOT_TABLE_BLOCK;
+        table->block_total[b] = block_sum(table, b);
+        table->block_digest[b] = block_hash(table, b);
+        build_alias(table, table->weights + base, block_size(table, b), table->block_total[b],
+                    (uint32_t)base, table->prob + base, table->alias + base);
+        table->dirty[b] = 0;
+    }
+    build_alias(table, table->block_total, table->num_blocks, total, 0,
+                table->outer_prob, table->outer_alias);
+
+    uint64_t h = (FNV_OFFSET ^ (uint64_t)table->n) * FNV_PRIME;
+    for (uint32_t b = 0; b < table->num_blocks; b++) {
+        h = (h ^ table->block_digest[b]) * FNV_PRIME;
+    }
+    table->digest = h;
+    table->any_dirty = 0;
+    return 0;
+}
+
+uint64_t loot_table_digest(const loot_table_t *table) {
+    return table->digest;
+}
+
+void loot_table_resolve(const loot_table_t *table, const uint64_t *words, size_t n,
+                        uint32_t *drops) {
+    const uint32_t *restrict outer_prob = table->outer_prob;
+    const uint32_t *restrict outer_alias = table->outer_alias;
+    const uint32_t *restrict prob = table->prob;
+    const uint32_t *restrict alias = table->alias;
+    const uint64_t num_blocks = table->num_blocks;
+    const uint32_t last = table->num_blocks - 1, last_size = table->last_block_size;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t w0 = words[2 * i], w1 = words[2 * i + 1];
+
+        // Column from the high half (multiply-shift), coin from the low half
+        uint32_t col = (uint32_t)(((w0 >> 32) * num_blocks) >> 32);
+        uint32_t b = (uint32_t)w0 < outer_prob[col] ? col : outer_alias[col];
+
+        uint64_t m = b == last ? last_size : LOOT_TABLE_BLOCK;
+        uint32_t e = b * LOOT_TABLE_BLOCK + (uint32_t)(((w1 >> 32) * m) >> 32);
+        drops[i] = (uint32_t)w1 < prob[e] ? e : alias[e];
+    }
+}
+
+uint64_t loot_stream_next(loot_stream_t *stream) {
+    return keyed_stream_next(stream);
+}
+
+qrng_error loot_stream_key(loot_stream_t *stream, qrng_ctx *ctx) {
+    return keyed_stream_key(stream, ctx);
+}
+
+int loot_table_roll_stream(loot_table_t *table, loot_stream_t *stream,
+                           uint32_t *drops, size_t n) {
+    if (!table || !stream || (!drops && n > 0)) return -1;
+    if (loot_table_rebuild(table) != 0) return -1;
+
+    uint64_t words[2 * ROLL_CHUNK];
+    for (size_t done = 0; done < n; done += ROLL_CHUNK) {
+        size_t m = n - done < ROLL_CHUNK ? n - done : ROLL_CHUNK;
+        keyed_stream_fill(stream, words, 2 * m);
+        loot_table_resolve(table, words, m, drops + done);
+    }
+    return 0;
+}
+
+static uint64_t drop_digest(uint64_t h, const uint32_t *drops, size_t n) {
+    for (size_t i = 0; i < n; i++) h = (h ^ drops[i]) * FNV_PRIME;
+    return h;
+}
+
+int loot_table_roll_batch(loot_table_t *table, qrng_ctx *ctx, uint32_t *drops, size_t n,
+                          loot_audit_t *audit) {
+    if (!table || !ctx) return -1;
+
+    loot_stream_t stream;
+    if (loot_stream_key(&stream, ctx) != QRNG_SUCCESS) return -1;
+    loot_stream_t key = stream;
+    if (loot_table_roll_stream(table, &stream, drops, n) != 0) return -1;
+
+    if (audit) {
+        memcpy(audit->key, key.s, sizeof(audit->key));
+        audit->table_digest = table->digest;
+        audit->count = n;
+        audit->digest = drop_digest(FNV_OFFSET, drops, n);
+    }
+    return 0;
+}
+
+int loot_table_replay(loot_table_t *table, const loot_audit_t *audit, uint32_t *drops) {
+    if (!table || !audit) return -1;
+    if (loot_table_rebuild(table) != 0 || table->digest != audit->table_digest) return -1;
+
+    loot_stream_t stream;
+    keyed_stream_seed(&stream, audit->key);
+    uint32_t chunk[ROLL_CHUNK];
+    uint64_t h = FNV_OFFSET;
+    for (uint64_t done = 0; done < audit->count; done += ROLL_CHUNK) {
+        size_t m = audit->count - done < ROLL_CHUNK ? (size_t)(audit->count - done) : ROLL_CHUNK;
+        uint32_t *out = drops ? drops + done : chunk;
+        loot_table_roll_stream(table, &stream, out, m);
+        h = drop_digest(h, out, m);
+    }
+    return h == audit->digest ? 0 : -1;
+}
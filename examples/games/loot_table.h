@@ -0,0 +1,145 @@
+#ifndef LOOT_TABLE_H
+#define LOOT_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../../src/quantum_rng/quantum_rng.h"
+#include "../../src/common/keyed_stream.h"
+
+/**
+ * @file loot_table.h
+ * @brief Weighted drop tables compiled to alias tables, resolved in batches
+ *
+ * A table of n weighted entries is compiled once into a two-level
+ * Walker/Vose alias table: entries are grouped into blocks of
+ * LOOT_TABLE_BLOCK, each block has its own alias table, and an outer alias
+ * table picks a block by its total weight. A drop is two O(1) alias
+ * lookups, one 64-bit random word each, whatever the table size.
+ *
+ * Changing a weight marks only its block stale. The next rebuild (explicit,
+ * or implied by the next roll) recompiles the stale blocks and the outer
+ * table, so an edit costs O(LOOT_TABLE_BLOCK + n / LOOT_TABLE_BLOCK)
+ * instead of O(n).
+ *
+ * Drop probabilities match the weights to within about 2^-32 per lookup
+ * level. The compiled table is a pure function of the weights, so any table
+ * with the same weights resolves the same words to the same drops.
+ *
+ * A table is not thread-safe, but concurrent loot_table_resolve() calls on
+ * a table that is not being edited are safe.
+ */
+
+#define LOOT_TABLE_BLOCK 128            // Entries per inner alias table
+#define LOOT_TABLE_MAX_ENTRIES (1u << 30)
+
+typedef struct loot_table loot_table_t;
+
+/**
+ * A keyed substream. One is keyed from the quantum RNG per batch; recording
+ * the key is enough to replay the batch, here or in any tool that follows
+ * the stream format defined in keyed_stream.h.
+ */
+typedef keyed_stream_t loot_stream_t;
+
+/**
+ * Audit record for one batch: with the same weights, replaying key yields
+ * exactly count drops whose digest is digest.
+ */
+typedef struct {
+    uint64_t key[4];        /**< Substream key, drawn from the quantum RNG */
+    uint64_t table_digest;  /**< Digest of the weights the batch was resolved against */
+    uint64_t count;         /**< Drops in the batch */
+    uint64_t digest;        /**< FNV-1a digest of the drop indices, in order */
+} loot_audit_t;
+
+/**
+ * Compile a table from n non-negative weights (at least one positive)
+ *
+ * @return Table, or NULL on bad weights or allocation failure
+ */
+loot_table_t *loot_table_create(const double *weights, size_t n);
+
+void loot_table_free(loot_table_t *table);
+
+size_t loot_table_size(const loot_table_t *table);
+
+double loot_table_weight(const loot_table_t *table, size_t index);
+
+/**
+ * Set one entry's weight. Takes effect at the next rebuild, which the roll
+ * functions do implicitly.
+ *
+ * @return 0 on success, non-zero on a bad index or weight
+ */
+int loot_table_set_weight(loot_table_t *table, size_t index, double weight);
+
+/**
+ * Recompile the blocks whose weights changed, then the outer table
+ *
+ * @return 0 on success, non-zero if every weight is now zero (the table
+ *         then keeps resolving against its last valid compilation)
+ */
+int loot_table_rebuild(loot_table_t *table);
+
+/**
+ * Digest of the weights of the current compilation. Tables with equal
+ * digests resolve identically.
+ */
+uint64_t loot_table_digest(const loot_table_t *table);
+
+/**
+ * Map random words to drops: drops[i] comes from words[2i] and words[2i+1]
+ *
+ * Uses the current compilation; call loot_table_rebuild() first to pick up
+ * weight changes.
+ *
+ * @param words 2 * n uniform 64-bit words
+ * @param n Number of drops
+ * @param drops Entry index of each drop
+ */
+void loot_table_resolve(const loot_table_t *table, const uint64_t *words, size_t n,
+                        uint32_t *drops);
+
+/**
+ * Key a substream from the quantum RNG (keyed_stream_key())
+ *
+ * @return QRNG_SUCCESS, or the quantum RNG error (the stream is then
+ *         unusable)
+ */
+qrng_error loot_stream_key(loot_stream_t *stream, qrng_ctx *ctx);
+
+/**
+ * Next word of a substream (keyed_stream_next())
+ */
+uint64_t loot_stream_next(loot_stream_t *stream);
+
+/**
+ * Resolve n drops from a substream, which is left positioned after them
+ *
+ * @return 0 on success, non-zero if pending weight changes leave every
+ *         weight zero
+ */
+int loot_table_roll_stream(loot_table_t *table, loot_stream_t *stream,
+                           uint32_t *drops, size_t n);
+
+/**
+ * Resolve a batch of n drops from a fresh substream keyed by the quantum
+ * RNG, recording what is needed to replay it
+ *
+ * @param audit Audit record for the batch (may be NULL)
+ * @return 0 on success, non-zero on error (nothing is rolled and audit is
+ *         left untouched)
+ */
+int loot_table_roll_batch(loot_table_t *table, qrng_ctx *ctx, uint32_t *drops, size_t n,
+                          loot_audit_t *audit);
+
+/**
+ * Replay an audited batch against a table with the same weights
+ *
+ * @param drops Replayed drops, audit->count values (may be NULL)
+ * @return 0 if the weights and the replayed drops match the record,
+ *         non-zero otherwise
+ */
+int loot_table_replay(loot_table_t *table, const loot_audit_t *audit, uint32_t *drops);
+
+#endif /* LOOT_TABLE_H */
@@ -0,0 +1,248 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "loot_table.h"
+#include "../../src/quantum_rng/quantum_rng.h"
+
+#define NUM_DROPS 2000000   // Drops per distribution test
+#define WIDE_ENTRIES 300    // Spans three blocks, the last one partial
+
+static int failures = 0;
+
+static void check(const char *name, int ok) {
+    printf("%-54s %s\n", name, ok ? "PASS" : "FAIL");
+    if (!ok) failures++;
+}
+
+// A fixed substream, so the statistical tests are reproducible
+static void fixed_stream(loot_stream_t *stream, uint64_t seed) {
+    stream->s[0] = seed;
+    stream->s[1] = 0x9E3779B97F4A7C15ULL;
+    stream->s[2] = 0xBF58476D1CE4E5B9ULL;
+    stream->s[3] = 0x94D049BB133111EBULL;
+}
+
+// Chi-square of counts against weights; zero-weight entries must be empty
+static int chi_square_ok(const uint32_t *drops, size_t num_drops,
+                         const double *weights, size_t n) {
+    size_t *counts = calloc(n, sizeof(size_t));
+    double total = 0.0, chi_square = 0.0;
+    int df = -1, ok = 1;
+    for (size_t i = 0; i < n; i++) total += weights[i];
+    for (size_t i = 0; i < num_drops; i++) counts[drops[i]]++;
+    for (size_t i = 0; i < n; i++) {
+        if (weights[i] == 0.0) {
+            if (counts[i] != 0) ok = 0;
+            continue;
+        }
+        double expected = (double)num_drops * weights[i] / total;
+        double diff = (double)counts[i] - expected;
+        chi_square += diff * diff / expected;
+        df++;
+    }
+    free(counts);
+    // 99.9% critical value, normal approximation
+    double critical = df + 3.09 * sqrt(2.0 * df);
+    printf("  chi-square %.1f (df %d, 99.9%% critical %.1f)\n", chi_square, df, critical);
+    return ok && chi_square < critical;
+}
+
+static void test_arguments(void) {
+    double good[] = {1.0, 2.0};
+    double negative[] = {1.0, -1.0};
+    double zeros[] = {0.0, 0.0, 0.0};
+    double not_a_number[] = {1.0, NAN};
+    double infinite[] = {1.0, INFINITY};
+
+    int ok = loot_table_create(NULL, 2) == NULL &&
+             loot_table_create(good, 0) == NULL &&
+             loot_table_create(negative, 2) == NULL &&
+             loot_table_create(zeros, 3) == NULL &&
+             loot_table_create(not_a_number, 2) == NULL &&
+             loot_table_create(infinite, 2) == NULL;
+
+    loot_table_t *table = loot_table_create(good, 2);
+    ok = ok && table && loot_table_size(table) == 2 &&
+         loot_table_set_weight(table, 2, 1.0) != 0 &&
+         loot_table_set_weight(table, 0, -0.5) != 0 &&
+         loot_table_set_weight(table, 0, NAN) != 0 &&
+         loot_table_weight(table, 1) == 2.0;
+    loot_table_free(table);
+    check("Argument checks", ok);
+}
+
+static void test_rarity_distribution(void) {
+    const double weights[] = {0.60, 0.25, 0.10, 0.04, 0.01};
+    loot_table_t *table = loot_table_create(weights, 5);
+    uint32_t *drops = malloc(NUM_DROPS * sizeof(uint32_t));
+    loot_stream_t stream;
+    fixed_stream(&stream, 1);
+
+    printf("\nFive-tier rarity table:\n");
+    loot_table_roll_stream(table, &stream, drops, NUM_DROPS);
+    check("Rarity frequencies", chi_square_ok(drops, NUM_DROPS, weights, 5));
+
+    free(drops);
+    loot_table_free(table);
+}
+
+static void test_wide_distribution(void) {
+    double weights[WIDE_ENTRIES];
+    for (int i = 0; i < WIDE_ENTRIES; i++) {
+        weights[i] = i % 7 == 3 ? 0.0 : 1.0 + (i % 13) * (i % 5);
+    }
+    loot_table_t *table = loot_table_create(weights, WIDE_ENTRIES);
+    uint32_t *drops = malloc(NUM_DROPS * sizeof(uint32_t));
+    loot_stream_t stream;
+    fixed_stream(&stream, 2);
+
+    printf("\n%d-entry table (%d blocks):\n", WIDE_ENTRIES,
+           (WIDE_ENTRIES + LOOT_TABLE_BLOCK - 1) / LOOT_TABLE_BLOCK);
+    loot_table_roll_stream(table, &stream, drops, NUM_DROPS);
+    check("Wide table frequencies, zero weights never drop",
+          chi_square_ok(drops, NUM_DROPS, weights, WIDE_ENTRIES));
+
+    free(drops);
+    loot_table_free(table);
+}
+
+// Editing weights and rebuilding must match compiling the edited weights
+static void test_incremental_rebuild(void) {
+    double weights[WIDE_ENTRIES];
+    for (int i = 0; i < WIDE_ENTRIES; i++) weights[i] = 1.0 + (i % 11);
+    loot_table_t *edited = loot_table_create(weights, WIDE_ENTRIES);
+
+    weights[5] = 40.0;
+    weights[200] = 0.0;
+    weights[299] = 7.5;
+    loot_table_set_weight(edited, 5, 40.0);
+    loot_table_set_weight(edited, 200, 0.0);
+    loot_table_set_weight(edited, 299, 7.5);
+
+    const size_t count = NUM_DROPS / 10;
+    loot_table_t *fresh = loot_table_create(weights, WIDE_ENTRIES);
+    uint32_t *a = malloc(count * sizeof(uint32_t));
+    uint32_t *b = malloc(count * sizeof(uint32_t));
+    loot_stream_t sa, sb;
+    fixed_stream(&sa, 3);
+    fixed_stream(&sb, 3);
+    loot_table_roll_stream(edited, &sa, a, count);
+    loot_table_roll_stream(fresh, &sb, b, count);
+
+    printf("\n");
+    check("Incremental rebuild matches a fresh compile",
+          loot_table_digest(edited) == loot_table_digest(fresh) &&
+          memcmp(a, b, count * sizeof(uint32_t)) == 0);
+
+    size_t hits5 = 0, hits200 = 0;
+    for (size_t i = 0; i < count; i++) {
+        hits5 += a[i] == 5;
+        hits200 += a[i] == 200;
+    }
+    check("Edited weights take effect", hits5 > 0 && hits200 == 0);
+
+    free(b);
+    free(a);
+    loot_table_free(fresh);
+    loot_table_free(edited);
+}
+
+static void test_all_zero_rejected(void) {
+    const double weights[] = {1.0, 3.0};
+    loot_table_t *table = loot_table_create(weights, 2);
+    uint64_t digest = loot_table_digest(table);
+    loot_stream_t stream;
+    uint32_t drop;
+    fixed_stream(&stream, 4);
+
+    loot_table_set_weight(table, 0, 0.0);
+    loot_table_set_weight(table, 1, 0.0);
+    int ok = loot_table_rebuild(table) != 0 &&
+             loot_table_roll_stream(table, &stream, &drop, 1) != 0 &&
+             loot_table_digest(table) == digest;
+
+    loot_table_set_weight(table, 1, 2.0);
+    ok = ok && loot_table_rebuild(table) == 0 &&
+         loot_table_roll_stream(table, &stream, &drop, 1) == 0 && drop == 1;
+    check("All-zero weights rejected, last compile kept", ok);
+    loot_table_free(table);
+}
+
+static void test_audit_replay(void) {
+    qrng_ctx *ctx;
+    qrng_init(&ctx, (uint8_t *)"audit", 5);
+    double weights[WIDE_ENTRIES];
+    for (int i = 0; i < WIDE_ENTRIES; i++) weights[i] = 1.0 + (i % 9);
+    loot_table_t *table = loot_table_create(weights, WIDE_ENTRIES);
+    loot_table_t *copy = loot_table_create(weights, WIDE_ENTRIES);
+
+    const size_t count = 100000;
+    uint32_t *drops = malloc(count * sizeof(uint32_t));
+    uint32_t *replayed = malloc(count * sizeof(uint32_t));
+    loot_audit_t audit, second;
+    loot_table_roll_batch(table, ctx, drops, count, &audit);
+    loot_table_roll_batch(table, ctx, replayed, count, &second);
+
+    printf("\n");
+    check("Batches get distinct substream keys",
+          memcmp(audit.key, second.key, sizeof(audit.key)) != 0);
+    check("Replay on an identical table reproduces the batch",
+          loot_table_replay(copy, &audit, replayed) == 0 &&
+          memcmp(drops, replayed, count * sizeof(uint32_t)) == 0 &&
+          loot_table_replay(copy, &audit, NULL) == 0);
+
+    // Another tool replays from the key with the shared stream format alone
+    uint64_t *words = malloc(2 * count * sizeof(uint64_t));
+    keyed_stream_t ks;
+    keyed_stream_seed(&ks, audit.key);
+    keyed_stream_fill(&ks, words, 2 * count);
+    loot_table_resolve(copy, words, count, replayed);
+    check("Key replays through keyed_stream.h directly",
+          memcmp(drops, replayed, count * sizeof(uint32_t)) == 0);
+    free(words);
+
+    loot_stream_t failed;
+    loot_audit_t untouched, marker;
+    memset(&untouched, 0xA5, sizeof(untouched));
+    marker = untouched;
+    check("Failed key draw leaves no stream and no audit record",
+          loot_stream_key(&failed, NULL) != QRNG_SUCCESS &&
+          (failed.s[0] | failed.s[1] | failed.s[2] | failed.s[3]) == 0 &&
+          loot_table_roll_batch(table, NULL, replayed, count, &untouched) != 0 &&
+          memcmp(&untouched, &marker, sizeof(marker)) == 0);
+
+    loot_audit_t tampered = audit;
+    tampered.digest ^= 1;
+    check("Replay detects a tampered record", loot_table_replay(copy, &tampered, NULL) != 0);
+
+    loot_table_set_weight(copy, 17, 100.0);
+    int changed = loot_table_replay(copy, &audit, NULL) != 0;
+    loot_table_set_weight(copy, 17, weights[17]);
+    check("Replay refuses changed weights, accepts restored ones",
+          changed && loot_table_replay(copy, &audit, NULL) == 0);
+
+    free(replayed);
+    free(drops);
+    loot_table_free(copy);
+    loot_table_free(table);
+    qrng_free(ctx);
+}
+
+int main() {
+    printf("=== Loot Table Test Suite ===\n\n");
+
+    test_arguments();
+    test_rarity_distribution();
+    test_wide_distribution();
+    test_incremental_rebuild();
+    test_all_zero_rejected();
+    test_audit_replay();
+
+    if (failures) {
+        printf("\n%d loot table test(s) FAILED.\n", failures);
+        return 1;
+    }
+    printf("\nAll tests passed.\n");
+    return 0;
+}
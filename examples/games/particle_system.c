@@ -1,16 +1,27 @@
 #include "../../src/quantum_rng/quantum_rng.h"
+#include "../../src/scheduler/task_pool.h"
+#include "../../src/common/keyed_stream.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <getopt.h>
 
 #define MAX_PARTICLES 10000
 #define NUM_ATTRACTORS 4
 #define PI 3.14159265358979323846
 
+#define PS_BLOCK 4096          // Particles per parallel update task
+#define PS_EMIT_BATCH 1024     // Particles per quantum-keyed emission batch
+#define PS_EMIT_LOCAL_KEYS 4   // Batch keys held on the stack before allocating
+#define BENCH_PARTICLES 1000000
+#define BENCH_FRAMES 100
+
+// Copy of one particle, as returned by ps_get_particle()
 typedef struct {
     float x, y, z;           // Position in 3D space
     float vx, vy, vz;        // Velocity
-    float ax, ay, az;        // Acceleration
     float mass;              // Particle mass
     float charge;            // Particle charge (for electromagnetic-like forces)
     float lifetime;          // Remaining lifetime
@@ -27,36 +38,63 @@ typedef struct {
     float radius;          // Influence radius
 } attractor_t;
 
+/*
+ * Particles are stored as structure-of-arrays: one array per attribute, so
+ * the update streams through memory and vectorizes across particles.
+ */
 typedef struct {
-    particle_t* particles;
+    float *x, *y, *z;
+    float *vx, *vy, *vz;
+    float *mass, *charge, *lifetime, *spin;
+    int *entangled_with;
+    void **user_data;
     size_t count;
     size_t capacity;
     attractor_t attractors[NUM_ATTRACTORS];
     qrng_ctx* rng;
     float time;
     float quantum_flux;    // Global quantum field strength
+    int num_threads;       // 0 = shared task pool, 1 = calling thread only, N = N threads
+    task_pool_t *pool;     // Private pool when num_threads > 1
 } particle_system_t;
 
-particle_system_t* ps_create(size_t max_particles) {
-    particle_system_t* sys = malloc(sizeof(particle_system_t));
+void ps_destroy(particle_system_t* sys);
+
+particle_system_t* ps_create(size_t max_particles, int num_threads) {
+    particle_system_t* sys = calloc(1, sizeof(particle_system_t));
     if (!sys) return NULL;
-    
-    sys->particles = malloc(max_particles * sizeof(particle_t));
-    if (!sys->particles) {
-        free(sys);
-        return NULL;
+
+    float **fields[] = { &sys->x, &sys->y, &sys->z, &sys->vx, &sys->vy, &sys->vz,
+                         &sys->mass, &sys->charge, &sys->lifetime, &sys->spin };
+    for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+        *fields[f] = malloc(max_particles * sizeof(float));
     }
-    
-    if (qrng_init(&sys->rng, (uint8_t*)"particles", 9) != QRNG_SUCCESS) {
-        free(sys->particles);
-        free(sys);
+    sys->entangled_with = malloc(max_particles * sizeof(int));
+    sys->user_data = malloc(max_particles * sizeof(void*));
+    int missing = !sys->entangled_with || !sys->user_data;
+    for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+        if (!*fields[f]) missing = 1;
+    }
+    if (missing || qrng_init(&sys->rng, (uint8_t*)"particles", 9) != QRNG_SUCCESS) {
+        ps_destroy(sys);
         return NULL;
     }
     sys->count = 0;
     sys->capacity = max_particles;
     sys->time = 0;
     sys->quantum_flux = 1.0f;
-    
+    sys->num_threads = num_threads;
+
+    if (num_threads > 1) {
+        task_pool_config_t pool_config;
+        task_pool_get_default_config(&pool_config);
+        pool_config.num_threads = (size_t)num_threads;
+        pool_config.affinity = TASK_POOL_AFFINITY_NONE;
+        if (task_pool_create(&sys->pool, &pool_config) != TASK_POOL_SUCCESS) {
+            sys->pool = NULL;  // Fall back to the shared pool
+        }
+    }
+
     // Initialize quantum attractors
     for (int i = 0; i < NUM_ATTRACTORS; i++) {
         sys->attractors[i].x = qrng_double(sys->rng) * 2.0f - 1.0f;
@@ -65,145 +103,277 @@ particle_system_t* ps_create(size_t max_particles) {
         sys->attractors[i].strength = (qrng_double(sys->rng) - 0.5f) * 2.0f;
         sys->attractors[i].radius = qrng_double(sys->rng) * 0.5f + 0.5f;
     }
-    
+
     return sys;
 }
 
 void ps_destroy(particle_system_t* sys) {
     if (sys) {
-        free(sys->particles);
-        qrng_free(sys->rng);
+        free(sys->x);
+        free(sys->y);
+        free(sys->z);
+        free(sys->vx);
+        free(sys->vy);
+        free(sys->vz);
+        free(sys->mass);
+        free(sys->charge);
+        free(sys->lifetime);
+        free(sys->spin);
+        free(sys->entangled_with);
+        free(sys->user_data);
+        if (sys->rng) qrng_free(sys->rng);
+        if (sys->pool) task_pool_free(sys->pool);
         free(sys);
     }
 }
 
+/*
+ * Emission draws one quantum-keyed stream per batch (keyed_stream.h) and
+ * fills whole attribute arrays from it: out[i] = lo + (hi - lo) * u, u
+ * uniform in [0, 1) with 24 bits, two per word.
+ */
+static void emit_stream_fill(keyed_stream_t *ks, float *out, size_t n, float lo, float hi) {
+    const float scale = (hi - lo) * (1.0f / 16777216.0f);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint64_t r = keyed_stream_next(ks);
+        out[i] = lo + (float)(r >> 40) * scale;
+        out[i + 1] = lo + (float)((r >> 8) & 0xFFFFFF) * scale;
+    }
+    if (i < n) {
+        out[i] = lo + (float)(keyed_stream_next(ks) >> 40) * scale;
+    }
+}
+
+// Positions at the emitter; velocity from direction (theta, phi) and speed
+static void spawn_range(const float *restrict theta, const float *restrict phi,
+                        const float *restrict speed, float x, float y, float z,
+                        float *restrict px, float *restrict py, float *restrict pz,
+                        float *restrict vx, float *restrict vy, float *restrict vz, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        px[i] = x;
+        py[i] = y;
+        pz[i] = z;
+        float sin_phi = sinf(phi[i]);
+        vx[i] = speed[i] * sin_phi * cosf(theta[i]);
+        vy[i] = speed[i] * sin_phi * sinf(theta[i]);
+        vz[i] = speed[i] * cosf(phi[i]);
+    }
+}
+
+/*
+ * Emit n particles at (x, y, z); returns the index of the first, or
+ * (size_t)-1 if the pool cannot hold all of them or the quantum RNG fails.
+ * Every batch key is drawn before any particle is written, so a failure
+ * emits nothing.
+ */
+size_t ps_emit_batch(particle_system_t* sys, float x, float y, float z, size_t n) {
+    if (n == 0 || n > sys->capacity - sys->count) return (size_t)-1;
+    size_t first = sys->count;
+
+    size_t num_batches = (n + PS_EMIT_BATCH - 1) / PS_EMIT_BATCH;
+    keyed_stream_t local_keys[PS_EMIT_LOCAL_KEYS];
+    keyed_stream_t *keys = num_batches <= PS_EMIT_LOCAL_KEYS ? local_keys :
+                           malloc(num_batches * sizeof(keyed_stream_t));
+    if (!keys) return (size_t)-1;
+    for (size_t b = 0; b < num_batches; b++) {
+        if (keyed_stream_key(&keys[b], sys->rng) != QRNG_SUCCESS) {
+            if (keys != local_keys) free(keys);
+            return (size_t)-1;
+        }
+    }
+
+    float theta[PS_EMIT_BATCH], phi[PS_EMIT_BATCH], speed[PS_EMIT_BATCH], roll[PS_EMIT_BATCH];
+    for (size_t base = 0; base < n; base += PS_EMIT_BATCH) {
+        size_t m = n - base < PS_EMIT_BATCH ? n - base : PS_EMIT_BATCH;
+        size_t start = first + base;
+        keyed_stream_t *es = &keys[base / PS_EMIT_BATCH];
+
+        // Quantum-keyed attributes, one array at a time
+        emit_stream_fill(es, theta, m, 0.0f, 2.0f * (float)PI);
+        emit_stream_fill(es, phi, m, 0.0f, (float)PI);
+        emit_stream_fill(es, speed, m, 0.0f, 2.0f);
+        emit_stream_fill(es, sys->mass + start, m, 0.5f, 1.0f);
+        emit_stream_fill(es, sys->charge + start, m, -1.0f, 1.0f);
+        emit_stream_fill(es, sys->lifetime + start, m, 1.0f, 6.0f);
+        emit_stream_fill(es, sys->spin + start, m, -1.0f, 1.0f);
+        emit_stream_fill(es, roll, m, 0.0f, 1.0f);
+
+        spawn_range(theta, phi, speed, x, y, z, sys->x + start, sys->y + start, sys->z + start,
+                    sys->vx + start, sys->vy + start, sys->vz + start, m);
+
+        // Quantum entanglement: ~10% of particles pair up with an existing one
+        for (size_t i = 0; i < m; i++) {
+            size_t index = start + i;
+            sys->user_data[index] = NULL;
+            sys->entangled_with[index] = -1;
+            if (roll[i] < 0.1f && index > 0) {
+                int partner = (int)(keyed_stream_next(es) % index);
+
+                // If the chosen partner is already entangled, break its old link
+                // first so no third particle is left pointing at it.
+                int old = sys->entangled_with[partner];
+                if (old >= 0) {
+                    sys->entangled_with[old] = -1;
+                }
+
+                sys->entangled_with[index] = partner;
+                sys->entangled_with[partner] = (int)index;
+            }
+        }
+        sys->count += m;
+    }
+    if (keys != local_keys) free(keys);
+    return first;
+}
+
 size_t ps_emit(particle_system_t* sys, float x, float y, float z) {
-    if (sys->count >= sys->capacity) return (size_t)-1;
-    
-    particle_t* p = &sys->particles[sys->count];
-    
-    // Position
-    p->x = x;
-    p->y = y;
-    p->z = z;
-    
-    // Quantum-derived velocity
-    float theta = qrng_double(sys->rng) * 2 * PI;
-    float phi = qrng_double(sys->rng) * PI;
-    float speed = qrng_double(sys->rng) * 2.0f;
-    
-    p->vx = speed * sin(phi) * cos(theta);
-    p->vy = speed * sin(phi) * sin(theta);
-    p->vz = speed * cos(phi);
-    
-    // Quantum properties
-    p->mass = qrng_double(sys->rng) * 0.5f + 0.5f;
-    p->charge = qrng_double(sys->rng) * 2.0f - 1.0f;
-    p->lifetime = qrng_double(sys->rng) * 5.0f + 1.0f;
-    p->spin = qrng_double(sys->rng) * 2.0f - 1.0f;
-    
-    // Quantum entanglement: ~10% of particles pair up with an existing one
-    if (qrng_double(sys->rng) < 0.1f && sys->count > 0) {
-        int partner = (int)(qrng_uint64(sys->rng) % sys->count);
-
-        // If the chosen partner is already entangled, break its old link
-        // first so no third particle is left pointing at it.
-        int old = sys->particles[partner].entangled_with;
-        if (old >= 0 && (size_t)old < sys->count) {
-            sys->particles[old].entangled_with = -1;
+    return ps_emit_batch(sys, x, y, z, 1);
+}
+
+/*
+ * One frame is two parallel passes over blocks of PS_BLOCK particles:
+ * forces (reading positions only) update velocity and lifetime, then
+ * positions advance. Every particle sees the same positions at any thread
+ * count, so the simulation does not depend on the schedule.
+ */
+typedef struct {
+    particle_system_t *sys;
+    float dt;
+} step_job_t;
+
+/*
+ * The kernels take restrict-qualified arrays as parameters: that is what
+ * lets the compiler vectorize them without runtime alias checks across a
+ * dozen attribute arrays.
+ */
+static void accelerate_range(const float *restrict x, const float *restrict y,
+                             const float *restrict z, const float *restrict charge,
+                             const float *restrict spin, const int *restrict entangled,
+                             float *restrict vx, float *restrict vy, float *restrict vz,
+                             float *restrict lifetime, const attractor_t *restrict attractors,
+                             float flux, float dt, size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; i++) {
+        float ax = 0.0f, ay = 0.0f, az = 0.0f;
+
+        // Attractor forces inside each radius (masked, no branches)
+        for (int j = 0; j < NUM_ATTRACTORS; j++) {
+            float dx = attractors[j].x - x[i];
+            float dy = attractors[j].y - y[i];
+            float dz = attractors[j].z - z[i];
+            float d2 = dx*dx + dy*dy + dz*dz;
+            float dist = sqrtf(fmaxf(d2, 1e-12f));
+            float inside = (float)((dist > 0.001f) & (dist < attractors[j].radius));
+            float force = inside * attractors[j].strength * charge[i] * flux / (dist * dist * dist);
+            ax += dx * force;
+            ay += dy * force;
+            az += dz * force;
         }
 
-        p->entangled_with = partner;
-        sys->particles[partner].entangled_with = (int)sys->count;
+        vx[i] += ax * dt;
+        vy[i] += ay * dt;
+        vz[i] += az * dt;
+        lifetime[i] -= dt;
+    }
+
+    // Entanglement coupling, for the minority of particles that have a
+    // partner; kept out of the loop above so that loop has no gathers
+    for (size_t i = lo; i < hi; i++) {
+        int partner = entangled[i];
+        if (partner < 0) continue;
+        float force = 0.1f * spin[i] * spin[partner] * flux * dt;
+        vx[i] += (x[partner] - x[i]) * force;
+        vy[i] += (y[partner] - y[i]) * force;
+        vz[i] += (z[partner] - z[i]) * force;
+    }
+}
+
+static void advance_range(float *restrict x, float *restrict y, float *restrict z,
+                          const float *restrict vx, const float *restrict vy,
+                          const float *restrict vz, float dt, size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; i++) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        z[i] += vz[i] * dt;
+    }
+}
+
+static void accelerate_blocks(void *arg, size_t begin, size_t end) {
+    const step_job_t *job = arg;
+    particle_system_t *sys = job->sys;
+    size_t hi = end * PS_BLOCK < sys->count ? end * PS_BLOCK : sys->count;
+    accelerate_range(sys->x, sys->y, sys->z, sys->charge, sys->spin, sys->entangled_with,
+                     sys->vx, sys->vy, sys->vz, sys->lifetime, sys->attractors,
+                     sys->quantum_flux, job->dt, begin * PS_BLOCK, hi);
+}
+
+static void advance_blocks(void *arg, size_t begin, size_t end) {
+    const step_job_t *job = arg;
+    particle_system_t *sys = job->sys;
+    size_t hi = end * PS_BLOCK < sys->count ? end * PS_BLOCK : sys->count;
+    advance_range(sys->x, sys->y, sys->z, sys->vx, sys->vy, sys->vz, job->dt,
+                  begin * PS_BLOCK, hi);
+}
+
+static void run_blocks(particle_system_t *sys, task_range_fn fn, step_job_t *job) {
+    size_t blocks = (sys->count + PS_BLOCK - 1) / PS_BLOCK;
+    if (sys->num_threads == 1) {
+        fn(job, 0, blocks);
     } else {
-        p->entangled_with = -1;
+        task_pool_parallel_for(sys->pool, blocks, 1, fn, job);
+    }
+}
+
+// Move particle `from` into slot `to`, re-pointing its partner's back-reference
+static void ps_move(particle_system_t* sys, size_t from, size_t to) {
+    sys->x[to] = sys->x[from];
+    sys->y[to] = sys->y[from];
+    sys->z[to] = sys->z[from];
+    sys->vx[to] = sys->vx[from];
+    sys->vy[to] = sys->vy[from];
+    sys->vz[to] = sys->vz[from];
+    sys->mass[to] = sys->mass[from];
+    sys->charge[to] = sys->charge[from];
+    sys->lifetime[to] = sys->lifetime[from];
+    sys->spin[to] = sys->spin[from];
+    sys->user_data[to] = sys->user_data[from];
+    int partner = sys->entangled_with[from];
+    sys->entangled_with[to] = partner;
+    if (partner >= 0) {
+        sys->entangled_with[partner] = (int)to;
     }
-    
-    p->user_data = NULL;
-    return sys->count++;
 }
 
 void ps_update(particle_system_t* sys, float dt) {
     sys->time += dt;
-    
+
     // Update quantum flux
     sys->quantum_flux = 0.8f + 0.2f * sin(sys->time * 0.5f);
-    
+
+    step_job_t job = { sys, dt };
+    run_blocks(sys, accelerate_blocks, &job);
+    run_blocks(sys, advance_blocks, &job);
+
+    // Remove dead particles (swap-with-last, then shrink)
     size_t i = 0;
     while (i < sys->count) {
-        particle_t* p = &sys->particles[i];
-        
-        // Reset acceleration
-        p->ax = p->ay = p->az = 0;
-        
-        // Apply attractor forces
-        for (int j = 0; j < NUM_ATTRACTORS; j++) {
-            float dx = sys->attractors[j].x - p->x;
-            float dy = sys->attractors[j].y - p->y;
-            float dz = sys->attractors[j].z - p->z;
-            float dist = sqrt(dx*dx + dy*dy + dz*dz);
-            
-            if (dist > 0.001f && dist < sys->attractors[j].radius) {
-                float force = sys->attractors[j].strength / (dist * dist);
-                force *= p->charge * sys->quantum_flux;
-                
-                p->ax += (dx / dist) * force;
-                p->ay += (dy / dist) * force;
-                p->az += (dz / dist) * force;
-            }
+        if (sys->lifetime[i] > 0) {
+            i++;
+            continue;
         }
-        
-        // Apply quantum entanglement effects
-        if (p->entangled_with >= 0 && (size_t)p->entangled_with < sys->count) {
-            particle_t* other = &sys->particles[p->entangled_with];
-            float dx = other->x - p->x;
-            float dy = other->y - p->y;
-            float dz = other->z - p->z;
-            float dist = sqrt(dx*dx + dy*dy + dz*dz);
-            
-            if (dist > 0.001f) {
-                float force = 0.1f * p->spin * other->spin * sys->quantum_flux;
-                p->ax += dx * force;
-                p->ay += dy * force;
-                p->az += dz * force;
-            }
+        // Break the dying particle's entanglement so its partner
+        // no longer points at a recycled slot.
+        int partner = sys->entangled_with[i];
+        if (partner >= 0) {
+            sys->entangled_with[partner] = -1;
         }
-        
-        // Update velocity and position
-        p->vx += p->ax * dt;
-        p->vy += p->ay * dt;
-        p->vz += p->az * dt;
-        
-        p->x += p->vx * dt;
-        p->y += p->vy * dt;
-        p->z += p->vz * dt;
-        
-        // Update lifetime
-        p->lifetime -= dt;
-        
-        // Remove dead particles (swap-with-last, then shrink)
-        if (p->lifetime <= 0) {
-            // Break the dying particle's entanglement so its partner
-            // no longer points at a recycled slot.
-            if (p->entangled_with >= 0 && (size_t)p->entangled_with < sys->count) {
-                sys->particles[p->entangled_with].entangled_with = -1;
-            }
 
-            size_t last = sys->count - 1;
-            if (i < last) {
-                sys->particles[i] = sys->particles[last];
-
-                // The particle formerly at `last` now lives at `i`;
-                // re-point its partner's back-reference.
-                int partner = sys->particles[i].entangled_with;
-                if (partner >= 0 && (size_t)partner < last) {
-                    sys->particles[partner].entangled_with = (int)i;
-                }
-            }
-            sys->count--;
-        } else {
-            i++;
+        size_t last = sys->count - 1;
+        if (i < last) {
+            // The particle formerly at `last` now lives at `i`
+            ps_move(sys, last, i);
         }
+        sys->count--;
     }
 }
 
@@ -218,9 +388,25 @@ void ps_set_attractor(particle_system_t* sys, int index, float x, float y, float
     }
 }
 
-const particle_t* ps_get_particles(const particle_system_t* sys, size_t* count) {
-    if (count) *count = sys->count;
-    return sys->particles;
+size_t ps_get_count(const particle_system_t* sys) {
+    return sys->count;
+}
+
+int ps_get_particle(const particle_system_t* sys, size_t index, particle_t* out) {
+    if (index >= sys->count) return -1;
+    out->x = sys->x[index];
+    out->y = sys->y[index];
+    out->z = sys->z[index];
+    out->vx = sys->vx[index];
+    out->vy = sys->vy[index];
+    out->vz = sys->vz[index];
+    out->mass = sys->mass[index];
+    out->charge = sys->charge[index];
+    out->lifetime = sys->lifetime[index];
+    out->spin = sys->spin[index];
+    out->entangled_with = sys->entangled_with[index];
+    out->user_data = sys->user_data[index];
+    return 0;
 }
 
 void ps_set_quantum_flux(particle_system_t* sys, float flux) {
@@ -233,14 +419,14 @@ float ps_get_quantum_flux(const particle_system_t* sys) {
 
 void* ps_get_particle_user_data(const particle_system_t* sys, size_t index) {
     if (index < sys->count) {
-        return sys->particles[index].user_data;
+        return sys->user_data[index];
     }
     return NULL;
 }
 
 void ps_set_particle_user_data(particle_system_t* sys, size_t index, void* data) {
     if (index < sys->count) {
-        sys->particles[index].user_data = data;
+        sys->user_data[index] = data;
     }
 }
 
@@ -253,9 +439,9 @@ static void print_system_stats(const particle_system_t* sys, float t) {
     double avg_speed = 0.0;
 
     for (size_t i = 0; i < sys->count; i++) {
-        const particle_t* p = &sys->particles[i];
-        if (p->entangled_with >= 0) entangled++;
-        avg_speed += sqrt(p->vx * p->vx + p->vy * p->vy + p->vz * p->vz);
+        if (sys->entangled_with[i] >= 0) entangled++;
+        avg_speed += sqrt(sys->vx[i] * sys->vx[i] + sys->vy[i] * sys->vy[i] +
+                          sys->vz[i] * sys->vz[i]);
     }
     if (sys->count > 0) avg_speed /= sys->count;
 
@@ -263,30 +449,128 @@ static void print_system_stats(const particle_system_t* sys, float t) {
            t, sys->count, entangled, sys->quantum_flux, avg_speed);
 }
 
-int main(void) {
+// Every entanglement link must be mutual after all the swap-removals
+static size_t count_broken_links(const particle_system_t* sys) {
+    size_t broken_links = 0;
+    for (size_t i = 0; i < sys->count; i++) {
+        int partner = sys->entangled_with[i];
+        if (partner >= 0) {
+            if ((size_t)partner >= sys->count ||
+                sys->entangled_with[partner] != (int)i) {
+                broken_links++;
+            }
+        }
+    }
+    return broken_links;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Frames per second for a system held at `particles`: each frame updates
+ * every particle, then re-emits as many as died.
+ */
+static int run_benchmark(size_t particles, int frames, int num_threads) {
+    particle_system_t* sys = ps_create(particles, num_threads);
+    if (!sys) {
+        fprintf(stderr, "Failed to create particle system\n");
+        return 1;
+    }
+
+    double t0 = now_seconds();
+    ps_emit_batch(sys, 0.0f, 0.0f, 0.0f, particles);
+    double emit_seconds = now_seconds() - t0;
+
+    const float dt = 0.02f;
+    size_t respawned = 0;
+    double update_seconds = 0.0;
+    t0 = now_seconds();
+    for (int f = 0; f < frames; f++) {
+        double u0 = now_seconds();
+        ps_update(sys, dt);
+        update_seconds += now_seconds() - u0;
+        size_t dead = particles - sys->count;
+        if (dead > 0) {
+            ps_emit_batch(sys, 0.0f, 0.0f, 0.0f, dead);
+            respawned += dead;
+        }
+    }
+    double frame_seconds = now_seconds() - t0;
+    size_t broken_links = count_broken_links(sys);
+
+    printf("Benchmark: %zu particles, %d frames, threads %d%s\n", particles, frames,
+           num_threads, num_threads == 0 ? " (shared pool)" : "");
+    printf("  Initial emission: %.3f s (%.1f M particles/s)\n",
+           emit_seconds, particles / emit_seconds / 1e6);
+    printf("  Frames:           %.3f s (%.1f frames/s)\n",
+           frame_seconds, frames / frame_seconds);
+    printf("  Update only:      %.1f M particle-steps/s\n",
+           (double)particles * frames / update_seconds / 1e6);
+    printf("  Respawned:        %zu particles (%.1f M particles/s incl. update)\n",
+           respawned, respawned / frame_seconds / 1e6);
+    printf("  Entanglement link check: %zu broken links (expect 0)\n", broken_links);
+
+    ps_destroy(sys);
+    return broken_links > 0 ? 1 : 0;
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [options]\n\n", prog);
+    printf("Without -b, runs the 6,000-particle entanglement demo.\n\n");
+    printf("  -b              Benchmark frames/sec on a large system\n");
+    printf("  -n <particles>  Benchmark particles (default %d)\n", BENCH_PARTICLES);
+    printf("  -f <frames>     Benchmark frames (default %d)\n", BENCH_FRAMES);
+    printf("  -p <threads>    0 = shared pool, 1 = calling thread, N = N threads (default 0)\n");
+    printf("  -h              Show this help and exit\n");
+}
+
+int main(int argc, char *argv[]) {
+    int benchmark = 0, frames = BENCH_FRAMES, num_threads = 0;
+    long particles = BENCH_PARTICLES;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "bn:f:p:h")) != -1) {
+        switch (opt) {
+            case 'b': benchmark = 1; break;
+            case 'n': particles = atol(optarg); break;
+            case 'f': frames = atoi(optarg); break;
+            case 'p': num_threads = atoi(optarg); break;
+            case 'h': usage(argv[0]); return 0;
+            default:  usage(argv[0]); return 1;
+        }
+    }
+    if (particles < 1 || frames < 1 || num_threads < 0) {
+        fprintf(stderr, "Error: need particles (-n) >= 1, frames (-f) >= 1 and threads (-p) >= 0.\n");
+        return 1;
+    }
+
+    if (benchmark) return run_benchmark((size_t)particles, frames, num_threads);
+
     printf("Quantum Particle System Demo\n");
     printf("============================\n\n");
 
-    particle_system_t* sys = ps_create(MAX_PARTICLES);
+    particle_system_t* sys = ps_create(MAX_PARTICLES, num_threads);
     if (!sys) {
         fprintf(stderr, "Failed to create particle system\n");
         return 1;
     }
 
-    // Burst-emit 2000 particles from three emitters
+    // Burst-emit 2000 particles from each of three emitters
     const float emitters[3][3] = {
         { 0.0f,  0.0f, 0.0f},
         { 0.5f,  0.5f, 0.2f},
         {-0.5f, -0.3f, 0.4f}
     };
     for (int e = 0; e < 3; e++) {
-        for (int i = 0; i < 2000; i++) {
-            if (ps_emit(sys, emitters[e][0], emitters[e][1], emitters[e][2])
-                    == (size_t)-1) {
-                fprintf(stderr, "Emit failed: pool exhausted\n");
-                ps_destroy(sys);
-                return 1;
-            }
+        if (ps_emit_batch(sys, emitters[e][0], emitters[e][1], emitters[e][2], 2000)
+                == (size_t)-1) {
+            fprintf(stderr, "Emit failed: pool exhausted\n");
+            ps_destroy(sys);
+            return 1;
         }
     }
 
@@ -305,16 +589,7 @@ int main(void) {
     }
 
     // Verify entanglement bookkeeping survived all the swap-removals
-    size_t broken_links = 0;
-    for (size_t i = 0; i < sys->count; i++) {
-        int partner = sys->particles[i].entangled_with;
-        if (partner >= 0) {
-            if ((size_t)partner >= sys->count ||
-                sys->particles[partner].entangled_with != (int)i) {
-                broken_links++;
-            }
-        }
-    }
+    size_t broken_links = count_broken_links(sys);
     printf("\nEntanglement link check: %zu broken links (expect 0)\n", broken_links);
 
     ps_destroy(sys);
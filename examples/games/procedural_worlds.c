@@ -1,48 +1,51 @@
 #include "../../src/quantum_rng/quantum_rng.h"
+#include "terrain_noise.h"
+#include "chunk_cache.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 
-#define WORLD_SIZE 128
+/*
+ * An unbounded world, generated chunk by chunk. The quantum RNG draws the
+ * noise tables once; every chunk is then a pure function of its
+ * coordinates, so chunks stream in through an LRU cache as the view moves
+ * and come back identical when revisited.
+ */
+
+#define CHUNK_SIZE 32
+#define VIEW_CHUNKS 4      // View is VIEW_CHUNKS x VIEW_CHUNKS chunks (128x128 cells)
+#define CACHE_CHUNKS 64
 #define OCTAVES 4
 
 typedef struct {
-    float height[WORLD_SIZE][WORLD_SIZE];
-    float temperature[WORLD_SIZE][WORLD_SIZE];
-    float moisture[WORLD_SIZE][WORLD_SIZE];
-} world_map;
-
-float quantum_noise2d(qrng_ctx *ctx, int x, int y, float frequency) {
-    float nx = x * frequency;
-    float ny = y * frequency;
-    
-    uint64_t hash = qrng_uint64(ctx);
-    float rx = (float)(hash & 0xFFFFFFFF) / UINT32_MAX;
-    float ry = (float)(hash >> 32) / UINT32_MAX;
-    
-    return cos(nx * rx + ny * ry) * 0.5 + 0.5;
+    float height[CHUNK_SIZE][CHUNK_SIZE];
+    float temperature[CHUNK_SIZE][CHUNK_SIZE];
+    float moisture[CHUNK_SIZE][CHUNK_SIZE];
+} world_chunk;
+
+// Fractal noise huddles around 0.5; spread it over the biome thresholds
+static float stretch(float v, float contrast) {
+    v = 0.5f + (v - 0.5f) * contrast;
+    return v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v;
 }
 
-void generate_terrain(qrng_ctx *ctx, world_map *map) {
-    for(int y = 0; y < WORLD_SIZE; y++) {
-        for(int x = 0; x < WORLD_SIZE; x++) {
-            float amplitude = 1.0;
-            float frequency = 1.0;
-            float height = 0;
-            float amplitude_sum = 0;
-
-            for(int o = 0; o < OCTAVES; o++) {
-                height += quantum_noise2d(ctx, x, y, frequency) * amplitude;
-                amplitude_sum += amplitude;
-                amplitude *= 0.5;
-                frequency *= 2.0;
-            }
-
-            // Normalize by the sum of octave amplitudes (1 + 1/2 + ... = 1.875
-            // for 4 octaves) so height spans [0, 1]. Dividing by 2^OCTAVES - 1
-            // (a previous bug) squashed everything below the ocean threshold.
-            map->height[y][x] = height / amplitude_sum;
-            map->temperature[y][x] = quantum_noise2d(ctx, x, y, 0.02);
-            map->moisture[y][x] = quantum_noise2d(ctx, x + 1000, y + 1000, 0.03);
+static void generate_chunk(void *user, int64_t chunk_x, int64_t chunk_y, void *out) {
+    const noise_table_t *noise = user;
+    world_chunk *chunk = out;
+    const noise_fbm_t height = { 1.0 / 48.0, OCTAVES, 0, 0 };
+    const noise_fbm_t temperature = { 0.02, 2, 0, 0 };
+    const noise_fbm_t moisture = { 0.03, 2, 0, 0 };
+    double x0 = (double)(chunk_x * CHUNK_SIZE);
+
+    for (int y = 0; y < CHUNK_SIZE; y++) {
+        double wy = (double)(chunk_y * CHUNK_SIZE + y);
+        noise_fbm_row(noise, &height, x0, wy, CHUNK_SIZE, chunk->height[y]);
+        noise_fbm_row(noise, &temperature, x0, wy, CHUNK_SIZE, chunk->temperature[y]);
+        noise_fbm_row(noise, &moisture, x0 + 1000.0, wy + 1000.0, CHUNK_SIZE, chunk->moisture[y]);
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            chunk->height[y][x] = stretch(chunk->height[y][x], 2.5f);
+            chunk->temperature[y][x] = stretch(chunk->temperature[y][x], 2.5f);
+            chunk->moisture[y][x] = stretch(chunk->moisture[y][x], 2.5f);
         }
     }
 }
@@ -50,23 +53,23 @@ void generate_terrain(qrng_ctx *ctx, world_map *map) {
 char get_biome_char(float height, float temp, float moisture) {
     if(height < 0.3) return '~';  // Ocean
     if(height < 0.4) return ',';  // Beach
-    
+
     if(temp < 0.2) {             // Cold biomes
         if(moisture < 0.3) return '.';  // Tundra
         return '*';                     // Snow
     }
-    
+
     if(temp < 0.4) {             // Cool biomes
         if(moisture < 0.3) return 'o';  // Grassland
         return 'T';                     // Taiga
     }
-    
+
     if(temp < 0.7) {             // Temperate biomes
         if(moisture < 0.3) return '-';  // Plains
         if(moisture < 0.6) return 'f';  // Forest
         return 'F';                     // Dense forest
     }
-    
+
     // Hot biomes
     if(moisture < 0.2) return '.';      // Desert
     if(moisture < 0.4) return 's';      // Savanna
@@ -74,22 +77,26 @@ char get_biome_char(float height, float temp, float moisture) {
     return 'R';                         // Dense rainforest
 }
 
-void print_world(const world_map *map) {
-    printf("\nProcedural World Generation:\n");
+// Print the VIEW_CHUNKS x VIEW_CHUNKS view whose top-left chunk is (cx, cy)
+void print_world(chunk_cache_t *cache, int64_t cx, int64_t cy) {
+    printf("\nProcedural World Generation (chunks %lld..%lld, %lld..%lld):\n",
+           (long long)cx, (long long)(cx + VIEW_CHUNKS - 1),
+           (long long)cy, (long long)(cy + VIEW_CHUNKS - 1));
     printf("===========================\n\n");
-    
-    for(int y = 0; y < WORLD_SIZE; y += 2) {
-        for(int x = 0; x < WORLD_SIZE; x += 2) {
-            char biome = get_biome_char(
-                map->height[y][x],
-                map->temperature[y][x],
-                map->moisture[y][x]
-            );
-            printf("%c", biome);
+
+    chunk_cache_prefetch(cache, cx, cy, cx + VIEW_CHUNKS - 1, cy + VIEW_CHUNKS - 1);
+    for(int y = 0; y < VIEW_CHUNKS * CHUNK_SIZE; y += 2) {
+        for(int x = 0; x < VIEW_CHUNKS * CHUNK_SIZE; x += 2) {
+            const world_chunk *chunk = chunk_cache_get(cache, cx + x / CHUNK_SIZE,
+                                                       cy + y / CHUNK_SIZE);
+            int lx = x % CHUNK_SIZE, ly = y % CHUNK_SIZE;
+            printf("%c", get_biome_char(chunk->height[ly][lx],
+                                        chunk->temperature[ly][lx],
+                                        chunk->moisture[ly][lx]));
         }
         printf("\n");
     }
-    
+
     printf("\nLegend:\n");
     printf("~ Ocean   , Beach   . Desert/Tundra   - Plains\n");
     printf("o Grass   f Forest  F Dense Forest    * Snow\n");
@@ -98,12 +105,36 @@ void print_world(const world_map *map) {
 
 int main() {
     qrng_ctx *ctx;
-    qrng_init(&ctx, (uint8_t*)"worldseed", 9);
-    
-    world_map map;
-    generate_terrain(ctx, &map);
-    print_world(&map);
-    
-    qrng_free(ctx);
+    if (qrng_init(&ctx, (uint8_t*)"worldseed", 9) != QRNG_SUCCESS) {
+        fprintf(stderr, "Failed to initialize QRNG\n");
+        return 1;
+    }
+
+    noise_table_t noise;
+    noise_table_init(&noise, ctx);
+    qrng_free(ctx);   // Everything below is a function of position
+
+    chunk_cache_t *cache = chunk_cache_create(CACHE_CHUNKS, sizeof(world_chunk),
+                                              generate_chunk, &noise);
+    if (!cache) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    print_world(cache, 0, 0);
+
+    // Travel east: the view streams in new chunks and the cache drops old ones
+    for (int64_t cx = 1; cx <= 32; cx++) {
+        chunk_cache_prefetch(cache, cx, 0, cx + VIEW_CHUNKS - 1, VIEW_CHUNKS - 1);
+    }
+    print_world(cache, 32, 0);
+
+    chunk_cache_stats_t stats;
+    chunk_cache_get_stats(cache, &stats);
+    printf("\nChunk cache: %zu resident of %d, %llu generated, %llu hits, %llu evicted\n",
+           stats.resident, CACHE_CHUNKS, (unsigned long long)stats.misses,
+           (unsigned long long)stats.hits, (unsigned long long)stats.evictions);
+
+    chunk_cache_free(cache);
     return 0;
 }
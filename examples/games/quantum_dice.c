@@ -1,5 +1,6 @@
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <math.h>
 #include "quantum_dice.h"
 #include "../../src/quantum_rng/quantum_rng.h"
@@ -7,6 +8,8 @@
 // Internal constants
 #define QUANTUM_MIXING_ROUNDS 3
 #define MAX_BATCH_SIZE 1000
+#define ROLL_CHUNK 1024     // Words drawn per qrng_bytes call
+#define SPEC_CHUNK 4096     // Faces rolled per batch in quantum_dice_roll_spec
 
 struct quantum_dice_t {
     qrng_ctx *qrng;        // Quantum RNG context
@@ -88,24 +91,190 @@ int quantum_dice_sides(const quantum_dice_t *dice) {
 }
 
 int quantum_dice_batch_roll(quantum_dice_t *dice, int *results, int count) {
-    if (!dice || !results || count <= 0 || count > MAX_BATCH_SIZE) {
+    if (!dice || !results || count <= 0) {
         return -1;
     }
-    
-    // Each roll is an independent, exactly-unbiased draw over [1, sides],
-    // using the same rejection-sampling scheme as the single-roll path.
+
+    // Each roll is an independent, exactly-unbiased draw over [1, sides].
     // (An earlier version averaged several uniforms per roll, which produced
     // a bell-shaped Irwin-Hall distribution biased toward the middle faces.)
-    const uint64_t sides = (uint64_t)dice->sides;
-    const uint64_t threshold = (0ULL - sides) % sides;  // == 2^64 mod sides
-    for (int i = 0; i < count; i++) {
-        uint64_t r;
-        do {
-            r = qrng_uint64(dice->qrng);
-        } while (r < threshold);
-        results[i] = (int)(r % sides) + 1;
+    return quantum_dice_roll_range(dice->qrng, 1, dice->sides, results, (size_t)count);
+}
+
+/*
+ * Lemire's multiply-shift reduction. A w-bit word x maps to the high w bits
+ * of x * span, which lands in [0, span). Each value has floor(2^w / span)
+ * or one more preimage; the extras are exactly the products whose low w
+ * bits fall below threshold = 2^w mod span, so rejecting those leaves every
+ * value with the same count. The rejection rate is below span / 2^w.
+ *
+ * The first pass over a chunk is branch-free (map every word, OR together
+ * the reject flags) so it vectorizes. Only a chunk that saw a rejection
+ * takes the second, compacting pass. Returns the number of values written.
+ */
+static size_t roll_chunk16(qrng_ctx *ctx, uint32_t span, int min, int *out, size_t n) {
+    uint16_t words[ROLL_CHUNK];
+    uint32_t threshold = 65536u % span;
+    qrng_bytes(ctx, (uint8_t *)words, n * sizeof(uint16_t));
+
+    uint32_t rejected = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t m = (uint32_t)words[i] * span;
+        out[i] = min + (int)(m >> 16);
+        rejected |= (m & 0xFFFFu) < threshold;
+    }
+    if (!rejected) return n;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t m = (uint32_t)words[i] * span;
+        out[kept] = min + (int)(m >> 16);
+        kept += (m & 0xFFFFu) >= threshold;
+    }
+    return kept;
+}
+
+static size_t roll_chunk32(qrng_ctx *ctx, uint64_t span, int min, int *out, size_t n) {
+    uint32_t words[ROLL_CHUNK];
+    uint64_t threshold = (1ULL << 32) % span;
+    qrng_bytes(ctx, (uint8_t *)words, n * sizeof(uint32_t));
+
+    uint32_t rejected = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t m = (uint64_t)words[i] * span;
+        out[i] = (int)((int64_t)min + (int64_t)(m >> 32));
+        rejected |= (m & 0xFFFFFFFFu) < threshold;
+    }
+    if (!rejected) return n;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t m = (uint64_t)words[i] * span;
+        out[kept] = (int)((int64_t)min + (int64_t)(m >> 32));
+        kept += (m & 0xFFFFFFFFu) >= threshold;
+    }
+    return kept;
+}
+
+int quantum_dice_roll_range(qrng_ctx *ctx, int min, int max, int *results, size_t count) {
+    if (!ctx || !results || min > max) {
+        return -1;
+    }
+
+    uint64_t span = (uint64_t)((int64_t)max - (int64_t)min) + 1;
+    size_t done = 0;
+    while (done < count) {
+        size_t n = count - done;
+        if (n > ROLL_CHUNK) n = ROLL_CHUNK;
+        done += span <= 256 ? roll_chunk16(ctx, (uint32_t)span, min, results + done, n)
+                            : roll_chunk32(ctx, span, min, results + done, n);
+    }
+    return 0;
+}
+
+// Parse an unsigned decimal of at most 9 digits; returns -1 if none
+static long parse_count(const char **s) {
+    if (!isdigit((unsigned char)**s)) return -1;
+    long v = 0;
+    for (int digits = 0; isdigit((unsigned char)**s); digits++, (*s)++) {
+        if (digits == 9) return -1;
+        v = v * 10 + (**s - '0');
+    }
+    return v;
+}
+
+int quantum_dice_parse_spec(const char *text, quantum_dice_spec_t *spec) {
+    if (!text || !spec) {
+        return -1;
+    }
+    memset(spec, 0, sizeof(*spec));
+
+    // Work on a copy without whitespace
+    char buf[256];
+    size_t len = 0;
+    for (const char *p = text; *p; p++) {
+        if (isspace((unsigned char)*p)) continue;
+        if (len + 1 >= sizeof(buf)) return -1;
+        buf[len++] = (char)tolower((unsigned char)*p);
+    }
+    buf[len] = '\0';
+    if (len == 0) return -1;
+
+    const char *s = buf;
+    int sign = 1;
+    for (;;) {
+        long n = parse_count(&s);
+        if (*s == 'd') {
+            s++;
+            long sides = parse_count(&s);
+            if (n < 0) n = 1;   // "d20" is one die
+            if (sign < 0 || n < 1 || sides < 2 || sides > QUANTUM_DICE_MAX_SIDES ||
+                spec->num_terms == QUANTUM_DICE_MAX_TERMS ||
+                spec->dice_per_roll + n > QUANTUM_DICE_MAX_DICE) {
+                return -1;
+            }
+            spec->counts[spec->num_terms] = (int)n;
+            spec->sides[spec->num_terms] = (int)sides;
+            spec->num_terms++;
+            spec->dice_per_roll += (int)n;
+        } else {
+            if (n < 0) return -1;
+            long modifier = spec->modifier + sign * n;
+            if (labs(modifier) > QUANTUM_DICE_MAX_MODIFIER) return -1;
+            spec->modifier = (int)modifier;
+        }
+
+        if (*s == '\0') break;
+        if (*s != '+' && *s != '-') return -1;
+        sign = *s == '+' ? 1 : -1;
+        s++;
+    }
+    return spec->num_terms > 0 ? 0 : -1;
+}
+
+int quantum_dice_roll_spec(qrng_ctx *ctx, const quantum_dice_spec_t *spec, size_t repeats,
+                           int *results, int64_t *totals) {
+    if (!ctx || !spec || spec->num_terms < 1 || (!results && !totals)) {
+        return -1;
+    }
+
+    int *faces = malloc(SPEC_CHUNK * sizeof(int));
+    if (!faces) {
+        return -1;
+    }
+    if (totals) {
+        for (size_t r = 0; r < repeats; r++) totals[r] = spec->modifier;
+    }
+
+    // Term by term, roll that term's dice for a run of repeats in one batch
+    // and scatter the faces into each roll's slots
+    size_t stride = (size_t)spec->dice_per_roll;
+    size_t offset = 0;
+    for (int t = 0; t < spec->num_terms; t++) {
+        size_t per_roll = (size_t)spec->counts[t];
+        size_t run = SPEC_CHUNK / per_roll;
+        if (run == 0) run = 1;
+
+        for (size_t first = 0; first < repeats; first += run) {
+            size_t rolls = repeats - first < run ? repeats - first : run;
+            // A term wider than SPEC_CHUNK rolls in pieces of one roll
+            for (size_t done = 0; done < rolls * per_roll; ) {
+                size_t n = rolls * per_roll - done;
+                if (n > SPEC_CHUNK) n = SPEC_CHUNK;
+                quantum_dice_roll_range(ctx, 1, spec->sides[t], faces, n);
+                for (size_t i = 0; i < n; i++) {
+                    size_t r = first + (done + i) / per_roll;
+                    size_t die = (done + i) % per_roll;
+                    if (results) results[r * stride + offset + die] = faces[i];
+                    if (totals) totals[r] += faces[i];
+                }
+                done += n;
+            }
+        }
+        offset += per_roll;
     }
 
+    free(faces);
     return 0;
 }
 
@@ -1,6 +1,8 @@
 #ifndef QUANTUM_DICE_H
 #define QUANTUM_DICE_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include "../../src/quantum_rng/quantum_rng.h"
 
 // Forward declaration of the opaque type
@@ -49,6 +51,67 @@ int quantum_dice_sides(const quantum_dice_t *dice);
  */
 int quantum_dice_batch_roll(quantum_dice_t *dice, int *results, int count);
 
+/**
+ * Roll count values uniform on [min, max] (min <= max)
+ *
+ * Random words are drawn in bulk and mapped with Lemire's multiply-shift
+ * reduction; the few words in the biased tail are rejected, so every value
+ * is exactly equally likely. Spans up to 256 use 16-bit words (two dice per
+ * 32 random bits), wider spans 32-bit words.
+ *
+ * @param ctx QRNG context to use for random number generation
+ * @param min Smallest value
+ * @param max Largest value
+ * @param results Array of count values
+ * @param count Number of values
+ * @return 0 on success, non-zero on error
+ */
+int quantum_dice_roll_range(qrng_ctx *ctx, int min, int max, int *results, size_t count);
+
+#define QUANTUM_DICE_MAX_TERMS 16
+#define QUANTUM_DICE_MAX_SIDES 1000000
+#define QUANTUM_DICE_MAX_DICE 100000     // Dice in one roll of an expression
+#define QUANTUM_DICE_MAX_MODIFIER 1000000
+
+/**
+ * A parsed dice expression such as "3d6+2d20+5": one term per NdS group
+ * (N defaults to 1) plus a constant modifier
+ */
+typedef struct {
+    int num_terms;
+    int counts[QUANTUM_DICE_MAX_TERMS];   // Dice in each term
+    int sides[QUANTUM_DICE_MAX_TERMS];    // Sides of each term's dice, 2..QUANTUM_DICE_MAX_SIDES
+    int modifier;                         // Sum of the constant terms
+    int dice_per_roll;                    // Total dice in one roll of the expression
+} quantum_dice_spec_t;
+
+/**
+ * Parse a dice expression of NdS and constant terms joined by '+' or '-'
+ * (constants only may be subtracted), e.g. "3d6+2d20", "d20+4", "4d6-1"
+ *
+ * @param text Expression (whitespace is ignored)
+ * @param spec Parsed expression
+ * @return 0 on success, non-zero on a malformed expression or too many dice
+ */
+int quantum_dice_parse_spec(const char *text, quantum_dice_spec_t *spec);
+
+/**
+ * Roll a dice expression repeats times in one call
+ *
+ * Each term's dice for all repeats are drawn as one batch. Faces are stored
+ * roll by roll in expression order: results[r * dice_per_roll + i] is die i
+ * of roll r.
+ *
+ * @param ctx QRNG context to use for random number generation
+ * @param spec Parsed expression
+ * @param repeats Number of rolls of the whole expression
+ * @param results Faces, repeats * spec->dice_per_roll values (may be NULL)
+ * @param totals Sum of faces plus modifier per roll, repeats values (may be NULL)
+ * @return 0 on success, non-zero on error
+ */
+int quantum_dice_roll_spec(qrng_ctx *ctx, const quantum_dice_spec_t *spec, size_t repeats,
+                           int *results, int64_t *totals);
+
 /**
  * Reset the quantum dice state
  * 
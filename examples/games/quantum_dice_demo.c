@@ -46,6 +46,16 @@ int main() {
         printf("\n");
     }
     
+    // Mixed dice expression in one call
+    quantum_dice_spec_t spec;
+    int faces[5];
+    int64_t total;
+    if (quantum_dice_parse_spec("3d6+2d20+5", &spec) == 0 &&
+        quantum_dice_roll_spec(ctx, &spec, 1, faces, &total) == 0) {
+        printf("\nRolling 3d6+2d20+5: %d %d %d | %d %d | +5 = %lld\n",
+               faces[0], faces[1], faces[2], faces[3], faces[4], (long long)total);
+    }
+
     // Distribution demonstration
     printf("\nD6 Distribution Test (1000 rolls):\n");
     int counts[6] = {0};
@@ -2,12 +2,23 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 #include "quantum_dice.h"
 #include "../../src/quantum_rng/quantum_rng.h"
 
 // Statistical test parameters
 #define NUM_ROLLS 1000000  // Large sample size for statistical significance
 #define TOLERANCE 0.01  // 1% tolerance for expected frequencies
+#define SPEC_ROLLS 200000  // Rolls of a whole dice expression
+
+// Failures in the batch-roller tests, which use a fixed seed
+static int failures = 0;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
 
 // Chi-square critical values for different degrees of freedom (df) at 95% confidence
 static double get_chi_square_critical(int df) {
@@ -15,15 +26,35 @@ static double get_chi_square_critical(int df) {
     switch(df) {
         case 3:  return 7.815;  // d4
         case 5:  return 11.070; // d6
+        case 6:  return 12.592; // [-3, 3]
         case 7:  return 14.067; // d8
         case 9:  return 16.919; // d10
         case 11: return 19.675; // d12
         case 19: return 30.144; // d20
         case 99: return 123.225; // d100
+        case 999: return 1073.643; // [1, 1000]
         default: return df * 1.5; // Conservative estimate for other sizes
     }
 }
 
+// Chi-square critical values at 99.9% confidence. The batch-roller tests
+// fail only beyond these, so a dozen statistics at a fixed seed do not
+// fail by chance one run in two.
+static double get_chi_square_strict(int df) {
+    switch(df) {
+        case 3:   return 16.266;
+        case 5:   return 20.515;
+        case 6:   return 22.458;
+        case 7:   return 24.322;
+        case 9:   return 27.877;
+        case 11:  return 31.264;
+        case 19:  return 43.820;
+        case 99:  return 148.230;
+        case 999: return 1142.848;
+        default:  return df * 2.0;
+    }
+}
+
 // Test helper functions
 static void print_distribution(const char* test_name, int* results, int sides) {
     printf("\n%s Distribution:\n", test_name);
@@ -210,6 +241,181 @@ static void test_stress() {
     printf("Stress tests completed\n");
 }
 
+// Chi-square statistic of counts[0..bins) against a uniform expectation
+static double chi_square_uniform(const int *counts, int bins, double total) {
+    double expected = total / bins;
+    double chi_square = 0.0;
+    for (int i = 0; i < bins; i++) {
+        double diff = counts[i] - expected;
+        chi_square += diff * diff / expected;
+    }
+    return chi_square;
+}
+
+static void test_batch_uniformity() {
+    printf("\n=== Testing Batch Range Rolling Uniformity ===\n");
+
+    qrng_ctx *ctx;
+    if (qrng_init(&ctx, (const uint8_t *)"dice-batch", 10) != QRNG_SUCCESS) {
+        fprintf(stderr, "Failed to initialize QRNG\n");
+        failures++;
+        return;
+    }
+
+    // 16-bit lanes up to span 256, 32-bit lanes above
+    static const int ranges[][2] = {
+        {1, 4}, {1, 6}, {1, 8}, {1, 10}, {1, 12}, {1, 20}, {1, 100}, {-3, 3}, {1, 1000}
+    };
+    int *rolls = malloc(NUM_ROLLS * sizeof(int));
+    printf("Range\t\tChi-square\tCritical (95%%)\tResult\n");
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+        int min = ranges[r][0], max = ranges[r][1], bins = max - min + 1;
+        int *counts = calloc(bins, sizeof(int));
+        int ok = quantum_dice_roll_range(ctx, min, max, rolls, NUM_ROLLS) == 0;
+        for (int i = 0; ok && i < NUM_ROLLS; i++) {
+            if (rolls[i] < min || rolls[i] > max) ok = 0;
+            else counts[rolls[i] - min]++;
+        }
+        double chi_square = chi_square_uniform(counts, bins, NUM_ROLLS);
+        double critical = get_chi_square_critical(bins - 1);
+        ok = ok && chi_square < get_chi_square_strict(bins - 1);
+        printf("[%d, %d]\t%s%.4f\t\t%.4f\t\t%s\n", min, max, max < 100 ? "\t" : "",
+               chi_square, critical,
+               !ok ? "FAIL" : chi_square < critical ? "PASS" : "PASS (above 95%, below 99.9%)");
+        if (!ok) failures++;
+        free(counts);
+    }
+
+    // Bad arguments
+    if (quantum_dice_roll_range(ctx, 5, 4, rolls, 1) == 0 ||
+        quantum_dice_roll_range(NULL, 1, 6, rolls, 1) == 0) {
+        printf("Argument checks: FAIL\n");
+        failures++;
+    }
+
+    free(rolls);
+    qrng_free(ctx);
+}
+
+static void test_dice_spec() {
+    printf("\n=== Testing Mixed Dice Expressions ===\n");
+
+    static const struct { const char *text; int ok; int dice; int modifier; } cases[] = {
+        { "3d6+2d20",     1, 5, 0 },
+        { "d20 + 4",      1, 1, 4 },
+        { "4D6-1",        1, 4, -1 },
+        { "2+1d8+3",      1, 1, 5 },
+        { "",             0, 0, 0 },
+        { "3d",           0, 0, 0 },
+        { "3d1",          0, 0, 0 },
+        { "0d6",          0, 0, 0 },
+        { "2d6-1d4",      0, 0, 0 },   // Dice may only be added
+        { "5",            0, 0, 0 },   // No dice
+        { "2d6*3",        0, 0, 0 },
+    };
+    int parse_ok = 1;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        quantum_dice_spec_t spec;
+        int parsed = quantum_dice_parse_spec(cases[i].text, &spec) == 0;
+        if (parsed != cases[i].ok ||
+            (parsed && (spec.dice_per_roll != cases[i].dice || spec.modifier != cases[i].modifier))) {
+            printf("Parse \"%s\": FAIL\n", cases[i].text);
+            parse_ok = 0;
+        }
+    }
+    printf("Expression parsing: %s\n", parse_ok ? "PASS" : "FAIL");
+    if (!parse_ok) failures++;
+
+    qrng_ctx *ctx;
+    if (qrng_init(&ctx, (const uint8_t *)"dice-spec", 9) != QRNG_SUCCESS) {
+        fprintf(stderr, "Failed to initialize QRNG\n");
+        failures++;
+        return;
+    }
+
+    quantum_dice_spec_t spec;
+    quantum_dice_parse_spec("3d6+2d20+5", &spec);
+    int *faces = malloc((size_t)SPEC_ROLLS * spec.dice_per_roll * sizeof(int));
+    int64_t *totals = malloc(SPEC_ROLLS * sizeof(int64_t));
+    int ok = quantum_dice_roll_spec(ctx, &spec, SPEC_ROLLS, faces, totals) == 0;
+
+    // Faces sit in expression order and sum (plus the modifier) to the total
+    int d6_counts[6] = {0}, d20_counts[20] = {0};
+    double mean = 0.0;
+    for (int r = 0; ok && r < SPEC_ROLLS; r++) {
+        const int *f = faces + (size_t)r * spec.dice_per_roll;
+        int64_t sum = spec.modifier;
+        for (int i = 0; i < spec.dice_per_roll; i++) {
+            int sides = i < 3 ? 6 : 20;
+            if (f[i] < 1 || f[i] > sides) ok = 0;
+            else if (sides == 6) d6_counts[f[i] - 1]++;
+            else d20_counts[f[i] - 1]++;
+            sum += f[i];
+        }
+        if (sum != totals[r]) ok = 0;
+        mean += totals[r];
+    }
+    mean /= SPEC_ROLLS;
+
+    double chi6 = chi_square_uniform(d6_counts, 6, 3.0 * SPEC_ROLLS);
+    double chi20 = chi_square_uniform(d20_counts, 20, 2.0 * SPEC_ROLLS);
+    // Var(total) = 3 * 35/12 + 2 * 399/12, so the mean's standard error is ~0.02
+    ok = ok && chi6 < get_chi_square_strict(5) && chi20 < get_chi_square_strict(19) &&
+         fabs(mean - 36.5) < 0.1;
+    printf("3d6+2d20+5 x %d: mean total %.3f (expected 36.5), d6 chi-square %.2f, "
+           "d20 chi-square %.2f\n", SPEC_ROLLS, mean, chi6, chi20);
+    printf("Result: %s\n", ok ? "PASS" : "FAIL");
+    if (!ok) failures++;
+
+    free(faces);
+    free(totals);
+    qrng_free(ctx);
+}
+
+static void test_throughput() {
+    printf("\n=== Roll Throughput ===\n");
+
+    qrng_ctx *ctx;
+    if (qrng_init(&ctx, (const uint8_t *)"dice-speed", 10) != QRNG_SUCCESS) {
+        fprintf(stderr, "Failed to initialize QRNG\n");
+        failures++;
+        return;
+    }
+    quantum_dice_t *d6 = quantum_dice_create(ctx, 6);
+    int *rolls = malloc(NUM_ROLLS * sizeof(int));
+
+    double start = now_seconds();
+    for (int i = 0; i < NUM_ROLLS / 4; i++) rolls[i] = quantum_dice_roll(d6);
+    double single = (NUM_ROLLS / 4) / (now_seconds() - start);
+
+    start = now_seconds();
+    quantum_dice_batch_roll(d6, rolls, NUM_ROLLS);
+    double batch16 = NUM_ROLLS / (now_seconds() - start);
+
+    start = now_seconds();
+    quantum_dice_roll_range(ctx, 1, 1000, rolls, NUM_ROLLS);
+    double batch32 = NUM_ROLLS / (now_seconds() - start);
+
+    quantum_dice_spec_t spec;
+    quantum_dice_parse_spec("3d6+2d20", &spec);
+    int64_t *totals = malloc(SPEC_ROLLS * sizeof(int64_t));
+    start = now_seconds();
+    quantum_dice_roll_spec(ctx, &spec, SPEC_ROLLS, NULL, totals);
+    double mixed = (double)SPEC_ROLLS * spec.dice_per_roll / (now_seconds() - start);
+
+    printf("quantum_dice_roll (d6, one word per roll): %12.0f rolls/sec\n", single);
+    printf("Batch d6 (16-bit lanes):                   %12.0f rolls/sec (%.1fx)\n",
+           batch16, batch16 / single);
+    printf("Batch [1, 1000] (32-bit lanes):            %12.0f rolls/sec (%.1fx)\n",
+           batch32, batch32 / single);
+    printf("Expression 3d6+2d20:                       %12.0f dice/sec\n", mixed);
+
+    free(totals);
+    free(rolls);
+    quantum_dice_free(d6);
+    qrng_free(ctx);
+}
+
 int main() {
     printf("=== Quantum Dice Test Suite ===\n");
     
@@ -217,7 +423,14 @@ int main() {
     test_fairness_across_sizes();
     test_sequential_independence();
     test_stress();
-    
+    test_batch_uniformity();
+    test_dice_spec();
+    test_throughput();
+
+    if (failures) {
+        printf("\n%d batch roller test(s) FAILED.\n", failures);
+        return 1;
+    }
     printf("\nAll tests completed.\n");
     return 0;
 }
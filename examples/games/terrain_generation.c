@@ -1,73 +1,136 @@
 #include "terrain_generation.h"
+#include "chunk_cache.h"
+#include "../../src/scheduler/task_pool.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Noise layers, as lattice cells per map side in the first octave. Whole
+ * numbers make every octave wrap with the map; the unbounded world uses the
+ * same frequencies without the wrap.
+ */
+#define HEIGHT_PERIOD 3
+#define HEIGHT_OCTAVES 6
+#define RIDGE_PERIOD 5
+#define RIDGE_OCTAVES 4
+#define CLIMATE_PERIOD 2
+#define CLIMATE_OCTAVES 3
+#define CAVE_PERIOD 13
+#define CAVE_OCTAVES 4
+
+// Fractal gradient noise clusters around its mean; stretch it back out
+// so the biome thresholds see the whole [0, 1] range
+#define HEIGHT_CONTRAST 2.0f
+#define CLIMATE_CONTRAST 2.5f
+
+static inline float stretch(float v, float mean, float contrast) {
+    v = 0.5f + (v - mean) * contrast;
+    return v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v;
+}
 
-// Quantum noise functions
-float quantum_noise2d(qrng_ctx *ctx, int x, int y, float frequency) {
-    double dx = x * frequency;
-    double dy = y * frequency;
-    
-    uint64_t hash = qrng_uint64(ctx);
-    double rx = (double)(hash & 0xFFFFFFFF) / UINT32_MAX;
-    double ry = (double)(hash >> 32) / UINT32_MAX;
-    
-    return (float)(cos(dx * rx + dy * ry) * 0.5 + 0.5);
+static noise_fbm_t layer(int period, int octaves, int ridged, int wrap) {
+    noise_fbm_t fbm;
+    fbm.frequency = (double)period / MAP_SIZE;
+    fbm.octaves = octaves;
+    fbm.period = wrap ? period : 0;
+    fbm.ridged = ridged;
+    return fbm;
 }
 
-float quantum_ridged_noise(qrng_ctx *ctx, int x, int y, float frequency) {
-    return 1.0f - fabsf(quantum_noise2d(ctx, x, y, frequency) * 2.0f - 1.0f);
+// Whole lattice cells per map side for a frequency, at least one
+static int map_period(float frequency) {
+    int period = (int)lrintf(frequency * MAP_SIZE);
+    return period < 1 ? 1 : period > NOISE_TABLE_SIZE ? NOISE_TABLE_SIZE : period;
 }
 
-// Terrain generation functions
-void generate_base_terrain(terrain_map_t *terrain, qrng_ctx *ctx) {
-    // Multi-octave quantum noise for heightmap
-    for (int y = 0; y < MAP_SIZE; y++) {
-        for (int x = 0; x < MAP_SIZE; x++) {
-            float amplitude = 1.0f;
-            float frequency = 0.01f;
-            float height = 0;
-            float height_norm = 0;
-
-            // Regular noise for base terrain
-            for (int octave = 0; octave < 6; octave++) {
-                height += quantum_noise2d(ctx, x, y, frequency) * amplitude;
-                height_norm += amplitude;
-                amplitude *= 0.5f;
-                frequency *= 2.0f;
-            }
-            height /= height_norm;  // Normalize octave sum to [0, 1]
-
-            // Ridged noise for mountains
-            amplitude = 0.5f;
-            frequency = 0.02f;
-            float mountain = 0;
-            float mountain_norm = 0;
-            for (int octave = 0; octave < 4; octave++) {
-                mountain += quantum_ridged_noise(ctx, x, y, frequency) * amplitude;
-                mountain_norm += amplitude;
-                amplitude *= 0.5f;
-                frequency *= 2.0f;
-            }
-            mountain /= mountain_norm;  // Normalize to [0, 1]
+float quantum_noise2d(const noise_table_t *noise, int x, int y, float frequency) {
+    int period = map_period(frequency);
+    double f = (double)period / MAP_SIZE;
+    return 0.5f + 0.5f * noise_sample(noise, x * f, y * f, period);
+}
 
-            // Combine height and mountain noise; result stays in [0, MAX_HEIGHT]
-            terrain->cells[y][x].height = (height * 0.7f + mountain * 0.3f) * MAX_HEIGHT;
+float quantum_ridged_noise(const noise_table_t *noise, int x, int y, float frequency) {
+    int period = map_period(frequency);
+    double f = (double)period / MAP_SIZE;
+    return 1.0f - fabsf(noise_sample(noise, x * f, y * f, period));
+}
 
-            // Generate climate data
-            terrain->cells[y][x].moisture = quantum_noise2d(ctx, x, y, 0.005f);
-            terrain->cells[y][x].temperature =
-                quantum_noise2d(ctx, x + 1000, y + 1000, 0.005f) -
-                (terrain->cells[y][x].height / MAX_HEIGHT) * 0.5f; // Temperature decreases with height
+/*
+ * Height, moisture and temperature for the n cells starting at (x0, y).
+ * wrap selects the toroidal map; otherwise the fields continue forever.
+ */
+static void terrain_fields_row(const noise_table_t *noise, int wrap, int64_t x0, int64_t y,
+                               size_t n, float *height, float *moisture, float *temperature) {
+    float ridge[TERRAIN_CHUNK_SIZE];
+    noise_fbm_t base = layer(HEIGHT_PERIOD, HEIGHT_OCTAVES, 0, wrap);
+    noise_fbm_t mountains = layer(RIDGE_PERIOD, RIDGE_OCTAVES, 1, wrap);
+    noise_fbm_t climate = layer(CLIMATE_PERIOD, CLIMATE_OCTAVES, 0, wrap);
+
+    noise_fbm_row(noise, &base, (double)x0, (double)y, n, height);
+    noise_fbm_row(noise, &mountains, (double)x0, (double)y, n, ridge);
+    noise_fbm_row(noise, &climate, (double)x0, (double)y, n, moisture);
+    noise_fbm_row(noise, &climate, (double)(x0 + 1000), (double)(y + 1000), n, temperature);
+
+    for (size_t i = 0; i < n; i++) {
+        // Combine height and mountain noise; result stays in [0, MAX_HEIGHT]
+        float h = stretch(height[i] * 0.7f + ridge[i] * 0.3f, 0.55f, HEIGHT_CONTRAST);
+        height[i] = h * MAX_HEIGHT;
+        moisture[i] = stretch(moisture[i], 0.5f, CLIMATE_CONTRAST);
+        // Temperature decreases with height (neutral at mid elevation)
+        temperature[i] = stretch(temperature[i], 0.5f, CLIMATE_CONTRAST) - (h - 0.5f) * 0.5f;
+    }
+}
 
-            // No river here yet; generate_rivers() marks river tiles with 0.
-            // (Leaving this uninitialized made is_water() read garbage.)
-            terrain->cells[y][x].river_distance = RIVER_NONE;
-            terrain->cells[y][x].cave_density = 0.0f;
+typedef struct {
+    terrain_map_t *terrain;
+    int caves;   // Fill cave_density instead of the base fields
+} tile_job_t;
+
+#define TILES_PER_SIDE (MAP_SIZE / TERRAIN_TILE)
+
+static void fill_tiles(void *arg, size_t begin, size_t end) {
+    const tile_job_t *job = arg;
+    terrain_map_t *terrain = job->terrain;
+    noise_fbm_t caves = layer(CAVE_PERIOD, CAVE_OCTAVES, 0, 1);
+    float height[TERRAIN_TILE], moisture[TERRAIN_TILE], temperature[TERRAIN_TILE];
+
+    for (size_t t = begin; t < end; t++) {
+        int x0 = (int)(t % TILES_PER_SIDE) * TERRAIN_TILE;
+        int y0 = (int)(t / TILES_PER_SIDE) * TERRAIN_TILE;
+        for (int y = y0; y < y0 + TERRAIN_TILE; y++) {
+            terrain_cell_t *row = &terrain->cells[y][x0];
+            if (job->caves) {
+                noise_fbm_row(&terrain->noise, &caves, x0, y + 2000, TERRAIN_TILE, height);
+                for (int i = 0; i < TERRAIN_TILE; i++) row[i].cave_density = height[i];
+                continue;
+            }
+            terrain_fields_row(&terrain->noise, 1, x0, y, TERRAIN_TILE,
+                               height, moisture, temperature);
+            for (int i = 0; i < TERRAIN_TILE; i++) {
+                row[i].height = height[i];
+                row[i].moisture = moisture[i];
+                row[i].temperature = temperature[i];
+                // No river here yet; generate_rivers() marks river tiles with 0.
+                // (Leaving this uninitialized made is_water() read garbage.)
+                row[i].river_distance = RIVER_NONE;
+                row[i].cave_density = 0.0f;
+            }
         }
     }
 }
 
+// Terrain generation functions
+void generate_base_terrain(terrain_map_t *terrain, qrng_ctx *ctx) {
+    // The only quantum draws: permutation and gradients for every layer
+    noise_table_init(&terrain->noise, ctx);
+
+    tile_job_t job = { terrain, 0 };
+    task_pool_parallel_for(NULL, TILES_PER_SIDE * TILES_PER_SIDE, 1, fill_tiles, &job);
+}
+
 void generate_rivers(terrain_map_t *terrain, qrng_ctx *ctx) {
     // Start rivers from high points
     for (int i = 0; i < terrain->num_rivers; i++) {
@@ -132,60 +195,31 @@ void generate_rivers(terrain_map_t *terrain, qrng_ctx *ctx) {
     }
 }
 
-void generate_caves(terrain_map_t *terrain, qrng_ctx *ctx) {
-    // Generate 3D noise for cave systems
-    for (int y = 0; y < MAP_SIZE; y++) {
-        for (int x = 0; x < MAP_SIZE; x++) {
-            float cave = 0;
-            float amplitude = 1.0f;
-            float frequency = 0.05f;
-            
-            for (int octave = 0; octave < 4; octave++) {
-                cave += quantum_noise2d(ctx, x, y + 2000, frequency) * amplitude;
-                amplitude *= 0.5f;
-                frequency *= 2.0f;
-            }
-            
-            terrain->cells[y][x].cave_density = cave;
-        }
-    }
+void generate_caves(terrain_map_t *terrain) {
+    // Cave density from its own band of the noise (offset in y), per tile
+    tile_job_t job = { terrain, 1 };
+    task_pool_parallel_for(NULL, TILES_PER_SIDE * TILES_PER_SIDE, 1, fill_tiles, &job);
+}
+
+biome_type classify_biome(float height, float moisture, float temperature,
+                          float sea_level, float mountain_level) {
+    if (height < sea_level) return BIOME_OCEAN;
+    if (height < sea_level + 10.0f) return BIOME_BEACH;
+    if (height > mountain_level) return BIOME_MOUNTAIN;
+    if (temperature < 0.2f) return BIOME_SNOW;
+    if (temperature < 0.4f) return BIOME_TUNDRA;
+    if (moisture < 0.2f) return BIOME_DESERT;
+    if (moisture < 0.4f) return BIOME_GRASSLAND;
+    if (moisture < 0.6f) return BIOME_FOREST;
+    return BIOME_RAINFOREST;
 }
 
 void determine_biomes(terrain_map_t *terrain) {
     for (int y = 0; y < MAP_SIZE; y++) {
         for (int x = 0; x < MAP_SIZE; x++) {
             terrain_cell_t *cell = &terrain->cells[y][x];
-            float height = cell->height;
-            float moisture = cell->moisture;
-            float temperature = cell->temperature;
-            
-            if (height < terrain->sea_level) {
-                cell->biome = BIOME_OCEAN;
-            }
-            else if (height < terrain->sea_level + 10.0f) {
-                cell->biome = BIOME_BEACH;
-            }
-            else if (height > terrain->mountain_level) {
-                cell->biome = BIOME_MOUNTAIN;
-            }
-            else if (temperature < 0.2f) {
-                cell->biome = BIOME_SNOW;
-            }
-            else if (temperature < 0.4f) {
-                cell->biome = BIOME_TUNDRA;
-            }
-            else if (moisture < 0.2f) {
-                cell->biome = BIOME_DESERT;
-            }
-            else if (moisture < 0.4f) {
-                cell->biome = BIOME_GRASSLAND;
-            }
-            else if (moisture < 0.6f) {
-                cell->biome = BIOME_FOREST;
-            }
-            else {
-                cell->biome = BIOME_RAINFOREST;
-            }
+            cell->biome = classify_biome(cell->height, cell->moisture, cell->temperature,
+                                         terrain->sea_level, terrain->mountain_level);
         }
     }
 }
@@ -193,8 +227,8 @@ void determine_biomes(terrain_map_t *terrain) {
 // Main generation function
 void generate_terrain(terrain_map_t *terrain, qrng_ctx *ctx) {
     // Initialize parameters
-    terrain->sea_level = MAX_HEIGHT * 0.4f;
-    terrain->mountain_level = MAX_HEIGHT * 0.8f;
+    terrain->sea_level = SEA_LEVEL;
+    terrain->mountain_level = MOUNTAIN_LEVEL;
     terrain->num_rivers = 5;
     terrain->erosion_factor = 0.1f;
     
@@ -203,12 +237,28 @@ void generate_terrain(terrain_map_t *terrain, qrng_ctx *ctx) {
     
     // Add features
     generate_rivers(terrain, ctx);
-    generate_caves(terrain, ctx);
+    generate_caves(terrain);
     
     // Determine biomes
     determine_biomes(terrain);
 }
 
+void generate_terrain_chunk(const noise_table_t *noise, int64_t chunk_x, int64_t chunk_y,
+                            terrain_chunk_t *chunk) {
+    int64_t x0 = chunk_x * TERRAIN_CHUNK_SIZE;
+    int64_t y0 = chunk_y * TERRAIN_CHUNK_SIZE;
+    for (int y = 0; y < TERRAIN_CHUNK_SIZE; y++) {
+        terrain_fields_row(noise, 0, x0, y0 + y, TERRAIN_CHUNK_SIZE,
+                           chunk->height[y], chunk->moisture[y], chunk->temperature[y]);
+        for (int x = 0; x < TERRAIN_CHUNK_SIZE; x++) {
+            chunk->biome[y][x] = (uint8_t)classify_biome(chunk->height[y][x],
+                                                         chunk->moisture[y][x],
+                                                         chunk->temperature[y][x],
+                                                         SEA_LEVEL, MOUNTAIN_LEVEL);
+        }
+    }
+}
+
 // Utility functions for game integration
 float get_height(const terrain_map_t *terrain, int x, int y) {
     x = (x + MAP_SIZE) % MAP_SIZE;
@@ -269,6 +319,14 @@ int is_water(const terrain_map_t *terrain, int x, int y) {
 // DEMO DRIVER
 // ============================================================================
 
+static double elapsed_ms(struct timespec a, struct timespec b) {
+    return (b.tv_sec - a.tv_sec) * 1e3 + (b.tv_nsec - a.tv_nsec) / 1e6;
+}
+
+static void generate_chunk(void *user, int64_t chunk_x, int64_t chunk_y, void *chunk) {
+    generate_terrain_chunk(user, chunk_x, chunk_y, chunk);
+}
+
 static char biome_char(biome_type b) {
     switch (b) {
         case BIOME_OCEAN:      return '~';
@@ -284,6 +342,72 @@ static char biome_char(biome_type b) {
     }
 }
 
+/*
+ * Stream the unbounded version of the world: a camera walks east, keeping
+ * a 5x3-chunk window resident, while the cache recycles what it left
+ * behind. Returns non-zero if a regenerated chunk differs from the first
+ * generation.
+ */
+#define STREAM_CACHE_CHUNKS 32
+#define STREAM_STEPS 64
+
+static int stream_world(const noise_table_t *noise) {
+    chunk_cache_t *cache = chunk_cache_create(STREAM_CACHE_CHUNKS, sizeof(terrain_chunk_t),
+                                              generate_chunk, (void *)noise);
+    terrain_chunk_t *origin = malloc(sizeof(terrain_chunk_t));
+    if (!cache || !origin) {
+        fprintf(stderr, "Out of memory\n");
+        chunk_cache_free(cache);
+        free(origin);
+        return 1;
+    }
+    memcpy(origin, chunk_cache_get(cache, 0, 0), sizeof(terrain_chunk_t));
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int64_t cx = 0; cx < STREAM_STEPS; cx++) {
+        chunk_cache_prefetch(cache, cx - 2, -1, cx + 2, 1);
+        // Player-side lookups around the camera are cache hits
+        for (int64_t dy = -1; dy <= 1; dy++) {
+            for (int64_t dx = -1; dx <= 1; dx++) chunk_cache_get(cache, cx + dx, dy);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    // The origin was evicted long ago; walking back regenerates it
+    int identical = memcmp(origin, chunk_cache_get(cache, 0, 0), sizeof(terrain_chunk_t)) == 0;
+
+    chunk_cache_stats_t stats;
+    chunk_cache_get_stats(cache, &stats);
+    double ms = elapsed_ms(t0, t1);
+    printf("\nStreaming %d chunks east (%dx%d cells each, %d-chunk LRU cache):\n",
+           STREAM_STEPS, TERRAIN_CHUNK_SIZE, TERRAIN_CHUNK_SIZE, STREAM_CACHE_CHUNKS);
+    printf("  Generated %llu chunks in %.1f ms (%.0f chunks/s), %llu hits, %llu evictions\n",
+           (unsigned long long)stats.misses, ms, stats.misses / (ms / 1e3),
+           (unsigned long long)stats.hits, (unsigned long long)stats.evictions);
+    printf("  Revisited origin chunk regenerated %s\n", identical ? "identically" : "DIFFERENTLY");
+
+    // Far from the origin the world goes on, no quantum draws needed
+    const int64_t far_x = 1000000;
+    printf("  Chunks (%lld..%lld, 0), downsampled 4x:\n",
+           (long long)far_x, (long long)far_x + 1);
+    chunk_cache_prefetch(cache, far_x, 0, far_x + 1, 0);
+    for (int y = 0; y < TERRAIN_CHUNK_SIZE; y += 4) {
+        printf("    ");
+        for (int64_t cx = far_x; cx <= far_x + 1; cx++) {
+            const terrain_chunk_t *chunk = chunk_cache_get(cache, cx, 0);
+            for (int x = 0; x < TERRAIN_CHUNK_SIZE; x += 4) {
+                putchar(biome_char((biome_type)chunk->biome[y][x]));
+            }
+        }
+        putchar('\n');
+    }
+
+    free(origin);
+    chunk_cache_free(cache);
+    return identical ? 0 : 1;
+}
+
 int main(void) {
     printf("Quantum Terrain Generation Demo\n");
     printf("===============================\n\n");
@@ -303,7 +427,10 @@ int main(void) {
         return 1;
     }
 
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
     generate_terrain(terrain, ctx);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
 
     // Render a downsampled biome overview (every 4th cell)
     printf("Biome map (%dx%d, downsampled 4x):\n\n", MAP_SIZE, MAP_SIZE);
@@ -341,7 +468,24 @@ int main(void) {
         "Rainforest", "Tundra", "Snow", "Mountain"
     };
 
+    // The noise wraps with the map: steps across the edge look like any other
+    float edge_step = 0.0f, inner_step = 0.0f;
+    for (int y = 0; y < MAP_SIZE; y++) {
+        for (int x = 0; x < MAP_SIZE; x++) {
+            float step = fabsf(get_height(terrain, x + 1, y) - get_height(terrain, x, y));
+            if (x == MAP_SIZE - 1) {
+                if (step > edge_step) edge_step = step;
+            } else if (step > inner_step) {
+                inner_step = step;
+            }
+        }
+    }
+
     printf("\nTerrain statistics (%d cells):\n", total);
+    printf("  Generated in %.1f ms (%d tiles of %dx%d cells)\n", elapsed_ms(t0, t1),
+           (MAP_SIZE / TERRAIN_TILE) * (MAP_SIZE / TERRAIN_TILE), TERRAIN_TILE, TERRAIN_TILE);
+    printf("  Largest height step: %.1f across the wrapped edge, %.1f inside\n",
+           edge_step, inner_step);
     printf("  Height: min %.1f, mean %.1f, max %.1f (sea level %.1f)\n",
            min_h, sum_h / total, max_h, terrain->sea_level);
     printf("  Rivers carved: %d tiles from %d sources\n",
@@ -355,9 +499,12 @@ int main(void) {
                biome_names[b], biome_counts[b], 100.0 * biome_counts[b] / total);
     }
 
+    int status = stream_world(&terrain->noise);
+
     free(terrain);
     qrng_free(ctx);
 
+    if (status != 0) return status;
     printf("\nTerrain generation completed successfully.\n");
     return 0;
 }
@@ -1,20 +1,32 @@
 #ifndef TERRAIN_GENERATION_H
 #define TERRAIN_GENERATION_H
 
+#include <stdint.h>
 #include "../../src/quantum_rng/quantum_rng.h"
+#include "terrain_noise.h"
 
 /**
  * @file terrain_generation.h
  * @brief Quantum-noise terrain generation for games
  *
- * Generates a wrapping (toroidal) terrain map from multi-octave quantum
+ * Generates a wrapping (toroidal) terrain map from multi-octave gradient
  * noise: heightmap with ridged mountain overlay, climate fields
  * (moisture/temperature), downhill-carved rivers, cave density, and a
- * biome classification. All randomness comes from the quantum RNG.
+ * biome classification. The noise tables and river sources come from the
+ * quantum RNG; every noise field is then a pure function of position, so
+ * the map is filled in independent tiles on the shared task pool.
+ *
+ * The same fields without the wrap describe an unbounded world, generated
+ * chunk by chunk (generate_terrain_chunk) and streamed through a
+ * chunk_cache_t.
  */
 
 #define MAP_SIZE 256
 #define MAX_HEIGHT 1000.0f
+#define TERRAIN_TILE 32          /**< Cells per side of a parallel generation tile */
+#define TERRAIN_CHUNK_SIZE 64    /**< Cells per side of a streamed chunk */
+#define SEA_LEVEL (MAX_HEIGHT * 0.4f)
+#define MOUNTAIN_LEVEL (MAX_HEIGHT * 0.8f)
 
 typedef enum {
     BIOME_OCEAN,
@@ -43,23 +55,40 @@ typedef struct {
 
 typedef struct {
     terrain_cell_t cells[MAP_SIZE][MAP_SIZE];
+    noise_table_t noise;   /**< Drawn once by generate_base_terrain */
     float sea_level;
     float mountain_level;
     int num_rivers;
     float erosion_factor;
 } terrain_map_t;
 
-// Quantum noise primitives
-float quantum_noise2d(qrng_ctx *ctx, int x, int y, float frequency);
-float quantum_ridged_noise(qrng_ctx *ctx, int x, int y, float frequency);
+/** One streamed chunk of the unbounded world (no rivers or caves) */
+typedef struct {
+    float height[TERRAIN_CHUNK_SIZE][TERRAIN_CHUNK_SIZE];
+    float moisture[TERRAIN_CHUNK_SIZE][TERRAIN_CHUNK_SIZE];
+    float temperature[TERRAIN_CHUNK_SIZE][TERRAIN_CHUNK_SIZE];
+    uint8_t biome[TERRAIN_CHUNK_SIZE][TERRAIN_CHUNK_SIZE];   /**< biome_type */
+} terrain_chunk_t;
+
+// Noise primitives in [0, 1]; the frequency is rounded to a whole number
+// of lattice cells per map so that the noise wraps with the map
+float quantum_noise2d(const noise_table_t *noise, int x, int y, float frequency);
+float quantum_ridged_noise(const noise_table_t *noise, int x, int y, float frequency);
 
 // Generation stages (generate_terrain runs all of them in order)
 void generate_base_terrain(terrain_map_t *terrain, qrng_ctx *ctx);
 void generate_rivers(terrain_map_t *terrain, qrng_ctx *ctx);
-void generate_caves(terrain_map_t *terrain, qrng_ctx *ctx);
+void generate_caves(terrain_map_t *terrain);
 void determine_biomes(terrain_map_t *terrain);
 void generate_terrain(terrain_map_t *terrain, qrng_ctx *ctx);
 
+// Unbounded world: chunk (chunk_x, chunk_y) covers cells
+// [chunk_x * TERRAIN_CHUNK_SIZE, (chunk_x + 1) * TERRAIN_CHUNK_SIZE) in x, likewise y
+biome_type classify_biome(float height, float moisture, float temperature,
+                          float sea_level, float mountain_level);
+void generate_terrain_chunk(const noise_table_t *noise, int64_t chunk_x, int64_t chunk_y,
+                            terrain_chunk_t *chunk);
+
 // Game-integration queries (coordinates wrap around the map edges)
 float get_height(const terrain_map_t *terrain, int x, int y);
 float get_slope(const terrain_map_t *terrain, int x, int y);
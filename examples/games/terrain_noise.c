@@ -0,0 +1,140 @@
+#include "terrain_noise.h"
+#include <math.h>
+#include <string.h>
+
+#define NOISE_BLOCK 64   // Points per lookup/arithmetic block in noise_row
+
+// Largest |noise| for unit gradients is sqrt(2)/2; scale it to 1
+#define NOISE_SCALE 1.41421356f
+
+int noise_table_init(noise_table_t *table, qrng_ctx *ctx) {
+    if (!table || !ctx) {
+        return -1;
+    }
+
+    // Fisher-Yates shuffle with unbiased quantum draws
+    uint8_t perm[NOISE_TABLE_SIZE];
+    for (int i = 0; i < NOISE_TABLE_SIZE; i++) perm[i] = (uint8_t)i;
+    for (int i = NOISE_TABLE_SIZE - 1; i > 0; i--) {
+        int j = (int)qrng_range32(ctx, 0, (uint32_t)i);
+        uint8_t t = perm[i];
+        perm[i] = perm[j];
+        perm[j] = t;
+    }
+    memcpy(table->perm, perm, NOISE_TABLE_SIZE);
+    memcpy(table->perm + NOISE_TABLE_SIZE, perm, NOISE_TABLE_SIZE);
+
+    // Gradients at uniformly random angles on the unit circle
+    for (int i = 0; i < NOISE_TABLE_SIZE; i++) {
+        double angle = 2.0 * M_PI * qrng_double(ctx);
+        table->grad_x[i] = (float)cos(angle);
+        table->grad_y[i] = (float)sin(angle);
+    }
+    return 0;
+}
+
+// Lattice index wrapped into the table (and into the period, if any)
+static inline int wrap_lattice(int64_t i, int period) {
+    if (period > 0) {
+        int64_t r = i % period;
+        return (int)(r < 0 ? r + period : r);
+    }
+    return (int)(i & (NOISE_TABLE_SIZE - 1));
+}
+
+// Quintic fade 6t^5 - 15t^4 + 10t^3
+static inline float fade(float t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+void noise_row(const noise_table_t *table, double x0, double step, double y,
+               int period, size_t n, float *out) {
+    double y_floor = floor(y);
+    int64_t iy = (int64_t)y_floor;
+    float fy = (float)(y - y_floor);
+    float v = fade(fy);
+    int iy0 = wrap_lattice(iy, period);
+    int iy1 = wrap_lattice(iy + 1, period);
+    const uint8_t *perm = table->perm;
+
+    for (size_t base = 0; base < n; base += NOISE_BLOCK) {
+        size_t m = n - base < NOISE_BLOCK ? n - base : NOISE_BLOCK;
+        float fx[NOISE_BLOCK];
+        float gx00[NOISE_BLOCK], gy00[NOISE_BLOCK], gx10[NOISE_BLOCK], gy10[NOISE_BLOCK];
+        float gx01[NOISE_BLOCK], gy01[NOISE_BLOCK], gx11[NOISE_BLOCK], gy11[NOISE_BLOCK];
+
+        // Lookups: hash the four lattice corners of each point
+        for (size_t i = 0; i < m; i++) {
+            double x = x0 + (double)(base + i) * step;
+            double x_floor = floor(x);
+            int64_t ix = (int64_t)x_floor;
+            fx[i] = (float)(x - x_floor);
+            int hx0 = perm[wrap_lattice(ix, period)];
+            int hx1 = perm[wrap_lattice(ix + 1, period)];
+            int h00 = perm[hx0 + iy0], h10 = perm[hx1 + iy0];
+            int h01 = perm[hx0 + iy1], h11 = perm[hx1 + iy1];
+            gx00[i] = table->grad_x[h00]; gy00[i] = table->grad_y[h00];
+            gx10[i] = table->grad_x[h10]; gy10[i] = table->grad_y[h10];
+            gx01[i] = table->grad_x[h01]; gy01[i] = table->grad_y[h01];
+            gx11[i] = table->grad_x[h11]; gy11[i] = table->grad_y[h11];
+        }
+
+        // Arithmetic: corner dot products, fade and bilinear blend
+        float *o = out + base;
+        for (size_t i = 0; i < m; i++) {
+            float u = fade(fx[i]);
+            float n00 = gx00[i] * fx[i] + gy00[i] * fy;
+            float n10 = gx10[i] * (fx[i] - 1.0f) + gy10[i] * fy;
+            float n01 = gx01[i] * fx[i] + gy01[i] * (fy - 1.0f);
+            float n11 = gx11[i] * (fx[i] - 1.0f) + gy11[i] * (fy - 1.0f);
+            float nx0 = n00 + u * (n10 - n00);
+            float nx1 = n01 + u * (n11 - n01);
+            o[i] = (nx0 + v * (nx1 - nx0)) * NOISE_SCALE;
+        }
+    }
+}
+
+float noise_sample(const noise_table_t *table, double x, double y, int period) {
+    float value;
+    noise_row(table, x, 0.0, y, period, 1, &value);
+    return value;
+}
+
+void noise_fbm_row(const noise_table_t *table, const noise_fbm_t *fbm,
+                   double x0, double y, size_t n, float *out) {
+    float octave[NOISE_BLOCK];
+    int octaves = fbm->octaves < 1 ? 1 :
+                  fbm->octaves > NOISE_MAX_OCTAVES ? NOISE_MAX_OCTAVES : fbm->octaves;
+
+    for (size_t base = 0; base < n; base += NOISE_BLOCK) {
+        size_t m = n - base < NOISE_BLOCK ? n - base : NOISE_BLOCK;
+        float *o = out + base;
+        for (size_t i = 0; i < m; i++) o[i] = 0.0f;
+
+        double frequency = fbm->frequency;
+        int period = fbm->period;
+        float amplitude = 1.0f, norm = 0.0f;
+        for (int k = 0; k < octaves; k++) {
+            noise_row(table, (x0 + (double)base) * frequency, frequency, y * frequency,
+                      period, m, octave);
+            if (fbm->ridged) {
+                for (size_t i = 0; i < m; i++) o[i] += (1.0f - fabsf(octave[i])) * amplitude;
+            } else {
+                for (size_t i = 0; i < m; i++) o[i] += (0.5f + 0.5f * octave[i]) * amplitude;
+            }
+            norm += amplitude;
+            amplitude *= 0.5f;
+            frequency *= 2.0;
+            if (period > 0) period = period * 2 <= NOISE_TABLE_SIZE ? period * 2 : 0;
+        }
+
+        float inv = 1.0f / norm;
+        for (size_t i = 0; i < m; i++) o[i] *= inv;
+    }
+}
+
+float noise_fbm(const noise_table_t *table, const noise_fbm_t *fbm, double x, double y) {
+    float value;
+    noise_fbm_row(table, fbm, x, y, 1, &value);
+    return value;
+}
@@ -0,0 +1,79 @@
+#ifndef TERRAIN_NOISE_H
+#define TERRAIN_NOISE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../../src/quantum_rng/quantum_rng.h"
+
+/**
+ * @file terrain_noise.h
+ * @brief Coherent gradient noise with quantum-drawn tables
+ *
+ * The quantum RNG is consulted once per world: noise_table_init() shuffles
+ * a 256-entry permutation and draws 256 unit gradients from it. After that
+ * the noise is a pure function of (x, y) (Perlin gradient noise over the
+ * table), so any region can be generated in any order, on any thread, and
+ * regenerated identically later.
+ *
+ * Rows are the unit of evaluation: noise_row() samples n points along x in
+ * blocks, first looking up the corner gradients of every point, then doing
+ * the fade/dot/lerp arithmetic in a loop that vectorizes across x.
+ *
+ * Lattice coordinates can wrap with a period of 1..256 cells, which makes
+ * a map seamless at its edges; period 0 wraps only at the table size (256
+ * lattice cells), i.e. effectively unbounded worlds.
+ */
+
+#define NOISE_TABLE_SIZE 256
+#define NOISE_MAX_OCTAVES 16
+
+typedef struct {
+    uint8_t perm[2 * NOISE_TABLE_SIZE];   /**< Permutation, stored twice */
+    float grad_x[NOISE_TABLE_SIZE];       /**< Unit gradient per hash */
+    float grad_y[NOISE_TABLE_SIZE];
+} noise_table_t;
+
+/** Fractal (multi-octave) noise parameters */
+typedef struct {
+    double frequency;   /**< Lattice cells per unit of x and y in the first octave */
+    int octaves;        /**< 1..NOISE_MAX_OCTAVES; each doubles the frequency, halves the amplitude */
+    int period;         /**< First-octave wrap in lattice cells (0 = none); doubles per octave */
+    int ridged;         /**< Use 1 - |noise| per octave (sharp ridges) */
+} noise_fbm_t;
+
+/**
+ * Draw the permutation and gradients from the quantum RNG
+ *
+ * @return 0 on success, non-zero on bad arguments
+ */
+int noise_table_init(noise_table_t *table, qrng_ctx *ctx);
+
+/**
+ * Gradient noise at (x, y), in [-1, 1]
+ *
+ * @param period Lattice wrap, 0..NOISE_TABLE_SIZE (0 = none)
+ */
+float noise_sample(const noise_table_t *table, double x, double y, int period);
+
+/**
+ * Gradient noise at (x0 + i * step, y) for i in [0, n), in [-1, 1]
+ */
+void noise_row(const noise_table_t *table, double x0, double step, double y,
+               int period, size_t n, float *out);
+
+/**
+ * Fractal noise at sample points (x0 + i, y) for i in [0, n), in [0, 1]
+ *
+ * Sample coordinates are scaled by fbm->frequency; octaves are summed with
+ * halving amplitudes and normalized. Plain octaves map [-1, 1] to [0, 1],
+ * ridged octaves are 1 - |noise|.
+ */
+void noise_fbm_row(const noise_table_t *table, const noise_fbm_t *fbm,
+                   double x0, double y, size_t n, float *out);
+
+/**
+ * Fractal noise at one point, in [0, 1] (same value noise_fbm_row gives)
+ */
+float noise_fbm(const noise_table_t *table, const noise_fbm_t *fbm, double x, double y);
+
+#endif /* TERRAIN_NOISE_H */
@@ -0,0 +1,93 @@
+#ifndef KEYED_STREAM_H
+#define KEYED_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../quantum_rng/quantum_rng.h"
+#include "secure_memory.h"
+
+/**
+ * @file keyed_stream.h
+ * @brief Quantum-keyed classical expansion: one xoshiro256** substream per key
+ *
+ * The quantum RNG delivers a few hundred thousand 64-bit words per second,
+ * which caps anything that draws every random number from it. Bulk
+ * consumers (Sobol scrambling, portfolio weights, particle emission, loot
+ * batches) instead take a 256-bit key from the quantum RNG once per batch
+ * and expand it with xoshiro256**.
+ *
+ * Trade-off: each key carries 256 bits of quantum entropy, but the words
+ * expanded from it are a deterministic function of the key. That is fine
+ * for simulation and games, and it makes a batch reproducible from its key
+ * alone. It is not a source of key material; use qrng_bytes() directly for
+ * secrets.
+ *
+ * Stream format, which audit records and replays depend on: the state is
+ * the four key words as given (an all-zero key, a fixed point of
+ * xoshiro256**, becomes s[0] = 1), and each word is the standard
+ * xoshiro256** output. keyed_stream_key() fills the key words with
+ * qrng_bytes() in host byte order.
+ */
+
+typedef struct {
+    uint64_t s[4];
+} keyed_stream_t;
+
+/**
+ * @brief Start a stream from a recorded or derived 256-bit key
+ */
+static inline void keyed_stream_seed(keyed_stream_t *ks, const uint64_t key[4]) {
+    for (int i = 0; i < 4; i++) ks->s[i] = key[i];
+    if ((ks->s[0] | ks->s[1] | ks->s[2] | ks->s[3]) == 0) ks->s[0] = 1;
+}
+
+/**
+ * @brief Start a stream from a fresh key drawn from the quantum RNG
+ *
+ * On failure the stream is left zeroed, not seeded; callers must not use
+ * it.
+ */
+static inline qrng_error keyed_stream_key(keyed_stream_t *ks, qrng_ctx *ctx) {
+    uint64_t key[4];
+    qrng_error err = qrng_bytes(ctx, (uint8_t *)key, sizeof(key));
+    if (err == QRNG_SUCCESS) {
+        keyed_stream_seed(ks, key);
+    } else {
+        secure_memzero(ks, sizeof(*ks));
+    }
+    secure_memzero(key, sizeof(key));
+    return err;
+}
+
+static inline uint64_t keyed_stream_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t keyed_stream_next(keyed_stream_t *ks) {
+    uint64_t *s = ks->s;
+    uint64_t result = keyed_stream_rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = keyed_stream_rotl(s[3], 45);
+    return result;
+}
+
+/**
+ * @brief Uniform double in [0, 1) from the top 53 bits of one word
+ */
+static inline double keyed_stream_double(keyed_stream_t *ks) {
+    return (double)(keyed_stream_next(ks) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * @brief The next n words, in order
+ */
+static inline void keyed_stream_fill(keyed_stream_t *ks, uint64_t *out, size_t n) {
+    for (size_t i = 0; i < n; i++) out[i] = keyed_stream_next(ks);
+}
+
+#endif /* KEYED_STREAM_H */
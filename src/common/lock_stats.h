@@ -0,0 +1,130 @@
+#ifndef LOCK_STATS_H
+#define LOCK_STATS_H
+
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+
+/**
+ * @file lock_stats.h
+ * @brief Optional lock-contention accounting for the library's shared locks
+ *
+ * Compile with -DQRNG_LOCK_STATS (`make LOCK_STATS=1`) to record, per lock,
+ * how often an acquisition had to wait and for how long. Without the flag
+ * the wrappers compile down to the plain pthread calls and the counters
+ * stay zero, so the struct layout (and ABI) is identical in both builds.
+ *
+ * Contention is detected with a trylock first; only contended acquisitions
+ * pay for clock_gettime, so the uncontended fast path stays cheap.
+ */
+
+/**
+ * @brief Per-lock contention statistics
+ */
+typedef struct {
+    uint64_t acquisitions;     /**< Total successful acquisitions */
+    uint64_t contended;        /**< Acquisitions that had to block */
+    uint64_t wait_ns_total;    /**< Total time spent blocked */
+    uint64_t wait_ns_max;      /**< Longest single wait */
+} qrng_lock_stats_t;
+
+/**
+ * @brief 1 if this build records lock statistics
+ */
+#ifdef QRNG_LOCK_STATS
+#define QRNG_LOCK_STATS_ENABLED 1
+#else
+#define QRNG_LOCK_STATS_ENABLED 0
+#endif
+
+#ifdef QRNG_LOCK_STATS
+
+static inline uint64_t lock_stats_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Counters are updated with relaxed atomics: readers of an rwlock hold it
+ * concurrently, so the lock itself does not serialize the updates.
+ */
+static inline void lock_stats_record(qrng_lock_stats_t *stats, uint64_t wait_ns, int contended) {
+    __atomic_fetch_add(&stats->acquisitions, 1, __ATOMIC_RELAXED);
+    if (!contended) return;
+    __atomic_fetch_add(&stats->contended, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->wait_ns_total, wait_ns, __ATOMIC_RELAXED);
+    uint64_t prev = __atomic_load_n(&stats->wait_ns_max, __ATOMIC_RELAXED);
+    while (wait_ns > prev &&
+           !__atomic_compare_exchange_n(&stats->wait_ns_max, &prev, wait_ns, 0,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+static inline int lock_stats_mutex_lock(pthread_mutex_t *mutex, qrng_lock_stats_t *stats) {
+    if (pthread_mutex_trylock(mutex) == 0) {
+        lock_stats_record(stats, 0, 0);
+        return 0;
+    }
+    uint64_t start = lock_stats_now_ns();
+    int rc = pthread_mutex_lock(mutex);
+    if (rc == 0) lock_stats_record(stats, lock_stats_now_ns() - start, 1);
+    return rc;
+}
+
+static inline int lock_stats_rwlock_rdlock(pthread_rwlock_t *lock, qrng_lock_stats_t *stats) {
+    if (pthread_rwlock_tryrdlock(lock) == 0) {
+        lock_stats_record(stats, 0, 0);
+        return 0;
+    }
+    uint64_t start = lock_stats_now_ns();
+    int rc = pthread_rwlock_rdlock(lock);
+    if (rc == 0) lock_stats_record(stats, lock_stats_now_ns() - start, 1);
+    return rc;
+}
+
+static inline int lock_stats_rwlock_wrlock(pthread_rwlock_t *lock, qrng_lock_stats_t *stats) {
+    if (pthread_rwlock_trywrlock(lock) == 0) {
+        lock_stats_record(stats, 0, 0);
+        return 0;
+    }
+    uint64_t start = lock_stats_now_ns();
+    int rc = pthread_rwlock_wrlock(lock);
+    if (rc == 0) lock_stats_record(stats, lock_stats_now_ns() - start, 1);
+    return rc;
+}
+
+/**
+ * @brief Snapshot stats without tearing individual counters
+ */
+static inline void lock_stats_snapshot(const qrng_lock_stats_t *src, qrng_lock_stats_t *dst) {
+    dst->acquisitions = __atomic_load_n(&src->acquisitions, __ATOMIC_RELAXED);
+    dst->contended = __atomic_load_n(&src->contended, __ATOMIC_RELAXED);
+    dst->wait_ns_total = __atomic_load_n(&src->wait_ns_total, __ATOMIC_RELAXED);
+    dst->wait_ns_max = __atomic_load_n(&src->wait_ns_max, __ATOMIC_RELAXED);
+}
+
+#else
+
+static inline int lock_stats_mutex_lock(pthread_mutex_t *mutex, qrng_lock_stats_t *stats) {
+    (void)stats;
+    return pthread_mutex_lock(mutex);
+}
+
+static inline int lock_stats_rwlock_rdlock(pthread_rwlock_t *lock, qrng_lock_stats_t *stats) {
+    (void)stats;
+    return pthread_rwlock_rdlock(lock);
+}
+
+static inline int lock_stats_rwlock_wrlock(pthread_rwlock_t *lock, qrng_lock_stats_t *stats) {
+    (void)stats;
+    return pthread_rwlock_wrlock(lock);
+}
+
+static inline void lock_stats_snapshot(const qrng_lock_stats_t *src, qrng_lock_stats_t *dst) {
+    *dst = *src;
+}
+
+#endif /* QRNG_LOCK_STATS */
+
+#endif /* LOCK_STATS_H */
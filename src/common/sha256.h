@@ -1,18 +1,19 @@
 /**
  * @file sha256.h
- * @brief Self-contained SHA-256 (FIPS 180-4) for the example programs.
+ * @brief Self-contained SHA-256 (FIPS 180-4)
  *
- * This is a straightforward, dependency-free SHA-256 implementation used by
- * the educational crypto examples so that "hash" always means a real
- * cryptographic hash. It is not hardware-accelerated and not side-channel
- * hardened; for production use a vetted library (e.g. libcrypto).
+ * This is a straightforward, dependency-free SHA-256 implementation. The
+ * library uses it for seed file integrity and key derivation (seed_file.c),
+ * and the educational crypto examples use it so that "hash" always means a
+ * real cryptographic hash. It is not hardware-accelerated and not
+ * side-channel hardened.
  *
  * All functions are static so this header can be included from multiple
  * translation units without link conflicts.
  */
 
-#ifndef EXAMPLES_CRYPTO_SHA256_H
-#define EXAMPLES_CRYPTO_SHA256_H
+#ifndef SHA256_H
+#define SHA256_H
 
 #include <stdint.h>
 #include <stddef.h>
@@ -156,4 +157,4 @@ static inline void sha256(const void *data, size_t len, uint8_t digest[SHA256_DI
     sha256_final(&ctx, digest);
 }
 
-#endif /* EXAMPLES_CRYPTO_SHA256_H */
+#endif /* SHA256_H */
@@ -0,0 +1,212 @@
+/**
+ * @file qrngd_client.c
+ * @brief Connection-reusing client for qrngd
+ */
+
+#define _GNU_SOURCE  // struct ucred
+#include "qrngd_client.h"
+#include "../common/secure_memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Requests written per batch before reading their responses
+#define QRNGD_CLIENT_PIPELINE 16
+
+#ifdef MSG_NOSIGNAL
+#define QRNGD_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define QRNGD_SEND_FLAGS 0
+#endif
+
+struct qrngd_client {
+    int fd;
+    char socket_path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+};
+
+/**
+ * @brief The peer must be this user or root; anyone else may have planted the socket
+ */
+static int peer_trusted(int fd) {
+#if defined(SO_PEERCRED)
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0 || len != sizeof(cred)) return 0;
+    uid_t uid = cred.uid;
+#else
+    uid_t uid;
+    gid_t gid;
+    if (getpeereid(fd, &uid, &gid) != 0) return 0;
+#endif
+    return uid == geteuid() || uid == 0;
+}
+
+static qrngd_error_t open_connection(const char *path, int *fd_out) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path, strlen(path) + 1);
+
+    *fd_out = -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return QRNGD_ERROR_SOCKET;
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return QRNGD_ERROR_SOCKET;
+    }
+    if (!peer_trusted(fd)) {
+        close(fd);
+        return QRNGD_ERROR_PERMISSION;
+    }
+    *fd_out = fd;
+    return QRNGD_SUCCESS;
+}
+
+static int send_all(int fd, const void *data, size_t len) {
+    const uint8_t *p = data;
+    while (len > 0) {
+        ssize_t n = send(fd, p, len, QRNGD_SEND_FLAGS);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int recv_all(int fd, void *data, size_t len) {
+    uint8_t *p = data;
+    while (len > 0) {
+        ssize_t n = recv(fd, p, len, 0);
+        if (n == 0) return -1;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+qrngd_error_t qrngd_default_socket_path(char *path, size_t size) {
+    if (!path) return QRNGD_ERROR_NULL_POINTER;
+    const char *runtime_dir = getenv("XDG_RUNTIME_DIR");
+    int n;
+    if (runtime_dir && runtime_dir[0] == '/') {
+        n = snprintf(path, size, "%s/%s", runtime_dir, QRNGD_SOCKET_NAME);
+    } else {
+        n = snprintf(path, size, "%s", QRNGD_DEFAULT_SOCKET);
+    }
+    return n < 0 || (size_t)n >= size ? QRNGD_ERROR_INVALID_PARAM : QRNGD_SUCCESS;
+}
+
+qrngd_error_t qrngd_client_connect(qrngd_client_t **client, const char *socket_path) {
+    if (!client) return QRNGD_ERROR_NULL_POINTER;
+    *client = NULL;
+
+    qrngd_client_t *c = calloc(1, sizeof(*c));
+    if (!c) return QRNGD_ERROR_OUT_OF_MEMORY;
+
+    const char *path = socket_path ? socket_path : getenv("QRNGD_SOCKET");
+    qrngd_error_t err = QRNGD_SUCCESS;
+    if (!path || !*path) {
+        err = qrngd_default_socket_path(c->socket_path, sizeof(c->socket_path));
+    } else if (strlen(path) >= sizeof(c->socket_path)) {
+        err = QRNGD_ERROR_INVALID_PARAM;
+    } else {
+        memcpy(c->socket_path, path, strlen(path) + 1);
+    }
+    if (err == QRNGD_SUCCESS) err = open_connection(c->socket_path, &c->fd);
+    if (err != QRNGD_SUCCESS) {
+        free(c);
+        return err;
+    }
+    *client = c;
+    return QRNGD_SUCCESS;
+}
+
+/**
+ * @brief One pass over the whole buffer on the current connection
+ *
+ * Up to QRNGD_CLIENT_PIPELINE requests go out in one write, then their
+ * responses are read straight into the caller's buffer.
+ */
+static qrngd_error_t transact(qrngd_client_t *client, qrngd_mode_t mode,
+                              uint8_t *buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        qrngd_request_t reqs[QRNGD_CLIENT_PIPELINE];
+        int count = 0;
+        size_t offset = done;
+        while (count < QRNGD_CLIENT_PIPELINE && offset < size) {
+            size_t chunk = size - offset;
+            if (chunk > QRNGD_MAX_REQUEST) chunk = QRNGD_MAX_REQUEST;
+            reqs[count].version = QRNGD_PROTOCOL_VERSION;
+            reqs[count].mode = (uint8_t)mode;
+            reqs[count].reserved = 0;
+            reqs[count].size = (uint32_t)chunk;
+            offset += chunk;
+            count++;
+        }
+        if (send_all(client->fd, reqs, count * sizeof(reqs[0])) != 0) return QRNGD_ERROR_SOCKET;
+
+        qrngd_error_t status = QRNGD_SUCCESS;
+        for (int i = 0; i < count; i++) {
+            qrngd_response_t resp;
+            if (recv_all(client->fd, &resp, sizeof(resp)) != 0) return QRNGD_ERROR_SOCKET;
+            if (resp.status != QRNGD_SUCCESS) {
+                // Keep reading so the connection stays in sync
+                if (resp.size != 0) return QRNGD_ERROR_PROTOCOL;
+                if (status == QRNGD_SUCCESS) status = (qrngd_error_t)resp.status;
+                done += reqs[i].size;
+                continue;
+            }
+            if (resp.size != reqs[i].size) return QRNGD_ERROR_PROTOCOL;
+            if (recv_all(client->fd, buffer + done, resp.size) != 0) return QRNGD_ERROR_SOCKET;
+            done += resp.size;
+        }
+        if (status != QRNGD_SUCCESS) return status;
+    }
+    return QRNGD_SUCCESS;
+}
+
+qrngd_error_t qrngd_client_bytes(qrngd_client_t *client, qrngd_mode_t mode,
+                                 uint8_t *buffer, size_t size) {
+    if (!client || !buffer) return QRNGD_ERROR_NULL_POINTER;
+    if ((int)mode < 0 || mode >= QRNGD_MODE_COUNT) return QRNGD_ERROR_INVALID_PARAM;
+    if (size == 0) return QRNGD_SUCCESS;
+
+    qrngd_error_t err = QRNGD_ERROR_SOCKET;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (client->fd < 0) {
+            err = open_connection(client->socket_path, &client->fd);
+            if (err != QRNGD_SUCCESS) break;
+        }
+        err = transact(client, mode, buffer, size);
+        if (err == QRNGD_SUCCESS) return QRNGD_SUCCESS;
+        if (err != QRNGD_ERROR_SOCKET && err != QRNGD_ERROR_PROTOCOL) break;
+
+        // Connection broken or out of sync: reconnect and retry once
+        close(client->fd);
+        client->fd = -1;
+    }
+    secure_memzero(buffer, size);
+    return err;
+}
+
+void qrngd_client_close(qrngd_client_t *client) {
+    if (!client) return;
+    if (client->fd >= 0) close(client->fd);
+    free(client);
+}
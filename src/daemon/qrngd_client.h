@@ -0,0 +1,63 @@
+#ifndef QRNGD_CLIENT_H
+#define QRNGD_CLIENT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "qrngd_protocol.h"
+
+/**
+ * @file qrngd_client.h
+ * @brief Client library for the qrngd entropy daemon
+ *
+ * A client holds one connection and reuses it for every call. If the daemon
+ * restarted since the last call, the request is retried once on a fresh
+ * connection. Reads larger than QRNGD_MAX_REQUEST are split and pipelined.
+ *
+ * Every connection is checked before use: the process serving the socket
+ * must run as the client's own user or as root, so a socket planted by
+ * another user is never read from.
+ *
+ * A client handle is not thread-safe; give each thread its own.
+ */
+
+typedef struct qrngd_client qrngd_client_t;
+
+/**
+ * @brief Default socket path: $XDG_RUNTIME_DIR/qrngd.sock, else QRNGD_DEFAULT_SOCKET
+ *
+ * Used by the daemon and by clients when no path is given.
+ *
+ * @param path Output buffer
+ * @param size Buffer size
+ * @return QRNGD_SUCCESS, or QRNGD_ERROR_INVALID_PARAM if the path does not fit
+ */
+qrngd_error_t qrngd_default_socket_path(char *path, size_t size);
+
+/**
+ * @brief Connect to a daemon
+ *
+ * @param client Output client handle
+ * @param socket_path Socket path (NULL = $QRNGD_SOCKET, else qrngd_default_socket_path())
+ * @return QRNGD_SUCCESS, QRNGD_ERROR_PERMISSION if the daemon runs as another
+ *         non-root user, or another error code
+ */
+qrngd_error_t qrngd_client_connect(qrngd_client_t **client, const char *socket_path);
+
+/**
+ * @brief Fill buffer with random bytes from the daemon
+ *
+ * @param client Client handle
+ * @param mode Generator to use
+ * @param buffer Output buffer
+ * @param size Number of bytes (any size; split as needed)
+ * @return QRNGD_SUCCESS or error code; on error the buffer is zeroed
+ */
+qrngd_error_t qrngd_client_bytes(qrngd_client_t *client, qrngd_mode_t mode,
+                                 uint8_t *buffer, size_t size);
+
+/**
+ * @brief Close the connection and free the handle
+ */
+void qrngd_client_close(qrngd_client_t *client);
+
+#endif /* QRNGD_CLIENT_H */
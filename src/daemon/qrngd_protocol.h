@@ -0,0 +1,83 @@
+#ifndef QRNGD_PROTOCOL_H
+#define QRNGD_PROTOCOL_H
+
+#include <stdint.h>
+
+/**
+ * @file qrngd_protocol.h
+ * @brief Wire format between qrngd and its clients
+ *
+ * Every request is a fixed 8-byte record and every response is an 8-byte
+ * header followed by `size` payload bytes. Responses come back in request
+ * order, so a client may pipeline several requests on one connection.
+ *
+ * The daemon only listens on a UNIX domain socket, so both ends share the
+ * host byte order and the structs go over the wire as-is.
+ */
+
+#define QRNGD_PROTOCOL_VERSION 1
+
+/**
+ * Default socket locations, resolved by qrngd_default_socket_path():
+ * $XDG_RUNTIME_DIR/QRNGD_SOCKET_NAME for a per-user daemon, else
+ * QRNGD_DEFAULT_SOCKET for a system one. Both directories are writable only
+ * by their owner, so no other user can plant a socket there first.
+ */
+#define QRNGD_SOCKET_NAME "qrngd.sock"
+#define QRNGD_DEFAULT_SOCKET "/run/qrngd/qrngd.sock"
+
+/** Mode of the socket file unless the daemon is configured otherwise */
+#define QRNGD_DEFAULT_SOCKET_MODE 0600
+
+/** Largest payload a single request may ask for; clients split larger reads */
+#define QRNGD_MAX_REQUEST (1024 * 1024)
+
+/**
+ * @brief Generator a request is served from
+ *
+ * The first four values match secure_rng_mode_t.
+ */
+typedef enum {
+    QRNGD_MODE_FAST = 0,       /**< secure_rng FAST */
+    QRNGD_MODE_QUANTUM,        /**< secure_rng QUANTUM */
+    QRNGD_MODE_HYBRID,         /**< FAST below the hybrid threshold, QUANTUM above */
+    QRNGD_MODE_VERIFIED,       /**< secure_rng VERIFIED (Bell-certified) */
+    QRNGD_MODE_QRNG_V3,        /**< qrng_v3 direct output */
+    QRNGD_MODE_COUNT
+} qrngd_mode_t;
+
+/**
+ * @brief One request record
+ */
+typedef struct {
+    uint8_t version;           /**< QRNGD_PROTOCOL_VERSION */
+    uint8_t mode;              /**< qrngd_mode_t */
+    uint16_t reserved;         /**< Must be zero (else QRNGD_ERROR_PROTOCOL) */
+    uint32_t size;             /**< Bytes requested, 1..QRNGD_MAX_REQUEST */
+} qrngd_request_t;
+
+/**
+ * @brief Response header; `size` payload bytes follow when status is 0
+ */
+typedef struct {
+    int32_t status;            /**< QRNGD_SUCCESS or a negative qrngd_error_t */
+    uint32_t size;             /**< Payload bytes that follow */
+} qrngd_response_t;
+
+/**
+ * @brief Daemon and client error codes
+ */
+typedef enum {
+    QRNGD_SUCCESS = 0,                  /**< Operation successful */
+    QRNGD_ERROR_NULL_POINTER = -1,      /**< NULL argument */
+    QRNGD_ERROR_INVALID_PARAM = -2,     /**< Bad size, mode or configuration */
+    QRNGD_ERROR_OUT_OF_MEMORY = -3,     /**< Allocation failed */
+    QRNGD_ERROR_SOCKET = -4,            /**< Socket setup or I/O failed */
+    QRNGD_ERROR_PROTOCOL = -5,          /**< Malformed request or response */
+    QRNGD_ERROR_GENERATION = -6,        /**< Underlying generator failed */
+    QRNGD_ERROR_ADDRESS_IN_USE = -7,    /**< Another daemon owns the socket path or shm ring */
+    QRNGD_ERROR_UNSUPPORTED = -8,       /**< Server needs epoll (Linux) */
+    QRNGD_ERROR_PERMISSION = -9         /**< Peer is neither this user nor root */
+} qrngd_error_t;
+
+#endif /* QRNGD_PROTOCOL_H */
@@ -0,0 +1,810 @@
+/**
+ * @file qrngd_server.c
+ * @brief epoll event loop for the qrngd entropy daemon
+ */
+
+#define _GNU_SOURCE  // accept4
+#include "qrngd_server.h"
+#include "qrngd_client.h"
+#include "shm_ring.h"
+#include <string.h>
+
+// ============================================================================
+// NAMES (all platforms)
+// ============================================================================
+
+static const char *mode_names[QRNGD_MODE_COUNT] = {
+    "fast", "quantum", "hybrid", "verified", "qrng_v3"
+};
+
+int qrngd_mode_from_string(const char *name) {
+    if (!name) return -1;
+    for (int i = 0; i < QRNGD_MODE_COUNT; i++) {
+        if (strcmp(name, mode_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+const char* qrngd_mode_string(qrngd_mode_t mode) {
+    if ((int)mode < 0 || mode >= QRNGD_MODE_COUNT) return "unknown";
+    return mode_names[mode];
+}
+
+const char* qrngd_error_string(qrngd_error_t error) {
+    switch (error) {
+        case QRNGD_SUCCESS: return "Success";
+        case QRNGD_ERROR_NULL_POINTER: return "NULL pointer";
+        case QRNGD_ERROR_INVALID_PARAM: return "Invalid parameter";
+        case QRNGD_ERROR_OUT_OF_MEMORY: return "Out of memory";
+        case QRNGD_ERROR_SOCKET: return "Socket error";
+        case QRNGD_ERROR_PROTOCOL: return "Protocol error";
+        case QRNGD_ERROR_GENERATION: return "Random generation failed";
+        case QRNGD_ERROR_ADDRESS_IN_USE: return "Socket path or shm ring already served by another daemon";
+        case QRNGD_ERROR_UNSUPPORTED: return "Not supported on this platform";
+        case QRNGD_ERROR_PERMISSION: return "Socket served by an untrusted user";
+        default: return "Unknown error";
+    }
+}
+
+void qrngd_get_default_config(qrngd_config_t *config) {
+    if (!config) return;
+    config->socket_path = NULL;
+    config->socket_mode = QRNGD_DEFAULT_SOCKET_MODE;
+    config->buffer_size = 256 * 1024;
+    config->max_clients = 16384;
+    config->max_pending_output = 4 * 1024 * 1024;
+    config->prewarm_modes = 1u << QRNGD_MODE_QUANTUM;
+    config->shm_name = NULL;
+    config->shm_slots = SHM_RING_DEFAULT_SLOT_COUNT;
+    config->shm_mode = QRNGD_MODE_QUANTUM;
+}
+
+#ifdef __linux__
+
+#include "../secure_rng/secure_rng.h"
+#include "../quantum_rng/quantum_rng_v3.h"
+#include "../common/secure_memory.h"
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+
+#define QRNGD_EPOLL_BATCH 256
+#define QRNGD_READ_BUFFER 4096          /* 512 pipelined requests */
+#define QRNGD_OUTPUT_KEEP (64 * 1024)   /* Larger idle output buffers are released */
+#define QRNGD_TOPUP_CHUNK (16 * 1024)   /* Bytes generated per loop pass while a buffer is low,
+                                           or per pass for an unfinished large response */
+#define QRNGD_SHM_POLL_MS 5             /* Ring heartbeat/refill interval while otherwise idle */
+
+// Counters are written by the loop thread only; readers may be elsewhere
+#define STAT_ADD(server, field, n) \
+    __atomic_fetch_add(&(server)->stats.field, (uint64_t)(n), __ATOMIC_RELAXED)
+#define STAT_SUB(server, field, n) \
+    __atomic_fetch_sub(&(server)->stats.field, (uint64_t)(n), __ATOMIC_RELAXED)
+
+/**
+ * @brief One mode's generator and pregenerated bytes
+ *
+ * Bytes in [pos, fill) are unserved; everything before pos has been wiped.
+ */
+typedef struct {
+    secure_rng_ctx_t *srng;
+    qrng_v3_ctx_t *v3;
+    uint8_t *data;
+    size_t pos;
+    size_t fill;
+    int failed;                     /**< Generator could not be created */
+    int topup_paused;               /**< Background top-up failed; wait for the next request */
+} mode_buffer_t;
+
+/**
+ * @brief Per-connection state
+ */
+typedef struct qrngd_conn {
+    int fd;
+    uint32_t events;                /**< Current epoll interest set */
+    struct qrngd_conn *prev;        /**< Open-connection list, for shutdown */
+    struct qrngd_conn *next;
+    uint8_t in[QRNGD_READ_BUFFER];  /**< Received bytes not yet parsed */
+    size_t in_len;
+    uint8_t *out;                   /**< Responses not yet written */
+    size_t out_pos;
+    size_t out_len;
+    size_t out_cap;
+    size_t gen_start;               /**< Header offset of an unfinished large response */
+    size_t gen_done;                /**< Payload bytes generated so far */
+    size_t gen_size;                /**< Payload size; 0 when no response is unfinished */
+    qrngd_mode_t gen_mode;
+    struct qrngd_conn *gen_prev;    /**< Queue of connections with an unfinished response */
+    struct qrngd_conn *gen_next;
+} qrngd_conn_t;
+
+struct qrngd_server {
+    qrngd_config_t config;
+    char socket_path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+    int listen_fd;
+    int socket_bound;               /**< socket_path is ours to unlink */
+    int epoll_fd;
+    int stop_fd;                    /**< eventfd written by qrngd_server_stop */
+    int reserve_fd;                 /**< Spare descriptor, given up to shed a connection at EMFILE */
+    mode_buffer_t buffers[QRNGD_MODE_COUNT];
+    qrngd_conn_t *conns;            /**< Open connections */
+    qrngd_conn_t *gen_head;         /**< Large responses, generated a chunk per loop pass */
+    qrngd_conn_t *gen_tail;
+    size_t hybrid_threshold;
+    shm_ring_t *shm;                /**< Shared ring, when config.shm_name is set */
+    qrngd_stats_t stats;
+};
+
+// Sentinel epoll payloads for the listening socket and the stop eventfd
+static char listen_tag;
+static char stop_tag;
+
+// ============================================================================
+// GENERATORS AND PREGENERATED BUFFERS
+// ============================================================================
+
+/**
+ * @brief HYBRID is resolved per request; the other modes map to themselves
+ */
+static qrngd_mode_t resolve_mode(const qrngd_server_t *server, qrngd_mode_t mode, size_t size) {
+    if (mode != QRNGD_MODE_HYBRID) return mode;
+    return size < server->hybrid_threshold ? QRNGD_MODE_FAST : QRNGD_MODE_QUANTUM;
+}
+
+static int ensure_generator(qrngd_server_t *server, qrngd_mode_t mode) {
+    mode_buffer_t *mb = &server->buffers[mode];
+    if (mb->srng || mb->v3) return 0;
+    if (mb->failed) return -1;
+
+    if (mode == QRNGD_MODE_QRNG_V3) {
+        if (qrng_v3_init(&mb->v3) != QRNG_V3_SUCCESS) mb->v3 = NULL;
+    } else {
+        secure_rng_config_t config;
+        secure_rng_get_default_config(&config);
+        config.mode = (secure_rng_mode_t)mode;
+        if (secure_rng_init_with_config(&mb->srng, &config) != SECURE_RNG_SUCCESS) mb->srng = NULL;
+    }
+    if (!mb->srng && !mb->v3) {
+        mb->failed = 1;
+        return -1;
+    }
+    return 0;
+}
+
+static int generate(mode_buffer_t *mb, uint8_t *out, size_t len) {
+    if (mb->v3) return qrng_v3_bytes(mb->v3, out, len) == QRNG_V3_SUCCESS ? 0 : -1;
+    return secure_rng_bytes(mb->srng, out, len) == SECURE_RNG_SUCCESS ? 0 : -1;
+}
+
+/**
+ * @brief Move unserved bytes to the front and generate up to amount more
+ *
+ * Top-ups are small so that generating never stalls the loop for long;
+ * a 256 KB QUANTUM refill in one go would hold every client for ~150 ms.
+ */
+static int top_up(qrngd_server_t *server, mode_buffer_t *mb, size_t amount) {
+    size_t left = mb->fill - mb->pos;
+    if (mb->pos > 0) memmove(mb->data, mb->data + mb->pos, left);
+    mb->pos = 0;
+    mb->fill = left;
+    if (amount > server->config.buffer_size - left) amount = server->config.buffer_size - left;
+    if (generate(mb, mb->data + left, amount) != 0) return -1;
+    mb->fill += amount;
+    STAT_ADD(server, buffer_refills, 1);
+    return 0;
+}
+
+/**
+ * @brief Copy len fresh bytes for mode into out (at most half the buffer)
+ */
+static int take_bytes(qrngd_server_t *server, qrngd_mode_t mode, uint8_t *out, size_t len) {
+    if (ensure_generator(server, mode) != 0) return -1;
+    mode_buffer_t *mb = &server->buffers[mode];
+    if (!mb->data) {
+        mb->data = malloc(server->config.buffer_size);
+        if (!mb->data) return -1;
+    }
+    size_t avail = mb->fill - mb->pos;
+    if (avail < len) {
+        size_t need = len - avail;
+        if (top_up(server, mb, need > QRNGD_TOPUP_CHUNK ? need : QRNGD_TOPUP_CHUNK) != 0) return -1;
+    }
+    mb->topup_paused = 0;
+
+    memcpy(out, mb->data + mb->pos, len);
+    secure_memzero(mb->data + mb->pos, len);
+    mb->pos += len;
+    return 0;
+}
+
+/**
+ * @brief shm_ring_fill_fn: ring slots come straight from the mode's generator
+ */
+static int shm_fill(void *user_data, uint8_t *buffer, size_t size) {
+    return generate((mode_buffer_t *)user_data, buffer, size);
+}
+
+/**
+ * @brief Publish one chunk into the shared ring
+ *
+ * @return 1 if the ring still has free slots to fill without waiting
+ */
+static int shm_top_up(qrngd_server_t *server) {
+    size_t slots = QRNGD_TOPUP_CHUNK / SHM_RING_DEFAULT_SLOT_SIZE;
+    int published = shm_ring_produce(server->shm, shm_fill,
+                                     &server->buffers[server->config.shm_mode], slots);
+    // Full, stuck on a slow consumer, or fenced: retry on the poll interval
+    return published > 0 && !shm_ring_is_full(server->shm);
+}
+
+/**
+ * @brief A buffer worth topping up while the loop is idle
+ */
+static mode_buffer_t* find_low_buffer(qrngd_server_t *server) {
+    for (int i = 0; i < QRNGD_MODE_COUNT; i++) {
+        mode_buffer_t *mb = &server->buffers[i];
+        if ((mb->srng || mb->v3) && mb->data && !mb->topup_paused &&
+            mb->fill - mb->pos < server->config.buffer_size / 2) {
+            return mb;
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// CONNECTIONS
+// ============================================================================
+
+static void gen_queue_remove(qrngd_server_t *server, qrngd_conn_t *conn) {
+    if (conn->gen_prev) conn->gen_prev->gen_next = conn->gen_next;
+    else server->gen_head = conn->gen_next;
+    if (conn->gen_next) conn->gen_next->gen_prev = conn->gen_prev;
+    else server->gen_tail = conn->gen_prev;
+    conn->gen_prev = conn->gen_next = NULL;
+}
+
+static void gen_queue_append(qrngd_server_t *server, qrngd_conn_t *conn) {
+    conn->gen_prev = server->gen_tail;
+    conn->gen_next = NULL;
+    if (server->gen_tail) server->gen_tail->gen_next = conn;
+    else server->gen_head = conn;
+    server->gen_tail = conn;
+}
+
+static void conn_close(qrngd_server_t *server, qrngd_conn_t *conn) {
+    if (conn->gen_size) gen_queue_remove(server, conn);
+    if (conn->prev) conn->prev->next = conn->next;
+    else server->conns = conn->next;
+    if (conn->next) conn->next->prev = conn->prev;
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+    if (conn->out) {
+        secure_memzero(conn->out, conn->out_cap);
+        free(conn->out);
+    }
+    free(conn);
+    STAT_SUB(server, connections_active, 1);
+}
+
+static uint8_t* reserve_output(qrngd_conn_t *conn, size_t extra) {
+    if (conn->out_len + extra > conn->out_cap) {
+        size_t cap = conn->out_cap ? conn->out_cap : 4096;
+        while (cap < conn->out_len + extra) cap *= 2;
+        uint8_t *grown = malloc(cap);
+        if (!grown) return NULL;
+        if (conn->out) {
+            memcpy(grown, conn->out, conn->out_len);
+            secure_memzero(conn->out, conn->out_cap);
+            free(conn->out);
+        }
+        conn->out = grown;
+        conn->out_cap = cap;
+    }
+    return conn->out + conn->out_len;
+}
+
+/**
+ * @brief Append one response (header + payload) to the output buffer
+ *
+ * Payloads over half the pregenerated buffer would drain it for everyone
+ * else, so they come straight from the generator instead; to keep a 1 MB
+ * QUANTUM read from holding the loop, that happens QRNGD_TOPUP_CHUNK bytes
+ * per loop pass (gen_step). Until it finishes, the connection sends only
+ * the responses before it and parses no further requests.
+ *
+ * @return 0, or -1 if the connection has to be dropped (out of memory)
+ */
+static int serve_request(qrngd_server_t *server, qrngd_conn_t *conn, const qrngd_request_t *req) {
+    qrngd_response_t resp = { QRNGD_SUCCESS, 0 };
+    int valid = req->version == QRNGD_PROTOCOL_VERSION && req->mode < QRNGD_MODE_COUNT &&
+                req->reserved == 0 && req->size > 0 && req->size <= QRNGD_MAX_REQUEST;
+    size_t payload = valid ? req->size : 0;
+
+    uint8_t *slot = reserve_output(conn, sizeof(resp) + payload);
+    if (!slot) return -1;
+
+    if (!valid) {
+        resp.status = QRNGD_ERROR_PROTOCOL;
+    } else {
+        qrngd_mode_t mode = resolve_mode(server, (qrngd_mode_t)req->mode, payload);
+        if (payload > server->config.buffer_size / 2 && ensure_generator(server, mode) == 0) {
+            conn->gen_start = conn->out_len;
+            conn->gen_done = 0;
+            conn->gen_size = payload;
+            conn->gen_mode = mode;
+            conn->out_len += sizeof(resp) + payload;
+            gen_queue_append(server, conn);
+            STAT_ADD(server, direct_generations, 1);
+            return 0;
+        }
+        if (payload > server->config.buffer_size / 2 ||
+            take_bytes(server, mode, slot + sizeof(resp), payload) != 0) {
+            secure_memzero(slot + sizeof(resp), payload);
+            resp.status = QRNGD_ERROR_GENERATION;
+        }
+    }
+
+    if (resp.status == QRNGD_SUCCESS) {
+        resp.size = (uint32_t)payload;
+        STAT_ADD(server, requests_served, 1);
+        STAT_ADD(server, bytes_served, payload);
+    } else {
+        STAT_ADD(server, request_errors, 1);
+    }
+    memcpy(slot, &resp, sizeof(resp));
+    conn->out_len += sizeof(resp) + resp.size;
+    return 0;
+}
+
+static size_t pending_output(const qrngd_conn_t *conn) {
+    return conn->out_len - conn->out_pos;
+}
+
+/**
+ * @brief Output ready to send: everything before an unfinished response
+ */
+static size_t sendable_output(const qrngd_conn_t *conn) {
+    return (conn->gen_size ? conn->gen_start : conn->out_len) - conn->out_pos;
+}
+
+/**
+ * @brief Write as much queued output as the socket takes
+ *
+ * @return 0, or -1 if the peer is gone
+ */
+static int flush_output(qrngd_server_t *server, qrngd_conn_t *conn) {
+    while (sendable_output(conn) > 0) {
+        ssize_t n = send(conn->fd, conn->out + conn->out_pos, sendable_output(conn), MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            return -1;
+        }
+        STAT_ADD(server, write_batches, 1);
+        conn->out_pos += (size_t)n;
+    }
+    if (conn->gen_size) return 0;
+    conn->out_pos = conn->out_len = 0;
+    if (conn->out_cap > QRNGD_OUTPUT_KEEP) {
+        secure_memzero(conn->out, conn->out_cap);
+        free(conn->out);
+        conn->out = NULL;
+        conn->out_cap = 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief Serve every complete request buffered, unless output backs up
+ */
+static int process_requests(qrngd_server_t *server, qrngd_conn_t *conn) {
+    size_t off = 0;
+    while (conn->in_len - off >= sizeof(qrngd_request_t) && !conn->gen_size &&
+           pending_output(conn) < server->config.max_pending_output) {
+        qrngd_request_t req;
+        memcpy(&req, conn->in + off, sizeof(req));
+        off += sizeof(req);
+        if (serve_request(server, conn, &req) != 0) return -1;
+    }
+    if (off > 0) {
+        memmove(conn->in, conn->in + off, conn->in_len - off);
+        conn->in_len -= off;
+    }
+    return flush_output(server, conn);
+}
+
+/**
+ * @brief Read while there is room and output is not backed up; write when pending
+ */
+static int update_interest(qrngd_server_t *server, qrngd_conn_t *conn) {
+    uint32_t events = 0;
+    if (conn->in_len < sizeof(conn->in) &&
+        pending_output(conn) < server->config.max_pending_output) {
+        events |= EPOLLIN;
+    }
+    if (sendable_output(conn) > 0) events |= EPOLLOUT;
+    if (events == conn->events) return 0;
+
+    struct epoll_event ev = { .events = events, .data.ptr = conn };
+    if (epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, conn->fd, &ev) != 0) return -1;
+    conn->events = events;
+    return 0;
+}
+
+static void handle_conn(qrngd_server_t *server, qrngd_conn_t *conn, uint32_t events) {
+    if (events & (EPOLLERR | EPOLLHUP) && !(events & EPOLLIN)) {
+        conn_close(server, conn);
+        return;
+    }
+    if (events & EPOLLOUT) {
+        if (flush_output(server, conn) != 0) {
+            conn_close(server, conn);
+            return;
+        }
+    }
+    if (events & EPOLLIN) {
+        ssize_t n = recv(conn->fd, conn->in + conn->in_len, sizeof(conn->in) - conn->in_len, 0);
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            conn_close(server, conn);
+            return;
+        }
+        if (n > 0) conn->in_len += (size_t)n;
+    }
+    // Output drained or new input: either way there may be requests to serve
+    if (process_requests(server, conn) != 0 || update_interest(server, conn) != 0) {
+        conn_close(server, conn);
+    }
+}
+
+/**
+ * @brief Accept and immediately close one connection while out of descriptors
+ *
+ * Left in the queue, it would keep the level-triggered listen fd readable
+ * and spin the loop; the reserve descriptor makes room to drop it instead.
+ *
+ * @return 0 if a connection was shed, -1 if the queue has to wait
+ */
+static int shed_connection(qrngd_server_t *server) {
+    if (server->reserve_fd < 0) return -1;
+    close(server->reserve_fd);
+    int fd = accept4(server->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+    if (fd >= 0) {
+        close(fd);
+        STAT_ADD(server, connections_rejected, 1);
+    }
+    server->reserve_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    return fd >= 0 ? 0 : -1;
+}
+
+/**
+ * @brief Generate one chunk of the oldest unfinished large response
+ *
+ * Connections take turns; a finished response is sent and the requests
+ * queued behind it are served.
+ */
+static void gen_step(qrngd_server_t *server) {
+    qrngd_conn_t *conn = server->gen_head;
+    gen_queue_remove(server, conn);
+
+    qrngd_response_t resp = { QRNGD_SUCCESS, 0 };
+    uint8_t *payload = conn->out + conn->gen_start + sizeof(resp);
+    size_t chunk = conn->gen_size - conn->gen_done;
+    if (chunk > QRNGD_TOPUP_CHUNK) chunk = QRNGD_TOPUP_CHUNK;
+    if (generate(&server->buffers[conn->gen_mode], payload + conn->gen_done, chunk) != 0) {
+        secure_memzero(payload, conn->gen_size);
+        conn->out_len = conn->gen_start + sizeof(resp);
+        resp.status = QRNGD_ERROR_GENERATION;
+        STAT_ADD(server, request_errors, 1);
+    } else {
+        conn->gen_done += chunk;
+        if (conn->gen_done < conn->gen_size) {
+            gen_queue_append(server, conn);
+            return;
+        }
+        resp.size = (uint32_t)conn->gen_size;
+        STAT_ADD(server, requests_served, 1);
+        STAT_ADD(server, bytes_served, conn->gen_size);
+    }
+    memcpy(conn->out + conn->gen_start, &resp, sizeof(resp));
+    conn->gen_size = 0;
+    if (process_requests(server, conn) != 0 || update_interest(server, conn) != 0) {
+        conn_close(server, conn);
+    }
+}
+
+static void accept_clients(qrngd_server_t *server) {
+    for (;;) {
+        int fd = accept4(server->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if ((errno == EMFILE || errno == ENFILE) && shed_connection(server) == 0) continue;
+            // EAGAIN: drained. ENOMEM and friends: retried on the next wakeup
+            return;
+        }
+        if (server->stats.connections_active >= server->config.max_clients) {
+            close(fd);
+            STAT_ADD(server, connections_rejected, 1);
+            continue;
+        }
+        qrngd_conn_t *conn = calloc(1, sizeof(*conn));
+        if (!conn) {
+            close(fd);
+            continue;
+        }
+        conn->fd = fd;
+        conn->events = EPOLLIN;
+        struct epoll_event ev = { .events = EPOLLIN, .data.ptr = conn };
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            close(fd);
+            free(conn);
+            continue;
+        }
+        conn->next = server->conns;
+        if (server->conns) server->conns->prev = conn;
+        server->conns = conn;
+        STAT_ADD(server, connections_accepted, 1);
+        STAT_ADD(server, connections_active, 1);
+    }
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+/**
+ * @brief Bind path, replacing a stale socket but never a live one
+ *
+ * The mode is applied between bind and listen, while connects are still
+ * refused, so the socket is never reachable with the umask's permissions.
+ */
+static qrngd_error_t bind_socket(qrngd_server_t *server) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, server->socket_path, strlen(server->socket_path) + 1);
+
+    struct stat st;
+    if (lstat(server->socket_path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) return QRNGD_ERROR_ADDRESS_IN_USE;
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (probe < 0) return QRNGD_ERROR_SOCKET;
+        int live = connect(probe, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+        close(probe);
+        if (live) return QRNGD_ERROR_ADDRESS_IN_USE;
+        unlink(server->socket_path);
+    }
+
+    server->listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (server->listen_fd < 0) return QRNGD_ERROR_SOCKET;
+    if (bind(server->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        return errno == EADDRINUSE ? QRNGD_ERROR_ADDRESS_IN_USE : QRNGD_ERROR_SOCKET;
+    }
+    server->socket_bound = 1;
+    if (chmod(server->socket_path, (mode_t)server->config.socket_mode) != 0 ||
+        listen(server->listen_fd, SOMAXCONN) != 0) {
+        return QRNGD_ERROR_SOCKET;
+    }
+    return QRNGD_SUCCESS;
+}
+
+/**
+ * @brief Raise the soft descriptor limit to cover max_clients
+ */
+static void raise_fd_limit(size_t wanted) {
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) != 0 || rl.rlim_cur >= wanted) return;
+    rl.rlim_cur = (rl.rlim_max == RLIM_INFINITY || rl.rlim_max > wanted) ? wanted : rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+}
+
+qrngd_error_t qrngd_server_create(qrngd_server_t **server, const qrngd_config_t *config) {
+    if (!server) return QRNGD_ERROR_NULL_POINTER;
+    *server = NULL;
+
+    qrngd_config_t cfg;
+    if (config) cfg = *config;
+    else qrngd_get_default_config(&cfg);
+
+    char default_path[sizeof(((struct sockaddr_un *)0)->sun_path)];
+    const char *path = cfg.socket_path;
+    if (!path) {
+        if (qrngd_default_socket_path(default_path, sizeof(default_path)) != QRNGD_SUCCESS) {
+            return QRNGD_ERROR_INVALID_PARAM;
+        }
+        path = default_path;
+    }
+    if (cfg.buffer_size < 2 * sizeof(qrngd_request_t) || cfg.max_clients == 0 ||
+        cfg.socket_mode > 0777 ||
+        cfg.max_pending_output == 0 ||
+        (cfg.shm_name && ((int)cfg.shm_mode < 0 || cfg.shm_mode >= QRNGD_MODE_COUNT ||
+                          cfg.shm_mode == QRNGD_MODE_HYBRID))) {
+        return QRNGD_ERROR_INVALID_PARAM;
+    }
+
+    qrngd_server_t *s = calloc(1, sizeof(*s));
+    if (!s) return QRNGD_ERROR_OUT_OF_MEMORY;
+    if (strlen(path) >= sizeof(s->socket_path)) {
+        free(s);
+        return QRNGD_ERROR_INVALID_PARAM;
+    }
+    memcpy(s->socket_path, path, strlen(path) + 1);
+    s->config = cfg;
+    s->config.socket_path = s->socket_path;
+    s->listen_fd = s->epoll_fd = s->stop_fd = -1;
+    s->reserve_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+
+    secure_rng_config_t srng_defaults;
+    secure_rng_get_default_config(&srng_defaults);
+    s->hybrid_threshold = srng_defaults.hybrid_threshold;
+
+    raise_fd_limit(cfg.max_clients + 64);
+
+    qrngd_error_t err = bind_socket(s);
+    if (err == QRNGD_SUCCESS) {
+        s->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        s->stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        struct epoll_event lev = { .events = EPOLLIN, .data.ptr = &listen_tag };
+        struct epoll_event sev = { .events = EPOLLIN, .data.ptr = &stop_tag };
+        if (s->epoll_fd < 0 || s->stop_fd < 0 ||
+            epoll_ctl(s->epoll_fd, EPOLL_CTL_ADD, s->listen_fd, &lev) != 0 ||
+            epoll_ctl(s->epoll_fd, EPOLL_CTL_ADD, s->stop_fd, &sev) != 0) {
+            err = QRNGD_ERROR_SOCKET;
+        }
+    }
+
+    for (int mode = 0; err == QRNGD_SUCCESS && mode < QRNGD_MODE_COUNT; mode++) {
+        if (!(cfg.prewarm_modes & (1u << mode)) || mode == QRNGD_MODE_HYBRID) continue;
+        mode_buffer_t *mb = &s->buffers[mode];
+        if (ensure_generator(s, (qrngd_mode_t)mode) != 0) {
+            err = QRNGD_ERROR_GENERATION;
+            break;
+        }
+        mb->data = malloc(cfg.buffer_size);
+        if (!mb->data) err = QRNGD_ERROR_OUT_OF_MEMORY;
+        else if (top_up(s, mb, cfg.buffer_size) != 0) err = QRNGD_ERROR_GENERATION;
+    }
+
+    if (err == QRNGD_SUCCESS && cfg.shm_name) {
+        shm_ring_config_t ring_cfg;
+        shm_ring_get_default_config(&ring_cfg);
+        ring_cfg.slot_count = cfg.shm_slots;
+        if (ensure_generator(s, cfg.shm_mode) != 0) err = QRNGD_ERROR_GENERATION;
+        else {
+            shm_ring_error_t ring_err = shm_ring_create(&s->shm, cfg.shm_name, &ring_cfg);
+            if (ring_err == SHM_RING_ERROR_IN_USE) err = QRNGD_ERROR_ADDRESS_IN_USE;
+            else if (ring_err != SHM_RING_SUCCESS) err = QRNGD_ERROR_SOCKET;
+        }
+        s->config.shm_name = NULL;  // Caller's string; the ring keeps its own copy
+    }
+
+    if (err != QRNGD_SUCCESS) {
+        qrngd_server_free(s);
+        return err;
+    }
+
+    *server = s;
+    return QRNGD_SUCCESS;
+}
+
+qrngd_error_t qrngd_server_run(qrngd_server_t *server) {
+    if (!server) return QRNGD_ERROR_NULL_POINTER;
+
+    struct epoll_event events[QRNGD_EPOLL_BATCH];
+    for (;;) {
+        // Block only when every buffer is comfortably full and no large
+        // response is unfinished; otherwise add one chunk of each per pass,
+        // between batches of client work
+        mode_buffer_t *low = find_low_buffer(server);
+        if (low && top_up(server, low, QRNGD_TOPUP_CHUNK) != 0) low->topup_paused = 1;
+        low = find_low_buffer(server);
+        int shm_busy = server->shm && shm_top_up(server);
+        if (server->gen_head) gen_step(server);
+        int busy = low || shm_busy || server->gen_head;
+
+        int timeout = busy ? 0 : server->shm ? QRNGD_SHM_POLL_MS : -1;
+        int n = epoll_wait(server->epoll_fd, events, QRNGD_EPOLL_BATCH, timeout);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return QRNGD_ERROR_SOCKET;
+        }
+
+        for (int i = 0; i < n; i++) {
+            void *tag = events[i].data.ptr;
+            if (tag == &stop_tag) {
+                uint64_t value;
+                if (read(server->stop_fd, &value, sizeof(value)) < 0) { /* already drained */ }
+                return QRNGD_SUCCESS;
+            }
+            if (tag == &listen_tag) {
+                accept_clients(server);
+                continue;
+            }
+            handle_conn(server, (qrngd_conn_t *)tag, events[i].events);
+        }
+    }
+}
+
+void qrngd_server_stop(qrngd_server_t *server) {
+    if (!server || server->stop_fd < 0) return;
+    uint64_t one = 1;
+    if (write(server->stop_fd, &one, sizeof(one)) < 0) { /* counter saturated: already stopping */ }
+}
+
+void qrngd_server_get_stats(const qrngd_server_t *server, qrngd_stats_t *stats) {
+    if (!server || !stats) return;
+    const qrngd_stats_t *src = &server->stats;
+    stats->connections_accepted = __atomic_load_n(&src->connections_accepted, __ATOMIC_RELAXED);
+    stats->connections_rejected = __atomic_load_n(&src->connections_rejected, __ATOMIC_RELAXED);
+    stats->connections_active = __atomic_load_n(&src->connections_active, __ATOMIC_RELAXED);
+    stats->requests_served = __atomic_load_n(&src->requests_served, __ATOMIC_RELAXED);
+    stats->bytes_served = __atomic_load_n(&src->bytes_served, __ATOMIC_RELAXED);
+    stats->request_errors = __atomic_load_n(&src->request_errors, __ATOMIC_RELAXED);
+    stats->buffer_refills = __atomic_load_n(&src->buffer_refills, __ATOMIC_RELAXED);
+    stats->direct_generations = __atomic_load_n(&src->direct_generations, __ATOMIC_RELAXED);
+    stats->write_batches = __atomic_load_n(&src->write_batches, __ATOMIC_RELAXED);
+
+    shm_ring_stats_t ring;
+    shm_ring_get_stats(server->shm, &ring);
+    stats->shm_slots_published = ring.published;
+    stats->shm_slots_consumed = ring.consumed;
+    stats->shm_slots_reclaimed = ring.reclaimed;
+    stats->shm_fences = ring.fences;
+}
+
+void qrngd_server_free(qrngd_server_t *server) {
+    if (!server) return;
+
+    while (server->conns) conn_close(server, server->conns);
+    if (server->listen_fd >= 0) close(server->listen_fd);
+    if (server->socket_bound) unlink(server->socket_path);
+    if (server->epoll_fd >= 0) close(server->epoll_fd);
+    if (server->stop_fd >= 0) close(server->stop_fd);
+    if (server->reserve_fd >= 0) close(server->reserve_fd);
+    shm_ring_destroy(server->shm);
+
+    for (int i = 0; i < QRNGD_MODE_COUNT; i++) {
+        mode_buffer_t *mb = &server->buffers[i];
+        if (mb->data) {
+            secure_memzero(mb->data, server->config.buffer_size);
+            free(mb->data);
+        }
+        if (mb->srng) secure_rng_free(mb->srng);
+        if (mb->v3) qrng_v3_free(mb->v3);
+    }
+    free(server);
+}
+
+#else /* !__linux__ */
+
+qrngd_error_t qrngd_server_create(qrngd_server_t **server, const qrngd_config_t *config) {
+    (void)config;
+    if (server) *server = NULL;
+    return QRNGD_ERROR_UNSUPPORTED;
+}
+
+qrngd_error_t qrngd_server_run(qrngd_server_t *server) {
+    (void)server;
+    return QRNGD_ERROR_UNSUPPORTED;
+}
+
+void qrngd_server_stop(qrngd_server_t *server) {
+    (void)server;
+}
+
+void qrngd_server_get_stats(const qrngd_server_t *server, qrngd_stats_t *stats) {
+    (void)server;
+    if (stats) memset(stats, 0, sizeof(*stats));
+}
+
+void qrngd_server_free(qrngd_server_t *server) {
+    (void)server;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,132 @@
+#ifndef QRNGD_SERVER_H
+#define QRNGD_SERVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "qrngd_protocol.h"
+
+/**
+ * @file qrngd_server.h
+ * @brief Entropy daemon core: one epoll loop serving random bytes
+ *
+ * A single process owns one generator per mode, so the entropy pools,
+ * startup tests and Bell certification are paid once per host instead of
+ * once per client process. The loop is single-threaded:
+ * - each mode keeps a pregenerated buffer, topped up 16 KB at a time
+ *   between batches of client work, so small requests are a memcpy and no
+ *   single refill stalls the loop;
+ * - requests for more than half the buffer are generated directly, one
+ *   16 KB chunk per loop pass, so a 1 MB QUANTUM read does not hold up
+ *   other clients either;
+ * - all responses produced by one read are coalesced into one write;
+ * - a connection whose unsent output exceeds max_pending_output stops being
+ *   read until the client catches up.
+ *
+ * Generators are created on the first request for their mode, except those
+ * listed in prewarm_modes. Served bytes are wiped from the buffer.
+ *
+ * With shm_name set, the loop also keeps a shared-memory ring (shm_ring.h)
+ * of shm_mode output topped up for same-host consumers that cannot afford
+ * a socket round trip per read.
+ *
+ * The server needs epoll and is only built on Linux; elsewhere
+ * qrngd_server_create returns QRNGD_ERROR_UNSUPPORTED.
+ */
+
+/**
+ * @brief Server configuration
+ */
+typedef struct {
+    const char *socket_path;        /**< UNIX socket path (NULL = qrngd_default_socket_path()) */
+    unsigned socket_mode;           /**< Socket file permissions (default 0600: this user only) */
+    size_t buffer_size;             /**< Pregenerated bytes per mode (default 256 KB) */
+    size_t max_clients;             /**< Connections beyond this are closed on accept */
+    size_t max_pending_output;      /**< Per-connection unsent bytes before reads pause */
+    unsigned prewarm_modes;         /**< Bit (1 << mode) per generator created at startup */
+    const char *shm_name;           /**< POSIX shm name for the shared ring (NULL = none) */
+    size_t shm_slots;               /**< Ring slots of SHM_RING_DEFAULT_SLOT_SIZE bytes */
+    qrngd_mode_t shm_mode;          /**< Generator feeding the ring (not HYBRID) */
+} qrngd_config_t;
+
+/**
+ * @brief Server counters
+ */
+typedef struct {
+    uint64_t connections_accepted;  /**< Total accepted connections */
+    uint64_t connections_rejected;  /**< Closed at max_clients or when out of descriptors */
+    uint64_t connections_active;    /**< Currently open connections */
+    uint64_t requests_served;       /**< Successful responses */
+    uint64_t bytes_served;          /**< Payload bytes sent */
+    uint64_t request_errors;        /**< Malformed or failed requests */
+    uint64_t buffer_refills;        /**< Pregenerated buffer top-ups */
+    uint64_t direct_generations;    /**< Requests too large for the buffer, generated in chunks */
+    uint64_t write_batches;         /**< write() calls carrying responses */
+    uint64_t shm_slots_published;   /**< Slots written to the shared ring */
+    uint64_t shm_slots_consumed;    /**< Slots taken by ring consumers */
+    uint64_t shm_slots_reclaimed;   /**< Slots recovered from crashed consumers */
+    uint64_t shm_fences;            /**< Ring fences after generation failures */
+} qrngd_stats_t;
+
+typedef struct qrngd_server qrngd_server_t;
+
+/**
+ * @brief Fill a configuration with defaults
+ */
+void qrngd_get_default_config(qrngd_config_t *config);
+
+/**
+ * @brief Bind the socket and create the prewarmed generators
+ *
+ * A stale socket file left by a crashed daemon is replaced; a path another
+ * daemon is still serving on gives QRNGD_ERROR_ADDRESS_IN_USE. The socket
+ * gets socket_mode before it starts listening; the directory holding it must
+ * already exist.
+ *
+ * @param server Output server handle
+ * @param config Configuration (NULL = defaults)
+ * @return QRNGD_SUCCESS or error code
+ */
+qrngd_error_t qrngd_server_create(qrngd_server_t **server, const qrngd_config_t *config);
+
+/**
+ * @brief Run the event loop until qrngd_server_stop is called
+ *
+ * @return QRNGD_SUCCESS, or QRNGD_ERROR_SOCKET if epoll fails
+ */
+qrngd_error_t qrngd_server_run(qrngd_server_t *server);
+
+/**
+ * @brief Ask a running loop to return
+ *
+ * Safe to call from another thread or a signal handler.
+ */
+void qrngd_server_stop(qrngd_server_t *server);
+
+/**
+ * @brief Snapshot the counters (callable while the loop runs)
+ */
+void qrngd_server_get_stats(const qrngd_server_t *server, qrngd_stats_t *stats);
+
+/**
+ * @brief Close all connections, remove the socket file and free the server
+ */
+void qrngd_server_free(qrngd_server_t *server);
+
+/**
+ * @brief Parse a mode name ("fast", "quantum", "hybrid", "verified", "qrng_v3")
+ *
+ * @return The mode, or -1 if the name is unknown
+ */
+int qrngd_mode_from_string(const char *name);
+
+/**
+ * @brief Mode name for display
+ */
+const char* qrngd_mode_string(qrngd_mode_t mode);
+
+/**
+ * @brief Error code description
+ */
+const char* qrngd_error_string(qrngd_error_t error);
+
+#endif /* QRNGD_SERVER_H */
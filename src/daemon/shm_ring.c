@@ -0,0 +1,519 @@
+/**
+ * @file shm_ring.c
+ * @brief Shared-memory MPMC ring of random bytes (see shm_ring.h)
+ */
+
+#include "shm_ring.h"
+#include "../common/secure_memory.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SHM_RING_NAME_MAX 64
+#define SHM_RING_MAX_SLOT_SIZE (1024 * 1024)
+#define SHM_RING_MAX_SLOTS (1u << 20)
+#define SHM_RING_SPINS 64               /* Empty-ring polls before sleeping */
+#define SHM_RING_SLEEP_MIN_NS 20000     /* Backoff sleep: 20 us .. 1 ms */
+#define SHM_RING_SLEEP_MAX_NS 1000000
+
+struct shm_ring {
+    shm_ring_header_t *hdr;
+    uint8_t *slots;                     /**< First slot header */
+    size_t map_size;
+    int producer;
+    char name[SHM_RING_NAME_MAX];
+    int32_t pid;
+
+    // Producer only
+    uint64_t stale_ns;
+    uint64_t stuck_pos;                 /**< Position waiting on an unreleased slot */
+    uint64_t stuck_since_ns;
+    int stuck_valid;
+    int fenced_by_fill;                 /**< The current fence came from a fill failure */
+
+    // Consumer only: unread tail of the last slot taken
+    uint8_t *cache;
+    size_t cache_pos;
+    size_t cache_len;
+};
+
+static const char *error_strings[] = {
+    "Success",
+    "NULL pointer",
+    "Invalid parameter",
+    "Shared memory error",
+    "Incompatible ring",
+    "Ring empty",
+    "Ring fenced after a health-test failure",
+    "Producer gone",
+    "Producer fill failed",
+    "Ring name held by a live producer"
+};
+
+const char* shm_ring_error_string(shm_ring_error_t error) {
+    int idx = -(int)error;
+    if (idx < 0 || idx >= (int)(sizeof(error_strings) / sizeof(error_strings[0]))) {
+        return "Unknown error";
+    }
+    return error_strings[idx];
+}
+
+void shm_ring_get_default_config(shm_ring_config_t *config) {
+    if (!config) return;
+    config->slot_size = SHM_RING_DEFAULT_SLOT_SIZE;
+    config->slot_count = SHM_RING_DEFAULT_SLOT_COUNT;
+    config->stale_ns = SHM_RING_DEFAULT_STALE_NS;
+}
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int pid_alive(int32_t pid) {
+    if (pid <= 0) return 0;
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+static size_t round_up(size_t value, size_t align) {
+    return (value + align - 1) / align * align;
+}
+
+static size_t header_bytes(void) {
+    return round_up(sizeof(shm_ring_header_t), 64);
+}
+
+shm_ring_header_t* shm_ring_header(shm_ring_t *ring) {
+    return ring ? ring->hdr : NULL;
+}
+
+shm_ring_slot_t* shm_ring_slot(shm_ring_t *ring, uint64_t pos) {
+    uint64_t mask = ring->hdr->slot_count - 1;
+    return (shm_ring_slot_t *)(ring->slots + (pos & mask) * ring->hdr->slot_stride);
+}
+
+static uint8_t* slot_data(shm_ring_slot_t *slot) {
+    return (uint8_t *)(slot + 1);
+}
+
+static int valid_name(const char *name) {
+    size_t len = name ? strlen(name) : 0;
+    return len >= 2 && len < SHM_RING_NAME_MAX && name[0] == '/' && !strchr(name + 1, '/');
+}
+
+/**
+ * @brief Whether an existing object is still some running producer's ring
+ *
+ * producer_pid is written before the magic, so a producer that crashed
+ * mid-create is recognised too. An object too short for a header was
+ * never sized by a producer.
+ */
+static int owned_by_live_producer(const char *name) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) return 0;
+    int live = 0;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(shm_ring_header_t)) {
+        shm_ring_header_t *hdr = mmap(NULL, sizeof(*hdr), PROT_READ, MAP_SHARED, fd, 0);
+        if (hdr != MAP_FAILED) {
+            live = !__atomic_load_n(&hdr->closed, __ATOMIC_ACQUIRE) &&
+                   pid_alive(__atomic_load_n(&hdr->producer_pid, __ATOMIC_ACQUIRE));
+            munmap(hdr, sizeof(*hdr));
+        }
+    }
+    close(fd);
+    return live;
+}
+
+// ============================================================================
+// PRODUCER
+// ============================================================================
+
+shm_ring_error_t shm_ring_create(shm_ring_t **ring, const char *name,
+                                 const shm_ring_config_t *config) {
+    if (!ring || !name) return SHM_RING_ERROR_NULL_POINTER;
+    *ring = NULL;
+
+    shm_ring_config_t cfg;
+    if (config) cfg = *config;
+    else shm_ring_get_default_config(&cfg);
+
+    if (!valid_name(name) || cfg.slot_size == 0 || cfg.slot_size > SHM_RING_MAX_SLOT_SIZE ||
+        cfg.slot_count < 2 || cfg.slot_count > SHM_RING_MAX_SLOTS) {
+        return SHM_RING_ERROR_INVALID_PARAM;
+    }
+    size_t count = 2;
+    while (count < cfg.slot_count) count <<= 1;
+    size_t stride = round_up(sizeof(shm_ring_slot_t) + cfg.slot_size, 64);
+    size_t map_size = header_bytes() + stride * count;
+
+    shm_ring_t *r = calloc(1, sizeof(*r));
+    if (!r) return SHM_RING_ERROR_SHM;
+
+    // A leftover object from a crashed producer is replaced, not reused;
+    // a running one's is left alone
+    if (owned_by_live_producer(name)) {
+        free(r);
+        return SHM_RING_ERROR_IN_USE;
+    }
+    shm_unlink(name);
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        free(r);
+        return errno == EEXIST ? SHM_RING_ERROR_IN_USE : SHM_RING_ERROR_SHM;
+    }
+    void *map = MAP_FAILED;
+    if (ftruncate(fd, (off_t)map_size) == 0) {
+        map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) {
+        shm_unlink(name);
+        free(r);
+        return SHM_RING_ERROR_SHM;
+    }
+
+    r->hdr = map;
+    r->slots = (uint8_t *)map + header_bytes();
+    r->map_size = map_size;
+    r->producer = 1;
+    r->pid = (int32_t)getpid();
+    r->stale_ns = cfg.stale_ns;
+    memcpy(r->name, name, strlen(name) + 1);
+
+    shm_ring_header_t *hdr = r->hdr;
+    hdr->version = SHM_RING_VERSION;
+    hdr->slot_size = (uint32_t)cfg.slot_size;
+    hdr->slot_count = count;
+    hdr->slot_stride = stride;
+    hdr->producer_pid = r->pid;
+    hdr->heartbeat_ns = now_ns();
+    for (uint64_t i = 0; i < count; i++) {
+        shm_ring_slot(r, i)->seq = i;
+    }
+    // Attachers check the magic last
+    __atomic_store_n(&hdr->magic, SHM_RING_MAGIC, __ATOMIC_RELEASE);
+
+    *ring = r;
+    return SHM_RING_SUCCESS;
+}
+
+/**
+ * @brief Take back a slot whose consumer died between claim and release
+ *
+ * @return 1 if the slot at pos is now free, 0 to keep waiting
+ */
+static int try_reclaim(shm_ring_t *ring, shm_ring_slot_t *slot, uint64_t pos) {
+    uint64_t prev = pos - ring->hdr->slot_count;
+    uint64_t now = now_ns();
+
+    if (!ring->stuck_valid || ring->stuck_pos != pos) {
+        ring->stuck_valid = 1;
+        ring->stuck_pos = pos;
+        ring->stuck_since_ns = now;
+        return 0;
+    }
+    if (now - ring->stuck_since_ns < ring->stale_ns) return 0;
+
+    // A live consumer is just slow; a missing pid means it died before
+    // recording one (stale_ns has already passed)
+    int32_t claimer = __atomic_load_n(&slot->claimer, __ATOMIC_ACQUIRE);
+    if (claimer != 0 && pid_alive(claimer)) return 0;
+
+    uint64_t expected = prev + 1;
+    if (__atomic_compare_exchange_n(&slot->seq, &expected, pos, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        __atomic_store_n(&slot->claimer, 0, __ATOMIC_RELAXED);
+        secure_memzero(slot_data(slot), ring->hdr->slot_size);
+        __atomic_fetch_add(&ring->hdr->slots_reclaimed, 1, __ATOMIC_RELAXED);
+    }
+    // Either reclaimed, or the consumer released it meanwhile
+    ring->stuck_valid = 0;
+    return 1;
+}
+
+int shm_ring_produce(shm_ring_t *ring, shm_ring_fill_fn fill, void *user_data, size_t max_slots) {
+    if (!ring || !fill) return SHM_RING_ERROR_NULL_POINTER;
+    if (!ring->producer) return SHM_RING_ERROR_INVALID_PARAM;
+
+    shm_ring_header_t *hdr = ring->hdr;
+    uint64_t count = hdr->slot_count;
+    __atomic_store_n(&hdr->heartbeat_ns, now_ns(), __ATOMIC_RELAXED);
+
+    int published = 0;
+    while ((size_t)published < max_slots) {
+        uint64_t pos = hdr->tail;
+        shm_ring_slot_t *slot = shm_ring_slot(ring, pos);
+        uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+        if (seq != pos) {
+            // Previous lap still held: unclaimed means the ring is full,
+            // claimed means a consumer has not released it yet
+            uint64_t head = __atomic_load_n(&hdr->head, __ATOMIC_ACQUIRE);
+            if (seq == pos - count + 1 && head > pos - count && try_reclaim(ring, slot, pos)) {
+                continue;
+            }
+            break;
+        }
+        ring->stuck_valid = 0;
+
+        // Released slots still hold what their consumer read
+        uint8_t *data = slot_data(slot);
+        secure_memzero(data, hdr->slot_size);
+        if (fill(user_data, data, hdr->slot_size) != 0) {
+            secure_memzero(data, hdr->slot_size);
+            if (!__atomic_load_n(&hdr->fenced, __ATOMIC_ACQUIRE)) {
+                shm_ring_fence(ring);
+                ring->fenced_by_fill = 1;
+            }
+            return SHM_RING_ERROR_GENERATION;
+        }
+        __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+        __atomic_store_n(&hdr->tail, pos + 1, __ATOMIC_RELEASE);
+        published++;
+    }
+
+    if (published > 0) {
+        __atomic_fetch_add(&hdr->slots_published, (uint64_t)published, __ATOMIC_RELAXED);
+        if (ring->fenced_by_fill) shm_ring_unfence(ring);
+    }
+    return published;
+}
+
+void shm_ring_fence(shm_ring_t *ring) {
+    if (!ring || !ring->producer) return;
+    shm_ring_header_t *hdr = ring->hdr;
+    uint64_t count = hdr->slot_count;
+
+    __atomic_store_n(&hdr->fenced, 1, __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&hdr->fence_count, 1, __ATOMIC_RELAXED);
+    ring->fenced_by_fill = 0;
+
+    // Drain published slots the way a consumer would, wiping instead of copying
+    for (;;) {
+        uint64_t pos = __atomic_load_n(&hdr->head, __ATOMIC_ACQUIRE);
+        shm_ring_slot_t *slot = shm_ring_slot(ring, pos);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos + 1) break;
+        if (!__atomic_compare_exchange_n(&hdr->head, &pos, pos + 1, 0,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        secure_memzero(slot_data(slot), hdr->slot_size);
+        __atomic_store_n(&slot->seq, pos + count, __ATOMIC_RELEASE);
+        __atomic_fetch_add(&hdr->slots_discarded, 1, __ATOMIC_RELAXED);
+    }
+
+    // Wipe released slots too; consumers never touch a free slot
+    uint64_t tail = hdr->tail;
+    for (uint64_t pos = tail; pos < tail + count; pos++) {
+        shm_ring_slot_t *slot = shm_ring_slot(ring, pos);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) == pos) {
+            secure_memzero(slot_data(slot), hdr->slot_size);
+        }
+    }
+}
+
+void shm_ring_unfence(shm_ring_t *ring) {
+    if (!ring || !ring->producer) return;
+    ring->fenced_by_fill = 0;
+    __atomic_store_n(&ring->hdr->fenced, 0, __ATOMIC_RELEASE);
+}
+
+int shm_ring_is_full(const shm_ring_t *ring) {
+    if (!ring) return 0;
+    uint64_t head = __atomic_load_n(&ring->hdr->head, __ATOMIC_ACQUIRE);
+    uint64_t tail = __atomic_load_n(&ring->hdr->tail, __ATOMIC_ACQUIRE);
+    return tail - head >= ring->hdr->slot_count;
+}
+
+void shm_ring_destroy(shm_ring_t *ring) {
+    if (!ring) return;
+    if (ring->producer) {
+        // Consumers still mapped see closed before the drain wipes the slots
+        __atomic_store_n(&ring->hdr->closed, 1, __ATOMIC_SEQ_CST);
+        shm_ring_fence(ring);
+        shm_unlink(ring->name);
+    }
+    munmap(ring->hdr, ring->map_size);
+    if (ring->cache) {
+        secure_memzero(ring->cache, ring->cache_len);
+        free(ring->cache);
+    }
+    free(ring);
+}
+
+// ============================================================================
+// CONSUMER
+// ============================================================================
+
+shm_ring_error_t shm_ring_attach(shm_ring_t **ring, const char *name) {
+    if (!ring || !name) return SHM_RING_ERROR_NULL_POINTER;
+    *ring = NULL;
+    if (!valid_name(name)) return SHM_RING_ERROR_INVALID_PARAM;
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) return SHM_RING_ERROR_SHM;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < header_bytes()) {
+        close(fd);
+        return SHM_RING_ERROR_INCOMPATIBLE;
+    }
+    size_t map_size = (size_t)st.st_size;
+    void *map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return SHM_RING_ERROR_SHM;
+
+    shm_ring_header_t *hdr = map;
+    uint64_t count = hdr->slot_count;
+    if (__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) != SHM_RING_MAGIC ||
+        hdr->version != SHM_RING_VERSION || hdr->slot_size == 0 ||
+        count < 2 || (count & (count - 1)) != 0 ||
+        hdr->slot_stride < sizeof(shm_ring_slot_t) + hdr->slot_size ||
+        header_bytes() + hdr->slot_stride * count > map_size) {
+        munmap(map, map_size);
+        return SHM_RING_ERROR_INCOMPATIBLE;
+    }
+
+    shm_ring_t *r = calloc(1, sizeof(*r));
+    uint8_t *cache = malloc(hdr->slot_size);
+    if (!r || !cache) {
+        free(r);
+        free(cache);
+        munmap(map, map_size);
+        return SHM_RING_ERROR_SHM;
+    }
+    r->hdr = hdr;
+    r->slots = (uint8_t *)map + header_bytes();
+    r->map_size = map_size;
+    r->pid = (int32_t)getpid();
+    r->cache = cache;
+    memcpy(r->name, name, strlen(name) + 1);
+
+    *ring = r;
+    return SHM_RING_SUCCESS;
+}
+
+/**
+ * @brief Claim one published slot and copy it into the private cache
+ */
+static shm_ring_error_t take_slot(shm_ring_t *ring) {
+    shm_ring_header_t *hdr = ring->hdr;
+    uint64_t count = hdr->slot_count;
+
+    for (;;) {
+        if (__atomic_load_n(&hdr->closed, __ATOMIC_ACQUIRE)) return SHM_RING_ERROR_NO_PRODUCER;
+        if (__atomic_load_n(&hdr->fenced, __ATOMIC_ACQUIRE)) return SHM_RING_ERROR_FENCED;
+
+        uint64_t pos = __atomic_load_n(&hdr->head, __ATOMIC_ACQUIRE);
+        shm_ring_slot_t *slot = shm_ring_slot(ring, pos);
+        uint64_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(seq - (pos + 1));
+
+        if (diff < 0) return SHM_RING_ERROR_EMPTY;
+        if (diff > 0) continue;         // Another consumer moved head; reload
+        if (!__atomic_compare_exchange_n(&hdr->head, &pos, pos + 1, 0,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+
+        __atomic_store_n(&slot->claimer, ring->pid, __ATOMIC_RELEASE);
+        memcpy(ring->cache, slot_data(slot), hdr->slot_size);
+        __atomic_store_n(&slot->claimer, 0, __ATOMIC_RELAXED);
+
+        uint64_t expected = pos + 1;
+        if (__atomic_compare_exchange_n(&slot->seq, &expected, pos + count, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            __atomic_fetch_add(&hdr->slots_consumed, 1, __ATOMIC_RELAXED);
+            ring->cache_pos = 0;
+            ring->cache_len = hdr->slot_size;
+            return SHM_RING_SUCCESS;
+        }
+        // The producer reclaimed the slot while we copied: the copy may be
+        // torn or handed to someone else, so drop it
+        secure_memzero(ring->cache, hdr->slot_size);
+        __atomic_fetch_add(&hdr->slots_discarded, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static int producer_gone(const shm_ring_header_t *hdr) {
+    return __atomic_load_n(&hdr->closed, __ATOMIC_ACQUIRE) ||
+           !pid_alive(__atomic_load_n(&hdr->producer_pid, __ATOMIC_RELAXED));
+}
+
+shm_ring_error_t shm_ring_read(shm_ring_t *ring, uint8_t *buffer, size_t size, int timeout_ms) {
+    if (!ring || !buffer) return SHM_RING_ERROR_NULL_POINTER;
+    if (ring->producer) return SHM_RING_ERROR_INVALID_PARAM;
+
+    size_t done = 0;
+    int spins = 0;
+    uint64_t sleep_ns = SHM_RING_SLEEP_MIN_NS;
+    uint64_t deadline = 0;
+    shm_ring_error_t err = SHM_RING_SUCCESS;
+
+    while (done < size) {
+        size_t cached = ring->cache_len - ring->cache_pos;
+        if (cached > 0) {
+            size_t n = size - done < cached ? size - done : cached;
+            memcpy(buffer + done, ring->cache + ring->cache_pos, n);
+            secure_memzero(ring->cache + ring->cache_pos, n);
+            ring->cache_pos += n;
+            done += n;
+            continue;
+        }
+
+        err = take_slot(ring);
+        if (err == SHM_RING_SUCCESS) continue;
+        if (err != SHM_RING_ERROR_EMPTY) break;
+
+        // Empty: spin a little, then back off; the syscalls only happen here
+        if (spins++ < SHM_RING_SPINS) continue;
+        if (producer_gone(ring->hdr)) {
+            err = SHM_RING_ERROR_NO_PRODUCER;
+            break;
+        }
+        uint64_t now = now_ns();
+        if (deadline == 0) deadline = now + (uint64_t)(timeout_ms > 0 ? timeout_ms : 0) * 1000000ULL;
+        if (now >= deadline) break;
+
+        struct timespec ts = { 0, (long)sleep_ns };
+        nanosleep(&ts, NULL);
+        if (sleep_ns < SHM_RING_SLEEP_MAX_NS) sleep_ns *= 2;
+        err = SHM_RING_SUCCESS;
+    }
+
+    if (done < size) {
+        secure_memzero(buffer, size);
+        return err != SHM_RING_SUCCESS ? err : SHM_RING_ERROR_EMPTY;
+    }
+    return SHM_RING_SUCCESS;
+}
+
+void shm_ring_detach(shm_ring_t *ring) {
+    shm_ring_destroy(ring);
+}
+
+void shm_ring_get_stats(const shm_ring_t *ring, shm_ring_stats_t *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!ring) return;
+    const shm_ring_header_t *hdr = ring->hdr;
+    stats->published = __atomic_load_n(&hdr->slots_published, __ATOMIC_RELAXED);
+    stats->consumed = __atomic_load_n(&hdr->slots_consumed, __ATOMIC_RELAXED);
+    stats->reclaimed = __atomic_load_n(&hdr->slots_reclaimed, __ATOMIC_RELAXED);
+    stats->discarded = __atomic_load_n(&hdr->slots_discarded, __ATOMIC_RELAXED);
+    stats->fences = __atomic_load_n(&hdr->fence_count, __ATOMIC_RELAXED);
+    uint64_t head = __atomic_load_n(&hdr->head, __ATOMIC_ACQUIRE);
+    uint64_t tail = __atomic_load_n(&hdr->tail, __ATOMIC_ACQUIRE);
+    stats->available = tail > head ? tail - head : 0;
+}
@@ -0,0 +1,224 @@
+#ifndef SHM_RING_H
+#define SHM_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file shm_ring.h
+ * @brief Shared-memory ring of verified random bytes for same-host consumers
+ *
+ * A producer (qrngd --shm) publishes fixed-size slots of health-tested
+ * output into a POSIX shared-memory object. Consumers in any process map
+ * it and take slots with a few atomic operations, so reads do not cost a
+ * syscall or a socket round trip.
+ *
+ * Protocol (bounded MPMC, after Vyukov): slot i carries a sequence word.
+ * For ring position p (slot p % slot_count):
+ * - seq == p:                 free; the producer may write it
+ * - seq == p + 1:             published; a consumer claims it by CAS on head
+ * - seq == p + slot_count:    released; free for the producer's next lap
+ *
+ * A consumer claims by advancing head, records its pid, copies the slot
+ * and releases it by CAS on seq. If the release CAS fails, the producer has
+ * reclaimed the slot in the meantime; the copy is wiped and the consumer
+ * takes another slot, so no byte is ever handed out twice.
+ *
+ * Producer duties:
+ * - wipe every released slot before refilling it;
+ * - shm_ring_fence() on a health-test failure: consumers get
+ *   SHM_RING_ERROR_FENCED and all published slots are drained and wiped;
+ * - reclaim slots left claimed by a consumer that died (its pid no longer
+ *   exists) or that never recorded a pid, after stale_ns;
+ * - refresh heartbeat_ns; consumers report SHM_RING_ERROR_NO_PRODUCER once
+ *   the ring is empty and the producer is gone.
+ *
+ * The layout below is the shared-memory format and is versioned by
+ * SHM_RING_VERSION.
+ */
+
+#define SHM_RING_MAGIC 0x51524E4753484D31ULL   /* "QRNGSHM1" */
+#define SHM_RING_VERSION 1
+
+#define SHM_RING_DEFAULT_SLOT_SIZE 1024
+#define SHM_RING_DEFAULT_SLOT_COUNT 1024
+#define SHM_RING_DEFAULT_STALE_NS 100000000ULL   /* 100 ms */
+
+/**
+ * @brief Ring error codes
+ */
+typedef enum {
+    SHM_RING_SUCCESS = 0,               /**< Operation successful */
+    SHM_RING_ERROR_NULL_POINTER = -1,   /**< NULL argument */
+    SHM_RING_ERROR_INVALID_PARAM = -2,  /**< Bad name or geometry */
+    SHM_RING_ERROR_SHM = -3,            /**< shm_open / mmap failed */
+    SHM_RING_ERROR_INCOMPATIBLE = -4,   /**< Object is not a ring of this version */
+    SHM_RING_ERROR_EMPTY = -5,          /**< No bytes within the timeout */
+    SHM_RING_ERROR_FENCED = -6,         /**< Producer saw a health-test failure */
+    SHM_RING_ERROR_NO_PRODUCER = -7,    /**< Ring drained and producer gone */
+    SHM_RING_ERROR_GENERATION = -8,     /**< Producer's fill callback failed */
+    SHM_RING_ERROR_IN_USE = -9          /**< Name held by a live producer */
+} shm_ring_error_t;
+
+/**
+ * @brief Shared header (first page of the object)
+ *
+ * head and tail sit on their own cache lines: consumers contend on head,
+ * the producer alone writes tail.
+ */
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t slot_size;                 /**< Payload bytes per slot */
+    uint64_t slot_count;                /**< Power of two */
+    uint64_t slot_stride;               /**< Bytes between slot headers */
+    int32_t producer_pid;
+    uint32_t fenced;                    /**< 1 while output is withheld */
+    uint32_t closed;                    /**< 1 once the producer shut down */
+    uint32_t reserved;
+    uint64_t heartbeat_ns;              /**< CLOCK_MONOTONIC of the producer's last pass */
+
+    // Counters (relaxed atomics)
+    uint64_t slots_published;
+    uint64_t slots_consumed;
+    uint64_t slots_reclaimed;           /**< Taken back from dead consumers */
+    uint64_t slots_discarded;           /**< Consumer copies dropped after a reclaim or fence */
+    uint64_t fence_count;
+
+    uint64_t head __attribute__((aligned(64)));   /**< Next position consumers claim */
+    uint64_t tail __attribute__((aligned(64)));   /**< Next position the producer writes */
+} shm_ring_header_t;
+
+/**
+ * @brief Per-slot header; slot_size payload bytes follow
+ */
+typedef struct {
+    uint64_t seq;                       /**< See the protocol above */
+    int32_t claimer;                    /**< pid of the consumer holding the slot, or 0 */
+    uint32_t reserved;
+} shm_ring_slot_t;
+
+/**
+ * @brief Producer geometry
+ */
+typedef struct {
+    size_t slot_size;                   /**< Payload bytes per slot */
+    size_t slot_count;                  /**< Rounded up to a power of two (>= 2) */
+    uint64_t stale_ns;                  /**< Grace before reclaiming a stuck slot */
+} shm_ring_config_t;
+
+/**
+ * @brief Counter snapshot
+ */
+typedef struct {
+    uint64_t published;
+    uint64_t consumed;
+    uint64_t reclaimed;
+    uint64_t discarded;
+    uint64_t fences;
+    uint64_t available;                 /**< Published, unclaimed slots now */
+} shm_ring_stats_t;
+
+typedef struct shm_ring shm_ring_t;
+
+/**
+ * @brief Producer's source of bytes; returns 0 on success
+ */
+typedef int (*shm_ring_fill_fn)(void *user_data, uint8_t *buffer, size_t size);
+
+void shm_ring_get_default_config(shm_ring_config_t *config);
+
+// ============================================================================
+// PRODUCER
+// ============================================================================
+
+/**
+ * @brief Create the shared object and map it
+ *
+ * An object left by a producer that has exited is replaced; one whose
+ * producer_pid is still running gives SHM_RING_ERROR_IN_USE.
+ *
+ * @param ring Output handle
+ * @param name POSIX shm name, e.g. "/qrngd"
+ * @param config Geometry (NULL = defaults)
+ */
+shm_ring_error_t shm_ring_create(shm_ring_t **ring, const char *name,
+                                 const shm_ring_config_t *config);
+
+/**
+ * @brief Fill up to max_slots free slots and refresh the heartbeat
+ *
+ * Also reclaims slots held by dead consumers. Stops early when the ring is
+ * full. A fill failure fences the ring; the next successful fill lifts the
+ * fence.
+ *
+ * @return Slots published (>= 0) or a negative shm_ring_error_t
+ */
+int shm_ring_produce(shm_ring_t *ring, shm_ring_fill_fn fill, void *user_data, size_t max_slots);
+
+/**
+ * @brief Withhold output: consumers get FENCED; published slots are wiped
+ */
+void shm_ring_fence(shm_ring_t *ring);
+
+/**
+ * @brief Resume output after a fence
+ */
+void shm_ring_unfence(shm_ring_t *ring);
+
+/**
+ * @brief 1 if every slot is published and unclaimed
+ */
+int shm_ring_is_full(const shm_ring_t *ring);
+
+/**
+ * @brief Mark closed, wipe, unlink and unmap (producer)
+ */
+void shm_ring_destroy(shm_ring_t *ring);
+
+// ============================================================================
+// CONSUMER
+// ============================================================================
+
+/**
+ * @brief Map an existing ring
+ *
+ * A handle keeps the unread tail of its last slot privately, so small
+ * reads do not waste slots. Handles are not thread-safe; use one per thread.
+ */
+shm_ring_error_t shm_ring_attach(shm_ring_t **ring, const char *name);
+
+/**
+ * @brief Read size random bytes
+ *
+ * Spins briefly, then sleeps with backoff while the ring is empty.
+ *
+ * @param timeout_ms How long to wait for the producer (0 = do not wait)
+ * @return SHM_RING_SUCCESS, EMPTY, FENCED or NO_PRODUCER; on error the
+ *         buffer is zeroed
+ */
+shm_ring_error_t shm_ring_read(shm_ring_t *ring, uint8_t *buffer, size_t size, int timeout_ms);
+
+/**
+ * @brief Wipe the private cache and unmap (consumer)
+ */
+void shm_ring_detach(shm_ring_t *ring);
+
+/**
+ * @brief Counter snapshot (either role)
+ */
+void shm_ring_get_stats(const shm_ring_t *ring, shm_ring_stats_t *stats);
+
+/**
+ * @brief Shared header, for tools and tests
+ */
+shm_ring_header_t* shm_ring_header(shm_ring_t *ring);
+
+/**
+ * @brief Slot at ring position pos (header + payload), for tools and tests
+ */
+shm_ring_slot_t* shm_ring_slot(shm_ring_t *ring, uint64_t pos);
+
+const char* shm_ring_error_string(shm_ring_error_t error);
+
+#endif /* SHM_RING_H */
@@ -1,110 +1,257 @@
 #include "entropy_pool.h"
+#include "seed_file.h"
 #include "../common/secure_memory.h"
 #include "../common/validation.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <time.h>
 
 /**
  * @file entropy_pool.c
  * @brief High-performance entropy pool with background pre-generation
  * 
- * Implements a thread-safe entropy pool that continuously generates and
- * tests entropy in the background, providing near-zero latency for requests.
+ * Implements a thread-safe entropy pool that generates and tests entropy in
+ * background refill tasks on the shared task pool, providing near-zero
+ * latency for requests.
  */
 
+// Small misses generate this much and keep the surplus, so a cold or drained
+// pool does not pay the per-call source and health-test cost per request
+#define ENTROPY_POOL_MISS_BATCH 1024
+
+// Fresh tested entropy mixed with the seed file at init. The seed is never
+// trusted alone, but a full prefill is not needed either.
+#define ENTROPY_POOL_SEED_FRESH_SIZE 256
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
 // ============================================================================
-// BACKGROUND WORKER THREAD
+// POOL STORAGE
 // ============================================================================
 
 /**
- * @brief Background thread function for continuous entropy generation
+ * @brief Append tested entropy to the ring (caller holds pool_mutex)
+ *
+ * @return Bytes added (less than len when the pool is nearly full)
  */
-static void* entropy_worker_thread(void *arg) {
-    entropy_pool_ctx_t *pool = (entropy_pool_ctx_t *)arg;
-    
-    uint8_t chunk[ENTROPY_POOL_CHUNK_SIZE];
-    
-    while (1) {
-        // Check for shutdown signal
-        pthread_mutex_lock(&pool->pool_mutex);
-        if (pool->shutdown_requested) {
-            pthread_mutex_unlock(&pool->pool_mutex);
-            break;
-        }
-        
-        // Wait if pool is full
-        while (pool->pool_available >= pool->config.refill_threshold && 
-               !pool->shutdown_requested) {
-            pthread_cond_wait(&pool->refill_cond, &pool->pool_mutex);
-        }
-        
-        if (pool->shutdown_requested) {
-            pthread_mutex_unlock(&pool->pool_mutex);
-            break;
+static size_t pool_append_locked(entropy_pool_ctx_t *pool, const uint8_t *data, size_t len) {
+    // Calculate space available
+    size_t space_available = pool->pool_size - pool->pool_available;
+    size_t bytes_to_add = (len < space_available) ? len : space_available;
+    
+    if (bytes_to_add > 0) {
+        // Calculate write position with wraparound
+        size_t write_pos = pool->pool_used + pool->pool_available;
+        if (write_pos >= pool->pool_size) {
+            write_pos -= pool->pool_size;
         }
         
-        pthread_mutex_unlock(&pool->pool_mutex);
-        
-        // Generate entropy outside lock for better concurrency
-        entropy_error_t err = entropy_get_bytes(pool->entropy_ctx, chunk, sizeof(chunk));
-        if (err != ENTROPY_SUCCESS) {
-            usleep(1000);  // Back off on error
-            continue;
+        // Handle wraparound
+        if (write_pos + bytes_to_add <= pool->pool_size) {
+            memcpy(pool->pool_buffer + write_pos, data, bytes_to_add);
+        } else {
+            // Split copy
+            size_t first_part = pool->pool_size - write_pos;
+            memcpy(pool->pool_buffer + write_pos, data, first_part);
+            memcpy(pool->pool_buffer, data + first_part, bytes_to_add - first_part);
         }
         
+        pool->pool_available += bytes_to_add;
+    }
+    
+    return bytes_to_add;
+}
+
+/**
+ * @brief Move up to len bytes out of the ring (caller holds pool_mutex)
+ *
+ * @return Bytes copied (less than len when the pool holds less)
+ */
+static size_t pool_take_locked(entropy_pool_ctx_t *pool, uint8_t *out, size_t len) {
+    size_t bytes_to_take = (len < pool->pool_available) ? len : pool->pool_available;
+    if (bytes_to_take == 0) return 0;
+    
+    size_t read_pos = pool->pool_used;
+    if (read_pos + bytes_to_take <= pool->pool_size) {
+        memcpy(out, pool->pool_buffer + read_pos, bytes_to_take);
+    } else {
+        // Wraparound copy
+        size_t first_part = pool->pool_size - read_pos;
+        memcpy(out, pool->pool_buffer + read_pos, first_part);
+        memcpy(out + first_part, pool->pool_buffer, bytes_to_take - first_part);
+    }
+    
+    pool->pool_used += bytes_to_take;
+    if (pool->pool_used >= pool->pool_size) {
+        pool->pool_used -= pool->pool_size;
+    }
+    pool->pool_available -= bytes_to_take;
+    
+    return bytes_to_take;
+}
+
+// ============================================================================
+// SEED FILE
+// ============================================================================
+
+static int seed_save_due(const entropy_pool_ctx_t *pool) {
+    if (!pool->seed_path) return 0;
+    if (pool->seed_saved_ns == 0) return 1;
+    
+    uint64_t interval_s = pool->config.seed_save_interval_s ?
+        pool->config.seed_save_interval_s : SEED_FILE_DEFAULT_SAVE_INTERVAL_S;
+    return now_ns() - pool->seed_saved_ns >= interval_s * 1000000000ULL;
+}
+
+/**
+ * @brief Write seed (tested entropy not handed out elsewhere) to the seed file
+ */
+static void save_seed(entropy_pool_ctx_t *pool, const uint8_t seed[SEED_FILE_SEED_SIZE]) {
+    // Stamp even on failure so a read-only directory is not retried per chunk
+    pool->seed_saved_ns = now_ns();
+    if (seed_file_write(pool->seed_path, seed) != SEED_FILE_SUCCESS) return;
+    
+    lock_stats_mutex_lock(&pool->pool_mutex, &pool->pool_lock_stats);
+    pool->stats.seed_file_saves++;
+    pthread_mutex_unlock(&pool->pool_mutex);
+}
+
+/**
+ * @brief Generate len bytes and run them through the health tests
+ */
+static int generate_tested(entropy_pool_ctx_t *ctx, uint8_t *buf, size_t len) {
+    if (entropy_get_bytes(ctx->entropy_ctx, buf, len) != ENTROPY_SUCCESS) {
+        return -1;
+    }
+    
+    lock_stats_mutex_lock(&ctx->health_mutex, &ctx->health_lock_stats);
+    health_error_t health_err = health_tests_run_batch(ctx->health_ctx, buf, len);
+    pthread_mutex_unlock(&ctx->health_mutex);
+    if (health_err != HEALTH_SUCCESS) {
+        secure_memzero(buf, len);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Fill the whole pool from the seed file mixed with fresh entropy
+ *
+ * seed_file_consume() replaces the file before releasing the key, so the
+ * same seed never fills two pools.
+ *
+ * @return 0 when the pool was filled, -1 to fall back to the normal prefill
+ */
+static int prefill_from_seed(entropy_pool_ctx_t *ctx) {
+    uint8_t fresh[ENTROPY_POOL_SEED_FRESH_SIZE];
+    uint8_t key[SEED_FILE_KEY_SIZE];
+    
+    if (generate_tested(ctx, fresh, sizeof(fresh)) != 0) return -1;
+    
+    seed_file_error_t err = seed_file_consume(ctx->seed_path, fresh, sizeof(fresh), key);
+    secure_memzero(fresh, sizeof(fresh));
+    if (err != SEED_FILE_SUCCESS) return -1;
+    
+    seed_file_expand(key, ctx->pool_buffer, ctx->pool_size);
+    secure_memzero(key, sizeof(key));
+    
+    ctx->pool_used = 0;
+    ctx->pool_available = ctx->pool_size;
+    ctx->stats.seed_file_loaded = 1;
+    ctx->stats.seed_file_saves++;
+    ctx->seed_saved_ns = now_ns();
+    return 0;
+}
+
+// ============================================================================
+// BACKGROUND REFILL
+// ============================================================================
+
+static void entropy_refill_task(void *arg);
+
+/**
+ * @brief Queue a refill task if the pool is below threshold (caller holds pool_mutex)
+ */
+static void schedule_refill_locked(entropy_pool_ctx_t *pool) {
+    if (!pool->background_running || pool->shutdown_requested || pool->refill_scheduled) return;
+    if (pool->pool_available >= pool->config.refill_threshold) return;
+    
+    task_pool_t *tasks = task_pool_default();
+    if (!tasks) return;  // Miss path still serves every request
+    pool->refill_scheduled = 1;
+    pool->refill_pool = tasks;
+    if (task_pool_submit(tasks, &pool->refill_group, entropy_refill_task, pool) != TASK_POOL_SUCCESS) {
+        pool->refill_scheduled = 0;
+    }
+}
+
+/**
+ * @brief Generate and test one chunk into the pool (runs on the task pool)
+ *
+ * Resubmits itself while the pool is below threshold, so a long refill
+ * hands the worker back between chunks instead of occupying it.
+ */
+static void entropy_refill_task(void *arg) {
+    entropy_pool_ctx_t *pool = (entropy_pool_ctx_t *)arg;
+    uint8_t chunk[ENTROPY_POOL_CHUNK_SIZE];
+    size_t keep = sizeof(chunk);
+    
+    lock_stats_mutex_lock(&pool->pool_mutex, &pool->pool_lock_stats);
+    int done = pool->shutdown_requested ||
+               pool->pool_available >= pool->config.refill_threshold;
+    if (done) {
+        pool->refill_scheduled = 0;
+    }
+    pthread_mutex_unlock(&pool->pool_mutex);
+    if (done) return;
+    
+    // Generate entropy outside lock for better concurrency
+    int added = 0;
+    entropy_error_t err = entropy_get_bytes(pool->entropy_ctx, chunk, sizeof(chunk));
+    if (err != ENTROPY_SUCCESS) {
+        usleep(1000);  // Back off on error
+    } else {
         // Run health tests on generated entropy. The health context is shared
         // with the on-demand generation path, so serialize access to it.
-        pthread_mutex_lock(&pool->health_mutex);
+        lock_stats_mutex_lock(&pool->health_mutex, &pool->health_lock_stats);
         health_error_t health_err = health_tests_run_batch(
             pool->health_ctx, chunk, sizeof(chunk));
         pthread_mutex_unlock(&pool->health_mutex);
-
+        
         if (health_err != HEALTH_SUCCESS) {
             // Health test failed - discard this chunk
-            secure_memzero(chunk, sizeof(chunk));
             usleep(10000);  // Back off more on health failure
-            continue;
-        }
-        
-        // Add tested entropy to pool
-        pthread_mutex_lock(&pool->pool_mutex);
-        
-        // Calculate space available
-        size_t space_available = pool->pool_size - pool->pool_available;
-        size_t bytes_to_add = (sizeof(chunk) < space_available) ? 
-                               sizeof(chunk) : space_available;
-        
-        if (bytes_to_add > 0) {
-            // Calculate write position with wraparound
-            size_t write_pos = pool->pool_used + pool->pool_available;
-            if (write_pos >= pool->pool_size) {
-                write_pos -= pool->pool_size;
-            }
-            
-            // Handle wraparound
-            if (write_pos + bytes_to_add <= pool->pool_size) {
-                memcpy(pool->pool_buffer + write_pos, chunk, bytes_to_add);
-            } else {
-                // Split copy
-                size_t first_part = pool->pool_size - write_pos;
-                memcpy(pool->pool_buffer + write_pos, chunk, first_part);
-                memcpy(pool->pool_buffer, chunk + first_part, bytes_to_add - first_part);
-            }
-            
-            pool->pool_available += bytes_to_add;
-            pool->stats.background_chunks++;
+        } else {
+            added = 1;
         }
-        
-        pthread_mutex_unlock(&pool->pool_mutex);
-        
-        // Small delay to prevent spinning
-        usleep(100);
+    }
+    
+    // Withhold the tail of the chunk for the seed file when a save is due.
+    // Refill tasks never overlap, so seed_saved_ns needs no lock.
+    if (added && seed_save_due(pool)) {
+        keep -= SEED_FILE_SEED_SIZE;
+    }
+    
+    // Add tested entropy to pool and continue if still below threshold
+    lock_stats_mutex_lock(&pool->pool_mutex, &pool->pool_lock_stats);
+    if (added && pool_append_locked(pool, chunk, keep) > 0) {
+        pool->stats.background_chunks++;
+    }
+    pool->refill_scheduled = 0;
+    schedule_refill_locked(pool);
+    pthread_mutex_unlock(&pool->pool_mutex);
+    
+    if (keep < sizeof(chunk)) {
+        save_seed(pool, chunk + keep);
     }
     
     secure_memzero(chunk, sizeof(chunk));
-    return NULL;
 }
 
 // ============================================================================
@@ -117,7 +264,10 @@ int entropy_pool_init(entropy_pool_ctx_t **ctx) {
         .refill_threshold = ENTROPY_POOL_REFILL_THRESHOLD,
         .chunk_size = ENTROPY_POOL_CHUNK_SIZE,
         .enable_background_thread = 1,
-        .min_entropy = 4.0
+        .min_entropy = 4.0,
+        .defer_prefill = 0,
+        .seed_file = NULL,
+        .seed_save_interval_s = 0
     };
     
     return entropy_pool_init_with_config(ctx, &config);
@@ -220,7 +370,45 @@ int entropy_pool_init_with_config(
         return -1;
     }
 
-    if (pthread_cond_init(&ctx->refill_cond, NULL) != 0) {
+    // Keep our own copy of the seed path; the caller's string may not
+    // outlive the pool
+    int init_failed = 0;
+    if (config->seed_file) {
+        ctx->seed_path = strdup(config->seed_file);
+        ctx->config.seed_file = ctx->seed_path;
+        init_failed = (ctx->seed_path == NULL);
+    }
+    
+    // Pre-fill pool with tested entropy: all of it from a seed file when one
+    // is usable, else one chunk. Deferred pools without a seed start empty
+    // and serve their first request on the miss path.
+    int seeded = !init_failed && ctx->seed_path && prefill_from_seed(ctx) == 0;
+    if (!init_failed && !seeded && !config->defer_prefill) {
+        uint8_t startup_entropy[4096];
+        if (generate_tested(ctx, startup_entropy, sizeof(startup_entropy)) == 0) {
+            size_t keep = sizeof(startup_entropy);
+            if (ctx->seed_path) {
+                // No usable seed file: write one now rather than at the
+                // first refill, so the next start is fast even after a crash
+                keep -= SEED_FILE_SEED_SIZE;
+                save_seed(ctx, startup_entropy + keep);
+            }
+            memcpy(ctx->pool_buffer, startup_entropy, keep);
+            ctx->pool_available = keep;
+        }
+        secure_memzero(startup_entropy, sizeof(startup_entropy));
+    }
+    
+    // Start background thread if enabled. A deferred pool starts it after
+    // the first request so it does not compete with that request for CPU.
+    if (config->enable_background_thread && config->defer_prefill) {
+        ctx->background_deferred = 1;
+    } else if (config->enable_background_thread && !init_failed) {
+        init_failed = (entropy_pool_start_background(ctx) != 0);
+    }
+    
+    if (init_failed) {
+        free(ctx->seed_path);
         pthread_mutex_destroy(&ctx->health_mutex);
         pthread_mutex_destroy(&ctx->pool_mutex);
         health_tests_free(ctx->health_ctx);
@@ -233,37 +421,6 @@ int entropy_pool_init_with_config(
         return -1;
     }
     
-    // Pre-fill pool with tested entropy
-    uint8_t startup_entropy[4096];
-    err = entropy_get_bytes(ctx->entropy_ctx, startup_entropy, sizeof(startup_entropy));
-    if (err == ENTROPY_SUCCESS) {
-        pthread_mutex_lock(&ctx->health_mutex);
-        health_err = health_tests_run_batch(ctx->health_ctx, startup_entropy, sizeof(startup_entropy));
-        pthread_mutex_unlock(&ctx->health_mutex);
-        if (health_err == HEALTH_SUCCESS) {
-            memcpy(ctx->pool_buffer, startup_entropy, sizeof(startup_entropy));
-            ctx->pool_available = sizeof(startup_entropy);
-        }
-    }
-    secure_memzero(startup_entropy, sizeof(startup_entropy));
-    
-    // Start background thread if enabled
-    if (config->enable_background_thread) {
-        if (entropy_pool_start_background(ctx) != 0) {
-            pthread_cond_destroy(&ctx->refill_cond);
-            pthread_mutex_destroy(&ctx->health_mutex);
-            pthread_mutex_destroy(&ctx->pool_mutex);
-            health_tests_free(ctx->health_ctx);
-            free(ctx->health_ctx);
-            entropy_free(ctx->entropy_ctx);
-            free(ctx->entropy_ctx);
-            secure_memzero(ctx->pool_buffer, ctx->pool_size);
-            free(ctx->pool_buffer);
-            free(ctx);
-            return -1;
-        }
-    }
-    
     *ctx_out = ctx;
     return 0;
 }
@@ -276,8 +433,21 @@ void entropy_pool_free(entropy_pool_ctx_t *ctx) {
         entropy_pool_stop_background(ctx);
     }
     
+    // Save a seed for the next start from pooled entropy, generating it if
+    // the pool has run dry
+    if (ctx->seed_path) {
+        uint8_t seed[SEED_FILE_SEED_SIZE];
+        lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
+        size_t taken = pool_take_locked(ctx, seed, sizeof(seed));
+        pthread_mutex_unlock(&ctx->pool_mutex);
+        if (taken == sizeof(seed) || generate_tested(ctx, seed, sizeof(seed)) == 0) {
+            save_seed(ctx, seed);
+        }
+        secure_memzero(seed, sizeof(seed));
+        free(ctx->seed_path);
+    }
+    
     // Destroy synchronization primitives
-    pthread_cond_destroy(&ctx->refill_cond);
     pthread_mutex_destroy(&ctx->health_mutex);
     pthread_mutex_destroy(&ctx->pool_mutex);
 
@@ -310,14 +480,12 @@ int entropy_pool_start_background(entropy_pool_ctx_t *ctx) {
         return 0;  // Already running
     }
     
+    lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
     ctx->shutdown_requested = 0;
-    
-    if (pthread_create(&ctx->background_thread, NULL, entropy_worker_thread, ctx) != 0) {
-        return -1;
-    }
-    
     ctx->background_running = 1;
     ctx->stats.background_active = 1;
+    schedule_refill_locked(ctx);
+    pthread_mutex_unlock(&ctx->pool_mutex);
     
     return 0;
 }
@@ -325,14 +493,16 @@ int entropy_pool_start_background(entropy_pool_ctx_t *ctx) {
 void entropy_pool_stop_background(entropy_pool_ctx_t *ctx) {
     if (!ctx || !ctx->background_running) return;
     
-    // Signal shutdown
-    pthread_mutex_lock(&ctx->pool_mutex);
+    // Signal shutdown; a queued refill task returns without generating
+    lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
     ctx->shutdown_requested = 1;
-    pthread_cond_broadcast(&ctx->refill_cond);
+    task_pool_t *tasks = ctx->refill_pool;
     pthread_mutex_unlock(&ctx->pool_mutex);
     
-    // Wait for thread to exit
-    pthread_join(ctx->background_thread, NULL);
+    // Wait for the refill task in flight
+    if (tasks) {
+        task_pool_wait(tasks, &ctx->refill_group);
+    }
     
     ctx->background_running = 0;
     ctx->stats.background_active = 0;
@@ -342,44 +512,38 @@ void entropy_pool_stop_background(entropy_pool_ctx_t *ctx) {
 // ENTROPY RETRIEVAL
 // ============================================================================
 
-int entropy_pool_get_bytes(
+/**
+ * @brief Start a deferred pool's worker once (after its first request)
+ */
+static void start_deferred_background(entropy_pool_ctx_t *ctx) {
+    if (!__atomic_load_n(&ctx->background_deferred, __ATOMIC_ACQUIRE)) return;
+    
+    lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
+    int start = ctx->background_deferred;
+    __atomic_store_n(&ctx->background_deferred, 0, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&ctx->pool_mutex);
+    
+    // On failure the pool keeps working on the miss path alone
+    if (start) {
+        entropy_pool_start_background(ctx);
+    }
+}
+
+static int pool_get_bytes(
     entropy_pool_ctx_t *ctx,
     uint8_t *buffer,
     size_t size
 ) {
-    VALIDATE_NOT_NULL(ctx, -1);
-    VALIDATE_BUFFER(buffer, size, -1);
-    
-    pthread_mutex_lock(&ctx->pool_mutex);
+    lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
     
     // Try to serve from pool first (cache hit)
     if (ctx->pool_available >= size) {
-        // Copy from pool
-        size_t read_pos = ctx->pool_used;
-        
-        if (read_pos + size <= ctx->pool_size) {
-            // Simple copy
-            memcpy(buffer, ctx->pool_buffer + read_pos, size);
-        } else {
-            // Wraparound copy
-            size_t first_part = ctx->pool_size - read_pos;
-            memcpy(buffer, ctx->pool_buffer + read_pos, first_part);
-            memcpy(buffer + first_part, ctx->pool_buffer, size - first_part);
-        }
-        
-        ctx->pool_used += size;
-        if (ctx->pool_used >= ctx->pool_size) {
-            ctx->pool_used -= ctx->pool_size;
-        }
-        
-        ctx->pool_available -= size;
+        pool_take_locked(ctx, buffer, size);
         ctx->stats.cache_hits++;
         ctx->stats.bytes_generated += size;
         
-        // Signal refill if needed
-        if (ctx->pool_available < ctx->config.refill_threshold) {
-            pthread_cond_signal(&ctx->refill_cond);
-        }
+        // Queue a refill if needed
+        schedule_refill_locked(ctx);
         
         pthread_mutex_unlock(&ctx->pool_mutex);
         return 0;
@@ -389,6 +553,32 @@ int entropy_pool_get_bytes(
     ctx->stats.cache_misses++;
     pthread_mutex_unlock(&ctx->pool_mutex);
     
+    // Small request: generate a batch, serve the head and pool the rest
+    if (size < ENTROPY_POOL_MISS_BATCH) {
+        uint8_t batch[ENTROPY_POOL_MISS_BATCH];
+        if (entropy_get_bytes(ctx->entropy_ctx, batch, sizeof(batch)) != ENTROPY_SUCCESS) {
+            return -1;
+        }
+        
+        lock_stats_mutex_lock(&ctx->health_mutex, &ctx->health_lock_stats);
+        health_error_t health_err = health_tests_run_batch(ctx->health_ctx, batch, sizeof(batch));
+        pthread_mutex_unlock(&ctx->health_mutex);
+        if (health_err != HEALTH_SUCCESS) {
+            secure_memzero(batch, sizeof(batch));
+            return -1;
+        }
+        
+        memcpy(buffer, batch, size);
+        
+        lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
+        pool_append_locked(ctx, batch + size, sizeof(batch) - size);
+        ctx->stats.bytes_generated += size;
+        pthread_mutex_unlock(&ctx->pool_mutex);
+        
+        secure_memzero(batch, sizeof(batch));
+        return 0;
+    }
+    
     // Generate directly (bypassing pool for large requests)
     entropy_error_t err = entropy_get_bytes(ctx->entropy_ctx, buffer, size);
     if (err != ENTROPY_SUCCESS) {
@@ -397,7 +587,7 @@ int entropy_pool_get_bytes(
     
     // Test generated entropy. Serialize health_ctx access — the background
     // worker thread runs the same tests on the shared context concurrently.
-    pthread_mutex_lock(&ctx->health_mutex);
+    lock_stats_mutex_lock(&ctx->health_mutex, &ctx->health_lock_stats);
     health_error_t health_err = health_tests_run_batch(ctx->health_ctx, buffer, size);
     pthread_mutex_unlock(&ctx->health_mutex);
     if (health_err != HEALTH_SUCCESS) {
@@ -405,7 +595,7 @@ int entropy_pool_get_bytes(
         return -1;
     }
     
-    pthread_mutex_lock(&ctx->pool_mutex);
+    lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
     ctx->stats.bytes_generated += size;
     ctx->stats.cache_misses++;
     pthread_mutex_unlock(&ctx->pool_mutex);
@@ -413,11 +603,126 @@ int entropy_pool_get_bytes(
     return 0;
 }
 
+int entropy_pool_get_bytes(
+    entropy_pool_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size
+) {
+    VALIDATE_NOT_NULL(ctx, -1);
+    VALIDATE_BUFFER(buffer, size, -1);
+    
+    int rc = pool_get_bytes(ctx, buffer, size);
+    if (rc == 0) {
+        start_deferred_background(ctx);
+    }
+    return rc;
+}
+
+/**
+ * @brief Take pooled entropy and queue a refill
+ */
+static size_t pool_take_available(entropy_pool_ctx_t *ctx, uint8_t *buffer, size_t size) {
+    lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
+    size_t taken = pool_take_locked(ctx, buffer, size);
+    ctx->stats.bytes_generated += taken;
+    schedule_refill_locked(ctx);
+    pthread_mutex_unlock(&ctx->pool_mutex);
+    
+    return taken;
+}
+
+int entropy_pool_try_bytes(
+    entropy_pool_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    size_t *filled
+) {
+    if (filled) *filled = 0;
+    VALIDATE_NOT_NULL(ctx, -1);
+    VALIDATE_BUFFER(buffer, size, -1);
+    
+    lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
+    size_t taken = pool_take_locked(ctx, buffer, size);
+    ctx->stats.bytes_generated += taken;
+    if (taken == size) {
+        ctx->stats.cache_hits++;
+    } else {
+        ctx->stats.cache_misses++;
+    }
+    schedule_refill_locked(ctx);
+    pthread_mutex_unlock(&ctx->pool_mutex);
+    
+    start_deferred_background(ctx);
+    if (filled) *filled = taken;
+    return taken == size ? 0 : ENTROPY_POOL_WOULD_BLOCK;
+}
+
+int entropy_pool_get_bytes_deadline(
+    entropy_pool_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    uint64_t timeout_ns,
+    size_t *filled
+) {
+    if (filled) *filled = 0;
+    VALIDATE_NOT_NULL(ctx, -1);
+    VALIDATE_BUFFER(buffer, size, -1);
+    
+    uint64_t start = now_ns();
+    uint64_t deadline = timeout_ns > UINT64_MAX - start ? UINT64_MAX : start + timeout_ns;
+    size_t done = pool_take_available(ctx, buffer, size);
+    int rc = 0;
+    
+    if (done < size) {
+        lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
+        ctx->stats.cache_misses++;
+        pthread_mutex_unlock(&ctx->pool_mutex);
+    }
+    
+    uint8_t batch[ENTROPY_POOL_MISS_BATCH];
+    while (done < size) {
+        if (now_ns() >= deadline) {
+            rc = ENTROPY_POOL_TIMEOUT;
+            break;
+        }
+        
+        if (entropy_get_bytes(ctx->entropy_ctx, batch, sizeof(batch)) != ENTROPY_SUCCESS) {
+            rc = -1;
+            break;
+        }
+        
+        lock_stats_mutex_lock(&ctx->health_mutex, &ctx->health_lock_stats);
+        health_error_t health_err = health_tests_run_batch(ctx->health_ctx, batch, sizeof(batch));
+        pthread_mutex_unlock(&ctx->health_mutex);
+        
+        if (health_err == HEALTH_SUCCESS) {
+            size_t n = size - done < sizeof(batch) ? size - done : sizeof(batch);
+            memcpy(buffer + done, batch, n);
+            done += n;
+            
+            lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
+            pool_append_locked(ctx, batch + n, sizeof(batch) - n);
+            ctx->stats.bytes_generated += n;
+            pthread_mutex_unlock(&ctx->pool_mutex);
+        }
+        
+        // A refill task may have landed meanwhile
+        if (done < size) {
+            done += pool_take_available(ctx, buffer + done, size - done);
+        }
+    }
+    secure_memzero(batch, sizeof(batch));
+    
+    start_deferred_background(ctx);
+    if (filled) *filled = done;
+    return rc;
+}
+
 int entropy_pool_refill(entropy_pool_ctx_t *ctx) {
     VALIDATE_NOT_NULL(ctx, -1);
     
-    pthread_mutex_lock(&ctx->pool_mutex);
-    pthread_cond_signal(&ctx->refill_cond);
+    lock_stats_mutex_lock(&ctx->pool_mutex, &ctx->pool_lock_stats);
+    schedule_refill_locked(ctx);
     ctx->stats.refills_triggered++;
     pthread_mutex_unlock(&ctx->pool_mutex);
     
@@ -443,6 +748,19 @@ int entropy_pool_get_stats(
     return 0;
 }
 
+int entropy_pool_get_lock_stats(
+    const entropy_pool_ctx_t *ctx,
+    qrng_lock_stats_t *pool_lock,
+    qrng_lock_stats_t *health_lock
+) {
+    VALIDATE_NOT_NULL(ctx, -1);
+    
+    if (pool_lock) lock_stats_snapshot(&ctx->pool_lock_stats, pool_lock);
+    if (health_lock) lock_stats_snapshot(&ctx->health_lock_stats, health_lock);
+    
+    return 0;
+}
+
 size_t entropy_pool_get_fill_level(const entropy_pool_ctx_t *ctx) {
     if (!ctx) return 0;
     
@@ -495,5 +813,9 @@ void entropy_pool_print_stats(const entropy_pool_ctx_t *ctx) {
     
     printf("  Refills triggered:  %llu\n", (unsigned long long)stats.refills_triggered);
     printf("  Background chunks:  %llu\n", (unsigned long long)stats.background_chunks);
+    if (ctx->seed_path) {
+        printf("  Seed file loaded:   %s\n", stats.seed_file_loaded ? "Yes" : "No");
+        printf("  Seed file saves:    %llu\n", (unsigned long long)stats.seed_file_saves);
+    }
     printf("\n");
 }
\ No newline at end of file
@@ -6,16 +6,22 @@
 #include <pthread.h>
 #include "hardware_entropy.h"
 #include "../health/health_tests.h"
+#include "../common/lock_stats.h"
+#include "../scheduler/task_pool.h"
 
 /**
  * @file entropy_pool.h
  * @brief Advanced entropy pooling with background pre-generation
  *
  * Provides a high-performance entropy pool that:
- * - Pre-generates tested entropy in background thread
+ * - Pre-generates tested entropy in background refill tasks, run on the
+ *   shared task pool (task_pool.h) rather than a thread per pool
  * - Reduces latency for entropy requests
  * - Maintains continuous health testing
  * - Thread-safe access with lock-free reads when possible
+ * - Optional seed file (seed_file.h): a pool given one starts full, from the
+ *   previous run's seed mixed with fresh tested entropy, and saves a new
+ *   seed periodically and on free
  *
  * Performance benefits:
  * - Near-zero latency for cached entropy
@@ -32,6 +38,13 @@
 #define ENTROPY_POOL_REFILL_THRESHOLD (16 * 1024)  // Refill at 25%
 #define ENTROPY_POOL_CHUNK_SIZE 4096  // Generate 4KB chunks
 
+/*
+ * Extra return codes of entropy_pool_try_bytes and
+ * entropy_pool_get_bytes_deadline (other calls return 0 or -1).
+ */
+#define ENTROPY_POOL_WOULD_BLOCK (-2)  // Pool held fewer bytes than requested
+#define ENTROPY_POOL_TIMEOUT (-3)      // Deadline passed before the request was filled
+
 /**
  * @brief Entropy pool configuration
  */
@@ -39,8 +52,11 @@ typedef struct {
     size_t pool_size;              /**< Total pool size in bytes */
     size_t refill_threshold;       /**< Trigger refill when below this */
     size_t chunk_size;             /**< Size of generation chunks */
-    int enable_background_thread;  /**< Enable background generation */
+    int enable_background_thread;  /**< Enable background refill tasks */
     double min_entropy;            /**< Min-entropy for health tests */
+    int defer_prefill;             /**< Skip the startup prefill; start the worker after the first request */
+    const char *seed_file;         /**< Seed file path, or NULL for none (copied at init) */
+    uint32_t seed_save_interval_s; /**< Seconds between periodic seed saves (0 = default) */
 } entropy_pool_config_t;
 
 /**
@@ -53,7 +69,9 @@ typedef struct {
     uint64_t refills_triggered;    /**< Number of refill operations */
     uint64_t background_chunks;    /**< Chunks generated in background */
     size_t current_fill_level;     /**< Current pool fill level */
-    int background_active;         /**< Background thread status */
+    int background_active;         /**< Background refill enabled */
+    int seed_file_loaded;          /**< Pool was seeded from the seed file at init */
+    uint64_t seed_file_saves;      /**< Successful seed file writes */
 } entropy_pool_stats_t;
 
 /**
@@ -71,18 +89,26 @@ typedef struct {
     
     // Thread safety
     pthread_mutex_t pool_mutex;    /**< Pool access mutex */
-    pthread_mutex_t health_mutex;  /**< Serializes health_ctx access across the worker + on-demand paths */
-    pthread_cond_t refill_cond;    /**< Refill condition variable */
-    pthread_t background_thread;   /**< Background generation thread */
-    int background_running;        /**< Background thread running flag */
+    pthread_mutex_t health_mutex;  /**< Serializes health_ctx access across the refill + on-demand paths */
+    task_group_t refill_group;     /**< Refill task in flight, waited for on stop */
+    task_pool_t *refill_pool;      /**< Pool the refill task was submitted to */
+    int refill_scheduled;          /**< A refill task is queued or running */
+    int background_running;        /**< Background refill enabled */
+    int background_deferred;       /**< Refill starts after the first request (defer_prefill) */
     int shutdown_requested;        /**< Shutdown flag */
     
     // Components
     entropy_ctx_t *entropy_ctx;    /**< Hardware entropy context */
     health_test_ctx_t *health_ctx; /**< Health test context */
     
+    // Seed file
+    char *seed_path;               /**< Owned copy of config.seed_file */
+    uint64_t seed_saved_ns;        /**< Last seed save (CLOCK_MONOTONIC) */
+    
     // Statistics
     entropy_pool_stats_t stats;
+    qrng_lock_stats_t pool_lock_stats;   /**< pool_mutex contention (QRNG_LOCK_STATS builds) */
+    qrng_lock_stats_t health_lock_stats; /**< health_mutex contention (QRNG_LOCK_STATS builds) */
 } entropy_pool_ctx_t;
 
 // ============================================================================
@@ -112,7 +138,8 @@ int entropy_pool_init_with_config(
 /**
  * @brief Free entropy pool context
  *
- * Stops background thread and securely erases pool.
+ * Stops background refill, saves a new seed when a seed file is configured,
+ * and securely erases pool.
  *
  * @param ctx Pool context
  */
@@ -121,7 +148,9 @@ void entropy_pool_free(entropy_pool_ctx_t *ctx);
 /**
  * @brief Start background entropy generation
  *
- * Launches background thread that continuously refills the pool.
+ * Enables refill tasks: whenever the pool drops below its refill threshold
+ * a task on the shared task pool generates and tests one chunk, and
+ * resubmits itself until the threshold is reached again.
  *
  * @param ctx Pool context
  * @return 0 on success, -1 on error
@@ -131,6 +160,8 @@ int entropy_pool_start_background(entropy_pool_ctx_t *ctx);
 /**
  * @brief Stop background entropy generation
  *
+ * Waits for an in-flight refill task, running queued pool tasks meanwhile.
+ *
  * @param ctx Pool context
  */
 void entropy_pool_stop_background(entropy_pool_ctx_t *ctx);
@@ -156,6 +187,51 @@ int entropy_pool_get_bytes(
     size_t size
 );
 
+/**
+ * @brief Take entropy from the pool without generating any
+ *
+ * Copies what the pool holds, up to size bytes, and queues a refill. Never
+ * runs the hardware source or health tests on the caller's thread.
+ *
+ * @param ctx Pool context
+ * @param buffer Output buffer
+ * @param size Number of bytes requested
+ * @param filled Output: bytes written to buffer (may be NULL)
+ * @return 0 when size bytes were copied, ENTROPY_POOL_WOULD_BLOCK on a
+ *         partial (possibly empty) fill, -1 on error
+ */
+int entropy_pool_try_bytes(
+    entropy_pool_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    size_t *filled
+);
+
+/**
+ * @brief Get entropy, generating on the caller's thread until a deadline
+ *
+ * Takes pooled entropy first, then generates and tests 1 KB batches while
+ * time remains, taking pooled entropy again between batches. A batch that
+ * fails the health tests is discarded and generation retried, so a source
+ * that is recovering gets until the deadline. The deadline is checked
+ * between batches: the call overruns it by at most one batch.
+ *
+ * @param ctx Pool context
+ * @param buffer Output buffer
+ * @param size Number of bytes requested
+ * @param timeout_ns Time allowed, from the call
+ * @param filled Output: bytes written to buffer (may be NULL)
+ * @return 0 when filled, ENTROPY_POOL_TIMEOUT on a partial fill, -1 on a
+ *         source error
+ */
+int entropy_pool_get_bytes_deadline(
+    entropy_pool_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    uint64_t timeout_ns,
+    size_t *filled
+);
+
 /**
  * @brief Refill entropy pool
  *
@@ -198,6 +274,23 @@ size_t entropy_pool_get_fill_level(const entropy_pool_ctx_t *ctx);
  */
 int entropy_pool_needs_refill(const entropy_pool_ctx_t *ctx);
 
+/**
+ * @brief Get contention statistics for the pool and health-test mutexes
+ *
+ * Counters are only recorded when the library is built with
+ * QRNG_LOCK_STATS (`make LOCK_STATS=1`); otherwise they read as zero.
+ *
+ * @param ctx Pool context
+ * @param pool_lock Output stats for pool_mutex (may be NULL)
+ * @param health_lock Output stats for health_mutex (may be NULL)
+ * @return 0 on success, -1 on error
+ */
+int entropy_pool_get_lock_stats(
+    const entropy_pool_ctx_t *ctx,
+    qrng_lock_stats_t *pool_lock,
+    qrng_lock_stats_t *health_lock
+);
+
 /**
  * @brief Print pool statistics
  *
@@ -0,0 +1,329 @@
+/**
+ * @file seed_file.c
+ * @brief Persisted seed with atomic replace and rewrite-on-read
+ */
+
+#define _GNU_SOURCE  // O_TMPFILE
+#include "seed_file.h"
+#include "../common/sha256.h"
+#include "../common/secure_memory.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SEED_FILE_MAGIC "QRNGSEED"
+#define SEED_FILE_MAGIC_SIZE 8
+#define SEED_FILE_VERSION 1
+#define SEED_FILE_HEADER_SIZE (SEED_FILE_MAGIC_SIZE + 4 + 4)
+#define SEED_FILE_TOTAL_SIZE (SEED_FILE_HEADER_SIZE + SEED_FILE_SEED_SIZE + SHA256_DIGEST_SIZE)
+
+// Domain-separation labels: the key handed to the caller and the seed written
+// back must never be derivable from each other
+static const char LABEL_KEY[] = "qrng seed-file key";
+static const char LABEL_NEXT[] = "qrng seed-file next";
+static const char LABEL_EXPAND[] = "qrng seed-file expand";
+
+// ============================================================================
+// ENCODING
+// ============================================================================
+
+static void put_u32_le(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t get_u32_le(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void encode(uint8_t out[SEED_FILE_TOTAL_SIZE], const uint8_t seed[SEED_FILE_SEED_SIZE]) {
+    memcpy(out, SEED_FILE_MAGIC, SEED_FILE_MAGIC_SIZE);
+    put_u32_le(out + SEED_FILE_MAGIC_SIZE, SEED_FILE_VERSION);
+    put_u32_le(out + SEED_FILE_MAGIC_SIZE + 4, SEED_FILE_SEED_SIZE);
+    memcpy(out + SEED_FILE_HEADER_SIZE, seed, SEED_FILE_SEED_SIZE);
+    sha256(out, SEED_FILE_HEADER_SIZE + SEED_FILE_SEED_SIZE,
+           out + SEED_FILE_HEADER_SIZE + SEED_FILE_SEED_SIZE);
+}
+
+static seed_file_error_t decode(const uint8_t in[SEED_FILE_TOTAL_SIZE],
+                                uint8_t seed[SEED_FILE_SEED_SIZE]) {
+    uint8_t digest[SHA256_DIGEST_SIZE];
+
+    if (memcmp(in, SEED_FILE_MAGIC, SEED_FILE_MAGIC_SIZE) != 0 ||
+        get_u32_le(in + SEED_FILE_MAGIC_SIZE) != SEED_FILE_VERSION ||
+        get_u32_le(in + SEED_FILE_MAGIC_SIZE + 4) != SEED_FILE_SEED_SIZE) {
+        return SEED_FILE_ERROR_CORRUPT;
+    }
+
+    sha256(in, SEED_FILE_HEADER_SIZE + SEED_FILE_SEED_SIZE, digest);
+    if (secure_memcmp(digest, in + SEED_FILE_HEADER_SIZE + SEED_FILE_SEED_SIZE,
+                      SHA256_DIGEST_SIZE) != 0) {
+        return SEED_FILE_ERROR_CORRUPT;
+    }
+
+    memcpy(seed, in + SEED_FILE_HEADER_SIZE, SEED_FILE_SEED_SIZE);
+    return SEED_FILE_SUCCESS;
+}
+
+// ============================================================================
+// ATOMIC REPLACE
+// ============================================================================
+
+static int write_all(int fd, const uint8_t *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+// Directory part of path ("." when there is none)
+static void dir_of(const char *path, char *dir, size_t size) {
+    const char *slash = strrchr(path, '/');
+    if (!slash) {
+        snprintf(dir, size, ".");
+    } else if (slash == path) {
+        snprintf(dir, size, "/");
+    } else {
+        snprintf(dir, size, "%.*s", (int)(slash - path), path);
+    }
+}
+
+static void fsync_dir(const char *dir) {
+    int fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+#ifdef O_TMPFILE
+// Unnamed file in dir, given a name only once its contents are durable
+static int write_via_tmpfile(const char *path, const char *dir,
+                             const uint8_t *data, size_t len) {
+    char proc_path[64];
+    char tmp_path[4096];
+    int fd = open(dir, O_TMPFILE | O_WRONLY | O_CLOEXEC, 0600);
+    if (fd < 0) return -1;
+
+    if (write_all(fd, data, len) != 0 || fsync(fd) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    // linkat() cannot replace an existing name, so link under a private
+    // temporary name and rename() that over the target
+    snprintf(proc_path, sizeof(proc_path), "/proc/self/fd/%d", fd);
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp.%ld", path, (long)getpid());
+    unlink(tmp_path);
+    if (linkat(AT_FDCWD, proc_path, AT_FDCWD, tmp_path, AT_SYMLINK_FOLLOW) != 0) {
+        close(fd);
+        return -1;
+    }
+    close(fd);
+
+    if (rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+        return -1;
+    }
+    return 0;
+}
+#endif
+
+static int write_via_mkstemp(const char *path, const uint8_t *data, size_t len) {
+    char tmp_path[4096];
+    int fd;
+
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp.XXXXXX", path);
+    fd = mkstemp(tmp_path);  // created 0600
+    if (fd < 0) return -1;
+
+    if (write_all(fd, data, len) != 0 || fsync(fd) != 0) {
+        close(fd);
+        unlink(tmp_path);
+        return -1;
+    }
+    close(fd);
+
+    if (rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+        return -1;
+    }
+    return 0;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+seed_file_error_t seed_file_write(const char *path, const uint8_t seed[SEED_FILE_SEED_SIZE]) {
+    uint8_t data[SEED_FILE_TOTAL_SIZE];
+    char dir[4096];
+    int rc = -1;
+
+    if (!path || !seed) return SEED_FILE_ERROR_NULL_POINTER;
+
+    encode(data, seed);
+    dir_of(path, dir, sizeof(dir));
+
+#ifdef O_TMPFILE
+    rc = write_via_tmpfile(path, dir, data, sizeof(data));
+#endif
+    if (rc != 0) {
+        // Filesystem without O_TMPFILE support, or no /proc to link through
+        rc = write_via_mkstemp(path, data, sizeof(data));
+    }
+    secure_memzero(data, sizeof(data));
+
+    if (rc != 0) return SEED_FILE_ERROR_IO;
+
+    // Make the rename itself durable
+    fsync_dir(dir);
+    return SEED_FILE_SUCCESS;
+}
+
+seed_file_error_t seed_file_read(const char *path, uint8_t seed[SEED_FILE_SEED_SIZE]) {
+    uint8_t data[SEED_FILE_TOTAL_SIZE + 1];
+    struct stat st;
+    size_t got = 0;
+    seed_file_error_t err;
+    int fd;
+
+    if (!path || !seed) return SEED_FILE_ERROR_NULL_POINTER;
+
+    fd = open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno == ENOENT) return SEED_FILE_ERROR_NOT_FOUND;
+        if (errno == ELOOP) return SEED_FILE_ERROR_INSECURE;
+        return SEED_FILE_ERROR_IO;
+    }
+
+    // A seed others can read is known to them; one others can write is
+    // chosen by them
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return SEED_FILE_ERROR_IO;
+    }
+    if (!S_ISREG(st.st_mode) || st.st_uid != geteuid() ||
+        (st.st_mode & (S_IRWXG | S_IRWXO)) != 0) {
+        close(fd);
+        return SEED_FILE_ERROR_INSECURE;
+    }
+
+    // Read one byte past the expected size so trailing data is detected
+    while (got < sizeof(data)) {
+        ssize_t n = read(fd, data + got, sizeof(data) - got);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            close(fd);
+            secure_memzero(data, sizeof(data));
+            return SEED_FILE_ERROR_IO;
+        }
+        if (n == 0) break;
+        got += (size_t)n;
+    }
+    close(fd);
+
+    err = got == SEED_FILE_TOTAL_SIZE ? decode(data, seed) : SEED_FILE_ERROR_CORRUPT;
+    secure_memzero(data, sizeof(data));
+    return err;
+}
+
+seed_file_error_t seed_file_consume(const char *path, const uint8_t *fresh,
+                                    size_t fresh_len, uint8_t key[SEED_FILE_KEY_SIZE]) {
+    uint8_t seed[SEED_FILE_SEED_SIZE];
+    uint8_t next[SEED_FILE_SEED_SIZE];
+    sha256_ctx_t sha;
+    seed_file_error_t err;
+    uint8_t i;
+
+    if (!path || !fresh || !key) return SEED_FILE_ERROR_NULL_POINTER;
+    memset(key, 0, SEED_FILE_KEY_SIZE);
+    if (fresh_len == 0) return SEED_FILE_ERROR_NULL_POINTER;
+
+    err = seed_file_read(path, seed);
+    if (err != SEED_FILE_SUCCESS) return err;
+
+    // Replacement seed: two independent 32-byte halves
+    for (i = 0; i < 2; i++) {
+        sha256_init(&sha);
+        sha256_update(&sha, LABEL_NEXT, sizeof(LABEL_NEXT));
+        sha256_update(&sha, &i, 1);
+        sha256_update(&sha, seed, sizeof(seed));
+        sha256_update(&sha, fresh, fresh_len);
+        sha256_final(&sha, next + (size_t)i * SHA256_DIGEST_SIZE);
+    }
+
+    // Rewrite before use: if this fails the old seed could be read again on
+    // the next start, so it must not be used now either
+    err = seed_file_write(path, next);
+    secure_memzero(next, sizeof(next));
+    if (err != SEED_FILE_SUCCESS) {
+        secure_memzero(seed, sizeof(seed));
+        secure_memzero(&sha, sizeof(sha));
+        return err;
+    }
+
+    sha256_init(&sha);
+    sha256_update(&sha, LABEL_KEY, sizeof(LABEL_KEY));
+    sha256_update(&sha, seed, sizeof(seed));
+    sha256_update(&sha, fresh, fresh_len);
+    sha256_final(&sha, key);
+
+    secure_memzero(seed, sizeof(seed));
+    secure_memzero(&sha, sizeof(sha));
+    return SEED_FILE_SUCCESS;
+}
+
+void seed_file_expand(const uint8_t key[SEED_FILE_KEY_SIZE], uint8_t *out, size_t len) {
+    uint8_t block[SHA256_DIGEST_SIZE];
+    uint8_t ctr[8];
+    sha256_ctx_t sha;
+    uint64_t counter = 0;
+
+    if (!key || !out) return;
+
+    while (len > 0) {
+        size_t take = len < sizeof(block) ? len : sizeof(block);
+        put_u32_le(ctr, (uint32_t)counter);
+        put_u32_le(ctr + 4, (uint32_t)(counter >> 32));
+
+        sha256_init(&sha);
+        sha256_update(&sha, LABEL_EXPAND, sizeof(LABEL_EXPAND));
+        sha256_update(&sha, key, SEED_FILE_KEY_SIZE);
+        sha256_update(&sha, ctr, sizeof(ctr));
+        sha256_final(&sha, block);
+
+        memcpy(out, block, take);
+        out += take;
+        len -= take;
+        counter++;
+    }
+
+    secure_memzero(block, sizeof(block));
+    secure_memzero(&sha, sizeof(sha));
+}
+
+const char* seed_file_error_string(seed_file_error_t error) {
+    switch (error) {
+        case SEED_FILE_SUCCESS: return "Success";
+        case SEED_FILE_ERROR_NULL_POINTER: return "NULL pointer or empty input";
+        case SEED_FILE_ERROR_NOT_FOUND: return "Seed file not found";
+        case SEED_FILE_ERROR_IO: return "Seed file I/O error";
+        case SEED_FILE_ERROR_CORRUPT: return "Seed file corrupt";
+        case SEED_FILE_ERROR_INSECURE: return "Seed file has unsafe owner, type or permissions";
+        default: return "Unknown error";
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef SEED_FILE_H
+#define SEED_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file seed_file.h
+ * @brief Persisted seed for fast restarts
+ *
+ * At startup the entropy pool and secure_rng must gather all their initial
+ * entropy from live sources, which is slow on boot, in fresh containers and
+ * with jitter-only sources. A seed file carries 64 bytes of output from the
+ * previous run:
+ *
+ * - seed_file_consume() verifies the file (magic, length, SHA-256 digest,
+ *   owner-only permissions), derives a key from the seed AND caller-supplied
+ *   fresh entropy, and atomically replaces the file with a new seed before
+ *   returning. The old seed is therefore never used twice, and it is never
+ *   used alone: the key depends on the fresh input too.
+ * - seed_file_write() replaces the file atomically: the data goes to an
+ *   unnamed O_TMPFILE (or a mkstemp() file where O_TMPFILE is unsupported),
+ *   is fsync()ed, and is renamed over the old file, so a crash leaves the old
+ *   or the new file, never a torn one.
+ *
+ * File layout (112 bytes): "QRNGSEED", u32 version, u32 seed length (both
+ * little-endian), the seed, then SHA-256 over everything before it.
+ */
+
+#define SEED_FILE_SEED_SIZE 64              /**< Seed bytes stored in the file */
+#define SEED_FILE_KEY_SIZE 32               /**< Key returned by seed_file_consume */
+#define SEED_FILE_DEFAULT_SAVE_INTERVAL_S 600  /**< Periodic rewrite interval */
+
+/**
+ * @brief Seed file error codes
+ */
+typedef enum {
+    SEED_FILE_SUCCESS = 0,                  /**< Operation successful */
+    SEED_FILE_ERROR_NULL_POINTER = -1,      /**< NULL argument */
+    SEED_FILE_ERROR_NOT_FOUND = -2,         /**< No seed file at path */
+    SEED_FILE_ERROR_IO = -3,                /**< Read, write, fsync or rename failed */
+    SEED_FILE_ERROR_CORRUPT = -4,           /**< Bad magic, length or digest */
+    SEED_FILE_ERROR_INSECURE = -5           /**< Not a regular file owned by us with mode 0600 */
+} seed_file_error_t;
+
+/**
+ * @brief Atomically replace the seed file with seed
+ */
+seed_file_error_t seed_file_write(const char *path, const uint8_t seed[SEED_FILE_SEED_SIZE]);
+
+/**
+ * @brief Read and verify the seed file without replacing it
+ */
+seed_file_error_t seed_file_read(const char *path, uint8_t seed[SEED_FILE_SEED_SIZE]);
+
+/**
+ * @brief Use the seed file once
+ *
+ * key = SHA-256(label || seed || fresh). The file is rewritten with a seed
+ * derived under a different label before the key is released; if that
+ * rewrite fails the key is not returned.
+ *
+ * @param path Seed file
+ * @param fresh Fresh, health-tested entropy (must not be empty)
+ * @param fresh_len Length of fresh
+ * @param key Output key
+ * @return SEED_FILE_SUCCESS or error code (key zeroed on error)
+ */
+seed_file_error_t seed_file_consume(const char *path, const uint8_t *fresh,
+                                    size_t fresh_len, uint8_t key[SEED_FILE_KEY_SIZE]);
+
+/**
+ * @brief Expand a key into len bytes: SHA-256(key || counter) blocks
+ */
+void seed_file_expand(const uint8_t key[SEED_FILE_KEY_SIZE], uint8_t *out, size_t len);
+
+const char* seed_file_error_string(seed_file_error_t error);
+
+#endif /* SEED_FILE_H */
@@ -4,6 +4,14 @@
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
+#include <errno.h>
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
 
 // Platform-specific high-resolution timing
 #ifdef __x86_64__
@@ -34,8 +42,32 @@
  * - Operation breakdowns
  * - Throughput measurement
  * - Latency histograms
+ * - Hardware counter attribution per operation (Linux perf_event_open)
  */
 
+// Bytes moved per last-level cache miss, for the bandwidth estimate
+#define PERF_CACHE_LINE_BYTES 64
+
+static uint64_t get_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void hw_reset_fds(perf_monitor_ctx_t *ctx) {
+    for (int i = 0; i < PERF_HW_MAX; i++) {
+        ctx->hw_fds[i] = -1;
+    }
+}
+
+static int hw_read_group(const perf_monitor_ctx_t *ctx, uint64_t values[PERF_HW_MAX]);
+static long hw_current_tid(void);
+
+// The group counts only the thread that opened it
+static int hw_counts_caller(const perf_monitor_ctx_t *ctx) {
+    return ctx->hw_enabled && hw_current_tid() == ctx->hw_tid;
+}
+
 // ============================================================================
 // CONTEXT MANAGEMENT
 // ============================================================================
@@ -49,6 +81,8 @@ int perf_monitor_init(perf_monitor_ctx_t **ctx_out) {
     // Initialize timing
     ctx->start_time = get_cycles();
     ctx->min_latency_cycles = UINT64_MAX;
+    hw_reset_fds(ctx);
+    ctx->hw_paranoid = -99;
     
     // Get CPU frequency for time conversion (approximate)
     #ifdef __linux__
@@ -77,6 +111,7 @@ int perf_monitor_init(perf_monitor_ctx_t **ctx_out) {
 
 void perf_monitor_free(perf_monitor_ctx_t *ctx) {
     if (!ctx) return;
+    perf_monitor_disable_hw_counters(ctx);
     secure_memzero(ctx, sizeof(*ctx));
     free(ctx);
 }
@@ -84,14 +119,25 @@ void perf_monitor_free(perf_monitor_ctx_t *ctx) {
 void perf_monitor_reset(perf_monitor_ctx_t *ctx) {
     if (!ctx) return;
     
-    // Save CPU frequency
+    // Save CPU frequency and the open counter group
     double saved_mhz = ctx->cpu_mhz;
+    int saved_hw_enabled = ctx->hw_enabled;
+    int saved_hw_error = ctx->hw_error;
+    int saved_hw_paranoid = ctx->hw_paranoid;
+    long saved_hw_tid = ctx->hw_tid;
+    int saved_hw_fds[PERF_HW_MAX];
+    memcpy(saved_hw_fds, ctx->hw_fds, sizeof(saved_hw_fds));
     
     // Reset all stats
     secure_memzero(ctx, sizeof(*ctx));
     
     // Restore
     ctx->cpu_mhz = saved_mhz;
+    ctx->hw_enabled = saved_hw_enabled;
+    ctx->hw_error = saved_hw_error;
+    ctx->hw_paranoid = saved_hw_paranoid;
+    ctx->hw_tid = saved_hw_tid;
+    memcpy(ctx->hw_fds, saved_hw_fds, sizeof(saved_hw_fds));
     ctx->start_time = get_cycles();
     ctx->min_latency_cycles = UINT64_MAX;
 }
@@ -104,6 +150,14 @@ void perf_monitor_start_operation(perf_monitor_ctx_t *ctx, perf_operation_t op)
     if (!ctx || op >= PERF_OP_MAX) return;
     
     ctx->current_op = op;
+    
+    // Sample counters before the cycle stamp so the read is not timed
+    if (hw_counts_caller(ctx) && hw_read_group(ctx, ctx->hw_op_start) == 0) {
+        ctx->hw_op_start_ns = get_monotonic_ns();
+    } else {
+        ctx->hw_op_start_ns = 0;
+    }
+    
     ctx->op_start_cycles = get_cycles();
 }
 
@@ -113,6 +167,22 @@ void perf_monitor_end_operation(perf_monitor_ctx_t *ctx) {
     uint64_t end_cycles = get_cycles();
     uint64_t elapsed = end_cycles - ctx->op_start_cycles;
     
+    // Attribute hardware counter deltas to the operation type
+    if (ctx->hw_op_start_ns != 0 && ctx->current_op < PERF_OP_MAX) {
+        uint64_t now[PERF_HW_MAX];
+        if (hw_counts_caller(ctx) && hw_read_group(ctx, now) == 0) {
+            perf_hw_counters_t *acc = &ctx->hw_by_op[ctx->current_op];
+            for (int i = 0; i < PERF_HW_MAX; i++) {
+                if (now[i] >= ctx->hw_op_start[i]) {
+                    acc->counts[i] += now[i] - ctx->hw_op_start[i];
+                }
+            }
+            acc->operations++;
+            acc->elapsed_ns += get_monotonic_ns() - ctx->hw_op_start_ns;
+        }
+        ctx->hw_op_start_ns = 0;
+    }
+    
     // Update totals
     ctx->total_operations++;
     ctx->total_cycles += elapsed;
@@ -267,6 +337,40 @@ void perf_monitor_print_stats(const perf_monitor_ctx_t *ctx) {
         threshold *= 2;
     }
     printf("\n");
+    
+    // Hardware counters (only when they were requested)
+    if (ctx->hw_enabled) {
+        printf("Hardware Counters (per operation type):\n");
+        printf("─────────────────────────────────────────────────────────\n");
+        printf("  %-20s %10s %6s %9s %9s %9s %9s\n",
+               "Operation", "Ops", "IPC", "LLC MPKI", "Br MPKI", "dTLB MPKI", "Est GB/s");
+        for (int op = 0; op < PERF_OP_MAX; op++) {
+            perf_hw_counters_t counters;
+            perf_hw_derived_t derived;
+            if (perf_monitor_get_hw_counters(ctx, (perf_operation_t)op, &counters, &derived) != 0 ||
+                counters.operations == 0) {
+                continue;
+            }
+            printf("  %-20s %10llu %6.2f %9.2f %9.2f %9.2f %9.2f\n",
+                   perf_operation_name((perf_operation_t)op),
+                   (unsigned long long)counters.operations,
+                   derived.ipc, derived.llc_mpki, derived.branch_mpki,
+                   derived.dtlb_mpki, derived.est_bandwidth_gbps);
+        }
+        for (int i = 0; i < PERF_HW_MAX; i++) {
+            if (ctx->hw_fds[i] < 0) {
+                printf("  (some events are not supported by this PMU and read as 0)\n");
+                break;
+            }
+        }
+        printf("\n");
+    } else if (ctx->hw_error != 0) {
+        printf("Hardware Counters: unavailable (%s", strerror(ctx->hw_error));
+        if (ctx->hw_paranoid != -99) {
+            printf(", perf_event_paranoid=%d", ctx->hw_paranoid);
+        }
+        printf(") - cycle timing only\n\n");
+    }
 }
 
 double perf_monitor_get_overhead_percent(const perf_monitor_ctx_t *ctx) {
@@ -277,4 +381,217 @@ double perf_monitor_get_overhead_percent(const perf_monitor_ctx_t *ctx) {
     uint64_t monitoring_cycles = ctx->total_operations * 50;  // ~50 cycles per operation
     
     return 100.0 * monitoring_cycles / ctx->total_cycles;
-}
\ No newline at end of file
+}
+
+// ============================================================================
+// HARDWARE COUNTERS
+// ============================================================================
+
+#ifdef __linux__
+
+typedef struct {
+    uint32_t type;
+    uint64_t config;
+} hw_event_spec_t;
+
+// Indexed by perf_hw_event_t; the first entry is the group leader
+static const hw_event_spec_t hw_event_specs[PERF_HW_MAX] = {
+    [PERF_HW_CYCLES]        = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    [PERF_HW_INSTRUCTIONS]  = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    [PERF_HW_LLC_MISSES]    = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    [PERF_HW_BRANCH_MISSES] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    [PERF_HW_DTLB_MISSES]   = { PERF_TYPE_HW_CACHE,
+                                PERF_COUNT_HW_CACHE_DTLB |
+                                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) }
+};
+
+static int read_perf_paranoid(void) {
+    int level = -99;
+    FILE *f = fopen("/proc/sys/kernel/perf_event_paranoid", "r");
+    if (f) {
+        if (fscanf(f, "%d", &level) != 1) {
+            level = -99;
+        }
+        fclose(f);
+    }
+    return level;
+}
+
+static int open_hw_event(const hw_event_spec_t *spec, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec->type;
+    attr.config = spec->config;
+    attr.disabled = (group_fd == -1);   // Leader starts disabled, members follow it
+    attr.exclude_kernel = 1;            // User-space only: allowed at paranoid <= 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+static int hw_read_group(const perf_monitor_ctx_t *ctx, uint64_t values[PERF_HW_MAX]) {
+    struct {
+        uint64_t nr;
+        uint64_t time_enabled;
+        uint64_t time_running;
+        uint64_t values[PERF_HW_MAX];
+    } data;
+    
+    ssize_t n = read(ctx->hw_fds[PERF_HW_CYCLES], &data, sizeof(data));
+    if (n < (ssize_t)(3 * sizeof(uint64_t))) {
+        return -1;
+    }
+    
+    // Scale for PMU multiplexing when the group was not always scheduled
+    double scale = 1.0;
+    if (data.time_running > 0 && data.time_running < data.time_enabled) {
+        scale = (double)data.time_enabled / (double)data.time_running;
+    }
+    
+    // Group values arrive in open order, skipping events that failed to open
+    uint64_t slot = 0;
+    for (int i = 0; i < PERF_HW_MAX; i++) {
+        if (ctx->hw_fds[i] < 0 || slot >= data.nr) {
+            values[i] = 0;
+            continue;
+        }
+        values[i] = (uint64_t)((double)data.values[slot++] * scale);
+    }
+    
+    return 0;
+}
+
+static long hw_current_tid(void) {
+    return (long)syscall(SYS_gettid);
+}
+
+int perf_monitor_enable_hw_counters(perf_monitor_ctx_t *ctx) {
+    if (!ctx) return -1;
+    if (ctx->hw_enabled) return 0;
+    
+    ctx->hw_paranoid = read_perf_paranoid();
+    hw_reset_fds(ctx);
+    
+    int leader = open_hw_event(&hw_event_specs[PERF_HW_CYCLES], -1);
+    if (leader < 0) {
+        ctx->hw_error = errno;
+        return -1;
+    }
+    ctx->hw_fds[PERF_HW_CYCLES] = leader;
+    
+    // Members are optional: VMs and some PMUs lack cache or TLB events
+    for (int i = 0; i < PERF_HW_MAX; i++) {
+        if (i == PERF_HW_CYCLES) continue;
+        ctx->hw_fds[i] = open_hw_event(&hw_event_specs[i], leader);
+    }
+    
+    if (ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP) != 0 ||
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) != 0) {
+        ctx->hw_error = errno;
+        perf_monitor_disable_hw_counters(ctx);
+        return -1;
+    }
+    
+    ctx->hw_error = 0;
+    ctx->hw_tid = hw_current_tid();
+    ctx->hw_enabled = 1;
+    memset(ctx->hw_by_op, 0, sizeof(ctx->hw_by_op));
+    return 0;
+}
+
+void perf_monitor_disable_hw_counters(perf_monitor_ctx_t *ctx) {
+    if (!ctx) return;
+    
+    for (int i = 0; i < PERF_HW_MAX; i++) {
+        if (ctx->hw_fds[i] >= 0) {
+            close(ctx->hw_fds[i]);
+        }
+    }
+    hw_reset_fds(ctx);
+    ctx->hw_enabled = 0;
+}
+
+#else /* !__linux__ */
+
+static long hw_current_tid(void) {
+    return 0;
+}
+
+static int hw_read_group(const perf_monitor_ctx_t *ctx, uint64_t values[PERF_HW_MAX]) {
+    (void)ctx;
+    memset(values, 0, sizeof(uint64_t) * PERF_HW_MAX);
+    return -1;
+}
+
+int perf_monitor_enable_hw_counters(perf_monitor_ctx_t *ctx) {
+    if (!ctx) return -1;
+    // perf_event_open is Linux-specific; keep cycle timing only
+    ctx->hw_error = ENOSYS;
+    return -1;
+}
+
+void perf_monitor_disable_hw_counters(perf_monitor_ctx_t *ctx) {
+    if (!ctx) return;
+    hw_reset_fds(ctx);
+    ctx->hw_enabled = 0;
+}
+
+#endif /* __linux__ */
+
+int perf_monitor_hw_available(const perf_monitor_ctx_t *ctx) {
+    return (ctx && ctx->hw_enabled);
+}
+
+int perf_monitor_get_hw_counters(
+    const perf_monitor_ctx_t *ctx,
+    perf_operation_t op,
+    perf_hw_counters_t *counters,
+    perf_hw_derived_t *derived
+) {
+    if (!ctx || !counters || op >= PERF_OP_MAX) return -1;
+    if (!ctx->hw_enabled) return -1;
+    
+    memcpy(counters, &ctx->hw_by_op[op], sizeof(*counters));
+    
+    if (derived) {
+        memset(derived, 0, sizeof(*derived));
+        
+        double cycles = (double)counters->counts[PERF_HW_CYCLES];
+        double instructions = (double)counters->counts[PERF_HW_INSTRUCTIONS];
+        
+        if (cycles > 0.0) {
+            derived->ipc = instructions / cycles;
+        }
+        if (instructions > 0.0) {
+            derived->llc_mpki = 1000.0 * counters->counts[PERF_HW_LLC_MISSES] / instructions;
+            derived->branch_mpki = 1000.0 * counters->counts[PERF_HW_BRANCH_MISSES] / instructions;
+            derived->dtlb_mpki = 1000.0 * counters->counts[PERF_HW_DTLB_MISSES] / instructions;
+        }
+        if (counters->elapsed_ns > 0) {
+            // bytes per ns == GB/s
+            derived->est_bandwidth_gbps = (double)counters->counts[PERF_HW_LLC_MISSES] *
+                                          PERF_CACHE_LINE_BYTES / (double)counters->elapsed_ns;
+        }
+    }
+    
+    return 0;
+}
+
+const char* perf_operation_name(perf_operation_t op) {
+    switch (op) {
+        case PERF_OP_ENTROPY_COLLECTION: return "entropy_collection";
+        case PERF_OP_HEALTH_TEST:        return "health_test";
+        case PERF_OP_QUANTUM_MIXING:     return "quantum_mixing";
+        case PERF_OP_OUTPUT_GENERATION:  return "output_generation";
+        case PERF_OP_GATE_SINGLE_QUBIT:  return "gate_single_qubit";
+        case PERF_OP_GATE_TWO_QUBIT:     return "gate_two_qubit";
+        case PERF_OP_GATE_MULTI_QUBIT:   return "gate_multi_qubit";
+        case PERF_OP_MEASUREMENT:        return "measurement";
+        default:                         return "unknown";
+    }
+}
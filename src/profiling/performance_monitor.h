@@ -13,6 +13,9 @@
  * - Operation breakdowns
  * - Throughput measurement
  * - Latency distribution histograms
+ * - Optional hardware performance counters (Linux perf_event_open):
+ *   IPC, LLC / dTLB / branch misses and estimated memory bandwidth,
+ *   attributed per operation type
  */
 
 // ============================================================================
@@ -24,9 +27,52 @@ typedef enum {
     PERF_OP_HEALTH_TEST,
     PERF_OP_QUANTUM_MIXING,
     PERF_OP_OUTPUT_GENERATION,
+    PERF_OP_GATE_SINGLE_QUBIT,      /**< Single-qubit gate kernels (H, X, Ry, ...) */
+    PERF_OP_GATE_TWO_QUBIT,         /**< Two-qubit gate kernels (CNOT, CZ, ...) */
+    PERF_OP_GATE_MULTI_QUBIT,       /**< Multi-controlled / QFT / Grover diffusion */
+    PERF_OP_MEASUREMENT,            /**< Born-rule measurement sampling */
     PERF_OP_MAX
 } perf_operation_t;
 
+// ============================================================================
+// HARDWARE COUNTERS
+// ============================================================================
+
+/**
+ * @brief Hardware events read as one perf_event_open group
+ *
+ * The group is scheduled onto the PMU atomically, so all counters in a
+ * delta cover exactly the same instructions.
+ */
+typedef enum {
+    PERF_HW_CYCLES,
+    PERF_HW_INSTRUCTIONS,
+    PERF_HW_LLC_MISSES,
+    PERF_HW_BRANCH_MISSES,
+    PERF_HW_DTLB_MISSES,
+    PERF_HW_MAX
+} perf_hw_event_t;
+
+/**
+ * @brief Hardware counter totals attributed to one operation type
+ */
+typedef struct {
+    uint64_t counts[PERF_HW_MAX];   /**< Event totals (multiplex-scaled) */
+    uint64_t operations;            /**< Operations that contributed */
+    uint64_t elapsed_ns;            /**< Wall time covered by the counts */
+} perf_hw_counters_t;
+
+/**
+ * @brief Metrics derived from hardware counter totals
+ */
+typedef struct {
+    double ipc;                     /**< Instructions per cycle */
+    double llc_mpki;                /**< LLC misses per 1000 instructions */
+    double branch_mpki;             /**< Branch misses per 1000 instructions */
+    double dtlb_mpki;               /**< dTLB misses per 1000 instructions */
+    double est_bandwidth_gbps;      /**< LLC misses x line size / time (GB/s) */
+} perf_hw_derived_t;
+
 // ============================================================================
 // CONTEXT
 // ============================================================================
@@ -69,6 +115,16 @@ typedef struct {
     
     // CPU info
     double cpu_mhz;                 /**< CPU frequency in MHz */
+    
+    // Hardware counters (perf_event_open group, Linux only)
+    int hw_enabled;                 /**< 1 if the counter group is open */
+    int hw_error;                   /**< errno from the failed open (0 if none) */
+    int hw_paranoid;                /**< perf_event_paranoid at enable time (-99 unknown) */
+    int hw_fds[PERF_HW_MAX];        /**< Event fds (-1 = event not supported) */
+    long hw_tid;                    /**< Thread the group counts (the enabling thread) */
+    uint64_t hw_op_start[PERF_HW_MAX]; /**< Counter values at operation start */
+    uint64_t hw_op_start_ns;        /**< Monotonic time at operation start */
+    perf_hw_counters_t hw_by_op[PERF_OP_MAX]; /**< Per-operation counter totals */
 } perf_monitor_ctx_t;
 
 /**
@@ -175,4 +231,63 @@ void perf_monitor_print_stats(const perf_monitor_ctx_t *ctx);
  */
 double perf_monitor_get_overhead_percent(const perf_monitor_ctx_t *ctx);
 
+// ============================================================================
+// HARDWARE COUNTERS
+// ============================================================================
+
+/**
+ * @brief Open the hardware counter group for the calling thread
+ * 
+ * Counts user-space events only, so it works at perf_event_paranoid <= 2.
+ * When the kernel refuses (higher paranoid level, no PMU in a VM, non-Linux
+ * build) the monitor keeps working with cycle timing only and the print
+ * routine reports why counters are unavailable.
+ * 
+ * Counters follow the thread that enabled them; operations timed from
+ * other threads skip the counter read and are not attributed.
+ * 
+ * @param ctx Monitor context
+ * @return 0 if counters are active, -1 if unavailable
+ */
+int perf_monitor_enable_hw_counters(perf_monitor_ctx_t *ctx);
+
+/**
+ * @brief Close the hardware counter group
+ * 
+ * @param ctx Monitor context
+ */
+void perf_monitor_disable_hw_counters(perf_monitor_ctx_t *ctx);
+
+/**
+ * @brief Check whether hardware counters are active
+ * 
+ * @param ctx Monitor context
+ * @return 1 if active, 0 otherwise
+ */
+int perf_monitor_hw_available(const perf_monitor_ctx_t *ctx);
+
+/**
+ * @brief Get hardware counter totals for one operation type
+ * 
+ * @param ctx Monitor context
+ * @param op Operation type
+ * @param counters Output totals
+ * @param derived Output derived metrics (may be NULL)
+ * @return 0 on success, -1 if counters were never enabled or op is invalid
+ */
+int perf_monitor_get_hw_counters(
+    const perf_monitor_ctx_t *ctx,
+    perf_operation_t op,
+    perf_hw_counters_t *counters,
+    perf_hw_derived_t *derived
+);
+
+/**
+ * @brief Get operation type name
+ * 
+ * @param op Operation type
+ * @return Short name
+ */
+const char* perf_operation_name(perf_operation_t op);
+
 #endif /* PERFORMANCE_MONITOR_H */
\ No newline at end of file
@@ -0,0 +1,390 @@
+/**
+ * @file sobol.c
+ * @brief Scrambled Sobol sequence and Brownian bridge
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sobol.h"
+#include "../common/sha256.h"
+#include "../common/keyed_stream.h"
+
+#define SOBOL_BITS 32
+
+struct sobol_ctx {
+    uint32_t dimensions;
+    uint64_t index;          // Index of the next point
+    uint32_t *directions;    // [bit * dimensions + dim], scrambled
+    uint32_t *shift;         // Digital shift per dimension
+    uint32_t *state;         // Current point: shift ^ XOR of directions
+};
+
+struct sobol_bridge {
+    uint32_t steps;
+    uint32_t *bridge_index;  // Point filled at step i
+    uint32_t *left_index;    // Left neighbour + 1 (0 = the origin)
+    uint32_t *right_index;   // Right neighbour
+    double *left_weight;
+    double *right_weight;
+    double *std_dev;
+};
+
+// ============================================================================
+// DIRECTION NUMBERS
+// ============================================================================
+
+/*
+ * Unscrambled direction numbers V_k = m_k / 2^k as 32-bit fractions, from
+ * the recurrence m_k = 2^s m_{k-s} ^ m_{k-s} ^ sum_j 2^j a_j m_{k-j} of the
+ * dimension's primitive polynomial x^s + a_1 x^{s-1} + ... + a_{s-1} x + 1.
+ * Dimension 0 is the van der Corput sequence (all m_k = 1).
+ */
+static void fill_directions(uint32_t dim, const uint16_t *initial_m, uint32_t v[SOBOL_BITS]) {
+    if (dim == 0) {
+        for (int k = 0; k < SOBOL_BITS; k++) v[k] = 1u << (SOBOL_BITS - 1 - k);
+        return;
+    }
+
+    uint32_t poly = sobol_polynomials[dim - 1];
+    int s = 31 - __builtin_clz(poly);
+    uint32_t a = (poly >> 1) & ((1u << (s - 1)) - 1);
+
+    for (int k = 0; k < s && k < SOBOL_BITS; k++) {
+        v[k] = (uint32_t)initial_m[k] << (SOBOL_BITS - 1 - k);
+    }
+    for (int k = s; k < SOBOL_BITS; k++) {
+        v[k] = v[k - s] ^ (v[k - s] >> s);
+        for (int j = 1; j < s; j++) {
+            if ((a >> (s - 1 - j)) & 1) v[k] ^= v[k - j];
+        }
+    }
+}
+
+// ============================================================================
+// SCRAMBLING
+// ============================================================================
+
+/*
+ * Scrambling bits come from a keyed stream (keyed_stream.h) whose key is
+ * SHA-256 of the caller's key, so any key length works and the scramble is
+ * a deterministic function of the key.
+ */
+static uint32_t scramble_next(keyed_stream_t *rng) {
+    return (uint32_t)(keyed_stream_next(rng) >> 32);
+}
+
+static void scramble_seed(keyed_stream_t *rng, const uint8_t *key, size_t key_len) {
+    static const char label[] = "qrng-sobol-scramble";
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sha256_ctx_t sha;
+    sha256_init(&sha);
+    sha256_update(&sha, label, sizeof(label) - 1);
+    sha256_update(&sha, key, key_len);
+    sha256_final(&sha, digest);
+
+    uint64_t words[4];
+    for (int i = 0; i < 4; i++) {
+        uint64_t w = 0;
+        for (int b = 0; b < 8; b++) w |= (uint64_t)digest[8 * i + b] << (8 * b);
+        words[i] = w;
+    }
+    keyed_stream_seed(rng, words);
+    memset(words, 0, sizeof(words));
+    memset(digest, 0, sizeof(digest));
+}
+
+/*
+ * Linear matrix scrambling: v' = L v over GF(2), with L a random
+ * lower-triangular matrix with unit diagonal acting on the bits of v, most
+ * significant first. Output bit i depends on input bits 0..i, so the
+ * stratification of every dyadic interval is preserved.
+ */
+static void scramble_directions(keyed_stream_t *rng, uint32_t v[SOBOL_BITS]) {
+    uint32_t rows[SOBOL_BITS];
+    for (int i = 0; i < SOBOL_BITS; i++) {
+        uint32_t above = i ? ~0u << (SOBOL_BITS - i) : 0;
+        rows[i] = (scramble_next(rng) & above) | (1u << (SOBOL_BITS - 1 - i));
+    }
+    for (int k = 0; k < SOBOL_BITS; k++) {
+        uint32_t out = 0;
+        for (int i = 0; i < SOBOL_BITS; i++) {
+            out |= (uint32_t)(__builtin_popcount(rows[i] & v[k]) & 1) << (SOBOL_BITS - 1 - i);
+        }
+        v[k] = out;
+    }
+}
+
+// ============================================================================
+// SEQUENCE
+// ============================================================================
+
+sobol_error_t sobol_init(sobol_ctx_t **ctx, uint32_t dimensions,
+                         const uint8_t *key, size_t key_len) {
+    if (!ctx || (!key && key_len > 0)) return SOBOL_ERROR_NULL_POINTER;
+    *ctx = NULL;
+    if (dimensions == 0 || dimensions > SOBOL_MAX_DIMENSION) {
+        return SOBOL_ERROR_INVALID_DIMENSION;
+    }
+
+    sobol_ctx_t *c = calloc(1, sizeof(*c));
+    if (!c) return SOBOL_ERROR_NO_MEMORY;
+    c->dimensions = dimensions;
+    c->directions = malloc((size_t)SOBOL_BITS * dimensions * sizeof(uint32_t));
+    c->shift = calloc(dimensions, sizeof(uint32_t));
+    c->state = malloc(dimensions * sizeof(uint32_t));
+    if (!c->directions || !c->shift || !c->state) {
+        sobol_free(c);
+        return SOBOL_ERROR_NO_MEMORY;
+    }
+
+    int scrambled = key_len > 0;
+    keyed_stream_t rng;
+    if (scrambled) scramble_seed(&rng, key, key_len);
+
+    const uint16_t *initial_m = sobol_initial_m;
+    for (uint32_t d = 0; d < dimensions; d++) {
+        uint32_t v[SOBOL_BITS];
+        fill_directions(d, initial_m, v);
+        if (d > 0) initial_m += 31 - __builtin_clz(sobol_polynomials[d - 1]);
+
+        if (scrambled) {
+            scramble_directions(&rng, v);
+            c->shift[d] = scramble_next(&rng);
+        }
+        for (int k = 0; k < SOBOL_BITS; k++) {
+            c->directions[(size_t)k * dimensions + d] = v[k];
+        }
+        c->state[d] = c->shift[d];
+    }
+
+    memset(&rng, 0, sizeof(rng));
+    *ctx = c;
+    return SOBOL_SUCCESS;
+}
+
+sobol_error_t sobol_clone(const sobol_ctx_t *ctx, sobol_ctx_t **copy) {
+    if (!ctx || !copy) return SOBOL_ERROR_NULL_POINTER;
+    *copy = NULL;
+
+    uint32_t n = ctx->dimensions;
+    sobol_ctx_t *c = calloc(1, sizeof(*c));
+    if (!c) return SOBOL_ERROR_NO_MEMORY;
+    c->dimensions = n;
+    c->index = ctx->index;
+    c->directions = malloc((size_t)SOBOL_BITS * n * sizeof(uint32_t));
+    c->shift = malloc(n * sizeof(uint32_t));
+    c->state = malloc(n * sizeof(uint32_t));
+    if (!c->directions || !c->shift || !c->state) {
+        sobol_free(c);
+        return SOBOL_ERROR_NO_MEMORY;
+    }
+    memcpy(c->directions, ctx->directions, (size_t)SOBOL_BITS * n * sizeof(uint32_t));
+    memcpy(c->shift, ctx->shift, n * sizeof(uint32_t));
+    memcpy(c->state, ctx->state, n * sizeof(uint32_t));
+
+    *copy = c;
+    return SOBOL_SUCCESS;
+}
+
+void sobol_free(sobol_ctx_t *ctx) {
+    if (!ctx) return;
+    free(ctx->directions);
+    free(ctx->shift);
+    free(ctx->state);
+    free(ctx);
+}
+
+sobol_error_t sobol_skip_to(sobol_ctx_t *ctx, uint64_t index) {
+    if (!ctx) return SOBOL_ERROR_NULL_POINTER;
+    if (index >> SOBOL_BITS) return SOBOL_ERROR_EXHAUSTED;
+
+    uint32_t n = ctx->dimensions;
+    uint32_t gray = (uint32_t)(index ^ (index >> 1));
+    memcpy(ctx->state, ctx->shift, n * sizeof(uint32_t));
+    for (int k = 0; gray; k++, gray >>= 1) {
+        if (!(gray & 1)) continue;
+        const uint32_t *v = ctx->directions + (size_t)k * n;
+        for (uint32_t d = 0; d < n; d++) ctx->state[d] ^= v[d];
+    }
+    ctx->index = index;
+    return SOBOL_SUCCESS;
+}
+
+sobol_error_t sobol_next(sobol_ctx_t *ctx, double *point) {
+    if (!ctx || !point) return SOBOL_ERROR_NULL_POINTER;
+    if (ctx->index >> SOBOL_BITS) return SOBOL_ERROR_EXHAUSTED;
+
+    uint32_t n = ctx->dimensions;
+    for (uint32_t d = 0; d < n; d++) {
+        point[d] = ((double)ctx->state[d] + 0.5) * (1.0 / 4294967296.0);
+    }
+
+    // Gray-code step: point i+1 differs from point i by the direction of
+    // the lowest zero bit of i
+    int c = __builtin_ctzll(~ctx->index);
+    if (c < SOBOL_BITS) {
+        const uint32_t *v = ctx->directions + (size_t)c * n;
+        for (uint32_t d = 0; d < n; d++) ctx->state[d] ^= v[d];
+    }
+    ctx->index++;
+    return SOBOL_SUCCESS;
+}
+
+sobol_error_t sobol_next_normal(sobol_ctx_t *ctx, double *z) {
+    sobol_error_t err = sobol_next(ctx, z);
+    if (err != SOBOL_SUCCESS) return err;
+    for (uint32_t d = 0; d < ctx->dimensions; d++) z[d] = sobol_inverse_normal(z[d]);
+    return SOBOL_SUCCESS;
+}
+
+uint64_t sobol_index(const sobol_ctx_t *ctx) {
+    return ctx ? ctx->index : 0;
+}
+
+uint32_t sobol_dimensions(const sobol_ctx_t *ctx) {
+    return ctx ? ctx->dimensions : 0;
+}
+
+double sobol_inverse_normal(double u) {
+    static const double a[6] = {
+        -3.969683028665376e+01,  2.209460984245205e+02, -2.759285104469687e+02,
+         1.383577518672690e+02, -3.066479806614716e+01,  2.506628277459239e+00 };
+    static const double b[5] = {
+        -5.447609879822406e+01,  1.615858368580409e+02, -1.556989798598866e+02,
+         6.680131188771972e+01, -1.328068155288572e+01 };
+    static const double c[6] = {
+        -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+        -2.549732539343734e+00,  4.374664141464968e+00,  2.938163982698783e+00 };
+    static const double d[4] = {
+         7.784695709041462e-03,  3.224671290700398e-01,  2.445134137142996e+00,
+         3.754408661907416e+00 };
+    const double u_low = 0.02425;
+
+    double x;
+    if (u < u_low) {
+        double q = sqrt(-2.0 * log(u));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    } else if (u <= 1.0 - u_low) {
+        double q = u - 0.5;
+        double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    } else {
+        double q = sqrt(-2.0 * log(1.0 - u));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+             ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+
+    // One Halley step on Phi(x) - u
+    double e = 0.5 * erfc(-x * M_SQRT1_2) - u;
+    double g = e * sqrt(2.0 * M_PI) * exp(0.5 * x * x);
+    return x - g / (1.0 + 0.5 * x * g);
+}
+
+// ============================================================================
+// BROWNIAN BRIDGE
+// ============================================================================
+
+/*
+ * Bridge order (Jaeckel, "Monte Carlo Methods in Finance"): the first
+ * variate fixes the last point, and each later one fills the middle of the
+ * widest remaining gap, conditioned on its two neighbours:
+ *   W(l) = wl W(left) + wr W(right) + sd z.
+ */
+sobol_error_t sobol_bridge_init(sobol_bridge_t **bridge, uint32_t steps) {
+    if (!bridge) return SOBOL_ERROR_NULL_POINTER;
+    *bridge = NULL;
+    if (steps == 0) return SOBOL_ERROR_INVALID_DIMENSION;
+
+    sobol_bridge_t *b = calloc(1, sizeof(*b));
+    uint32_t *map = calloc(steps, sizeof(uint32_t));
+    if (!b || !map) {
+        free(b);
+        free(map);
+        return SOBOL_ERROR_NO_MEMORY;
+    }
+    b->steps = steps;
+    b->bridge_index = malloc(steps * sizeof(uint32_t));
+    b->left_index = malloc(steps * sizeof(uint32_t));
+    b->right_index = malloc(steps * sizeof(uint32_t));
+    b->left_weight = malloc(steps * sizeof(double));
+    b->right_weight = malloc(steps * sizeof(double));
+    b->std_dev = malloc(steps * sizeof(double));
+    if (!b->bridge_index || !b->left_index || !b->right_index || !b->left_weight ||
+        !b->right_weight || !b->std_dev) {
+        free(map);
+        sobol_bridge_free(b);
+        return SOBOL_ERROR_NO_MEMORY;
+    }
+
+    map[steps - 1] = 1;
+    b->bridge_index[0] = steps - 1;
+    b->left_index[0] = 0;
+    b->right_index[0] = 0;
+    b->left_weight[0] = 0.0;
+    b->right_weight[0] = 0.0;
+    b->std_dev[0] = sqrt((double)steps);
+
+    for (uint32_t i = 1, j = 0; i < steps; i++) {
+        while (map[j]) j++;          // First unfilled point
+        uint32_t k = j;
+        while (!map[k]) k++;         // Next filled point
+        uint32_t l = j + ((k - 1 - j) >> 1);
+        map[l] = i;
+
+        b->bridge_index[i] = l;
+        b->left_index[i] = j;
+        b->right_index[i] = k;
+        b->left_weight[i] = (double)(k - l) / (k + 1 - j);
+        b->right_weight[i] = (double)(l + 1 - j) / (k + 1 - j);
+        b->std_dev[i] = sqrt((double)(l + 1 - j) * (k - l) / (k + 1 - j));
+
+        j = k + 1;
+        if (j >= steps) j = 0;
+    }
+
+    free(map);
+    *bridge = b;
+    return SOBOL_SUCCESS;
+}
+
+void sobol_bridge_free(sobol_bridge_t *bridge) {
+    if (!bridge) return;
+    free(bridge->bridge_index);
+    free(bridge->left_index);
+    free(bridge->right_index);
+    free(bridge->left_weight);
+    free(bridge->right_weight);
+    free(bridge->std_dev);
+    free(bridge);
+}
+
+void sobol_bridge_transform(const sobol_bridge_t *bridge, const double *z, double *dw) {
+    uint32_t n = bridge->steps;
+    double *w = dw;   // Build W(1..n) in place, then difference it
+
+    w[n - 1] = bridge->std_dev[0] * z[0];
+    for (uint32_t i = 1; i < n; i++) {
+        uint32_t j = bridge->left_index[i];
+        uint32_t k = bridge->right_index[i];
+        uint32_t l = bridge->bridge_index[i];
+        double left = j ? w[j - 1] : 0.0;
+        w[l] = bridge->left_weight[i] * left + bridge->right_weight[i] * w[k] +
+               bridge->std_dev[i] * z[i];
+    }
+
+    for (uint32_t i = n - 1; i > 0; i--) dw[i] = w[i] - w[i - 1];
+}
+
+const char* sobol_error_string(sobol_error_t error) {
+    switch (error) {
+        case SOBOL_SUCCESS: return "Success";
+        case SOBOL_ERROR_NULL_POINTER: return "NULL pointer";
+        case SOBOL_ERROR_INVALID_DIMENSION: return "Dimension out of range";
+        case SOBOL_ERROR_NO_MEMORY: return "Out of memory";
+        case SOBOL_ERROR_EXHAUSTED: return "Sequence exhausted (2^32 points)";
+        default: return "Unknown error";
+    }
+}
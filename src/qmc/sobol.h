@@ -0,0 +1,124 @@
+#ifndef SOBOL_H
+#define SOBOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sobol_directions.h"
+
+/**
+ * @file sobol.h
+ * @brief Scrambled Sobol low-discrepancy sequence and Brownian bridge
+ *
+ * Quasi-Monte Carlo replaces pseudo-random points with a low-discrepancy
+ * sequence. Its integration error falls close to O(N^-1) for smooth
+ * integrands, where pseudo-random sampling gives O(N^-1/2).
+ *
+ * - Direction numbers are Joe and Kuo's (new-joe-kuo-6.21201), for up to
+ *   SOBOL_MAX_DIMENSION dimensions, with 32-bit resolution (2^32 points).
+ * - Points are generated in Gray-code order. Each point costs one XOR per
+ *   dimension, and sobol_skip_to() jumps straight to any index, so threads
+ *   can split an index range.
+ * - Scrambling is Matousek's linear matrix scrambling plus a random digital
+ *   shift, derived from a caller-supplied key. Fill the key from
+ *   secure_rng_bytes() or qrng_v3_bytes() for a fresh randomization, or from
+ *   a seeded generator for a reproducible one. Scrambled points keep the
+ *   net structure, and each point is uniform on (0,1)^d, so estimates are
+ *   unbiased. Independent keys give independent replicates for error bars.
+ * - Point coordinates are (x + 0.5) / 2^32, strictly inside (0,1), so they
+ *   can be fed to sobol_inverse_normal() without clamping.
+ *
+ * The Brownian bridge turns one point of standard normals into the
+ * increments of a Brownian path, with the first coordinates fixing the
+ * terminal value and the coarse shape. This concentrates the path's
+ * variance in the best-distributed leading dimensions.
+ */
+
+// ============================================================================
+// ERROR CODES
+// ============================================================================
+
+typedef enum {
+    SOBOL_SUCCESS = 0,                  /**< Operation successful */
+    SOBOL_ERROR_NULL_POINTER = -1,      /**< NULL argument */
+    SOBOL_ERROR_INVALID_DIMENSION = -2, /**< Dimension 0 or above SOBOL_MAX_DIMENSION */
+    SOBOL_ERROR_NO_MEMORY = -3,         /**< Allocation failed */
+    SOBOL_ERROR_EXHAUSTED = -4          /**< Index beyond 2^32 points */
+} sobol_error_t;
+
+typedef struct sobol_ctx sobol_ctx_t;
+typedef struct sobol_bridge sobol_bridge_t;
+
+// ============================================================================
+// SEQUENCE
+// ============================================================================
+
+/**
+ * @brief Create a generator positioned at index 0
+ *
+ * @param ctx Output generator
+ * @param dimensions Coordinates per point (1..SOBOL_MAX_DIMENSION)
+ * @param key Scrambling key (NULL with key_len 0 for the plain sequence)
+ * @param key_len Key length in bytes
+ */
+sobol_error_t sobol_init(sobol_ctx_t **ctx, uint32_t dimensions,
+                         const uint8_t *key, size_t key_len);
+
+/**
+ * @brief Copy a generator (tables and position) for use on another thread
+ */
+sobol_error_t sobol_clone(const sobol_ctx_t *ctx, sobol_ctx_t **copy);
+
+void sobol_free(sobol_ctx_t *ctx);
+
+/**
+ * @brief Position the generator so the next point is point index
+ *
+ * O(dimensions * 32): the state is rebuilt from the Gray code of index.
+ */
+sobol_error_t sobol_skip_to(sobol_ctx_t *ctx, uint64_t index);
+
+/**
+ * @brief Write the next point's coordinates, each in (0,1), to point
+ */
+sobol_error_t sobol_next(sobol_ctx_t *ctx, double *point);
+
+/**
+ * @brief Next point mapped through sobol_inverse_normal()
+ */
+sobol_error_t sobol_next_normal(sobol_ctx_t *ctx, double *z);
+
+uint64_t sobol_index(const sobol_ctx_t *ctx);
+uint32_t sobol_dimensions(const sobol_ctx_t *ctx);
+
+/**
+ * @brief Inverse standard normal CDF for u in (0,1)
+ *
+ * Acklam's rational approximation refined with one Halley step (relative
+ * error below 1e-14).
+ */
+double sobol_inverse_normal(double u);
+
+// ============================================================================
+// BROWNIAN BRIDGE
+// ============================================================================
+
+/**
+ * @brief Precompute the bridge order for steps unit time steps
+ */
+sobol_error_t sobol_bridge_init(sobol_bridge_t **bridge, uint32_t steps);
+
+void sobol_bridge_free(sobol_bridge_t *bridge);
+
+/**
+ * @brief Map steps standard normals to steps Brownian increments
+ *
+ * z[0] sets W(steps), z[1] the midpoint, and so on by bisection. The
+ * increments dw[i] = W(i+1) - W(i) have the same joint law as z (iid
+ * N(0,1)), so they drop in wherever per-step normals are used. z and dw
+ * may not alias. The bridge is read-only here and may be shared by threads.
+ */
+void sobol_bridge_transform(const sobol_bridge_t *bridge, const double *z, double *dw);
+
+const char* sobol_error_string(sobol_error_t error);
+
+#endif /* SOBOL_H */
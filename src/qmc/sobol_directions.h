@@ -0,0 +1,17 @@
+#ifndef SOBOL_DIRECTIONS_H
+#define SOBOL_DIRECTIONS_H
+
+#include <stdint.h>
+
+/**
+ * @file sobol_directions.h
+ * @brief Joe-Kuo direction-number tables used by sobol.c (internal)
+ */
+
+#define SOBOL_MAX_DIMENSION 3667     /**< Dimensions covered by the table */
+#define SOBOL_INITIAL_M_COUNT 50807  /**< Sum of the polynomial degrees */
+
+extern const uint16_t sobol_polynomials[SOBOL_MAX_DIMENSION - 1];
+extern const uint16_t sobol_initial_m[SOBOL_INITIAL_M_COUNT];
+
+#endif /* SOBOL_DIRECTIONS_H */
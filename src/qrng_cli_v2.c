@@ -10,16 +10,26 @@
  * - Entropy source information
  * - Multiple output formats (hex, binary, base64)
  * - Batch generation
+ * - Multi-threaded ordered generation for large outputs (--threads)
+ * - Rate-controlled streaming with jitter statistics (--rate)
  * - Interactive and command-line modes
  */
 
 #include "secure_rng/secure_rng.h"
+#include "common/secure_memory.h"
+#include "secure_rng/paced_stream.h"
+#include "quantum_rng/simd_ops.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <getopt.h>
 #include <time.h>
 #include <unistd.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <errno.h>
+#include <ctype.h>
 
 // ============================================================================
 // CONSTANTS
@@ -27,7 +37,10 @@
 
 #define VERSION "2.0.0"
 #define DEFAULT_OUTPUT_SIZE 32
-#define MAX_OUTPUT_SIZE (1024 * 1024 * 100)  // 100MB max
+#define MAX_OUTPUT_SIZE (1024 * 1024 * 100)  // 100MB max (single-threaded)
+#define MAX_THREADS 256
+#define PARALLEL_BLOCK_SIZE (768 * 1024)     // Multiple of 3: no base64 padding mid-stream
+#define REORDER_SLOTS_PER_THREAD 2
 
 // ============================================================================
 // OUTPUT FORMATS
@@ -40,42 +53,81 @@ typedef enum {
     OUTPUT_FORMAT_DEC
 } output_format_t;
 
-static void print_hex(const uint8_t *data, size_t size) {
+static size_t encode_decimal(const uint8_t *data, size_t size, char *out) {
+    size_t o = 0;
     for (size_t i = 0; i < size; i++) {
-        printf("%02x", data[i]);
+        uint8_t v = data[i];
+        if (v >= 100) out[o++] = (char)('0' + v / 100);
+        if (v >= 10) out[o++] = (char)('0' + (v / 10) % 10);
+        out[o++] = (char)('0' + v % 10);
+        if (i < size - 1) out[o++] = ' ';
     }
-    printf("\n");
+    return o;
 }
 
-static void print_binary(const uint8_t *data, size_t size) {
-    if (fwrite(data, 1, size, stdout) != size) {
-        fprintf(stderr, "Warning: Not all bytes written\n");
+/**
+ * @brief Worst-case encoded size of one piece, including separators
+ */
+static size_t encoded_capacity(output_format_t format, size_t size) {
+    switch (format) {
+        case OUTPUT_FORMAT_HEX:    return 2 * size + 1;
+        case OUTPUT_FORMAT_BASE64: return 4 * ((size + 2) / 3) + 1;
+        case OUTPUT_FORMAT_DEC:    return 4 * size + 2;
+        default:                   return 0;
     }
 }
 
-static const char base64_chars[] = 
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-static void print_base64(const uint8_t *data, size_t size) {
-    for (size_t i = 0; i < size; i += 3) {
-        uint32_t n = ((uint32_t)data[i]) << 16;
-        if (i + 1 < size) n |= ((uint32_t)data[i + 1]) << 8;
-        if (i + 2 < size) n |= data[i + 2];
-        
-        printf("%c", base64_chars[(n >> 18) & 0x3F]);
-        printf("%c", base64_chars[(n >> 12) & 0x3F]);
-        printf("%c", (i + 1 < size) ? base64_chars[(n >> 6) & 0x3F] : '=');
-        printf("%c", (i + 2 < size) ? base64_chars[n & 0x3F] : '=');
+/**
+ * @brief Encode one piece of a longer output
+ *
+ * Concatenating the pieces of an output (first..last) gives exactly what
+ * encoding it in one go would: the decimal separator goes before every
+ * piece but the first, and the newline after the last. Every piece but the
+ * last must be a multiple of 3 bytes so base64 padding only ends the line.
+ */
+static size_t encode_piece(output_format_t format, const uint8_t *data, size_t size,
+                           char *out, int first, int last) {
+    size_t o = 0;
+    switch (format) {
+        case OUTPUT_FORMAT_HEX:
+            o = simd_encode_hex(data, size, out);
+            break;
+        case OUTPUT_FORMAT_BASE64:
+            o = simd_encode_base64(data, size, out);
+            break;
+        case OUTPUT_FORMAT_DEC:
+            if (!first && size > 0) out[o++] = ' ';
+            o += encode_decimal(data, size, out + o);
+            break;
+        default:
+            return 0;
     }
-    printf("\n");
+    if (last) out[o++] = '\n';
+    return o;
 }
 
-static void print_decimal(const uint8_t *data, size_t size) {
-    for (size_t i = 0; i < size; i++) {
-        printf("%u", data[i]);
-        if (i < size - 1) printf(" ");
+// Text formats are encoded and written this many input bytes at a time
+#define FORMAT_CHUNK (3 * 4096)
+
+static void print_formatted(output_format_t format, const uint8_t *data, size_t size) {
+    if (format == OUTPUT_FORMAT_BINARY) {
+        if (fwrite(data, 1, size, stdout) != size) {
+            fprintf(stderr, "Warning: Not all bytes written\n");
+        }
+        return;
     }
-    printf("\n");
+    
+    static char text[4 * FORMAT_CHUNK + 2];
+    size_t pos = 0;
+    do {
+        size_t n = size - pos < FORMAT_CHUNK ? size - pos : FORMAT_CHUNK;
+        size_t len = encode_piece(format, data + pos, n, text, pos == 0, pos + n == size);
+        if (fwrite(text, 1, len, stdout) != len) {
+            fprintf(stderr, "Warning: Not all bytes written\n");
+            return;
+        }
+        pos += n;
+    } while (pos < size);
 }
 
 // ============================================================================
@@ -90,6 +142,8 @@ typedef struct {
     // Mode options
     secure_rng_mode_t mode;
     int thread_safe;
+    int threads;                 // Parallel generator threads (0 = single-threaded)
+    double rate;                 // Paced output in bytes/s (0 = as fast as possible)
     
     // Configuration options
     double min_entropy;
@@ -115,6 +169,9 @@ static void print_usage(const char *program_name) {
     printf("  -n, --bytes=N          Generate N random bytes (default: %d)\n", DEFAULT_OUTPUT_SIZE);
     printf("  -f, --format=FMT       Output format: hex, binary, base64, dec (default: hex)\n");
     printf("  -c, --continuous       Continuous generation (until Ctrl+C)\n");
+    printf("  -j, --threads=N        Generate and encode in N threads, output in order\n");
+    printf("                         (streams; lifts the %d MB -n limit)\n", MAX_OUTPUT_SIZE / (1024 * 1024));
+    printf("  -R, --rate=RATE        Pace output at RATE bytes/s (suffix K, M, G; streams)\n");
     
     printf("\nMode Options:\n");
     printf("  -m, --mode=MODE        Operation mode:\n");
@@ -146,6 +203,8 @@ static void print_usage(const char *program_name) {
     printf("  %s -m fast -n 1000000 -b         # Benchmark FAST mode\n", program_name);
     printf("  %s -m quantum -t -s              # Thread-safe quantum mode with stats\n", program_name);
     printf("  %s -m hybrid -c                  # Continuous adaptive mode\n", program_name);
+    printf("  %s -j 8 -n 10000000000 -f binary > corpus.bin  # 10 GB on 8 cores\n", program_name);
+    printf("  %s -c -R 2M -f binary -s | nc rig 9000    # Steady 2 MB/s feed\n", program_name);
     
     printf("\nSecurity Considerations:\n");
     printf("  - All entropy is health-tested per NIST SP 800-90B\n");
@@ -173,6 +232,236 @@ static void print_version(void) {
     printf("License: MIT\n");
 }
 
+// ============================================================================
+// PARALLEL GENERATION
+// ============================================================================
+
+/*
+ * Output is split into PARALLEL_BLOCK_SIZE blocks. Each worker owns a
+ * secure_rng context, claims the next block number, generates and encodes
+ * it into a reorder slot, and the main thread writes slots strictly in block
+ * order. A worker may only run REORDER_SLOTS_PER_THREAD * threads blocks
+ * ahead of the writer, so memory stays bounded however large -n is.
+ */
+
+typedef struct {
+    uint8_t *raw;                /**< Generated block */
+    char *text;                  /**< Encoded block (text formats) */
+    size_t size;                 /**< Random bytes in the block */
+    size_t len;                  /**< Bytes to write */
+    int ready;                   /**< Filled and waiting for the writer */
+} reorder_slot_t;
+
+typedef struct {
+    output_format_t format;
+    uint64_t total_bytes;        /**< UINT64_MAX for continuous output */
+    uint64_t num_blocks;
+    int continuous;              /**< One line per block instead of one line total */
+    
+    reorder_slot_t *slots;
+    size_t num_slots;
+    
+    pthread_mutex_t mutex;
+    pthread_cond_t slot_ready;   /**< Writer waits for the next block */
+    pthread_cond_t slot_free;    /**< Workers wait for reorder room */
+    uint64_t next_block;         /**< Next block number to claim */
+    uint64_t next_write;         /**< Next block number to write */
+    int stop;                    /**< Set on error or when the writer finishes */
+    secure_rng_error_t error;
+} parallel_job_t;
+
+typedef struct {
+    parallel_job_t *job;
+    secure_rng_ctx_t *ctx;
+} parallel_worker_t;
+
+static void* parallel_worker_main(void *arg) {
+    parallel_worker_t *worker = (parallel_worker_t *)arg;
+    parallel_job_t *job = worker->job;
+    
+    while (1) {
+        pthread_mutex_lock(&job->mutex);
+        while (!job->stop && job->next_block < job->num_blocks &&
+               job->next_block >= job->next_write + job->num_slots) {
+            pthread_cond_wait(&job->slot_free, &job->mutex);
+        }
+        if (job->stop || job->next_block >= job->num_blocks) {
+            pthread_mutex_unlock(&job->mutex);
+            break;
+        }
+        uint64_t block = job->next_block++;
+        pthread_mutex_unlock(&job->mutex);
+        
+        reorder_slot_t *slot = &job->slots[block % job->num_slots];
+        uint64_t offset = block * PARALLEL_BLOCK_SIZE;
+        size_t size = PARALLEL_BLOCK_SIZE;
+        if (job->total_bytes - offset < size) {
+            size = (size_t)(job->total_bytes - offset);
+        }
+        
+        secure_rng_error_t err = secure_rng_bytes(worker->ctx, slot->raw, size);
+        if (err == SECURE_RNG_SUCCESS) {
+            slot->size = size;
+            if (job->format == OUTPUT_FORMAT_BINARY) {
+                slot->len = size;
+            } else {
+                int first = job->continuous || block == 0;
+                int last = job->continuous || block == job->num_blocks - 1;
+                slot->len = encode_piece(job->format, slot->raw, size, slot->text, first, last);
+            }
+        }
+        
+        pthread_mutex_lock(&job->mutex);
+        if (err != SECURE_RNG_SUCCESS) {
+            job->error = err;
+            job->stop = 1;
+            pthread_cond_broadcast(&job->slot_free);
+        }
+        slot->ready = 1;
+        pthread_cond_signal(&job->slot_ready);
+        pthread_mutex_unlock(&job->mutex);
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief Generate and write output with multiple threads, in order
+ *
+ * Nothing is written unless every worker thread starts.
+ *
+ * @param ctx Context for the first worker (others create their own)
+ * @param config Configuration for the additional worker contexts
+ * @param bytes_written Random bytes written to stdout
+ * @return SECURE_RNG_SUCCESS or the first worker error
+ */
+static secure_rng_error_t generate_parallel(
+    secure_rng_ctx_t *ctx,
+    const secure_rng_config_t *config,
+    const cli_options_t *opts,
+    uint64_t *bytes_written
+) {
+    *bytes_written = 0;
+    int threads = opts->threads;
+    parallel_job_t job = {
+        .format = opts->format,
+        .total_bytes = opts->continuous ? UINT64_MAX : opts->num_bytes,
+        .continuous = opts->continuous,
+        .num_slots = (size_t)threads * REORDER_SLOTS_PER_THREAD,
+        .error = SECURE_RNG_SUCCESS
+    };
+    job.num_blocks = opts->continuous ? UINT64_MAX :
+                     (opts->num_bytes + PARALLEL_BLOCK_SIZE - 1) / PARALLEL_BLOCK_SIZE;
+    if (job.num_blocks == 0) {
+        print_formatted(opts->format, NULL, 0);
+        return SECURE_RNG_SUCCESS;
+    }
+    
+    secure_rng_error_t result = SECURE_RNG_SUCCESS;
+    parallel_worker_t workers[MAX_THREADS] = {{0}};
+    pthread_t tids[MAX_THREADS];
+    int started = 0;
+    
+    job.slots = calloc(job.num_slots, sizeof(reorder_slot_t));
+    if (!job.slots) return SECURE_RNG_ERROR_INITIALIZATION;
+    
+    size_t text_capacity = encoded_capacity(opts->format, PARALLEL_BLOCK_SIZE);
+    for (size_t i = 0; i < job.num_slots; i++) {
+        job.slots[i].raw = malloc(PARALLEL_BLOCK_SIZE);
+        job.slots[i].text = text_capacity ? malloc(text_capacity) : NULL;
+        if (!job.slots[i].raw || (text_capacity && !job.slots[i].text)) {
+            result = SECURE_RNG_ERROR_INITIALIZATION;
+            goto cleanup;
+        }
+    }
+    
+    // Worker contexts: the caller's context plus one fresh context each
+    for (int t = 0; t < threads; t++) {
+        workers[t].job = &job;
+        if (t == 0) {
+            workers[t].ctx = ctx;
+        } else {
+            result = secure_rng_init_with_config(&workers[t].ctx, config);
+            if (result != SECURE_RNG_SUCCESS) goto cleanup;
+        }
+    }
+    
+    pthread_mutex_init(&job.mutex, NULL);
+    pthread_cond_init(&job.slot_ready, NULL);
+    pthread_cond_init(&job.slot_free, NULL);
+    
+    for (; started < threads; started++) {
+        if (pthread_create(&tids[started], NULL, parallel_worker_main, &workers[started]) != 0) {
+            result = SECURE_RNG_ERROR_INITIALIZATION;
+            break;
+        }
+    }
+    
+    // Writer: drain slots in block order, once the whole pool is running
+    if (started == threads) {
+        for (uint64_t block = 0; block < job.num_blocks; block++) {
+            reorder_slot_t *slot = &job.slots[block % job.num_slots];
+            
+            pthread_mutex_lock(&job.mutex);
+            while (!slot->ready && !job.stop) {
+                pthread_cond_wait(&job.slot_ready, &job.mutex);
+            }
+            int write_it = slot->ready && !job.stop;
+            pthread_mutex_unlock(&job.mutex);
+            if (!write_it) break;
+            
+            const void *data = opts->format == OUTPUT_FORMAT_BINARY ?
+                               (const void *)slot->raw : (const void *)slot->text;
+            if (fwrite(data, 1, slot->len, stdout) != slot->len) {
+                fprintf(stderr, "Warning: Not all bytes written\n");
+                break;
+            }
+            *bytes_written += slot->size;
+            
+            pthread_mutex_lock(&job.mutex);
+            slot->ready = 0;
+            job.next_write++;
+            pthread_cond_broadcast(&job.slot_free);
+            pthread_mutex_unlock(&job.mutex);
+        }
+    }
+    
+    // Release any worker still waiting for room
+    pthread_mutex_lock(&job.mutex);
+    job.stop = 1;
+    pthread_cond_broadcast(&job.slot_free);
+    pthread_mutex_unlock(&job.mutex);
+    
+    for (int t = 0; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    if (result == SECURE_RNG_SUCCESS) {
+        result = job.error;
+    }
+    
+    pthread_cond_destroy(&job.slot_free);
+    pthread_cond_destroy(&job.slot_ready);
+    pthread_mutex_destroy(&job.mutex);
+    
+cleanup:
+    for (int t = 1; t < threads; t++) {
+        if (workers[t].ctx) secure_rng_free(workers[t].ctx);
+    }
+    for (size_t i = 0; i < job.num_slots; i++) {
+        if (job.slots[i].raw) {
+            secure_memzero(job.slots[i].raw, PARALLEL_BLOCK_SIZE);
+            free(job.slots[i].raw);
+        }
+        if (job.slots[i].text) {
+            secure_memzero(job.slots[i].text, text_capacity);
+            free(job.slots[i].text);
+        }
+    }
+    free(job.slots);
+    
+    return result;
+}
+
 // ============================================================================
 // BENCHMARKING
 // ============================================================================
@@ -256,6 +545,130 @@ static void run_mode_comparison(secure_rng_ctx_t *ctx) {
     printf("\n");
 }
 
+// ============================================================================
+// PACED STREAMING
+// ============================================================================
+
+static paced_stream_t *g_paced_stream = NULL;
+
+static void paced_stop_signal(int sig) {
+    (void)sig;
+    paced_stream_stop(g_paced_stream);
+}
+
+/**
+ * @brief Parse "500", "64K", "2.5M" or "1G" (binary multiples) as bytes/s
+ */
+static int parse_rate(const char *text, double *rate) {
+    char *end;
+    double value = strtod(text, &end);
+    switch (*end) {
+        case 'k': case 'K': value *= 1024.0; end++; break;
+        case 'm': case 'M': value *= 1024.0 * 1024.0; end++; break;
+        case 'g': case 'G': value *= 1024.0 * 1024.0 * 1024.0; end++; break;
+        default: break;
+    }
+    if (end == text || !(value > 0)) return -1;
+    if (*end == 'B' || *end == 'b') end++;
+    if (strcmp(end, "") != 0 && strcmp(end, "/s") != 0) return -1;
+    *rate = value;
+    return 0;
+}
+
+/**
+ * @brief Parse a positive decimal byte count; no sign, no trailing text
+ */
+static int parse_byte_count(const char *text, size_t *count) {
+    char *end;
+    if (!isdigit((unsigned char)text[0])) return -1;   // strtoull accepts "-5" and " 5"
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (errno == ERANGE || *end != '\0' || value == 0 || value > SIZE_MAX) return -1;
+    *count = (size_t)value;
+    return 0;
+}
+
+static int paced_sink(void *user_data, const uint8_t *data, size_t size) {
+    const cli_options_t *opts = user_data;
+    print_formatted(opts->format, data, size);
+    return (fflush(stdout) == 0 && !ferror(stdout)) ? 0 : -1;
+}
+
+static void print_paced_line(const paced_stream_stats_t *st) {
+    fprintf(stderr, "[rate] %8.3f MB/s  jitter mean %6.1f us  max %7.1f us  "
+            "behind %llu  underruns %llu\n",
+            st->achieved_rate / (1024.0 * 1024.0), st->jitter_mean_ns / 1e3,
+            st->jitter_max_ns / 1e3, (unsigned long long)st->behind_events,
+            (unsigned long long)st->underruns);
+}
+
+static void paced_report(void *user_data, const paced_stream_stats_t *stats) {
+    (void)user_data;
+    print_paced_line(stats);
+}
+
+/**
+ * @brief Stream -n bytes (or until Ctrl+C with -c) at opts->rate
+ */
+static int run_paced(secure_rng_ctx_t *ctx, const cli_options_t *opts) {
+    paced_stream_config_t config;
+    paced_stream_get_default_config(&config);
+    config.rate = opts->rate;
+    config.total_bytes = opts->continuous ? 0 : opts->num_bytes;
+    if (opts->show_stats) config.report_interval_ns = 1000000000ULL;
+
+    paced_stream_error_t err = paced_stream_create(&g_paced_stream, &config,
+                                                   paced_stream_secure_rng_source, ctx,
+                                                   paced_sink, (void *)opts);
+    if (err != PACED_STREAM_SUCCESS) {
+        fprintf(stderr, "Error: %s\n", paced_stream_error_string(err));
+        return 1;
+    }
+    paced_stream_set_report(g_paced_stream, paced_report, NULL);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = paced_stop_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    if (!opts->quiet) {
+        fprintf(stderr, "Streaming at %.3f MB/s%s...\n", opts->rate / (1024.0 * 1024.0),
+                opts->continuous ? " (Ctrl+C to stop)" : "");
+    }
+    err = paced_stream_run(g_paced_stream);
+
+    paced_stream_stats_t stats;
+    paced_stream_get_stats(g_paced_stream, &stats);
+    if (opts->show_stats) {
+        fprintf(stderr, "\n=== Paced Stream Statistics ===\n");
+        fprintf(stderr, "Target rate:     %.3f MB/s\n", opts->rate / (1024.0 * 1024.0));
+        fprintf(stderr, "Achieved rate:   %.3f MB/s\n", stats.achieved_rate / (1024.0 * 1024.0));
+        fprintf(stderr, "Bytes emitted:   %llu in %.3f s\n",
+                (unsigned long long)stats.bytes_emitted, stats.elapsed_s);
+        fprintf(stderr, "Wake jitter:     mean %.1f us, stddev %.1f us, max %.1f us\n",
+                stats.jitter_mean_ns / 1e3, stats.jitter_stddev_ns / 1e3, stats.jitter_max_ns / 1e3);
+        fprintf(stderr, "Ticks:           %llu (%llu missed)\n",
+                (unsigned long long)stats.ticks, (unsigned long long)stats.missed_ticks);
+        fprintf(stderr, "Fell behind:     %llu ticks, %llu bytes forfeited, %llu slow writes\n",
+                (unsigned long long)stats.behind_events, (unsigned long long)stats.bytes_forfeited,
+                (unsigned long long)stats.sink_stalls);
+        fprintf(stderr, "Generator:       %llu underruns, buffer low-water %zu KB\n",
+                (unsigned long long)stats.underruns, stats.buffer_min / 1024);
+    } else if (!opts->quiet && (stats.behind_events > 0 || stats.underruns > 0)) {
+        // Consumers need to know when the stream could not hold its rate
+        print_paced_line(&stats);
+    }
+
+    paced_stream_free(g_paced_stream);
+    g_paced_stream = NULL;
+    if (err != PACED_STREAM_SUCCESS) {
+        fprintf(stderr, "Error: %s\n", paced_stream_error_string(err));
+        return 1;
+    }
+    return 0;
+}
+
 // ============================================================================
 // MAIN
 // ============================================================================
@@ -267,6 +680,8 @@ int main(int argc, char *argv[]) {
         .format = OUTPUT_FORMAT_HEX,
         .mode = SECURE_RNG_MODE_QUANTUM,
         .thread_safe = 0,
+        .threads = 0,
+        .rate = 0,
         .min_entropy = 4.0,
         .reseed_interval = 1024 * 1024,
         .show_stats = 0,
@@ -291,6 +706,8 @@ int main(int argc, char *argv[]) {
         {"entropy-info", no_argument,       0, 'E'},
         {"benchmark",    no_argument,       0, 'b'},
         {"continuous",   no_argument,       0, 'c'},
+        {"threads",      required_argument, 0, 'j'},
+        {"rate",         required_argument, 0, 'R'},
         {"verbose",      no_argument,       0, 'v'},
         {"quiet",        no_argument,       0, 'q'},
         {"help",         no_argument,       0, 'h'},
@@ -299,13 +716,11 @@ int main(int argc, char *argv[]) {
     };
     
     int opt;
-    while ((opt = getopt_long(argc, argv, "n:f:m:te:r:sHEbcvqhV", long_options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "n:f:m:te:r:sHEbcj:R:vqhV", long_options, NULL)) != -1) {
         switch (opt) {
             case 'n':
-                opts.num_bytes = atoll(optarg);
-                if (opts.num_bytes > MAX_OUTPUT_SIZE) {
-                    fprintf(stderr, "Error: Size exceeds maximum (%d MB)\n", 
-                            MAX_OUTPUT_SIZE / (1024 * 1024));
+                if (parse_byte_count(optarg, &opts.num_bytes) != 0) {
+                    fprintf(stderr, "Error: Invalid byte count '%s' (positive decimal integer)\n", optarg);
                     return 1;
                 }
                 break;
@@ -376,6 +791,21 @@ int main(int argc, char *argv[]) {
                 opts.continuous = 1;
                 break;
                 
+            case 'j':
+                opts.threads = atoi(optarg);
+                if (opts.threads < 1 || opts.threads > MAX_THREADS) {
+                    fprintf(stderr, "Error: Threads must be in [1, %d]\n", MAX_THREADS);
+                    return 1;
+                }
+                break;
+                
+            case 'R':
+                if (parse_rate(optarg, &opts.rate) != 0) {
+                    fprintf(stderr, "Error: Invalid rate '%s' (e.g. 500K, 2M)\n", optarg);
+                    return 1;
+                }
+                break;
+                
             case 'v':
                 opts.verbose = 1;
                 break;
@@ -398,6 +828,18 @@ int main(int argc, char *argv[]) {
         }
     }
     
+    if (opts.rate > 0 && opts.threads > 0) {
+        fprintf(stderr, "Error: --rate and --threads cannot be combined\n");
+        return 1;
+    }
+    
+    // Threaded and paced generation stream, so only buffered output is size-limited
+    if (opts.threads == 0 && opts.rate == 0 && opts.num_bytes > MAX_OUTPUT_SIZE) {
+        fprintf(stderr, "Error: Size exceeds maximum (%d MB); use --threads to stream larger outputs\n", 
+                MAX_OUTPUT_SIZE / (1024 * 1024));
+        return 1;
+    }
+    
     // Initialize RNG
     if (opts.verbose && !opts.quiet) {
         fprintf(stderr, "Initializing Quantum RNG v%s...\n", VERSION);
@@ -405,6 +847,9 @@ int main(int argc, char *argv[]) {
         if (opts.thread_safe) {
             fprintf(stderr, "Thread-safe: Enabled\n");
         }
+        if (opts.threads > 0) {
+            fprintf(stderr, "Generator threads: %d\n", opts.threads);
+        }
     }
     
     secure_rng_config_t config;
@@ -460,6 +905,48 @@ int main(int argc, char *argv[]) {
         return 0;
     }
     
+    // Paced streaming (also handles -c)
+    if (opts.rate > 0) {
+        int rc = run_paced(ctx, &opts);
+        secure_rng_free(ctx);
+        return rc;
+    }
+    
+    // Multi-threaded ordered generation (also handles -c)
+    if (opts.threads > 0) {
+        if (opts.continuous && !opts.quiet) {
+            fprintf(stderr, "Generating continuous random data (Ctrl+C to stop)...\n");
+        }
+        
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        uint64_t produced = 0;
+        err = generate_parallel(ctx, &config, &opts, &produced);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        fflush(stdout);
+        
+        if (err != SECURE_RNG_SUCCESS) {
+            fprintf(stderr, "Error: %s\n", secure_rng_error_string(err));
+            secure_rng_free(ctx);
+            return 1;
+        }
+        
+        if (opts.show_stats) {
+            double seconds = (double)(t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+            double mbps = (produced / (1024.0 * 1024.0)) / seconds;
+            
+            printf("\n=== Generation Statistics ===\n");
+            printf("Bytes generated: %llu\n", (unsigned long long)produced);
+            printf("Threads: %d\n", opts.threads);
+            printf("Time: %.3f seconds (wall clock)\n", seconds);
+            printf("Throughput: %.2f MB/s\n", mbps);
+            printf("\n");
+        }
+        
+        secure_rng_free(ctx);
+        return 0;
+    }
+    
     // Continuous mode
     if (opts.continuous) {
         if (!opts.quiet) {
@@ -474,20 +961,7 @@ int main(int argc, char *argv[]) {
                 break;
             }
             
-            switch (opts.format) {
-                case OUTPUT_FORMAT_HEX:
-                    print_hex(buffer, sizeof(buffer));
-                    break;
-                case OUTPUT_FORMAT_BINARY:
-                    print_binary(buffer, sizeof(buffer));
-                    break;
-                case OUTPUT_FORMAT_BASE64:
-                    print_base64(buffer, sizeof(buffer));
-                    break;
-                case OUTPUT_FORMAT_DEC:
-                    print_decimal(buffer, sizeof(buffer));
-                    break;
-            }
+            print_formatted(opts.format, buffer, sizeof(buffer));
         }
         
         secure_rng_free(ctx);
@@ -514,20 +988,7 @@ int main(int argc, char *argv[]) {
     }
     
     // Output data
-    switch (opts.format) {
-        case OUTPUT_FORMAT_HEX:
-            print_hex(buffer, opts.num_bytes);
-            break;
-        case OUTPUT_FORMAT_BINARY:
-            print_binary(buffer, opts.num_bytes);
-            break;
-        case OUTPUT_FORMAT_BASE64:
-            print_base64(buffer, opts.num_bytes);
-            break;
-        case OUTPUT_FORMAT_DEC:
-            print_decimal(buffer, opts.num_bytes);
-            break;
-    }
+    print_formatted(opts.format, buffer, opts.num_bytes);
     
     free(buffer);
     
@@ -0,0 +1,204 @@
+/**
+ * @file qrngd.c
+ * @brief qrngd - host-local entropy daemon
+ *
+ * Serves random bytes from one set of secure_rng / qrng_v3 generators to
+ * every process on the host over a UNIX domain socket, so entropy pools,
+ * startup tests and Bell certification run once instead of per process.
+ * Clients use src/daemon/qrngd_client.h; with --shm, same-host consumers
+ * can instead map a shared ring and read without syscalls (shm_ring.h).
+ *
+ * Runs in the foreground (for systemd or a supervisor); SIGINT/SIGTERM
+ * shut it down cleanly and print the counters.
+ */
+
+#include "daemon/qrngd_server.h"
+#include "daemon/qrngd_client.h"
+#include "daemon/shm_ring.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <signal.h>
+
+static qrngd_server_t *g_server = NULL;
+
+static void handle_signal(int sig) {
+    (void)sig;
+    qrngd_server_stop(g_server);
+}
+
+static void print_usage(const char *program_name) {
+    qrngd_config_t defaults;
+    qrngd_get_default_config(&defaults);
+
+    char default_path[256];
+    if (qrngd_default_socket_path(default_path, sizeof(default_path)) != QRNGD_SUCCESS) {
+        snprintf(default_path, sizeof(default_path), "%s", QRNGD_DEFAULT_SOCKET);
+    }
+
+    printf("qrngd - local quantum RNG entropy daemon\n\n");
+    printf("Usage: %s [OPTIONS]\n\n", program_name);
+    printf("  -s, --socket=PATH      UNIX socket path (default: %s)\n", default_path);
+    printf("      --socket-mode=OCT  Socket file permissions (default: %04o; 0666 lets\n"
+           "                         every user of a system daemon connect)\n",
+           defaults.socket_mode);
+    printf("  -b, --buffer=KB        Pregenerated bytes per mode in KB (default: %zu)\n",
+           defaults.buffer_size / 1024);
+    printf("  -c, --max-clients=N    Maximum concurrent connections (default: %zu)\n",
+           defaults.max_clients);
+    printf("  -p, --prewarm=MODES    Comma-separated modes to start at launch\n");
+    printf("                         (fast,quantum,verified,qrng_v3; default: quantum)\n");
+    printf("  -m, --shm=NAME         Also publish into shared-memory ring NAME (e.g. /qrngd)\n");
+    printf("      --shm-slots=N      Ring slots of %d bytes (default: %zu)\n",
+           SHM_RING_DEFAULT_SLOT_SIZE, defaults.shm_slots);
+    printf("      --shm-mode=MODE    Generator feeding the ring (default: quantum)\n");
+    printf("  -q, --quiet            Do not print counters on shutdown\n");
+    printf("  -h, --help             Show this help\n");
+}
+
+static int parse_prewarm(const char *list, unsigned *mask) {
+    char copy[256];
+    snprintf(copy, sizeof(copy), "%s", list);
+    *mask = 0;
+    for (char *save = NULL, *tok = strtok_r(copy, ",", &save); tok; tok = strtok_r(NULL, ",", &save)) {
+        int mode = qrngd_mode_from_string(tok);
+        if (mode < 0) return -1;
+        *mask |= 1u << mode;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    qrngd_config_t config;
+    qrngd_get_default_config(&config);
+    int quiet = 0;
+
+    static struct option long_options[] = {
+        {"socket",      required_argument, 0, 's'},
+        {"socket-mode", required_argument, 0, 'o'},
+        {"buffer",      required_argument, 0, 'b'},
+        {"max-clients", required_argument, 0, 'c'},
+        {"prewarm",     required_argument, 0, 'p'},
+        {"shm",         required_argument, 0, 'm'},
+        {"shm-slots",   required_argument, 0, 'S'},
+        {"shm-mode",    required_argument, 0, 'M'},
+        {"quiet",       no_argument,       0, 'q'},
+        {"help",        no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "s:b:c:p:m:qh", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 's':
+                config.socket_path = optarg;
+                break;
+            case 'o': {
+                char *end;
+                unsigned long mode = strtoul(optarg, &end, 8);
+                if (end == optarg || *end || mode > 0777) {
+                    fprintf(stderr, "Error: invalid socket mode '%s'\n", optarg);
+                    return 1;
+                }
+                config.socket_mode = (unsigned)mode;
+                break;
+            }
+            case 'b':
+                config.buffer_size = strtoull(optarg, NULL, 10) * 1024;
+                break;
+            case 'c':
+                config.max_clients = strtoull(optarg, NULL, 10);
+                break;
+            case 'p':
+                if (parse_prewarm(optarg, &config.prewarm_modes) != 0) {
+                    fprintf(stderr, "Error: unknown mode in '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'm':
+                config.shm_name = optarg;
+                break;
+            case 'S':
+                config.shm_slots = strtoull(optarg, NULL, 10);
+                break;
+            case 'M': {
+                int mode = qrngd_mode_from_string(optarg);
+                if (mode < 0 || mode == QRNGD_MODE_HYBRID) {
+                    fprintf(stderr, "Error: unsupported ring mode '%s'\n", optarg);
+                    return 1;
+                }
+                config.shm_mode = (qrngd_mode_t)mode;
+                break;
+            }
+            case 'q':
+                quiet = 1;
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    char default_path[256];
+    if (!config.socket_path) {
+        if (qrngd_default_socket_path(default_path, sizeof(default_path)) != QRNGD_SUCCESS) {
+            fprintf(stderr, "Error: $XDG_RUNTIME_DIR is too long for a socket path\n");
+            return 1;
+        }
+        config.socket_path = default_path;
+    }
+
+    qrngd_error_t err = qrngd_server_create(&g_server, &config);
+    if (err != QRNGD_SUCCESS) {
+        fprintf(stderr, "Error: %s\n", qrngd_error_string(err));
+        return 1;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handle_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    if (!quiet) {
+        fprintf(stderr, "qrngd listening on %s (mode %04o)\n",
+                config.socket_path, config.socket_mode);
+        if (config.shm_name) {
+            fprintf(stderr, "qrngd publishing %s output to shm ring %s\n",
+                    qrngd_mode_string(config.shm_mode), config.shm_name);
+        }
+    }
+    err = qrngd_server_run(g_server);
+
+    if (!quiet) {
+        qrngd_stats_t stats;
+        qrngd_server_get_stats(g_server, &stats);
+        fprintf(stderr, "\nqrngd shutting down\n");
+        fprintf(stderr, "  connections:  %llu accepted, %llu rejected\n",
+                (unsigned long long)stats.connections_accepted,
+                (unsigned long long)stats.connections_rejected);
+        fprintf(stderr, "  requests:     %llu served, %llu failed\n",
+                (unsigned long long)stats.requests_served,
+                (unsigned long long)stats.request_errors);
+        fprintf(stderr, "  bytes served: %llu\n", (unsigned long long)stats.bytes_served);
+        fprintf(stderr, "  refills:      %llu buffered, %llu direct\n",
+                (unsigned long long)stats.buffer_refills,
+                (unsigned long long)stats.direct_generations);
+        fprintf(stderr, "  writes:       %llu\n", (unsigned long long)stats.write_batches);
+        if (config.shm_name) {
+            fprintf(stderr, "  shm slots:    %llu published, %llu consumed, %llu reclaimed, %llu fences\n",
+                    (unsigned long long)stats.shm_slots_published,
+                    (unsigned long long)stats.shm_slots_consumed,
+                    (unsigned long long)stats.shm_slots_reclaimed,
+                    (unsigned long long)stats.shm_fences);
+        }
+    }
+
+    qrngd_server_free(g_server);
+    return err == QRNGD_SUCCESS ? 0 : 1;
+}
@@ -235,6 +235,40 @@ qs_error_t grover_amplitude_amplification(
     size_t num_iterations
 );
 
+/**
+ * @brief Reflection about an arbitrary state: D_ψ = 2|ψ⟩⟨ψ| - I
+ *
+ * Generalizes grover_diffusion (where |ψ⟩ = H⊗ⁿ|0⟩ⁿ) to the state
+ * |ψ⟩ = A|0⟩ prepared by any algorithm A, as amplitude amplification
+ * and estimation require.  Computed directly from the overlap ⟨ψ|state⟩
+ * in two passes over the state vector.
+ *
+ * @param state Quantum state (modified)
+ * @param axis Normalized state |ψ⟩ with the same number of qubits
+ * @return QS_SUCCESS or error
+ */
+qs_error_t grover_reflect_about(quantum_state_t *state, const quantum_state_t *axis);
+
+/**
+ * @brief Fused amplitude-amplification iteration Q = D_ψ · S_χ
+ *
+ * S_χ flips the phase of every basis state with good_qubit set (the
+ * "good" subspace), D_ψ reflects about |ψ⟩.  The oracle is folded into
+ * the overlap and update loops, so one iteration is two streaming passes
+ * instead of an oracle pass plus a reflection.  Starting from |ψ⟩ with
+ * a = P(good_qubit = 1) = sin²θ, k iterations give P = sin²((2k+1)θ).
+ *
+ * @param state Quantum state (modified)
+ * @param axis Normalized state |ψ⟩ with the same number of qubits
+ * @param good_qubit Qubit that marks the good subspace
+ * @return QS_SUCCESS or error
+ */
+qs_error_t grover_amplification_iteration(
+    quantum_state_t *state,
+    const quantum_state_t *axis,
+    size_t good_qubit
+);
+
 /**
  * @brief Quantum sampling with importance sampling
  *
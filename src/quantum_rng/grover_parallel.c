@@ -2,46 +2,57 @@
 #include "grover.h"
 #include "quantum_constants.h"
 #include "../entropy/hardware_entropy.h"
+#include "../scheduler/task_pool.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
 #include <math.h>
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
-
-#ifdef __APPLE__
-#include <sys/sysctl.h>
-#include <unistd.h>
-#endif
-
 // ============================================================================
 // HARDWARE DETECTION
 // ============================================================================
 
 size_t grover_parallel_get_optimal_batch_size(void) {
-#ifdef _OPENMP
-    int num_threads = omp_get_max_threads();
-    return (size_t)num_threads;
-#else
-    // Fallback: try to detect cores
-#ifdef __APPLE__
-    int num_cores = 0;
-    size_t size = sizeof(num_cores);
-    if (sysctlbyname("hw.ncpu", &num_cores, &size, NULL, 0) == 0) {
-        return (size_t)num_cores;
-    }
-#endif
-    return 1;  // Sequential fallback
-#endif
+    // One search per thread of the shared pool
+    size_t threads = task_pool_num_threads(task_pool_default());
+    return threads ? threads : 1;
 }
 
 // ============================================================================
 // PARALLEL BATCH PROCESSING
 // ============================================================================
 
+typedef struct {
+    const grover_parallel_config_t *config;
+    const uint64_t *marked_states;
+    quantum_entropy_ctx_t *entropy_pools;
+    quantum_state_t *states;
+    grover_result_t *results;
+} grover_batch_t;
+
+/**
+ * @brief Run searches [begin, end) of a batch (task_range_fn)
+ */
+static void grover_batch_range(void *arg, size_t begin, size_t end) {
+    grover_batch_t *batch = arg;
+    for (size_t i = begin; i < end; i++) {
+        grover_config_t search_config = {
+            .num_qubits = batch->config->num_qubits,
+            .marked_state = batch->marked_states[i],
+            .num_iterations = 0,
+            .use_optimal_iterations = batch->config->use_optimal_iterations
+        };
+        
+        // Thread-safe: each search has its own state and entropy context
+        batch->results[i] = grover_search(
+            &batch->states[i],
+            &search_config,
+            &batch->entropy_pools[i]
+        );
+    }
+}
+
 grover_parallel_result_t grover_parallel_batch(
     const grover_parallel_config_t *config,
     const uint64_t *marked_states,
@@ -91,26 +102,9 @@ grover_parallel_result_t grover_parallel_batch(
     struct timespec start_time, end_time;
     clock_gettime(CLOCK_MONOTONIC, &start_time);
     
-    // PARALLEL EXECUTION - M2 ULTRA 24-CORE OPTIMIZATION
-#ifdef _OPENMP
-    #pragma omp parallel for schedule(dynamic) num_threads(num_searches)
-#endif
-    for (size_t i = 0; i < num_searches; i++) {
-        // Each thread runs independent Grover search
-        grover_config_t search_config = {
-            .num_qubits = config->num_qubits,
-            .marked_state = marked_states[i],
-            .num_iterations = 0,
-            .use_optimal_iterations = config->use_optimal_iterations
-        };
-        
-        // Thread-safe: each thread has its own state and entropy context
-        result.results[i] = grover_search(
-            &states[i],
-            &search_config,
-            &entropy_pools[i]
-        );
-    }
+    // PARALLEL EXECUTION: one search per task on the shared pool
+    grover_batch_t batch = { config, marked_states, entropy_pools, states, result.results };
+    task_pool_parallel_for(NULL, num_searches, 1, grover_batch_range, &batch);
     
     // End timing
     clock_gettime(CLOCK_MONOTONIC, &end_time);
@@ -313,11 +307,8 @@ grover_parallel_benchmark_t grover_parallel_benchmark(
     printf("║    Search space:        %6llu (2^%zu)                   ║\n",
            1ULL << num_qubits, num_qubits);
     
-#ifdef _OPENMP
-    printf("║    OpenMP threads:      %6d                            ║\n", omp_get_max_threads());
-#else
-    printf("║    OpenMP:              NOT ENABLED                       ║\n");
-#endif
+    printf("║    Pool threads:        %6zu                            ║\n",
+           task_pool_num_threads(task_pool_default()));
     
     printf("║                                                           ║\n");
     printf("╚═══════════════════════════════════════════════════════════╝\n");
@@ -478,13 +469,9 @@ void grover_parallel_print_config(const grover_parallel_config_t *config) {
            config->pin_to_performance_cores ? "YES" : "NO ");
     printf("║                                                           ║\n");
     
-#ifdef _OPENMP
-    printf("║  OpenMP Status:         ENABLED                           ║\n");
-    printf("║  Max threads:           %6d                            ║\n", omp_get_max_threads());
-#else
-    printf("║  OpenMP Status:         DISABLED                          ║\n");
-    printf("║  Note: Compile with -fopenmp for parallel execution      ║\n");
-#endif
+    printf("║  Pool threads:          %6zu                            ║\n",
+           task_pool_num_threads(task_pool_default()));
+    printf("║  Set QRNG_THREADS / QRNG_AFFINITY to change the pool     ║\n");
     
     printf("╚═══════════════════════════════════════════════════════════╝\n");
     printf("\n");
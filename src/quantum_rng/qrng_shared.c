@@ -0,0 +1,515 @@
+#include "qrng_shared.h"
+#include "../common/secure_memory.h"
+#include "../common/validation.h"
+#include "../scheduler/task_pool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/**
+ * @file qrng_shared.c
+ * @brief Shared quantum engine and ChaCha20 handles
+ */
+
+#define QRNG_SHARED_BELL_MEASUREMENTS 4000
+
+/**
+ * @brief A Bell test taken off the engine
+ *
+ * The engine's quantum state is copied under the lock, and the test's
+ * measurement outcomes come from a ChaCha20 stream keyed from engine
+ * output, so running it touches nothing the lock protects.
+ */
+typedef struct {
+    quantum_state_t state;
+    uint32_t key[8];
+    uint64_t counter;
+} bell_job_t;
+
+struct qrng_shared {
+    qrng_v3_ctx_t *rng;
+    pthread_mutex_t lock;
+
+    // Engine output not yet handed out as keys
+    uint8_t *key_cache;
+    size_t key_cache_size;
+    size_t key_cache_pos;
+
+    uint64_t reseed_interval;
+    uint64_t bell_interval;         /**< 0 = no Bell tests for handle output */
+    double min_chsh;
+    uint64_t bytes_since_bell;
+    int verification_failed;
+
+    // Scheduled Bell test: at most one runs on the task pool at a time
+    bell_job_t bell_job;
+    int bell_running;
+    task_pool_t *bell_pool;
+    task_group_t bell_group;
+
+    uint64_t next_serial;           /**< Atomic */
+    uint64_t epoch;                 /**< Atomic */
+
+    qrng_shared_stats_t stats;      /**< Under lock (except handles_created) */
+};
+
+// ============================================================================
+// CHACHA20
+// ============================================================================
+
+#define ROTL32(v, n) (((v) << (n)) | ((v) >> (32 - (n))))
+
+#define QUARTER_ROUND(a, b, c, d) do {             \
+    a += b; d ^= a; d = ROTL32(d, 16);             \
+    c += d; b ^= c; b = ROTL32(b, 12);             \
+    a += b; d ^= a; d = ROTL32(d, 8);              \
+    c += d; b ^= c; b = ROTL32(b, 7);              \
+} while (0)
+
+/**
+ * @brief One ChaCha20 block (64-bit counter and nonce, as in the original design)
+ */
+static void chacha20_block(const uint32_t key[8], uint64_t counter,
+                           uint64_t nonce, uint8_t out[64]) {
+    uint32_t in[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+        (uint32_t)counter, (uint32_t)(counter >> 32),
+        (uint32_t)nonce, (uint32_t)(nonce >> 32)
+    };
+    uint32_t x[16];
+    memcpy(x, in, sizeof(x));
+
+    for (int i = 0; i < 10; i++) {
+        QUARTER_ROUND(x[0], x[4], x[8],  x[12]);
+        QUARTER_ROUND(x[1], x[5], x[9],  x[13]);
+        QUARTER_ROUND(x[2], x[6], x[10], x[14]);
+        QUARTER_ROUND(x[3], x[7], x[11], x[15]);
+        QUARTER_ROUND(x[0], x[5], x[10], x[15]);
+        QUARTER_ROUND(x[1], x[6], x[11], x[12]);
+        QUARTER_ROUND(x[2], x[7], x[8],  x[13]);
+        QUARTER_ROUND(x[3], x[4], x[9],  x[14]);
+    }
+
+    for (int i = 0; i < 16; i++) {
+        uint32_t v = x[i] + in[i];
+        out[4 * i]     = (uint8_t)v;
+        out[4 * i + 1] = (uint8_t)(v >> 8);
+        out[4 * i + 2] = (uint8_t)(v >> 16);
+        out[4 * i + 3] = (uint8_t)(v >> 24);
+    }
+
+    secure_memzero(x, sizeof(x));
+    secure_memzero(in, sizeof(in));
+}
+
+// ============================================================================
+// ENGINE
+// ============================================================================
+
+void qrng_shared_get_default_config(qrng_shared_config_t *config) {
+    if (!config) return;
+
+    memset(config, 0, sizeof(*config));
+    qrng_v3_get_default_config(&config->engine);
+    config->key_cache_size = 4096;
+    config->reseed_interval = 1024 * 1024;
+}
+
+qrng_v3_error_t qrng_shared_create(qrng_shared_t **engine,
+                                   const qrng_shared_config_t *config) {
+    VALIDATE_NOT_NULL(engine, QRNG_V3_ERROR_NULL_CONTEXT);
+    *engine = NULL;
+
+    qrng_shared_config_t cfg;
+    if (config) {
+        cfg = *config;
+    } else {
+        qrng_shared_get_default_config(&cfg);
+    }
+    if (cfg.key_cache_size < 32 || cfg.reseed_interval == 0) {
+        return QRNG_V3_ERROR_INVALID_PARAM;
+    }
+    cfg.key_cache_size -= cfg.key_cache_size % 32;
+
+    qrng_shared_t *e = calloc(1, sizeof(*e));
+    if (!e) return QRNG_V3_ERROR_OUT_OF_MEMORY;
+
+    e->key_cache = malloc(cfg.key_cache_size);
+    if (!e->key_cache) {
+        free(e);
+        return QRNG_V3_ERROR_OUT_OF_MEMORY;
+    }
+
+    qrng_v3_error_t err = qrng_v3_init_with_config(&e->rng, &cfg.engine);
+    if (err != QRNG_V3_SUCCESS) {
+        free(e->key_cache);
+        free(e);
+        return err;
+    }
+
+    pthread_mutex_init(&e->lock, NULL);
+    e->key_cache_size = cfg.key_cache_size;
+    e->key_cache_pos = cfg.key_cache_size;     // Empty; filled on first key
+    e->reseed_interval = cfg.reseed_interval;
+    e->bell_interval = cfg.engine.enable_bell_monitoring ? cfg.engine.bell_test_interval : 0;
+    e->min_chsh = cfg.engine.min_acceptable_chsh;
+
+    *engine = e;
+    return QRNG_V3_SUCCESS;
+}
+
+void qrng_shared_free(qrng_shared_t *engine) {
+    if (!engine) return;
+
+    // A scheduled Bell test still uses the engine when it finishes
+    if (engine->bell_pool) task_pool_wait(engine->bell_pool, &engine->bell_group);
+
+    qrng_v3_free(engine->rng);
+    secure_memzero(engine->key_cache, engine->key_cache_size);
+    free(engine->key_cache);
+    pthread_mutex_destroy(&engine->lock);
+    free(engine);
+}
+
+void qrng_shared_reseed_all(qrng_shared_t *engine) {
+    if (!engine) return;
+    __atomic_add_fetch(&engine->epoch, 1, __ATOMIC_RELEASE);
+}
+
+// ============================================================================
+// BELL TESTS
+// ============================================================================
+
+/**
+ * @brief quantum_entropy_fn over the job's ChaCha20 stream
+ */
+static int bell_job_entropy(void *user_data, uint8_t *buffer, size_t size) {
+    bell_job_t *job = user_data;
+    uint8_t block[64];
+    while (size > 0) {
+        size_t n = size < sizeof(block) ? size : sizeof(block);
+        chacha20_block(job->key, job->counter++, UINT64_MAX, block);
+        memcpy(buffer, block, n);
+        buffer += n;
+        size -= n;
+    }
+    secure_memzero(block, sizeof(block));
+    return 0;
+}
+
+/**
+ * @brief Snapshot the engine for a Bell test (lock held)
+ */
+static qrng_v3_error_t bell_job_prepare_locked(qrng_shared_t *e, bell_job_t *job) {
+    qrng_v3_error_t err = qrng_v3_bytes(e->rng, (uint8_t *)job->key, sizeof(job->key));
+    if (err != QRNG_V3_SUCCESS) return err;
+    e->stats.engine_bytes += sizeof(job->key);
+    job->counter = 0;
+
+    err = qrng_v3_snapshot_state(e->rng, &job->state);
+    if (err != QRNG_V3_SUCCESS) secure_memzero(job->key, sizeof(job->key));
+    return err;
+}
+
+/**
+ * @brief Run a prepared test without the lock and release the snapshot
+ */
+static bell_test_result_t bell_job_run(bell_job_t *job) {
+    quantum_entropy_ctx_t entropy;
+    quantum_entropy_init(&entropy, bell_job_entropy, job);
+    bell_test_result_t result = bell_test_chsh(&job->state, 0, 1,
+                                               QRNG_SHARED_BELL_MEASUREMENTS, NULL, &entropy);
+    quantum_state_free(&job->state);
+    secure_memzero(job->key, sizeof(job->key));
+    return result;
+}
+
+/**
+ * @brief Count a finished test; a failure stops key issue (lock held)
+ */
+static void bell_record_locked(qrng_shared_t *e, const bell_test_result_t *result) {
+    qrng_v3_record_verification(e->rng, result);
+    e->stats.bell_tests++;
+    if (result->chsh_value < e->min_chsh) {
+        e->stats.bell_failures++;
+        e->verification_failed = 1;
+    }
+}
+
+static void bell_task(void *arg) {
+    qrng_shared_t *e = arg;
+    bell_test_result_t result = bell_job_run(&e->bell_job);
+
+    pthread_mutex_lock(&e->lock);
+    bell_record_locked(e, &result);
+    e->bell_running = 0;
+    pthread_mutex_unlock(&e->lock);
+}
+
+/**
+ * @brief Account handle output and prepare a Bell test when one is due (lock held)
+ *
+ * @return 1 if e->bell_job is ready; the caller starts it after unlocking
+ */
+static int shared_report_locked(qrng_shared_t *e, uint64_t bytes) {
+    e->stats.handle_bytes += bytes;
+    if (e->bell_interval == 0) return 0;
+
+    e->bytes_since_bell += bytes;
+    if (e->bytes_since_bell < e->bell_interval || e->bell_running) return 0;
+    e->bytes_since_bell = 0;
+
+    if (bell_job_prepare_locked(e, &e->bell_job) != QRNG_V3_SUCCESS) {
+        // No snapshot means no evidence: fail closed
+        e->stats.bell_tests++;
+        e->stats.bell_failures++;
+        e->verification_failed = 1;
+        return 0;
+    }
+    e->bell_running = 1;
+    return 1;
+}
+
+/**
+ * @brief Start a prepared test on the task pool, or inline without one
+ */
+static void bell_start(qrng_shared_t *e) {
+    task_pool_t *pool = task_pool_default();
+    if (pool) {
+        e->bell_pool = pool;
+        if (task_pool_submit(pool, &e->bell_group, bell_task, e) == TASK_POOL_SUCCESS) return;
+    }
+    bell_task(e);
+}
+
+qrng_v3_error_t qrng_shared_reverify(qrng_shared_t *engine) {
+    VALIDATE_NOT_NULL(engine, QRNG_V3_ERROR_NULL_CONTEXT);
+
+    bell_job_t job;
+    pthread_mutex_lock(&engine->lock);
+    uint64_t failures = engine->stats.bell_failures;
+    qrng_v3_error_t err = bell_job_prepare_locked(engine, &job);
+    pthread_mutex_unlock(&engine->lock);
+    if (err != QRNG_V3_SUCCESS) return err;
+
+    bell_test_result_t result = bell_job_run(&job);
+
+    pthread_mutex_lock(&engine->lock);
+    bell_record_locked(engine, &result);
+    int passed = result.chsh_value >= engine->min_chsh;
+    // A scheduled test that failed meanwhile still stands
+    if (passed && engine->stats.bell_failures == failures) {
+        engine->verification_failed = 0;
+        engine->bytes_since_bell = 0;
+    }
+    pthread_mutex_unlock(&engine->lock);
+    return passed ? QRNG_V3_SUCCESS : QRNG_V3_ERROR_BELL_TEST_FAILED;
+}
+
+// ============================================================================
+// KEYS
+// ============================================================================
+
+/**
+ * @brief Report a handle's output and hand it a fresh key
+ */
+static qrng_v3_error_t shared_issue_key(qrng_shared_t *e, uint64_t reported,
+                                        uint32_t key[8]) {
+    qrng_v3_error_t err = QRNG_V3_SUCCESS;
+
+    pthread_mutex_lock(&e->lock);
+
+    int bell_due = shared_report_locked(e, reported);
+
+    if (e->verification_failed) {
+        err = QRNG_V3_ERROR_BELL_TEST_FAILED;
+    } else if (e->key_cache_pos + 32 > e->key_cache_size) {
+        err = qrng_v3_bytes(e->rng, e->key_cache, e->key_cache_size);
+        if (err == QRNG_V3_SUCCESS) {
+            e->key_cache_pos = 0;
+            e->stats.engine_bytes += e->key_cache_size;
+        } else if (err == QRNG_V3_ERROR_BELL_TEST_FAILED) {
+            e->verification_failed = 1;
+        }
+    }
+
+    if (err == QRNG_V3_SUCCESS) {
+        // Keys are consumed once: wipe them from the cache as they leave
+        uint8_t *src = e->key_cache + e->key_cache_pos;
+        for (int i = 0; i < 8; i++) {
+            key[i] = (uint32_t)src[4 * i] | ((uint32_t)src[4 * i + 1] << 8) |
+                     ((uint32_t)src[4 * i + 2] << 16) | ((uint32_t)src[4 * i + 3] << 24);
+        }
+        secure_memzero(src, 32);
+        e->key_cache_pos += 32;
+        e->stats.keys_issued++;
+    }
+
+    pthread_mutex_unlock(&e->lock);
+    if (bell_due) bell_start(e);
+    return err;
+}
+
+int qrng_shared_is_verified(qrng_shared_t *engine) {
+    if (!engine) return 0;
+
+    pthread_mutex_lock(&engine->lock);
+    int verified = !engine->verification_failed &&
+                   qrng_v3_is_quantum_verified(engine->rng);
+    pthread_mutex_unlock(&engine->lock);
+    return verified;
+}
+
+void qrng_shared_get_stats(qrng_shared_t *engine, qrng_shared_stats_t *stats) {
+    if (!engine || !stats) return;
+
+    pthread_mutex_lock(&engine->lock);
+    *stats = engine->stats;
+    pthread_mutex_unlock(&engine->lock);
+    stats->handles_created = __atomic_load_n(&engine->next_serial, __ATOMIC_RELAXED);
+    stats->epoch = __atomic_load_n(&engine->epoch, __ATOMIC_ACQUIRE);
+}
+
+// ============================================================================
+// HANDLES
+// ============================================================================
+
+qrng_v3_error_t qrng_handle_init(qrng_handle_t *handle, qrng_shared_t *engine) {
+    VALIDATE_NOT_NULL(handle, QRNG_V3_ERROR_NULL_CONTEXT);
+    VALIDATE_NOT_NULL(engine, QRNG_V3_ERROR_NULL_CONTEXT);
+
+    memset(handle, 0, sizeof(*handle));
+    handle->engine = engine;
+    handle->nonce = __atomic_fetch_add(&engine->next_serial, 1, __ATOMIC_RELAXED);
+    handle->block_pos = sizeof(handle->block);
+    return QRNG_V3_SUCCESS;
+}
+
+void qrng_handle_clear(qrng_handle_t *handle) {
+    if (!handle) return;
+
+    qrng_shared_t *e = handle->engine;
+    if (e && handle->bytes_since_key > 0) {
+        pthread_mutex_lock(&e->lock);
+        int bell_due = shared_report_locked(e, handle->bytes_since_key);
+        pthread_mutex_unlock(&e->lock);
+        if (bell_due) bell_start(e);
+    }
+    secure_memzero(handle, sizeof(*handle));
+}
+
+/**
+ * @brief Draw a new key when the handle has none, is due, or the epoch moved
+ */
+static qrng_v3_error_t handle_check_key(qrng_handle_t *h) {
+    uint64_t epoch = __atomic_load_n(&h->engine->epoch, __ATOMIC_ACQUIRE);
+    if (h->keyed && h->epoch == epoch &&
+        h->bytes_since_key < h->engine->reseed_interval) {
+        return QRNG_V3_SUCCESS;
+    }
+
+    qrng_v3_error_t err = shared_issue_key(h->engine, h->bytes_since_key, h->key);
+    if (err != QRNG_V3_SUCCESS) return err;
+
+    h->keyed = 1;
+    h->epoch = epoch;
+    h->counter = 0;
+    h->bytes_since_key = 0;
+    secure_memzero(h->block, sizeof(h->block));
+    h->block_pos = sizeof(h->block);
+    return QRNG_V3_SUCCESS;
+}
+
+qrng_v3_error_t qrng_handle_bytes(qrng_handle_t *handle, uint8_t *buffer, size_t size) {
+    VALIDATE_NOT_NULL(handle, QRNG_V3_ERROR_NULL_CONTEXT);
+    VALIDATE_BUFFER(buffer, size, QRNG_V3_ERROR_NULL_BUFFER);
+    if (!handle->engine) return QRNG_V3_ERROR_NOT_INITIALIZED;
+
+    while (size > 0) {
+        qrng_v3_error_t err = handle_check_key(handle);
+        if (err != QRNG_V3_SUCCESS) return err;
+
+        // Never run one key past reseed_interval
+        uint64_t budget = handle->engine->reseed_interval - handle->bytes_since_key;
+        size_t chunk = size < budget ? size : (size_t)budget;
+        size_t done = 0;
+
+        // Leftover keystream first
+        size_t avail = sizeof(handle->block) - handle->block_pos;
+        if (avail > 0) {
+            size_t n = chunk < avail ? chunk : avail;
+            memcpy(buffer, handle->block + handle->block_pos, n);
+            secure_memzero(handle->block + handle->block_pos, n);
+            handle->block_pos += (uint8_t)n;
+            done = n;
+        }
+
+        // Whole blocks straight into the caller's buffer
+        while (chunk - done >= 64) {
+            chacha20_block(handle->key, handle->counter++, handle->nonce, buffer + done);
+            done += 64;
+        }
+
+        if (done < chunk) {
+            size_t n = chunk - done;
+            chacha20_block(handle->key, handle->counter++, handle->nonce, handle->block);
+            memcpy(buffer + done, handle->block, n);
+            secure_memzero(handle->block, n);
+            handle->block_pos = (uint8_t)n;
+            done = chunk;
+        }
+
+        handle->bytes_since_key += chunk;
+        buffer += chunk;
+        size -= chunk;
+    }
+
+    return QRNG_V3_SUCCESS;
+}
+
+qrng_v3_error_t qrng_handle_uint64(qrng_handle_t *handle, uint64_t *value) {
+    VALIDATE_NOT_NULL(handle, QRNG_V3_ERROR_NULL_CONTEXT);
+    VALIDATE_NOT_NULL(value, QRNG_V3_ERROR_NULL_BUFFER);
+
+    return qrng_handle_bytes(handle, (uint8_t*)value, sizeof(*value));
+}
+
+qrng_v3_error_t qrng_handle_double(qrng_handle_t *handle, double *value) {
+    VALIDATE_NOT_NULL(handle, QRNG_V3_ERROR_NULL_CONTEXT);
+    VALIDATE_NOT_NULL(value, QRNG_V3_ERROR_NULL_BUFFER);
+
+    uint64_t random_bits;
+    qrng_v3_error_t err = qrng_handle_uint64(handle, &random_bits);
+    if (err != QRNG_V3_SUCCESS) return err;
+
+    *value = (double)(random_bits >> 11) * 0x1.0p-53;
+    return QRNG_V3_SUCCESS;
+}
+
+qrng_v3_error_t qrng_handle_range(qrng_handle_t *handle, uint64_t min,
+                                  uint64_t max, uint64_t *value) {
+    VALIDATE_NOT_NULL(handle, QRNG_V3_ERROR_NULL_CONTEXT);
+    VALIDATE_NOT_NULL(value, QRNG_V3_ERROR_NULL_BUFFER);
+
+    if (min > max) return QRNG_V3_ERROR_INVALID_PARAM;
+    if (min == max) {
+        *value = min;
+        return QRNG_V3_SUCCESS;
+    }
+
+    uint64_t range = max - min + 1;
+    if (range == 0) {  // Full 64-bit range
+        return qrng_handle_uint64(handle, value);
+    }
+
+    uint64_t threshold = (UINT64_MAX - range + 1) % range;
+    uint64_t r;
+    do {
+        qrng_v3_error_t err = qrng_handle_uint64(handle, &r);
+        if (err != QRNG_V3_SUCCESS) return err;
+    } while (r < threshold);
+
+    *value = min + (r % range);
+    return QRNG_V3_SUCCESS;
+}
@@ -0,0 +1,146 @@
+#ifndef QRNG_SHARED_H
+#define QRNG_SHARED_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "quantum_rng_v3.h"
+
+/**
+ * @file qrng_shared.h
+ * @brief Lightweight RNG handles fed by one shared quantum engine
+ *
+ * A qrng_v3_ctx_t carries a quantum state, an entropy pool, a Bell monitor,
+ * a performance monitor and an output buffer, which is far too much for one
+ * RNG per user session. In shared mode a single engine owns one qrng_v3
+ * context and hands out keys; each session gets a qrng_handle_t:
+ *
+ * - a handle is a plain struct (a few hundred bytes) the caller embeds or
+ *   allocates; qrng_handle_init() only records the engine and takes a
+ *   serial number, so creation is O(1) and never touches the engine;
+ * - on first use a handle draws a 32-byte ChaCha20 key from the engine and
+ *   then expands it locally, so steady-state generation takes no lock;
+ * - a handle rekeys from the engine every reseed_interval bytes and after
+ *   qrng_shared_reseed_all(); the handle serial is the ChaCha20 nonce, so
+ *   two handles never share a keystream;
+ * - handles report their output volume when they rekey, and the engine
+ *   runs a Bell test every bell_test_interval bytes of handle output. The
+ *   test runs on a copy of the engine's quantum state on the task pool, so
+ *   it never holds the engine lock; after a failed test handles return
+ *   QRNG_V3_ERROR_BELL_TEST_FAILED when they next ask for a key, until
+ *   qrng_shared_reverify() passes.
+ *
+ * The engine is thread-safe. A handle is not: use one per thread or
+ * session. The engine must outlive its handles.
+ */
+
+/**
+ * @brief Shared engine configuration
+ */
+typedef struct {
+    qrng_v3_config_t engine;        /**< Configuration of the one qrng_v3 context */
+    size_t key_cache_size;          /**< Engine bytes fetched per key refill (default 4 KB) */
+    uint64_t reseed_interval;       /**< Handle output between rekeys (default 1 MB) */
+} qrng_shared_config_t;
+
+/**
+ * @brief Engine counters
+ */
+typedef struct {
+    uint64_t handles_created;
+    uint64_t keys_issued;           /**< First keys and rekeys */
+    uint64_t handle_bytes;          /**< Handle output reported at rekey/clear */
+    uint64_t engine_bytes;          /**< Bytes drawn from the qrng_v3 context */
+    uint64_t bell_tests;            /**< Scheduled and qrng_shared_reverify tests finished */
+    uint64_t bell_failures;
+    uint64_t epoch;                 /**< Bumped by qrng_shared_reseed_all */
+} qrng_shared_stats_t;
+
+typedef struct qrng_shared qrng_shared_t;
+
+/**
+ * @brief One logical RNG backed by a shared engine
+ *
+ * Treat the fields as private.
+ */
+typedef struct {
+    qrng_shared_t *engine;
+    uint32_t key[8];                /**< ChaCha20 key */
+    uint64_t nonce;                 /**< Handle serial */
+    uint64_t counter;               /**< Next ChaCha20 block */
+    uint64_t epoch;                 /**< Engine epoch at last key */
+    uint64_t bytes_since_key;
+    uint8_t block[64];              /**< Unused keystream */
+    uint8_t block_pos;              /**< 64 = empty */
+    uint8_t keyed;
+} qrng_handle_t;
+
+/**
+ * @brief Default configuration (qrng_v3 defaults for the engine)
+ */
+void qrng_shared_get_default_config(qrng_shared_config_t *config);
+
+/**
+ * @brief Create the shared engine
+ *
+ * @param engine Output engine pointer
+ * @param config Configuration (NULL = defaults)
+ * @return QRNG_V3_SUCCESS or error code
+ */
+qrng_v3_error_t qrng_shared_create(qrng_shared_t **engine,
+                                   const qrng_shared_config_t *config);
+
+/**
+ * @brief Free the engine; handles must be cleared first
+ */
+void qrng_shared_free(qrng_shared_t *engine);
+
+/**
+ * @brief Make every handle rekey before its next output
+ */
+void qrng_shared_reseed_all(qrng_shared_t *engine);
+
+/**
+ * @brief 1 while no Bell test of handle output has failed and the engine
+ *        context reports quantum behaviour (see qrng_v3_is_quantum_verified)
+ */
+int qrng_shared_is_verified(qrng_shared_t *engine);
+
+/**
+ * @brief Run a Bell test now, on the calling thread and outside the engine lock
+ *
+ * A pass clears an earlier failure, unless a scheduled test failed while
+ * this one ran, and handles get keys again.
+ *
+ * @return QRNG_V3_SUCCESS if the test passed, QRNG_V3_ERROR_BELL_TEST_FAILED
+ *         if it did not, or the error that prevented running it
+ */
+qrng_v3_error_t qrng_shared_reverify(qrng_shared_t *engine);
+
+void qrng_shared_get_stats(qrng_shared_t *engine, qrng_shared_stats_t *stats);
+
+/**
+ * @brief Bind a handle to an engine (O(1); no key is drawn yet)
+ */
+qrng_v3_error_t qrng_handle_init(qrng_handle_t *handle, qrng_shared_t *engine);
+
+/**
+ * @brief Report output to the engine and wipe the handle
+ */
+void qrng_handle_clear(qrng_handle_t *handle);
+
+qrng_v3_error_t qrng_handle_bytes(qrng_handle_t *handle, uint8_t *buffer, size_t size);
+
+qrng_v3_error_t qrng_handle_uint64(qrng_handle_t *handle, uint64_t *value);
+
+/**
+ * @brief Double in [0, 1) with 53 random bits
+ */
+qrng_v3_error_t qrng_handle_double(qrng_handle_t *handle, double *value);
+
+/**
+ * @brief Unbiased integer in [min, max]
+ */
+qrng_v3_error_t qrng_handle_range(qrng_handle_t *handle, uint64_t min,
+                                  uint64_t max, uint64_t *value);
+
+#endif /* QRNG_SHARED_H */
@@ -2,6 +2,7 @@
 #include "quantum_entropy.h"
 #include "quantum_constants.h"
 #include "simd_ops.h"
+#include "../scheduler/task_pool.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -32,6 +33,80 @@ static inline int get_bit(uint64_t n, int bit_pos) {
     return (n >> bit_pos) & 1ULL;
 }
 
+// ============================================================================
+// PARALLEL SINGLE-QUBIT KERNEL
+// ============================================================================
+
+// States with at least this many amplitudes split single-qubit gates across
+// the shared task pool; below it a task hand-off costs more than the sweep
+#define GATE_PARALLEL_MIN_DIM (1ULL << 18)
+#define GATE_PARALLEL_GRAIN (1ULL << 14)  // Amplitude pairs per chunk
+
+typedef enum {
+    PAIR_KERNEL_HADAMARD,
+    PAIR_KERNEL_PAULI_X,
+    PAIR_KERNEL_MATRIX
+} pair_kernel_kind_t;
+
+typedef struct {
+    complex_t *amplitudes;
+    uint64_t stride;
+    pair_kernel_kind_t kind;
+    complex_t m[2][2];
+} pair_kernel_t;
+
+/**
+ * @brief Apply a 2x2 kernel to amplitude pairs [begin, end) (task_range_fn)
+ *
+ * Pair k is (idx0, idx0 + stride) with idx0 = k with a zero inserted at
+ * the target bit.
+ */
+static void pair_kernel_range(void *arg, size_t begin, size_t end) {
+    const pair_kernel_t *pk = arg;
+    complex_t *amp = pk->amplitudes;
+    const uint64_t stride = pk->stride;
+    const uint64_t low = stride - 1;
+    
+    for (uint64_t k = begin; k < end; k++) {
+        const uint64_t idx0 = ((k & ~low) << 1) | (k & low);
+        const uint64_t idx1 = idx0 + stride;
+        const complex_t amp0 = amp[idx0];
+        const complex_t amp1 = amp[idx1];
+        
+        switch (pk->kind) {
+            case PAIR_KERNEL_HADAMARD:
+                amp[idx0] = (amp0 + amp1) * QC_SQRT2_INV;
+                amp[idx1] = (amp0 - amp1) * QC_SQRT2_INV;
+                break;
+            case PAIR_KERNEL_PAULI_X:
+                amp[idx0] = amp1;
+                amp[idx1] = amp0;
+                break;
+            case PAIR_KERNEL_MATRIX:
+                amp[idx0] = pk->m[0][0] * amp0 + pk->m[0][1] * amp1;
+                amp[idx1] = pk->m[1][0] * amp0 + pk->m[1][1] * amp1;
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Run a pair kernel on the task pool if the state is large enough
+ *
+ * @return 1 if applied, 0 if the caller should use its serial loop
+ */
+static int gate_parallel_pairs(quantum_state_t *state, int qubit, pair_kernel_t *pk) {
+    if (state->state_dim < GATE_PARALLEL_MIN_DIM) return 0;
+    task_pool_t *pool = task_pool_default();
+    if (task_pool_num_threads(pool) < 2) return 0;
+    
+    pk->amplitudes = state->amplitudes;
+    pk->stride = 1ULL << qubit;
+    task_pool_parallel_for(pool, state->state_dim / 2, GATE_PARALLEL_GRAIN,
+                           pair_kernel_range, pk);
+    return 1;
+}
+
 // ============================================================================
 // SINGLE-QUBIT GATES
 // ============================================================================
@@ -40,6 +115,9 @@ qs_error_t gate_pauli_x(quantum_state_t *state, int qubit) {
     if (!state || !state->amplitudes) return QS_ERROR_INVALID_STATE;
     if (!check_qubit_valid(state, qubit)) return QS_ERROR_INVALID_QUBIT;
     
+    pair_kernel_t pk = { .kind = PAIR_KERNEL_PAULI_X };
+    if (gate_parallel_pairs(state, qubit, &pk)) return QS_SUCCESS;
+    
     // OPTIMIZED X gate: Stride-based indexing, no get_bit()
     // X gate: |0⟩ ↔ |1⟩
     const uint64_t stride = 1ULL << qubit;
@@ -113,8 +191,12 @@ qs_error_t gate_hadamard(quantum_state_t *state, int qubit) {
      *
      * KEY OPTIMIZATION: Stride-based access eliminates bit-checking overhead
      * and enables full vectorization across entire amplitude blocks.
+     * Large states are split across the shared task pool.
      */
     
+    pair_kernel_t pk = { .kind = PAIR_KERNEL_HADAMARD };
+    if (gate_parallel_pairs(state, qubit, &pk)) return QS_SUCCESS;
+    
     const uint64_t stride = 1ULL << qubit;
     const uint64_t block_size = stride << 1;
     
@@ -931,6 +1013,10 @@ qs_error_t apply_single_qubit_gate(
     if (!state || !state->amplitudes) return QS_ERROR_INVALID_STATE;
     if (!check_qubit_valid(state, qubit)) return QS_ERROR_INVALID_QUBIT;
     
+    pair_kernel_t pk = { .kind = PAIR_KERNEL_MATRIX };
+    memcpy(pk.m, matrix, sizeof(pk.m));
+    if (gate_parallel_pairs(state, qubit, &pk)) return QS_SUCCESS;
+    
     for (uint64_t i = 0; i < state->state_dim; i++) {
         if (!get_bit(i, qubit)) {
             uint64_t j = flip_bit(i, qubit);
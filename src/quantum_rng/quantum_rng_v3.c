@@ -36,6 +36,19 @@
 // CONFIGURATION
 // ============================================================================
 
+// First output buffer refill; later refills double up to the buffer size
+#define QRNG_V3_FIRST_FILL_SIZE 256
+
+// Largest refill of a try/deadline call: the work lost when one runs short
+// of entropy, and the step between deadline checks
+#define QRNG_V3_BOUNDED_FILL_SIZE 1024
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
 void qrng_v3_get_default_config(qrng_v3_config_t *config) {
     if (!config) return;
     
@@ -66,6 +79,10 @@ void qrng_v3_get_default_config(qrng_v3_config_t *config) {
     // Performance
     config->enable_simd = 1;
     config->enable_performance_monitoring = 0;  // Disabled by default (overhead)
+    
+    // Startup
+    config->lazy_init = 0;  // Eager: prefill the entropy pool during init
+    config->seed_file = NULL;  // No persisted seed
 }
 
 // ============================================================================
@@ -323,6 +340,35 @@ static int extract_grover_entropy(
 // INITIALIZATION & CLEANUP
 // ============================================================================
 
+/**
+ * @brief Create the Bell test monitor on first need
+ */
+static void ensure_bell_monitor(qrng_v3_ctx_t *ctx) {
+    if (ctx->bell_monitor) return;
+    
+    ctx->bell_monitor = calloc(1, sizeof(bell_test_monitor_t));
+    if (ctx->bell_monitor) {
+        bell_monitor_init(ctx->bell_monitor, 100);  // Track last 100 tests
+    }
+}
+
+/**
+ * @brief Size of the next output buffer refill
+ *
+ * The first refill is kept small so a fresh context returns its first bytes
+ * quickly; each refill then doubles until the whole buffer is used.
+ */
+static size_t next_fill_size(const qrng_v3_ctx_t *ctx) {
+    if (ctx->buffer_fill == 0) {
+        return ctx->output_buffer_size < QRNG_V3_FIRST_FILL_SIZE ?
+               ctx->output_buffer_size : QRNG_V3_FIRST_FILL_SIZE;
+    }
+    if (ctx->buffer_fill >= ctx->output_buffer_size / 2) {
+        return ctx->output_buffer_size;
+    }
+    return ctx->buffer_fill * 2;
+}
+
 qrng_v3_error_t qrng_v3_init(qrng_v3_ctx_t **ctx_out) {
     qrng_v3_config_t config;
     qrng_v3_get_default_config(&config);
@@ -354,7 +400,9 @@ qrng_v3_error_t qrng_v3_init_with_config(
         .refill_threshold = config->entropy_pool_size / 4,
         .chunk_size = 4096,
         .enable_background_thread = config->enable_background_entropy,
-        .min_entropy = 4.0
+        .min_entropy = 4.0,
+        .defer_prefill = config->lazy_init,
+        .seed_file = config->seed_file
     };
     
     int pool_err = entropy_pool_init_with_config(&ctx->entropy_pool, &pool_config);
@@ -362,6 +410,7 @@ qrng_v3_error_t qrng_v3_init_with_config(
         free(ctx);
         return QRNG_V3_ERROR_ENTROPY_FAILURE;
     }
+    ctx->config.seed_file = ctx->entropy_pool->seed_path;  // Pool owns the copy
     
     // LAYER 2: Initialize quantum simulation engine
     ctx->quantum_state = calloc(1, sizeof(quantum_state_t));
@@ -397,14 +446,12 @@ qrng_v3_error_t qrng_v3_init_with_config(
         free(ctx);
         return QRNG_V3_ERROR_OUT_OF_MEMORY;
     }
-    ctx->buffer_pos = ctx->output_buffer_size;  // Force initial fill
+    ctx->buffer_pos = 0;
+    ctx->buffer_fill = 0;  // Force initial fill
     
-    // Initialize Bell test monitoring
-    if (config->enable_bell_monitoring) {
-        ctx->bell_monitor = calloc(1, sizeof(bell_test_monitor_t));
-        if (ctx->bell_monitor) {
-            bell_monitor_init(ctx->bell_monitor, 100);  // Track last 100 tests
-        }
+    // Initialize Bell test monitoring (lazy contexts create it on first test)
+    if (config->enable_bell_monitoring && !config->lazy_init) {
+        ensure_bell_monitor(ctx);
     }
     
     // Initialize Grover cache
@@ -414,7 +461,10 @@ qrng_v3_error_t qrng_v3_init_with_config(
     
     // Initialize performance monitoring
     if (config->enable_performance_monitoring) {
-        perf_monitor_init(&ctx->perf_monitor);
+        if (perf_monitor_init(&ctx->perf_monitor) == 0) {
+            // Optional: falls back to cycle timing when the kernel refuses
+            perf_monitor_enable_hw_counters(ctx->perf_monitor);
+        }
     }
     
     ctx->initialized = 1;
@@ -469,61 +519,76 @@ void qrng_v3_free(qrng_v3_ctx_t *ctx) {
 // RANDOM NUMBER GENERATION
 // ============================================================================
 
-qrng_v3_error_t qrng_v3_bytes(
+/**
+ * @brief Copy size bytes of output, refilling the output buffer as needed
+ *
+ * Bounded calls (ctx->entropy_bounded) refill at most
+ * QRNG_V3_BOUNDED_FILL_SIZE bytes at a time and check the deadline before
+ * each refill; a refill that ran short of entropy is discarded.
+ *
+ * @param copied Output: bytes written to buffer
+ */
+static qrng_v3_error_t generate_output(
     qrng_v3_ctx_t *ctx,
     uint8_t *buffer,
-    size_t size
+    size_t size,
+    size_t *copied
 ) {
-    VALIDATE_NOT_NULL(ctx, QRNG_V3_ERROR_NULL_CONTEXT);
-    VALIDATE_BUFFER(buffer, size, QRNG_V3_ERROR_NULL_BUFFER);
-    
-    if (!ctx->initialized) {
-        return QRNG_V3_ERROR_NOT_INITIALIZED;
-    }
-    
-    // Performance monitoring
-    if (ctx->perf_monitor) {
-        perf_monitor_start_operation(ctx->perf_monitor, PERF_OP_OUTPUT_GENERATION);
-    }
-    
     size_t bytes_copied = 0;
+    qrng_v3_error_t result = QRNG_V3_SUCCESS;
     
     while (bytes_copied < size) {
         // Refill buffer if needed
-        if (ctx->buffer_pos >= ctx->output_buffer_size) {
+        if (ctx->buffer_pos >= ctx->buffer_fill) {
             // Generate fresh quantum entropy
+            size_t fill = next_fill_size(ctx);
             int err;
             
+            if (ctx->entropy_bounded) {
+                if (ctx->entropy_deadline_ns != 0 && now_ns() >= ctx->entropy_deadline_ns) {
+                    result = QRNG_V3_ERROR_TIMEOUT;
+                    break;
+                }
+                if (fill > QRNG_V3_BOUNDED_FILL_SIZE) fill = QRNG_V3_BOUNDED_FILL_SIZE;
+                ctx->entropy_starved = 0;
+            }
+            
             switch (ctx->config.mode) {
                 case QRNG_V3_MODE_DIRECT:
-                    err = extract_quantum_entropy(ctx, ctx->output_buffer, ctx->output_buffer_size);
+                    err = extract_quantum_entropy(ctx, ctx->output_buffer, fill);
                     break;
                     
                 case QRNG_V3_MODE_GROVER:
                     // Grover-based entropy extraction
-                    err = extract_grover_entropy(ctx, ctx->output_buffer, ctx->output_buffer_size);
+                    err = extract_grover_entropy(ctx, ctx->output_buffer, fill);
                     break;
                     
                 case QRNG_V3_MODE_BELL_VERIFIED:
-                    err = extract_quantum_entropy(ctx, ctx->output_buffer, ctx->output_buffer_size);
+                    err = extract_quantum_entropy(ctx, ctx->output_buffer, fill);
                     break;
                     
                 default:
+                    *copied = bytes_copied;
                     return QRNG_V3_ERROR_INVALID_PARAM;
             }
             
+            if (ctx->entropy_bounded && ctx->entropy_starved) {
+                // Measurements ran without fresh entropy: drop the refill
+                result = ctx->entropy_deadline_ns != 0 ? QRNG_V3_ERROR_TIMEOUT
+                                                       : QRNG_V3_ERROR_WOULD_BLOCK;
+                break;
+            }
             if (err != 0) {
-                if (ctx->perf_monitor) {
-                    perf_monitor_end_operation(ctx->perf_monitor);
-                }
-                return QRNG_V3_ERROR_ENTROPY_FAILURE;
+                result = QRNG_V3_ERROR_ENTROPY_FAILURE;
+                break;
             }
             
             ctx->buffer_pos = 0;
+            ctx->buffer_fill = fill;
         }
         
         // Copy from buffer
-        size_t copy_size = ctx->output_buffer_size - ctx->buffer_pos;
+        size_t copy_size = ctx->buffer_fill - ctx->buffer_pos;
         if (copy_size > size - bytes_copied) {
             copy_size = size - bytes_copied;
         }
@@ -533,37 +598,80 @@ qrng_v3_error_t qrng_v3_bytes(
         bytes_copied += copy_size;
     }
     
+    *copied = bytes_copied;
+    return result;
+}
+
+/**
+ * @brief Run the periodic Bell test once bell_test_interval bytes have been served
+ */
+static qrng_v3_error_t run_due_bell_test(qrng_v3_ctx_t *ctx) {
+    if (!ctx->config.enable_bell_monitoring ||
+        ctx->config.bell_test_interval == 0 ||
+        ctx->bytes_since_bell_test < ctx->config.bell_test_interval) {
+        return QRNG_V3_SUCCESS;
+    }
+    
+    // Use enough measurements that the CHSH estimate is statistically
+    // tight (SE ~ 2/sqrt(N)); a small N made monitored generation
+    // spuriously trip the min-CHSH check on an unlucky draw.
+    bell_test_result_t result = qrng_v3_verify_quantum(ctx, 4000);
+
+    ensure_bell_monitor(ctx);
+    if (ctx->bell_monitor) {
+        bell_monitor_add_result(ctx->bell_monitor, &result);
+    }
+    
+    ctx->stats.bell_tests_performed++;
+    if (bell_test_confirms_quantum(&result)) {
+        ctx->stats.bell_tests_passed++;
+    }
+    
+    // Check if quantum behavior is maintained
+    if (result.chsh_value < ctx->config.min_acceptable_chsh) {
+        // Quantum behavior degraded - this shouldn't happen in simulation
+        // but good to check
+        return QRNG_V3_ERROR_BELL_TEST_FAILED;
+    }
+    
+    ctx->bytes_since_bell_test = 0;
+    return QRNG_V3_SUCCESS;
+}
+
+qrng_v3_error_t qrng_v3_bytes(
+    qrng_v3_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size
+) {
+    VALIDATE_NOT_NULL(ctx, QRNG_V3_ERROR_NULL_CONTEXT);
+    VALIDATE_BUFFER(buffer, size, QRNG_V3_ERROR_NULL_BUFFER);
+    
+    if (!ctx->initialized) {
+        return QRNG_V3_ERROR_NOT_INITIALIZED;
+    }
+    
+    // Performance monitoring
+    if (ctx->perf_monitor) {
+        perf_monitor_start_operation(ctx->perf_monitor, PERF_OP_OUTPUT_GENERATION);
+    }
+    
+    size_t bytes_copied = 0;
+    qrng_v3_error_t err = generate_output(ctx, buffer, size, &bytes_copied);
+    if (err != QRNG_V3_SUCCESS) {
+        if (ctx->perf_monitor) {
+            perf_monitor_end_operation(ctx->perf_monitor);
+        }
+        return err;
+    }
+    
     // Update statistics
     ctx->stats.bytes_generated += size;
     ctx->bytes_since_bell_test += size;
     
     // Bell test monitoring
-    if (ctx->config.enable_bell_monitoring && 
-        ctx->config.bell_test_interval > 0 &&
-        ctx->bytes_since_bell_test >= ctx->config.bell_test_interval) {
-        
-        // Use enough measurements that the CHSH estimate is statistically
-        // tight (SE ~ 2/sqrt(N)); a small N made monitored generation
-        // spuriously trip the min-CHSH check on an unlucky draw.
-        bell_test_result_t result = qrng_v3_verify_quantum(ctx, 4000);
-
-        if (ctx->bell_monitor) {
-            bell_monitor_add_result(ctx->bell_monitor, &result);
-        }
-        
-        ctx->stats.bell_tests_performed++;
-        if (bell_test_confirms_quantum(&result)) {
-            ctx->stats.bell_tests_passed++;
-        }
-        
-        // Check if quantum behavior is maintained
-        if (result.chsh_value < ctx->config.min_acceptable_chsh) {
-            // Quantum behavior degraded - this shouldn't happen in simulation
-            // but good to check
-            return QRNG_V3_ERROR_BELL_TEST_FAILED;
-        }
-        
-        ctx->bytes_since_bell_test = 0;
+    err = run_due_bell_test(ctx);
+    if (err != QRNG_V3_SUCCESS) {
+        return err;
     }
     
     if (ctx->perf_monitor) {
@@ -574,6 +682,102 @@ qrng_v3_error_t qrng_v3_bytes(
     return QRNG_V3_SUCCESS;
 }
 
+// ============================================================================
+// BOUNDED GENERATION
+// ============================================================================
+
+/**
+ * @brief Entropy callback used during try/deadline calls
+ *
+ * Never lets the entropy pool generate past the call's limit; on a
+ * shortfall it flags the context so the refill in progress is discarded.
+ */
+static int bounded_entropy_callback(void *user_data, uint8_t *buffer, size_t size) {
+    qrng_v3_ctx_t *ctx = (qrng_v3_ctx_t *)user_data;
+    int rc;
+    
+    if (ctx->entropy_deadline_ns == 0) {
+        rc = entropy_pool_try_bytes(ctx->entropy_pool, buffer, size, NULL);
+    } else {
+        uint64_t now = now_ns();
+        rc = now >= ctx->entropy_deadline_ns ? ENTROPY_POOL_TIMEOUT :
+             entropy_pool_get_bytes_deadline(ctx->entropy_pool, buffer, size,
+                                             ctx->entropy_deadline_ns - now, NULL);
+    }
+    
+    if (rc == ENTROPY_POOL_WOULD_BLOCK || rc == ENTROPY_POOL_TIMEOUT) {
+        ctx->entropy_starved = 1;
+        return -1;
+    }
+    return rc;
+}
+
+/**
+ * @brief Shared body of qrng_v3_try_bytes and qrng_v3_bytes_deadline
+ */
+static qrng_v3_error_t bytes_bounded(
+    qrng_v3_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    uint64_t deadline_ns,
+    size_t *filled
+) {
+    if (filled) *filled = 0;
+    VALIDATE_NOT_NULL(ctx, QRNG_V3_ERROR_NULL_CONTEXT);
+    VALIDATE_BUFFER(buffer, size, QRNG_V3_ERROR_NULL_BUFFER);
+    
+    if (!ctx->initialized) {
+        return QRNG_V3_ERROR_NOT_INITIALIZED;
+    }
+    
+    // Seeded contexts draw from a deterministic stream and never block
+    quantum_entropy_ctx_t saved = ctx->entropy_ctx;
+    int pooled = ctx->entropy_ctx.get_bytes == entropy_pool_callback;
+    if (pooled) {
+        quantum_entropy_init(&ctx->entropy_ctx, bounded_entropy_callback, ctx);
+    }
+    ctx->entropy_bounded = 1;
+    ctx->entropy_deadline_ns = deadline_ns;
+    
+    size_t bytes_copied = 0;
+    qrng_v3_error_t err = generate_output(ctx, buffer, size, &bytes_copied);
+    
+    ctx->entropy_bounded = 0;
+    ctx->entropy_ctx = saved;
+    
+    ctx->stats.bytes_generated += bytes_copied;
+    ctx->bytes_since_bell_test += bytes_copied;
+    if (filled) *filled = bytes_copied;
+    
+    // A due Bell test costs a fixed 4000 measurements; try calls leave it to
+    // the next call that may block, deadline calls run it if time remains
+    if (err == QRNG_V3_SUCCESS && deadline_ns != 0 && now_ns() < deadline_ns) {
+        err = run_due_bell_test(ctx);
+    }
+    return err;
+}
+
+qrng_v3_error_t qrng_v3_try_bytes(
+    qrng_v3_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    size_t *filled
+) {
+    return bytes_bounded(ctx, buffer, size, 0, filled);
+}
+
+qrng_v3_error_t qrng_v3_bytes_deadline(
+    qrng_v3_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    uint64_t timeout_ns,
+    size_t *filled
+) {
+    uint64_t start = now_ns();
+    uint64_t deadline = timeout_ns > UINT64_MAX - start ? UINT64_MAX : start + timeout_ns;
+    return bytes_bounded(ctx, buffer, size, deadline, filled);
+}
+
 qrng_v3_error_t qrng_v3_uint64(qrng_v3_ctx_t *ctx, uint64_t *value) {
     VALIDATE_NOT_NULL(ctx, QRNG_V3_ERROR_NULL_CONTEXT);
     VALIDATE_NOT_NULL(value, QRNG_V3_ERROR_NULL_BUFFER);
@@ -912,6 +1116,24 @@ qrng_v3_error_t qrng_v3_grover_multi_target(
 // QUANTUM VERIFICATION
 // ============================================================================
 
+/**
+ * @brief Fold one CHSH value into the Bell statistics
+ */
+static void record_chsh(qrng_v3_ctx_t *ctx, double chsh) {
+    if (chsh > ctx->stats.max_chsh) {
+        ctx->stats.max_chsh = chsh;
+    }
+    if (ctx->stats.min_chsh == 0.0 || chsh < ctx->stats.min_chsh) {
+        ctx->stats.min_chsh = chsh;
+    }
+    
+    // Update running average
+    double total = ctx->stats.average_chsh * ctx->stats.bell_tests_performed;
+    total += chsh;
+    ctx->stats.bell_tests_performed++;
+    ctx->stats.average_chsh = total / ctx->stats.bell_tests_performed;
+}
+
 bell_test_result_t qrng_v3_verify_quantum(
     qrng_v3_ctx_t *ctx,
     size_t num_measurements
@@ -932,21 +1154,37 @@ bell_test_result_t qrng_v3_verify_quantum(
         &ctx->entropy_ctx
     );
     
-    // Update statistics
-    if (result.chsh_value > ctx->stats.max_chsh) {
-        ctx->stats.max_chsh = result.chsh_value;
+    record_chsh(ctx, result.chsh_value);
+    return result;
+}
+
+qrng_v3_error_t qrng_v3_snapshot_state(const qrng_v3_ctx_t *ctx, quantum_state_t *state) {
+    VALIDATE_NOT_NULL(ctx, QRNG_V3_ERROR_NULL_CONTEXT);
+    VALIDATE_NOT_NULL(state, QRNG_V3_ERROR_NULL_BUFFER);
+
+    if (!ctx->initialized || !ctx->quantum_state) {
+        return QRNG_V3_ERROR_NOT_INITIALIZED;
     }
-    if (ctx->stats.min_chsh == 0.0 || result.chsh_value < ctx->stats.min_chsh) {
-        ctx->stats.min_chsh = result.chsh_value;
+    if (quantum_state_clone(state, ctx->quantum_state) != QS_SUCCESS) {
+        return QRNG_V3_ERROR_OUT_OF_MEMORY;
     }
-    
-    // Update running average
-    double total = ctx->stats.average_chsh * ctx->stats.bell_tests_performed;
-    total += result.chsh_value;
-    ctx->stats.bell_tests_performed++;
-    ctx->stats.average_chsh = total / ctx->stats.bell_tests_performed;
-    
-    return result;
+    return QRNG_V3_SUCCESS;
+}
+
+qrng_v3_error_t qrng_v3_record_verification(qrng_v3_ctx_t *ctx,
+                                            const bell_test_result_t *result) {
+    VALIDATE_NOT_NULL(ctx, QRNG_V3_ERROR_NULL_CONTEXT);
+    VALIDATE_NOT_NULL(result, QRNG_V3_ERROR_NULL_BUFFER);
+
+    record_chsh(ctx, result->chsh_value);
+    ensure_bell_monitor(ctx);
+    if (ctx->bell_monitor) {
+        bell_monitor_add_result(ctx->bell_monitor, result);
+    }
+    if (bell_test_confirms_quantum(result)) {
+        ctx->stats.bell_tests_passed++;
+    }
+    return QRNG_V3_SUCCESS;
 }
 
 double qrng_v3_get_entanglement_entropy(const qrng_v3_ctx_t *ctx) {
@@ -1132,6 +1370,10 @@ const char* qrng_v3_error_string(qrng_v3_error_t error) {
             return "Out of memory";
         case QRNG_V3_ERROR_NOT_INITIALIZED:
             return "Context not initialized";
+        case QRNG_V3_ERROR_WOULD_BLOCK:
+            return "Output not available without blocking";
+        case QRNG_V3_ERROR_TIMEOUT:
+            return "Deadline passed before the request was filled";
         default:
             return "Unknown error";
     }
@@ -80,7 +80,11 @@ typedef struct {
     
     // Performance
     int enable_simd;                /**< Use SIMD optimizations */
-    int enable_performance_monitoring; /**< Track performance metrics */
+    int enable_performance_monitoring; /**< Track performance metrics (+ HW counters on Linux) */
+    
+    // Startup
+    int lazy_init;                  /**< Defer pool prefill and Bell monitor setup until first use */
+    const char *seed_file;          /**< Entropy pool seed file (seed_file.h), NULL for none (copied at init) */
 } qrng_v3_config_t;
 
 /**
@@ -95,7 +99,9 @@ typedef enum {
     QRNG_V3_ERROR_QUANTUM_INIT = -5,
     QRNG_V3_ERROR_BELL_TEST_FAILED = -6,
     QRNG_V3_ERROR_OUT_OF_MEMORY = -7,
-    QRNG_V3_ERROR_NOT_INITIALIZED = -8
+    QRNG_V3_ERROR_NOT_INITIALIZED = -8,
+    QRNG_V3_ERROR_WOULD_BLOCK = -9,     /**< try call ran out of pooled entropy; partial fill */
+    QRNG_V3_ERROR_TIMEOUT = -10         /**< Deadline passed; partial fill */
 } qrng_v3_error_t;
 
 /**
@@ -145,6 +151,7 @@ typedef struct {
     uint8_t *output_buffer;
     size_t output_buffer_size;
     size_t buffer_pos;
+    size_t buffer_fill;             /**< Valid bytes in output_buffer; ramps up to output_buffer_size */
     
     // Grover caching
     uint64_t *grover_cache;
@@ -156,6 +163,11 @@ typedef struct {
     // Statistics
     qrng_v3_stats_t stats;
     
+    // Bounded generation (qrng_v3_try_bytes / qrng_v3_bytes_deadline)
+    int entropy_bounded;            /**< A try/deadline call is in progress */
+    uint64_t entropy_deadline_ns;   /**< CLOCK_MONOTONIC deadline; 0 = try (pooled entropy only) */
+    int entropy_starved;            /**< The current refill ran short of entropy */
+    
     // State
     int initialized;
 } qrng_v3_ctx_t;
@@ -197,6 +209,10 @@ qrng_v3_error_t qrng_v3_init(qrng_v3_ctx_t **ctx);
 /**
  * @brief Initialize with custom configuration
  * 
+ * With config->lazy_init set, the entropy pool starts empty and is filled
+ * by its background thread, and the Bell monitor is created on the first
+ * periodic test, so initialization does no entropy collection at all.
+ * 
  * @param ctx Output context pointer
  * @param config Custom configuration
  * @return QRNG_V3_SUCCESS or error code
@@ -240,6 +256,51 @@ qrng_v3_error_t qrng_v3_bytes(
     size_t size
 );
 
+/**
+ * @brief Generate random bytes without blocking on the entropy source
+ *
+ * Serves buffered output first, then keeps generating while the entropy
+ * pool holds enough tested entropy. The hardware source never runs on the
+ * caller's thread. A refill that runs short is discarded; the refills
+ * already copied are reported in *filled. A due Bell test is left to the
+ * next qrng_v3_bytes() or qrng_v3_bytes_deadline() call.
+ *
+ * @param ctx Quantum RNG context
+ * @param buffer Output buffer
+ * @param size Number of bytes to generate
+ * @param filled Output: bytes written (may be NULL)
+ * @return QRNG_V3_SUCCESS, QRNG_V3_ERROR_WOULD_BLOCK or error code
+ */
+qrng_v3_error_t qrng_v3_try_bytes(
+    qrng_v3_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    size_t *filled
+);
+
+/**
+ * @brief Generate random bytes, giving up after timeout_ns
+ *
+ * Output is refilled in steps of at most 1 KB and the entropy pool may
+ * generate on this thread only until the deadline (see
+ * entropy_pool_get_bytes_deadline), so the call overruns by at most one
+ * step, plus one Bell test when one falls due before the deadline.
+ *
+ * @param ctx Quantum RNG context
+ * @param buffer Output buffer
+ * @param size Number of bytes to generate
+ * @param timeout_ns Time allowed, from the call
+ * @param filled Output: bytes written (may be NULL)
+ * @return QRNG_V3_SUCCESS, QRNG_V3_ERROR_TIMEOUT or error code
+ */
+qrng_v3_error_t qrng_v3_bytes_deadline(
+    qrng_v3_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    uint64_t timeout_ns,
+    size_t *filled
+);
+
 /**
  * @brief Generate uint64 using quantum simulation
  * 
@@ -348,6 +409,31 @@ bell_test_result_t qrng_v3_verify_quantum(
     size_t num_measurements
 );
 
+/**
+ * @brief Copy the context's quantum state
+ *
+ * Lets a caller that serialises access to ctx take the copy under its own
+ * lock, run bell_test_chsh() on it after releasing the lock, and hand the
+ * result back with qrng_v3_record_verification().
+ *
+ * @param ctx Quantum RNG context
+ * @param state Output state; release with quantum_state_free()
+ * @return QRNG_V3_SUCCESS or error code
+ */
+qrng_v3_error_t qrng_v3_snapshot_state(const qrng_v3_ctx_t *ctx, quantum_state_t *state);
+
+/**
+ * @brief Count a Bell test run on a snapshot as one of the context's own
+ *
+ * Feeds the Bell statistics, history and qrng_v3_is_quantum_verified().
+ *
+ * @param ctx Quantum RNG context
+ * @param result Test result
+ * @return QRNG_V3_SUCCESS or error code
+ */
+qrng_v3_error_t qrng_v3_record_verification(qrng_v3_ctx_t *ctx,
+                                            const bell_test_result_t *result);
+
 /**
  * @brief Get entanglement entropy of current quantum state
  * 
@@ -420,7 +506,8 @@ void qrng_v3_print_stats(const qrng_v3_ctx_t *ctx);
  * @brief Get Bell test history
  * 
  * @param ctx Quantum RNG context
- * @return Bell test monitor (read-only)
+ * @return Bell test monitor (read-only), or NULL if monitoring is off or,
+ *         with lazy_init, no periodic test has run yet
  */
 const bell_test_monitor_t* qrng_v3_get_bell_history(const qrng_v3_ctx_t *ctx);
 
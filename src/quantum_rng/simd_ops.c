@@ -13,9 +13,8 @@
     #ifdef __SSE3__
         #include <pmmintrin.h>  // SSE3: _mm_hadd_pd, _mm_addsub_pd (used below)
     #endif
-    #ifdef __AVX2__
-        #include <immintrin.h>  // AVX2
-    #endif
+    // AVX2, plus the SSSE3/AVX2 encoders built with target attributes
+    #include <immintrin.h>
 #endif
 
 #if defined(__ARM_NEON) || defined(__ARM_NEON__)
@@ -723,4 +722,295 @@ uint64_t simd_fast_measurement_sample(
     // For now, use the cumulative search (already optimized)
     // Could be further optimized with probability pre-computation if needed
     return simd_cumulative_probability_search(amplitudes, n, random_threshold);
-}
\ No newline at end of file
+}
+
+// ============================================================================
+// OUTPUT ENCODING
+// ============================================================================
+
+static const char encode_hex_digits[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7',
+    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+};
+
+static const char encode_base64_alphabet[64] = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M',
+    'N', 'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm',
+    'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+};
+
+static size_t hex_encode_scalar(const uint8_t *in, size_t n, char *out) {
+    for (size_t i = 0; i < n; i++) {
+        out[2 * i] = encode_hex_digits[in[i] >> 4];
+        out[2 * i + 1] = encode_hex_digits[in[i] & 0x0F];
+    }
+    return 2 * n;
+}
+
+static size_t base64_encode_scalar(const uint8_t *in, size_t n, char *out) {
+    size_t o = 0;
+    size_t i = 0;
+    for (; i + 3 <= n; i += 3) {
+        uint32_t v = ((uint32_t)in[i] << 16) | ((uint32_t)in[i + 1] << 8) | in[i + 2];
+        out[o++] = encode_base64_alphabet[(v >> 18) & 0x3F];
+        out[o++] = encode_base64_alphabet[(v >> 12) & 0x3F];
+        out[o++] = encode_base64_alphabet[(v >> 6) & 0x3F];
+        out[o++] = encode_base64_alphabet[v & 0x3F];
+    }
+    if (i < n) {
+        uint32_t v = (uint32_t)in[i] << 16;
+        if (i + 1 < n) v |= (uint32_t)in[i + 1] << 8;
+        out[o++] = encode_base64_alphabet[(v >> 18) & 0x3F];
+        out[o++] = encode_base64_alphabet[(v >> 12) & 0x3F];
+        out[o++] = (i + 1 < n) ? encode_base64_alphabet[(v >> 6) & 0x3F] : '=';
+        out[o++] = '=';
+    }
+    return o;
+}
+
+#if defined(__x86_64__)
+
+/*
+ * The build only guarantees SSE3, so the SSSE3 and AVX2 encoders are
+ * compiled per function with target attributes and chosen at runtime.
+ *
+ * Base64 follows Mula/Lemire: pshufb gathers each 3-byte group into a
+ * 32-bit lane, two multiplies move the four 6-bit fields into separate
+ * bytes, and a 16-entry pshufb table maps each index range to its ASCII
+ * offset.
+ */
+
+__attribute__((target("ssse3")))
+static size_t hex_encode_ssse3(const uint8_t *in, size_t n, char *out) {
+    const __m128i lut = _mm_loadu_si128((const __m128i *)encode_hex_digits);
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), low_nibble));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, low_nibble));
+        _mm_storeu_si128((__m128i *)(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    hex_encode_scalar(in + i, n - i, out + 2 * i);
+    return 2 * n;
+}
+
+__attribute__((target("avx2")))
+static size_t hex_encode_avx2(const uint8_t *in, size_t n, char *out) {
+    const __m256i lut = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128((const __m128i *)encode_hex_digits));
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(in + i));
+        __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibble));
+        __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, low_nibble));
+        // Unpack works per 128-bit lane: lo_pairs holds bytes 0-7 and
+        // 16-23, hi_pairs 8-15 and 24-31
+        __m256i lo_pairs = _mm256_unpacklo_epi8(hi, lo);
+        __m256i hi_pairs = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i *)(out + 2 * i),
+                            _mm256_permute2x128_si256(lo_pairs, hi_pairs, 0x20));
+        _mm256_storeu_si256((__m256i *)(out + 2 * i + 32),
+                            _mm256_permute2x128_si256(lo_pairs, hi_pairs, 0x31));
+    }
+    if (i < n) hex_encode_ssse3(in + i, n - i, out + 2 * i);
+    return 2 * n;
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i base64_indices_ssse3(__m128i v) {
+    v = _mm_shuffle_epi8(v, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0FC0FC00)),
+                                 _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003F03F0)),
+                                 _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t0, t1);
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i base64_ascii_ssse3(__m128i idx) {
+    const __m128i offsets = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+    __m128i sel = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+    __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), idx);
+    sel = _mm_or_si128(sel, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(idx, _mm_shuffle_epi8(offsets, sel));
+}
+
+__attribute__((target("ssse3")))
+static size_t base64_encode_ssse3(const uint8_t *in, size_t n, char *out) {
+    size_t i = 0, o = 0;
+    // Each step consumes 12 bytes but loads 16
+    for (; i + 16 <= n; i += 12, o += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + i));
+        _mm_storeu_si128((__m128i *)(out + o), base64_ascii_ssse3(base64_indices_ssse3(v)));
+    }
+    return o + base64_encode_scalar(in + i, n - i, out + o);
+}
+
+__attribute__((target("avx2")))
+static size_t base64_encode_avx2(const uint8_t *in, size_t n, char *out) {
+    const __m256i gather = _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    size_t i = 0, o = 0;
+    // 24 bytes per step: 12 in each lane, the high lane loaded from in+12
+    for (; i + 28 <= n; i += 24, o += 32) {
+        __m256i v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(in + i))),
+            _mm_loadu_si128((const __m128i *)(in + i + 12)), 1);
+        v = _mm256_shuffle_epi8(v, gather);
+        __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00)),
+                                        _mm256_set1_epi32(0x04000040));
+        __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0)),
+                                        _mm256_set1_epi32(0x01000010));
+        __m256i idx = _mm256_or_si256(t0, t1);
+        __m256i sel = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+        __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx);
+        sel = _mm256_or_si256(sel, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+        _mm256_storeu_si256((__m256i *)(out + o),
+                            _mm256_add_epi8(idx, _mm256_shuffle_epi8(offsets, sel)));
+    }
+    return o + base64_encode_ssse3(in + i, n - i, out + o);
+}
+
+#elif defined(__aarch64__)
+
+static size_t hex_encode_neon(const uint8_t *in, size_t n, char *out) {
+    const uint8x16_t lut = vld1q_u8((const uint8_t *)encode_hex_digits);
+    const uint8x16_t low_nibble = vdupq_n_u8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t v = vld1q_u8(in + i);
+        uint8x16x2_t pairs;
+        pairs.val[0] = vqtbl1q_u8(lut, vshrq_n_u8(v, 4));
+        pairs.val[1] = vqtbl1q_u8(lut, vandq_u8(v, low_nibble));
+        vst2q_u8((uint8_t *)out + 2 * i, pairs);
+    }
+    hex_encode_scalar(in + i, n - i, out + 2 * i);
+    return 2 * n;
+}
+
+static size_t base64_encode_neon(const uint8_t *in, size_t n, char *out) {
+    const uint8_t *alphabet = (const uint8_t *)encode_base64_alphabet;
+    uint8x16x4_t table;
+    table.val[0] = vld1q_u8(alphabet);
+    table.val[1] = vld1q_u8(alphabet + 16);
+    table.val[2] = vld1q_u8(alphabet + 32);
+    table.val[3] = vld1q_u8(alphabet + 48);
+    const uint8x16_t mask6 = vdupq_n_u8(0x3F);
+    size_t i = 0, o = 0;
+    // vld3/vst4 de-interleave 16 groups of 3 bytes and interleave 16 groups of 4 chars
+    for (; i + 48 <= n; i += 48, o += 64) {
+        uint8x16x3_t src = vld3q_u8(in + i);
+        uint8x16x4_t idx;
+        idx.val[0] = vshrq_n_u8(src.val[0], 2);
+        idx.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(src.val[0], 4), vshrq_n_u8(src.val[1], 4)), mask6);
+        idx.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(src.val[1], 2), vshrq_n_u8(src.val[2], 6)), mask6);
+        idx.val[3] = vandq_u8(src.val[2], mask6);
+        uint8x16x4_t chars;
+        chars.val[0] = vqtbl4q_u8(table, idx.val[0]);
+        chars.val[1] = vqtbl4q_u8(table, idx.val[1]);
+        chars.val[2] = vqtbl4q_u8(table, idx.val[2]);
+        chars.val[3] = vqtbl4q_u8(table, idx.val[3]);
+        vst4q_u8((uint8_t *)out + o, chars);
+    }
+    return o + base64_encode_scalar(in + i, n - i, out + o);
+}
+
+#endif
+
+typedef size_t (*encode_fn_t)(const uint8_t *in, size_t n, char *out);
+
+static encode_fn_t hex_encoder = NULL;
+static encode_fn_t base64_encoder = NULL;
+
+// Encoders for one path, or -1 if this build or CPU lacks it
+static int encoders_for(simd_encoder_t which, encode_fn_t *hex, encode_fn_t *b64) {
+#if defined(__x86_64__)
+    simd_capabilities_t caps = simd_detect_capabilities();
+    if (which == SIMD_ENCODER_AUTO) {
+        which = caps.has_avx2 ? SIMD_ENCODER_AVX2 :
+                caps.has_ssse3 ? SIMD_ENCODER_SSSE3 : SIMD_ENCODER_SCALAR;
+    }
+#elif defined(__aarch64__)
+    if (which == SIMD_ENCODER_AUTO) which = SIMD_ENCODER_NEON;
+#else
+    if (which == SIMD_ENCODER_AUTO) which = SIMD_ENCODER_SCALAR;
+#endif
+
+    switch (which) {
+        case SIMD_ENCODER_SCALAR:
+            *hex = hex_encode_scalar;
+            *b64 = base64_encode_scalar;
+            return 0;
+#if defined(__x86_64__)
+        case SIMD_ENCODER_SSSE3:
+            if (!caps.has_ssse3) return -1;
+            *hex = hex_encode_ssse3;
+            *b64 = base64_encode_ssse3;
+            return 0;
+        case SIMD_ENCODER_AVX2:
+            if (!caps.has_avx2) return -1;
+            *hex = hex_encode_avx2;
+            *b64 = base64_encode_avx2;
+            return 0;
+#elif defined(__aarch64__)
+        case SIMD_ENCODER_NEON:
+            *hex = hex_encode_neon;
+            *b64 = base64_encode_neon;
+            return 0;
+#endif
+        default:
+            return -1;
+    }
+}
+
+static void install_encoders(encode_fn_t hex, encode_fn_t b64) {
+    __atomic_store_n(&base64_encoder, b64, __ATOMIC_RELAXED);
+    __atomic_store_n(&hex_encoder, hex, __ATOMIC_RELEASE);
+}
+
+/*
+ * Pick the widest encoder this CPU supports. Every caller resolves the same
+ * pointers, so a race on first use only repeats the same stores.
+ */
+static void select_encoders(void) {
+    encode_fn_t hex, b64;
+    encoders_for(SIMD_ENCODER_AUTO, &hex, &b64);
+    install_encoders(hex, b64);
+}
+
+int simd_encode_select(simd_encoder_t which) {
+    encode_fn_t hex, b64;
+    if (encoders_for(which, &hex, &b64) != 0) return -1;
+    install_encoders(hex, b64);
+    return 0;
+}
+
+size_t simd_encode_hex(const uint8_t *in, size_t n, char *out) {
+    if (!in || !out || n == 0) return 0;
+    encode_fn_t fn = __atomic_load_n(&hex_encoder, __ATOMIC_ACQUIRE);
+    if (!fn) {
+        select_encoders();
+        fn = hex_encoder;
+    }
+    return fn(in, n, out);
+}
+
+size_t simd_encode_base64(const uint8_t *in, size_t n, char *out) {
+    if (!in || !out || n == 0) return 0;
+    if (!__atomic_load_n(&hex_encoder, __ATOMIC_ACQUIRE)) select_encoders();
+    return __atomic_load_n(&base64_encoder, __ATOMIC_RELAXED)(in, n, out);
+}
@@ -247,6 +247,58 @@ uint64_t simd_fast_measurement_sample(
     double random_threshold
 );
 
+// ============================================================================
+// OUTPUT ENCODING
+// ============================================================================
+
+/**
+ * @brief Encode bytes as lowercase hex
+ *
+ * Uses a pshufb/tbl nibble lookup (AVX2, SSSE3 or NEON, picked at runtime
+ * on x86) with a scalar tail. No terminator is written.
+ *
+ * @param in Input bytes
+ * @param n Number of input bytes
+ * @param out Output buffer, at least 2*n bytes
+ * @return Number of characters written (2*n)
+ */
+size_t simd_encode_hex(const uint8_t *in, size_t n, char *out);
+
+/**
+ * @brief Encode bytes as standard base64 (RFC 4648, '=' padded)
+ *
+ * Vectorized the same way as simd_encode_hex; the scalar tail handles the
+ * last partial group and padding. No terminator is written.
+ *
+ * @param in Input bytes
+ * @param n Number of input bytes
+ * @param out Output buffer, at least 4*((n+2)/3) bytes
+ * @return Number of characters written
+ */
+size_t simd_encode_base64(const uint8_t *in, size_t n, char *out);
+
+/**
+ * @brief Encoder implementations behind simd_encode_hex/simd_encode_base64
+ */
+typedef enum {
+    SIMD_ENCODER_AUTO,      /**< Widest one this CPU supports (the default) */
+    SIMD_ENCODER_SCALAR,
+    SIMD_ENCODER_SSSE3,     /**< x86-64 */
+    SIMD_ENCODER_AVX2,      /**< x86-64 */
+    SIMD_ENCODER_NEON       /**< AArch64 */
+} simd_encoder_t;
+
+/**
+ * @brief Route both encoders through one implementation
+ *
+ * For tests and benchmarks that compare paths; process-wide, and not meant
+ * to change while other threads are encoding.
+ *
+ * @param which Implementation to use
+ * @return 0 on success, -1 if this build or CPU does not have it
+ */
+int simd_encode_select(simd_encoder_t which);
+
 #ifdef __cplusplus
 }
 #endif
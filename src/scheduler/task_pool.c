@@ -0,0 +1,889 @@
+/**
+ * @file task_pool.c
+ * @brief Work-stealing pool behind task_pool.h
+ */
+
+#define _GNU_SOURCE  // sched_getcpu, pthread_setaffinity_np
+#include "task_pool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <strings.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sched.h>
+
+#define TASK_POOL_DEFAULT_EXTERNAL_SLOTS 4
+#define TASK_QUEUE_INITIAL_CAPACITY 64
+
+#define STAT_ADD(pool, field, n) \
+    __atomic_fetch_add(&(pool)->stats.field, (uint64_t)(n), __ATOMIC_RELAXED)
+
+typedef struct {
+    task_fn fn;
+    void *arg;
+    task_group_t *group;
+} task_t;
+
+/**
+ * @brief Mutex-protected ring; owners pop the back, thieves the front
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    task_t *items;
+    size_t capacity;
+    size_t head;
+    size_t count;                   /**< Read without the lock as a hint */
+} task_queue_t;
+
+typedef struct {
+    task_pool_t *pool;
+    task_queue_t deque;
+    int index;
+    int node;                       /**< Scheduling node */
+    int cpu;                        /**< Pinned CPU, or -1 */
+    int *node_cpus;                 /**< CPUs to bind to (AFFINITY_NODE), or NULL */
+    size_t num_node_cpus;
+    int external;
+    int active;                     /**< External slot in use (under idle_lock) */
+    uint64_t epoch;                 /**< release_epoch when the external thread joined */
+    uint32_t rng;                   /**< Victim selection */
+} worker_t;
+
+struct task_pool {
+    task_pool_config_t config;
+    size_t num_workers;             /**< Internal workers plus external slots */
+    worker_t *workers;
+    pthread_t *threads;
+    size_t threads_started;
+
+    size_t num_nodes;
+    task_queue_t *node_queues;
+    size_t next_queue;              /**< Round-robin for outside submissions */
+    int *cpu_node;                  /**< CPU number -> scheduling node (-1 = unknown) */
+    size_t cpu_node_len;
+
+    // Sleeping workers and group waiters; also guards shutdown and externals
+    pthread_mutex_t idle_lock;
+    pthread_cond_t idle_cond;
+    size_t queued;                  /**< Tasks submitted and not yet taken */
+    size_t sleepers;
+    int shutdown;
+    uint64_t release_epoch;
+    size_t external_active;
+
+    task_pool_stats_t stats;
+};
+
+static __thread worker_t *tls_worker;
+
+static const char *error_strings[] = {
+    "Success",
+    "NULL pointer",
+    "Invalid parameter",
+    "Out of memory",
+    "Thread creation failed",
+    "Pool is shutting down",
+    "No free external slot",
+    "Default pool already in use"
+};
+
+const char* task_pool_error_string(task_pool_error_t error) {
+    int idx = -(int)error;
+    if (idx < 0 || idx >= (int)(sizeof(error_strings) / sizeof(error_strings[0]))) {
+        return "Unknown error";
+    }
+    return error_strings[idx];
+}
+
+// ============================================================================
+// TASK QUEUES
+// ============================================================================
+
+static int queue_init(task_queue_t *q) {
+    q->items = malloc(TASK_QUEUE_INITIAL_CAPACITY * sizeof(*q->items));
+    if (!q->items) return -1;
+    q->capacity = TASK_QUEUE_INITIAL_CAPACITY;
+    q->head = 0;
+    q->count = 0;
+    pthread_mutex_init(&q->lock, NULL);
+    return 0;
+}
+
+static void queue_destroy(task_queue_t *q) {
+    if (!q->items) return;
+    pthread_mutex_destroy(&q->lock);
+    free(q->items);
+    q->items = NULL;
+}
+
+static int queue_push(task_queue_t *q, const task_t *task) {
+    pthread_mutex_lock(&q->lock);
+    if (q->count == q->capacity) {
+        task_t *grown = malloc(2 * q->capacity * sizeof(*grown));
+        if (!grown) {
+            pthread_mutex_unlock(&q->lock);
+            return -1;
+        }
+        for (size_t i = 0; i < q->count; i++) grown[i] = q->items[(q->head + i) % q->capacity];
+        free(q->items);
+        q->items = grown;
+        q->capacity *= 2;
+        q->head = 0;
+    }
+    q->items[(q->head + q->count) % q->capacity] = *task;
+    __atomic_store_n(&q->count, q->count + 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+static int queue_pop(task_queue_t *q, task_t *task, int newest) {
+    if (__atomic_load_n(&q->count, __ATOMIC_ACQUIRE) == 0) return 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->count == 0) {
+        pthread_mutex_unlock(&q->lock);
+        return 0;
+    }
+    if (newest) {
+        *task = q->items[(q->head + q->count - 1) % q->capacity];
+    } else {
+        *task = q->items[q->head];
+        q->head = (q->head + 1) % q->capacity;
+    }
+    __atomic_store_n(&q->count, q->count - 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&q->lock);
+    return 1;
+}
+
+// ============================================================================
+// TOPOLOGY
+// ============================================================================
+
+typedef struct {
+    int cpu;
+    int node;
+} cpu_info_t;
+
+#ifdef __linux__
+/**
+ * @brief Mark the CPUs of a sysfs cpulist ("0-3,8-11") with node
+ */
+static void parse_cpulist(const char *list, int node, int *node_of, size_t len) {
+    const char *p = list;
+    while (*p) {
+        char *end;
+        long lo = strtol(p, &end, 10);
+        if (end == p) break;
+        long hi = lo;
+        if (*end == '-') {
+            p = end + 1;
+            hi = strtol(p, &end, 10);
+        }
+        for (long c = lo; c <= hi; c++) {
+            if (c >= 0 && (size_t)c < len) node_of[c] = node;
+        }
+        p = (*end == ',') ? end + 1 : end;
+        if (*p == '\n') break;
+    }
+}
+#endif
+
+/**
+ * @brief Usable CPUs, sorted by node; nodes are numbered densely from 0
+ *
+ * @return Number of CPUs (at least 1); *num_nodes receives the node count
+ */
+static size_t detect_topology(cpu_info_t **out, size_t *num_nodes) {
+    *num_nodes = 1;
+#ifdef __linux__
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        int node_of[CPU_SETSIZE];
+        for (int c = 0; c < CPU_SETSIZE; c++) node_of[c] = 0;
+        for (int node = 0; node < TASK_POOL_MAX_NODES; node++) {
+            char path[96], list[1024];
+            snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+            FILE *f = fopen(path, "r");
+            if (!f) continue;
+            if (fgets(list, sizeof(list), f)) parse_cpulist(list, node, node_of, CPU_SETSIZE);
+            fclose(f);
+        }
+
+        // Renumber the nodes that have usable CPUs to 0..k-1
+        int dense[TASK_POOL_MAX_NODES];
+        for (int i = 0; i < TASK_POOL_MAX_NODES; i++) dense[i] = -1;
+        size_t count = 0, nodes = 0;
+        for (int c = 0; c < CPU_SETSIZE; c++) {
+            if (!CPU_ISSET(c, &allowed)) continue;
+            count++;
+            if (dense[node_of[c]] < 0) dense[node_of[c]] = (int)nodes++;
+        }
+        cpu_info_t *cpus = count ? malloc(count * sizeof(*cpus)) : NULL;
+        if (cpus) {
+            size_t k = 0;
+            for (size_t n = 0; n < nodes; n++) {
+                for (int c = 0; c < CPU_SETSIZE; c++) {
+                    if (CPU_ISSET(c, &allowed) && (size_t)dense[node_of[c]] == n) {
+                        cpus[k].cpu = c;
+                        cpus[k].node = (int)n;
+                        k++;
+                    }
+                }
+            }
+            *out = cpus;
+            *num_nodes = nodes;
+            return count;
+        }
+    }
+#endif
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t count = online > 0 ? (size_t)online : 1;
+    cpu_info_t *cpus = malloc(count * sizeof(*cpus));
+    if (!cpus) {
+        *out = NULL;
+        return 1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        cpus[i].cpu = -1;
+        cpus[i].node = 0;
+    }
+    *out = cpus;
+    return count;
+}
+
+static void bind_current_thread(const worker_t *w) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (w->cpu >= 0) {
+        CPU_SET(w->cpu, &set);
+    } else if (w->node_cpus) {
+        for (size_t i = 0; i < w->num_node_cpus; i++) CPU_SET(w->node_cpus[i], &set);
+    } else {
+        return;
+    }
+    // Best effort: a restricted container may refuse
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)w;
+#endif
+}
+
+/**
+ * @brief Assign every internal worker a node and, per policy, CPUs
+ */
+static int place_workers(task_pool_t *pool) {
+    cpu_info_t *cpus = NULL;
+    size_t nodes = 1;
+    size_t ncpu = detect_topology(&cpus, &nodes);
+    if (!cpus) return -1;
+
+    task_pool_affinity_t policy = pool->config.affinity;
+    if (policy == TASK_POOL_AFFINITY_NONE || cpus[0].cpu < 0) {
+        policy = TASK_POOL_AFFINITY_NONE;
+        nodes = 1;
+    }
+
+    size_t node_start[TASK_POOL_MAX_NODES + 1] = {0};
+    for (size_t i = 0; i < ncpu; i++) node_start[cpus[i].node + 1]++;
+    for (size_t n = 0; n < nodes; n++) node_start[n + 1] += node_start[n];
+
+    int raw_node[pool->config.num_threads + 1];
+    for (size_t i = 0; i < pool->config.num_threads; i++) {
+        worker_t *w = &pool->workers[i];
+        w->cpu = -1;
+        raw_node[i] = 0;
+        if (policy == TASK_POOL_AFFINITY_COMPACT) {
+            const cpu_info_t *c = &cpus[i % ncpu];
+            w->cpu = c->cpu;
+            raw_node[i] = c->node;
+        } else if (policy == TASK_POOL_AFFINITY_SCATTER) {
+            size_t n = i % nodes;
+            size_t size = node_start[n + 1] - node_start[n];
+            const cpu_info_t *c = &cpus[node_start[n] + (i / nodes) % size];
+            w->cpu = c->cpu;
+            raw_node[i] = c->node;
+        } else if (policy == TASK_POOL_AFFINITY_NODE) {
+            raw_node[i] = (int)(i % nodes);
+            if (nodes > 1) {
+                size_t n = (size_t)raw_node[i];
+                w->num_node_cpus = node_start[n + 1] - node_start[n];
+                w->node_cpus = malloc(w->num_node_cpus * sizeof(int));
+                if (w->node_cpus) {
+                    for (size_t k = 0; k < w->num_node_cpus; k++) {
+                        w->node_cpus[k] = cpus[node_start[n] + k].cpu;
+                    }
+                }
+            }
+        }
+    }
+
+    // Scheduling nodes are the nodes that received workers
+    int dense[TASK_POOL_MAX_NODES];
+    for (size_t n = 0; n < TASK_POOL_MAX_NODES; n++) dense[n] = -1;
+    size_t used = 0;
+    for (size_t i = 0; i < pool->config.num_threads; i++) {
+        if (dense[raw_node[i]] < 0) dense[raw_node[i]] = (int)used++;
+        pool->workers[i].node = dense[raw_node[i]];
+    }
+    pool->num_nodes = used ? used : 1;
+
+    int max_cpu = -1;
+    for (size_t i = 0; i < ncpu; i++) {
+        if (cpus[i].cpu > max_cpu) max_cpu = cpus[i].cpu;
+    }
+    if (max_cpu >= 0 && pool->num_nodes > 1) {
+        pool->cpu_node_len = (size_t)max_cpu + 1;
+        pool->cpu_node = malloc(pool->cpu_node_len * sizeof(int));
+        if (pool->cpu_node) {
+            for (size_t c = 0; c < pool->cpu_node_len; c++) pool->cpu_node[c] = -1;
+            for (size_t i = 0; i < ncpu; i++) pool->cpu_node[cpus[i].cpu] = dense[cpus[i].node];
+        }
+    }
+    free(cpus);
+    return 0;
+}
+
+/**
+ * @brief Scheduling node of the CPU the caller is running on
+ */
+static int node_of_current_cpu(const task_pool_t *pool) {
+#ifdef __linux__
+    if (pool->cpu_node) {
+        int cpu = sched_getcpu();
+        if (cpu >= 0 && (size_t)cpu < pool->cpu_node_len && pool->cpu_node[cpu] >= 0) {
+            return pool->cpu_node[cpu];
+        }
+    }
+#else
+    (void)pool;
+#endif
+    return 0;
+}
+
+// ============================================================================
+// SCHEDULING
+// ============================================================================
+
+static uint32_t next_random(worker_t *self) {
+    static uint32_t shared_seed = 0x9E3779B9u;
+    uint32_t x = self ? self->rng : __atomic_add_fetch(&shared_seed, 0x6D2B79F5u, __ATOMIC_RELAXED);
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    if (self) self->rng = x;
+    return x;
+}
+
+static int steal(task_pool_t *pool, worker_t *self, int home, int remote, task_t *task) {
+    size_t n = pool->num_workers;
+    if (n == 0) return 0;
+    size_t start = next_random(self) % n;
+    for (size_t i = 0; i < n; i++) {
+        worker_t *victim = &pool->workers[(start + i) % n];
+        if (victim == self || (victim->node == home) == remote) continue;
+        if (queue_pop(&victim->deque, task, 0)) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Take one task: own deque, own node, then other nodes
+ */
+static int find_task(task_pool_t *pool, worker_t *self, int home, task_t *task) {
+    int found = 0;
+    if (self && queue_pop(&self->deque, task, 1)) {
+        found = 1;
+    } else if (queue_pop(&pool->node_queues[home], task, 0)) {
+        found = 1;
+    } else if (steal(pool, self, home, 0, task)) {
+        STAT_ADD(pool, steals, 1);
+        found = 1;
+    } else {
+        for (size_t k = 1; k < pool->num_nodes && !found; k++) {
+            if (queue_pop(&pool->node_queues[(home + k) % pool->num_nodes], task, 0)) {
+                STAT_ADD(pool, remote_steals, 1);
+                found = 1;
+            }
+        }
+        if (!found && pool->num_nodes > 1 && steal(pool, self, home, 1, task)) {
+            STAT_ADD(pool, steals, 1);
+            STAT_ADD(pool, remote_steals, 1);
+            found = 1;
+        }
+    }
+    if (found) __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_SEQ_CST);
+    return found;
+}
+
+static void run_task(task_pool_t *pool, const task_t *task) {
+    task->fn(task->arg);
+    STAT_ADD(pool, executed, 1);
+    if (task->group && __atomic_sub_fetch(&task->group->pending, 1, __ATOMIC_ACQ_REL) == 0) {
+        // Waiters sleep on idle_cond alongside idle workers
+        pthread_mutex_lock(&pool->idle_lock);
+        pthread_cond_broadcast(&pool->idle_cond);
+        pthread_mutex_unlock(&pool->idle_lock);
+    }
+}
+
+/**
+ * @brief Sleep until work is queued (idle_lock held)
+ */
+static void idle_wait(task_pool_t *pool) {
+    __atomic_add_fetch(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pool->queued, __ATOMIC_SEQ_CST) == 0) {
+        pthread_cond_wait(&pool->idle_cond, &pool->idle_lock);
+    }
+    __atomic_sub_fetch(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+}
+
+static int should_exit(const task_pool_t *pool, const worker_t *w) {
+    if (w->external) return pool->shutdown || w->epoch != pool->release_epoch;
+    // Internal workers drain the queues before exiting
+    return pool->shutdown && __atomic_load_n(&pool->queued, __ATOMIC_SEQ_CST) == 0;
+}
+
+static void worker_loop(worker_t *w) {
+    task_pool_t *pool = w->pool;
+    for (;;) {
+        task_t task;
+        if (find_task(pool, w, w->node, &task)) {
+            run_task(pool, &task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->idle_lock);
+        if (should_exit(pool, w)) {
+            pthread_mutex_unlock(&pool->idle_lock);
+            break;
+        }
+        idle_wait(pool);
+        pthread_mutex_unlock(&pool->idle_lock);
+    }
+}
+
+static void* worker_main(void *arg) {
+    worker_t *w = arg;
+    tls_worker = w;
+    bind_current_thread(w);
+    worker_loop(w);
+    tls_worker = NULL;
+    return NULL;
+}
+
+static worker_t* current_worker(const task_pool_t *pool) {
+    return (tls_worker && tls_worker->pool == pool) ? tls_worker : NULL;
+}
+
+static task_pool_error_t submit_task(task_pool_t *pool, task_group_t *group,
+                                     task_fn fn, void *arg, int node) {
+    if (!pool || !fn) return TASK_POOL_ERROR_NULL_POINTER;
+    if (__atomic_load_n(&pool->shutdown, __ATOMIC_ACQUIRE)) return TASK_POOL_ERROR_SHUTDOWN;
+
+    task_t task = { fn, arg, group };
+    worker_t *self = current_worker(pool);
+    task_queue_t *q;
+    if (node >= 0 && (size_t)node < pool->num_nodes) {
+        q = &pool->node_queues[node];
+    } else if (self) {
+        q = &self->deque;
+    } else {
+        size_t rr = __atomic_fetch_add(&pool->next_queue, 1, __ATOMIC_RELAXED);
+        q = &pool->node_queues[rr % pool->num_nodes];
+    }
+
+    if (group) __atomic_add_fetch(&group->pending, 1, __ATOMIC_ACQ_REL);
+    // Counted before the push so a sleeping check never misses the task
+    __atomic_add_fetch(&pool->queued, 1, __ATOMIC_SEQ_CST);
+    if (queue_push(q, &task) != 0) {
+        __atomic_sub_fetch(&pool->queued, 1, __ATOMIC_SEQ_CST);
+        if (group) __atomic_sub_fetch(&group->pending, 1, __ATOMIC_ACQ_REL);
+        return TASK_POOL_ERROR_OUT_OF_MEMORY;
+    }
+    STAT_ADD(pool, submitted, 1);
+
+    if (__atomic_load_n(&pool->sleepers, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&pool->idle_lock);
+        pthread_cond_signal(&pool->idle_cond);
+        pthread_mutex_unlock(&pool->idle_lock);
+    }
+    return TASK_POOL_SUCCESS;
+}
+
+task_pool_error_t task_pool_submit(task_pool_t *pool, task_group_t *group,
+                                   task_fn fn, void *arg) {
+    return submit_task(pool, group, fn, arg, -1);
+}
+
+task_pool_error_t task_pool_submit_on_node(task_pool_t *pool, task_group_t *group,
+                                           task_fn fn, void *arg, int node) {
+    return submit_task(pool, group, fn, arg, node);
+}
+
+void task_pool_wait(task_pool_t *pool, task_group_t *group) {
+    if (!pool || !group) return;
+    worker_t *self = current_worker(pool);
+    int home = self ? self->node : node_of_current_cpu(pool);
+
+    while (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0) {
+        task_t task;
+        if (find_task(pool, self, home, &task)) {
+            STAT_ADD(pool, helped, 1);
+            run_task(pool, &task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->idle_lock);
+        if (__atomic_load_n(&group->pending, __ATOMIC_ACQUIRE) > 0) idle_wait(pool);
+        pthread_mutex_unlock(&pool->idle_lock);
+    }
+}
+
+// ============================================================================
+// PARALLEL FOR
+// ============================================================================
+
+typedef struct {
+    size_t next;                    /**< Next unclaimed index (atomic) */
+    size_t end;
+} pfor_range_t;
+
+typedef struct {
+    task_range_fn fn;
+    void *arg;
+    size_t grain;
+    size_t num_ranges;
+    pfor_range_t ranges[TASK_POOL_MAX_NODES];
+} pfor_t;
+
+/**
+ * @brief Claim chunks, starting with the home node's part of the range
+ */
+static void pfor_run(pfor_t *p, int home) {
+    for (size_t k = 0; k < p->num_ranges; k++) {
+        pfor_range_t *r = &p->ranges[((size_t)home + k) % p->num_ranges];
+        for (;;) {
+            size_t begin = __atomic_fetch_add(&r->next, p->grain, __ATOMIC_RELAXED);
+            if (begin >= r->end) break;
+            size_t end = begin + p->grain < r->end ? begin + p->grain : r->end;
+            p->fn(p->arg, begin, end);
+        }
+    }
+}
+
+static void pfor_task(void *arg) {
+    int node = task_pool_current_node();
+    pfor_run(arg, node < 0 ? 0 : node);
+}
+
+void task_pool_parallel_for(task_pool_t *pool, size_t n, size_t grain,
+                            task_range_fn fn, void *arg) {
+    if (!fn || n == 0) return;
+    if (!pool) pool = task_pool_default();
+
+    size_t threads = pool ? task_pool_num_threads(pool) : 1;
+    if (grain == 0) grain = n / (threads * 4) ? n / (threads * 4) : 1;
+    size_t chunks = (n + grain - 1) / grain;
+    if (threads <= 1 || chunks <= 1) {
+        fn(arg, 0, n);
+        return;
+    }
+
+    pfor_t p = { .fn = fn, .arg = arg, .grain = grain };
+    p.num_ranges = pool->num_nodes < chunks ? pool->num_nodes : chunks;
+    for (size_t m = 0; m < p.num_ranges; m++) {
+        // Node parts are whole chunks so every claim is grain-aligned
+        p.ranges[m].next = (chunks * m / p.num_ranges) * grain;
+        p.ranges[m].end = (chunks * (m + 1) / p.num_ranges) * grain;
+        if (p.ranges[m].end > n) p.ranges[m].end = n;
+    }
+
+    worker_t *self = current_worker(pool);
+    int home = self ? self->node : node_of_current_cpu(pool);
+    size_t helpers = (chunks < threads ? chunks : threads) - 1;
+    task_group_t group = TASK_GROUP_INIT;
+    for (size_t i = 0; i < helpers; i++) {
+        int node = (int)(((size_t)home + 1 + i) % pool->num_nodes);
+        if (submit_task(pool, &group, pfor_task, &p, node) != TASK_POOL_SUCCESS) break;
+    }
+    pfor_run(&p, home % (int)p.num_ranges);
+    task_pool_wait(pool, &group);
+}
+
+// ============================================================================
+// EXTERNAL THREADS
+// ============================================================================
+
+task_pool_error_t task_pool_run_external(task_pool_t *pool) {
+    if (!pool) return TASK_POOL_ERROR_NULL_POINTER;
+
+    pthread_mutex_lock(&pool->idle_lock);
+    if (pool->shutdown) {
+        pthread_mutex_unlock(&pool->idle_lock);
+        return TASK_POOL_ERROR_SHUTDOWN;
+    }
+    worker_t *w = NULL;
+    for (size_t i = pool->config.num_threads; i < pool->num_workers; i++) {
+        if (!pool->workers[i].active) {
+            w = &pool->workers[i];
+            break;
+        }
+    }
+    if (!w) {
+        pthread_mutex_unlock(&pool->idle_lock);
+        return TASK_POOL_ERROR_NO_SLOT;
+    }
+    w->active = 1;
+    w->epoch = pool->release_epoch;
+    __atomic_add_fetch(&pool->external_active, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&pool->idle_lock);
+
+    w->node = node_of_current_cpu(pool);
+    worker_t *previous = tls_worker;
+    tls_worker = w;
+    worker_loop(w);
+    tls_worker = previous;
+
+    // Tasks this thread spawned but did not run move to its node queue
+    task_t task;
+    while (queue_pop(&w->deque, &task, 0)) {
+        while (queue_push(&pool->node_queues[w->node], &task) != 0) sched_yield();
+    }
+
+    pthread_mutex_lock(&pool->idle_lock);
+    w->active = 0;
+    __atomic_sub_fetch(&pool->external_active, 1, __ATOMIC_RELAXED);
+    pthread_cond_broadcast(&pool->idle_cond);
+    pthread_mutex_unlock(&pool->idle_lock);
+    return TASK_POOL_SUCCESS;
+}
+
+void task_pool_release_external(task_pool_t *pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->idle_lock);
+    pool->release_epoch++;
+    pthread_cond_broadcast(&pool->idle_cond);
+    pthread_mutex_unlock(&pool->idle_lock);
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+void task_pool_get_default_config(task_pool_config_t *config) {
+    if (!config) return;
+    cpu_info_t *cpus = NULL;
+    size_t nodes;
+    size_t ncpu = detect_topology(&cpus, &nodes);
+    free(cpus);
+    config->num_threads = ncpu;
+    config->external_slots = TASK_POOL_DEFAULT_EXTERNAL_SLOTS;
+    config->affinity = TASK_POOL_AFFINITY_NODE;
+}
+
+task_pool_error_t task_pool_create(task_pool_t **pool_out, const task_pool_config_t *config) {
+    if (!pool_out) return TASK_POOL_ERROR_NULL_POINTER;
+    *pool_out = NULL;
+
+    task_pool_t *pool = calloc(1, sizeof(*pool));
+    if (!pool) return TASK_POOL_ERROR_OUT_OF_MEMORY;
+    if (config) pool->config = *config;
+    else task_pool_get_default_config(&pool->config);
+    if (pool->config.affinity > TASK_POOL_AFFINITY_SCATTER ||
+        (pool->config.num_threads == 0 && pool->config.external_slots == 0)) {
+        free(pool);
+        return TASK_POOL_ERROR_INVALID_PARAM;
+    }
+
+    pthread_mutex_init(&pool->idle_lock, NULL);
+    pthread_cond_init(&pool->idle_cond, NULL);
+    pool->num_workers = pool->config.num_threads + pool->config.external_slots;
+    pool->workers = calloc(pool->num_workers ? pool->num_workers : 1, sizeof(*pool->workers));
+    pool->threads = calloc(pool->config.num_threads ? pool->config.num_threads : 1,
+                           sizeof(*pool->threads));
+    if (!pool->workers || !pool->threads || place_workers(pool) != 0) {
+        task_pool_free(pool);
+        return TASK_POOL_ERROR_OUT_OF_MEMORY;
+    }
+
+    pool->node_queues = calloc(pool->num_nodes, sizeof(*pool->node_queues));
+    if (!pool->node_queues) {
+        task_pool_free(pool);
+        return TASK_POOL_ERROR_OUT_OF_MEMORY;
+    }
+    for (size_t n = 0; n < pool->num_nodes; n++) {
+        if (queue_init(&pool->node_queues[n]) != 0) {
+            task_pool_free(pool);
+            return TASK_POOL_ERROR_OUT_OF_MEMORY;
+        }
+    }
+    for (size_t i = 0; i < pool->num_workers; i++) {
+        worker_t *w = &pool->workers[i];
+        w->pool = pool;
+        w->index = (int)i;
+        w->rng = 0x9E3779B9u * (uint32_t)(i + 1);
+        if (i >= pool->config.num_threads) {
+            w->external = 1;
+            w->cpu = -1;
+        }
+        if (queue_init(&w->deque) != 0) {
+            task_pool_free(pool);
+            return TASK_POOL_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    for (size_t i = 0; i < pool->config.num_threads; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, &pool->workers[i]) != 0) {
+            task_pool_free(pool);
+            return TASK_POOL_ERROR_THREAD;
+        }
+        pool->threads_started++;
+    }
+
+    *pool_out = pool;
+    return TASK_POOL_SUCCESS;
+}
+
+void task_pool_free(task_pool_t *pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->idle_lock);
+    __atomic_store_n(&pool->shutdown, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&pool->idle_cond);
+    while (__atomic_load_n(&pool->external_active, __ATOMIC_RELAXED) > 0) {
+        pthread_cond_wait(&pool->idle_cond, &pool->idle_lock);
+    }
+    pthread_mutex_unlock(&pool->idle_lock);
+
+    // With no internal workers the queued tasks run here
+    if (pool->threads_started == 0 && pool->node_queues) {
+        task_t task;
+        while (find_task(pool, NULL, 0, &task)) run_task(pool, &task);
+    }
+    for (size_t i = 0; i < pool->threads_started; i++) pthread_join(pool->threads[i], NULL);
+
+    for (size_t i = 0; pool->workers && i < pool->num_workers; i++) {
+        queue_destroy(&pool->workers[i].deque);
+        free(pool->workers[i].node_cpus);
+    }
+    for (size_t n = 0; pool->node_queues && n < pool->num_nodes; n++) {
+        queue_destroy(&pool->node_queues[n]);
+    }
+    pthread_mutex_destroy(&pool->idle_lock);
+    pthread_cond_destroy(&pool->idle_cond);
+    free(pool->node_queues);
+    free(pool->cpu_node);
+    free(pool->workers);
+    free(pool->threads);
+    free(pool);
+}
+
+// ============================================================================
+// DEFAULT POOL
+// ============================================================================
+
+static pthread_mutex_t default_lock = PTHREAD_MUTEX_INITIALIZER;
+static task_pool_t *default_pool;
+static int default_failed;
+static int atfork_registered;
+
+/**
+ * @brief A forked child has none of the parent's workers; start afresh
+ */
+static void default_pool_atfork_child(void) {
+    pthread_mutex_init(&default_lock, NULL);
+    default_pool = NULL;
+    default_failed = 0;
+    tls_worker = NULL;
+}
+
+static void config_from_environment(task_pool_config_t *config) {
+    const char *threads = getenv("QRNG_THREADS");
+    if (threads && *threads) {
+        char *end;
+        unsigned long n = strtoul(threads, &end, 10);
+        if (*end == '\0' && n > 0 && n <= 4096) config->num_threads = n;
+    }
+    const char *affinity = getenv("QRNG_AFFINITY");
+    if (affinity) {
+        if (strcasecmp(affinity, "none") == 0) config->affinity = TASK_POOL_AFFINITY_NONE;
+        else if (strcasecmp(affinity, "node") == 0) config->affinity = TASK_POOL_AFFINITY_NODE;
+        else if (strcasecmp(affinity, "compact") == 0) config->affinity = TASK_POOL_AFFINITY_COMPACT;
+        else if (strcasecmp(affinity, "scatter") == 0) config->affinity = TASK_POOL_AFFINITY_SCATTER;
+    }
+}
+
+static void register_atfork_locked(void) {
+    if (!atfork_registered) {
+        pthread_atfork(NULL, NULL, default_pool_atfork_child);
+        atfork_registered = 1;
+    }
+}
+
+task_pool_t* task_pool_default(void) {
+    task_pool_t *pool = __atomic_load_n(&default_pool, __ATOMIC_ACQUIRE);
+    if (pool) return pool;
+
+    pthread_mutex_lock(&default_lock);
+    if (!default_pool && !default_failed) {
+        task_pool_config_t config;
+        task_pool_get_default_config(&config);
+        config_from_environment(&config);
+        if (task_pool_create(&pool, &config) == TASK_POOL_SUCCESS) {
+            register_atfork_locked();
+            __atomic_store_n(&default_pool, pool, __ATOMIC_RELEASE);
+        } else {
+            default_failed = 1;
+        }
+    }
+    pool = default_pool;
+    pthread_mutex_unlock(&default_lock);
+    return pool;
+}
+
+task_pool_error_t task_pool_set_default(task_pool_t *pool) {
+    if (!pool) return TASK_POOL_ERROR_NULL_POINTER;
+    pthread_mutex_lock(&default_lock);
+    if (default_pool) {
+        pthread_mutex_unlock(&default_lock);
+        return TASK_POOL_ERROR_ALREADY_SET;
+    }
+    register_atfork_locked();
+    __atomic_store_n(&default_pool, pool, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&default_lock);
+    return TASK_POOL_SUCCESS;
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+size_t task_pool_num_threads(const task_pool_t *pool) {
+    if (!pool) return 0;
+    return pool->config.num_threads + __atomic_load_n(&pool->external_active, __ATOMIC_RELAXED);
+}
+
+size_t task_pool_num_nodes(const task_pool_t *pool) {
+    return pool ? pool->num_nodes : 0;
+}
+
+int task_pool_current_node(void) {
+    return tls_worker ? tls_worker->node : -1;
+}
+
+int task_pool_worker_index(void) {
+    return tls_worker ? tls_worker->index : -1;
+}
+
+void task_pool_get_stats(task_pool_t *pool, task_pool_stats_t *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!pool) return;
+    stats->threads = pool->config.num_threads;
+    stats->nodes = pool->num_nodes;
+    stats->external_active = __atomic_load_n(&pool->external_active, __ATOMIC_RELAXED);
+    stats->submitted = __atomic_load_n(&pool->stats.submitted, __ATOMIC_RELAXED);
+    stats->executed = __atomic_load_n(&pool->stats.executed, __ATOMIC_RELAXED);
+    stats->steals = __atomic_load_n(&pool->stats.steals, __ATOMIC_RELAXED);
+    stats->remote_steals = __atomic_load_n(&pool->stats.remote_steals, __ATOMIC_RELAXED);
+    stats->helped = __atomic_load_n(&pool->stats.helped, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,215 @@
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file task_pool.h
+ * @brief Shared work-stealing thread pool
+ *
+ * One pool runs the library's parallel work: gate kernels on large states,
+ * Grover batches, entropy pool refills and rng_async pieces all submit
+ * tasks to task_pool_default(), so subsystems running at the same time
+ * share one set of threads instead of each starting its own.
+ *
+ * Scheduling:
+ * - every worker owns a deque; tasks a worker submits go to its own deque,
+ *   which it runs newest-first while idle workers steal oldest-first;
+ * - tasks submitted from outside the pool go to a per-NUMA-node queue;
+ * - an idle worker looks in its own deque, then its node's queue, then
+ *   steals from workers on its node, and only then from other nodes;
+ * - a thread waiting for a task group runs queued tasks while it waits,
+ *   so nested parallel sections cannot deadlock the pool.
+ *
+ * Placement: with the default TASK_POOL_AFFINITY_NODE each worker is bound
+ * to the CPUs of one NUMA node (nodes are taken round-robin), which keeps
+ * a worker next to the memory its tasks first touched. COMPACT and SCATTER
+ * pin each worker to one CPU; NONE leaves placement to the OS and treats
+ * the machine as one node. Topology comes from /sys on Linux and respects
+ * the process CPU mask; elsewhere the machine is one unpinned node.
+ *
+ * Applications that manage their own threads can create a pool with
+ * num_threads = 0 and lend threads to it with task_pool_run_external(),
+ * then install it with task_pool_set_default() before the library first
+ * needs one.
+ *
+ * The default pool reads QRNG_THREADS (worker count) and QRNG_AFFINITY
+ * (none, node, compact or scatter) from the environment.
+ */
+
+#define TASK_POOL_MAX_NODES 64
+
+/**
+ * @brief Pool error codes
+ */
+typedef enum {
+    TASK_POOL_SUCCESS = 0,                  /**< Operation successful */
+    TASK_POOL_ERROR_NULL_POINTER = -1,      /**< NULL argument */
+    TASK_POOL_ERROR_INVALID_PARAM = -2,     /**< Bad configuration */
+    TASK_POOL_ERROR_OUT_OF_MEMORY = -3,     /**< Allocation failed */
+    TASK_POOL_ERROR_THREAD = -4,            /**< Thread creation failed */
+    TASK_POOL_ERROR_SHUTDOWN = -5,          /**< Pool is being freed */
+    TASK_POOL_ERROR_NO_SLOT = -6,           /**< All external slots are in use */
+    TASK_POOL_ERROR_ALREADY_SET = -7        /**< Default pool already in use */
+} task_pool_error_t;
+
+/**
+ * @brief Worker placement policy
+ */
+typedef enum {
+    TASK_POOL_AFFINITY_NONE = 0,    /**< No binding; one scheduling node */
+    TASK_POOL_AFFINITY_NODE,        /**< Bind each worker to one NUMA node's CPUs */
+    TASK_POOL_AFFINITY_COMPACT,     /**< Pin to one CPU each, filling a node before the next */
+    TASK_POOL_AFFINITY_SCATTER      /**< Pin to one CPU each, round-robin across nodes */
+} task_pool_affinity_t;
+
+/**
+ * @brief Pool configuration
+ */
+typedef struct {
+    size_t num_threads;             /**< Internal workers (default: usable CPUs; may be 0) */
+    size_t external_slots;          /**< Application threads that may join (default 4) */
+    task_pool_affinity_t affinity;  /**< Placement policy (default NODE) */
+} task_pool_config_t;
+
+/**
+ * @brief Pool counters
+ */
+typedef struct {
+    size_t threads;                 /**< Internal workers */
+    size_t nodes;                   /**< Scheduling nodes */
+    size_t external_active;         /**< Application threads currently lent */
+    uint64_t submitted;
+    uint64_t executed;
+    uint64_t steals;                /**< Tasks taken from another worker's deque */
+    uint64_t remote_steals;         /**< Steals or queue takes across nodes */
+    uint64_t helped;                /**< Tasks run by threads waiting on a group */
+} task_pool_stats_t;
+
+typedef void (*task_fn)(void *arg);
+
+/**
+ * @brief Body of task_pool_parallel_for; processes [begin, end)
+ */
+typedef void (*task_range_fn)(void *arg, size_t begin, size_t end);
+
+/**
+ * @brief Completion counter for a set of tasks
+ *
+ * Initialize with TASK_GROUP_INIT; it may live on the waiter's stack.
+ */
+typedef struct {
+    size_t pending;
+} task_group_t;
+
+#define TASK_GROUP_INIT { 0 }
+
+typedef struct task_pool task_pool_t;
+
+/**
+ * @brief Fill a configuration with defaults (environment not consulted)
+ */
+void task_pool_get_default_config(task_pool_config_t *config);
+
+/**
+ * @brief Create a pool and start its workers
+ */
+task_pool_error_t task_pool_create(task_pool_t **pool, const task_pool_config_t *config);
+
+/**
+ * @brief Run queued tasks, stop the workers and free the pool
+ *
+ * Lent application threads return from task_pool_run_external() first.
+ * Must not be called from a task.
+ */
+void task_pool_free(task_pool_t *pool);
+
+/**
+ * @brief The library-wide pool, created on first use
+ *
+ * Never NULL unless creation failed (then callers run work inline).
+ */
+task_pool_t* task_pool_default(void);
+
+/**
+ * @brief Install an application-owned pool as the library-wide pool
+ *
+ * @return TASK_POOL_ERROR_ALREADY_SET once the default pool exists
+ */
+task_pool_error_t task_pool_set_default(task_pool_t *pool);
+
+/**
+ * @brief Queue fn(arg)
+ *
+ * From a worker the task goes to that worker's deque, otherwise to a node
+ * queue. group may be NULL.
+ */
+task_pool_error_t task_pool_submit(task_pool_t *pool, task_group_t *group,
+                                   task_fn fn, void *arg);
+
+/**
+ * @brief Queue fn(arg) on a NUMA node's queue (node < 0 = no preference)
+ */
+task_pool_error_t task_pool_submit_on_node(task_pool_t *pool, task_group_t *group,
+                                           task_fn fn, void *arg, int node);
+
+/**
+ * @brief Wait until every task of group has finished, running queued tasks meanwhile
+ */
+void task_pool_wait(task_pool_t *pool, task_group_t *group);
+
+/**
+ * @brief Run fn over [0, n) in chunks of at least grain, in parallel
+ *
+ * The caller takes part, so this also works from inside a task. The range
+ * is split into one contiguous part per node and each part is handed to
+ * that node's workers first. Runs inline when the pool has one thread or
+ * n <= grain.
+ *
+ * @param pool Pool (NULL = task_pool_default())
+ */
+void task_pool_parallel_for(task_pool_t *pool, size_t n, size_t grain,
+                            task_range_fn fn, void *arg);
+
+/**
+ * @brief Lend the calling thread to the pool until released
+ *
+ * Runs tasks like an internal worker until task_pool_release_external()
+ * or task_pool_free().
+ *
+ * @return TASK_POOL_SUCCESS after release, TASK_POOL_ERROR_NO_SLOT, or
+ *         TASK_POOL_ERROR_SHUTDOWN
+ */
+task_pool_error_t task_pool_run_external(task_pool_t *pool);
+
+/**
+ * @brief Make every thread currently in task_pool_run_external() return
+ */
+void task_pool_release_external(task_pool_t *pool);
+
+/**
+ * @brief Threads that can run tasks (internal workers plus lent threads)
+ */
+size_t task_pool_num_threads(const task_pool_t *pool);
+
+/**
+ * @brief Scheduling nodes of the pool
+ */
+size_t task_pool_num_nodes(const task_pool_t *pool);
+
+/**
+ * @brief Node of the calling worker (-1 when not a worker of any pool)
+ */
+int task_pool_current_node(void);
+
+/**
+ * @brief Index of the calling worker within its pool (-1 when not a worker)
+ */
+int task_pool_worker_index(void);
+
+void task_pool_get_stats(task_pool_t *pool, task_pool_stats_t *stats);
+
+const char* task_pool_error_string(task_pool_error_t error);
+
+#endif /* TASK_POOL_H */
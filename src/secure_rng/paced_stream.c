@@ -0,0 +1,420 @@
+/**
+ * @file paced_stream.c
+ * @brief Token-bucket paced streaming (see paced_stream.h)
+ */
+
+#include "paced_stream.h"
+#include "../common/secure_memory.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/timerfd.h>
+#endif
+
+#define PACED_STREAM_DEFAULT_TICK_NS 1000000ULL          /* 1 ms */
+#define PACED_STREAM_DEFAULT_BUFFER (1024 * 1024)
+#define PACED_STREAM_DEFAULT_CHUNK (64 * 1024)
+#define PACED_STREAM_BURST_NS 20000000ULL                /* Default bucket: 20 ms of output */
+#define PACED_STREAM_PREFILL_WAIT_NS 10000000L            /* Recheck stop while prefilling */
+
+struct paced_stream {
+    paced_stream_config_t config;
+    paced_stream_source_fn source;
+    void *source_data;
+    paced_stream_sink_fn sink;
+    void *sink_data;
+    paced_stream_report_fn report;
+    void *report_data;
+
+    // Bounded buffer: bytes [rpos, rpos + count) (mod cap) are unsent.
+    // Only the generator writes outside that range, only the pacer reads
+    // inside it, so the copies themselves run unlocked.
+    uint8_t *buf;
+    size_t cap;
+    size_t rpos;
+    size_t count;
+    pthread_mutex_t lock;
+    pthread_cond_t not_full;
+    pthread_cond_t not_empty;
+    int shutdown;                   /**< Generator should exit (under lock) */
+    int source_failed;              /**< Generator hit a source error (under lock) */
+    int stop_requested;             /**< Set by paced_stream_stop (atomic) */
+    int started;                    /**< paced_stream_run has been called */
+
+    // Statistics (under lock)
+    paced_stream_stats_t stats;
+    double jitter_m2;               /**< Welford sum of squared deviations */
+    uint64_t start_ns;
+    uint64_t end_ns;
+};
+
+static const char *error_strings[] = {
+    "Success",
+    "NULL pointer",
+    "Invalid parameter",
+    "Out of memory",
+    "Source failed",
+    "Sink failed",
+    "Timer or thread setup failed"
+};
+
+const char* paced_stream_error_string(paced_stream_error_t error) {
+    int idx = -(int)error;
+    if (idx < 0 || idx >= (int)(sizeof(error_strings) / sizeof(error_strings[0]))) {
+        return "Unknown error";
+    }
+    return error_strings[idx];
+}
+
+void paced_stream_get_default_config(paced_stream_config_t *config) {
+    if (!config) return;
+    memset(config, 0, sizeof(*config));
+    config->tick_ns = PACED_STREAM_DEFAULT_TICK_NS;
+    config->buffer_size = PACED_STREAM_DEFAULT_BUFFER;
+    config->generate_chunk = PACED_STREAM_DEFAULT_CHUNK;
+    config->max_write = PACED_STREAM_DEFAULT_CHUNK;
+}
+
+int paced_stream_secure_rng_source(void *user_data, uint8_t *buffer, size_t size) {
+    return secure_rng_bytes((secure_rng_ctx_t *)user_data, buffer, size) == SECURE_RNG_SUCCESS ? 0 : -1;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+paced_stream_error_t paced_stream_create(paced_stream_t **stream,
+                                         const paced_stream_config_t *config,
+                                         paced_stream_source_fn source, void *source_data,
+                                         paced_stream_sink_fn sink, void *sink_data) {
+    if (!stream || !config || !source || !sink) return PACED_STREAM_ERROR_NULL_POINTER;
+    *stream = NULL;
+
+    paced_stream_config_t cfg = *config;
+    if (!(cfg.rate > 0) || !isfinite(cfg.rate) || cfg.tick_ns == 0 ||
+        cfg.buffer_size == 0 || cfg.generate_chunk == 0 || cfg.max_write == 0) {
+        return PACED_STREAM_ERROR_INVALID_PARAM;
+    }
+    if (cfg.burst_bytes == 0) {
+        // Deep enough to ride out a scheduler timeslice, shallow enough
+        // that a stalled sink does not get a visible catch-up burst
+        uint64_t window = cfg.tick_ns > PACED_STREAM_BURST_NS ? cfg.tick_ns : PACED_STREAM_BURST_NS;
+        double burst = cfg.rate * (double)window / 1e9;
+        cfg.burst_bytes = burst < 1.0 ? 1 : (size_t)burst;
+    }
+
+    paced_stream_t *s = calloc(1, sizeof(*s));
+    if (!s) return PACED_STREAM_ERROR_OUT_OF_MEMORY;
+    s->buf = malloc(cfg.buffer_size);
+    if (!s->buf) {
+        free(s);
+        return PACED_STREAM_ERROR_OUT_OF_MEMORY;
+    }
+    s->config = cfg;
+    s->cap = cfg.buffer_size;
+    s->source = source;
+    s->source_data = source_data;
+    s->sink = sink;
+    s->sink_data = sink_data;
+    s->stats.buffer_min = cfg.buffer_size;
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->not_full, NULL);
+    pthread_cond_init(&s->not_empty, NULL);
+
+    *stream = s;
+    return PACED_STREAM_SUCCESS;
+}
+
+void paced_stream_set_report(paced_stream_t *stream, paced_stream_report_fn report,
+                             void *user_data) {
+    if (!stream) return;
+    stream->report = report;
+    stream->report_data = user_data;
+}
+
+void paced_stream_stop(paced_stream_t *stream) {
+    if (stream) __atomic_store_n(&stream->stop_requested, 1, __ATOMIC_RELEASE);
+}
+
+void paced_stream_free(paced_stream_t *stream) {
+    if (!stream) return;
+    secure_memzero(stream->buf, stream->cap);
+    free(stream->buf);
+    pthread_mutex_destroy(&stream->lock);
+    pthread_cond_destroy(&stream->not_full);
+    pthread_cond_destroy(&stream->not_empty);
+    free(stream);
+}
+
+/**
+ * @brief Fill the derived fields of a stats snapshot (lock held)
+ */
+static void finish_stats(const paced_stream_t *s, paced_stream_stats_t *out) {
+    *out = s->stats;
+    uint64_t end = s->end_ns ? s->end_ns : (s->start_ns ? now_ns() : 0);
+    out->elapsed_s = s->start_ns ? (double)(end - s->start_ns) / 1e9 : 0.0;
+    out->achieved_rate = out->elapsed_s > 0 ? (double)out->bytes_emitted / out->elapsed_s : 0.0;
+    uint64_t wakeups = s->stats.ticks - s->stats.missed_ticks;
+    out->jitter_stddev_ns = wakeups > 1 ? sqrt(s->jitter_m2 / (double)wakeups) : 0.0;
+    if (s->stats.ticks == 0) out->buffer_min = 0;
+}
+
+void paced_stream_get_stats(paced_stream_t *stream, paced_stream_stats_t *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!stream) return;
+    pthread_mutex_lock(&stream->lock);
+    finish_stats(stream, stats);
+    pthread_mutex_unlock(&stream->lock);
+}
+
+// ============================================================================
+// GENERATOR THREAD
+// ============================================================================
+
+static void* generator_main(void *arg) {
+    paced_stream_t *s = arg;
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (s->count == s->cap && !s->shutdown) pthread_cond_wait(&s->not_full, &s->lock);
+        if (s->shutdown) break;
+
+        size_t wpos = (s->rpos + s->count) % s->cap;
+        size_t n = s->cap - s->count;
+        if (n > s->cap - wpos) n = s->cap - wpos;
+        if (n > s->config.generate_chunk) n = s->config.generate_chunk;
+        pthread_mutex_unlock(&s->lock);
+
+        int rc = s->source(s->source_data, s->buf + wpos, n);
+
+        pthread_mutex_lock(&s->lock);
+        if (rc != 0) {
+            secure_memzero(s->buf + wpos, n);
+            s->source_failed = 1;
+            pthread_cond_signal(&s->not_empty);
+            break;
+        }
+        s->count += n;
+        s->stats.bytes_generated += n;
+        pthread_cond_signal(&s->not_empty);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+// ============================================================================
+// PACING LOOP
+// ============================================================================
+
+typedef struct {
+    int fd;                         /**< timerfd, or -1 for the sleep fallback */
+    uint64_t start_ns;
+    uint64_t tick_ns;
+    uint64_t ticks;                 /**< Expirations consumed so far */
+} tick_timer_t;
+
+static int timer_start(tick_timer_t *t, uint64_t start_ns, uint64_t tick_ns) {
+    t->start_ns = start_ns;
+    t->tick_ns = tick_ns;
+    t->ticks = 0;
+    t->fd = -1;
+#ifdef __linux__
+    t->fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (t->fd < 0) return -1;
+    uint64_t first = start_ns + tick_ns;
+    struct itimerspec its = {
+        .it_interval = { (time_t)(tick_ns / 1000000000ULL), (long)(tick_ns % 1000000000ULL) },
+        .it_value = { (time_t)(first / 1000000000ULL), (long)(first % 1000000000ULL) }
+    };
+    if (timerfd_settime(t->fd, TFD_TIMER_ABSTIME, &its, NULL) != 0) {
+        close(t->fd);
+        t->fd = -1;
+        return -1;
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief Block until the next tick
+ *
+ * @return Periods elapsed since the previous call (> 1 when wakeups were
+ *         missed), or 0 on error
+ */
+static uint64_t timer_wait(tick_timer_t *t) {
+    uint64_t expirations = 0;
+#ifdef __linux__
+    for (;;) {
+        ssize_t n = read(t->fd, &expirations, sizeof(expirations));
+        if (n == (ssize_t)sizeof(expirations)) break;
+        if (n < 0 && errno == EINTR) continue;
+        return 0;
+    }
+#else
+    uint64_t next = t->start_ns + (t->ticks + 1) * t->tick_ns;
+    struct timespec ts = { (time_t)(next / 1000000000ULL), (long)(next % 1000000000ULL) };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) { }
+    expirations = (now_ns() - t->start_ns) / t->tick_ns - t->ticks;
+    if (expirations == 0) expirations = 1;
+#endif
+    t->ticks += expirations;
+    return expirations;
+}
+
+static void timer_stop(tick_timer_t *t) {
+    if (t->fd >= 0) close(t->fd);
+    t->fd = -1;
+}
+
+/**
+ * @brief Hand n buffered bytes to the sink, wiping them as they go
+ */
+static paced_stream_error_t emit(paced_stream_t *s, size_t n) {
+    while (n > 0) {
+        size_t piece = n;
+        if (piece > s->cap - s->rpos) piece = s->cap - s->rpos;
+        if (piece > s->config.max_write) piece = s->config.max_write;
+
+        uint64_t t0 = now_ns();
+        int rc = s->sink(s->sink_data, s->buf + s->rpos, piece);
+        uint64_t took = now_ns() - t0;
+        secure_memzero(s->buf + s->rpos, piece);
+
+        pthread_mutex_lock(&s->lock);
+        s->rpos = (s->rpos + piece) % s->cap;
+        s->count -= piece;
+        if (rc == 0) s->stats.bytes_emitted += piece;
+        if (took > s->config.tick_ns) s->stats.sink_stalls++;
+        pthread_cond_signal(&s->not_full);
+        pthread_mutex_unlock(&s->lock);
+
+        if (rc != 0) return PACED_STREAM_ERROR_SINK;
+        n -= piece;
+    }
+    return PACED_STREAM_SUCCESS;
+}
+
+/**
+ * @brief Wait until the buffer is half full, the source fails, or stop
+ */
+static void prefill(paced_stream_t *s) {
+    pthread_mutex_lock(&s->lock);
+    while (s->count < s->cap / 2 && !s->source_failed &&
+           !__atomic_load_n(&s->stop_requested, __ATOMIC_ACQUIRE)) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += PACED_STREAM_PREFILL_WAIT_NS;
+        if (ts.tv_nsec >= 1000000000L) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&s->not_empty, &s->lock, &ts);
+    }
+    pthread_mutex_unlock(&s->lock);
+}
+
+paced_stream_error_t paced_stream_run(paced_stream_t *stream) {
+    if (!stream) return PACED_STREAM_ERROR_NULL_POINTER;
+    paced_stream_t *s = stream;
+    if (s->started) return PACED_STREAM_ERROR_INVALID_PARAM;
+    s->started = 1;
+
+    pthread_t generator;
+    if (pthread_create(&generator, NULL, generator_main, s) != 0) return PACED_STREAM_ERROR_TIMER;
+    prefill(s);
+
+    const paced_stream_config_t *cfg = &s->config;
+    tick_timer_t timer;
+    uint64_t start = now_ns();
+    paced_stream_error_t err = PACED_STREAM_SUCCESS;
+    if (timer_start(&timer, start, cfg->tick_ns) != 0) err = PACED_STREAM_ERROR_TIMER;
+
+    pthread_mutex_lock(&s->lock);
+    s->start_ns = start;
+    pthread_mutex_unlock(&s->lock);
+
+    double tokens = 0.0;
+    uint64_t last = start;
+    uint64_t last_report = start;
+    uint64_t emitted = 0;
+
+    while (err == PACED_STREAM_SUCCESS && !__atomic_load_n(&s->stop_requested, __ATOMIC_ACQUIRE)) {
+        if (cfg->total_bytes && emitted >= cfg->total_bytes) break;
+
+        uint64_t expirations = timer_wait(&timer);
+        if (expirations == 0) {
+            err = PACED_STREAM_ERROR_TIMER;
+            break;
+        }
+        uint64_t now = now_ns();
+        double late = (double)(int64_t)(now - (start + timer.ticks * cfg->tick_ns));
+        if (late < 0) late = 0;
+
+        tokens += cfg->rate * (double)(now - last) / 1e9;
+        last = now;
+        int overflow = tokens > (double)cfg->burst_bytes;
+        double forfeited = overflow ? tokens - (double)cfg->burst_bytes : 0.0;
+        if (overflow) tokens = (double)cfg->burst_bytes;
+
+        size_t want = (size_t)tokens;
+        if (cfg->total_bytes && want > cfg->total_bytes - emitted) {
+            want = (size_t)(cfg->total_bytes - emitted);
+        }
+
+        pthread_mutex_lock(&s->lock);
+        size_t avail = s->count;
+        int drained = s->source_failed && avail == 0;
+        s->stats.ticks += expirations;
+        s->stats.missed_ticks += expirations - 1;
+        s->stats.bytes_forfeited += (uint64_t)forfeited;
+        if (overflow) s->stats.behind_events++;
+        if (avail < want) s->stats.underruns++;
+        if (avail < s->stats.buffer_min) s->stats.buffer_min = avail;
+        // Welford over wakeups
+        uint64_t wakeups = s->stats.ticks - s->stats.missed_ticks;
+        double delta = late - s->stats.jitter_mean_ns;
+        s->stats.jitter_mean_ns += delta / (double)wakeups;
+        s->jitter_m2 += delta * (late - s->stats.jitter_mean_ns);
+        if (late > s->stats.jitter_max_ns) s->stats.jitter_max_ns = late;
+        pthread_mutex_unlock(&s->lock);
+
+        if (drained) {
+            err = PACED_STREAM_ERROR_SOURCE;
+            break;
+        }
+        size_t n = want < avail ? want : avail;
+        if (n > 0) {
+            err = emit(s, n);
+            tokens -= (double)n;
+            emitted += n;
+        }
+
+        if (s->report && cfg->report_interval_ns && now - last_report >= cfg->report_interval_ns) {
+            paced_stream_stats_t snapshot;
+            paced_stream_get_stats(s, &snapshot);
+            s->report(s->report_data, &snapshot);
+            last_report = now;
+        }
+    }
+
+    timer_stop(&timer);
+    pthread_mutex_lock(&s->lock);
+    s->end_ns = now_ns();
+    s->shutdown = 1;
+    pthread_cond_broadcast(&s->not_full);
+    pthread_mutex_unlock(&s->lock);
+    pthread_join(generator, NULL);
+    return err;
+}
@@ -0,0 +1,157 @@
+#ifndef PACED_STREAM_H
+#define PACED_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "secure_rng.h"
+
+/**
+ * @file paced_stream.h
+ * @brief Rate-controlled streaming of random bytes
+ *
+ * Emits a source's output to a sink at a fixed byte rate, for consumers
+ * such as hardware test rigs and network distributors that want a steady
+ * stream rather than everything at once.
+ *
+ * Two threads:
+ * - a generator thread keeps a bounded buffer ahead of the pacing, so a
+ *   slow generation call delays the buffer, not the output;
+ * - the calling thread wakes on a periodic timer (timerfd on Linux,
+ *   clock_nanosleep elsewhere), adds rate x elapsed to a token bucket and
+ *   hands that many buffered bytes to the sink.
+ *
+ * The bucket holds at most burst_bytes. When the sink blocks (a full pipe,
+ * a slow socket) or the generator cannot keep up, tokens beyond that are
+ * forfeited and counted in the stats; the stream then continues at the
+ * configured rate instead of bursting to catch up. Emitted bytes are wiped
+ * from the buffer.
+ */
+
+/**
+ * @brief Stream error codes
+ */
+typedef enum {
+    PACED_STREAM_SUCCESS = 0,               /**< Finished or stopped */
+    PACED_STREAM_ERROR_NULL_POINTER = -1,   /**< NULL argument */
+    PACED_STREAM_ERROR_INVALID_PARAM = -2,  /**< Bad rate or geometry */
+    PACED_STREAM_ERROR_OUT_OF_MEMORY = -3,  /**< Allocation failed */
+    PACED_STREAM_ERROR_SOURCE = -4,         /**< Source callback failed */
+    PACED_STREAM_ERROR_SINK = -5,           /**< Sink callback failed */
+    PACED_STREAM_ERROR_TIMER = -6           /**< Timer or thread setup failed */
+} paced_stream_error_t;
+
+/**
+ * @brief Stream configuration
+ */
+typedef struct {
+    double rate;                    /**< Bytes per second (required, > 0) */
+    uint64_t total_bytes;           /**< Stop after this many bytes (0 = until stopped) */
+    uint64_t tick_ns;               /**< Timer period (default 1 ms) */
+    size_t burst_bytes;             /**< Token bucket depth (0 = 20 ms or one tick of output) */
+    size_t buffer_size;             /**< Generated-ahead bytes (default 1 MB) */
+    size_t generate_chunk;          /**< Bytes per source call (default 64 KB) */
+    size_t max_write;               /**< Largest single sink call (default 64 KB) */
+    uint64_t report_interval_ns;    /**< Report callback period (0 = never) */
+} paced_stream_config_t;
+
+/**
+ * @brief Stream statistics
+ *
+ * Wake jitter is how late the pacing thread woke relative to its schedule;
+ * the achieved rate is emitted bytes over elapsed time since the first tick.
+ */
+typedef struct {
+    uint64_t bytes_emitted;         /**< Bytes handed to the sink */
+    uint64_t bytes_generated;       /**< Bytes produced by the source */
+    uint64_t bytes_forfeited;       /**< Tokens dropped because the bucket was full */
+    uint64_t ticks;                 /**< Timer periods elapsed */
+    uint64_t missed_ticks;          /**< Periods that passed without a wakeup */
+    uint64_t underruns;             /**< Ticks where the buffer held fewer bytes than tokens */
+    uint64_t sink_stalls;           /**< Sink calls that took longer than one tick */
+    uint64_t behind_events;         /**< Ticks where tokens overflowed the bucket */
+    size_t buffer_min;              /**< Lowest buffer level seen after the first tick */
+    double elapsed_s;               /**< Seconds since the first tick */
+    double achieved_rate;           /**< bytes_emitted / elapsed_s */
+    double jitter_mean_ns;          /**< Mean wake lateness */
+    double jitter_stddev_ns;        /**< Standard deviation of wake lateness */
+    double jitter_max_ns;           /**< Worst wake lateness */
+} paced_stream_stats_t;
+
+/**
+ * @brief Produces random bytes; returns 0 on success
+ */
+typedef int (*paced_stream_source_fn)(void *user_data, uint8_t *buffer, size_t size);
+
+/**
+ * @brief Consumes emitted bytes; returns 0 on success
+ */
+typedef int (*paced_stream_sink_fn)(void *user_data, const uint8_t *data, size_t size);
+
+/**
+ * @brief Periodic progress callback, on the pacing thread
+ */
+typedef void (*paced_stream_report_fn)(void *user_data, const paced_stream_stats_t *stats);
+
+typedef struct paced_stream paced_stream_t;
+
+/**
+ * @brief Fill a configuration with defaults (rate is left at 0)
+ */
+void paced_stream_get_default_config(paced_stream_config_t *config);
+
+/**
+ * @brief Create a stream
+ *
+ * @param stream Output handle
+ * @param config Configuration (rate must be set)
+ * @param source Byte source, called on the generator thread only
+ * @param source_data Source user data
+ * @param sink Byte sink, called on the thread running paced_stream_run
+ * @param sink_data Sink user data
+ * @return PACED_STREAM_SUCCESS or error code
+ */
+paced_stream_error_t paced_stream_create(paced_stream_t **stream,
+                                         const paced_stream_config_t *config,
+                                         paced_stream_source_fn source, void *source_data,
+                                         paced_stream_sink_fn sink, void *sink_data);
+
+/**
+ * @brief Set the progress callback (before paced_stream_run)
+ */
+void paced_stream_set_report(paced_stream_t *stream, paced_stream_report_fn report,
+                             void *user_data);
+
+/**
+ * @brief Stream until total_bytes, paced_stream_stop, or an error
+ *
+ * Waits for the buffer to fill halfway before the first tick, so pacing
+ * starts from a generated-ahead position. A stream runs once; create
+ * another to stream again.
+ */
+paced_stream_error_t paced_stream_run(paced_stream_t *stream);
+
+/**
+ * @brief Ask a running stream to return after the current tick
+ *
+ * Async-signal-safe.
+ */
+void paced_stream_stop(paced_stream_t *stream);
+
+/**
+ * @brief Snapshot the statistics (callable while running)
+ */
+void paced_stream_get_stats(paced_stream_t *stream, paced_stream_stats_t *stats);
+
+/**
+ * @brief Wipe the buffer and free the stream
+ */
+void paced_stream_free(paced_stream_t *stream);
+
+/**
+ * @brief paced_stream_source_fn over a secure_rng context (user_data)
+ */
+int paced_stream_secure_rng_source(void *user_data, uint8_t *buffer, size_t size);
+
+const char* paced_stream_error_string(paced_stream_error_t error);
+
+#endif /* PACED_STREAM_H */
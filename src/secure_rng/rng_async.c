@@ -0,0 +1,481 @@
+/**
+ * @file rng_async.c
+ * @brief Piece tasks and completion queue behind rng_async.h
+ */
+
+#include "rng_async.h"
+#include "../common/secure_memory.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+#define RNG_ASYNC_DEFAULT_SPLIT (1024 * 1024)
+#define RNG_ASYNC_DEFAULT_SYNC_THRESHOLD (64 * 1024)
+#define RNG_ASYNC_DEFAULT_MAX_OUTSTANDING 1024
+
+#define STAT_ADD(ctx, field, n) \
+    __atomic_fetch_add(&(ctx)->stats.field, (uint64_t)(n), __ATOMIC_RELAXED)
+
+typedef enum {
+    BACKEND_SECURE_RNG,
+    BACKEND_QRNG_V3
+} backend_t;
+
+/**
+ * @brief One generator instance, used by one task at a time
+ */
+typedef struct {
+    secure_rng_ctx_t *srng;
+    qrng_v3_ctx_t *v3;
+} generator_t;
+
+/**
+ * @brief A split request; one task per piece, each claiming the next offset
+ */
+typedef struct {
+    rng_async_t *ctx;
+    uint8_t *buf;
+    size_t size;
+    void *cookie;
+    size_t next_offset;             /**< Next piece to claim (atomic) */
+    size_t pieces_left;             /**< Pieces not yet generated (atomic) */
+    int failed;                     /**< A piece failed (atomic) */
+} rng_request_t;
+
+struct rng_async {
+    rng_async_config_t config;
+    backend_t backend;
+    secure_rng_config_t srng_config;
+    qrng_v3_config_t v3_config;
+
+    generator_t inline_gen;         /**< For requests below sync_threshold */
+    pthread_mutex_t inline_lock;
+
+    // Piece tasks run on a shared task pool
+    task_pool_t *pool;
+    task_group_t pieces;            /**< Piece tasks in flight */
+
+    // Idle generators; a piece task takes one and creates one if none is idle
+    pthread_mutex_t gen_lock;
+    generator_t **idle_gens;
+    size_t num_idle;
+    size_t num_gens;                /**< Generators created (capacity of idle_gens) */
+
+    // Completion queue: a ring of max_outstanding entries, which cannot
+    // overflow because submit refuses requests beyond that
+    pthread_mutex_t cq_lock;
+    pthread_cond_t cq_cond;
+    rng_async_completion_t *cq;
+    size_t cq_head;
+    size_t cq_count;
+    size_t outstanding;
+    int notify_fd;                  /**< eventfd, or the read end of a pipe */
+    int notify_write_fd;            /**< Same as notify_fd for an eventfd */
+
+    rng_async_stats_t stats;
+};
+
+static const char *error_strings[] = {
+    "Success",
+    "NULL pointer",
+    "Invalid parameter",
+    "Out of memory",
+    "Too many outstanding requests",
+    "Timed out",
+    "Random generation failed",
+    "Initialization failed"
+};
+
+const char* rng_async_error_string(rng_async_error_t error) {
+    int idx = -(int)error;
+    if (idx < 0 || idx >= (int)(sizeof(error_strings) / sizeof(error_strings[0]))) {
+        return "Unknown error";
+    }
+    return error_strings[idx];
+}
+
+void rng_async_get_default_config(rng_async_config_t *config) {
+    if (!config) return;
+    config->pool = NULL;
+    config->workers = 0;
+    config->split_size = RNG_ASYNC_DEFAULT_SPLIT;
+    config->sync_threshold = RNG_ASYNC_DEFAULT_SYNC_THRESHOLD;
+    config->max_outstanding = RNG_ASYNC_DEFAULT_MAX_OUTSTANDING;
+}
+
+// ============================================================================
+// GENERATORS
+// ============================================================================
+
+static int generator_init(rng_async_t *ctx, generator_t *gen) {
+    if (ctx->backend == BACKEND_QRNG_V3) {
+        return qrng_v3_init_with_config(&gen->v3, &ctx->v3_config) == QRNG_V3_SUCCESS ? 0 : -1;
+    }
+    return secure_rng_init_with_config(&gen->srng, &ctx->srng_config) == SECURE_RNG_SUCCESS ? 0 : -1;
+}
+
+static void generator_free(generator_t *gen) {
+    if (gen->srng) secure_rng_free(gen->srng);
+    if (gen->v3) qrng_v3_free(gen->v3);
+    gen->srng = NULL;
+    gen->v3 = NULL;
+}
+
+static int generator_bytes(generator_t *gen, uint8_t *out, size_t len) {
+    if (gen->v3) return qrng_v3_bytes(gen->v3, out, len) == QRNG_V3_SUCCESS ? 0 : -1;
+    return secure_rng_bytes(gen->srng, out, len) == SECURE_RNG_SUCCESS ? 0 : -1;
+}
+
+/**
+ * @brief Create a generator and add it to the set owned by the context
+ *
+ * @return The generator (not on the idle list), or NULL
+ */
+static generator_t* generator_add(rng_async_t *ctx) {
+    generator_t *gen = calloc(1, sizeof(*gen));
+    if (!gen) return NULL;
+    if (generator_init(ctx, gen) != 0) {
+        generator_free(gen);
+        free(gen);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&ctx->gen_lock);
+    generator_t **grown = realloc(ctx->idle_gens, (ctx->num_gens + 1) * sizeof(*grown));
+    if (!grown) {
+        pthread_mutex_unlock(&ctx->gen_lock);
+        generator_free(gen);
+        free(gen);
+        return NULL;
+    }
+    ctx->idle_gens = grown;
+    ctx->num_gens++;
+    pthread_mutex_unlock(&ctx->gen_lock);
+    return gen;
+}
+
+static generator_t* generator_acquire(rng_async_t *ctx) {
+    pthread_mutex_lock(&ctx->gen_lock);
+    generator_t *gen = ctx->num_idle ? ctx->idle_gens[--ctx->num_idle] : NULL;
+    pthread_mutex_unlock(&ctx->gen_lock);
+    return gen ? gen : generator_add(ctx);
+}
+
+static void generator_release(rng_async_t *ctx, generator_t *gen) {
+    pthread_mutex_lock(&ctx->gen_lock);
+    ctx->idle_gens[ctx->num_idle++] = gen;
+    pthread_mutex_unlock(&ctx->gen_lock);
+}
+
+// ============================================================================
+// COMPLETION QUEUE
+// ============================================================================
+
+static void notify_set(rng_async_t *ctx) {
+#ifdef __linux__
+    uint64_t one = 1;
+    if (write(ctx->notify_write_fd, &one, sizeof(one)) < 0) { /* counter already non-zero */ }
+#else
+    char one = 1;
+    if (write(ctx->notify_write_fd, &one, 1) < 0) { /* pipe full: already readable */ }
+#endif
+}
+
+static void notify_clear(rng_async_t *ctx) {
+    uint8_t drain[64];
+    while (read(ctx->notify_fd, drain, sizeof(drain)) > 0) { }
+}
+
+static void post_completion(rng_async_t *ctx, uint8_t *buf, size_t size, void *cookie,
+                            rng_async_error_t status) {
+    if (status != RNG_ASYNC_SUCCESS) {
+        secure_memzero(buf, size);
+        STAT_ADD(ctx, failures, 1);
+    }
+    pthread_mutex_lock(&ctx->cq_lock);
+    size_t slot = (ctx->cq_head + ctx->cq_count) % ctx->config.max_outstanding;
+    ctx->cq[slot] = (rng_async_completion_t){ cookie, buf, size, status };
+    if (ctx->cq_count++ == 0) notify_set(ctx);
+    pthread_cond_broadcast(&ctx->cq_cond);
+    pthread_mutex_unlock(&ctx->cq_lock);
+}
+
+/**
+ * @brief Move up to max completions to out (cq_lock held)
+ */
+static size_t take_completions(rng_async_t *ctx, rng_async_completion_t *out, size_t max) {
+    size_t n = 0;
+    while (n < max && ctx->cq_count > 0) {
+        out[n++] = ctx->cq[ctx->cq_head];
+        ctx->cq_head = (ctx->cq_head + 1) % ctx->config.max_outstanding;
+        ctx->cq_count--;
+    }
+    ctx->outstanding -= n;
+    if (n > 0 && ctx->cq_count == 0) notify_clear(ctx);
+    STAT_ADD(ctx, completed, n);
+    return n;
+}
+
+size_t rng_async_poll(rng_async_t *ctx, rng_async_completion_t *out, size_t max) {
+    if (!ctx || !out || max == 0) return 0;
+    pthread_mutex_lock(&ctx->cq_lock);
+    size_t n = take_completions(ctx, out, max);
+    pthread_mutex_unlock(&ctx->cq_lock);
+    return n;
+}
+
+size_t rng_async_wait(rng_async_t *ctx, rng_async_completion_t *out, size_t max, int timeout_ms) {
+    if (!ctx || !out || max == 0) return 0;
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    if (timeout_ms > 0) {
+        deadline.tv_sec += timeout_ms / 1000;
+        deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&ctx->cq_lock);
+    while (ctx->cq_count == 0 && ctx->outstanding > 0 && timeout_ms != 0) {
+        if (timeout_ms < 0) {
+            pthread_cond_wait(&ctx->cq_cond, &ctx->cq_lock);
+        } else if (pthread_cond_timedwait(&ctx->cq_cond, &ctx->cq_lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    size_t n = take_completions(ctx, out, max);
+    pthread_mutex_unlock(&ctx->cq_lock);
+    return n;
+}
+
+int rng_async_fd(const rng_async_t *ctx) {
+    return ctx ? ctx->notify_fd : -1;
+}
+
+size_t rng_async_outstanding(rng_async_t *ctx) {
+    if (!ctx) return 0;
+    pthread_mutex_lock(&ctx->cq_lock);
+    size_t n = ctx->outstanding;
+    pthread_mutex_unlock(&ctx->cq_lock);
+    return n;
+}
+
+void rng_async_get_stats(rng_async_t *ctx, rng_async_stats_t *stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!ctx) return;
+    stats->submitted = __atomic_load_n(&ctx->stats.submitted, __ATOMIC_RELAXED);
+    stats->completed = __atomic_load_n(&ctx->stats.completed, __ATOMIC_RELAXED);
+    stats->inline_requests = __atomic_load_n(&ctx->stats.inline_requests, __ATOMIC_RELAXED);
+    stats->pieces = __atomic_load_n(&ctx->stats.pieces, __ATOMIC_RELAXED);
+    stats->bytes = __atomic_load_n(&ctx->stats.bytes, __ATOMIC_RELAXED);
+    stats->failures = __atomic_load_n(&ctx->stats.failures, __ATOMIC_RELAXED);
+}
+
+// ============================================================================
+// PIECE TASKS
+// ============================================================================
+
+/**
+ * @brief Generate one piece of a split request (runs on the task pool)
+ */
+static void piece_task(void *arg) {
+    rng_request_t *req = arg;
+    rng_async_t *ctx = req->ctx;
+    size_t offset = __atomic_fetch_add(&req->next_offset, ctx->config.split_size, __ATOMIC_RELAXED);
+    size_t n = req->size - offset;
+    if (n > ctx->config.split_size) n = ctx->config.split_size;
+
+    generator_t *gen = generator_acquire(ctx);
+    if (!gen || generator_bytes(gen, req->buf + offset, n) != 0) {
+        __atomic_store_n(&req->failed, 1, __ATOMIC_RELAXED);
+    }
+    if (gen) generator_release(ctx, gen);
+    STAT_ADD(ctx, pieces, 1);
+    STAT_ADD(ctx, bytes, n);
+
+    // The task finishing the last piece completes the request
+    if (__atomic_sub_fetch(&req->pieces_left, 1, __ATOMIC_ACQ_REL) == 0) {
+        int failed = __atomic_load_n(&req->failed, __ATOMIC_RELAXED);
+        post_completion(ctx, req->buf, req->size, req->cookie,
+                        failed ? RNG_ASYNC_ERROR_GENERATION : RNG_ASYNC_SUCCESS);
+        free(req);
+    }
+}
+
+rng_async_error_t rng_async_submit(rng_async_t *ctx, void *buf, size_t len, void *cookie) {
+    if (!ctx || !buf) return RNG_ASYNC_ERROR_NULL_POINTER;
+    if (len == 0) return RNG_ASYNC_ERROR_INVALID_PARAM;
+
+    pthread_mutex_lock(&ctx->cq_lock);
+    if (ctx->outstanding >= ctx->config.max_outstanding) {
+        pthread_mutex_unlock(&ctx->cq_lock);
+        return RNG_ASYNC_ERROR_QUEUE_FULL;
+    }
+    ctx->outstanding++;
+    pthread_mutex_unlock(&ctx->cq_lock);
+    STAT_ADD(ctx, submitted, 1);
+
+    if (len < ctx->config.sync_threshold) {
+        pthread_mutex_lock(&ctx->inline_lock);
+        int rc = generator_bytes(&ctx->inline_gen, buf, len);
+        pthread_mutex_unlock(&ctx->inline_lock);
+        STAT_ADD(ctx, inline_requests, 1);
+        STAT_ADD(ctx, bytes, len);
+        post_completion(ctx, buf, len, cookie, rc == 0 ? RNG_ASYNC_SUCCESS : RNG_ASYNC_ERROR_GENERATION);
+        return RNG_ASYNC_SUCCESS;
+    }
+
+    rng_request_t *req = calloc(1, sizeof(*req));
+    if (!req) {
+        pthread_mutex_lock(&ctx->cq_lock);
+        ctx->outstanding--;
+        pthread_mutex_unlock(&ctx->cq_lock);
+        return RNG_ASYNC_ERROR_OUT_OF_MEMORY;
+    }
+    req->ctx = ctx;
+    req->buf = buf;
+    req->size = len;
+    req->cookie = cookie;
+    size_t pieces = (len + ctx->config.split_size - 1) / ctx->config.split_size;
+    req->pieces_left = pieces;
+
+    for (size_t i = 0; i < pieces; i++) {
+        if (task_pool_submit(ctx->pool, &ctx->pieces, piece_task, req) != TASK_POOL_SUCCESS) {
+            // Pieces nobody will claim are generated here
+            while (i++ < pieces) piece_task(req);
+            break;
+        }
+    }
+    return RNG_ASYNC_SUCCESS;
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+static int open_notify(rng_async_t *ctx) {
+#ifdef __linux__
+    ctx->notify_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    ctx->notify_write_fd = ctx->notify_fd;
+    return ctx->notify_fd >= 0 ? 0 : -1;
+#else
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    for (int i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    ctx->notify_fd = fds[0];
+    ctx->notify_write_fd = fds[1];
+    return 0;
+#endif
+}
+
+static rng_async_error_t async_create(rng_async_t **out, rng_async_t *ctx,
+                                      const rng_async_config_t *config) {
+    if (config) ctx->config = *config;
+    else rng_async_get_default_config(&ctx->config);
+
+    rng_async_config_t *cfg = &ctx->config;
+    if (cfg->split_size == 0 || cfg->max_outstanding == 0) {
+        free(ctx);
+        return RNG_ASYNC_ERROR_INVALID_PARAM;
+    }
+    ctx->pool = cfg->pool ? cfg->pool : task_pool_default();
+    if (!ctx->pool) {
+        free(ctx);
+        return RNG_ASYNC_ERROR_INIT;
+    }
+    if (cfg->workers == 0) cfg->workers = task_pool_num_threads(ctx->pool);
+
+    ctx->notify_fd = ctx->notify_write_fd = -1;
+    pthread_mutex_init(&ctx->inline_lock, NULL);
+    pthread_mutex_init(&ctx->gen_lock, NULL);
+    pthread_mutex_init(&ctx->cq_lock, NULL);
+    pthread_cond_init(&ctx->cq_cond, NULL);
+
+    ctx->cq = calloc(cfg->max_outstanding, sizeof(*ctx->cq));
+    if (!ctx->cq) {
+        rng_async_free(ctx);
+        return RNG_ASYNC_ERROR_OUT_OF_MEMORY;
+    }
+    if (open_notify(ctx) != 0 || generator_init(ctx, &ctx->inline_gen) != 0) {
+        rng_async_free(ctx);
+        return RNG_ASYNC_ERROR_INIT;
+    }
+    // Create the expected generators now so the first large request does not
+    for (size_t i = 0; i < cfg->workers; i++) {
+        generator_t *gen = generator_add(ctx);
+        if (!gen) {
+            rng_async_free(ctx);
+            return RNG_ASYNC_ERROR_INIT;
+        }
+        generator_release(ctx, gen);
+    }
+
+    *out = ctx;
+    return RNG_ASYNC_SUCCESS;
+}
+
+rng_async_error_t rng_async_create_secure(rng_async_t **ctx,
+                                          const secure_rng_config_t *rng_config,
+                                          const rng_async_config_t *config) {
+    if (!ctx) return RNG_ASYNC_ERROR_NULL_POINTER;
+    *ctx = NULL;
+    rng_async_t *c = calloc(1, sizeof(*c));
+    if (!c) return RNG_ASYNC_ERROR_OUT_OF_MEMORY;
+    c->backend = BACKEND_SECURE_RNG;
+    if (rng_config) c->srng_config = *rng_config;
+    else secure_rng_get_default_config(&c->srng_config);
+    // Each generator is owned by one thread; no locking needed inside
+    c->srng_config.enable_thread_safety = 0;
+    return async_create(ctx, c, config);
+}
+
+rng_async_error_t rng_async_create_v3(rng_async_t **ctx,
+                                      const qrng_v3_config_t *v3_config,
+                                      const rng_async_config_t *config) {
+    if (!ctx) return RNG_ASYNC_ERROR_NULL_POINTER;
+    *ctx = NULL;
+    rng_async_t *c = calloc(1, sizeof(*c));
+    if (!c) return RNG_ASYNC_ERROR_OUT_OF_MEMORY;
+    c->backend = BACKEND_QRNG_V3;
+    if (v3_config) c->v3_config = *v3_config;
+    else qrng_v3_get_default_config(&c->v3_config);
+    return async_create(ctx, c, config);
+}
+
+void rng_async_free(rng_async_t *ctx) {
+    if (!ctx) return;
+
+    // Queued pieces still run; this thread helps with them
+    if (ctx->pool) task_pool_wait(ctx->pool, &ctx->pieces);
+
+    for (size_t i = 0; i < ctx->num_idle; i++) {
+        generator_free(ctx->idle_gens[i]);
+        free(ctx->idle_gens[i]);
+    }
+    generator_free(&ctx->inline_gen);
+    if (ctx->notify_fd >= 0) close(ctx->notify_fd);
+    if (ctx->notify_write_fd >= 0 && ctx->notify_write_fd != ctx->notify_fd) close(ctx->notify_write_fd);
+
+    pthread_mutex_destroy(&ctx->inline_lock);
+    pthread_mutex_destroy(&ctx->gen_lock);
+    pthread_mutex_destroy(&ctx->cq_lock);
+    pthread_cond_destroy(&ctx->cq_cond);
+    free(ctx->cq);
+    free(ctx->idle_gens);
+    free(ctx);
+}
@@ -0,0 +1,160 @@
+#ifndef RNG_ASYNC_H
+#define RNG_ASYNC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "secure_rng.h"
+#include "../quantum_rng/quantum_rng_v3.h"
+#include "../scheduler/task_pool.h"
+
+/**
+ * @file rng_async.h
+ * @brief Asynchronous random generation with a completion queue
+ *
+ * A 64 MB secure_rng_bytes() or qrng_v3_bytes() call blocks its caller for
+ * the whole generation. An rng_async context instead takes requests with
+ * rng_async_submit() and reports them through a completion queue:
+ *
+ * - requests below sync_threshold are generated during submit on the
+ *   caller's thread (a pool hop would cost more than the work) and their
+ *   completion is queued before submit returns;
+ * - larger requests are split into split_size pieces, one task each on the
+ *   shared task pool (task_pool.h), so one request uses every core; each
+ *   piece borrows an idle generator from the context;
+ * - the task finishing a request's last piece queues its completion and
+ *   makes rng_async_fd() readable, so an epoll loop can watch it next to
+ *   its sockets and call rng_async_poll() when it fires.
+ *
+ * Requests start in submission order; completions may arrive out of
+ * order. A buffer belongs to the context from submit until its completion
+ * is returned; a failed request's buffer is zeroed.
+ *
+ * Output is the concatenation of independent generator instances, each
+ * created with the same mode and configuration as the context.
+ */
+
+/**
+ * @brief Async error codes (also used as completion status)
+ */
+typedef enum {
+    RNG_ASYNC_SUCCESS = 0,                  /**< Operation successful */
+    RNG_ASYNC_ERROR_NULL_POINTER = -1,      /**< NULL argument */
+    RNG_ASYNC_ERROR_INVALID_PARAM = -2,     /**< Bad size or configuration */
+    RNG_ASYNC_ERROR_OUT_OF_MEMORY = -3,     /**< Allocation failed */
+    RNG_ASYNC_ERROR_QUEUE_FULL = -4,        /**< max_outstanding requests in flight */
+    RNG_ASYNC_ERROR_TIMEOUT = -5,           /**< rng_async_wait timed out */
+    RNG_ASYNC_ERROR_GENERATION = -6,        /**< A generator call failed */
+    RNG_ASYNC_ERROR_INIT = -7               /**< Generator, thread or fd setup failed */
+} rng_async_error_t;
+
+/**
+ * @brief Pool configuration
+ */
+typedef struct {
+    task_pool_t *pool;              /**< Pool for piece tasks (NULL = task_pool_default()) */
+    size_t workers;                 /**< Generators created up front (0 = pool threads) */
+    size_t split_size;              /**< Bytes per piece (default 1 MB) */
+    size_t sync_threshold;          /**< Smaller requests run inline (default 64 KB) */
+    size_t max_outstanding;         /**< Submitted, not yet returned by poll (default 1024) */
+} rng_async_config_t;
+
+/**
+ * @brief One finished request
+ */
+typedef struct {
+    void *cookie;                   /**< As passed to rng_async_submit */
+    uint8_t *buffer;
+    size_t size;
+    rng_async_error_t status;       /**< RNG_ASYNC_SUCCESS or RNG_ASYNC_ERROR_GENERATION */
+} rng_async_completion_t;
+
+/**
+ * @brief Counters
+ */
+typedef struct {
+    uint64_t submitted;
+    uint64_t completed;             /**< Completions returned by poll/wait */
+    uint64_t inline_requests;       /**< Generated synchronously in submit */
+    uint64_t pieces;                /**< Pieces generated by the pool */
+    uint64_t bytes;                 /**< Bytes generated (inline and pool) */
+    uint64_t failures;              /**< Requests completed with an error */
+} rng_async_stats_t;
+
+typedef struct rng_async rng_async_t;
+
+void rng_async_get_default_config(rng_async_config_t *config);
+
+/**
+ * @brief Async context over secure_rng generators
+ *
+ * @param ctx Output context
+ * @param rng_config Generator configuration (NULL = secure_rng defaults)
+ * @param config Pool configuration (NULL = defaults)
+ */
+rng_async_error_t rng_async_create_secure(rng_async_t **ctx,
+                                          const secure_rng_config_t *rng_config,
+                                          const rng_async_config_t *config);
+
+/**
+ * @brief Async context over qrng_v3 generators
+ *
+ * @param ctx Output context
+ * @param v3_config Generator configuration (NULL = qrng_v3 defaults)
+ * @param config Pool configuration (NULL = defaults)
+ */
+rng_async_error_t rng_async_create_v3(rng_async_t **ctx,
+                                      const qrng_v3_config_t *v3_config,
+                                      const rng_async_config_t *config);
+
+/**
+ * @brief Queue a request for len random bytes into buf
+ *
+ * Thread-safe. Small requests are generated before this returns.
+ *
+ * @return RNG_ASYNC_SUCCESS (the completion will be queued),
+ *         RNG_ASYNC_ERROR_QUEUE_FULL, or a parameter error
+ */
+rng_async_error_t rng_async_submit(rng_async_t *ctx, void *buf, size_t len, void *cookie);
+
+/**
+ * @brief Take up to max finished requests without blocking
+ *
+ * @return Number of completions written to out
+ */
+size_t rng_async_poll(rng_async_t *ctx, rng_async_completion_t *out, size_t max);
+
+/**
+ * @brief Like rng_async_poll, but block until at least one completion
+ *
+ * @param timeout_ms Maximum wait (< 0 = no limit)
+ * @return Completions written (>= 1), or 0 on timeout or when nothing is
+ *         outstanding
+ */
+size_t rng_async_wait(rng_async_t *ctx, rng_async_completion_t *out, size_t max, int timeout_ms);
+
+/**
+ * @brief Descriptor readable while completions are queued
+ *
+ * An eventfd on Linux, a pipe elsewhere. Level-triggered: it stays
+ * readable until rng_async_poll() has taken every completion. Do not read
+ * it directly.
+ */
+int rng_async_fd(const rng_async_t *ctx);
+
+/**
+ * @brief Requests submitted and not yet returned by poll/wait
+ */
+size_t rng_async_outstanding(rng_async_t *ctx);
+
+void rng_async_get_stats(rng_async_t *ctx, rng_async_stats_t *stats);
+
+/**
+ * @brief Finish queued pieces and free the context
+ *
+ * Completions not yet polled are discarded; their buffers are complete.
+ */
+void rng_async_free(rng_async_t *ctx);
+
+const char* rng_async_error_string(rng_async_error_t error);
+
+#endif /* RNG_ASYNC_H */
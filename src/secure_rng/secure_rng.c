@@ -4,11 +4,13 @@
 #include "../quantum_rng/quantum_state.h"
 #include "../quantum_rng/bell_test.h"
 #include "../quantum_rng/quantum_entropy.h"
+#include "../entropy/seed_file.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
 #include <pthread.h>
+#include <errno.h>
 
 /**
  * @file secure_rng.c
@@ -41,7 +43,7 @@ static secure_rng_error_t lock_write(secure_rng_ctx_t *ctx) {
     if (!ctx) return SECURE_RNG_ERROR_NULL_CONTEXT;
     if (!ctx->thread_safe) return SECURE_RNG_SUCCESS;
     
-    if (pthread_rwlock_wrlock(&ctx->rwlock) != 0) {
+    if (lock_stats_rwlock_wrlock(&ctx->rwlock, &ctx->rwlock_stats) != 0) {
         return SECURE_RNG_ERROR_MUTEX_LOCK;
     }
     return SECURE_RNG_SUCCESS;
@@ -57,7 +59,7 @@ static secure_rng_error_t lock_read(const secure_rng_ctx_t *ctx) {
     // Cast away const for locking - this is safe for rwlock
     // as read locks don't modify the logical state
     secure_rng_ctx_t *mutable_ctx = (secure_rng_ctx_t *)ctx;
-    if (pthread_rwlock_rdlock(&mutable_ctx->rwlock) != 0) {
+    if (lock_stats_rwlock_rdlock(&mutable_ctx->rwlock, &mutable_ctx->rwlock_stats) != 0) {
         return SECURE_RNG_ERROR_MUTEX_LOCK;
     }
     return SECURE_RNG_SUCCESS;
@@ -208,6 +210,231 @@ static secure_rng_error_t run_bell_certification(secure_rng_ctx_t *ctx) {
     return SECURE_RNG_SUCCESS;
 }
 
+// ============================================================================
+// STARTUP
+// ============================================================================
+
+/**
+ * @brief Seed file outcome of the startup tests, published by the caller
+ */
+typedef struct {
+    int loaded;             /**< A seed file was mixed into the startup entropy */
+    int saved;              /**< A seed file was written for the next start */
+    time_t saved_time;      /**< When saved was decided */
+} startup_seed_t;
+
+/**
+ * @brief Write a seed for the next start, drawn from the quantum RNG
+ *
+ * Uses only ctx->seed_path and ctx->qrng_ctx. Returns 1 on success.
+ */
+static int write_seed_file(secure_rng_ctx_t *ctx) {
+    uint8_t seed[SEED_FILE_SEED_SIZE];
+    int saved = 0;
+
+    if (!ctx->seed_path || !ctx->qrng_ctx) return 0;
+    if (qrng_bytes(ctx->qrng_ctx, seed, sizeof(seed)) == QRNG_SUCCESS &&
+        seed_file_write(ctx->seed_path, seed) == SEED_FILE_SUCCESS) {
+        saved = 1;
+    }
+    secure_memzero(seed, sizeof(seed));
+    return saved;
+}
+
+/**
+ * @brief Save a seed for the next start and record it in the statistics
+ *
+ * Caller holds the write lock (or has exclusive use of ctx).
+ */
+static void save_seed_file(secure_rng_ctx_t *ctx) {
+    ctx->seed_saved_time = time(NULL);
+    if (write_seed_file(ctx)) {
+        ctx->stats.seed_file_saves++;
+    }
+}
+
+/**
+ * @brief Record the startup seed file outcome in the statistics
+ *
+ * Caller holds the write lock (or has exclusive use of ctx).
+ */
+static void publish_startup_seed(secure_rng_ctx_t *ctx, const startup_seed_t *seed) {
+    ctx->stats.seed_file_loaded = seed->loaded;
+    ctx->stats.seed_file_saves += (uint64_t)seed->saved;
+    ctx->seed_saved_time = seed->saved_time;
+}
+
+/**
+ * @brief Mix the seed file into tested startup entropy
+ *
+ * XORs a stream derived from the seed file and the startup entropy itself
+ * into the startup entropy. The fresh entropy is never replaced, only
+ * strengthened, so a missing or stale seed costs nothing. Returns 1 when a
+ * seed was mixed in.
+ */
+static int mix_seed_file(secure_rng_ctx_t *ctx, uint8_t entropy[STARTUP_ENTROPY_SIZE]) {
+    uint8_t key[SEED_FILE_KEY_SIZE];
+    uint8_t stream[STARTUP_ENTROPY_SIZE];
+
+    if (seed_file_consume(ctx->seed_path, entropy, STARTUP_ENTROPY_SIZE, key) != SEED_FILE_SUCCESS) {
+        return 0;
+    }
+
+    seed_file_expand(key, stream, sizeof(stream));
+    for (size_t i = 0; i < sizeof(stream); i++) {
+        entropy[i] ^= stream[i];
+    }
+
+    secure_memzero(key, sizeof(key));
+    secure_memzero(stream, sizeof(stream));
+    return 1;
+}
+
+/**
+ * @brief Run the startup health tests and seed the quantum RNG
+ *
+ * Collects STARTUP_ENTROPY_SIZE bytes, runs the NIST SP 800-90B startup
+ * tests over them and, only if they pass, uses them (mixed with the seed
+ * file, when configured) to initialize ctx->qrng_ctx. Writes the entropy,
+ * health and qrng contexts and the seed file; the seed file outcome goes to
+ * *seed, not ctx->stats, so a background caller can publish it under the
+ * write lock.
+ */
+static secure_rng_error_t run_startup_tests(secure_rng_ctx_t *ctx, startup_seed_t *seed) {
+    memset(seed, 0, sizeof(*seed));
+
+    uint8_t *startup_entropy = calloc(1, STARTUP_ENTROPY_SIZE);
+    if (!startup_entropy) {
+        return SECURE_RNG_ERROR_INITIALIZATION;
+    }
+
+    // Collect startup entropy
+    entropy_error_t entropy_err = entropy_get_bytes(ctx->entropy_ctx, startup_entropy, STARTUP_ENTROPY_SIZE);
+    if (entropy_err != ENTROPY_SUCCESS) {
+        secure_memzero(startup_entropy, STARTUP_ENTROPY_SIZE);
+        free(startup_entropy);
+        return SECURE_RNG_ERROR_ENTROPY_FAILURE;
+    }
+
+    // Run startup tests
+    health_error_t health_err = health_tests_startup(ctx->health_ctx, startup_entropy, STARTUP_ENTROPY_SIZE);
+    if (health_err != HEALTH_SUCCESS) {
+        secure_memzero(startup_entropy, STARTUP_ENTROPY_SIZE);
+        free(startup_entropy);
+        return SECURE_RNG_ERROR_STARTUP_FAILED;
+    }
+
+    // The health tests ran on the raw source; the seed file is mixed in after
+    int seeded = ctx->seed_path &&
+                 mix_seed_file(ctx, startup_entropy);
+
+    // Initialize quantum RNG with tested entropy
+    qrng_error qrng_err = qrng_init(&ctx->qrng_ctx, startup_entropy, STARTUP_ENTROPY_SIZE);
+    secure_memzero(startup_entropy, STARTUP_ENTROPY_SIZE);
+    free(startup_entropy);
+
+    if (qrng_err != QRNG_SUCCESS) {
+        ctx->qrng_ctx = NULL;
+        return SECURE_RNG_ERROR_INITIALIZATION;
+    }
+
+    // Consuming the seed file already replaced it; otherwise create one
+    seed->loaded = seeded;
+    if (ctx->seed_path) {
+        seed->saved_time = time(NULL);
+        seed->saved = seeded || write_seed_file(ctx);
+    }
+
+    return SECURE_RNG_SUCCESS;
+}
+
+/**
+ * @brief Background half of a lazy_init context's startup
+ */
+static void* deferred_startup_thread(void *arg) {
+    secure_rng_ctx_t *ctx = (secure_rng_ctx_t *)arg;
+
+    startup_seed_t seed;
+    secure_rng_error_t result = run_startup_tests(ctx, &seed);
+
+    // Readers of the statistics may already hold the context
+    if (result == SECURE_RNG_SUCCESS && lock_write(ctx) == SECURE_RNG_SUCCESS) {
+        publish_startup_seed(ctx, &seed);
+        unlock(ctx);
+    }
+
+    pthread_mutex_lock(&ctx->startup_mutex);
+    ctx->startup_result = result;
+    __atomic_store_n(&ctx->state,
+                     result == SECURE_RNG_SUCCESS ? SECURE_RNG_STATE_OPERATIONAL
+                                                  : SECURE_RNG_STATE_ERROR,
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&ctx->startup_done, 1, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&ctx->startup_cond);
+    pthread_mutex_unlock(&ctx->startup_mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief Launch the startup tests on a background thread
+ */
+static secure_rng_error_t start_deferred_startup(secure_rng_ctx_t *ctx) {
+    if (pthread_mutex_init(&ctx->startup_mutex, NULL) != 0) {
+        return SECURE_RNG_ERROR_INITIALIZATION;
+    }
+    if (pthread_cond_init(&ctx->startup_cond, NULL) != 0) {
+        pthread_mutex_destroy(&ctx->startup_mutex);
+        return SECURE_RNG_ERROR_INITIALIZATION;
+    }
+
+    ctx->lazy_startup = 1;
+    ctx->startup_done = 0;
+    ctx->startup_result = SECURE_RNG_ERROR_STARTUP_FAILED;
+
+    if (pthread_create(&ctx->startup_thread, NULL, deferred_startup_thread, ctx) != 0) {
+        pthread_cond_destroy(&ctx->startup_cond);
+        pthread_mutex_destroy(&ctx->startup_mutex);
+        ctx->lazy_startup = 0;
+        return SECURE_RNG_ERROR_INITIALIZATION;
+    }
+    return SECURE_RNG_SUCCESS;
+}
+
+/**
+ * @brief Join the startup thread of a lazy_init context
+ */
+static void stop_deferred_startup(secure_rng_ctx_t *ctx) {
+    if (!ctx->lazy_startup) return;
+
+    pthread_join(ctx->startup_thread, NULL);
+    pthread_cond_destroy(&ctx->startup_cond);
+    pthread_mutex_destroy(&ctx->startup_mutex);
+    ctx->lazy_startup = 0;
+}
+
+/**
+ * @brief Block until the startup tests have finished
+ *
+ * Output gate for lazy_init contexts: returns SECURE_RNG_SUCCESS only once
+ * the startup tests have passed and the quantum RNG is seeded. Eager
+ * contexts return immediately.
+ */
+static secure_rng_error_t await_startup(secure_rng_ctx_t *ctx) {
+    if (!ctx->lazy_startup) return SECURE_RNG_SUCCESS;
+
+    if (!__atomic_load_n(&ctx->startup_done, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_lock(&ctx->startup_mutex);
+        while (!ctx->startup_done) {
+            pthread_cond_wait(&ctx->startup_cond, &ctx->startup_mutex);
+        }
+        pthread_mutex_unlock(&ctx->startup_mutex);
+    }
+
+    return ctx->startup_result == SECURE_RNG_SUCCESS ?
+           SECURE_RNG_SUCCESS : SECURE_RNG_ERROR_STARTUP_FAILED;
+}
+
 // ============================================================================
 // CONFIGURATION
 // ============================================================================
@@ -243,6 +470,12 @@ void secure_rng_get_default_config(secure_rng_config_t *config) {
     
     // Thread safety defaults
     config->enable_thread_safety = 0;  // Disabled by default (per-thread contexts recommended)
+
+    // Startup defaults
+    config->lazy_init = 0;  // Run startup tests inside init
+
+    // Seed file defaults
+    config->seed_file = NULL;  // No persisted seed
 }
 
 /**
@@ -317,9 +550,21 @@ secure_rng_error_t secure_rng_init_with_config(
     memcpy(&ctx->config, config, sizeof(secure_rng_config_t));
     ctx->state = SECURE_RNG_STATE_STARTUP;
 
+    // Keep our own copy of the seed path; the caller's string may not
+    // outlive the context
+    if (config->seed_file) {
+        ctx->seed_path = strdup(config->seed_file);
+        if (!ctx->seed_path) {
+            free(ctx);
+            return SECURE_RNG_ERROR_INITIALIZATION;
+        }
+        ctx->config.seed_file = ctx->seed_path;
+    }
+
     // Initialize entropy source
     ctx->entropy_ctx = calloc(1, sizeof(entropy_ctx_t));
     if (!ctx->entropy_ctx) {
+        free(ctx->seed_path);
         free(ctx);
         return SECURE_RNG_ERROR_INITIALIZATION;
     }
@@ -327,6 +572,7 @@ secure_rng_error_t secure_rng_init_with_config(
     entropy_error_t entropy_err = entropy_init(ctx->entropy_ctx);
     if (entropy_err != ENTROPY_SUCCESS) {
         free(ctx->entropy_ctx);
+        free(ctx->seed_path);
         free(ctx);
         return SECURE_RNG_ERROR_ENTROPY_FAILURE;
     }
@@ -338,6 +584,7 @@ secure_rng_error_t secure_rng_init_with_config(
             !caps.has_dev_random && !caps.has_dev_urandom) {
             entropy_free(ctx->entropy_ctx);
             free(ctx->entropy_ctx);
+            free(ctx->seed_path);
             free(ctx);
             return SECURE_RNG_ERROR_ENTROPY_FAILURE;
         }
@@ -348,6 +595,7 @@ secure_rng_error_t secure_rng_init_with_config(
     if (!ctx->health_ctx) {
         entropy_free(ctx->entropy_ctx);
         free(ctx->entropy_ctx);
+        free(ctx->seed_path);
         free(ctx);
         return SECURE_RNG_ERROR_INITIALIZATION;
     }
@@ -365,79 +613,20 @@ secure_rng_error_t secure_rng_init_with_config(
         entropy_free(ctx->entropy_ctx);
         free(ctx->entropy_ctx);
         free(ctx->health_ctx);
+        free(ctx->seed_path);
         free(ctx);
         return SECURE_RNG_ERROR_INITIALIZATION;
     }
 
-    // Run startup health tests
-    uint8_t *startup_entropy = calloc(1, STARTUP_ENTROPY_SIZE);
-    if (!startup_entropy) {
-        health_tests_free(ctx->health_ctx);
-        entropy_free(ctx->entropy_ctx);
-        free(ctx->health_ctx);
-        free(ctx->entropy_ctx);
-        free(ctx);
-        return SECURE_RNG_ERROR_INITIALIZATION;
-    }
-
-    // Collect startup entropy
-    entropy_err = entropy_get_bytes(ctx->entropy_ctx, startup_entropy, STARTUP_ENTROPY_SIZE);
-    if (entropy_err != ENTROPY_SUCCESS) {
-        secure_memzero(startup_entropy, STARTUP_ENTROPY_SIZE);
-        free(startup_entropy);
-        health_tests_free(ctx->health_ctx);
-        entropy_free(ctx->entropy_ctx);
-        free(ctx->health_ctx);
-        free(ctx->entropy_ctx);
-        free(ctx);
-        return SECURE_RNG_ERROR_ENTROPY_FAILURE;
-    }
-
-    // Run startup tests
-    health_err = health_tests_startup(ctx->health_ctx, startup_entropy, STARTUP_ENTROPY_SIZE);
-    if (health_err != HEALTH_SUCCESS) {
-        secure_memzero(startup_entropy, STARTUP_ENTROPY_SIZE);
-        free(startup_entropy);
-        health_tests_free(ctx->health_ctx);
-        entropy_free(ctx->entropy_ctx);
-        free(ctx->health_ctx);
-        free(ctx->entropy_ctx);
-        free(ctx);
-        return SECURE_RNG_ERROR_STARTUP_FAILED;
-    }
-
-    // Initialize quantum RNG with tested entropy
-    qrng_error qrng_err = qrng_init(&ctx->qrng_ctx, startup_entropy, STARTUP_ENTROPY_SIZE);
-    secure_memzero(startup_entropy, STARTUP_ENTROPY_SIZE);
-    free(startup_entropy);
-
-    if (qrng_err != QRNG_SUCCESS) {
-        health_tests_free(ctx->health_ctx);
-        entropy_free(ctx->entropy_ctx);
-        free(ctx->health_ctx);
-        free(ctx->entropy_ctx);
-        free(ctx);
-        return SECURE_RNG_ERROR_INITIALIZATION;
-    }
-
-    // Initialize entropy cache if configured
-    if (config->entropy_cache_size > 0) {
-        ctx->entropy_cache = calloc(1, config->entropy_cache_size);
-        if (ctx->entropy_cache) {
-            ctx->cache_size = config->entropy_cache_size;
-            ctx->cache_used = 0;
-        }
-    }
-
-    // Initialize thread safety if requested
+    // Initialize thread safety if requested; before startup, whose
+    // background thread publishes its results under the write lock
     if (config->enable_thread_safety) {
         if (pthread_rwlock_init(&ctx->rwlock, NULL) != 0) {
-            qrng_free(ctx->qrng_ctx);
             health_tests_free(ctx->health_ctx);
             entropy_free(ctx->entropy_ctx);
             free(ctx->health_ctx);
             free(ctx->entropy_ctx);
-            if (ctx->entropy_cache) free(ctx->entropy_cache);
+            free(ctx->seed_path);
             free(ctx);
             return SECURE_RNG_ERROR_INITIALIZATION;
         }
@@ -445,14 +634,55 @@ secure_rng_error_t secure_rng_init_with_config(
         ctx->rwlock_initialized = 1;
     }
 
+    // Run startup health tests and seed the quantum RNG, either now or on a
+    // background thread that generation calls wait for
+    if (config->lazy_init) {
+        secure_rng_error_t start_err = start_deferred_startup(ctx);
+        if (start_err != SECURE_RNG_SUCCESS) {
+            if (ctx->rwlock_initialized) pthread_rwlock_destroy(&ctx->rwlock);
+            health_tests_free(ctx->health_ctx);
+            entropy_free(ctx->entropy_ctx);
+            free(ctx->health_ctx);
+            free(ctx->entropy_ctx);
+            free(ctx->seed_path);
+            free(ctx);
+            return start_err;
+        }
+    } else {
+        startup_seed_t seed;
+        secure_rng_error_t startup_err = run_startup_tests(ctx, &seed);
+        if (startup_err != SECURE_RNG_SUCCESS) {
+            if (ctx->rwlock_initialized) pthread_rwlock_destroy(&ctx->rwlock);
+            health_tests_free(ctx->health_ctx);
+            entropy_free(ctx->entropy_ctx);
+            free(ctx->health_ctx);
+            free(ctx->entropy_ctx);
+            free(ctx->seed_path);
+            free(ctx);
+            return startup_err;
+        }
+        publish_startup_seed(ctx, &seed);
+    }
+
+    // Initialize entropy cache if configured
+    if (config->entropy_cache_size > 0) {
+        ctx->entropy_cache = calloc(1, config->entropy_cache_size);
+        if (ctx->entropy_cache) {
+            ctx->cache_size = config->entropy_cache_size;
+            ctx->cache_used = 0;
+        }
+    }
+
     // Initialize statistics
     ctx->stats.state = SECURE_RNG_STATE_OPERATIONAL;
     ctx->stats.current_mode = config->mode;
     ctx->stats.primary_source = ctx->entropy_ctx->caps.preferred_source;
     ctx->stats.last_reseed_time = time(NULL);
 
-    // Set state to operational
-    ctx->state = SECURE_RNG_STATE_OPERATIONAL;
+    // Set state to operational (deferred startup publishes it when done)
+    if (!ctx->lazy_startup) {
+        ctx->state = SECURE_RNG_STATE_OPERATIONAL;
+    }
 
     *ctx_out = ctx;
     return SECURE_RNG_SUCCESS;
@@ -481,6 +711,16 @@ secure_rng_error_t secure_rng_init_threadsafe_with_config(
 void secure_rng_free(secure_rng_ctx_t *ctx) {
     if (!ctx) return;
 
+    // Let deferred startup finish before tearing down what it uses
+    stop_deferred_startup(ctx);
+
+    // Save a seed for the next start
+    if (ctx->seed_path && ctx->state == SECURE_RNG_STATE_OPERATIONAL) {
+        save_seed_file(ctx);
+    }
+    free(ctx->seed_path);
+    ctx->seed_path = NULL;
+
     // Set state to shutdown
     ctx->state = SECURE_RNG_STATE_SHUTDOWN;
 
@@ -525,6 +765,9 @@ void secure_rng_free(secure_rng_ctx_t *ctx) {
 secure_rng_error_t secure_rng_reset(secure_rng_ctx_t *ctx) {
     if (!ctx) return SECURE_RNG_ERROR_NULL_CONTEXT;
     
+    secure_rng_error_t startup_err = await_startup(ctx);
+    if (startup_err != SECURE_RNG_SUCCESS) return startup_err;
+    
     secure_rng_error_t lock_err = lock_write(ctx);
     if (lock_err != SECURE_RNG_SUCCESS) return lock_err;
     
@@ -556,6 +799,9 @@ secure_rng_error_t secure_rng_reseed(secure_rng_ctx_t *ctx) {
     
     // Note: Caller (secure_rng_reset or init) handles locking
     
+    secure_rng_error_t startup_err = await_startup(ctx);
+    if (startup_err != SECURE_RNG_SUCCESS) return startup_err;
+    
     if (ctx->state != SECURE_RNG_STATE_OPERATIONAL) {
         return SECURE_RNG_ERROR_NOT_INITIALIZED;
     }
@@ -583,6 +829,12 @@ secure_rng_error_t secure_rng_reseed(secure_rng_ctx_t *ctx) {
     ctx->bell_certified = 0;  /* renew Bell certification for the new epoch */
     ctx->stats.last_reseed_time = time(NULL);
 
+    // Refresh the seed file periodically, so a crash loses little
+    if (ctx->seed_path &&
+        ctx->stats.last_reseed_time - ctx->seed_saved_time >= SEED_FILE_DEFAULT_SAVE_INTERVAL_S) {
+        save_seed_file(ctx);
+    }
+
     return SECURE_RNG_SUCCESS;
 }
 
@@ -594,6 +846,9 @@ secure_rng_error_t secure_rng_reseed_with_entropy(
     if (!ctx) return SECURE_RNG_ERROR_NULL_CONTEXT;
     if (!external_entropy || size == 0) return SECURE_RNG_ERROR_INVALID_PARAM;
     
+    secure_rng_error_t startup_err = await_startup(ctx);
+    if (startup_err != SECURE_RNG_SUCCESS) return startup_err;
+    
     secure_rng_error_t lock_err = lock_write(ctx);
     if (lock_err != SECURE_RNG_SUCCESS) return lock_err;
     
@@ -658,45 +913,18 @@ secure_rng_error_t secure_rng_reseed_with_entropy(
 // RANDOM NUMBER GENERATION
 // ============================================================================
 
-secure_rng_error_t secure_rng_bytes(
+/**
+ * @brief Generate size bytes in the given (non-HYBRID) mode (caller holds the write lock)
+ */
+static secure_rng_error_t generate_locked(
     secure_rng_ctx_t *ctx,
+    secure_rng_mode_t mode,
     uint8_t *buffer,
     size_t size
 ) {
-    if (!ctx) return SECURE_RNG_ERROR_NULL_CONTEXT;
-    if (!buffer || size == 0) return SECURE_RNG_ERROR_NULL_BUFFER;
-    
-    secure_rng_error_t lock_err = lock_write(ctx);
-    if (lock_err != SECURE_RNG_SUCCESS) return lock_err;
-    
-    if (ctx->state != SECURE_RNG_STATE_OPERATIONAL) {
-        unlock(ctx);
-        return SECURE_RNG_ERROR_NOT_INITIALIZED;
-    }
-
-    // Determine effective mode (for HYBRID)
-    secure_rng_mode_t effective_mode = ctx->config.mode;
-    if (effective_mode == SECURE_RNG_MODE_HYBRID) {
-        effective_mode = (size < ctx->config.hybrid_threshold) ?
-                         SECURE_RNG_MODE_FAST : SECURE_RNG_MODE_QUANTUM;
-    }
-
-    // Check if reseed needed
-    if (reseed_needed(ctx)) {
-        secure_rng_error_t err = secure_rng_reseed(ctx);
-        if (err != SECURE_RNG_SUCCESS) {
-            if (ctx->config.zeroize_on_error) {
-                secure_memzero(buffer, size);
-            }
-            unlock(ctx);
-            return err;
-        }
-    }
-
-    // Generate based on mode
     secure_rng_error_t result = SECURE_RNG_SUCCESS;
     
-    switch (effective_mode) {
+    switch (mode) {
         case SECURE_RNG_MODE_FAST:
             // Direct hardware entropy (fastest, still health-tested)
             result = collect_tested_entropy(ctx, buffer, size);
@@ -753,10 +981,65 @@ secure_rng_error_t secure_rng_bytes(
             break;
             
         case SECURE_RNG_MODE_HYBRID:
-            // Should not reach here (handled above)
+            // Should not reach here (resolved by the caller)
             result = SECURE_RNG_ERROR_INVALID_PARAM;
             break;
     }
+    
+    return result;
+}
+
+/**
+ * @brief Resolve HYBRID to the mode used for a request of this size
+ */
+static secure_rng_mode_t effective_mode_for(const secure_rng_ctx_t *ctx, size_t size) {
+    secure_rng_mode_t mode = ctx->config.mode;
+    if (mode == SECURE_RNG_MODE_HYBRID) {
+        mode = (size < ctx->config.hybrid_threshold) ?
+               SECURE_RNG_MODE_FAST : SECURE_RNG_MODE_QUANTUM;
+    }
+    return mode;
+}
+
+secure_rng_error_t secure_rng_bytes(
+    secure_rng_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size
+) {
+    if (!ctx) return SECURE_RNG_ERROR_NULL_CONTEXT;
+    if (!buffer || size == 0) return SECURE_RNG_ERROR_NULL_BUFFER;
+    
+    secure_rng_error_t startup_err = await_startup(ctx);
+    if (startup_err != SECURE_RNG_SUCCESS) {
+        if (ctx->config.zeroize_on_error) {
+            secure_memzero(buffer, size);
+        }
+        return startup_err;
+    }
+    
+    secure_rng_error_t lock_err = lock_write(ctx);
+    if (lock_err != SECURE_RNG_SUCCESS) return lock_err;
+    
+    if (ctx->state != SECURE_RNG_STATE_OPERATIONAL) {
+        unlock(ctx);
+        return SECURE_RNG_ERROR_NOT_INITIALIZED;
+    }
+
+    secure_rng_mode_t effective_mode = effective_mode_for(ctx, size);
+
+    // Check if reseed needed
+    if (reseed_needed(ctx)) {
+        secure_rng_error_t err = secure_rng_reseed(ctx);
+        if (err != SECURE_RNG_SUCCESS) {
+            if (ctx->config.zeroize_on_error) {
+                secure_memzero(buffer, size);
+            }
+            unlock(ctx);
+            return err;
+        }
+    }
+
+    secure_rng_error_t result = generate_locked(ctx, effective_mode, buffer, size);
 
     if (result == SECURE_RNG_SUCCESS) {
         // Update statistics
@@ -769,6 +1052,182 @@ secure_rng_error_t secure_rng_bytes(
     return result;
 }
 
+// ============================================================================
+// BOUNDED GENERATION
+// ============================================================================
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief CLOCK_REALTIME equivalent of a monotonic deadline, for pthread timed waits
+ */
+static struct timespec realtime_deadline(uint64_t deadline_ns) {
+    uint64_t now = now_ns();
+    uint64_t left = deadline_ns > now ? deadline_ns - now : 0;
+    
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += (time_t)(left / 1000000000ULL);
+    ts.tv_nsec += (long)(left % 1000000000ULL);
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+/**
+ * @brief await_startup() that gives up immediately (nonblocking) or at deadline_ns
+ */
+static secure_rng_error_t await_startup_bounded(
+    secure_rng_ctx_t *ctx,
+    int nonblocking,
+    uint64_t deadline_ns
+) {
+    if (!ctx->lazy_startup) return SECURE_RNG_SUCCESS;
+
+    if (!__atomic_load_n(&ctx->startup_done, __ATOMIC_ACQUIRE)) {
+        if (nonblocking) return SECURE_RNG_ERROR_WOULD_BLOCK;
+        
+        struct timespec abs = realtime_deadline(deadline_ns);
+        pthread_mutex_lock(&ctx->startup_mutex);
+        while (!ctx->startup_done) {
+            if (pthread_cond_timedwait(&ctx->startup_cond, &ctx->startup_mutex, &abs) == ETIMEDOUT) {
+                break;
+            }
+        }
+        int done = ctx->startup_done;
+        pthread_mutex_unlock(&ctx->startup_mutex);
+        if (!done) return SECURE_RNG_ERROR_TIMEOUT;
+    }
+
+    return ctx->startup_result == SECURE_RNG_SUCCESS ?
+           SECURE_RNG_SUCCESS : SECURE_RNG_ERROR_STARTUP_FAILED;
+}
+
+/**
+ * @brief lock_write() that gives up immediately (nonblocking) or at deadline_ns
+ */
+static secure_rng_error_t lock_write_bounded(
+    secure_rng_ctx_t *ctx,
+    int nonblocking,
+    uint64_t deadline_ns
+) {
+    if (!ctx->thread_safe) return SECURE_RNG_SUCCESS;
+    
+    int rc;
+    if (nonblocking) {
+        rc = pthread_rwlock_trywrlock(&ctx->rwlock);
+    } else {
+        struct timespec abs = realtime_deadline(deadline_ns);
+        rc = pthread_rwlock_timedwrlock(&ctx->rwlock, &abs);
+    }
+    
+    if (rc == EBUSY) return SECURE_RNG_ERROR_WOULD_BLOCK;
+    if (rc == ETIMEDOUT) return SECURE_RNG_ERROR_TIMEOUT;
+    if (rc != 0) return SECURE_RNG_ERROR_MUTEX_LOCK;
+    return SECURE_RNG_SUCCESS;
+}
+
+/**
+ * @brief Shared body of secure_rng_try_bytes and secure_rng_bytes_deadline
+ *
+ * Output is generated in SECURE_RNG_BOUNDED_CHUNK pieces with the deadline
+ * checked between them, so a deadline call overruns by at most one chunk
+ * (or one reseed or Bell certification, which also run as a single step).
+ */
+#define SECURE_RNG_BOUNDED_CHUNK 4096
+static secure_rng_error_t bytes_bounded(
+    secure_rng_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    int nonblocking,
+    uint64_t deadline_ns,
+    size_t *filled
+) {
+    if (filled) *filled = 0;
+    if (!ctx) return SECURE_RNG_ERROR_NULL_CONTEXT;
+    if (!buffer || size == 0) return SECURE_RNG_ERROR_NULL_BUFFER;
+    
+    secure_rng_error_t err = await_startup_bounded(ctx, nonblocking, deadline_ns);
+    if (err != SECURE_RNG_SUCCESS) return err;
+    
+    err = lock_write_bounded(ctx, nonblocking, deadline_ns);
+    if (err != SECURE_RNG_SUCCESS) return err;
+    
+    if (ctx->state != SECURE_RNG_STATE_OPERATIONAL) {
+        unlock(ctx);
+        return SECURE_RNG_ERROR_NOT_INITIALIZED;
+    }
+    
+    secure_rng_mode_t effective_mode = effective_mode_for(ctx, size);
+    
+    // Reseeding and Bell certification collect hardware entropy on this
+    // thread; a try call leaves them to a call that can wait
+    if (nonblocking && (reseed_needed(ctx) ||
+                        (effective_mode == SECURE_RNG_MODE_VERIFIED && !ctx->bell_certified))) {
+        unlock(ctx);
+        return SECURE_RNG_ERROR_WOULD_BLOCK;
+    }
+    
+    if (reseed_needed(ctx)) {
+        err = secure_rng_reseed(ctx);
+        if (err != SECURE_RNG_SUCCESS) {
+            unlock(ctx);
+            return err;
+        }
+    }
+    
+    size_t done = 0;
+    secure_rng_error_t result = SECURE_RNG_SUCCESS;
+    while (done < size) {
+        if (!nonblocking && now_ns() >= deadline_ns) {
+            result = SECURE_RNG_ERROR_TIMEOUT;
+            break;
+        }
+        
+        size_t n = size - done < SECURE_RNG_BOUNDED_CHUNK ? size - done : SECURE_RNG_BOUNDED_CHUNK;
+        result = generate_locked(ctx, effective_mode, buffer + done, n);
+        if (result != SECURE_RNG_SUCCESS) break;
+        done += n;
+    }
+    
+    ctx->stats.bytes_generated += done;
+    ctx->bytes_since_reseed += done;
+    if (result == SECURE_RNG_SUCCESS) {
+        ctx->stats.requests_served++;
+    }
+    
+    unlock(ctx);
+    if (filled) *filled = done;
+    return result;
+}
+
+secure_rng_error_t secure_rng_try_bytes(
+    secure_rng_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    size_t *filled
+) {
+    return bytes_bounded(ctx, buffer, size, 1, 0, filled);
+}
+
+secure_rng_error_t secure_rng_bytes_deadline(
+    secure_rng_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    uint64_t timeout_ns,
+    size_t *filled
+) {
+    uint64_t start = now_ns();
+    uint64_t deadline = timeout_ns > UINT64_MAX - start ? UINT64_MAX : start + timeout_ns;
+    return bytes_bounded(ctx, buffer, size, 0, deadline, filled);
+}
+
 secure_rng_error_t secure_rng_uint64(secure_rng_ctx_t *ctx, uint64_t *value) {
     if (!ctx) return SECURE_RNG_ERROR_NULL_CONTEXT;
     if (!value) return SECURE_RNG_ERROR_NULL_BUFFER;
@@ -868,18 +1327,32 @@ secure_rng_error_t secure_rng_get_stats(
     if (lock_err != SECURE_RNG_SUCCESS) return lock_err;
 
     memcpy(stats, &ctx->stats, sizeof(*stats));
+    stats->state = secure_rng_get_state(ctx);
     
     unlock(ctx);
     return SECURE_RNG_SUCCESS;
 }
 
+secure_rng_error_t secure_rng_get_lock_stats(
+    const secure_rng_ctx_t *ctx,
+    qrng_lock_stats_t *stats
+) {
+    if (!ctx) return SECURE_RNG_ERROR_NULL_CONTEXT;
+    if (!stats) return SECURE_RNG_ERROR_NULL_BUFFER;
+
+    // Read without taking the lock so the snapshot does not count itself
+    lock_stats_snapshot(&ctx->rwlock_stats, stats);
+    return SECURE_RNG_SUCCESS;
+}
+
 secure_rng_state_t secure_rng_get_state(const secure_rng_ctx_t *ctx) {
     if (!ctx) return SECURE_RNG_STATE_UNINITIALIZED;
-    return ctx->state;
+    // Atomic: a lazy_init context's startup thread publishes the state
+    return __atomic_load_n(&ctx->state, __ATOMIC_ACQUIRE);
 }
 
 int secure_rng_is_operational(const secure_rng_ctx_t *ctx) {
-    return (ctx && ctx->state == SECURE_RNG_STATE_OPERATIONAL);
+    return secure_rng_get_state(ctx) == SECURE_RNG_STATE_OPERATIONAL;
 }
 
 const health_test_stats_t* secure_rng_get_health_stats(const secure_rng_ctx_t *ctx) {
@@ -989,6 +1462,10 @@ const char* secure_rng_error_string(secure_rng_error_t error) {
             return "Mutex lock failed";
         case SECURE_RNG_ERROR_MUTEX_UNLOCK:
             return "Mutex unlock failed";
+        case SECURE_RNG_ERROR_WOULD_BLOCK:
+            return "Output not available without blocking";
+        case SECURE_RNG_ERROR_TIMEOUT:
+            return "Deadline passed before the request was filled";
         default:
             return "Unknown error";
     }
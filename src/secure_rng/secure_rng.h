@@ -7,6 +7,7 @@
 #include "../quantum_rng/quantum_rng.h"
 #include "../entropy/hardware_entropy.h"
 #include "../health/health_tests.h"
+#include "../common/lock_stats.h"
 
 /**
  * @file secure_rng.h
@@ -82,6 +83,10 @@ typedef struct {
     
     // Thread safety configuration
     int enable_thread_safety;         /**< Enable pthread mutex locking */
+
+    // Startup configuration
+    int lazy_init;                    /**< Run startup tests in the background; output waits for them */
+    const char *seed_file;            /**< Seed file (seed_file.h) mixed into the startup seed, NULL for none (copied at init) */
 } secure_rng_config_t;
 
 /**
@@ -100,7 +105,9 @@ typedef enum {
     SECURE_RNG_ERROR_INSUFFICIENT_ENTROPY = -9, /**< Not enough entropy */
     SECURE_RNG_ERROR_INVALID_RANGE = -10,      /**< Invalid range parameters */
     SECURE_RNG_ERROR_MUTEX_LOCK = -11,         /**< Mutex lock failed */
-    SECURE_RNG_ERROR_MUTEX_UNLOCK = -12        /**< Mutex unlock failed */
+    SECURE_RNG_ERROR_MUTEX_UNLOCK = -12,       /**< Mutex unlock failed */
+    SECURE_RNG_ERROR_WOULD_BLOCK = -13,        /**< try call would have had to wait */
+    SECURE_RNG_ERROR_TIMEOUT = -14             /**< Deadline passed; partial fill */
 } secure_rng_error_t;
 
 /**
@@ -145,6 +152,10 @@ typedef struct {
     secure_rng_state_t state;          /**< Current state */
     secure_rng_mode_t current_mode;    /**< Current operation mode */
     time_t last_reseed_time;           /**< Last reseed timestamp */
+
+    // Seed file
+    int seed_file_loaded;              /**< Startup seed was mixed with the seed file */
+    uint64_t seed_file_saves;          /**< Successful seed file writes */
 } secure_rng_stats_t;
 
 /**
@@ -171,6 +182,10 @@ typedef struct {
     // Reseeding tracking
     uint64_t bytes_since_reseed;       /**< Bytes since last reseed */
 
+    // Seed file (config.seed_file)
+    char *seed_path;                   /**< Owned copy of config.seed_file */
+    time_t seed_saved_time;            /**< Last seed file write */
+
     // VERIFIED-mode Bell certification
     int bell_certified;                /**< 1 once the quantum source has passed a CHSH Bell test this epoch */
     double last_chsh_value;            /**< Most recent measured CHSH S value (0 until first certification) */
@@ -179,6 +194,15 @@ typedef struct {
     int thread_safe;                   /**< Thread-safety enabled flag */
     pthread_rwlock_t rwlock;           /**< Read-write lock for thread safety */
     int rwlock_initialized;            /**< RW-lock initialization flag */
+    qrng_lock_stats_t rwlock_stats;    /**< Contention stats (QRNG_LOCK_STATS builds) */
+
+    // Deferred startup (config.lazy_init)
+    int lazy_startup;                  /**< Startup tests run on startup_thread */
+    pthread_t startup_thread;          /**< Collects startup entropy and runs the startup tests */
+    pthread_mutex_t startup_mutex;     /**< Guards startup_done / startup_result */
+    pthread_cond_t startup_cond;       /**< Signalled when the startup tests finish */
+    int startup_done;                  /**< 1 once startup_result is final */
+    secure_rng_error_t startup_result; /**< Outcome of the deferred startup tests */
 
     // Error callback
     void (*error_callback)(secure_rng_error_t error, const char *msg, void *user_data);
@@ -220,6 +244,12 @@ secure_rng_error_t secure_rng_init(secure_rng_ctx_t **ctx);
 /**
  * @brief Initialize secure RNG with custom configuration
  *
+ * With config->lazy_init set, steps 3-4 of secure_rng_init() run on a
+ * background thread and this call returns with the context in
+ * SECURE_RNG_STATE_STARTUP. Generation calls block until the startup tests
+ * have passed, so no output is ever produced from untested entropy; if they
+ * fail, those calls return SECURE_RNG_ERROR_STARTUP_FAILED.
+ *
  * @param ctx Output context pointer
  * @param config Custom configuration
  * @return SECURE_RNG_SUCCESS or error code
@@ -300,6 +330,53 @@ secure_rng_error_t secure_rng_bytes(
     size_t size
 );
 
+/**
+ * @brief Generate random bytes without waiting
+ *
+ * Fails with SECURE_RNG_ERROR_WOULD_BLOCK, writing nothing, when output
+ * would first need something this call does not wait for: the deferred
+ * startup tests of a lazy_init context, the lock of a thread-safe context
+ * held by another thread, a due reseed, or VERIFIED-mode Bell
+ * certification. Those run on the next secure_rng_bytes() or
+ * secure_rng_bytes_deadline() call. Otherwise generates the whole request.
+ *
+ * @param ctx Secure RNG context
+ * @param buffer Output buffer
+ * @param size Number of bytes to generate
+ * @param filled Output: bytes written (may be NULL)
+ * @return SECURE_RNG_SUCCESS, SECURE_RNG_ERROR_WOULD_BLOCK or error code
+ */
+secure_rng_error_t secure_rng_try_bytes(
+    secure_rng_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    size_t *filled
+);
+
+/**
+ * @brief Generate random bytes, giving up after timeout_ns
+ *
+ * Waits for startup and the lock no longer than the deadline, then
+ * generates in 4 KB steps, checking the deadline between steps. The call
+ * overruns the deadline by at most one step (a 4 KB chunk, a reseed or a
+ * Bell certification). On SECURE_RNG_ERROR_TIMEOUT the first *filled
+ * bytes of buffer are valid output.
+ *
+ * @param ctx Secure RNG context
+ * @param buffer Output buffer
+ * @param size Number of bytes to generate
+ * @param timeout_ns Time allowed, from the call
+ * @param filled Output: bytes written (may be NULL)
+ * @return SECURE_RNG_SUCCESS, SECURE_RNG_ERROR_TIMEOUT or error code
+ */
+secure_rng_error_t secure_rng_bytes_deadline(
+    secure_rng_ctx_t *ctx,
+    uint8_t *buffer,
+    size_t size,
+    uint64_t timeout_ns,
+    size_t *filled
+);
+
 /**
  * @brief Generate random 64-bit unsigned integer
  *
@@ -450,6 +527,21 @@ const health_test_stats_t* secure_rng_get_health_stats(const secure_rng_ctx_t *c
  */
 const entropy_capabilities_t* secure_rng_get_entropy_caps(const secure_rng_ctx_t *ctx);
 
+/**
+ * @brief Get contention statistics for the context's read-write lock
+ *
+ * Counters are only recorded when the library is built with
+ * QRNG_LOCK_STATS (`make LOCK_STATS=1`); otherwise they read as zero.
+ *
+ * @param ctx Secure RNG context
+ * @param stats Output lock statistics
+ * @return SECURE_RNG_SUCCESS or error code
+ */
+secure_rng_error_t secure_rng_get_lock_stats(
+    const secure_rng_ctx_t *ctx,
+    qrng_lock_stats_t *stats
+);
+
 /**
  * @brief Print detailed statistics
  *
@@ -0,0 +1,811 @@
+/**
+ * @file benchmark_harness.c
+ * @brief Unified benchmark driver for every engine in the library
+ *
+ * Replaces the per-binary ad-hoc tables (benchmark_suite.c, benchmark_matrix.c,
+ * phase3_phase4_benchmark.c, ...) with a single registry of benchmarks:
+ * - qrng_v3 in every mode
+ * - secure_rng in every mode at several request sizes
+ * - entropy pool, health tests
+ * - gate kernels (H, CNOT, Toffoli, measurement) across qubit counts
+ * - Bell (CHSH) test and Grover iterations / sampling
+ *
+ * Methodology:
+ * - Each benchmark is calibrated so one repetition lasts at least --min-ms
+ * - Warmup repetitions are discarded, then --reps repetitions are timed
+ * - Reports mean, standard deviation and a Student-t 95% confidence interval
+ * - The process is pinned to one CPU (Linux) to avoid migration noise
+ * - Optional hardware counters (IPC, LLC MPKI) via the performance monitor
+ *
+ * Output is a human-readable table plus machine-readable JSON (--json).
+ * With --baseline the run is compared against a stored JSON file and the
+ * process exits non-zero when any benchmark regresses by more than
+ * --threshold percent (see `make bench_check`).
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <sched.h>
+#endif
+
+#include "../src/quantum_rng/quantum_rng_v3.h"
+#include "../src/quantum_rng/quantum_state.h"
+#include "../src/quantum_rng/quantum_gates.h"
+#include "../src/quantum_rng/bell_test.h"
+#include "../src/quantum_rng/grover.h"
+#include "../src/quantum_rng/quantum_entropy.h"
+#include "../src/quantum_rng/simd_ops.h"
+#include "../src/secure_rng/secure_rng.h"
+#include "../src/entropy/entropy_pool.h"
+#include "../src/entropy/hardware_entropy.h"
+#include "../src/health/health_tests.h"
+#include "../src/profiling/performance_monitor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define BENCH_MAX_CASES 128
+#define BENCH_MAX_REPS 100
+#define BENCH_BUFFER_SIZE (1024 * 1024)
+#define BENCH_NAME_LEN 64
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
+typedef struct bench_case bench_case_t;
+
+/**
+ * @brief One registered benchmark
+ *
+ * run() performs a single operation; the harness calls it in a calibrated
+ * loop. bytes_per_op > 0 adds a throughput column.
+ */
+struct bench_case {
+    char name[BENCH_NAME_LEN];
+    const char *group;
+    perf_operation_t hw_op;           /**< Counter attribution category */
+    size_t bytes_per_op;
+    int param;                        /**< Mode or qubit count */
+    size_t size;                      /**< Request size in bytes */
+    uint64_t min_ops;                 /**< Lower bound on ops per repetition */
+    void *state;
+    void *aux;                        /**< Per-case scratch (e.g. state template) */
+    int (*setup)(bench_case_t *bc);
+    int (*run)(bench_case_t *bc);
+    void (*teardown)(bench_case_t *bc);
+};
+
+/**
+ * @brief Timing result for one benchmark
+ */
+typedef struct {
+    double mean_ns;                   /**< Mean time per operation */
+    double stddev_ns;
+    double ci95_ns;                   /**< Half-width of the 95% CI */
+    double min_ns;
+    double mbps;                      /**< Throughput at the mean (0 if n/a) */
+    uint64_t ops_per_rep;
+    double ipc;                       /**< -1 when counters unavailable */
+    double llc_mpki;
+    int failed;
+} bench_result_t;
+
+typedef struct {
+    const char *filter;
+    const char *json_path;
+    const char *baseline_path;
+    double threshold_pct;
+    int warmup;
+    int reps;
+    double min_ms;
+    int cpu;
+    int max_qubits;
+    int hw_counters;
+    int list_only;
+} bench_options_t;
+
+static bench_case_t cases[BENCH_MAX_CASES];
+static size_t num_cases = 0;
+static uint8_t *bench_buffer = NULL;
+
+// Shared entropy for measurement-based kernels (Bell, Grover, measure)
+static entropy_ctx_t bench_hw_entropy;
+static quantum_entropy_ctx_t bench_qentropy;
+
+static int bench_entropy_callback(void *user_data, uint8_t *buffer, size_t size) {
+    return entropy_get_bytes((entropy_ctx_t *)user_data, buffer, size) == ENTROPY_SUCCESS ? 0 : -1;
+}
+
+static bench_case_t* register_case(const char *group, const char *name,
+                                   perf_operation_t hw_op, size_t bytes_per_op) {
+    if (num_cases >= BENCH_MAX_CASES) return NULL;
+    bench_case_t *bc = &cases[num_cases++];
+    memset(bc, 0, sizeof(*bc));
+    bc->group = group;
+    snprintf(bc->name, sizeof(bc->name), "%s", name);
+    bc->hw_op = hw_op;
+    bc->bytes_per_op = bytes_per_op;
+    return bc;
+}
+
+// ============================================================================
+// QRNG V3
+// ============================================================================
+
+static int v3_setup(bench_case_t *bc) {
+    qrng_v3_config_t config;
+    qrng_v3_get_default_config(&config);
+    config.mode = (qrng_v3_mode_t)bc->param;
+    config.enable_performance_monitoring = 0;
+    qrng_v3_ctx_t *ctx = NULL;
+    if (qrng_v3_init_with_config(&ctx, &config) != QRNG_V3_SUCCESS) return -1;
+    bc->state = ctx;
+    return 0;
+}
+
+static int v3_run(bench_case_t *bc) {
+    return qrng_v3_bytes((qrng_v3_ctx_t *)bc->state, bench_buffer, bc->size) == QRNG_V3_SUCCESS ? 0 : -1;
+}
+
+static void v3_teardown(bench_case_t *bc) {
+    qrng_v3_free((qrng_v3_ctx_t *)bc->state);
+}
+
+// ============================================================================
+// SECURE RNG
+// ============================================================================
+
+static int srng_setup(bench_case_t *bc) {
+    secure_rng_config_t config;
+    secure_rng_get_default_config(&config);
+    config.mode = (secure_rng_mode_t)bc->param;
+    secure_rng_ctx_t *ctx = NULL;
+    if (secure_rng_init_with_config(&ctx, &config) != SECURE_RNG_SUCCESS) return -1;
+    bc->state = ctx;
+    return 0;
+}
+
+static int srng_run(bench_case_t *bc) {
+    return secure_rng_bytes((secure_rng_ctx_t *)bc->state, bench_buffer, bc->size) == SECURE_RNG_SUCCESS ? 0 : -1;
+}
+
+static void srng_teardown(bench_case_t *bc) {
+    secure_rng_free((secure_rng_ctx_t *)bc->state);
+}
+
+// ============================================================================
+// ENTROPY POOL / HEALTH TESTS
+// ============================================================================
+
+static int pool_setup(bench_case_t *bc) {
+    entropy_pool_ctx_t *pool = NULL;
+    if (entropy_pool_init(&pool) != 0) return -1;
+    bc->state = pool;
+    return 0;
+}
+
+static int pool_run(bench_case_t *bc) {
+    return entropy_pool_get_bytes((entropy_pool_ctx_t *)bc->state, bench_buffer, bc->size);
+}
+
+static void pool_teardown(bench_case_t *bc) {
+    entropy_pool_free((entropy_pool_ctx_t *)bc->state);
+}
+
+static int health_setup(bench_case_t *bc) {
+    health_test_ctx_t *ctx = calloc(1, sizeof(health_test_ctx_t));
+    if (!ctx) return -1;
+    if (health_tests_init(ctx) != HEALTH_SUCCESS) {
+        free(ctx);
+        return -1;
+    }
+    // Feed real entropy so the batch never trips RCT/APT
+    if (entropy_get_bytes(&bench_hw_entropy, bench_buffer, bc->size) != ENTROPY_SUCCESS) {
+        health_tests_free(ctx);
+        free(ctx);
+        return -1;
+    }
+    bc->state = ctx;
+    return 0;
+}
+
+static int health_run(bench_case_t *bc) {
+    return health_tests_run_batch((health_test_ctx_t *)bc->state, bench_buffer, bc->size) == HEALTH_SUCCESS ? 0 : -1;
+}
+
+static void health_teardown(bench_case_t *bc) {
+    health_tests_free((health_test_ctx_t *)bc->state);
+    free(bc->state);
+}
+
+// ============================================================================
+// GATE KERNELS / BELL / GROVER
+// ============================================================================
+
+static int state_setup(bench_case_t *bc) {
+    quantum_state_t *state = malloc(sizeof(quantum_state_t));
+    if (!state) return -1;
+    if (quantum_state_init(state, (size_t)bc->param) != QS_SUCCESS) {
+        free(state);
+        return -1;
+    }
+    // Spread amplitude over the register so kernels touch every element
+    for (int q = 0; q < bc->param; q++) {
+        gate_hadamard(state, q);
+    }
+    bc->state = state;
+    return 0;
+}
+
+static void state_teardown(bench_case_t *bc) {
+    quantum_state_free((quantum_state_t *)bc->state);
+    free(bc->state);
+}
+
+static int gate_h_run(bench_case_t *bc) {
+    return gate_hadamard((quantum_state_t *)bc->state, bc->param / 2) == QS_SUCCESS ? 0 : -1;
+}
+
+static int gate_cnot_run(bench_case_t *bc) {
+    return gate_cnot((quantum_state_t *)bc->state, 0, bc->param - 1) == QS_SUCCESS ? 0 : -1;
+}
+
+static int gate_toffoli_run(bench_case_t *bc) {
+    return gate_toffoli((quantum_state_t *)bc->state, 0, 1, bc->param - 1) == QS_SUCCESS ? 0 : -1;
+}
+
+static int measure_setup(bench_case_t *bc) {
+    if (state_setup(bc) != 0) return -1;
+    quantum_state_t *state = (quantum_state_t *)bc->state;
+    size_t bytes = state->state_dim * sizeof(complex_t);
+    bc->aux = malloc(bytes);
+    if (!bc->aux) {
+        state_teardown(bc);
+        return -1;
+    }
+    memcpy(bc->aux, state->amplitudes, bytes);
+    return 0;
+}
+
+static int measure_run(bench_case_t *bc) {
+    quantum_state_t *state = (quantum_state_t *)bc->state;
+    // Measurement collapses the state; restore the superposition with one copy
+    memcpy(state->amplitudes, bc->aux, state->state_dim * sizeof(complex_t));
+    (void)quantum_measure_all_fast(state, &bench_qentropy);
+    return 0;
+}
+
+static void measure_teardown(bench_case_t *bc) {
+    free(bc->aux);
+    state_teardown(bc);
+}
+
+static int bell_run(bench_case_t *bc) {
+    quantum_state_t *state = (quantum_state_t *)bc->state;
+    bell_test_result_t result = bell_test_chsh(state, 0, 1, bc->size, NULL, &bench_qentropy);
+    return result.chsh_value > 0.0 ? 0 : -1;
+}
+
+static int grover_iter_run(bench_case_t *bc) {
+    return grover_iteration((quantum_state_t *)bc->state, 1) == QS_SUCCESS ? 0 : -1;
+}
+
+static int grover_sample_run(bench_case_t *bc) {
+    (void)grover_random_sample((quantum_state_t *)bc->state, (size_t)bc->param, &bench_qentropy);
+    return 0;
+}
+
+// ============================================================================
+// OUTPUT ENCODING
+// ============================================================================
+
+static int encode_setup(bench_case_t *bc) {
+    if (entropy_get_bytes(&bench_hw_entropy, bench_buffer, bc->size) != ENTROPY_SUCCESS) {
+        return -1;
+    }
+    bc->state = malloc(2 * bc->size + 4);
+    return bc->state ? 0 : -1;
+}
+
+static int encode_hex_run(bench_case_t *bc) {
+    return simd_encode_hex(bench_buffer, bc->size, (char *)bc->state) == 2 * bc->size ? 0 : -1;
+}
+
+static int encode_base64_run(bench_case_t *bc) {
+    return simd_encode_base64(bench_buffer, bc->size, (char *)bc->state) > 0 ? 0 : -1;
+}
+
+static void encode_teardown(bench_case_t *bc) {
+    free(bc->state);
+    bc->state = NULL;
+}
+
+// ============================================================================
+// REGISTRY CONSTRUCTION
+// ============================================================================
+
+static void build_registry(int max_qubits) {
+    // Short, stable names: these are the keys used for baseline comparison
+    static const char *v3_modes[] = {"direct", "grover", "bell_verified"};
+    static const char *srng_modes[] = {"fast", "quantum", "hybrid", "verified"};
+    static const size_t srng_sizes[] = {32, 4096, 65536};
+    static const int qubit_counts[] = {10, 14, 18, 20, 22, 24};
+    char name[BENCH_NAME_LEN];
+    bench_case_t *bc;
+
+    for (int mode = QRNG_V3_MODE_DIRECT; mode <= QRNG_V3_MODE_BELL_VERIFIED; mode++) {
+        snprintf(name, sizeof(name), "qrng_v3/%s/4096", v3_modes[mode]);
+        bc = register_case("qrng_v3", name, PERF_OP_OUTPUT_GENERATION, 4096);
+        if (!bc) return;
+        // One rep must span a full output-buffer refill cycle to amortize it
+        bc->param = mode; bc->size = 4096; bc->min_ops = 65536 / 4096;
+        bc->setup = v3_setup; bc->run = v3_run; bc->teardown = v3_teardown;
+    }
+
+    for (int mode = SECURE_RNG_MODE_FAST; mode <= SECURE_RNG_MODE_VERIFIED; mode++) {
+        for (size_t i = 0; i < sizeof(srng_sizes) / sizeof(srng_sizes[0]); i++) {
+            snprintf(name, sizeof(name), "secure_rng/%s/%zu", srng_modes[mode], srng_sizes[i]);
+            bc = register_case("secure_rng", name, PERF_OP_OUTPUT_GENERATION, srng_sizes[i]);
+            if (!bc) return;
+            bc->param = mode; bc->size = srng_sizes[i];
+            bc->setup = srng_setup; bc->run = srng_run; bc->teardown = srng_teardown;
+        }
+    }
+
+    bc = register_case("entropy", "entropy_pool/get/32", PERF_OP_ENTROPY_COLLECTION, 32);
+    if (!bc) return;
+    bc->size = 32; bc->setup = pool_setup; bc->run = pool_run; bc->teardown = pool_teardown;
+    bc = register_case("entropy", "entropy_pool/get/4096", PERF_OP_ENTROPY_COLLECTION, 4096);
+    if (!bc) return;
+    bc->size = 4096; bc->min_ops = ENTROPY_POOL_DEFAULT_SIZE / 4096;
+    bc->setup = pool_setup; bc->run = pool_run; bc->teardown = pool_teardown;
+
+    bc = register_case("health", "health/batch/4096", PERF_OP_HEALTH_TEST, 4096);
+    if (!bc) return;
+    bc->size = 4096; bc->setup = health_setup; bc->run = health_run; bc->teardown = health_teardown;
+
+    bc = register_case("encode", "encode/hex/65536", PERF_OP_OUTPUT_GENERATION, 65536);
+    if (!bc) return;
+    bc->size = 65536; bc->setup = encode_setup; bc->run = encode_hex_run; bc->teardown = encode_teardown;
+    bc = register_case("encode", "encode/base64/65536", PERF_OP_OUTPUT_GENERATION, 65536);
+    if (!bc) return;
+    bc->size = 65536; bc->setup = encode_setup; bc->run = encode_base64_run; bc->teardown = encode_teardown;
+
+    for (size_t i = 0; i < sizeof(qubit_counts) / sizeof(qubit_counts[0]); i++) {
+        int n = qubit_counts[i];
+        if (n > max_qubits) break;
+        size_t state_bytes = ((size_t)1 << n) * sizeof(complex_t);
+
+        snprintf(name, sizeof(name), "gate/hadamard/%dq", n);
+        bc = register_case("gates", name, PERF_OP_GATE_SINGLE_QUBIT, state_bytes);
+        if (!bc) return;
+        bc->param = n; bc->setup = state_setup; bc->run = gate_h_run; bc->teardown = state_teardown;
+
+        snprintf(name, sizeof(name), "gate/cnot/%dq", n);
+        bc = register_case("gates", name, PERF_OP_GATE_TWO_QUBIT, state_bytes);
+        if (!bc) return;
+        bc->param = n; bc->setup = state_setup; bc->run = gate_cnot_run; bc->teardown = state_teardown;
+
+        snprintf(name, sizeof(name), "gate/toffoli/%dq", n);
+        bc = register_case("gates", name, PERF_OP_GATE_MULTI_QUBIT, state_bytes);
+        if (!bc) return;
+        bc->param = n; bc->setup = state_setup; bc->run = gate_toffoli_run; bc->teardown = state_teardown;
+
+        snprintf(name, sizeof(name), "measure/all_fast/%dq", n);
+        bc = register_case("gates", name, PERF_OP_MEASUREMENT, 0);
+        if (!bc) return;
+        bc->param = n; bc->setup = measure_setup; bc->run = measure_run; bc->teardown = measure_teardown;
+    }
+
+    bc = register_case("bell", "bell/chsh/1000", PERF_OP_QUANTUM_MIXING, 0);
+    if (!bc) return;
+    bc->param = 2; bc->size = 1000;
+    bc->setup = state_setup; bc->run = bell_run; bc->teardown = state_teardown;
+
+    for (int n = 8; n <= 12 && n <= max_qubits; n += 4) {
+        snprintf(name, sizeof(name), "grover/iteration/%dq", n);
+        bc = register_case("grover", name, PERF_OP_GATE_MULTI_QUBIT, 0);
+        if (!bc) return;
+        bc->param = n; bc->setup = state_setup; bc->run = grover_iter_run; bc->teardown = state_teardown;
+
+        snprintf(name, sizeof(name), "grover/sample/%dq", n);
+        bc = register_case("grover", name, PERF_OP_QUANTUM_MIXING, 0);
+        if (!bc) return;
+        bc->param = n; bc->setup = state_setup; bc->run = grover_sample_run; bc->teardown = state_teardown;
+    }
+}
+
+// ============================================================================
+// TIMING AND STATISTICS
+// ============================================================================
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Two-sided 95% Student-t critical value for df degrees of freedom
+ */
+static double t_critical_95(int df) {
+    static const double table[] = {
+        0.0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+        2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093,
+        2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (df <= 0) return 0.0;
+    if (df <= 30) return table[df];
+    return 1.96;
+}
+
+/**
+ * @brief Time one repetition of ops iterations; returns total ns or -1
+ */
+static double time_rep(bench_case_t *bc, uint64_t ops) {
+    double start = now_ns();
+    for (uint64_t i = 0; i < ops; i++) {
+        if (bc->run(bc) != 0) return -1.0;
+    }
+    return now_ns() - start;
+}
+
+static void run_case(bench_case_t *bc, const bench_options_t *opts,
+                     perf_monitor_ctx_t *mon, bench_result_t *res) {
+    double samples[BENCH_MAX_REPS];
+    memset(res, 0, sizeof(*res));
+    res->ipc = -1.0;
+    res->llc_mpki = -1.0;
+
+    if (bc->setup(bc) != 0) {
+        res->failed = 1;
+        return;
+    }
+
+    // Prime lazily-filled buffers so calibration sees steady-state cost
+    if (bc->run(bc) != 0) {
+        res->failed = 1;
+        bc->teardown(bc);
+        return;
+    }
+
+    // Calibrate: grow the inner loop until one rep takes at least min_ms
+    uint64_t ops = bc->min_ops > 0 ? bc->min_ops : 1;
+    double target_ns = opts->min_ms * 1e6;
+    for (;;) {
+        double t = time_rep(bc, ops);
+        if (t < 0) {
+            res->failed = 1;
+            bc->teardown(bc);
+            return;
+        }
+        if (t >= target_ns || ops >= ((uint64_t)1 << 30)) break;
+        uint64_t next = t > 0 ? (uint64_t)(ops * (target_ns / t) * 1.2) : ops * 10;
+        ops = next > ops ? next : ops * 2;
+    }
+    res->ops_per_rep = ops;
+
+    for (int w = 0; w < opts->warmup; w++) {
+        (void)time_rep(bc, ops);
+    }
+
+    if (mon) {
+        perf_monitor_reset(mon);
+        perf_monitor_start_operation(mon, bc->hw_op);
+    }
+
+    int n = 0;
+    for (int r = 0; r < opts->reps; r++) {
+        double t = time_rep(bc, ops);
+        if (t < 0) {
+            res->failed = 1;
+            break;
+        }
+        samples[n++] = t / (double)ops;
+    }
+
+    if (mon) {
+        perf_monitor_end_operation(mon);
+        perf_hw_counters_t counters;
+        perf_hw_derived_t derived;
+        if (perf_monitor_get_hw_counters(mon, bc->hw_op, &counters, &derived) == 0) {
+            res->ipc = derived.ipc;
+            res->llc_mpki = derived.llc_mpki;
+        }
+    }
+
+    bc->teardown(bc);
+    if (n == 0) {
+        res->failed = 1;
+        return;
+    }
+
+    double sum = 0.0, min = samples[0];
+    for (int i = 0; i < n; i++) {
+        sum += samples[i];
+        if (samples[i] < min) min = samples[i];
+    }
+    double mean = sum / n;
+    double var = 0.0;
+    for (int i = 0; i < n; i++) {
+        var += (samples[i] - mean) * (samples[i] - mean);
+    }
+    var = n > 1 ? var / (n - 1) : 0.0;
+
+    res->mean_ns = mean;
+    res->stddev_ns = sqrt(var);
+    res->ci95_ns = n > 1 ? t_critical_95(n - 1) * res->stddev_ns / sqrt((double)n) : 0.0;
+    res->min_ns = min;
+    res->mbps = (bc->bytes_per_op > 0 && mean > 0) ?
+                (double)bc->bytes_per_op / mean * 1e9 / (1024.0 * 1024.0) : 0.0;
+}
+
+// ============================================================================
+// CPU PINNING
+// ============================================================================
+
+static int pin_cpu(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set);
+#else
+    (void)cpu;
+    return -1;  // No portable affinity API (macOS only offers hints)
+#endif
+}
+
+// ============================================================================
+// JSON OUTPUT AND BASELINE COMPARISON
+// ============================================================================
+
+/**
+ * @brief Write results as JSON, one benchmark object per line
+ *
+ * The one-per-line layout keeps the baseline reader trivial.
+ */
+static int write_json(const char *path, const bench_options_t *opts,
+                      const bench_result_t *results) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"version\": \"%s\",\n", qrng_v3_version());
+    fprintf(f, "  \"timestamp\": %ld,\n", (long)time(NULL));
+    fprintf(f, "  \"cpu\": %d,\n", opts->cpu);
+    fprintf(f, "  \"reps\": %d,\n", opts->reps);
+    fprintf(f, "  \"warmup\": %d,\n", opts->warmup);
+    fprintf(f, "  \"benchmarks\": [\n");
+
+    int first = 1;
+    for (size_t i = 0; i < num_cases; i++) {
+        const bench_case_t *bc = &cases[i];
+        const bench_result_t *r = &results[i];
+        if (opts->filter && !strstr(bc->name, opts->filter)) continue;
+
+        fprintf(f, "%s    {\"name\": \"%s\", \"group\": \"%s\", \"failed\": %d, "
+                   "\"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"ci95_ns\": %.3f, "
+                   "\"min_ns\": %.3f, \"ops_per_rep\": %llu, \"mbps\": %.3f",
+                first ? "" : ",\n", bc->name, bc->group, r->failed,
+                r->mean_ns, r->stddev_ns, r->ci95_ns, r->min_ns,
+                (unsigned long long)r->ops_per_rep, r->mbps);
+        if (r->ipc >= 0) {
+            fprintf(f, ", \"ipc\": %.3f, \"llc_mpki\": %.3f", r->ipc, r->llc_mpki);
+        }
+        fprintf(f, "}");
+        first = 0;
+    }
+    fprintf(f, "\n  ]\n}\n");
+    fclose(f);
+    return 0;
+}
+
+/**
+ * @brief Look up a benchmark's mean_ns in a baseline produced by write_json
+ * @return 0 if found, -1 otherwise
+ */
+static int baseline_lookup(FILE *f, const char *name, double *mean_ns) {
+    char line[1024];
+    char key[BENCH_NAME_LEN + 16];
+    snprintf(key, sizeof(key), "\"name\": \"%s\"", name);
+
+    rewind(f);
+    while (fgets(line, sizeof(line), f)) {
+        if (!strstr(line, key)) continue;
+        if (strstr(line, "\"failed\": 1")) return -1;
+        const char *p = strstr(line, "\"mean_ns\": ");
+        if (!p) return -1;
+        *mean_ns = strtod(p + strlen("\"mean_ns\": "), NULL);
+        return *mean_ns > 0 ? 0 : -1;
+    }
+    return -1;
+}
+
+/**
+ * @brief Compare against baseline; returns number of regressions or -1
+ *
+ * A benchmark regresses when even the optimistic end of its confidence
+ * interval (mean - ci95) is slower than baseline by more than threshold.
+ */
+static int compare_baseline(const bench_options_t *opts, const bench_result_t *results) {
+    FILE *f = fopen(opts->baseline_path, "r");
+    if (!f) {
+        fprintf(stderr, "Baseline %s not found (create it with 'make bench_baseline')\n",
+                opts->baseline_path);
+        return -1;
+    }
+
+    int regressions = 0;
+    printf("\nBaseline comparison (%s, threshold %.1f%%):\n", opts->baseline_path, opts->threshold_pct);
+    printf("  %-34s %12s %12s %9s\n", "Benchmark", "Base ns/op", "Now ns/op", "Change");
+
+    for (size_t i = 0; i < num_cases; i++) {
+        const bench_case_t *bc = &cases[i];
+        const bench_result_t *r = &results[i];
+        if (opts->filter && !strstr(bc->name, opts->filter)) continue;
+
+        double base;
+        if (baseline_lookup(f, bc->name, &base) != 0) {
+            printf("  %-34s %12s %12.1f %9s\n", bc->name, "-", r->mean_ns, "new");
+            continue;
+        }
+        if (r->failed) {
+            printf("  %-34s %12.1f %12s %9s  REGRESSION\n", bc->name, base, "-", "failed");
+            regressions++;
+            continue;
+        }
+
+        double change = (r->mean_ns - base) / base * 100.0;
+        double optimistic = (r->mean_ns - r->ci95_ns - base) / base * 100.0;
+        int regressed = optimistic > opts->threshold_pct;
+        printf("  %-34s %12.1f %12.1f %+8.1f%%%s\n", bc->name, base, r->mean_ns, change,
+               regressed ? "  REGRESSION" : "");
+        regressions += regressed;
+    }
+
+    fclose(f);
+    return regressions;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  --filter STR      Run only benchmarks whose name contains STR\n");
+    printf("  --reps N          Timed repetitions (default 10, max %d)\n", BENCH_MAX_REPS);
+    printf("  --warmup N        Discarded warmup repetitions (default 2)\n");
+    printf("  --min-ms MS       Minimum duration of one repetition (default 5)\n");
+    printf("  --cpu N           Pin to CPU N (default 0, -1 disables pinning)\n");
+    printf("  --max-qubits N    Largest gate-kernel register (default 20)\n");
+    printf("  --hw              Collect hardware counters (Linux perf_event)\n");
+    printf("  --json FILE       Write results as JSON\n");
+    printf("  --baseline FILE   Compare against a previous --json output\n");
+    printf("  --threshold PCT   Regression threshold in percent (default 10)\n");
+    printf("  --list            List registered benchmarks and exit\n");
+}
+
+int main(int argc, char **argv) {
+    bench_options_t opts = {
+        .filter = NULL, .json_path = NULL, .baseline_path = NULL,
+        .threshold_pct = 10.0, .warmup = 2, .reps = 10, .min_ms = 5.0,
+        .cpu = 0, .max_qubits = 20, .hw_counters = 0, .list_only = 0
+    };
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--filter") == 0 && val) { opts.filter = val; i++; }
+        else if (strcmp(arg, "--reps") == 0 && val) { opts.reps = atoi(val); i++; }
+        else if (strcmp(arg, "--warmup") == 0 && val) { opts.warmup = atoi(val); i++; }
+        else if (strcmp(arg, "--min-ms") == 0 && val) { opts.min_ms = atof(val); i++; }
+        else if (strcmp(arg, "--cpu") == 0 && val) { opts.cpu = atoi(val); i++; }
+        else if (strcmp(arg, "--max-qubits") == 0 && val) { opts.max_qubits = atoi(val); i++; }
+        else if (strcmp(arg, "--json") == 0 && val) { opts.json_path = val; i++; }
+        else if (strcmp(arg, "--baseline") == 0 && val) { opts.baseline_path = val; i++; }
+        else if (strcmp(arg, "--threshold") == 0 && val) { opts.threshold_pct = atof(val); i++; }
+        else if (strcmp(arg, "--hw") == 0) { opts.hw_counters = 1; }
+        else if (strcmp(arg, "--list") == 0) { opts.list_only = 1; }
+        else {
+            print_usage(argv[0]);
+            return strcmp(arg, "--help") == 0 ? 0 : 2;
+        }
+    }
+    if (opts.reps < 2) opts.reps = 2;
+    if (opts.reps > BENCH_MAX_REPS) opts.reps = BENCH_MAX_REPS;
+    if (opts.warmup < 0) opts.warmup = 0;
+    if (opts.min_ms <= 0) opts.min_ms = 1.0;
+
+    build_registry(opts.max_qubits);
+
+    if (opts.list_only) {
+        for (size_t i = 0; i < num_cases; i++) {
+            printf("%-10s %s\n", cases[i].group, cases[i].name);
+        }
+        return 0;
+    }
+
+    bench_buffer = malloc(BENCH_BUFFER_SIZE);
+    bench_result_t *results = calloc(num_cases, sizeof(bench_result_t));
+    if (!bench_buffer || !results || entropy_init(&bench_hw_entropy) != ENTROPY_SUCCESS) {
+        fprintf(stderr, "Benchmark setup failed\n");
+        free(bench_buffer);
+        free(results);
+        return 1;
+    }
+    quantum_entropy_init(&bench_qentropy, bench_entropy_callback, &bench_hw_entropy);
+
+    int pinned = opts.cpu >= 0 && pin_cpu(opts.cpu) == 0;
+
+    perf_monitor_ctx_t *mon = NULL;
+    if (opts.hw_counters && perf_monitor_init(&mon) == 0) {
+        if (perf_monitor_enable_hw_counters(mon) != 0) {
+            fprintf(stderr, "Hardware counters unavailable; timing only\n");
+            perf_monitor_free(mon);
+            mon = NULL;
+        }
+    }
+
+    printf("╔══════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║                    QUANTUM RNG UNIFIED BENCHMARK HARNESS                     ║\n");
+    printf("╚══════════════════════════════════════════════════════════════════════════════╝\n");
+    printf("  reps=%d warmup=%d min-rep=%.1fms cpu=%s hw-counters=%s\n\n",
+           opts.reps, opts.warmup, opts.min_ms, pinned ? "pinned" : "unpinned",
+           mon ? "on" : "off");
+    printf("  %-34s %12s %10s %7s %10s%s\n", "Benchmark", "ns/op", "±95% CI", "CV", "MB/s",
+           mon ? "    IPC  LLC-MPKI" : "");
+
+    int failures = 0;
+    for (size_t i = 0; i < num_cases; i++) {
+        bench_case_t *bc = &cases[i];
+        bench_result_t *r = &results[i];
+        if (opts.filter && !strstr(bc->name, opts.filter)) continue;
+
+        run_case(bc, &opts, mon, r);
+        if (r->failed) {
+            printf("  %-34s %12s\n", bc->name, "FAILED");
+            failures++;
+            continue;
+        }
+
+        printf("  %-34s %12.1f %10.1f %6.1f%%", bc->name, r->mean_ns, r->ci95_ns,
+               r->mean_ns > 0 ? r->stddev_ns / r->mean_ns * 100.0 : 0.0);
+        if (r->mbps > 0) printf(" %10.2f", r->mbps);
+        else printf(" %10s", "-");
+        if (mon && r->ipc >= 0) printf(" %6.2f %9.2f", r->ipc, r->llc_mpki);
+        printf("\n");
+        fflush(stdout);
+    }
+
+    int status = failures ? 1 : 0;
+
+    if (opts.json_path && write_json(opts.json_path, &opts, results) == 0) {
+        printf("\nResults written to %s\n", opts.json_path);
+    }
+
+    if (opts.baseline_path) {
+        int regressions = compare_baseline(&opts, results);
+        if (regressions < 0) {
+            status = 1;
+        } else if (regressions > 0) {
+            printf("\n%d benchmark(s) regressed by more than %.1f%%\n", regressions, opts.threshold_pct);
+            status = 1;
+        } else {
+            printf("\nNo regressions beyond %.1f%%\n", opts.threshold_pct);
+        }
+    }
+
+    if (mon) perf_monitor_free(mon);
+    entropy_free(&bench_hw_entropy);
+    free(results);
+    free(bench_buffer);
+    return status;
+}
@@ -0,0 +1,317 @@
+/**
+ * @file cold_start_benchmark.c
+ * @brief Initialization cost and time-to-first-byte per API
+ *
+ * Short-lived CLI jobs pay full initialization on every start, so for them
+ * the number that matters is not throughput but how long it takes from
+ * "create a context" to "have the first random bytes". For each API this
+ * measures:
+ * - init:  the *_init / *_init_with_config call
+ * - first: the first request (32 bytes by default) on the new context
+ * - TTFB:  init + first
+ *
+ * Eager and lazy_init variants are listed side by side. By default every
+ * sample runs in a freshly spawned copy of this binary, so page faults,
+ * first-touch allocation and one-time CPU feature probing are included the
+ * way a real process start sees them; --in-process reuses one process.
+ */
+
+#include "../src/secure_rng/secure_rng.h"
+#include "../src/entropy/entropy_pool.h"
+#include "../src/quantum_rng/quantum_rng_v3.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+#define MAX_SAMPLES 1000
+#define DEFAULT_SAMPLES 15
+#define DEFAULT_REQUEST 32
+#define COLD_START_TARGET_NS 1e6   /* "under a millisecond" */
+
+typedef enum {
+    API_SECURE_RNG = 0,
+    API_SECURE_RNG_LAZY,
+    API_QRNG_V3,
+    API_QRNG_V3_LAZY,
+    API_ENTROPY_POOL,
+    API_ENTROPY_POOL_DEFERRED,
+    API_COUNT
+} cold_api_t;
+
+static const char *api_names[API_COUNT] = {
+    "secure_rng",
+    "secure_rng/lazy",
+    "qrng_v3",
+    "qrng_v3/lazy",
+    "entropy_pool",
+    "entropy_pool/deferred"
+};
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(double *sorted, int n, double p) {
+    int idx = (int)(p * (n - 1) + 0.5);
+    return sorted[idx];
+}
+
+// ============================================================================
+// ONE SAMPLE
+// ============================================================================
+
+/**
+ * @brief Create a context, request the first bytes, tear it down
+ *
+ * @return 0 on success, -1 if init or the first request failed
+ */
+static int measure_once(cold_api_t api, size_t request, double *init_ns, double *first_ns) {
+    uint8_t *buf = malloc(request);
+    if (!buf) return -1;
+
+    int rc = -1;
+    double t0 = 0, t1 = 0, t2 = 0;
+
+    switch (api) {
+        case API_SECURE_RNG:
+        case API_SECURE_RNG_LAZY: {
+            secure_rng_config_t config;
+            secure_rng_get_default_config(&config);
+            config.lazy_init = (api == API_SECURE_RNG_LAZY);
+            secure_rng_ctx_t *ctx = NULL;
+
+            t0 = now_ns();
+            if (secure_rng_init_with_config(&ctx, &config) != SECURE_RNG_SUCCESS) break;
+            t1 = now_ns();
+            int err = secure_rng_bytes(ctx, buf, request);
+            t2 = now_ns();
+
+            secure_rng_free(ctx);
+            if (err == SECURE_RNG_SUCCESS) rc = 0;
+            break;
+        }
+        case API_QRNG_V3:
+        case API_QRNG_V3_LAZY: {
+            qrng_v3_config_t config;
+            qrng_v3_get_default_config(&config);
+            config.lazy_init = (api == API_QRNG_V3_LAZY);
+            qrng_v3_ctx_t *ctx = NULL;
+
+            t0 = now_ns();
+            if (qrng_v3_init_with_config(&ctx, &config) != QRNG_V3_SUCCESS) break;
+            t1 = now_ns();
+            int err = qrng_v3_bytes(ctx, buf, request);
+            t2 = now_ns();
+
+            qrng_v3_free(ctx);
+            if (err == QRNG_V3_SUCCESS) rc = 0;
+            break;
+        }
+        case API_ENTROPY_POOL:
+        case API_ENTROPY_POOL_DEFERRED: {
+            entropy_pool_config_t config = {
+                .pool_size = ENTROPY_POOL_DEFAULT_SIZE,
+                .refill_threshold = ENTROPY_POOL_REFILL_THRESHOLD,
+                .chunk_size = ENTROPY_POOL_CHUNK_SIZE,
+                .enable_background_thread = 1,
+                .min_entropy = 4.0,
+                .defer_prefill = (api == API_ENTROPY_POOL_DEFERRED)
+            };
+            entropy_pool_ctx_t *ctx = NULL;
+
+            t0 = now_ns();
+            if (entropy_pool_init_with_config(&ctx, &config) != 0) break;
+            t1 = now_ns();
+            int err = entropy_pool_get_bytes(ctx, buf, request);
+            t2 = now_ns();
+
+            entropy_pool_free(ctx);
+            if (err == 0) rc = 0;
+            break;
+        }
+        default:
+            break;
+    }
+
+    free(buf);
+    if (rc == 0) {
+        *init_ns = t1 - t0;
+        *first_ns = t2 - t1;
+    }
+    return rc;
+}
+
+/**
+ * @brief Run one sample in a fresh process
+ *
+ * The child is this binary with `--child <api> --size <n>`; it prints
+ * "<init_ns> <first_ns>" on stdout.
+ */
+static int measure_spawned(const char *self, cold_api_t api, size_t request,
+                           double *init_ns, double *first_ns) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+
+    char size_arg[32];
+    snprintf(size_arg, sizeof(size_arg), "%zu", request);
+    char *child_argv[] = {
+        (char *)self, "--child", (char *)api_names[api], "--size", size_arg, NULL
+    };
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&actions, fds[0]);
+
+    pid_t pid;
+    int spawn_err = posix_spawn(&pid, self, &actions, NULL, child_argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if (spawn_err != 0) {
+        close(fds[0]);
+        return -1;
+    }
+
+    char line[128] = {0};
+    size_t got = 0;
+    ssize_t n;
+    while (got < sizeof(line) - 1 &&
+           (n = read(fds[0], line + got, sizeof(line) - 1 - got)) > 0) {
+        got += (size_t)n;
+    }
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return -1;
+
+    return sscanf(line, "%lf %lf", init_ns, first_ns) == 2 ? 0 : -1;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static int find_api(const char *name) {
+    for (int i = 0; i < API_COUNT; i++) {
+        if (strcmp(name, api_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--samples N] [--size BYTES] [--filter SUBSTR] [--in-process]\n", prog);
+    printf("  --samples N      samples per API (default %d)\n", DEFAULT_SAMPLES);
+    printf("  --size BYTES     size of the first request (default %d)\n", DEFAULT_REQUEST);
+    printf("  --filter SUBSTR  only APIs whose name contains SUBSTR\n");
+    printf("  --in-process     reuse this process instead of spawning one per sample\n");
+}
+
+int main(int argc, char **argv) {
+    int samples = DEFAULT_SAMPLES;
+    size_t request = DEFAULT_REQUEST;
+    const char *filter = NULL;
+    const char *child_api = NULL;
+    int in_process = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--samples") == 0 && val) { samples = atoi(val); i++; }
+        else if (strcmp(argv[i], "--size") == 0 && val) { request = (size_t)strtoull(val, NULL, 10); i++; }
+        else if (strcmp(argv[i], "--filter") == 0 && val) { filter = val; i++; }
+        else if (strcmp(argv[i], "--child") == 0 && val) { child_api = val; i++; }
+        else if (strcmp(argv[i], "--in-process") == 0) { in_process = 1; }
+        else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+    if (samples < 1) samples = 1;
+    if (samples > MAX_SAMPLES) samples = MAX_SAMPLES;
+    if (request == 0) request = DEFAULT_REQUEST;
+
+    // Child mode: one sample, machine-readable
+    if (child_api) {
+        int api = find_api(child_api);
+        double init_ns, first_ns;
+        if (api < 0 || measure_once((cold_api_t)api, request, &init_ns, &first_ns) != 0) {
+            return 1;
+        }
+        printf("%.0f %.0f\n", init_ns, first_ns);
+        return 0;
+    }
+
+    // Spawn through /proc/self/exe where available so PATH lookup and a
+    // relative argv[0] do not matter
+    const char *self = access("/proc/self/exe", X_OK) == 0 ? "/proc/self/exe" : argv[0];
+
+    printf("╔══════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║                QUANTUM RNG COLD-START / TIME-TO-FIRST-BYTE                   ║\n");
+    printf("╚══════════════════════════════════════════════════════════════════════════════╝\n");
+    printf("  samples=%d  first request=%zu B  %s\n\n", samples, request,
+           in_process ? "in-process (warm)" : "fresh process per sample");
+    printf("  %-22s %10s %10s %10s %10s %10s  %s\n",
+           "api", "init p50", "init p95", "first p50", "TTFB p50", "TTFB p95", "init<1ms");
+    printf("  %-22s %10s %10s %10s %10s %10s  %s\n",
+           "", "(ms)", "(ms)", "(ms)", "(ms)", "(ms)", "");
+
+    static double init_ns[MAX_SAMPLES], first_ns[MAX_SAMPLES], ttfb_ns[MAX_SAMPLES];
+    int failures = 0;
+
+    for (int api = 0; api < API_COUNT; api++) {
+        if (filter && !strstr(api_names[api], filter)) continue;
+
+        int ok = 0;
+        for (int s = 0; s < samples; s++) {
+            double ti, tf;
+            int rc = in_process ?
+                     measure_once((cold_api_t)api, request, &ti, &tf) :
+                     measure_spawned(self, (cold_api_t)api, request, &ti, &tf);
+            if (rc != 0) continue;
+            init_ns[ok] = ti;
+            first_ns[ok] = tf;
+            ttfb_ns[ok] = ti + tf;
+            ok++;
+        }
+        if (ok == 0) {
+            printf("  %-22s  FAILED\n", api_names[api]);
+            failures++;
+            continue;
+        }
+        if (ok < samples) failures++;
+
+        qsort(init_ns, ok, sizeof(double), cmp_double);
+        qsort(first_ns, ok, sizeof(double), cmp_double);
+        qsort(ttfb_ns, ok, sizeof(double), cmp_double);
+
+        double init_p50 = percentile(init_ns, ok, 0.50);
+        printf("  %-22s %10.3f %10.3f %10.3f %10.3f %10.3f  %s\n",
+               api_names[api],
+               init_p50 / 1e6,
+               percentile(init_ns, ok, 0.95) / 1e6,
+               percentile(first_ns, ok, 0.50) / 1e6,
+               percentile(ttfb_ns, ok, 0.50) / 1e6,
+               percentile(ttfb_ns, ok, 0.95) / 1e6,
+               init_p50 < COLD_START_TARGET_NS ? "yes" : "no");
+    }
+
+    printf("\n  init  = *_init_with_config; first = first request on the new context\n");
+    printf("  lazy secure_rng runs its startup tests in the background: the first\n");
+    printf("  request waits for them, so TTFB only improves when the caller has other\n");
+    printf("  startup work to overlap with init.\n");
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,270 @@
+/**
+ * @file paced_stream_test.c
+ * @brief Tests for the rate-controlled streaming engine
+ *
+ * Tests cover:
+ * - Exact byte count, ordering and achieved rate of a finite stream
+ * - Stopping an unbounded stream from another thread
+ * - Backpressure accounting when the sink stalls
+ * - Source and sink failures
+ * - Configuration validation
+ */
+
+#include "../src/secure_rng/paced_stream.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <math.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+#define TEST_START(name) \
+    do { \
+        tests_run++; \
+        printf("\n[TEST %d] %s\n", tests_run, name); \
+    } while(0)
+
+#define TEST_PASS() \
+    do { \
+        tests_passed++; \
+        printf("  ✓ PASSED\n"); \
+        return 1; \
+    } while(0)
+
+#define TEST_FAIL(msg) \
+    do { \
+        tests_failed++; \
+        printf("  ✗ FAILED: %s\n", msg); \
+        return 0; \
+    } while(0)
+
+#define ASSERT_TRUE(expr, msg) \
+    do { \
+        if (!(expr)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(a, b, msg) \
+    do { \
+        if ((a) != (b)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            printf("  Expected: %ld, Got: %ld\n", (long)(b), (long)(a)); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+// Source: a byte counter, optionally failing after a limit
+typedef struct {
+    uint8_t next;
+    uint64_t produced;
+    uint64_t fail_after;            /**< 0 = never fail */
+} counter_source_t;
+
+static int counter_fill(void *user_data, uint8_t *buf, size_t size) {
+    counter_source_t *src = user_data;
+    if (src->fail_after && src->produced + size > src->fail_after) return -1;
+    for (size_t i = 0; i < size; i++) buf[i] = src->next++;
+    src->produced += size;
+    return 0;
+}
+
+// Sink: checks the counter sequence; can stall once or fail
+typedef struct {
+    uint8_t expect;
+    uint64_t received;
+    int out_of_order;
+    useconds_t stall_us;            /**< Sleep this long on the first call after stall_at */
+    uint64_t stall_at;
+    int fail;
+} checking_sink_t;
+
+static int checking_write(void *user_data, const uint8_t *data, size_t size) {
+    checking_sink_t *sink = user_data;
+    if (sink->fail) return -1;
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] != sink->expect++) sink->out_of_order = 1;
+    }
+    sink->received += size;
+    if (sink->stall_us && sink->received >= sink->stall_at) {
+        usleep(sink->stall_us);
+        sink->stall_us = 0;
+    }
+    return 0;
+}
+
+static void small_config(paced_stream_config_t *config, double rate, uint64_t total) {
+    paced_stream_get_default_config(config);
+    config->rate = rate;
+    config->total_bytes = total;
+    config->buffer_size = 64 * 1024;
+    config->generate_chunk = 4096;
+    config->max_write = 4096;
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+int test_finite_stream(void) {
+    TEST_START("Finite stream emits every byte in order at the configured rate");
+
+    paced_stream_config_t config;
+    small_config(&config, 1024 * 1024, 512 * 1024);
+    counter_source_t src = {0};
+    checking_sink_t sink = {0};
+    paced_stream_t *stream = NULL;
+    ASSERT_EQ(paced_stream_create(&stream, &config, counter_fill, &src, checking_write, &sink),
+              PACED_STREAM_SUCCESS, "Create should succeed");
+    ASSERT_EQ(paced_stream_run(stream), PACED_STREAM_SUCCESS, "Run should finish");
+
+    paced_stream_stats_t stats;
+    paced_stream_get_stats(stream, &stats);
+    printf("  %.3f MB/s in %.3f s, jitter mean %.1f us max %.1f us\n",
+           stats.achieved_rate / (1024.0 * 1024.0), stats.elapsed_s,
+           stats.jitter_mean_ns / 1e3, stats.jitter_max_ns / 1e3);
+
+    ASSERT_EQ(sink.received, 512 * 1024, "Exactly total_bytes should be emitted");
+    ASSERT_EQ(stats.bytes_emitted, 512 * 1024, "Stats should count every byte");
+    ASSERT_TRUE(!sink.out_of_order, "Bytes should arrive in generation order");
+    ASSERT_TRUE(fabs(stats.achieved_rate / config.rate - 1.0) < 0.1, "Rate within 10%");
+    ASSERT_TRUE(stats.ticks > 0 && stats.jitter_max_ns >= stats.jitter_mean_ns,
+                "Jitter statistics should be recorded");
+    ASSERT_EQ(paced_stream_run(stream), PACED_STREAM_ERROR_INVALID_PARAM, "A stream runs once");
+
+    paced_stream_free(stream);
+    TEST_PASS();
+}
+
+static void *stop_later(void *arg) {
+    usleep(200000);
+    paced_stream_stop((paced_stream_t *)arg);
+    return NULL;
+}
+
+int test_stop_unbounded(void) {
+    TEST_START("paced_stream_stop ends an unbounded stream");
+
+    paced_stream_config_t config;
+    small_config(&config, 256 * 1024, 0);
+    counter_source_t src = {0};
+    checking_sink_t sink = {0};
+    paced_stream_t *stream = NULL;
+    ASSERT_EQ(paced_stream_create(&stream, &config, counter_fill, &src, checking_write, &sink),
+              PACED_STREAM_SUCCESS, "Create should succeed");
+
+    pthread_t stopper;
+    pthread_create(&stopper, NULL, stop_later, stream);
+    ASSERT_EQ(paced_stream_run(stream), PACED_STREAM_SUCCESS, "Stop is a clean finish");
+    pthread_join(stopper, NULL);
+
+    paced_stream_stats_t stats;
+    paced_stream_get_stats(stream, &stats);
+    ASSERT_TRUE(sink.received > 0 && sink.received < 256 * 1024,
+                "About 0.2 s worth of output should be emitted");
+    ASSERT_TRUE(stats.bytes_generated >= stats.bytes_emitted, "Generation stays ahead");
+    paced_stream_free(stream);
+    TEST_PASS();
+}
+
+int test_sink_backpressure(void) {
+    TEST_START("A stalled sink is reported and the stream does not burst to catch up");
+
+    paced_stream_config_t config;
+    small_config(&config, 512 * 1024, 256 * 1024);
+    counter_source_t src = {0};
+    checking_sink_t sink = { .stall_us = 100000, .stall_at = 32 * 1024 };
+    paced_stream_t *stream = NULL;
+    ASSERT_EQ(paced_stream_create(&stream, &config, counter_fill, &src, checking_write, &sink),
+              PACED_STREAM_SUCCESS, "Create should succeed");
+    ASSERT_EQ(paced_stream_run(stream), PACED_STREAM_SUCCESS, "Run should finish");
+
+    paced_stream_stats_t stats;
+    paced_stream_get_stats(stream, &stats);
+    printf("  behind %llu, forfeited %llu B, stalls %llu, missed ticks %llu\n",
+           (unsigned long long)stats.behind_events, (unsigned long long)stats.bytes_forfeited,
+           (unsigned long long)stats.sink_stalls, (unsigned long long)stats.missed_ticks);
+    ASSERT_TRUE(stats.sink_stalls >= 1, "The slow write should be counted");
+    ASSERT_TRUE(stats.behind_events >= 1, "Falling behind should be reported");
+    // 100 ms at 512 KB/s is ~51 KB; all but one bucket of it is forfeited
+    ASSERT_TRUE(stats.bytes_forfeited > 32 * 1024, "Missed output should be forfeited");
+    ASSERT_TRUE(!sink.out_of_order && sink.received == 256 * 1024, "Output stays complete");
+    paced_stream_free(stream);
+    TEST_PASS();
+}
+
+int test_failures(void) {
+    TEST_START("Source and sink failures end the stream with their error");
+
+    paced_stream_config_t config;
+    small_config(&config, 1024 * 1024, 0);
+    counter_source_t src = { .fail_after = 40 * 1024 };
+    checking_sink_t sink = {0};
+    paced_stream_t *stream = NULL;
+    ASSERT_EQ(paced_stream_create(&stream, &config, counter_fill, &src, checking_write, &sink),
+              PACED_STREAM_SUCCESS, "Create should succeed");
+    ASSERT_EQ(paced_stream_run(stream), PACED_STREAM_ERROR_SOURCE, "Source failure is reported");
+    ASSERT_EQ(sink.received, src.produced, "Bytes generated before the failure are still sent");
+    paced_stream_free(stream);
+
+    counter_source_t good = {0};
+    checking_sink_t broken = { .fail = 1 };
+    ASSERT_EQ(paced_stream_create(&stream, &config, counter_fill, &good, checking_write, &broken),
+              PACED_STREAM_SUCCESS, "Create should succeed");
+    ASSERT_EQ(paced_stream_run(stream), PACED_STREAM_ERROR_SINK, "Sink failure is reported");
+    paced_stream_free(stream);
+    TEST_PASS();
+}
+
+int test_invalid_config(void) {
+    TEST_START("Invalid configurations are rejected");
+
+    paced_stream_config_t config;
+    paced_stream_t *stream = NULL;
+    counter_source_t src = {0};
+    checking_sink_t sink = {0};
+
+    paced_stream_get_default_config(&config);
+    ASSERT_EQ(paced_stream_create(&stream, &config, counter_fill, &src, checking_write, &sink),
+              PACED_STREAM_ERROR_INVALID_PARAM, "Rate must be set");
+    config.rate = 1000;
+    config.buffer_size = 0;
+    ASSERT_EQ(paced_stream_create(&stream, &config, counter_fill, &src, checking_write, &sink),
+              PACED_STREAM_ERROR_INVALID_PARAM, "Buffer must be non-empty");
+    ASSERT_EQ(paced_stream_create(&stream, &config, NULL, &src, checking_write, &sink),
+              PACED_STREAM_ERROR_NULL_POINTER, "Source is required");
+    ASSERT_TRUE(stream == NULL, "No stream on failure");
+    TEST_PASS();
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("PACED STREAM TESTS\n");
+    printf("========================================\n");
+
+    test_finite_stream();
+    test_stop_unbounded();
+    test_sink_backpressure();
+    test_failures();
+    test_invalid_config();
+
+    printf("\n========================================\n");
+    printf("TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Total tests:  %d\n", tests_run);
+    printf("Passed:       %d\n", tests_passed);
+    printf("Failed:       %d\n", tests_failed);
+    printf("========================================\n");
+
+    return tests_failed == 0 ? 0 : 1;
+}
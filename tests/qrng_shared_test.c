@@ -0,0 +1,453 @@
+/**
+ * @file qrng_shared_test.c
+ * @brief Tests for shared-engine RNG handles
+ *
+ * Tests cover:
+ * - The ChaCha20 block function against the RFC 7539 test vector
+ * - O(1) handle creation with no engine access and a small footprint
+ * - Distinct output across many handles
+ * - Rekeying by interval and by qrng_shared_reseed_all
+ * - Concurrent handles on one engine
+ * - Scheduled Bell tests off the engine lock, failure and qrng_shared_reverify
+ * - Range, double and parameter validation
+ */
+
+#include "../src/quantum_rng/qrng_shared.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+#define TEST_START(name) \
+    do { \
+        tests_run++; \
+        printf("\n[TEST %d] %s\n", tests_run, name); \
+    } while(0)
+
+#define TEST_PASS() \
+    do { \
+        tests_passed++; \
+        printf("  ✓ PASSED\n"); \
+        return 1; \
+    } while(0)
+
+#define TEST_FAIL(msg) \
+    do { \
+        tests_failed++; \
+        printf("  ✗ FAILED: %s\n", msg); \
+        return 0; \
+    } while(0)
+
+#define ASSERT_TRUE(expr, msg) \
+    do { \
+        if (!(expr)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(a, b, msg) \
+    do { \
+        if ((a) != (b)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            printf("  Expected: %ld, Got: %ld\n", (long)(b), (long)(a)); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static qrng_shared_t *make_engine(uint64_t reseed_interval) {
+    qrng_shared_config_t config;
+    qrng_shared_get_default_config(&config);
+    config.engine.enable_background_entropy = 0;
+    config.reseed_interval = reseed_interval;
+
+    qrng_shared_t *engine = NULL;
+    if (qrng_shared_create(&engine, &config) != QRNG_V3_SUCCESS) return NULL;
+    return engine;
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+int test_chacha_vector(void) {
+    TEST_START("ChaCha20 block matches RFC 7539 section 2.3.2");
+
+    qrng_shared_t *engine = make_engine(1024 * 1024);
+    ASSERT_TRUE(engine != NULL, "Engine creation");
+
+    // Pre-key the handle by hand; the RFC's 32-bit counter and 96-bit nonce
+    // map onto the 64/64 layout as below
+    qrng_handle_t h;
+    ASSERT_EQ(qrng_handle_init(&h, engine), QRNG_V3_SUCCESS, "Init should succeed");
+    for (int i = 0; i < 8; i++) {
+        h.key[i] = (uint32_t)(4 * i) | (uint32_t)(4 * i + 1) << 8 |
+                   (uint32_t)(4 * i + 2) << 16 | (uint32_t)(4 * i + 3) << 24;
+    }
+    h.counter = 1 | (uint64_t)0x09000000 << 32;
+    h.nonce = 0x4a000000;
+    h.keyed = 1;
+
+    static const uint8_t expected[64] = {
+        0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+        0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+        0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+        0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e
+    };
+    uint8_t out[64];
+    ASSERT_EQ(qrng_handle_bytes(&h, out, 10), QRNG_V3_SUCCESS, "Partial read");
+    ASSERT_EQ(qrng_handle_bytes(&h, out + 10, 54), QRNG_V3_SUCCESS, "Rest of the block");
+    ASSERT_TRUE(memcmp(out, expected, 64) == 0, "Keystream should match the test vector");
+
+    qrng_shared_stats_t stats;
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_EQ(stats.keys_issued, 0, "A keyed handle should not ask for a key");
+
+    qrng_handle_clear(&h);
+    qrng_shared_free(engine);
+    TEST_PASS();
+}
+
+int test_creation_cost(void) {
+    TEST_START("Handle creation is O(1) and small");
+
+    qrng_shared_t *engine = make_engine(1024 * 1024);
+    ASSERT_TRUE(engine != NULL, "Engine creation");
+
+    const size_t count = 50000;
+    qrng_handle_t *handles = malloc(count * sizeof(*handles));
+    ASSERT_TRUE(handles != NULL, "Allocation");
+
+    double start = now_seconds();
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_EQ(qrng_handle_init(&handles[i], engine), QRNG_V3_SUCCESS, "Init should succeed");
+    }
+    double per_handle_ns = (now_seconds() - start) * 1e9 / count;
+
+    printf("  sizeof(qrng_handle_t) = %zu bytes, init %.1f ns/handle\n",
+           sizeof(qrng_handle_t), per_handle_ns);
+    ASSERT_TRUE(sizeof(qrng_handle_t) <= 256, "Handle should fit in a few hundred bytes");
+
+    qrng_shared_stats_t stats;
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_EQ(stats.handles_created, count, "Every handle gets a serial");
+    ASSERT_EQ(stats.keys_issued, 0, "Creation should not draw keys");
+    ASSERT_EQ(stats.engine_bytes, 0, "Creation should not touch the engine");
+
+    for (size_t i = 0; i < count; i++) qrng_handle_clear(&handles[i]);
+    free(handles);
+    qrng_shared_free(engine);
+    TEST_PASS();
+}
+
+int test_distinct_handles(void) {
+    TEST_START("Many handles produce distinct output");
+
+    qrng_shared_t *engine = make_engine(1024 * 1024);
+    ASSERT_TRUE(engine != NULL, "Engine creation");
+
+    const size_t count = 10000;
+    qrng_handle_t *handles = malloc(count * sizeof(*handles));
+    uint64_t *values = malloc(count * sizeof(*values));
+    ASSERT_TRUE(handles && values, "Allocation");
+
+    for (size_t i = 0; i < count; i++) {
+        qrng_handle_init(&handles[i], engine);
+        ASSERT_EQ(qrng_handle_uint64(&handles[i], &values[i]), QRNG_V3_SUCCESS, "Draw should succeed");
+    }
+
+    qsort(values, count, sizeof(*values), cmp_u64);
+    size_t dups = 0;
+    for (size_t i = 1; i < count; i++) dups += values[i] == values[i - 1];
+    ASSERT_EQ(dups, 0, "First outputs should all differ");
+
+    // Bit balance over one handle's stream
+    uint8_t buf[65536];
+    ASSERT_EQ(qrng_handle_bytes(&handles[0], buf, sizeof(buf)), QRNG_V3_SUCCESS, "Bulk draw");
+    uint64_t ones = 0;
+    for (size_t i = 0; i < sizeof(buf); i++) ones += (uint64_t)__builtin_popcount(buf[i]);
+    double ratio = (double)ones / (sizeof(buf) * 8.0);
+    printf("  ones ratio %.4f\n", ratio);
+    ASSERT_TRUE(ratio > 0.49 && ratio < 0.51, "Bits should be balanced");
+
+    qrng_shared_stats_t stats;
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_EQ(stats.keys_issued, count, "One key per handle");
+
+    for (size_t i = 0; i < count; i++) qrng_handle_clear(&handles[i]);
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_EQ(stats.handle_bytes, count * 8 + sizeof(buf), "Clear should report output");
+
+    free(values);
+    free(handles);
+    qrng_shared_free(engine);
+    TEST_PASS();
+}
+
+int test_rekey(void) {
+    TEST_START("Handles rekey by interval and on reseed_all");
+
+    qrng_shared_t *engine = make_engine(4096);
+    ASSERT_TRUE(engine != NULL, "Engine creation");
+
+    qrng_handle_t h;
+    qrng_handle_init(&h, engine);
+
+    uint8_t buf[64 * 1024 + 100];
+    ASSERT_EQ(qrng_handle_bytes(&h, buf, sizeof(buf)), QRNG_V3_SUCCESS, "Bulk draw");
+
+    qrng_shared_stats_t stats;
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_EQ(stats.keys_issued, 17, "One key per 4 KB plus the tail");
+    ASSERT_EQ(stats.handle_bytes, 16 * 4096, "Rekeys report the previous key's output");
+
+    uint64_t v;
+    ASSERT_EQ(qrng_handle_uint64(&h, &v), QRNG_V3_SUCCESS, "Draw within interval");
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_EQ(stats.keys_issued, 17, "No rekey within the interval");
+
+    qrng_shared_reseed_all(engine);
+    ASSERT_EQ(qrng_handle_uint64(&h, &v), QRNG_V3_SUCCESS, "Draw after reseed_all");
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_EQ(stats.keys_issued, 18, "reseed_all should force a rekey");
+    ASSERT_EQ(stats.epoch, 1, "Epoch should advance");
+
+    qrng_handle_clear(&h);
+    qrng_shared_free(engine);
+    TEST_PASS();
+}
+
+typedef struct {
+    qrng_shared_t *engine;
+    int errors;
+} worker_arg_t;
+
+static void *handle_worker(void *p) {
+    worker_arg_t *arg = p;
+    qrng_handle_t handles[64];
+    for (int i = 0; i < 64; i++) qrng_handle_init(&handles[i], arg->engine);
+
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < 64; i++) {
+            uint8_t buf[100];
+            if (qrng_handle_bytes(&handles[i], buf, sizeof(buf)) != QRNG_V3_SUCCESS) {
+                arg->errors++;
+            }
+        }
+    }
+
+    for (int i = 0; i < 64; i++) qrng_handle_clear(&handles[i]);
+    return NULL;
+}
+
+int test_concurrent_handles(void) {
+    TEST_START("Handles on several threads share one engine");
+
+    qrng_shared_t *engine = make_engine(1024);
+    ASSERT_TRUE(engine != NULL, "Engine creation");
+
+    pthread_t threads[4];
+    worker_arg_t args[4];
+    for (int t = 0; t < 4; t++) {
+        args[t].engine = engine;
+        args[t].errors = 0;
+        pthread_create(&threads[t], NULL, handle_worker, &args[t]);
+    }
+    int errors = 0;
+    for (int t = 0; t < 4; t++) {
+        pthread_join(threads[t], NULL);
+        errors += args[t].errors;
+    }
+    ASSERT_EQ(errors, 0, "No draw should fail");
+
+    qrng_shared_stats_t stats;
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_EQ(stats.handles_created, 256, "All handles counted");
+    ASSERT_EQ(stats.handle_bytes, 256 * 50 * 100, "All output reported");
+    ASSERT_TRUE(stats.keys_issued >= 256 * 4, "Handles should rekey every 1 KB");
+
+    qrng_shared_free(engine);
+    TEST_PASS();
+}
+
+// Well above the engine output handles draw, so the engine's own Bell
+// check stays out of the way and the scheduled test is what runs
+#define BELL_INTERVAL (256 * 1024)
+
+static qrng_shared_t *make_bell_engine(double min_chsh) {
+    qrng_shared_config_t config;
+    qrng_shared_get_default_config(&config);
+    config.engine.enable_background_entropy = 0;
+    config.engine.enable_bell_monitoring = 1;
+    config.engine.bell_test_interval = BELL_INTERVAL;
+    config.engine.min_acceptable_chsh = min_chsh;
+    config.reseed_interval = BELL_INTERVAL / 16;
+
+    qrng_shared_t *engine = NULL;
+    if (qrng_shared_create(&engine, &config) != QRNG_V3_SUCCESS) return NULL;
+    return engine;
+}
+
+// Scheduled tests finish on the task pool; give them up to five seconds
+static void wait_for_bell_tests(qrng_shared_t *engine, uint64_t count,
+                                qrng_shared_stats_t *stats) {
+    for (int i = 0; i < 5000; i++) {
+        qrng_shared_get_stats(engine, stats);
+        if (stats->bell_tests >= count) return;
+        usleep(1000);
+    }
+}
+
+int test_bell_schedule(void) {
+    TEST_START("Bell tests run off the engine lock; reverify re-tests on demand");
+
+    qrng_shared_t *engine = make_bell_engine(2.4);
+    ASSERT_TRUE(engine != NULL, "Engine creation");
+
+    qrng_handle_t h;
+    qrng_handle_init(&h, engine);
+    uint8_t *buf = malloc(BELL_INTERVAL + 1);
+    ASSERT_TRUE(buf != NULL, "Allocation");
+    ASSERT_EQ(qrng_handle_bytes(&h, buf, BELL_INTERVAL + 1), QRNG_V3_SUCCESS,
+              "Draw past the interval");
+    free(buf);
+
+    qrng_shared_stats_t stats;
+    wait_for_bell_tests(engine, 1, &stats);
+    ASSERT_TRUE(stats.bell_tests >= 1, "A scheduled test should finish");
+    ASSERT_EQ(stats.bell_failures, 0, "Simulated state should pass");
+    ASSERT_TRUE(qrng_shared_is_verified(engine), "Engine verified");
+
+    uint64_t before = stats.bell_tests;
+    ASSERT_EQ(qrng_shared_reverify(engine), QRNG_V3_SUCCESS, "Reverify should pass");
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_TRUE(stats.bell_tests >= before + 1, "Reverify counts as a test");
+    ASSERT_EQ(qrng_shared_reverify(NULL), QRNG_V3_ERROR_NULL_CONTEXT, "NULL engine rejected");
+
+    qrng_handle_clear(&h);
+    qrng_shared_free(engine);
+    TEST_PASS();
+}
+
+int test_bell_failure(void) {
+    TEST_START("A failed Bell test stops key issue and reverify re-tests");
+
+    // CHSH cannot exceed 2*sqrt(2), so every test fails
+    qrng_shared_t *engine = make_bell_engine(2.9);
+    ASSERT_TRUE(engine != NULL, "Engine creation");
+
+    qrng_handle_t h;
+    qrng_handle_init(&h, engine);
+    uint8_t buf[BELL_INTERVAL / 16];
+    qrng_v3_error_t err = QRNG_V3_SUCCESS;
+    for (int i = 0; i < 5000 && err == QRNG_V3_SUCCESS; i++) {
+        err = qrng_handle_bytes(&h, buf, sizeof(buf));
+        if (i >= 16) usleep(1000);
+    }
+    qrng_shared_stats_t stats;
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_EQ(err, QRNG_V3_ERROR_BELL_TEST_FAILED, "Handles should stop getting keys");
+    ASSERT_TRUE(stats.bell_failures >= 1, "Failure counted");
+    ASSERT_TRUE(!qrng_shared_is_verified(engine), "Engine not verified");
+
+    ASSERT_EQ(qrng_shared_reverify(engine), QRNG_V3_ERROR_BELL_TEST_FAILED,
+              "Reverify should fail again");
+    qrng_shared_get_stats(engine, &stats);
+    ASSERT_TRUE(stats.bell_failures >= 2, "Reverify failure counted");
+    ASSERT_EQ(qrng_handle_bytes(&h, buf, sizeof(buf)), QRNG_V3_ERROR_BELL_TEST_FAILED,
+              "Failure should persist");
+
+    qrng_handle_clear(&h);
+    qrng_shared_free(engine);
+    TEST_PASS();
+}
+
+int test_range_and_params(void) {
+    TEST_START("Range, double and parameter validation");
+
+    qrng_shared_t *engine = make_engine(1024 * 1024);
+    ASSERT_TRUE(engine != NULL, "Engine creation");
+
+    qrng_handle_t h;
+    qrng_handle_init(&h, engine);
+
+    int seen[6] = {0};
+    for (int i = 0; i < 6000; i++) {
+        uint64_t v;
+        ASSERT_EQ(qrng_handle_range(&h, 1, 6, &v), QRNG_V3_SUCCESS, "Range should succeed");
+        ASSERT_TRUE(v >= 1 && v <= 6, "Value within range");
+        seen[v - 1]++;
+    }
+    for (int i = 0; i < 6; i++) ASSERT_TRUE(seen[i] > 800, "Every face should appear");
+
+    double d;
+    ASSERT_EQ(qrng_handle_double(&h, &d), QRNG_V3_SUCCESS, "Double should succeed");
+    ASSERT_TRUE(d >= 0.0 && d < 1.0, "Double within [0, 1)");
+
+    uint64_t v;
+    ASSERT_EQ(qrng_handle_range(&h, 5, 4, &v), QRNG_V3_ERROR_INVALID_PARAM, "min > max rejected");
+    ASSERT_EQ(qrng_handle_bytes(&h, NULL, 8), QRNG_V3_ERROR_NULL_BUFFER, "NULL buffer rejected");
+    ASSERT_EQ(qrng_handle_init(NULL, engine), QRNG_V3_ERROR_NULL_CONTEXT, "NULL handle rejected");
+
+    qrng_handle_t cleared;
+    qrng_handle_init(&cleared, engine);
+    qrng_handle_clear(&cleared);
+    ASSERT_EQ(qrng_handle_uint64(&cleared, &v), QRNG_V3_ERROR_NOT_INITIALIZED, "Cleared handle rejected");
+
+    qrng_shared_config_t config;
+    qrng_shared_get_default_config(&config);
+    config.reseed_interval = 0;
+    qrng_shared_t *bad = NULL;
+    ASSERT_EQ(qrng_shared_create(&bad, &config), QRNG_V3_ERROR_INVALID_PARAM, "Zero interval rejected");
+
+    qrng_handle_clear(&h);
+    qrng_shared_free(engine);
+    TEST_PASS();
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("SHARED ENGINE HANDLE TESTS\n");
+    printf("========================================\n");
+
+    test_chacha_vector();
+    test_creation_cost();
+    test_distinct_handles();
+    test_rekey();
+    test_concurrent_handles();
+    test_bell_schedule();
+    test_bell_failure();
+    test_range_and_params();
+
+    printf("\n========================================\n");
+    printf("TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Total tests:  %d\n", tests_run);
+    printf("Passed:       %d\n", tests_passed);
+    printf("Failed:       %d\n", tests_failed);
+    printf("========================================\n");
+
+    return tests_failed == 0 ? 0 : 1;
+}
@@ -570,6 +570,45 @@ static void test_continuous_monitoring(void) {
     test_pass();
 }
 
+static void test_lazy_initialization(void) {
+    test_start("Lazy initialization");
+    
+    qrng_v3_config_t config;
+    qrng_v3_get_default_config(&config);
+    
+    config.lazy_init = 1;
+    config.enable_bell_monitoring = 1;
+    config.bell_test_interval = 2048;
+    
+    qrng_v3_ctx_t *ctx;
+    if (qrng_v3_init_with_config(&ctx, &config) != QRNG_V3_SUCCESS) {
+        test_fail("Lazy init failed");
+        return;
+    }
+    
+    if (qrng_v3_get_bell_history(ctx) != NULL) {
+        qrng_v3_free(ctx);
+        test_fail("Bell monitor created before first use");
+        return;
+    }
+    
+    uint8_t buffer[8192];
+    if (qrng_v3_bytes(ctx, buffer, sizeof(buffer)) != QRNG_V3_SUCCESS) {
+        qrng_v3_free(ctx);
+        test_fail("Generation after lazy init failed");
+        return;
+    }
+    
+    if (qrng_v3_get_bell_history(ctx) == NULL) {
+        qrng_v3_free(ctx);
+        test_fail("Bell monitor not created on first test");
+        return;
+    }
+    
+    qrng_v3_free(ctx);
+    test_pass();
+}
+
 static void test_backward_compatibility(void) {
     test_start("Backward compatibility (seed-based init)");
     
@@ -595,6 +634,77 @@ static void test_backward_compatibility(void) {
     test_pass();
 }
 
+static double elapsed_ms(const struct timespec *t0) {
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (t1.tv_sec - t0->tv_sec) * 1e3 + (t1.tv_nsec - t0->tv_nsec) / 1e6;
+}
+
+static void test_bounded_generation(void) {
+    test_start("Non-blocking and deadline-bounded generation");
+    
+    // Lazy and without background refill: the entropy pool stays empty
+    qrng_v3_config_t config;
+    qrng_v3_get_default_config(&config);
+    config.lazy_init = 1;
+    config.enable_background_entropy = 0;
+    
+    qrng_v3_ctx_t *ctx;
+    if (qrng_v3_init_with_config(&ctx, &config) != QRNG_V3_SUCCESS) {
+        test_fail("Init failed");
+        return;
+    }
+    
+    uint8_t buf[4096];
+    size_t filled = 99;
+    if (entropy_pool_try_bytes(ctx->entropy_pool, buf, 64, &filled) != ENTROPY_POOL_WOULD_BLOCK ||
+        filled != 0) {
+        qrng_v3_free(ctx);
+        test_fail("Pool try on an empty pool should would-block");
+        return;
+    }
+    if (qrng_v3_try_bytes(ctx, buf, 64, &filled) != QRNG_V3_ERROR_WOULD_BLOCK || filled != 0) {
+        qrng_v3_free(ctx);
+        test_fail("Try without pooled entropy should would-block");
+        return;
+    }
+    
+    if (entropy_pool_get_bytes_deadline(ctx->entropy_pool, buf, sizeof(buf), 1000000000ULL, &filled) != 0 ||
+        filled != sizeof(buf)) {
+        qrng_v3_free(ctx);
+        test_fail("Pool deadline call should generate on the caller's thread");
+        return;
+    }
+    if (qrng_v3_bytes_deadline(ctx, buf, sizeof(buf), 1000000000ULL, &filled) != QRNG_V3_SUCCESS ||
+        filled != sizeof(buf)) {
+        qrng_v3_free(ctx);
+        test_fail("Deadline call with time to spare should fill");
+        return;
+    }
+    
+    // A short deadline on a large request returns a partial fill promptly
+    size_t big = 1024 * 1024;
+    uint8_t *large = malloc(big);
+    struct timespec t0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    qrng_v3_error_t err = qrng_v3_bytes_deadline(ctx, large, big, 5000000, &filled);
+    double ms = elapsed_ms(&t0);
+    free(large);
+    qrng_v3_free(ctx);
+    
+    printf("\n      5 ms deadline: %zu of %zu bytes in %.2f ms\n      ", filled, big, ms);
+    if (err != QRNG_V3_ERROR_TIMEOUT || filled >= big) {
+        test_fail("Short deadline should time out with a partial fill");
+        return;
+    }
+    if (ms > 100.0) {
+        test_fail("Deadline overrun should be bounded");
+        return;
+    }
+    
+    test_pass();
+}
+
 static void test_arm_entropy_detection(void) {
     test_start("ARM hardware entropy detection");
     
@@ -715,7 +825,9 @@ int main(void) {
     test_entropy_layering();
     test_bell_test_performance();
     test_continuous_monitoring();
+    test_lazy_initialization();
     test_backward_compatibility();
+    test_bounded_generation();
     test_arm_entropy_detection();
     
     // Performance benchmarks
@@ -0,0 +1,452 @@
+/**
+ * @file qrngd_loadgen.c
+ * @brief Load generator for the qrngd entropy daemon
+ *
+ * Opens N concurrent connections (10k by default), keeps one request in
+ * flight on each for a fixed duration, and reports requests/sec, payload
+ * MB/s and the latency distribution (p50/p90/p99/p99.9/max).
+ *
+ * Without --socket a private daemon is forked on a temporary socket, so the
+ * server and the clients have separate descriptor tables; with --socket the
+ * load goes to an already running qrngd. All clients are driven from one
+ * epoll loop, so on small machines the generator and the daemon share the
+ * CPU and the numbers are a lower bound.
+ *
+ * With --shm NAME the sockets are bypassed: --threads consumer threads read
+ * from the daemon's shared-memory ring (forked with --shm NAME unless
+ * --socket names a running daemon) and the same report is per read.
+ */
+
+#include "../src/daemon/qrngd_server.h"
+#include "../src/daemon/shm_ring.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+#define DEFAULT_CLIENTS 10000
+#define DEFAULT_DURATION 5.0
+#define DEFAULT_REQUEST 32
+#define DRAIN_GRACE_NS 5e9          /* Wait this long for in-flight responses */
+#define SHM_READ_TIMEOUT_MS 1000
+
+typedef struct {
+    int fd;
+    size_t got;                     /**< Response bytes received so far */
+    qrngd_response_t header;
+    double sent_ns;
+    int active;
+} load_client_t;
+
+typedef struct {
+    double *samples;                /**< Latencies in ns */
+    size_t count;
+    size_t cap;
+} latency_log_t;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, size_t n, double p) {
+    if (n == 0) return 0.0;
+    size_t idx = (size_t)(p * (double)(n - 1) + 0.5);
+    return sorted[idx];
+}
+
+static int log_latency(latency_log_t *log, double ns) {
+    if (log->count == log->cap) {
+        size_t cap = log->cap ? log->cap * 2 : 65536;
+        double *grown = realloc(log->samples, cap * sizeof(double));
+        if (!grown) return -1;
+        log->samples = grown;
+        log->cap = cap;
+    }
+    log->samples[log->count++] = ns;
+    return 0;
+}
+
+static void raise_fd_limit(size_t wanted) {
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) != 0 || rl.rlim_cur >= wanted) return;
+    rl.rlim_cur = (rl.rlim_max == RLIM_INFINITY || rl.rlim_max > wanted) ? wanted : rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+}
+
+// ============================================================================
+// PRIVATE DAEMON
+// ============================================================================
+
+static qrngd_server_t *child_server = NULL;
+
+static void child_stop(int sig) {
+    (void)sig;
+    qrngd_server_stop(child_server);
+}
+
+/**
+ * @brief Fork a daemon on path; returns its pid once it accepts, or -1
+ */
+static pid_t spawn_daemon(const char *path, size_t clients, int mode, const char *shm_name) {
+    int ready[2];
+    if (pipe(ready) != 0) return -1;
+
+    pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        close(ready[0]);
+        qrngd_config_t config;
+        qrngd_get_default_config(&config);
+        config.socket_path = path;
+        config.max_clients = clients + 16;
+        config.prewarm_modes = mode == QRNGD_MODE_HYBRID ?
+            (1u << QRNGD_MODE_FAST) | (1u << QRNGD_MODE_QUANTUM) : 1u << mode;
+        config.shm_name = shm_name;
+        config.shm_mode = (qrngd_mode_t)mode;
+        int status = qrngd_server_create(&child_server, &config);
+        if (write(ready[1], &status, sizeof(status)) != sizeof(status)) _exit(1);
+        close(ready[1]);
+        if (status != QRNGD_SUCCESS) _exit(1);
+
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = child_stop;
+        sigaction(SIGTERM, &sa, NULL);
+        signal(SIGPIPE, SIG_IGN);
+        int rc = qrngd_server_run(child_server);
+        qrngd_server_free(child_server);
+        _exit(rc == QRNGD_SUCCESS ? 0 : 1);
+    }
+
+    close(ready[1]);
+    int status = -1;
+    ssize_t n = read(ready[0], &status, sizeof(status));
+    close(ready[0]);
+    if (n != sizeof(status) || status != QRNGD_SUCCESS) {
+        fprintf(stderr, "Error: daemon failed to start: %s\n",
+                qrngd_error_string((qrngd_error_t)status));
+        waitpid(pid, NULL, 0);
+        return -1;
+    }
+    return pid;
+}
+
+// ============================================================================
+// LOAD LOOP
+// ============================================================================
+
+static int send_request(load_client_t *c, const qrngd_request_t *req) {
+    c->got = 0;
+    c->sent_ns = now_ns();
+    ssize_t n = send(c->fd, req, sizeof(*req), MSG_NOSIGNAL);
+    return n == (ssize_t)sizeof(*req) ? 0 : -1;
+}
+
+/**
+ * @brief Read what is available; returns 1 when the response is complete,
+ * 0 if more is pending, -1 on error
+ */
+static int read_response(load_client_t *c, uint8_t *scratch, size_t scratch_size, size_t expected) {
+    for (;;) {
+        ssize_t n = recv(c->fd, scratch, scratch_size, 0);
+        if (n == 0) return -1;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+        // Capture the header as it streams past
+        if (c->got < sizeof(c->header)) {
+            size_t take = sizeof(c->header) - c->got;
+            if (take > (size_t)n) take = (size_t)n;
+            memcpy((uint8_t *)&c->header + c->got, scratch, take);
+        }
+        c->got += (size_t)n;
+        if (c->got >= sizeof(c->header)) {
+            size_t total = sizeof(c->header) +
+                           (c->header.status == QRNGD_SUCCESS ? c->header.size : 0);
+            if (c->header.status == QRNGD_SUCCESS && c->header.size != expected) return -1;
+            if (c->got >= total) return 1;
+        }
+    }
+}
+
+static void print_results(latency_log_t *log, uint64_t errors, size_t unfinished,
+                          double elapsed, size_t size, const char *unit) {
+    qsort(log->samples, log->count, sizeof(double), cmp_double);
+    printf("\n  %-22s %12llu\n", unit, (unsigned long long)log->count);
+    printf("  %-22s %12llu\n", "errors", (unsigned long long)errors);
+    printf("  %-22s %12zu\n", "unfinished", unfinished);
+    char rate[32];
+    snprintf(rate, sizeof(rate), "%s/sec", unit);
+    printf("  %-22s %12.0f\n", rate, log->count / (elapsed / 1e9));
+    printf("  %-22s %12.2f\n", "payload MB/s", log->count * (double)size / (elapsed / 1e9) / 1e6);
+    printf("\n  latency (us)    p50 %9.1f   p90 %9.1f   p99 %9.1f   p99.9 %9.1f   max %9.1f\n",
+           percentile(log->samples, log->count, 0.50) / 1e3,
+           percentile(log->samples, log->count, 0.90) / 1e3,
+           percentile(log->samples, log->count, 0.99) / 1e3,
+           percentile(log->samples, log->count, 0.999) / 1e3,
+           log->count ? log->samples[log->count - 1] / 1e3 : 0.0);
+}
+
+// ============================================================================
+// SHARED-MEMORY CONSUMERS
+// ============================================================================
+
+typedef struct {
+    const char *shm_name;
+    size_t size;
+    double end_ns;
+    latency_log_t log;
+    uint64_t errors;
+    pthread_t thread;
+} shm_worker_t;
+
+static void *shm_worker(void *arg) {
+    shm_worker_t *w = arg;
+    shm_ring_t *ring = NULL;
+    if (shm_ring_attach(&ring, w->shm_name) != SHM_RING_SUCCESS) {
+        w->errors++;
+        return NULL;
+    }
+    uint8_t *buf = malloc(w->size);
+    while (buf && now_ns() < w->end_ns) {
+        double t0 = now_ns();
+        shm_ring_error_t err = shm_ring_read(ring, buf, w->size, SHM_READ_TIMEOUT_MS);
+        if (err != SHM_RING_SUCCESS || log_latency(&w->log, now_ns() - t0) != 0) {
+            w->errors++;
+            if (err == SHM_RING_ERROR_NO_PRODUCER) break;
+        }
+    }
+    free(buf);
+    shm_ring_detach(ring);
+    return NULL;
+}
+
+static int run_shm_load(const char *shm_name, size_t threads, double duration, size_t size) {
+    shm_worker_t *workers = calloc(threads, sizeof(*workers));
+    if (!workers) return 1;
+
+    double start = now_ns();
+    for (size_t i = 0; i < threads; i++) {
+        workers[i].shm_name = shm_name;
+        workers[i].size = size;
+        workers[i].end_ns = start + duration * 1e9;
+        pthread_create(&workers[i].thread, NULL, shm_worker, &workers[i]);
+    }
+    latency_log_t log = {0};
+    uint64_t errors = 0;
+    for (size_t i = 0; i < threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        errors += workers[i].errors;
+        for (size_t j = 0; j < workers[i].log.count; j++) {
+            if (log_latency(&log, workers[i].log.samples[j]) != 0) errors++;
+        }
+        free(workers[i].log.samples);
+    }
+    double elapsed = now_ns() - start;
+
+    print_results(&log, errors, 0, elapsed, size, "reads");
+    printf("\n  Reads are served from a mapped ring without syscalls; once the\n");
+    printf("  consumers outpace the daemon, latency is the producer's fill rate.\n");
+
+    free(log.samples);
+    free(workers);
+    return errors == 0 ? 0 : 1;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--clients N] [--duration SEC] [--size BYTES] [--mode MODE] [--socket PATH]\n", prog);
+    printf("       %s --shm NAME [--threads N] [--duration SEC] [--size BYTES] [--mode MODE]\n", prog);
+    printf("  --clients N     concurrent connections (default %d)\n", DEFAULT_CLIENTS);
+    printf("  --duration SEC  measured run time (default %.0f)\n", DEFAULT_DURATION);
+    printf("  --size BYTES    bytes per request (default %d)\n", DEFAULT_REQUEST);
+    printf("  --mode MODE     fast, quantum, hybrid, verified or qrng_v3 (default fast)\n");
+    printf("  --socket PATH   load an existing daemon instead of forking one\n");
+    printf("  --shm NAME      read the daemon's shared-memory ring instead of sockets\n");
+    printf("  --threads N     ring consumer threads with --shm (default 1)\n");
+}
+
+int main(int argc, char **argv) {
+    size_t clients = DEFAULT_CLIENTS;
+    double duration = DEFAULT_DURATION;
+    size_t size = DEFAULT_REQUEST;
+    int mode = QRNGD_MODE_FAST;
+    const char *socket_path = NULL;
+    const char *shm_name = NULL;
+    size_t threads = 1;
+
+    for (int i = 1; i < argc; i++) {
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--clients") == 0 && val) { clients = strtoull(val, NULL, 10); i++; }
+        else if (strcmp(argv[i], "--duration") == 0 && val) { duration = atof(val); i++; }
+        else if (strcmp(argv[i], "--size") == 0 && val) { size = strtoull(val, NULL, 10); i++; }
+        else if (strcmp(argv[i], "--mode") == 0 && val) { mode = qrngd_mode_from_string(val); i++; }
+        else if (strcmp(argv[i], "--socket") == 0 && val) { socket_path = val; i++; }
+        else if (strcmp(argv[i], "--shm") == 0 && val) { shm_name = val; i++; }
+        else if (strcmp(argv[i], "--threads") == 0 && val) { threads = strtoull(val, NULL, 10); i++; }
+        else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+    if (clients == 0 || duration <= 0 || size == 0 || size > QRNGD_MAX_REQUEST || mode < 0 ||
+        threads == 0 || (shm_name && mode == QRNGD_MODE_HYBRID)) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    raise_fd_limit(clients + 64);
+
+    char private_path[108];
+    pid_t daemon_pid = -1;
+    if (!socket_path) {
+        snprintf(private_path, sizeof(private_path), "/tmp/qrngd_loadgen_%d.sock", (int)getpid());
+        socket_path = private_path;
+        daemon_pid = spawn_daemon(socket_path, clients, mode, shm_name);
+        if (daemon_pid < 0) return 1;
+    }
+
+    if (shm_name) {
+        printf("╔══════════════════════════════════════════════════════════════════════════════╗\n");
+        printf("║                       QRNGD SHARED-MEMORY RING LOAD                          ║\n");
+        printf("╚══════════════════════════════════════════════════════════════════════════════╝\n");
+        printf("  ring=%s%s\n", shm_name, daemon_pid > 0 ? " (private daemon)" : "");
+        printf("  threads=%zu  read=%zu B  mode=%s  duration=%.1f s\n",
+               threads, size, qrngd_mode_string((qrngd_mode_t)mode), duration);
+        int rc = run_shm_load(shm_name, threads, duration, size);
+        if (daemon_pid > 0) {
+            kill(daemon_pid, SIGTERM);
+            waitpid(daemon_pid, NULL, 0);
+        }
+        return rc;
+    }
+
+    printf("╔══════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║                         QRNGD DAEMON LOAD GENERATOR                          ║\n");
+    printf("╚══════════════════════════════════════════════════════════════════════════════╝\n");
+    printf("  socket=%s%s\n", socket_path, daemon_pid > 0 ? " (private daemon)" : "");
+    printf("  clients=%zu  request=%zu B  mode=%s  duration=%.1f s\n\n",
+           clients, size, qrngd_mode_string((qrngd_mode_t)mode), duration);
+
+    load_client_t *conns = calloc(clients, sizeof(*conns));
+    uint8_t *scratch = malloc(size + sizeof(qrngd_response_t));
+    latency_log_t log = {0};
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (!conns || !scratch || epfd < 0) {
+        fprintf(stderr, "Error: out of memory\n");
+        return 1;
+    }
+
+    // Connect everything before the clock starts
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", socket_path);
+
+    double t_connect = now_ns();
+    size_t connected = 0;
+    for (; connected < clients; connected++) {
+        load_client_t *c = &conns[connected];
+        c->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (c->fd < 0 || connect(c->fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+            fprintf(stderr, "  connect %zu failed: %s\n", connected, strerror(errno));
+            if (c->fd >= 0) close(c->fd);
+            break;
+        }
+        fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL) | O_NONBLOCK);
+        struct epoll_event ev = { .events = EPOLLIN, .data.ptr = c };
+        epoll_ctl(epfd, EPOLL_CTL_ADD, c->fd, &ev);
+    }
+    t_connect = now_ns() - t_connect;
+    printf("  connected %zu/%zu clients in %.1f ms\n", connected, clients, t_connect / 1e6);
+
+    qrngd_request_t req = { QRNGD_PROTOCOL_VERSION, (uint8_t)mode, 0, (uint32_t)size };
+    uint64_t errors = 0;
+    size_t in_flight = 0;
+
+    double start = now_ns();
+    double end = start + duration * 1e9;
+    for (size_t i = 0; i < connected; i++) {
+        if (send_request(&conns[i], &req) == 0) {
+            conns[i].active = 1;
+            in_flight++;
+        } else {
+            errors++;
+        }
+    }
+
+    struct epoll_event events[512];
+    while (in_flight > 0) {
+        double now = now_ns();
+        if (now > end + DRAIN_GRACE_NS) break;
+        int n = epoll_wait(epfd, events, 512, 100);
+        if (n < 0 && errno != EINTR) break;
+
+        for (int i = 0; i < n; i++) {
+            load_client_t *c = events[i].data.ptr;
+            if (!c->active) continue;
+            int rc = read_response(c, scratch, size + sizeof(qrngd_response_t), size);
+            if (rc == 0) continue;
+
+            double done = now_ns();
+            if (rc < 0 || c->header.status != QRNGD_SUCCESS) {
+                errors++;
+            } else if (log_latency(&log, done - c->sent_ns) != 0) {
+                errors++;
+            }
+            // Keep loading until the deadline, then let this client go idle
+            if (rc < 0 || done >= end || send_request(c, &req) != 0) {
+                c->active = 0;
+                in_flight--;
+            }
+        }
+    }
+    double elapsed = now_ns() - start;
+
+    for (size_t i = 0; i < connected; i++) close(conns[i].fd);
+    close(epfd);
+
+    if (daemon_pid > 0) {
+        kill(daemon_pid, SIGTERM);
+        waitpid(daemon_pid, NULL, 0);
+    }
+
+    print_results(&log, errors, in_flight, elapsed, size, "requests");
+    printf("\n  With N clients each keeping one request in flight, latency is about\n");
+    printf("  N / (requests/sec): it measures queueing in the daemon, not a single\n");
+    printf("  round trip. Use --clients 1 for the unloaded round-trip time.\n");
+
+    free(log.samples);
+    free(scratch);
+    free(conns);
+    return (connected == clients && errors == 0 && in_flight == 0) ? 0 : 1;
+}
+
+#else /* !__linux__ */
+
+int main(void) {
+    fprintf(stderr, "qrngd_loadgen needs epoll (Linux)\n");
+    return 0;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,701 @@
+/**
+ * @file qrngd_test.c
+ * @brief Tests for the qrngd entropy daemon and its client library
+ *
+ * Each test runs a server on its own event-loop thread and a temporary
+ * socket, then talks to it through the client library or a raw socket.
+ */
+
+#include "../src/daemon/qrngd_server.h"
+#include "../src/daemon/qrngd_client.h"
+#include "../src/daemon/shm_ring.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+#define TEST_START(name) \
+    do { \
+        tests_run++; \
+        printf("\n[TEST %d] %s\n", tests_run, name); \
+    } while(0)
+
+#define TEST_PASS() \
+    do { \
+        tests_passed++; \
+        printf("  ✓ PASSED\n"); \
+        return 1; \
+    } while(0)
+
+#define TEST_FAIL(msg) \
+    do { \
+        tests_failed++; \
+        printf("  ✗ FAILED: %s\n", msg); \
+        return 0; \
+    } while(0)
+
+#define ASSERT_TRUE(expr, msg) \
+    do { \
+        if (!(expr)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+#define ASSERT_SUCCESS(err, msg) \
+    do { \
+        qrngd_error_t e_ = (err); \
+        if (e_ != QRNGD_SUCCESS) { \
+            printf("  Error: %s\n", qrngd_error_string(e_)); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+typedef struct {
+    qrngd_server_t *server;
+    pthread_t thread;
+    int shm;                        /**< Also publish the shared ring */
+} test_daemon_t;
+
+static char socket_path[108];
+static char shm_name[64];
+
+static void *loop_thread(void *arg) {
+    qrngd_server_run((qrngd_server_t *)arg);
+    return NULL;
+}
+
+static qrngd_error_t daemon_start(test_daemon_t *d) {
+    qrngd_config_t config;
+    qrngd_get_default_config(&config);
+    config.socket_path = socket_path;
+    config.buffer_size = 64 * 1024;
+    config.prewarm_modes = 1u << QRNGD_MODE_FAST;
+    config.shm_name = d->shm ? shm_name : NULL;
+    config.shm_slots = 64;
+    config.shm_mode = QRNGD_MODE_FAST;
+    qrngd_error_t err = qrngd_server_create(&d->server, &config);
+    if (err != QRNGD_SUCCESS) return err;
+    if (pthread_create(&d->thread, NULL, loop_thread, d->server) != 0) {
+        qrngd_server_free(d->server);
+        return QRNGD_ERROR_OUT_OF_MEMORY;
+    }
+    return QRNGD_SUCCESS;
+}
+
+static void daemon_stop(test_daemon_t *d) {
+    qrngd_server_stop(d->server);
+    pthread_join(d->thread, NULL);
+    qrngd_server_free(d->server);
+    d->server = NULL;
+}
+
+static int raw_connect(void) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", socket_path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int raw_recv(int fd, void *buf, size_t len) {
+    uint8_t *p = buf;
+    while (len > 0) {
+        ssize_t n = recv(fd, p, len, 0);
+        if (n <= 0) return -1;
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int all_zero(const uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i]) return 0;
+    }
+    return 1;
+}
+
+// Ring fill callback: each slot starts with a unique counter
+typedef struct {
+    uint64_t next_id;
+    int fail;
+} ring_source_t;
+
+static int counting_fill(void *user_data, uint8_t *buf, size_t size) {
+    ring_source_t *src = user_data;
+    if (src->fail) return -1;
+    memset(buf, 0xA5, size);
+    memcpy(buf, &src->next_id, sizeof(src->next_id));
+    src->next_id++;
+    return 0;
+}
+
+static shm_ring_error_t small_ring(shm_ring_t **ring, size_t slots, uint64_t stale_ns) {
+    shm_ring_config_t config;
+    shm_ring_get_default_config(&config);
+    config.slot_size = 64;
+    config.slot_count = slots;
+    config.stale_ns = stale_ns;
+    return shm_ring_create(ring, shm_name, &config);
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+int test_server_lifecycle(void) {
+    TEST_START("Server binds, refuses a live path, removes its socket");
+
+    test_daemon_t d = { 0 };
+    ASSERT_SUCCESS(daemon_start(&d), "Server should start");
+
+    struct stat st;
+    ASSERT_TRUE(stat(socket_path, &st) == 0 && S_ISSOCK(st.st_mode), "Socket file should exist");
+    ASSERT_TRUE((st.st_mode & 0777) == QRNGD_DEFAULT_SOCKET_MODE,
+                "Socket should get the configured mode, not the umask's");
+
+    qrngd_server_t *second = NULL;
+    qrngd_config_t config;
+    qrngd_get_default_config(&config);
+    config.socket_path = socket_path;
+    config.prewarm_modes = 0;
+    ASSERT_TRUE(qrngd_server_create(&second, &config) == QRNGD_ERROR_ADDRESS_IN_USE,
+                "Second server on a live path should be refused");
+    ASSERT_TRUE(stat(socket_path, &st) == 0, "Refused server must not unlink the live socket");
+
+    daemon_stop(&d);
+    ASSERT_TRUE(stat(socket_path, &st) != 0, "Socket file should be removed on free");
+
+    TEST_PASS();
+}
+
+int test_default_socket_path(void) {
+    TEST_START("Default socket lives in a private runtime directory");
+
+    const char *saved = getenv("XDG_RUNTIME_DIR");
+    char saved_copy[256];
+    snprintf(saved_copy, sizeof(saved_copy), "%s", saved ? saved : "");
+    char path[108];
+
+    setenv("XDG_RUNTIME_DIR", "/run/user/1234", 1);
+    ASSERT_SUCCESS(qrngd_default_socket_path(path, sizeof(path)), "Runtime dir path");
+    ASSERT_TRUE(strcmp(path, "/run/user/1234/" QRNGD_SOCKET_NAME) == 0,
+                "Should use $XDG_RUNTIME_DIR");
+
+    setenv("XDG_RUNTIME_DIR", "relative", 1);
+    ASSERT_SUCCESS(qrngd_default_socket_path(path, sizeof(path)), "Fallback path");
+    ASSERT_TRUE(strcmp(path, QRNGD_DEFAULT_SOCKET) == 0, "Relative runtime dir is ignored");
+    ASSERT_TRUE(qrngd_default_socket_path(path, 8) == QRNGD_ERROR_INVALID_PARAM,
+                "Truncated path should be refused");
+
+    if (saved) setenv("XDG_RUNTIME_DIR", saved_copy, 1);
+    else unsetenv("XDG_RUNTIME_DIR");
+    TEST_PASS();
+}
+
+int test_client_modes(void) {
+    TEST_START("Client receives bytes in every mode");
+
+    test_daemon_t d = { 0 };
+    ASSERT_SUCCESS(daemon_start(&d), "Server should start");
+    qrngd_client_t *client = NULL;
+    ASSERT_SUCCESS(qrngd_client_connect(&client, socket_path), "Client should connect");
+
+    static const qrngd_mode_t modes[] = {
+        QRNGD_MODE_FAST, QRNGD_MODE_QUANTUM, QRNGD_MODE_HYBRID, QRNGD_MODE_QRNG_V3
+    };
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+        uint8_t a[64], b[64];
+        ASSERT_SUCCESS(qrngd_client_bytes(client, modes[i], a, sizeof(a)), "Request should succeed");
+        ASSERT_SUCCESS(qrngd_client_bytes(client, modes[i], b, sizeof(b)), "Request should succeed");
+        ASSERT_TRUE(!all_zero(a, sizeof(a)), "Output should not be all zero");
+        ASSERT_TRUE(memcmp(a, b, sizeof(a)) != 0, "Consecutive requests must not repeat bytes");
+        printf("  %-8s ok\n", qrngd_mode_string(modes[i]));
+    }
+
+    qrngd_client_close(client);
+    daemon_stop(&d);
+    TEST_PASS();
+}
+
+int test_large_request(void) {
+    TEST_START("Requests above QRNGD_MAX_REQUEST are split and pipelined");
+
+    test_daemon_t d = { 0 };
+    ASSERT_SUCCESS(daemon_start(&d), "Server should start");
+    qrngd_client_t *client = NULL;
+    ASSERT_SUCCESS(qrngd_client_connect(&client, socket_path), "Client should connect");
+
+    size_t size = 2 * QRNGD_MAX_REQUEST + 12345;
+    uint8_t *buf = calloc(1, size);
+    ASSERT_TRUE(buf != NULL, "Allocation");
+    ASSERT_SUCCESS(qrngd_client_bytes(client, QRNGD_MODE_FAST, buf, size), "Large request should succeed");
+    ASSERT_TRUE(!all_zero(buf, 4096) && !all_zero(buf + size - 4096, 4096),
+                "Both ends of the buffer should be filled");
+
+    qrngd_stats_t stats;
+    qrngd_server_get_stats(d.server, &stats);
+    ASSERT_TRUE(stats.requests_served == 3, "Should take three protocol requests");
+    ASSERT_TRUE(stats.bytes_served == size, "Byte count should match");
+    printf("  %zu bytes in %llu requests, %llu writes\n", size,
+           (unsigned long long)stats.requests_served, (unsigned long long)stats.write_batches);
+
+    free(buf);
+    qrngd_client_close(client);
+    daemon_stop(&d);
+    TEST_PASS();
+}
+
+int test_large_request_interleaving(void) {
+    TEST_START("Large QUANTUM reads do not hold up small requests");
+
+    test_daemon_t d = { 0 };
+    ASSERT_SUCCESS(daemon_start(&d), "Server should start");
+    int fd = raw_connect();
+    ASSERT_TRUE(fd >= 0, "Raw connect");
+
+    // 4 MB of QUANTUM output, pipelined and left unread for now
+    qrngd_request_t big[4];
+    for (int i = 0; i < 4; i++) {
+        big[i] = (qrngd_request_t){ QRNGD_PROTOCOL_VERSION, QRNGD_MODE_QUANTUM, 0, QRNGD_MAX_REQUEST };
+    }
+    ASSERT_TRUE(send(fd, big, sizeof(big), 0) == (ssize_t)sizeof(big), "Send large requests");
+    qrngd_stats_t stats;
+    do {
+        usleep(1000);
+        qrngd_server_get_stats(d.server, &stats);
+    } while (stats.direct_generations == 0);
+
+    qrngd_client_t *client = NULL;
+    uint8_t small[32];
+    ASSERT_SUCCESS(qrngd_client_connect(&client, socket_path), "Client should connect");
+    for (int i = 0; i < 10; i++) {
+        ASSERT_SUCCESS(qrngd_client_bytes(client, QRNGD_MODE_FAST, small, sizeof(small)), "Request");
+    }
+    qrngd_server_get_stats(d.server, &stats);
+    ASSERT_TRUE(stats.bytes_served < 4ull * QRNGD_MAX_REQUEST,
+                "Small requests should be served while the large ones are generated");
+
+    uint8_t *payload = malloc(QRNGD_MAX_REQUEST);
+    ASSERT_TRUE(payload != NULL, "Allocation");
+    int ok = 1;
+    for (int i = 0; i < 4 && ok; i++) {
+        qrngd_response_t resp;
+        ok = raw_recv(fd, &resp, sizeof(resp)) == 0 && resp.status == QRNGD_SUCCESS &&
+             resp.size == QRNGD_MAX_REQUEST && raw_recv(fd, payload, resp.size) == 0 &&
+             !all_zero(payload + resp.size - 4096, 4096);
+    }
+    free(payload);
+    ASSERT_TRUE(ok, "Every large response should arrive complete and in order");
+    qrngd_server_get_stats(d.server, &stats);
+    ASSERT_TRUE(stats.direct_generations == 4, "Four direct generations");
+
+    close(fd);
+    qrngd_client_close(client);
+    daemon_stop(&d);
+    TEST_PASS();
+}
+
+int test_invalid_requests(void) {
+    TEST_START("Malformed requests get an error and the connection stays usable");
+
+    test_daemon_t d = { 0 };
+    ASSERT_SUCCESS(daemon_start(&d), "Server should start");
+    int fd = raw_connect();
+    ASSERT_TRUE(fd >= 0, "Raw connect");
+
+    qrngd_request_t bad[] = {
+        { QRNGD_PROTOCOL_VERSION, QRNGD_MODE_FAST, 0, 0 },
+        { QRNGD_PROTOCOL_VERSION, QRNGD_MODE_FAST, 0, QRNGD_MAX_REQUEST + 1 },
+        { QRNGD_PROTOCOL_VERSION, 99, 0, 16 },
+        { QRNGD_PROTOCOL_VERSION + 1, QRNGD_MODE_FAST, 0, 16 },
+        { QRNGD_PROTOCOL_VERSION, QRNGD_MODE_FAST, 0x5A5A, 16 }, // reserved set
+        { QRNGD_PROTOCOL_VERSION, QRNGD_MODE_FAST, 0, 16 }       // valid
+    };
+    ASSERT_TRUE(send(fd, bad, sizeof(bad), 0) == (ssize_t)sizeof(bad), "Send");
+
+    for (int i = 0; i < 5; i++) {
+        qrngd_response_t resp;
+        ASSERT_TRUE(raw_recv(fd, &resp, sizeof(resp)) == 0, "Response header");
+        ASSERT_TRUE(resp.status == QRNGD_ERROR_PROTOCOL && resp.size == 0,
+                    "Malformed request should get PROTOCOL error without payload");
+    }
+    qrngd_response_t resp;
+    uint8_t payload[16];
+    ASSERT_TRUE(raw_recv(fd, &resp, sizeof(resp)) == 0, "Response header");
+    ASSERT_TRUE(resp.status == QRNGD_SUCCESS && resp.size == 16, "Valid request after errors");
+    ASSERT_TRUE(raw_recv(fd, payload, sizeof(payload)) == 0, "Payload");
+
+    qrngd_stats_t stats;
+    qrngd_server_get_stats(d.server, &stats);
+    ASSERT_TRUE(stats.request_errors == 5, "Five errors counted");
+
+    close(fd);
+    daemon_stop(&d);
+    TEST_PASS();
+}
+
+int test_pipelined_batching(void) {
+    TEST_START("Pipelined requests are answered in order with batched writes");
+
+    test_daemon_t d = { 0 };
+    ASSERT_SUCCESS(daemon_start(&d), "Server should start");
+    int fd = raw_connect();
+    ASSERT_TRUE(fd >= 0, "Raw connect");
+
+    enum { COUNT = 64 };
+    qrngd_request_t reqs[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        reqs[i] = (qrngd_request_t){ QRNGD_PROTOCOL_VERSION, QRNGD_MODE_FAST, 0, (uint32_t)(8 + i) };
+    }
+    ASSERT_TRUE(send(fd, reqs, sizeof(reqs), 0) == (ssize_t)sizeof(reqs), "Send");
+
+    uint8_t prev[8 + COUNT] = {0};
+    for (int i = 0; i < COUNT; i++) {
+        qrngd_response_t resp;
+        uint8_t payload[8 + COUNT];
+        ASSERT_TRUE(raw_recv(fd, &resp, sizeof(resp)) == 0, "Response header");
+        ASSERT_TRUE(resp.status == QRNGD_SUCCESS && resp.size == reqs[i].size,
+                    "Responses should come back in request order");
+        ASSERT_TRUE(raw_recv(fd, payload, resp.size) == 0, "Payload");
+        ASSERT_TRUE(memcmp(payload, prev, 8) != 0, "Responses must not repeat bytes");
+        memcpy(prev, payload, 8);
+    }
+
+    qrngd_stats_t stats;
+    qrngd_server_get_stats(d.server, &stats);
+    printf("  %d responses in %llu writes\n", COUNT, (unsigned long long)stats.write_batches);
+    ASSERT_TRUE(stats.write_batches < COUNT, "Responses should be coalesced");
+
+    close(fd);
+    daemon_stop(&d);
+    TEST_PASS();
+}
+
+int test_client_reconnect(void) {
+    TEST_START("Client reuses its connection and survives a daemon restart");
+
+    test_daemon_t d = { 0 };
+    ASSERT_SUCCESS(daemon_start(&d), "Server should start");
+    qrngd_client_t *client = NULL;
+    ASSERT_SUCCESS(qrngd_client_connect(&client, socket_path), "Client should connect");
+
+    uint8_t buf[32];
+    for (int i = 0; i < 10; i++) {
+        ASSERT_SUCCESS(qrngd_client_bytes(client, QRNGD_MODE_FAST, buf, sizeof(buf)), "Request");
+    }
+    qrngd_stats_t stats;
+    qrngd_server_get_stats(d.server, &stats);
+    ASSERT_TRUE(stats.connections_accepted == 1, "Ten requests should share one connection");
+
+    daemon_stop(&d);
+    ASSERT_TRUE(qrngd_client_bytes(client, QRNGD_MODE_FAST, buf, sizeof(buf)) == QRNGD_ERROR_SOCKET,
+                "Request with no daemon should fail");
+    ASSERT_TRUE(all_zero(buf, sizeof(buf)), "Failed request should zero the buffer");
+
+    ASSERT_SUCCESS(daemon_start(&d), "Server should restart");
+    ASSERT_SUCCESS(qrngd_client_bytes(client, QRNGD_MODE_FAST, buf, sizeof(buf)),
+                   "Client should reconnect to the new daemon");
+
+    qrngd_client_close(client);
+    daemon_stop(&d);
+    TEST_PASS();
+}
+
+int test_descriptor_exhaustion(void) {
+    TEST_START("Out of descriptors, queued connections are shed, not spun on");
+
+    test_daemon_t d = { 0 };
+    ASSERT_SUCCESS(daemon_start(&d), "Server should start");
+
+    struct rlimit saved, low;
+    ASSERT_TRUE(getrlimit(RLIMIT_NOFILE, &saved) == 0, "getrlimit");
+    low = saved;
+    low.rlim_cur = 64;
+    ASSERT_TRUE(setrlimit(RLIMIT_NOFILE, &low) == 0, "Lower the descriptor limit");
+
+    // Fill the table, then free one slot for the client's own socket
+    int fillers[64];
+    int count = 0;
+    while (count < 64 && (fillers[count] = dup(0)) >= 0) count++;
+    close(fillers[--count]);
+    int fd = raw_connect();
+
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    char byte;
+    int shed = fd >= 0 && poll(&pfd, 1, 2000) == 1 && recv(fd, &byte, 1, 0) == 0;
+    if (fd >= 0) close(fd);
+    while (count > 0) close(fillers[--count]);
+    setrlimit(RLIMIT_NOFILE, &saved);
+
+    qrngd_stats_t stats;
+    qrngd_server_get_stats(d.server, &stats);
+    ASSERT_TRUE(shed && stats.connections_rejected == 1,
+                "Connection queued at EMFILE should be accepted and closed");
+
+    qrngd_client_t *client = NULL;
+    uint8_t buf[32];
+    ASSERT_SUCCESS(qrngd_client_connect(&client, socket_path), "Client should connect afterwards");
+    ASSERT_SUCCESS(qrngd_client_bytes(client, QRNGD_MODE_FAST, buf, sizeof(buf)),
+                   "Server should still serve");
+
+    qrngd_client_close(client);
+    daemon_stop(&d);
+    TEST_PASS();
+}
+
+int test_shm_ring_consumers(void) {
+    TEST_START("Shared ring hands each slot to exactly one consumer");
+
+    shm_ring_t *producer = NULL, *a = NULL, *b = NULL;
+    ASSERT_TRUE(small_ring(&producer, 16, SHM_RING_DEFAULT_STALE_NS) == SHM_RING_SUCCESS,
+                "Ring should be created");
+    ASSERT_TRUE(shm_ring_attach(&a, shm_name) == SHM_RING_SUCCESS, "First consumer attaches");
+    ASSERT_TRUE(shm_ring_attach(&b, shm_name) == SHM_RING_SUCCESS, "Second consumer attaches");
+
+    ring_source_t src = { 0, 0 };
+    ASSERT_TRUE(shm_ring_produce(producer, counting_fill, &src, 100) == 16, "Fill stops when full");
+    ASSERT_TRUE(shm_ring_is_full(producer), "Ring should report full");
+
+    // Take 64 slots alternately, refilling as they drain
+    uint8_t seen[64] = { 0 };
+    for (int i = 0; i < 64; i++) {
+        uint8_t slot[64];
+        shm_ring_t *consumer = (i & 1) ? b : a;
+        if (shm_ring_read(consumer, slot, sizeof(slot), 0) != SHM_RING_SUCCESS) {
+            shm_ring_produce(producer, counting_fill, &src, 100);
+            ASSERT_TRUE(shm_ring_read(consumer, slot, sizeof(slot), 0) == SHM_RING_SUCCESS,
+                        "Read after refill");
+        }
+        uint64_t id;
+        memcpy(&id, slot, sizeof(id));
+        ASSERT_TRUE(id < 64 && !seen[id], "Slot ids must be unique");
+        seen[id] = 1;
+        ASSERT_TRUE(slot[8] == 0xA5 && slot[63] == 0xA5, "Payload copied intact");
+    }
+
+    // Small reads are served from the handle's leftover bytes
+    shm_ring_produce(producer, counting_fill, &src, 100);
+    shm_ring_stats_t before, after;
+    shm_ring_get_stats(producer, &before);
+    uint8_t small[16];
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(shm_ring_read(a, small, sizeof(small), 0) == SHM_RING_SUCCESS, "Small read");
+    }
+    shm_ring_get_stats(producer, &after);
+    ASSERT_TRUE(after.consumed - before.consumed == 1, "Four 16-byte reads should take one slot");
+
+    shm_ring_detach(a);
+    shm_ring_detach(b);
+    shm_ring_destroy(producer);
+    TEST_PASS();
+}
+
+int test_shm_ring_fence(void) {
+    TEST_START("Shared ring fences on fill failure and wipes published slots");
+
+    shm_ring_t *producer = NULL, *consumer = NULL;
+    ASSERT_TRUE(small_ring(&producer, 8, SHM_RING_DEFAULT_STALE_NS) == SHM_RING_SUCCESS,
+                "Ring should be created");
+    ASSERT_TRUE(shm_ring_attach(&consumer, shm_name) == SHM_RING_SUCCESS, "Consumer attaches");
+
+    ring_source_t src = { 0, 0 };
+    ASSERT_TRUE(shm_ring_produce(producer, counting_fill, &src, 4) == 4, "Publish four slots");
+    src.fail = 1;
+    ASSERT_TRUE(shm_ring_produce(producer, counting_fill, &src, 4) == SHM_RING_ERROR_GENERATION,
+                "Fill failure should be reported");
+
+    uint8_t buf[32];
+    memset(buf, 0xFF, sizeof(buf));
+    ASSERT_TRUE(shm_ring_read(consumer, buf, sizeof(buf), 0) == SHM_RING_ERROR_FENCED,
+                "Consumers should see the fence");
+    ASSERT_TRUE(all_zero(buf, sizeof(buf)), "Fenced read should zero the buffer");
+    for (uint64_t pos = 0; pos < 8; pos++) {
+        shm_ring_slot_t *slot = shm_ring_slot(producer, pos);
+        ASSERT_TRUE(all_zero((uint8_t *)(slot + 1), 64), "Every slot should be wiped");
+    }
+
+    shm_ring_stats_t stats;
+    shm_ring_get_stats(producer, &stats);
+    ASSERT_TRUE(stats.fences == 1 && stats.available == 0, "Published slots should be drained");
+
+    src.fail = 0;
+    ASSERT_TRUE(shm_ring_produce(producer, counting_fill, &src, 4) == 4, "Recovery publishes");
+    ASSERT_TRUE(shm_ring_read(consumer, buf, sizeof(buf), 0) == SHM_RING_SUCCESS,
+                "Output should resume after a good fill");
+
+    shm_ring_detach(consumer);
+    shm_ring_destroy(producer);
+    TEST_PASS();
+}
+
+int test_shm_ring_crashed_consumer(void) {
+    TEST_START("Shared ring reclaims a slot held by a crashed consumer");
+
+    shm_ring_t *producer = NULL, *consumer = NULL;
+    ASSERT_TRUE(small_ring(&producer, 4, 1000000) == SHM_RING_SUCCESS, "Ring should be created");
+    ring_source_t src = { 0, 0 };
+    ASSERT_TRUE(shm_ring_produce(producer, counting_fill, &src, 4) == 4, "Fill the ring");
+
+    // The child claims slot 0 exactly like a consumer, then dies holding it
+    pid_t child = fork();
+    if (child == 0) {
+        shm_ring_t *victim = NULL;
+        if (shm_ring_attach(&victim, shm_name) != SHM_RING_SUCCESS) _exit(1);
+        shm_ring_header_t *hdr = shm_ring_header(victim);
+        uint64_t pos = 0;
+        if (!__atomic_compare_exchange_n(&hdr->head, &pos, 1, 0,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            _exit(1);
+        }
+        __atomic_store_n(&shm_ring_slot(victim, 0)->claimer, (int32_t)getpid(), __ATOMIC_RELEASE);
+        _exit(0);
+    }
+    ASSERT_TRUE(child > 0, "fork should succeed");
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0, "Child should claim a slot");
+
+    ASSERT_TRUE(shm_ring_attach(&consumer, shm_name) == SHM_RING_SUCCESS, "Consumer attaches");
+    uint8_t buf[3 * 64];
+    ASSERT_TRUE(shm_ring_read(consumer, buf, sizeof(buf), 0) == SHM_RING_SUCCESS,
+                "Remaining slots are readable");
+
+    // The producer's next lap waits on slot 0 until stale_ns passes
+    shm_ring_stats_t stats = { 0 };
+    for (int i = 0; i < 200 && stats.reclaimed == 0; i++) {
+        shm_ring_produce(producer, counting_fill, &src, 4);
+        shm_ring_get_stats(producer, &stats);
+        usleep(1000);
+    }
+    ASSERT_TRUE(stats.reclaimed == 1, "The dead consumer's slot should be reclaimed");
+
+    shm_ring_produce(producer, counting_fill, &src, 4);
+    ASSERT_TRUE(shm_ring_read(consumer, buf, sizeof(buf), 0) == SHM_RING_SUCCESS,
+                "Reads continue after the reclaim");
+
+    shm_ring_detach(consumer);
+    shm_ring_destroy(producer);
+    TEST_PASS();
+}
+
+int test_shm_ring_replace(void) {
+    TEST_START("Shared ring replaces a dead producer's object, never a live one");
+
+    shm_ring_t *producer = NULL, *second = NULL, *consumer = NULL;
+    ASSERT_TRUE(small_ring(&producer, 4, SHM_RING_DEFAULT_STALE_NS) == SHM_RING_SUCCESS,
+                "Ring should be created");
+    ASSERT_TRUE(small_ring(&second, 4, SHM_RING_DEFAULT_STALE_NS) == SHM_RING_ERROR_IN_USE,
+                "A live producer's ring should be refused");
+    ring_source_t src = { 0, 0 };
+    ASSERT_TRUE(shm_ring_produce(producer, counting_fill, &src, 4) == 4, "Fill the ring");
+    uint8_t buf[64];
+    ASSERT_TRUE(shm_ring_attach(&consumer, shm_name) == SHM_RING_SUCCESS &&
+                shm_ring_read(consumer, buf, sizeof(buf), 0) == SHM_RING_SUCCESS,
+                "Live ring should still be readable");
+    shm_ring_detach(consumer);
+    shm_ring_destroy(producer);
+
+    // The child creates the ring and exits without destroying it
+    pid_t child = fork();
+    if (child == 0) {
+        shm_ring_t *orphan = NULL;
+        _exit(small_ring(&orphan, 4, SHM_RING_DEFAULT_STALE_NS) == SHM_RING_SUCCESS ? 0 : 1);
+    }
+    ASSERT_TRUE(child > 0, "fork should succeed");
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0, "Child should create a ring");
+
+    ASSERT_TRUE(small_ring(&producer, 4, SHM_RING_DEFAULT_STALE_NS) == SHM_RING_SUCCESS,
+                "A dead producer's ring should be replaced");
+    shm_ring_destroy(producer);
+    TEST_PASS();
+}
+
+int test_daemon_shm_ring(void) {
+    TEST_START("Daemon publishes into the shared ring and closes it on shutdown");
+
+    test_daemon_t d = { .shm = 1 };
+    ASSERT_SUCCESS(daemon_start(&d), "Server with --shm should start");
+    shm_ring_t *consumer = NULL;
+    ASSERT_TRUE(shm_ring_attach(&consumer, shm_name) == SHM_RING_SUCCESS, "Consumer attaches");
+
+    uint8_t buf[16 * 1024];
+    ASSERT_TRUE(shm_ring_read(consumer, buf, sizeof(buf), 2000) == SHM_RING_SUCCESS,
+                "Read 16 KB from the ring");
+    ASSERT_TRUE(!all_zero(buf, sizeof(buf)), "Ring bytes should be random");
+
+    qrngd_stats_t stats;
+    qrngd_server_get_stats(d.server, &stats);
+    ASSERT_TRUE(stats.shm_slots_consumed >= 16, "Server should count ring consumption");
+
+    daemon_stop(&d);
+    ASSERT_TRUE(shm_ring_read(consumer, buf, sizeof(buf), 100) == SHM_RING_ERROR_NO_PRODUCER,
+                "Reads after shutdown should report the producer gone");
+    shm_ring_detach(consumer);
+    ASSERT_TRUE(shm_ring_attach(&consumer, shm_name) == SHM_RING_ERROR_SHM,
+                "Shutdown should unlink the ring");
+    TEST_PASS();
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("QRNGD DAEMON TESTS\n");
+    printf("========================================\n");
+
+#ifndef __linux__
+    printf("qrngd needs epoll; skipping on this platform\n");
+    return 0;
+#endif
+
+    snprintf(socket_path, sizeof(socket_path), "/tmp/qrngd_test_%d.sock", (int)getpid());
+    snprintf(shm_name, sizeof(shm_name), "/qrngd_test_%d", (int)getpid());
+
+    test_server_lifecycle();
+    test_default_socket_path();
+    test_client_modes();
+    test_large_request();
+    test_large_request_interleaving();
+    test_invalid_requests();
+    test_pipelined_batching();
+    test_client_reconnect();
+    test_descriptor_exhaustion();
+    test_shm_ring_consumers();
+    test_shm_ring_fence();
+    test_shm_ring_crashed_consumer();
+    test_shm_ring_replace();
+    test_daemon_shm_ring();
+
+    printf("\n========================================\n");
+    printf("TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Total tests:  %d\n", tests_run);
+    printf("Passed:       %d\n", tests_passed);
+    printf("Failed:       %d\n", tests_failed);
+    printf("========================================\n");
+
+    return tests_failed == 0 ? 0 : 1;
+}
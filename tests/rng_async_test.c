@@ -0,0 +1,302 @@
+/**
+ * @file rng_async_test.c
+ * @brief Tests for the async submit/poll API
+ *
+ * Tests cover:
+ * - Small requests completing inline during submit
+ * - Large requests split into pieces across the worker pool
+ * - Readiness of the completion fd under epoll
+ * - Many concurrent requests with distinct cookies
+ * - Outstanding limit, wait timeouts and parameter validation
+ * - The qrng_v3 backend
+ */
+
+#include "../src/secure_rng/rng_async.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+#define TEST_START(name) \
+    do { \
+        tests_run++; \
+        printf("\n[TEST %d] %s\n", tests_run, name); \
+    } while(0)
+
+#define TEST_PASS() \
+    do { \
+        tests_passed++; \
+        printf("  ✓ PASSED\n"); \
+        return 1; \
+    } while(0)
+
+#define TEST_FAIL(msg) \
+    do { \
+        tests_failed++; \
+        printf("  ✗ FAILED: %s\n", msg); \
+        return 0; \
+    } while(0)
+
+#define ASSERT_TRUE(expr, msg) \
+    do { \
+        if (!(expr)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(a, b, msg) \
+    do { \
+        if ((a) != (b)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            printf("  Expected: %ld, Got: %ld\n", (long)(b), (long)(a)); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+// A buffer is plausibly random if no 4 KB block is left at its fill value
+static int looks_filled(const uint8_t *buf, size_t size) {
+    for (size_t off = 0; off < size; off += 4096) {
+        size_t n = size - off < 4096 ? size - off : 4096;
+        size_t same = 0;
+        for (size_t i = 0; i < n; i++) same += buf[off + i] == 0xAA;
+        if (same > n / 16 + 8) return 0;
+    }
+    return 1;
+}
+
+static void pool_config(rng_async_config_t *config) {
+    rng_async_get_default_config(config);
+    config->workers = 2;
+    config->split_size = 64 * 1024;
+    config->sync_threshold = 4096;
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+int test_inline_small(void) {
+    TEST_START("Small requests complete during submit");
+
+    rng_async_t *ctx = NULL;
+    rng_async_config_t config;
+    pool_config(&config);
+    ASSERT_EQ(rng_async_create_secure(&ctx, NULL, &config), RNG_ASYNC_SUCCESS, "Create should succeed");
+
+    uint8_t buf[1024];
+    memset(buf, 0xAA, sizeof(buf));
+    ASSERT_EQ(rng_async_submit(ctx, buf, sizeof(buf), buf), RNG_ASYNC_SUCCESS, "Submit should succeed");
+
+    rng_async_completion_t done;
+    ASSERT_EQ(rng_async_poll(ctx, &done, 1), 1, "Completion should already be queued");
+    ASSERT_TRUE(done.cookie == buf && done.buffer == buf && done.size == sizeof(buf),
+                "Completion should describe the request");
+    ASSERT_EQ(done.status, RNG_ASYNC_SUCCESS, "Request should succeed");
+    ASSERT_TRUE(looks_filled(buf, sizeof(buf)), "Buffer should be filled");
+
+    rng_async_stats_t stats;
+    rng_async_get_stats(ctx, &stats);
+    ASSERT_EQ(stats.inline_requests, 1, "Request should be counted inline");
+    ASSERT_EQ(stats.pieces, 0, "No pool pieces");
+    ASSERT_EQ(rng_async_outstanding(ctx), 0, "Nothing outstanding");
+    rng_async_free(ctx);
+    TEST_PASS();
+}
+
+int test_large_split(void) {
+    TEST_START("Large requests are split across the worker pool");
+
+    rng_async_t *ctx = NULL;
+    rng_async_config_t config;
+    pool_config(&config);
+    ASSERT_EQ(rng_async_create_secure(&ctx, NULL, &config), RNG_ASYNC_SUCCESS, "Create should succeed");
+
+    size_t size = 10 * 64 * 1024 + 100;
+    uint8_t *buf = malloc(size);
+    ASSERT_TRUE(buf != NULL, "Allocation");
+    memset(buf, 0xAA, size);
+    ASSERT_EQ(rng_async_submit(ctx, buf, size, (void *)7), RNG_ASYNC_SUCCESS, "Submit should succeed");
+
+    rng_async_completion_t done;
+    ASSERT_EQ(rng_async_wait(ctx, &done, 1, -1), 1, "Wait should return the completion");
+    ASSERT_TRUE(done.cookie == (void *)7 && done.status == RNG_ASYNC_SUCCESS, "Request should succeed");
+    ASSERT_TRUE(looks_filled(buf, size), "Every piece should be filled, including the tail");
+
+    rng_async_stats_t stats;
+    rng_async_get_stats(ctx, &stats);
+    ASSERT_EQ(stats.pieces, 11, "Ten full pieces plus a tail");
+    ASSERT_EQ(stats.bytes, size, "Every byte counted once");
+    free(buf);
+    rng_async_free(ctx);
+    TEST_PASS();
+}
+
+int test_epoll_fd(void) {
+    TEST_START("Completion fd is readable exactly while completions are queued");
+
+    rng_async_t *ctx = NULL;
+    rng_async_config_t config;
+    pool_config(&config);
+    ASSERT_EQ(rng_async_create_secure(&ctx, NULL, &config), RNG_ASYNC_SUCCESS, "Create should succeed");
+
+    int ep = epoll_create1(0);
+    struct epoll_event ev = { .events = EPOLLIN };
+    ASSERT_TRUE(epoll_ctl(ep, EPOLL_CTL_ADD, rng_async_fd(ctx), &ev) == 0, "fd should be pollable");
+    ASSERT_EQ(epoll_wait(ep, &ev, 1, 0), 0, "Idle fd should not be readable");
+
+    size_t size = 256 * 1024;
+    uint8_t *a = malloc(size), *b = malloc(size);
+    ASSERT_EQ(rng_async_submit(ctx, a, size, a), RNG_ASYNC_SUCCESS, "Submit a");
+    ASSERT_EQ(rng_async_submit(ctx, b, size, b), RNG_ASYNC_SUCCESS, "Submit b");
+
+    size_t got = 0;
+    rng_async_completion_t done[2];
+    while (got < 2) {
+        ASSERT_EQ(epoll_wait(ep, &ev, 1, 10000), 1, "fd should fire when a request finishes");
+        size_t n = rng_async_poll(ctx, done + got, 2 - got);
+        ASSERT_TRUE(n >= 1, "A readable fd means a completion is queued");
+        got += n;
+    }
+    ASSERT_EQ(epoll_wait(ep, &ev, 1, 0), 0, "Drained fd should not be readable");
+    ASSERT_TRUE(done[0].cookie != done[1].cookie, "Both requests should complete once");
+
+    close(ep);
+    free(a);
+    free(b);
+    rng_async_free(ctx);
+    TEST_PASS();
+}
+
+int test_many_requests(void) {
+    TEST_START("Mixed concurrent requests each complete once with their cookie");
+
+    rng_async_t *ctx = NULL;
+    rng_async_config_t config;
+    pool_config(&config);
+    ASSERT_EQ(rng_async_create_secure(&ctx, NULL, &config), RNG_ASYNC_SUCCESS, "Create should succeed");
+
+    enum { COUNT = 24 };
+    uint8_t *bufs[COUNT];
+    int seen[COUNT] = {0};
+    for (int i = 0; i < COUNT; i++) {
+        size_t size = (i % 3 == 0) ? 1000 : 100 * 1024;
+        bufs[i] = malloc(size);
+        ASSERT_EQ(rng_async_submit(ctx, bufs[i], size, (void *)(intptr_t)i), RNG_ASYNC_SUCCESS,
+                  "Submit should succeed");
+    }
+
+    rng_async_completion_t done[8];
+    int total = 0;
+    size_t n;
+    while ((n = rng_async_wait(ctx, done, 8, 10000)) > 0) {
+        for (size_t j = 0; j < n; j++) {
+            int id = (int)(intptr_t)done[j].cookie;
+            ASSERT_TRUE(id >= 0 && id < COUNT && done[j].buffer == bufs[id], "Cookie matches buffer");
+            seen[id]++;
+            total++;
+        }
+    }
+    ASSERT_EQ(total, COUNT, "Every request should complete");
+    for (int i = 0; i < COUNT; i++) {
+        ASSERT_EQ(seen[i], 1, "Each cookie exactly once");
+        free(bufs[i]);
+    }
+
+    rng_async_stats_t stats;
+    rng_async_get_stats(ctx, &stats);
+    ASSERT_EQ(stats.submitted, COUNT, "Submitted count");
+    ASSERT_EQ(stats.completed, COUNT, "Completed count");
+    ASSERT_EQ(stats.inline_requests, COUNT / 3, "Small requests inline");
+    rng_async_free(ctx);
+    TEST_PASS();
+}
+
+int test_limits(void) {
+    TEST_START("Outstanding limit, wait timeout and parameter checks");
+
+    rng_async_t *ctx = NULL;
+    rng_async_config_t config;
+    pool_config(&config);
+    config.max_outstanding = 2;
+    ASSERT_EQ(rng_async_create_secure(&ctx, NULL, &config), RNG_ASYNC_SUCCESS, "Create should succeed");
+
+    uint8_t a[64], b[64], c[64];
+    rng_async_completion_t done[2];
+    ASSERT_EQ(rng_async_wait(ctx, done, 2, 50), 0, "Nothing outstanding returns at once");
+    ASSERT_EQ(rng_async_submit(ctx, a, sizeof(a), a), RNG_ASYNC_SUCCESS, "First fits");
+    ASSERT_EQ(rng_async_submit(ctx, b, sizeof(b), b), RNG_ASYNC_SUCCESS, "Second fits");
+    ASSERT_EQ(rng_async_submit(ctx, c, sizeof(c), c), RNG_ASYNC_ERROR_QUEUE_FULL,
+              "Unpolled completions count as outstanding");
+    ASSERT_EQ(rng_async_poll(ctx, done, 2), 2, "Both complete");
+    ASSERT_EQ(rng_async_submit(ctx, c, sizeof(c), c), RNG_ASYNC_SUCCESS, "Polling frees slots");
+    ASSERT_EQ(rng_async_poll(ctx, done, 2), 1, "Third completes");
+
+    ASSERT_EQ(rng_async_submit(ctx, a, 0, a), RNG_ASYNC_ERROR_INVALID_PARAM, "Empty request");
+    ASSERT_EQ(rng_async_submit(ctx, NULL, 16, a), RNG_ASYNC_ERROR_NULL_POINTER, "NULL buffer");
+    rng_async_free(ctx);
+
+    config.split_size = 0;
+    ASSERT_EQ(rng_async_create_secure(&ctx, NULL, &config), RNG_ASYNC_ERROR_INVALID_PARAM,
+              "Zero split size is rejected");
+    ASSERT_TRUE(ctx == NULL, "No context on failure");
+    TEST_PASS();
+}
+
+int test_v3_backend(void) {
+    TEST_START("qrng_v3 backend fills split requests");
+
+    rng_async_t *ctx = NULL;
+    rng_async_config_t config;
+    pool_config(&config);
+    ASSERT_EQ(rng_async_create_v3(&ctx, NULL, &config), RNG_ASYNC_SUCCESS, "Create should succeed");
+
+    size_t size = 4 * 1024 * 1024;
+    uint8_t *buf = malloc(size);
+    memset(buf, 0xAA, size);
+    ASSERT_EQ(rng_async_submit(ctx, buf, size, NULL), RNG_ASYNC_SUCCESS, "Submit should succeed");
+    rng_async_completion_t done;
+    ASSERT_EQ(rng_async_wait(ctx, &done, 1, -1), 1, "Wait should return the completion");
+    ASSERT_EQ(done.status, RNG_ASYNC_SUCCESS, "Request should succeed");
+    ASSERT_TRUE(looks_filled(buf, size), "Buffer should be filled");
+
+    rng_async_stats_t stats;
+    rng_async_get_stats(ctx, &stats);
+    ASSERT_EQ(stats.pieces, 64, "4 MB in 64 KB pieces");
+    free(buf);
+    rng_async_free(ctx);
+    TEST_PASS();
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("ASYNC RNG TESTS\n");
+    printf("========================================\n");
+
+    test_inline_small();
+    test_large_split();
+    test_epoll_fd();
+    test_many_requests();
+    test_limits();
+    test_v3_backend();
+
+    printf("\n========================================\n");
+    printf("TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Total tests:  %d\n", tests_run);
+    printf("Passed:       %d\n", tests_passed);
+    printf("Failed:       %d\n", tests_failed);
+    printf("========================================\n");
+
+    return tests_failed == 0 ? 0 : 1;
+}
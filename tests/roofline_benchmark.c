@@ -0,0 +1,495 @@
+/**
+ * @file roofline_benchmark.c
+ * @brief Memory-bandwidth roofline for the state-vector simulation kernels
+ *
+ * benchmark_matrix.c and accelerate_benchmark_vs_simd report gates/sec; this
+ * reports how close each kernel gets to the hardware limits:
+ * - Measures STREAM-style copy and triad bandwidth and peak double-precision
+ *   FLOP rate on the host (single thread, matching the gate kernels)
+ * - Runs each quantum_gates.c kernel and each simd_ops.c primitive from
+ *   10 qubits up to the largest register that fits in memory (30 max)
+ * - Computes arithmetic intensity (FLOPs / byte) from an algorithmic model of
+ *   the minimum traffic, and the achieved fraction of the roofline
+ * - Flags kernels that sit far below the memory roof as latency-bound
+ *
+ * The traffic model counts each amplitude the kernel must read and write
+ * exactly once (ideal cache). Extra passes or strided access in the actual
+ * implementation therefore show up as a lower roofline fraction.
+ */
+
+#include "../src/quantum_rng/quantum_state.h"
+#include "../src/quantum_rng/quantum_gates.h"
+#include "../src/quantum_rng/simd_ops.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#define STREAM_MIN_ELEMENTS (1u << 24)  /* 128 MB per array at minimum */
+#define STREAM_REPS 5
+#define MIN_BATCH_NS 20e6               /* Each timed batch lasts >= 20 ms */
+#define TIMED_BATCHES 3
+#define QFT_MAX_QUBITS 20               /* O(n^2) passes; keep runtime sane */
+#define MAX_SUPPORTED_QUBITS 30
+#define LATENCY_BOUND_FRACTION 0.25
+#define ROOF_BOUND_FRACTION 0.50
+
+// ============================================================================
+// KERNEL REGISTRY
+// ============================================================================
+
+/**
+ * @brief Buffers shared by all kernels at one register size
+ */
+typedef struct {
+    quantum_state_t state;
+    complex_t *aux;                     /**< Second N-amplitude array */
+    double *probs;                      /**< N doubles */
+    int qubit;                          /**< Target qubit for 1q/2q gates */
+    double norm;                        /**< Runtime 1.0 (kept opaque to LTO) */
+    int qft_qubits[MAX_SUPPORTED_QUBITS];
+} kernel_ctx_t;
+
+typedef struct {
+    const char *name;
+    const char *source;                 /**< "gates" or "simd" */
+    double bytes_per_amp;               /**< Minimum DRAM traffic per amplitude */
+    double flops_per_amp;
+    int max_qubits;                     /**< 0 = no kernel-specific cap */
+    void (*model)(int n, double *bytes_per_amp, double *flops_per_amp);
+    void (*run)(kernel_ctx_t *k);
+} roofline_kernel_t;
+
+// Partner qubit for controlled gates: highest index that is not the target
+static int partner(const kernel_ctx_t *k) {
+    int last = (int)k->state.num_qubits - 1;
+    return k->qubit == last ? last - 1 : last;
+}
+
+static int third(const kernel_ctx_t *k) {
+    int a = k->qubit, b = partner(k);
+    for (int q = 0; q < (int)k->state.num_qubits; q++) {
+        if (q != a && q != b) return q;
+    }
+    return 0;
+}
+
+static void run_x(kernel_ctx_t *k)       { gate_pauli_x(&k->state, k->qubit); }
+static void run_y(kernel_ctx_t *k)       { gate_pauli_y(&k->state, k->qubit); }
+static void run_z(kernel_ctx_t *k)       { gate_pauli_z(&k->state, k->qubit); }
+static void run_h(kernel_ctx_t *k)       { gate_hadamard(&k->state, k->qubit); }
+static void run_s(kernel_ctx_t *k)       { gate_s(&k->state, k->qubit); }
+static void run_t(kernel_ctx_t *k)       { gate_t(&k->state, k->qubit); }
+static void run_rx(kernel_ctx_t *k)      { gate_rx(&k->state, k->qubit, 0.3); }
+static void run_ry(kernel_ctx_t *k)      { gate_ry(&k->state, k->qubit, 0.3); }
+static void run_rz(kernel_ctx_t *k)      { gate_rz(&k->state, k->qubit, 0.3); }
+static void run_u3(kernel_ctx_t *k)      { gate_u3(&k->state, k->qubit, 0.3, 0.2, 0.1); }
+static void run_cnot(kernel_ctx_t *k)    { gate_cnot(&k->state, partner(k), k->qubit); }
+static void run_cz(kernel_ctx_t *k)      { gate_cz(&k->state, partner(k), k->qubit); }
+static void run_swap(kernel_ctx_t *k)    { gate_swap(&k->state, partner(k), k->qubit); }
+static void run_cphase(kernel_ctx_t *k)  { gate_cphase(&k->state, partner(k), k->qubit, 0.3); }
+static void run_toffoli(kernel_ctx_t *k) { gate_toffoli(&k->state, partner(k), third(k), k->qubit); }
+static void run_fredkin(kernel_ctx_t *k) { gate_fredkin(&k->state, third(k), partner(k), k->qubit); }
+
+static void run_qft(kernel_ctx_t *k) {
+    gate_qft(&k->state, k->qft_qubits, k->state.num_qubits);
+}
+
+static void model_qft(int n, double *bytes_per_amp, double *flops_per_amp) {
+    // n Hadamards + n(n-1)/2 controlled phases + n/2 swaps
+    double cphases = (double)n * (n - 1) / 2.0;
+    *bytes_per_amp = 32.0 * n + 8.0 * cphases + 16.0 * (n / 2);
+    *flops_per_amp = 4.0 * n + 1.5 * cphases;
+}
+
+static void run_sum_sq(kernel_ctx_t *k) {
+    volatile double sink = simd_sum_squared_magnitudes(k->state.amplitudes, k->state.state_dim);
+    (void)sink;
+}
+
+static void run_normalize(kernel_ctx_t *k) {
+    simd_normalize_amplitudes(k->state.amplitudes, k->state.state_dim, k->norm);
+}
+
+static void run_probs(kernel_ctx_t *k) {
+    simd_compute_probabilities(k->state.amplitudes, k->probs, k->state.state_dim);
+}
+
+static void run_cswap(kernel_ctx_t *k) {
+    size_t half = k->state.state_dim / 2;
+    simd_complex_swap(k->state.amplitudes, k->state.amplitudes + half, half);
+}
+
+static void run_mul_i(kernel_ctx_t *k) {
+    simd_multiply_by_i(k->state.amplitudes, k->state.state_dim, 0);
+}
+
+static void run_negate(kernel_ctx_t *k) {
+    simd_negate(k->state.amplitudes, k->state.state_dim);
+}
+
+static void run_phase(kernel_ctx_t *k) {
+    simd_apply_phase(k->state.amplitudes, cexp(I * 0.3), k->state.state_dim);
+}
+
+static void run_xor(kernel_ctx_t *k) {
+    simd_xor_bytes((uint8_t *)k->aux, (const uint8_t *)k->state.amplitudes,
+                   k->state.state_dim * sizeof(complex_t));
+}
+
+static void run_mix(kernel_ctx_t *k) {
+    // state (8N bytes) x entropy (8N bytes) -> output (8N bytes)
+    size_t bytes = k->state.state_dim * sizeof(double);
+    simd_mix_entropy((const uint8_t *)k->state.amplitudes, (const uint8_t *)k->probs,
+                     (uint8_t *)k->aux, bytes);
+}
+
+static void run_cumsearch(kernel_ctx_t *k) {
+    // Threshold near 1 forces a scan of (almost) the whole vector
+    volatile uint64_t sink = simd_cumulative_probability_search(
+        k->state.amplitudes, k->state.state_dim, 0.999999);
+    (void)sink;
+}
+
+/*
+ * Traffic model, per amplitude of the N-element state (16 B each):
+ * - pair-updating 1q gates read and write everything: 32 B
+ * - diagonal gates on |1> (Z, S, T) touch half the vector: 16 B
+ * - controlled gates touch the control=1 half (or quarter for Toffoli)
+ */
+static const roofline_kernel_t kernels[] = {
+    {"gate_pauli_x",   "gates", 32.0,  0.0, 0, NULL, run_x},
+    {"gate_pauli_y",   "gates", 32.0,  1.0, 0, NULL, run_y},
+    {"gate_pauli_z",   "gates", 16.0,  1.0, 0, NULL, run_z},
+    {"gate_hadamard",  "gates", 32.0,  4.0, 0, NULL, run_h},
+    {"gate_s",         "gates", 16.0,  0.5, 0, NULL, run_s},
+    {"gate_t",         "gates", 16.0,  3.0, 0, NULL, run_t},
+    {"gate_rx",        "gates", 32.0,  6.0, 0, NULL, run_rx},
+    {"gate_ry",        "gates", 32.0,  6.0, 0, NULL, run_ry},
+    {"gate_rz",        "gates", 32.0,  6.0, 0, NULL, run_rz},
+    {"gate_u3",        "gates", 32.0, 14.0, 0, NULL, run_u3},
+    {"gate_cnot",      "gates", 16.0,  0.0, 0, NULL, run_cnot},
+    {"gate_cz",        "gates",  8.0,  0.5, 0, NULL, run_cz},
+    {"gate_swap",      "gates", 16.0,  0.0, 0, NULL, run_swap},
+    {"gate_cphase",    "gates",  8.0,  1.5, 0, NULL, run_cphase},
+    {"gate_toffoli",   "gates",  8.0,  0.0, 0, NULL, run_toffoli},
+    {"gate_fredkin",   "gates",  8.0,  0.0, 0, NULL, run_fredkin},
+    {"gate_qft",       "gates",  0.0,  0.0, QFT_MAX_QUBITS, model_qft, run_qft},
+    {"simd_sum_sq",    "simd",  16.0,  4.0, 0, NULL, run_sum_sq},
+    {"simd_normalize", "simd",  32.0,  2.0, 0, NULL, run_normalize},
+    {"simd_probs",     "simd",  24.0,  3.0, 0, NULL, run_probs},
+    {"simd_cswap",     "simd",  32.0,  0.0, 0, NULL, run_cswap},
+    {"simd_mul_i",     "simd",  32.0,  1.0, 0, NULL, run_mul_i},
+    {"simd_negate",    "simd",  32.0,  2.0, 0, NULL, run_negate},
+    {"simd_phase",     "simd",  32.0,  6.0, 0, NULL, run_phase},
+    {"simd_xor_bytes", "simd",  48.0,  0.0, 0, NULL, run_xor},
+    {"simd_mix",       "simd",  24.0,  0.0, 0, NULL, run_mix},
+    {"simd_cumsearch", "simd",  16.0,  4.0, 0, NULL, run_cumsearch},
+};
+
+#define NUM_KERNELS (sizeof(kernels) / sizeof(kernels[0]))
+
+// ============================================================================
+// HOST CEILINGS
+// ============================================================================
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static size_t llc_bytes(void);
+static double memory_budget(void);
+
+/**
+ * @brief STREAM array length: >= 4x LLC per array (STREAM rule), memory permitting
+ */
+static size_t stream_elements(void) {
+    size_t n = 4 * llc_bytes() / sizeof(double);
+    size_t cap = (size_t)(memory_budget() / 4.0 / sizeof(double));
+    if (n > cap) n = cap;
+    if (n < STREAM_MIN_ELEMENTS) n = STREAM_MIN_ELEMENTS;
+    return n;
+}
+
+/**
+ * @brief STREAM copy and triad, best of STREAM_REPS, in GB/s
+ */
+static int measure_stream(size_t n, double *copy_gbps, double *triad_gbps) {
+    double *a = malloc(n * sizeof(double));
+    double *b = malloc(n * sizeof(double));
+    double *c = malloc(n * sizeof(double));
+    if (!a || !b || !c) {
+        free(a); free(b); free(c);
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        a[i] = 1.0; b[i] = 2.0; c[i] = 0.0;
+    }
+
+    double best_copy = 1e30, best_triad = 1e30;
+    const double scalar = 3.0;
+    for (int r = 0; r < STREAM_REPS; r++) {
+        double t0 = now_ns();
+        for (size_t i = 0; i < n; i++) c[i] = a[i];
+        double t1 = now_ns();
+        for (size_t i = 0; i < n; i++) a[i] = b[i] + scalar * c[i];
+        double t2 = now_ns();
+        if (t1 - t0 < best_copy) best_copy = t1 - t0;
+        if (t2 - t1 < best_triad) best_triad = t2 - t1;
+    }
+
+    // Keep the stores observable
+    volatile double sink = a[n / 2] + c[n / 3];
+    (void)sink;
+
+    *copy_gbps = 2.0 * n * sizeof(double) / best_copy;
+    *triad_gbps = 3.0 * n * sizeof(double) / best_triad;
+    free(a); free(b); free(c);
+    return 0;
+}
+
+/**
+ * @brief Peak multiply-add rate with many independent chains, in GFLOP/s
+ *
+ * 32 independent accumulators hide FP latency; the compiler vectorizes the
+ * inner loop with whatever ISA this build targets (SSE3 by default, AVX/FMA
+ * with `make NATIVE=1`), so the ceiling matches the kernels' own codegen.
+ */
+static double measure_peak_gflops(void) {
+    double acc[32];
+    const double mul = 0.999999999, add = 1e-9;
+    const long iters = 20000000;
+    for (int j = 0; j < 32; j++) acc[j] = 1.0 + j * 1e-3;
+
+    double best = 1e30;
+    for (int r = 0; r < 3; r++) {
+        double t0 = now_ns();
+        for (long i = 0; i < iters; i++) {
+            for (int j = 0; j < 32; j++) {
+                acc[j] = acc[j] * mul + add;
+            }
+        }
+        double t = now_ns() - t0;
+        if (t < best) best = t;
+    }
+
+    volatile double sink = 0.0;
+    for (int j = 0; j < 32; j++) sink += acc[j];
+    (void)sink;
+
+    return 2.0 * 32.0 * (double)iters / best;
+}
+
+static size_t llc_bytes(void) {
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (l3 > 0) return (size_t)l3;
+#endif
+    return 32u * 1024 * 1024;  // Conservative default when unknown (macOS)
+}
+
+/**
+ * @brief Half of physical memory (4 GB if unknown)
+ */
+static double memory_budget(void) {
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGESIZE);
+    return (pages > 0 && page_size > 0) ? (double)pages * page_size / 2.0 : 4e9;
+}
+
+static int max_qubits_for_memory(void) {
+    double budget = memory_budget();
+    // state (16N) + aux (16N) + probs (8N)
+    int n = 10;
+    while (n < MAX_SUPPORTED_QUBITS && 40.0 * (double)(1ULL << (n + 1)) <= budget) n++;
+    return n;
+}
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+/**
+ * @brief Best average ns per call over TIMED_BATCHES calibrated batches
+ */
+static double time_kernel(const roofline_kernel_t *kern, kernel_ctx_t *k) {
+    kern->run(k);  // warm caches / page in
+
+    long ops = 1;
+    double t;
+    for (;;) {
+        double t0 = now_ns();
+        for (long i = 0; i < ops; i++) kern->run(k);
+        t = now_ns() - t0;
+        if (t >= MIN_BATCH_NS || ops >= (1L << 28)) break;
+        ops = t > 0 ? (long)(ops * (MIN_BATCH_NS / t) * 1.2) + 1 : ops * 10;
+    }
+
+    double best = t / ops;
+    for (int b = 1; b < TIMED_BATCHES; b++) {
+        double t0 = now_ns();
+        for (long i = 0; i < ops; i++) kern->run(k);
+        double per = (now_ns() - t0) / ops;
+        if (per < best) best = per;
+    }
+    return best;
+}
+
+static int ctx_init(kernel_ctx_t *k, int n, int target_qubit) {
+    memset(k, 0, sizeof(*k));
+    if (quantum_state_init(&k->state, (size_t)n) != QS_SUCCESS) return -1;
+
+    size_t dim = k->state.state_dim;
+    k->aux = malloc(dim * sizeof(complex_t));
+    k->probs = malloc(dim * sizeof(double));
+    if (!k->aux || !k->probs) {
+        free(k->aux);
+        free(k->probs);
+        quantum_state_free(&k->state);
+        return -1;
+    }
+
+    // Uniform superposition without n Hadamard passes
+    const double amp = 1.0 / sqrt((double)dim);
+    for (size_t i = 0; i < dim; i++) {
+        k->state.amplitudes[i] = amp;
+        k->aux[i] = amp;
+        k->probs[i] = amp * amp;
+    }
+
+    // A literal 1.0 lets -ffast-math + LTO delete the whole normalize pass
+    volatile double one = 1.0;
+    k->norm = one;
+
+    k->qubit = target_qubit < 0 || target_qubit >= n ? n - 1 : target_qubit;
+    for (int q = 0; q < n; q++) k->qft_qubits[q] = q;
+    return 0;
+}
+
+static void ctx_free(kernel_ctx_t *k) {
+    free(k->aux);
+    free(k->probs);
+    quantum_state_free(&k->state);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  --min-qubits N   Smallest register (default 10)\n");
+    printf("  --max-qubits N   Largest register (default: what fits in half of RAM, max %d)\n",
+           MAX_SUPPORTED_QUBITS);
+    printf("  --step N         Qubit increment (default 2)\n");
+    printf("  --qubit K        Target qubit for gates (default 0; -1 = highest stride)\n");
+    printf("  --filter STR     Only kernels whose name contains STR\n");
+}
+
+int main(int argc, char **argv) {
+    int min_q = 10, max_q = max_qubits_for_memory(), step = 2, target_qubit = 0;
+    const char *filter = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--min-qubits") == 0 && val) { min_q = atoi(val); i++; }
+        else if (strcmp(argv[i], "--max-qubits") == 0 && val) { max_q = atoi(val); i++; }
+        else if (strcmp(argv[i], "--step") == 0 && val) { step = atoi(val); i++; }
+        else if (strcmp(argv[i], "--qubit") == 0 && val) { target_qubit = atoi(val); i++; }
+        else if (strcmp(argv[i], "--filter") == 0 && val) { filter = val; i++; }
+        else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+    if (min_q < 3) min_q = 3;
+    if (max_q > MAX_SUPPORTED_QUBITS) max_q = MAX_SUPPORTED_QUBITS;
+    if (step < 1) step = 1;
+
+    printf("╔══════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║                  STATE-VECTOR KERNEL ROOFLINE BENCHMARK                      ║\n");
+    printf("╚══════════════════════════════════════════════════════════════════════════════╝\n");
+
+    double copy_gbps, triad_gbps;
+    size_t stream_n = stream_elements();
+    if (measure_stream(stream_n, &copy_gbps, &triad_gbps) != 0) {
+        fprintf(stderr, "STREAM allocation failed\n");
+        return 1;
+    }
+    double peak_gflops = measure_peak_gflops();
+    double bw = triad_gbps;                 // GB/s == bytes/ns
+    double ridge = peak_gflops / bw;        // FLOP/byte where the roofs meet
+    size_t llc = llc_bytes();
+
+    printf("  STREAM copy:  %8.2f GB/s   (single thread, 3 x %zu MB arrays)\n",
+           copy_gbps, stream_n * sizeof(double) >> 20);
+    printf("  STREAM triad: %8.2f GB/s   (memory roof)\n", triad_gbps);
+    printf("  Peak FP:      %8.2f GFLOP/s (compute roof)\n", peak_gflops);
+    printf("  Ridge point:  %8.3f FLOP/byte   LLC: %zu KB\n", ridge, llc / 1024);
+    printf("  Qubits %d..%d step %d, target qubit %s\n\n", min_q, max_q, step,
+           target_qubit < 0 ? "highest" : "fixed");
+
+    printf("  %-16s %3s %10s %7s %9s %8s %7s  %s\n",
+           "Kernel", "n", "ns/call", "AI", "GB/s", "GFLOP/s", "Roof%", "Bound");
+
+    int latency_bound = 0;
+    for (int n = min_q; n <= max_q; n = (n < max_q && n + step > max_q) ? max_q : n + step) {
+        kernel_ctx_t k;
+        if (ctx_init(&k, n, target_qubit) != 0) {
+            printf("  %d qubits: allocation failed, stopping\n", n);
+            break;
+        }
+        double dim = (double)k.state.state_dim;
+        size_t state_bytes = k.state.state_dim * sizeof(complex_t);
+
+        for (size_t i = 0; i < NUM_KERNELS; i++) {
+            const roofline_kernel_t *kern = &kernels[i];
+            if (filter && !strstr(kern->name, filter)) continue;
+            if (kern->max_qubits && n > kern->max_qubits) continue;
+
+            double bpa = kern->bytes_per_amp, fpa = kern->flops_per_amp;
+            if (kern->model) kern->model(n, &bpa, &fpa);
+            double bytes = bpa * dim, flops = fpa * dim;
+
+            double ns = time_kernel(kern, &k);
+            double achieved_gbps = bytes / ns;
+            double achieved_gflops = flops / ns;
+            double ai = bytes > 0 ? flops / bytes : 0.0;
+
+            // Roofline time: whichever ceiling binds
+            double t_mem = bytes / bw;
+            double t_fp = flops / peak_gflops;
+            double t_roof = t_mem > t_fp ? t_mem : t_fp;
+            double fraction = t_roof / ns;
+
+            const char *bound;
+            if (state_bytes <= llc) {
+                bound = "cache-resident";
+            } else if (fraction >= ROOF_BOUND_FRACTION) {
+                bound = ai >= ridge ? "compute" : "bandwidth";
+            } else if (ai < ridge && fraction < LATENCY_BOUND_FRACTION) {
+                bound = "LATENCY";
+                latency_bound++;
+            } else {
+                bound = "partial";
+            }
+
+            printf("  %-16s %3d %10.0f %7.3f %9.2f %8.2f %6.1f%%  %s\n",
+                   kern->name, n, ns, ai, achieved_gbps, achieved_gflops,
+                   fraction * 100.0, bound);
+            fflush(stdout);
+        }
+        ctx_free(&k);
+    }
+
+    printf("\n  AI = arithmetic intensity (FLOP/byte, minimum-traffic model).\n");
+    printf("  Roof%% = roofline time / measured time. 'LATENCY' marks DRAM-resident\n");
+    printf("  kernels below %.0f%% of the memory roof: stalls, strides or per-call\n",
+           LATENCY_BOUND_FRACTION * 100.0);
+    printf("  overhead dominate, not bandwidth. %d kernel/size point(s) flagged.\n", latency_bound);
+    return 0;
+}
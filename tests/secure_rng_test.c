@@ -155,6 +155,41 @@ int test_init_runs_startup_tests(void) {
     TEST_PASS();
 }
 
+int test_lazy_init_gates_output(void) {
+    TEST_START("Lazy initialization gates output on startup tests");
+
+    secure_rng_config_t config;
+    secure_rng_get_default_config(&config);
+    config.lazy_init = 1;
+
+    // Free while the startup tests may still be running
+    secure_rng_ctx_t *ctx;
+    ASSERT_SUCCESS(secure_rng_init_with_config(&ctx, &config), "Lazy init should succeed");
+    secure_rng_free(ctx);
+
+    secure_rng_error_t err = secure_rng_init_with_config(&ctx, &config);
+    ASSERT_SUCCESS(err, "Lazy init should succeed");
+
+    secure_rng_state_t state = secure_rng_get_state(ctx);
+    ASSERT_TRUE(state == SECURE_RNG_STATE_STARTUP || state == SECURE_RNG_STATE_OPERATIONAL,
+                "Lazy context should be starting up or operational");
+
+    // The first request waits for the startup tests
+    uint8_t buffer[64];
+    err = secure_rng_bytes(ctx, buffer, sizeof(buffer));
+    ASSERT_SUCCESS(err, "First request should succeed once startup passes");
+    ASSERT_EQ(secure_rng_get_state(ctx), SECURE_RNG_STATE_OPERATIONAL, "Should be operational after first request");
+
+    const health_test_stats_t *health_stats = secure_rng_get_health_stats(ctx);
+    ASSERT_TRUE(health_stats->startup_complete, "Startup tests should be complete before output");
+
+    printf("  State at return from init: %s\n",
+           state == SECURE_RNG_STATE_STARTUP ? "STARTUP" : "OPERATIONAL");
+
+    secure_rng_free(ctx);
+    TEST_PASS();
+}
+
 // ============================================================================
 // GENERATION TESTS
 // ============================================================================
@@ -556,6 +591,79 @@ int test_error_strings(void) {
     TEST_PASS();
 }
 
+typedef struct {
+    secure_rng_ctx_t *ctx;
+    secure_rng_error_t try_result;
+    secure_rng_error_t deadline_result;
+    size_t filled;
+    double waited_ms;
+} contended_call_t;
+
+static void *contended_calls(void *arg) {
+    contended_call_t *call = arg;
+    uint8_t buffer[256];
+    size_t filled = 0;
+    struct timespec t0, t1;
+
+    call->try_result = secure_rng_try_bytes(call->ctx, buffer, sizeof(buffer), &filled);
+    call->filled = filled;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    call->deadline_result = secure_rng_bytes_deadline(call->ctx, buffer, sizeof(buffer), 2000000, &filled);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    call->filled += filled;
+    call->waited_ms = (t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6;
+    return NULL;
+}
+
+int test_try_and_deadline_bytes(void) {
+    TEST_START("Non-blocking and deadline-bounded generation");
+
+    secure_rng_config_t config;
+    secure_rng_get_default_config(&config);
+    config.reseed_interval = 1024;
+    config.auto_reseed_enabled = 1;
+
+    secure_rng_ctx_t *ctx;
+    ASSERT_SUCCESS(secure_rng_init_threadsafe_with_config(&ctx, &config), "Init should succeed");
+
+    uint8_t buffer[256];
+    size_t filled = 0;
+    ASSERT_SUCCESS(secure_rng_try_bytes(ctx, buffer, sizeof(buffer), &filled), "Try should succeed");
+    ASSERT_EQ(filled, sizeof(buffer), "Try should fill the request");
+
+    // Another thread holding the lock: try fails at once, deadline times out
+    pthread_rwlock_wrlock(&ctx->rwlock);
+    contended_call_t call = { ctx, SECURE_RNG_SUCCESS, SECURE_RNG_SUCCESS, 1, 0.0 };
+    pthread_t thread;
+    pthread_create(&thread, NULL, contended_calls, &call);
+    pthread_join(thread, NULL);
+    pthread_rwlock_unlock(&ctx->rwlock);
+    ASSERT_EQ(call.try_result, SECURE_RNG_ERROR_WOULD_BLOCK, "Try should not wait for the lock");
+    ASSERT_EQ(call.deadline_result, SECURE_RNG_ERROR_TIMEOUT, "Deadline should expire waiting for the lock");
+    ASSERT_EQ(call.filled, 0, "Nothing written");
+    printf("  Lock wait returned after %.2f ms (deadline 2 ms)\n", call.waited_ms);
+    ASSERT_TRUE(call.waited_ms >= 1.5 && call.waited_ms < 100.0, "Deadline should be honoured");
+
+    // A due reseed is left to a call that may block
+    uint8_t block[1024];
+    ASSERT_SUCCESS(secure_rng_bytes(ctx, block, sizeof(block)), "Generation should succeed");
+    ASSERT_EQ(secure_rng_try_bytes(ctx, buffer, sizeof(buffer), &filled),
+              SECURE_RNG_ERROR_WOULD_BLOCK, "Try should not reseed");
+    uint64_t reseeds = ctx->stats.reseed_count;
+    ASSERT_SUCCESS(secure_rng_bytes_deadline(ctx, buffer, sizeof(buffer), 1000000000ULL, &filled),
+                   "Deadline call should reseed and fill");
+    ASSERT_EQ(filled, sizeof(buffer), "Deadline call should fill the request");
+    ASSERT_TRUE(ctx->stats.reseed_count == reseeds + 1, "Deadline call should have reseeded");
+
+    // An expired deadline reports a partial fill in whole chunks
+    ASSERT_EQ(secure_rng_bytes_deadline(ctx, buffer, sizeof(buffer), 0, &filled),
+              SECURE_RNG_ERROR_TIMEOUT, "Zero timeout should expire");
+    ASSERT_EQ(filled, 0, "Nothing written");
+
+    secure_rng_free(ctx);
+    TEST_PASS();
+}
+
 // ============================================================================
 // PERFORMANCE TESTS
 // ============================================================================
@@ -694,6 +802,7 @@ int main(void) {
     test_default_init();
     test_custom_config_init();
     test_init_runs_startup_tests();
+    test_lazy_init_gates_output();
 
     // Generation tests
     test_generate_bytes();
@@ -702,6 +811,7 @@ int main(void) {
     test_generate_double();
     test_generate_range32();
     test_generate_range64();
+    test_try_and_deadline_bytes();
 
     // Reseeding tests
     test_manual_reseed();
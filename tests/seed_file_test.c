@@ -0,0 +1,400 @@
+/**
+ * @file seed_file_test.c
+ * @brief Tests for the persisted seed file
+ *
+ * Tests cover:
+ * - SHA-256 known answer (FIPS 180-2 "abc")
+ * - Atomic write: round trip, mode 0600, no temporary files left behind
+ * - Rewrite-on-read: a consumed seed is replaced and never yields the same key
+ * - Rejection of missing, corrupt, truncated, group-readable and symlinked files
+ * - Entropy pool starting full from the seed file and saving on free
+ * - secure_rng creating and then mixing in the seed file
+ */
+
+#include "../src/entropy/seed_file.h"
+#include "../src/entropy/entropy_pool.h"
+#include "../src/secure_rng/secure_rng.h"
+#include "../src/common/sha256.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+#define TEST_START(name) \
+    do { \
+        tests_run++; \
+        printf("\n[TEST %d] %s\n", tests_run, name); \
+    } while(0)
+
+#define TEST_PASS() \
+    do { \
+        tests_passed++; \
+        printf("  ✓ PASSED\n"); \
+        return 1; \
+    } while(0)
+
+#define TEST_FAIL(msg) \
+    do { \
+        tests_failed++; \
+        printf("  ✗ FAILED: %s\n", msg); \
+        return 0; \
+    } while(0)
+
+#define ASSERT_TRUE(expr, msg) \
+    do { \
+        if (!(expr)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(a, b, msg) \
+    do { \
+        if ((a) != (b)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            printf("  Expected: %ld, Got: %ld\n", (long)(b), (long)(a)); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+static char test_dir[] = "/tmp/seed_file_test.XXXXXX";
+
+static void path_in_dir(char *out, size_t size, const char *name) {
+    snprintf(out, size, "%s/%s", test_dir, name);
+}
+
+static void fill_pattern(uint8_t *buf, size_t len, uint8_t start) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(start + i * 7);
+    }
+}
+
+static long file_size(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? (long)st.st_size : -1;
+}
+
+// Entries in test_dir other than "." and ".."
+static int dir_entries(void) {
+    DIR *d = opendir(test_dir);
+    struct dirent *e;
+    int n = 0;
+    if (!d) return -1;
+    while ((e = readdir(d)) != NULL) {
+        if (strcmp(e->d_name, ".") != 0 && strcmp(e->d_name, "..") != 0) n++;
+    }
+    closedir(d);
+    return n;
+}
+
+static void clear_dir(void) {
+    DIR *d = opendir(test_dir);
+    struct dirent *e;
+    char path[512];
+    if (!d) return;
+    while ((e = readdir(d)) != NULL) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+        path_in_dir(path, sizeof(path), e->d_name);
+        unlink(path);
+    }
+    closedir(d);
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+int test_sha256_vector(void) {
+    TEST_START("SHA-256 known answer");
+
+    static const uint8_t expected[SHA256_DIGEST_SIZE] = {
+        0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde,
+        0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+        0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+    };
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sha256("abc", 3, digest);
+    ASSERT_TRUE(memcmp(digest, expected, sizeof(digest)) == 0, "SHA-256(\"abc\") matches FIPS 180-2");
+
+    TEST_PASS();
+}
+
+int test_round_trip(void) {
+    TEST_START("Atomic write round trip");
+    clear_dir();
+
+    char path[512];
+    uint8_t seed[SEED_FILE_SEED_SIZE], back[SEED_FILE_SEED_SIZE];
+    struct stat st;
+    path_in_dir(path, sizeof(path), "seed");
+    fill_pattern(seed, sizeof(seed), 1);
+
+    ASSERT_EQ(seed_file_write(path, seed), SEED_FILE_SUCCESS, "write succeeds");
+    ASSERT_EQ(seed_file_read(path, back), SEED_FILE_SUCCESS, "read succeeds");
+    ASSERT_TRUE(memcmp(seed, back, sizeof(seed)) == 0, "seed round-trips");
+
+    ASSERT_EQ(stat(path, &st), 0, "file exists");
+    ASSERT_EQ(st.st_mode & 0777, 0600, "file mode is 0600");
+    ASSERT_EQ(file_size(path), 112, "file is 112 bytes");
+
+    // Replacing leaves exactly one file: no temporaries behind
+    fill_pattern(seed, sizeof(seed), 2);
+    ASSERT_EQ(seed_file_write(path, seed), SEED_FILE_SUCCESS, "overwrite succeeds");
+    ASSERT_EQ(seed_file_read(path, back), SEED_FILE_SUCCESS, "read after overwrite");
+    ASSERT_TRUE(memcmp(seed, back, sizeof(seed)) == 0, "new seed read back");
+    ASSERT_EQ(dir_entries(), 1, "only the seed file in the directory");
+
+    TEST_PASS();
+}
+
+int test_consume_rewrites(void) {
+    TEST_START("Consume rewrites the file and never repeats a key");
+    clear_dir();
+
+    char path[512];
+    uint8_t seed[SEED_FILE_SEED_SIZE], after[SEED_FILE_SEED_SIZE];
+    uint8_t fresh[64], other_fresh[64];
+    uint8_t key1[SEED_FILE_KEY_SIZE], key2[SEED_FILE_KEY_SIZE], key3[SEED_FILE_KEY_SIZE];
+    path_in_dir(path, sizeof(path), "seed");
+    fill_pattern(seed, sizeof(seed), 3);
+    fill_pattern(fresh, sizeof(fresh), 4);
+    fill_pattern(other_fresh, sizeof(other_fresh), 5);
+
+    ASSERT_EQ(seed_file_write(path, seed), SEED_FILE_SUCCESS, "write succeeds");
+    ASSERT_EQ(seed_file_consume(path, fresh, sizeof(fresh), key1), SEED_FILE_SUCCESS, "first consume");
+    ASSERT_EQ(seed_file_read(path, after), SEED_FILE_SUCCESS, "file still valid");
+    ASSERT_TRUE(memcmp(seed, after, sizeof(seed)) != 0, "seed replaced on read");
+
+    // Same fresh input, but the file moved on: a different key
+    ASSERT_EQ(seed_file_consume(path, fresh, sizeof(fresh), key2), SEED_FILE_SUCCESS, "second consume");
+    ASSERT_TRUE(memcmp(key1, key2, sizeof(key1)) != 0, "second key differs");
+
+    // Same seed, different fresh input: a different key
+    ASSERT_EQ(seed_file_write(path, seed), SEED_FILE_SUCCESS, "restore seed");
+    ASSERT_EQ(seed_file_consume(path, other_fresh, sizeof(other_fresh), key3), SEED_FILE_SUCCESS,
+              "consume with other fresh input");
+    ASSERT_TRUE(memcmp(key1, key3, sizeof(key1)) != 0, "key depends on fresh input");
+
+    // The key must not reveal the replacement seed
+    ASSERT_EQ(seed_file_read(path, after), SEED_FILE_SUCCESS, "read replacement");
+    ASSERT_TRUE(memcmp(after, key3, sizeof(key3)) != 0, "replacement seed is not the key");
+
+    ASSERT_EQ(seed_file_consume(path, fresh, 0, key1), SEED_FILE_ERROR_NULL_POINTER,
+              "empty fresh input rejected");
+
+    TEST_PASS();
+}
+
+int test_rejects_bad_files(void) {
+    TEST_START("Missing, corrupt and insecure files rejected");
+    clear_dir();
+
+    char path[512], link_path[512];
+    uint8_t seed[SEED_FILE_SEED_SIZE], back[SEED_FILE_SEED_SIZE];
+    uint8_t fresh[32], key[SEED_FILE_KEY_SIZE], zero[SEED_FILE_KEY_SIZE] = {0};
+    uint8_t byte;
+    int fd;
+    path_in_dir(path, sizeof(path), "seed");
+    path_in_dir(link_path, sizeof(link_path), "link");
+    fill_pattern(seed, sizeof(seed), 6);
+    fill_pattern(fresh, sizeof(fresh), 7);
+
+    ASSERT_EQ(seed_file_read(path, back), SEED_FILE_ERROR_NOT_FOUND, "missing file");
+
+    // Flip one seed byte
+    ASSERT_EQ(seed_file_write(path, seed), SEED_FILE_SUCCESS, "write succeeds");
+    fd = open(path, O_RDWR);
+    ASSERT_TRUE(fd >= 0, "open for tampering");
+    ASSERT_EQ(pread(fd, &byte, 1, 40), 1, "read byte");
+    byte ^= 0x01;
+    ASSERT_EQ(pwrite(fd, &byte, 1, 40), 1, "write byte");
+    close(fd);
+    ASSERT_EQ(seed_file_read(path, back), SEED_FILE_ERROR_CORRUPT, "bit flip detected");
+
+    memset(key, 0xAA, sizeof(key));
+    ASSERT_EQ(seed_file_consume(path, fresh, sizeof(fresh), key), SEED_FILE_ERROR_CORRUPT,
+              "consume of corrupt file fails");
+    ASSERT_TRUE(memcmp(key, zero, sizeof(key)) == 0, "no key on failure");
+
+    // Truncated
+    ASSERT_EQ(seed_file_write(path, seed), SEED_FILE_SUCCESS, "rewrite");
+    ASSERT_EQ(truncate(path, 100), 0, "truncate");
+    ASSERT_EQ(seed_file_read(path, back), SEED_FILE_ERROR_CORRUPT, "truncation detected");
+
+    // Readable by group
+    ASSERT_EQ(seed_file_write(path, seed), SEED_FILE_SUCCESS, "rewrite");
+    ASSERT_EQ(chmod(path, 0640), 0, "chmod");
+    ASSERT_EQ(seed_file_read(path, back), SEED_FILE_ERROR_INSECURE, "group-readable rejected");
+
+    // Symlink to a valid file
+    ASSERT_EQ(chmod(path, 0600), 0, "chmod back");
+    ASSERT_EQ(symlink(path, link_path), 0, "symlink");
+    ASSERT_EQ(seed_file_read(link_path, back), SEED_FILE_ERROR_INSECURE, "symlink rejected");
+
+    ASSERT_EQ(seed_file_read(NULL, back), SEED_FILE_ERROR_NULL_POINTER, "NULL path");
+
+    TEST_PASS();
+}
+
+int test_pool_starts_full(void) {
+    TEST_START("Entropy pool starts full from the seed file");
+    clear_dir();
+
+    char path[512];
+    uint8_t seed[SEED_FILE_SEED_SIZE], after[SEED_FILE_SEED_SIZE], saved[SEED_FILE_SEED_SIZE];
+    uint8_t out[64];
+    entropy_pool_ctx_t *pool = NULL;
+    entropy_pool_stats_t stats;
+    path_in_dir(path, sizeof(path), "pool.seed");
+
+    entropy_pool_config_t config = {
+        .pool_size = 64 * 1024,
+        .refill_threshold = 16 * 1024,
+        .chunk_size = 4096,
+        .enable_background_thread = 0,
+        .min_entropy = 4.0,
+        .defer_prefill = 0,
+        .seed_file = path,
+        .seed_save_interval_s = 0
+    };
+
+    // First start: no file yet, normal prefill, seed file created
+    ASSERT_EQ(entropy_pool_init_with_config(&pool, &config), 0, "init without seed file");
+    entropy_pool_get_stats(pool, &stats);
+    ASSERT_EQ(stats.seed_file_loaded, 0, "nothing loaded");
+    ASSERT_TRUE(stats.current_fill_level < config.pool_size, "partial prefill");
+    ASSERT_EQ(seed_file_read(path, seed), SEED_FILE_SUCCESS, "seed file created at init");
+    entropy_pool_free(pool);
+    ASSERT_EQ(seed_file_read(path, saved), SEED_FILE_SUCCESS, "seed file valid after free");
+    ASSERT_TRUE(memcmp(seed, saved, sizeof(seed)) != 0, "new seed saved on free");
+
+    // Second start: full pool, file replaced before the pool is used
+    pool = NULL;
+    ASSERT_EQ(entropy_pool_init_with_config(&pool, &config), 0, "init with seed file");
+    entropy_pool_get_stats(pool, &stats);
+    ASSERT_EQ(stats.seed_file_loaded, 1, "seed file loaded");
+    ASSERT_EQ(stats.current_fill_level, config.pool_size, "pool starts full");
+    ASSERT_EQ(seed_file_read(path, after), SEED_FILE_SUCCESS, "seed file still valid");
+    ASSERT_TRUE(memcmp(saved, after, sizeof(saved)) != 0, "seed file rewritten on load");
+    ASSERT_EQ(entropy_pool_get_bytes(pool, out, sizeof(out)), 0, "served from the pool");
+    entropy_pool_get_stats(pool, &stats);
+    ASSERT_EQ(stats.cache_hits, 1, "first request is a cache hit");
+    entropy_pool_free(pool);
+
+    ASSERT_EQ(dir_entries(), 1, "only the seed file in the directory");
+
+    TEST_PASS();
+}
+
+int test_secure_rng_seed_file(void) {
+    TEST_START("secure_rng creates and mixes the seed file");
+    clear_dir();
+
+    char path[512];
+    uint8_t seed[SEED_FILE_SEED_SIZE], after[SEED_FILE_SEED_SIZE];
+    uint8_t out[32];
+    secure_rng_config_t config;
+    secure_rng_stats_t stats;
+    secure_rng_ctx_t *rng = NULL;
+    path_in_dir(path, sizeof(path), "rng.seed");
+
+    secure_rng_get_default_config(&config);
+    config.require_hardware_entropy = 0;
+    config.seed_file = path;
+
+    ASSERT_EQ(secure_rng_init_with_config(&rng, &config), SECURE_RNG_SUCCESS, "init without seed file");
+    secure_rng_get_stats(rng, &stats);
+    ASSERT_EQ(stats.seed_file_loaded, 0, "nothing loaded");
+    ASSERT_EQ(seed_file_read(path, seed), SEED_FILE_SUCCESS, "seed file created at init");
+    secure_rng_free(rng);
+
+    rng = NULL;
+    ASSERT_EQ(seed_file_read(path, seed), SEED_FILE_SUCCESS, "seed file saved on free");
+    ASSERT_EQ(secure_rng_init_with_config(&rng, &config), SECURE_RNG_SUCCESS, "init with seed file");
+    secure_rng_get_stats(rng, &stats);
+    ASSERT_EQ(stats.seed_file_loaded, 1, "seed file mixed in");
+    ASSERT_EQ(seed_file_read(path, after), SEED_FILE_SUCCESS, "seed file still valid");
+    ASSERT_TRUE(memcmp(seed, after, sizeof(seed)) != 0, "seed file rewritten on load");
+    ASSERT_EQ(secure_rng_bytes(rng, out, sizeof(out)), SECURE_RNG_SUCCESS, "generates");
+    secure_rng_free(rng);
+
+    TEST_PASS();
+}
+
+int test_secure_rng_lazy_seed_file(void) {
+    TEST_START("secure_rng lazy_init publishes the seed file outcome");
+    clear_dir();
+
+    char path[512];
+    uint8_t out[32];
+    secure_rng_config_t config;
+    secure_rng_stats_t stats;
+    secure_rng_ctx_t *rng = NULL;
+    path_in_dir(path, sizeof(path), "lazy.seed");
+
+    secure_rng_get_default_config(&config);
+    config.require_hardware_entropy = 0;
+    config.enable_thread_safety = 1;
+    config.lazy_init = 1;
+    config.seed_file = path;
+
+    // First start creates the file; the second consumes it
+    ASSERT_EQ(secure_rng_init_with_config(&rng, &config), SECURE_RNG_SUCCESS, "first lazy init");
+    ASSERT_EQ(secure_rng_bytes(rng, out, sizeof(out)), SECURE_RNG_SUCCESS, "first start completes");
+    secure_rng_free(rng);
+
+    rng = NULL;
+    ASSERT_EQ(secure_rng_init_with_config(&rng, &config), SECURE_RNG_SUCCESS, "second lazy init");
+    secure_rng_get_stats(rng, &stats);   // May run while the startup thread does
+    ASSERT_EQ(secure_rng_bytes(rng, out, sizeof(out)), SECURE_RNG_SUCCESS, "second start completes");
+    secure_rng_get_stats(rng, &stats);
+    ASSERT_EQ(stats.seed_file_loaded, 1, "seed file mixed in");
+    ASSERT_EQ(stats.seed_file_saves, 1, "replacement counted once");
+    secure_rng_free(rng);
+
+    TEST_PASS();
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("SEED FILE TESTS\n");
+    printf("========================================\n");
+
+    if (!mkdtemp(test_dir)) {
+        perror("mkdtemp");
+        return 1;
+    }
+
+    test_sha256_vector();
+    test_round_trip();
+    test_consume_rewrites();
+    test_rejects_bad_files();
+    test_pool_starts_full();
+    test_secure_rng_seed_file();
+    test_secure_rng_lazy_seed_file();
+
+    clear_dir();
+    rmdir(test_dir);
+
+    printf("\n========================================\n");
+    printf("TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Total tests:  %d\n", tests_run);
+    printf("Passed:       %d\n", tests_passed);
+    printf("Failed:       %d\n", tests_failed);
+    printf("========================================\n");
+
+    return tests_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file simd_encode_test.c
+ * @brief Tests for the hex and base64 output encoders
+ *
+ * Tests cover, for every encoder path this build and CPU can run (scalar,
+ * SSSE3, AVX2, NEON):
+ * - Byte-for-byte agreement with an independent reference encoder for
+ *   every length 0..MAX_LEN, including each base64 padding tail
+ * - Unaligned source and destination offsets
+ * - No writes past the encoded length
+ * - RFC 4648 test vectors
+ */
+
+#include "../src/quantum_rng/simd_ops.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_LEN 200         // Covers several SIMD blocks plus every tail length
+#define MAX_OFFSET 16       // Source and destination misalignments tried
+#define CANARY 0x5A
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+static int tests_skipped = 0;
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+#define TEST_START(name) \
+    do { \
+        tests_run++; \
+        printf("\n[TEST %d] %s\n", tests_run, name); \
+    } while(0)
+
+#define TEST_PASS() \
+    do { \
+        tests_passed++; \
+        printf("  ✓ PASSED\n"); \
+        return 1; \
+    } while(0)
+
+#define TEST_FAIL(msg) \
+    do { \
+        tests_failed++; \
+        printf("  ✗ FAILED: %s\n", msg); \
+        return 0; \
+    } while(0)
+
+#define ASSERT_TRUE(expr, msg) \
+    do { \
+        if (!(expr)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+typedef size_t (*encode_fn_t)(const uint8_t *in, size_t n, char *out);
+
+static const struct {
+    simd_encoder_t which;
+    const char *name;
+} encoders[] = {
+    {SIMD_ENCODER_SCALAR, "scalar"},
+    {SIMD_ENCODER_SSSE3, "SSSE3"},
+    {SIMD_ENCODER_AVX2, "AVX2"},
+    {SIMD_ENCODER_NEON, "NEON"},
+};
+
+// Straightforward reference encoders, independent of simd_ops.c
+static size_t reference_hex(const uint8_t *in, size_t n, char *out) {
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < n; i++) {
+        out[2 * i] = digits[in[i] >> 4];
+        out[2 * i + 1] = digits[in[i] & 0x0F];
+    }
+    return 2 * n;
+}
+
+static size_t reference_base64(const uint8_t *in, size_t n, char *out) {
+    static const char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t o = 0;
+    for (size_t i = 0; i < n; i += 3) {
+        uint32_t b0 = in[i];
+        uint32_t b1 = i + 1 < n ? in[i + 1] : 0;
+        uint32_t b2 = i + 2 < n ? in[i + 2] : 0;
+        out[o++] = alphabet[b0 >> 2];
+        out[o++] = alphabet[((b0 & 0x03) << 4) | (b1 >> 4)];
+        out[o++] = i + 1 < n ? alphabet[((b1 & 0x0F) << 2) | (b2 >> 6)] : '=';
+        out[o++] = i + 2 < n ? alphabet[b2 & 0x3F] : '=';
+    }
+    return o;
+}
+
+// Every byte value shows up, in a pattern with no short period
+static void fill_input(uint8_t *buf, size_t n) {
+    uint32_t x = 0x12345678;
+    for (size_t i = 0; i < n; i++) {
+        x = x * 1664525u + 1013904223u;
+        buf[i] = (uint8_t)(x >> 24);
+    }
+}
+
+/*
+ * Compare one encoder against its reference for every length and offset
+ * pair; the destination is canary-filled so overruns show up too.
+ */
+static int compare_all(encode_fn_t encode, encode_fn_t reference, const char *what) {
+    static uint8_t src[MAX_LEN + MAX_OFFSET];
+    static char expected[4 * MAX_LEN + 8];
+    static char out[4 * MAX_LEN + 2 * MAX_OFFSET + 64];
+    fill_input(src, sizeof(src));
+
+    for (size_t len = 0; len <= MAX_LEN; len++) {
+        for (size_t so = 0; so < MAX_OFFSET; so++) {
+            size_t expected_len = reference(src + so, len, expected);
+            for (size_t dof = 0; dof < MAX_OFFSET; dof++) {
+                memset(out, CANARY, sizeof(out));
+                size_t got = encode(src + so, len, out + dof);
+                int ok = got == expected_len &&
+                         memcmp(out + dof, expected, expected_len) == 0;
+                for (size_t k = 0; ok && k < sizeof(out); k++) {
+                    if ((k < dof || k >= dof + expected_len) && (uint8_t)out[k] != CANARY) {
+                        ok = 0;
+                    }
+                }
+                if (!ok) {
+                    printf("  %s mismatch: len %zu, src offset %zu, dst offset %zu\n",
+                           what, len, so, dof);
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+static int test_rfc4648_vectors(void) {
+    TEST_START("RFC 4648 base64 vectors (default path)");
+    static const char *cases[][2] = {
+        {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="},
+        {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"},
+    };
+    ASSERT_TRUE(simd_encode_select(SIMD_ENCODER_AUTO) == 0, "automatic selection");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        char out[16];
+        size_t n = simd_encode_base64((const uint8_t *)cases[i][0], strlen(cases[i][0]), out);
+        ASSERT_TRUE(n == strlen(cases[i][1]) && memcmp(out, cases[i][1], n) == 0,
+                    cases[i][1]);
+    }
+    char hex[8];
+    ASSERT_TRUE(simd_encode_hex((const uint8_t *)"\x00\x9f\xff", 3, hex) == 6 &&
+                memcmp(hex, "009fff", 6) == 0, "hex vector");
+    TEST_PASS();
+}
+
+static int test_encoder_path(simd_encoder_t which, const char *name) {
+    char title[64];
+    snprintf(title, sizeof(title), "%s encoders match the reference", name);
+    if (simd_encode_select(which) != 0) {
+        tests_skipped++;
+        printf("\n[SKIP] %s (not available on this build or CPU)\n", title);
+        return 1;
+    }
+    TEST_START(title);
+    ASSERT_TRUE(compare_all(simd_encode_hex, reference_hex, "hex"), "hex output");
+    ASSERT_TRUE(compare_all(simd_encode_base64, reference_base64, "base64"), "base64 output");
+    TEST_PASS();
+}
+
+static int test_errors(void) {
+    TEST_START("Argument handling");
+    char out[8] = {0};
+    uint8_t in[1] = {0xAB};
+    ASSERT_TRUE(simd_encode_select((simd_encoder_t)99) != 0, "unknown encoder rejected");
+    ASSERT_TRUE(simd_encode_hex(NULL, 1, out) == 0, "NULL input");
+    ASSERT_TRUE(simd_encode_base64(in, 1, NULL) == 0, "NULL output");
+    ASSERT_TRUE(simd_encode_select(SIMD_ENCODER_AUTO) == 0, "automatic selection restored");
+    TEST_PASS();
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("SIMD ENCODER TESTS\n");
+    printf("========================================\n");
+
+    test_rfc4648_vectors();
+    for (size_t i = 0; i < sizeof(encoders) / sizeof(encoders[0]); i++) {
+        test_encoder_path(encoders[i].which, encoders[i].name);
+    }
+    test_errors();
+
+    printf("\n========================================\n");
+    printf("TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Total tests:  %d\n", tests_run);
+    printf("Passed:       %d\n", tests_passed);
+    printf("Failed:       %d\n", tests_failed);
+    printf("Skipped:      %d (encoder paths not available here)\n", tests_skipped);
+    printf("========================================\n");
+
+    return tests_failed == 0 ? 0 : 1;
+}
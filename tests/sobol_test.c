@@ -0,0 +1,389 @@
+/**
+ * @file sobol_test.c
+ * @brief Tests for the scrambled Sobol sequence and Brownian bridge
+ *
+ * Tests cover:
+ * - Unscrambled points matching the reference Joe-Kuo sequence
+ * - One-dimensional stratification and the two-dimensional (0,m,2)-net
+ *   property surviving scrambling keyed from secure_rng
+ * - Gray-code skip and clone agreeing with sequential generation
+ * - Scrambling as a deterministic function of the key
+ * - Inverse normal CDF accuracy
+ * - Brownian bridge covariance min(i, j)
+ * - Integration error against pseudo-random sampling
+ * - Argument validation and exhaustion
+ */
+
+#include "../src/qmc/sobol.h"
+#include "../src/secure_rng/secure_rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+#define TEST_START(name) \
+    do { \
+        tests_run++; \
+        printf("\n[TEST %d] %s\n", tests_run, name); \
+    } while(0)
+
+#define TEST_PASS() \
+    do { \
+        tests_passed++; \
+        printf("  ✓ PASSED\n"); \
+        return 1; \
+    } while(0)
+
+#define TEST_FAIL(msg) \
+    do { \
+        tests_failed++; \
+        printf("  ✗ FAILED: %s\n", msg); \
+        return 0; \
+    } while(0)
+
+#define ASSERT_TRUE(expr, msg) \
+    do { \
+        if (!(expr)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(a, b, msg) \
+    do { \
+        if ((a) != (b)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            printf("  Expected: %ld, Got: %ld\n", (long)(b), (long)(a)); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+// Point coordinates are (x + 0.5) / 2^32; recover x
+static uint32_t raw_bits(double u) {
+    return (uint32_t)(u * 4294967296.0);
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+static int test_known_points(void) {
+    TEST_START("Unscrambled points match the reference sequence");
+
+    static const double expected[8][2] = {
+        { 0.0,   0.0   }, { 0.5,   0.5   }, { 0.75,  0.25  }, { 0.25,  0.75  },
+        { 0.375, 0.375 }, { 0.875, 0.875 }, { 0.625, 0.125 }, { 0.125, 0.625 },
+    };
+
+    sobol_ctx_t *s;
+    ASSERT_EQ(sobol_init(&s, 2, NULL, 0), SOBOL_SUCCESS, "init");
+    for (int i = 0; i < 8; i++) {
+        double p[2];
+        sobol_next(s, p);
+        ASSERT_TRUE(fabs(p[0] - expected[i][0]) < 1e-9 &&
+                    fabs(p[1] - expected[i][1]) < 1e-9, "point differs from reference");
+    }
+    sobol_free(s);
+
+    // Dimension 3 (x^2 + x + 1, m = 1, 3): points 1..3 are 0.5, 0.25, 0.75
+    ASSERT_EQ(sobol_init(&s, 3, NULL, 0), SOBOL_SUCCESS, "init 3D");
+    double p[3], third[4];
+    for (int i = 0; i < 4; i++) {
+        sobol_next(s, p);
+        third[i] = p[2];
+    }
+    sobol_free(s);
+    ASSERT_TRUE(fabs(third[1] - 0.5) < 1e-9 && fabs(third[2] - 0.25) < 1e-9 &&
+                fabs(third[3] - 0.75) < 1e-9, "third dimension differs from reference");
+
+    TEST_PASS();
+}
+
+static int test_scrambled_stratification(void) {
+    TEST_START("Scrambling keyed from secure_rng keeps the net structure");
+
+    secure_rng_ctx_t *rng;
+    uint8_t key[32];
+    ASSERT_EQ(secure_rng_init(&rng), SECURE_RNG_SUCCESS, "secure_rng init");
+    ASSERT_EQ(secure_rng_bytes(rng, key, sizeof(key)), SECURE_RNG_SUCCESS, "key bytes");
+    secure_rng_free(rng);
+
+    const int m = 10;
+    const uint32_t n = 1u << m;
+    const uint32_t dims = SOBOL_MAX_DIMENSION;
+    sobol_ctx_t *s;
+    ASSERT_EQ(sobol_init(&s, dims, key, sizeof(key)), SOBOL_SUCCESS, "init");
+
+    uint32_t *bits = malloc((size_t)n * dims * sizeof(uint32_t));
+    double *p = malloc(dims * sizeof(double));
+    ASSERT_TRUE(bits && p, "allocation");
+    for (uint32_t i = 0; i < n; i++) {
+        sobol_next(s, p);
+        for (uint32_t d = 0; d < dims; d++) bits[(size_t)i * dims + d] = raw_bits(p[d]);
+    }
+    sobol_free(s);
+    free(p);
+
+    // Every coordinate: each of the 2^m intervals holds exactly one point
+    uint8_t *seen = malloc(n);
+    int ok = seen != NULL;
+    for (uint32_t d = 0; ok && d < dims; d++) {
+        memset(seen, 0, n);
+        for (uint32_t i = 0; i < n; i++) seen[bits[(size_t)i * dims + d] >> (32 - m)]++;
+        for (uint32_t b = 0; b < n; b++) ok &= seen[b] == 1;
+    }
+
+    // First two coordinates: every 2^k x 2^(m-k) box holds exactly one point
+    for (int k = 0; ok && k <= m; k++) {
+        memset(seen, 0, n);
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t x = k ? bits[(size_t)i * dims] >> (32 - k) : 0;
+            uint32_t y = k < m ? bits[(size_t)i * dims + 1] >> (32 - (m - k)) : 0;
+            seen[(x << (m - k)) | y]++;
+        }
+        for (uint32_t b = 0; b < n; b++) ok &= seen[b] == 1;
+    }
+    free(seen);
+    free(bits);
+    ASSERT_TRUE(ok, "stratification broken");
+    printf("  %u points x %u dimensions stratified\n", n, dims);
+
+    TEST_PASS();
+}
+
+static int test_skip_and_clone(void) {
+    TEST_START("Gray-code skip and clone match sequential generation");
+
+    const uint32_t dims = 64;
+    const uint8_t key[] = "skip-test";
+    sobol_ctx_t *seq, *jump, *copy;
+    ASSERT_EQ(sobol_init(&seq, dims, key, sizeof(key)), SOBOL_SUCCESS, "init");
+    ASSERT_EQ(sobol_init(&jump, dims, key, sizeof(key)), SOBOL_SUCCESS, "init");
+
+    double a[64], b[64];
+    for (uint32_t i = 0; i < 5000; i++) sobol_next(seq, a);
+    ASSERT_EQ(sobol_skip_to(jump, 5000), SOBOL_SUCCESS, "skip");
+    ASSERT_EQ(sobol_clone(seq, &copy), SOBOL_SUCCESS, "clone");
+
+    for (int i = 0; i < 100; i++) {
+        double c[64];
+        sobol_next(seq, a);
+        sobol_next(jump, b);
+        sobol_next(copy, c);
+        ASSERT_TRUE(memcmp(a, b, sizeof(a)) == 0, "skip_to differs from sequential");
+        ASSERT_TRUE(memcmp(a, c, sizeof(a)) == 0, "clone differs from original");
+    }
+    ASSERT_EQ(sobol_index(jump), 5100, "index after skip");
+
+    // Skipping backwards works too
+    ASSERT_EQ(sobol_skip_to(jump, 0), SOBOL_SUCCESS, "skip to 0");
+    sobol_next(jump, b);
+    ASSERT_EQ(raw_bits(b[0]) == raw_bits(a[0]), 0, "point 0 should differ from point 5099");
+
+    sobol_free(seq);
+    sobol_free(jump);
+    sobol_free(copy);
+    TEST_PASS();
+}
+
+static int test_scrambling_keys(void) {
+    TEST_START("Scrambling is a deterministic function of the key");
+
+    const uint8_t key1[] = "key one";
+    const uint8_t key2[] = "key two";
+    sobol_ctx_t *s1, *s1b, *s2, *plain;
+    sobol_init(&s1, 8, key1, sizeof(key1));
+    sobol_init(&s1b, 8, key1, sizeof(key1));
+    sobol_init(&s2, 8, key2, sizeof(key2));
+    sobol_init(&plain, 8, NULL, 0);
+
+    int same = 1, differ = 0, differ_plain = 0;
+    double sum = 0.0;
+    const int n = 4096;
+    for (int i = 0; i < n; i++) {
+        double a[8], b[8], c[8], d[8];
+        sobol_next(s1, a);
+        sobol_next(s1b, b);
+        sobol_next(s2, c);
+        sobol_next(plain, d);
+        same &= memcmp(a, b, sizeof(a)) == 0;
+        differ |= memcmp(a, c, sizeof(a)) != 0;
+        differ_plain |= memcmp(a, d, sizeof(a)) != 0;
+        for (int k = 0; k < 8; k++) sum += a[k];
+    }
+    sobol_free(s1);
+    sobol_free(s1b);
+    sobol_free(s2);
+    sobol_free(plain);
+
+    ASSERT_TRUE(same, "same key gave different points");
+    ASSERT_TRUE(differ, "different keys gave the same points");
+    ASSERT_TRUE(differ_plain, "scrambled points equal the plain sequence");
+    double mean = sum / (8.0 * n);
+    printf("  Mean coordinate: %.6f\n", mean);
+    ASSERT_TRUE(fabs(mean - 0.5) < 1e-3, "scrambled mean far from 0.5");
+
+    TEST_PASS();
+}
+
+static int test_inverse_normal(void) {
+    TEST_START("Inverse normal CDF accuracy");
+
+    double worst = 0.0;
+    static const double us[] = { 1e-12, 1e-8, 1e-4, 0.01, 0.02425, 0.1, 0.3, 0.5,
+                                 0.7, 0.9, 0.97575, 0.99, 0.9999, 1.0 - 1e-8 };
+    for (size_t i = 0; i < sizeof(us) / sizeof(us[0]); i++) {
+        double x = sobol_inverse_normal(us[i]);
+        double back = 0.5 * erfc(-x * M_SQRT1_2);
+        double rel = fabs(back - us[i]) / fmin(us[i], 1.0 - us[i]);
+        if (rel > worst) worst = rel;
+    }
+    printf("  Worst relative error of Phi(inverse(u)): %.2e\n", worst);
+    ASSERT_TRUE(worst < 1e-9, "inverse normal inaccurate");
+    ASSERT_TRUE(fabs(sobol_inverse_normal(0.5)) < 1e-15, "inverse(0.5) != 0");
+    ASSERT_TRUE(fabs(sobol_inverse_normal(0.975) - 1.959963984540054) < 1e-12,
+                "inverse(0.975) != 1.95996");
+
+    TEST_PASS();
+}
+
+static int test_bridge_covariance(void) {
+    TEST_START("Brownian bridge has Brownian covariance");
+
+    // The bridge is linear: W = A z. Brownian motion needs A A^T = min(i, j)
+    // (unit steps), which also makes the increments iid N(0,1).
+    const uint32_t n = 37;
+    sobol_bridge_t *bridge;
+    ASSERT_EQ(sobol_bridge_init(&bridge, n), SOBOL_SUCCESS, "bridge init");
+
+    double *a = calloc((size_t)n * n, sizeof(double));   // a[col * n + row] = W(row)
+    double z[37], dw[37];
+    ASSERT_TRUE(a != NULL, "allocation");
+    for (uint32_t col = 0; col < n; col++) {
+        memset(z, 0, sizeof(z));
+        z[col] = 1.0;
+        sobol_bridge_transform(bridge, z, dw);
+        double w = 0.0;
+        for (uint32_t row = 0; row < n; row++) {
+            w += dw[row];
+            a[(size_t)col * n + row] = w;
+        }
+    }
+
+    double worst = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        for (uint32_t j = 0; j < n; j++) {
+            double cov = 0.0;
+            for (uint32_t k = 0; k < n; k++) cov += a[(size_t)k * n + i] * a[(size_t)k * n + j];
+            double expected = (double)((i < j ? i : j) + 1);
+            if (fabs(cov - expected) > worst) worst = fabs(cov - expected);
+        }
+    }
+    free(a);
+
+    // z[0] alone sets the terminal value W(n) = sqrt(n) z[0]
+    memset(z, 0, sizeof(z));
+    z[0] = 1.0;
+    sobol_bridge_transform(bridge, z, dw);
+    double terminal = 0.0;
+    for (uint32_t i = 0; i < n; i++) terminal += dw[i];
+    sobol_bridge_free(bridge);
+
+    printf("  Max covariance error: %.2e\n", worst);
+    ASSERT_TRUE(worst < 1e-9, "bridge covariance wrong");
+    ASSERT_TRUE(fabs(terminal - sqrt((double)n)) < 1e-12, "terminal value wrong");
+
+    TEST_PASS();
+}
+
+static int test_integration_error(void) {
+    TEST_START("Integration error beats pseudo-random sampling");
+
+    // f(u) = prod_d (1 + (u_d - 0.5) / 2) has integral 1 over [0,1]^16 and
+    // variance (1 + 1/48)^16 - 1.
+    const uint32_t dims = 16;
+    const uint8_t key[] = "integration";
+    double variance = pow(1.0 + 1.0 / 48.0, dims) - 1.0;
+
+    printf("  %8s %12s %12s\n", "N", "QMC error", "MC std err");
+    double qmc_error = 0.0;
+    for (uint32_t n = 1024; n <= 65536; n *= 4) {
+        sobol_ctx_t *s;
+        sobol_init(&s, dims, key, sizeof(key));
+        double sum = 0.0, p[16];
+        for (uint32_t i = 0; i < n; i++) {
+            sobol_next(s, p);
+            double f = 1.0;
+            for (uint32_t d = 0; d < dims; d++) f *= 1.0 + 0.5 * (p[d] - 0.5);
+            sum += f;
+        }
+        sobol_free(s);
+        qmc_error = fabs(sum / n - 1.0);
+        printf("  %8u %12.2e %12.2e\n", n, qmc_error, sqrt(variance / n));
+    }
+    ASSERT_TRUE(qmc_error < 0.1 * sqrt(variance / 65536), "QMC error not below MC error");
+
+    TEST_PASS();
+}
+
+static int test_errors(void) {
+    TEST_START("Argument validation and exhaustion");
+
+    sobol_ctx_t *s;
+    ASSERT_EQ(sobol_init(&s, 0, NULL, 0), SOBOL_ERROR_INVALID_DIMENSION, "zero dimensions");
+    ASSERT_EQ(sobol_init(&s, SOBOL_MAX_DIMENSION + 1, NULL, 0), SOBOL_ERROR_INVALID_DIMENSION,
+              "too many dimensions");
+    ASSERT_EQ(sobol_init(&s, 2, NULL, 4), SOBOL_ERROR_NULL_POINTER, "NULL key with length");
+    ASSERT_EQ(sobol_init(NULL, 2, NULL, 0), SOBOL_ERROR_NULL_POINTER, "NULL ctx");
+
+    ASSERT_EQ(sobol_init(&s, 2, NULL, 0), SOBOL_SUCCESS, "init");
+    double p[2];
+    ASSERT_EQ(sobol_skip_to(s, 1ULL << 32), SOBOL_ERROR_EXHAUSTED, "skip past end");
+    ASSERT_EQ(sobol_skip_to(s, (1ULL << 32) - 1), SOBOL_SUCCESS, "skip to last");
+    ASSERT_EQ(sobol_next(s, p), SOBOL_SUCCESS, "last point");
+    ASSERT_EQ(sobol_next(s, p), SOBOL_ERROR_EXHAUSTED, "exhausted");
+    sobol_free(s);
+
+    sobol_bridge_t *bridge;
+    ASSERT_EQ(sobol_bridge_init(&bridge, 0), SOBOL_ERROR_INVALID_DIMENSION, "empty bridge");
+
+    TEST_PASS();
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    printf("========================================\n");
+    printf("SOBOL SEQUENCE TESTS\n");
+    printf("========================================\n");
+
+    test_known_points();
+    test_scrambled_stratification();
+    test_skip_and_clone();
+    test_scrambling_keys();
+    test_inverse_normal();
+    test_bridge_covariance();
+    test_integration_error();
+    test_errors();
+
+    printf("\n========================================\n");
+    printf("TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Total tests:  %d\n", tests_run);
+    printf("Passed:       %d\n", tests_passed);
+    printf("Failed:       %d\n", tests_failed);
+    printf("========================================\n");
+
+    return tests_failed == 0 ? 0 : 1;
+}
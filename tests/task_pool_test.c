@@ -0,0 +1,337 @@
+/**
+ * @file task_pool_test.c
+ * @brief Tests for the shared work-stealing task pool
+ *
+ * Tests cover:
+ * - Task groups: every task runs once and wait returns after the last
+ * - parallel_for coverage, including nested calls from inside tasks
+ * - Work stealing between internal workers
+ * - Pools without internal threads driven by application threads
+ * - Placement policies and configuration validation
+ * - Parallel gate kernels matching the serial result
+ */
+
+#include "../src/scheduler/task_pool.h"
+#include "../src/quantum_rng/quantum_state.h"
+#include "../src/quantum_rng/quantum_gates.h"
+#include "../src/quantum_rng/quantum_constants.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <complex.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+#define TEST_START(name) \
+    do { \
+        tests_run++; \
+        printf("\n[TEST %d] %s\n", tests_run, name); \
+    } while(0)
+
+#define TEST_PASS() \
+    do { \
+        tests_passed++; \
+        printf("  ✓ PASSED\n"); \
+        return 1; \
+    } while(0)
+
+#define TEST_FAIL(msg) \
+    do { \
+        tests_failed++; \
+        printf("  ✗ FAILED: %s\n", msg); \
+        return 0; \
+    } while(0)
+
+#define ASSERT_TRUE(expr, msg) \
+    do { \
+        if (!(expr)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+#define ASSERT_EQ(a, b, msg) \
+    do { \
+        if ((a) != (b)) { \
+            printf("  Assertion failed: %s\n", msg); \
+            printf("  Expected: %ld, Got: %ld\n", (long)(b), (long)(a)); \
+            TEST_FAIL(msg); \
+        } \
+    } while(0)
+
+static void pool_config(task_pool_config_t *config, size_t threads) {
+    task_pool_get_default_config(config);
+    config->num_threads = threads;
+    config->affinity = TASK_POOL_AFFINITY_NONE;
+}
+
+static void count_task(void *arg) {
+    __atomic_add_fetch((int *)arg, 1, __ATOMIC_RELAXED);
+}
+
+static void mark_range(void *arg, size_t begin, size_t end) {
+    int *hits = arg;
+    for (size_t i = begin; i < end; i++) __atomic_add_fetch(&hits[i], 1, __ATOMIC_RELAXED);
+}
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+int test_group_wait(void) {
+    TEST_START("Every task of a group runs once before wait returns");
+
+    task_pool_t *pool = NULL;
+    task_pool_config_t config;
+    pool_config(&config, 4);
+    ASSERT_EQ(task_pool_create(&pool, &config), TASK_POOL_SUCCESS, "Create should succeed");
+
+    int counter = 0;
+    task_group_t group = TASK_GROUP_INIT;
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_EQ(task_pool_submit(pool, &group, count_task, &counter), TASK_POOL_SUCCESS,
+                  "Submit should succeed");
+    }
+    task_pool_wait(pool, &group);
+    ASSERT_EQ(counter, 10000, "All tasks should have run");
+    ASSERT_EQ(group.pending, 0, "Group should be empty");
+
+    task_pool_stats_t stats;
+    task_pool_get_stats(pool, &stats);
+    ASSERT_EQ(stats.executed, 10000, "Executed count");
+    ASSERT_EQ(stats.threads, 4, "Thread count");
+    task_pool_free(pool);
+    TEST_PASS();
+}
+
+typedef struct {
+    task_pool_t *pool;
+    int *hits;
+    size_t inner;
+} nested_t;
+
+static void nested_outer(void *arg, size_t begin, size_t end) {
+    nested_t *n = arg;
+    for (size_t i = begin; i < end; i++) {
+        task_pool_parallel_for(n->pool, n->inner, 7, mark_range, n->hits + i * n->inner);
+    }
+}
+
+int test_parallel_for(void) {
+    TEST_START("parallel_for covers the range exactly once, also when nested");
+
+    task_pool_t *pool = NULL;
+    task_pool_config_t config;
+    pool_config(&config, 3);
+    ASSERT_EQ(task_pool_create(&pool, &config), TASK_POOL_SUCCESS, "Create should succeed");
+
+    size_t n = 100003;
+    int *hits = calloc(n, sizeof(int));
+    task_pool_parallel_for(pool, n, 1000, mark_range, hits);
+    for (size_t i = 0; i < n; i++) ASSERT_EQ(hits[i], 1, "Each index exactly once");
+
+    // Outer tasks waiting on inner loops must help rather than block
+    nested_t nested = { pool, calloc(64 * 100, sizeof(int)), 100 };
+    task_pool_parallel_for(pool, 64, 1, nested_outer, &nested);
+    for (size_t i = 0; i < 64 * 100; i++) ASSERT_EQ(nested.hits[i], 1, "Nested coverage");
+
+    free(hits);
+    free(nested.hits);
+    task_pool_free(pool);
+    TEST_PASS();
+}
+
+typedef struct {
+    task_pool_t *pool;
+    task_group_t *group;
+    int *counter;
+} spawner_t;
+
+static void slow_task(void *arg) {
+    usleep(2000);
+    count_task(arg);
+}
+
+static void spawner_task(void *arg) {
+    spawner_t *s = arg;
+    // Tasks submitted from a worker land in its own deque; others must steal
+    for (int i = 0; i < 32; i++) task_pool_submit(s->pool, s->group, slow_task, s->counter);
+}
+
+int test_work_stealing(void) {
+    TEST_START("Idle workers steal tasks spawned on another worker");
+
+    task_pool_t *pool = NULL;
+    task_pool_config_t config;
+    pool_config(&config, 4);
+    ASSERT_EQ(task_pool_create(&pool, &config), TASK_POOL_SUCCESS, "Create should succeed");
+
+    int counter = 0;
+    task_group_t group = TASK_GROUP_INIT;
+    spawner_t spawner = { pool, &group, &counter };
+    task_pool_submit(pool, &group, spawner_task, &spawner);
+    task_pool_wait(pool, &group);
+    ASSERT_EQ(counter, 32, "All spawned tasks should run");
+
+    task_pool_stats_t stats;
+    task_pool_get_stats(pool, &stats);
+    printf("  steals %llu, helped %llu\n",
+           (unsigned long long)stats.steals, (unsigned long long)stats.helped);
+    ASSERT_TRUE(stats.steals + stats.helped > 0, "Spawned tasks should be taken by other threads");
+    task_pool_free(pool);
+    TEST_PASS();
+}
+
+static void* lend_thread(void *arg) {
+    return (void *)(intptr_t)task_pool_run_external((task_pool_t *)arg);
+}
+
+int test_external_threads(void) {
+    TEST_START("A pool without internal threads runs on lent application threads");
+
+    task_pool_t *pool = NULL;
+    task_pool_config_t config;
+    pool_config(&config, 0);
+    config.external_slots = 2;
+    ASSERT_EQ(task_pool_create(&pool, &config), TASK_POOL_SUCCESS, "Create should succeed");
+    ASSERT_EQ(task_pool_num_threads(pool), 0, "No threads before lending");
+
+    pthread_t lent[2];
+    for (int i = 0; i < 2; i++) pthread_create(&lent[i], NULL, lend_thread, pool);
+    while (task_pool_num_threads(pool) < 2) usleep(1000);
+    ASSERT_EQ(task_pool_run_external(pool), TASK_POOL_ERROR_NO_SLOT, "Only two slots");
+
+    int counter = 0;
+    task_group_t group = TASK_GROUP_INIT;
+    for (int i = 0; i < 1000; i++) task_pool_submit(pool, &group, count_task, &counter);
+    task_pool_wait(pool, &group);
+    ASSERT_EQ(counter, 1000, "Tasks should run on lent threads");
+
+    task_pool_release_external(pool);
+    for (int i = 0; i < 2; i++) {
+        void *rc;
+        pthread_join(lent[i], &rc);
+        ASSERT_EQ((intptr_t)rc, TASK_POOL_SUCCESS, "Lent thread returns after release");
+    }
+    ASSERT_EQ(task_pool_num_threads(pool), 0, "Threads returned");
+
+    // Without any thread, waiting runs the tasks on the caller
+    group.pending = 0;
+    counter = 0;
+    for (int i = 0; i < 10; i++) task_pool_submit(pool, &group, count_task, &counter);
+    task_pool_wait(pool, &group);
+    ASSERT_EQ(counter, 10, "Waiter runs queued tasks itself");
+    task_pool_free(pool);
+    TEST_PASS();
+}
+
+int test_placement_and_config(void) {
+    TEST_START("Placement policies create working pools; bad configs are rejected");
+
+    task_pool_affinity_t policies[] = {
+        TASK_POOL_AFFINITY_NONE, TASK_POOL_AFFINITY_NODE,
+        TASK_POOL_AFFINITY_COMPACT, TASK_POOL_AFFINITY_SCATTER
+    };
+    for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+        task_pool_t *pool = NULL;
+        task_pool_config_t config;
+        pool_config(&config, 2);
+        config.affinity = policies[p];
+        ASSERT_EQ(task_pool_create(&pool, &config), TASK_POOL_SUCCESS, "Create should succeed");
+        ASSERT_TRUE(task_pool_num_nodes(pool) >= 1, "At least one node");
+        int hits[5000] = {0};
+        task_pool_parallel_for(pool, 5000, 100, mark_range, hits);
+        for (size_t i = 0; i < 5000; i++) ASSERT_EQ(hits[i], 1, "Coverage under every policy");
+        task_pool_free(pool);
+    }
+
+    task_pool_t *pool = NULL;
+    task_pool_config_t config;
+    pool_config(&config, 0);
+    config.external_slots = 0;
+    ASSERT_EQ(task_pool_create(&pool, &config), TASK_POOL_ERROR_INVALID_PARAM,
+              "A pool needs at least one possible thread");
+    ASSERT_TRUE(pool == NULL, "No pool on failure");
+    ASSERT_TRUE(task_pool_default() != NULL, "Default pool exists");
+    ASSERT_EQ(task_pool_set_default(task_pool_default()), TASK_POOL_ERROR_ALREADY_SET,
+              "Default cannot be replaced once in use");
+    ASSERT_EQ(task_pool_current_node(), -1, "Main thread is not a worker");
+    TEST_PASS();
+}
+
+int test_parallel_gates(void) {
+    TEST_START("Parallel gate kernels match the serial result");
+
+    // 2^19 amplitudes is above the parallel threshold
+    quantum_state_t a, b;
+    ASSERT_EQ(quantum_state_init(&a, 19), QS_SUCCESS, "State init");
+    ASSERT_EQ(quantum_state_init(&b, 19), QS_SUCCESS, "State init");
+    for (int q = 0; q < 19; q++) gate_hadamard(&a, q);
+    gate_pauli_x(&a, 3);
+    const complex_t ry[2][2] = { { 0.6, -0.8 }, { 0.8, 0.6 } };
+    apply_single_qubit_gate(&a, 18, ry);
+
+    // Reference: the same gates applied pairwise on one thread
+    double amp = 1.0;
+    for (int q = 0; q < 19; q++) amp *= QC_SQRT2_INV;
+    for (uint64_t i = 0; i < b.state_dim; i++) b.amplitudes[i] = amp;
+    for (uint64_t i = 0; i < b.state_dim; i++) {
+        if (i & (1ULL << 18)) continue;
+        complex_t a0 = b.amplitudes[i], a1 = b.amplitudes[i | (1ULL << 18)];
+        b.amplitudes[i] = ry[0][0] * a0 + ry[0][1] * a1;
+        b.amplitudes[i | (1ULL << 18)] = ry[1][0] * a0 + ry[1][1] * a1;
+    }
+
+    double max_err = 0.0;
+    for (uint64_t i = 0; i < a.state_dim; i++) {
+        double err = cabs(a.amplitudes[i] - b.amplitudes[i]);
+        if (err > max_err) max_err = err;
+    }
+    printf("  pool threads %zu, max error %.3g\n", task_pool_num_threads(task_pool_default()), max_err);
+    ASSERT_TRUE(max_err < 1e-12, "Amplitudes should match");
+    quantum_state_free(&a);
+    quantum_state_free(&b);
+    TEST_PASS();
+}
+
+int main(void) {
+    printf("========================================\n");
+    printf("TASK POOL TESTS\n");
+    printf("========================================\n");
+
+    // A multi-threaded default pool exercises the parallel gate path on any host
+    task_pool_t *shared = NULL;
+    task_pool_config_t config;
+    pool_config(&config, 4);
+    if (task_pool_create(&shared, &config) != TASK_POOL_SUCCESS ||
+        task_pool_set_default(shared) != TASK_POOL_SUCCESS) {
+        printf("Could not install the default pool\n");
+        return 1;
+    }
+
+    test_group_wait();
+    test_parallel_for();
+    test_work_stealing();
+    test_external_threads();
+    test_placement_and_config();
+    test_parallel_gates();
+
+    printf("\n========================================\n");
+    printf("TEST SUMMARY\n");
+    printf("========================================\n");
+    printf("Total tests:  %d\n", tests_run);
+    printf("Passed:       %d\n", tests_passed);
+    printf("Failed:       %d\n", tests_failed);
+    printf("========================================\n");
+
+    return tests_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,367 @@
+/**
+ * @file thread_scaling_benchmark.c
+ * @brief Multi-threaded contention and scaling benchmark
+ *
+ * thread_safety_test.c checks correctness under concurrency; this measures
+ * how throughput scales. For 1..N threads and request sizes from 4 B to 1 MB
+ * it drives:
+ * - one shared secure_rng context (secure_rng_init_threadsafe)
+ * - one shared entropy_pool_ctx_t
+ * - per-thread qrng_v3 contexts (no sharing; the scaling ceiling)
+ *
+ * Reported per cell: aggregate throughput, worst per-thread p99 latency and
+ * scaling efficiency (throughput(N) / (N * throughput(1))). When the library
+ * is built with `make LOCK_STATS=1`, lock wait statistics are added so the
+ * table shows which lock stops scaling.
+ */
+
+#include "../src/secure_rng/secure_rng.h"
+#include "../src/entropy/entropy_pool.h"
+#include "../src/quantum_rng/quantum_rng_v3.h"
+#include "../src/common/lock_stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_THREADS 256
+#define LATENCY_SAMPLES 8192
+#define DEFAULT_CELL_MS 200
+
+typedef enum {
+    TARGET_SECURE_RNG = 0,
+    TARGET_ENTROPY_POOL,
+    TARGET_QRNG_V3,
+    TARGET_COUNT
+} scaling_target_t;
+
+static const char *target_names[TARGET_COUNT] = {
+    "secure_rng (shared, thread-safe)",
+    "entropy_pool (shared)",
+    "qrng_v3 (per-thread contexts)"
+};
+
+static const size_t default_sizes[] = {4, 64, 1024, 16384, 262144, 1048576};
+
+/**
+ * @brief Per-thread worker state
+ */
+typedef struct {
+    scaling_target_t target;
+    void *ctx;                        /**< Shared or per-thread engine */
+    size_t size;
+    uint8_t *buffer;
+    double *latencies_ns;             /**< Ring of recent per-op latencies */
+    uint64_t ops;
+    uint64_t errors;
+    double p99_ns;
+} worker_t;
+
+// Start gate: workers block until every thread is created and primed
+static pthread_mutex_t gate_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gate_cond = PTHREAD_COND_INITIALIZER;
+static int gate_open = 0;
+static int workers_ready = 0;
+static volatile int stop_flag = 0;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static int do_request(worker_t *w) {
+    switch (w->target) {
+        case TARGET_SECURE_RNG:
+            return secure_rng_bytes((secure_rng_ctx_t *)w->ctx, w->buffer, w->size) == SECURE_RNG_SUCCESS ? 0 : -1;
+        case TARGET_ENTROPY_POOL:
+            return entropy_pool_get_bytes((entropy_pool_ctx_t *)w->ctx, w->buffer, w->size);
+        case TARGET_QRNG_V3:
+            return qrng_v3_bytes((qrng_v3_ctx_t *)w->ctx, w->buffer, w->size) == QRNG_V3_SUCCESS ? 0 : -1;
+        default:
+            return -1;
+    }
+}
+
+static void* worker_main(void *arg) {
+    worker_t *w = (worker_t *)arg;
+
+    // Prime lazily-filled buffers (qrng_v3 output buffer) outside the window
+    if (do_request(w) != 0) w->errors++;
+
+    pthread_mutex_lock(&gate_mutex);
+    workers_ready++;
+    pthread_cond_broadcast(&gate_cond);
+    while (!gate_open) {
+        pthread_cond_wait(&gate_cond, &gate_mutex);
+    }
+    pthread_mutex_unlock(&gate_mutex);
+
+    // At least one request per thread, even when a single op outlasts the cell
+    do {
+        double start = now_ns();
+        if (do_request(w) != 0) w->errors++;
+        w->latencies_ns[w->ops % LATENCY_SAMPLES] = now_ns() - start;
+        w->ops++;
+    } while (!stop_flag);
+
+    size_t n = w->ops < LATENCY_SAMPLES ? (size_t)w->ops : LATENCY_SAMPLES;
+    qsort(w->latencies_ns, n, sizeof(double), cmp_double);
+    size_t idx = (size_t)(0.99 * (double)(n - 1));
+    w->p99_ns = w->latencies_ns[idx];
+    return NULL;
+}
+
+/**
+ * @brief Snapshot of the lock that guards the target's shared state
+ */
+static void target_lock_stats(scaling_target_t target, void *shared, qrng_lock_stats_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (target == TARGET_SECURE_RNG && shared) {
+        secure_rng_get_lock_stats((secure_rng_ctx_t *)shared, out);
+    } else if (target == TARGET_ENTROPY_POOL && shared) {
+        entropy_pool_get_lock_stats((entropy_pool_ctx_t *)shared, out, NULL);
+    }
+}
+
+typedef struct {
+    double mbps;
+    double ops_per_sec;
+    double p99_us;
+    uint64_t errors;
+    uint64_t ops;
+    double contended_pct;
+    double wait_ns_per_op;
+} cell_result_t;
+
+static int run_cell(scaling_target_t target, void *shared, qrng_v3_ctx_t **per_thread,
+                    int threads, size_t size, int cell_ms, cell_result_t *res) {
+    worker_t workers[MAX_THREADS];
+    pthread_t tids[MAX_THREADS];
+    qrng_lock_stats_t before, after;
+    int created = 0;
+
+    memset(res, 0, sizeof(*res));
+    memset(workers, 0, sizeof(workers));
+
+    for (int t = 0; t < threads; t++) {
+        workers[t].target = target;
+        workers[t].ctx = target == TARGET_QRNG_V3 ? (void *)per_thread[t] : shared;
+        workers[t].size = size;
+        workers[t].buffer = malloc(size);
+        workers[t].latencies_ns = malloc(LATENCY_SAMPLES * sizeof(double));
+        if (!workers[t].buffer || !workers[t].latencies_ns) {
+            for (int i = 0; i <= t; i++) {
+                free(workers[i].buffer);
+                free(workers[i].latencies_ns);
+            }
+            return -1;
+        }
+    }
+
+    gate_open = 0;
+    workers_ready = 0;
+    stop_flag = 0;
+    for (; created < threads; created++) {
+        if (pthread_create(&tids[created], NULL, worker_main, &workers[created]) != 0) break;
+    }
+
+    pthread_mutex_lock(&gate_mutex);
+    while (workers_ready < created) {
+        pthread_cond_wait(&gate_cond, &gate_mutex);
+    }
+    target_lock_stats(target, shared, &before);
+    double start = now_ns();
+    gate_open = 1;
+    pthread_cond_broadcast(&gate_cond);
+    pthread_mutex_unlock(&gate_mutex);
+
+    usleep((useconds_t)cell_ms * 1000);
+    stop_flag = 1;
+
+    for (int t = 0; t < created; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    double elapsed_s = (now_ns() - start) / 1e9;
+    target_lock_stats(target, shared, &after);
+
+    double worst_p99 = 0.0;
+    for (int t = 0; t < created; t++) {
+        res->ops += workers[t].ops;
+        res->errors += workers[t].errors;
+        if (workers[t].p99_ns > worst_p99) worst_p99 = workers[t].p99_ns;
+        free(workers[t].buffer);
+        free(workers[t].latencies_ns);
+    }
+    for (int t = created; t < threads; t++) {
+        free(workers[t].buffer);
+        free(workers[t].latencies_ns);
+    }
+    if (created < threads) return -1;
+
+    res->ops_per_sec = (double)res->ops / elapsed_s;
+    res->mbps = res->ops_per_sec * (double)size / (1024.0 * 1024.0);
+    res->p99_us = worst_p99 / 1000.0;
+
+    uint64_t acq = after.acquisitions - before.acquisitions;
+    if (acq > 0) {
+        res->contended_pct = 100.0 * (double)(after.contended - before.contended) / (double)acq;
+    }
+    if (res->ops > 0) {
+        res->wait_ns_per_op = (double)(after.wait_ns_total - before.wait_ns_total) / (double)res->ops;
+    }
+    return 0;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  --threads N     Maximum thread count (default: online CPUs, min 4)\n");
+    printf("  --ms N          Duration of each cell in ms (default %d)\n", DEFAULT_CELL_MS);
+    printf("  --size BYTES    Run a single request size instead of 4 B..1 MB\n");
+    printf("  --target NAME   secure_rng, entropy_pool or qrng_v3 (default all)\n");
+}
+
+int main(int argc, char **argv) {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = ncpu > 4 ? (int)ncpu : 4;
+    int cell_ms = DEFAULT_CELL_MS;
+    size_t single_size = 0;
+    int only_target = -1;
+
+    for (int i = 1; i < argc; i++) {
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--threads") == 0 && val) { max_threads = atoi(val); i++; }
+        else if (strcmp(argv[i], "--ms") == 0 && val) { cell_ms = atoi(val); i++; }
+        else if (strcmp(argv[i], "--size") == 0 && val) { single_size = (size_t)strtoull(val, NULL, 10); i++; }
+        else if (strcmp(argv[i], "--target") == 0 && val) {
+            if (strcmp(val, "secure_rng") == 0) only_target = TARGET_SECURE_RNG;
+            else if (strcmp(val, "entropy_pool") == 0) only_target = TARGET_ENTROPY_POOL;
+            else if (strcmp(val, "qrng_v3") == 0) only_target = TARGET_QRNG_V3;
+            else { print_usage(argv[0]); return 2; }
+            i++;
+        } else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+    if (max_threads < 1) max_threads = 1;
+    if (max_threads > MAX_THREADS) max_threads = MAX_THREADS;
+    if (cell_ms < 10) cell_ms = 10;
+
+    size_t sizes[sizeof(default_sizes) / sizeof(default_sizes[0])];
+    size_t num_sizes = 0;
+    if (single_size > 0) {
+        sizes[num_sizes++] = single_size;
+    } else {
+        memcpy(sizes, default_sizes, sizeof(default_sizes));
+        num_sizes = sizeof(default_sizes) / sizeof(default_sizes[0]);
+    }
+
+    // Thread counts: 1, 2, 4, ... up to max_threads (always including it)
+    int thread_counts[16];
+    int num_counts = 0;
+    for (int t = 1; t < max_threads && num_counts < 15; t *= 2) {
+        thread_counts[num_counts++] = t;
+    }
+    thread_counts[num_counts++] = max_threads;
+
+    printf("╔══════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║                  QUANTUM RNG THREAD SCALING BENCHMARK                        ║\n");
+    printf("╚══════════════════════════════════════════════════════════════════════════════╝\n");
+    printf("  online CPUs=%ld  max threads=%d  cell=%dms  lock stats=%s\n",
+           ncpu, max_threads, cell_ms,
+           QRNG_LOCK_STATS_ENABLED ? "on" : "off (build with make LOCK_STATS=1)");
+
+    int failures = 0;
+    for (int target = 0; target < TARGET_COUNT; target++) {
+        if (only_target >= 0 && target != only_target) continue;
+
+        void *shared = NULL;
+        qrng_v3_ctx_t *per_thread[MAX_THREADS] = {0};
+
+        if (target == TARGET_SECURE_RNG) {
+            secure_rng_ctx_t *ctx = NULL;
+            if (secure_rng_init_threadsafe(&ctx) != SECURE_RNG_SUCCESS) {
+                printf("\n  %s: init failed\n", target_names[target]);
+                failures++;
+                continue;
+            }
+            shared = ctx;
+        } else if (target == TARGET_ENTROPY_POOL) {
+            entropy_pool_ctx_t *pool = NULL;
+            if (entropy_pool_init(&pool) != 0) {
+                printf("\n  %s: init failed\n", target_names[target]);
+                failures++;
+                continue;
+            }
+            shared = pool;
+        } else {
+            int ok = 1;
+            for (int t = 0; t < max_threads && ok; t++) {
+                ok = qrng_v3_init(&per_thread[t]) == QRNG_V3_SUCCESS;
+            }
+            if (!ok) {
+                for (int t = 0; t < max_threads; t++) qrng_v3_free(per_thread[t]);
+                printf("\n  %s: init failed\n", target_names[target]);
+                failures++;
+                continue;
+            }
+        }
+
+        printf("\n  %s\n", target_names[target]);
+        printf("  %9s %7s %11s %12s %11s %7s", "Size", "Threads", "MB/s", "ops/s", "p99 (us)", "Eff");
+        if (QRNG_LOCK_STATS_ENABLED && target != TARGET_QRNG_V3) {
+            printf(" %10s %12s", "Contended", "Wait/op(ns)");
+        }
+        printf("\n");
+
+        for (size_t s = 0; s < num_sizes; s++) {
+            double base_ops = 0.0;
+            for (int c = 0; c < num_counts; c++) {
+                cell_result_t res;
+                int threads = thread_counts[c];
+                if (run_cell((scaling_target_t)target, shared, per_thread, threads,
+                             sizes[s], cell_ms, &res) != 0) {
+                    printf("  %9zu %7d   cell failed\n", sizes[s], threads);
+                    failures++;
+                    continue;
+                }
+                if (c == 0) base_ops = res.ops_per_sec / threads;
+                double eff = base_ops > 0 ? 100.0 * res.ops_per_sec / (threads * base_ops) : 0.0;
+
+                printf("  %9zu %7d %11.2f %12.0f %11.1f %6.1f%%",
+                       sizes[s], threads, res.mbps, res.ops_per_sec, res.p99_us, eff);
+                if (QRNG_LOCK_STATS_ENABLED && target != TARGET_QRNG_V3) {
+                    printf(" %9.1f%% %12.0f", res.contended_pct, res.wait_ns_per_op);
+                }
+                if (res.errors > 0) {
+                    printf("  (%llu errors)", (unsigned long long)res.errors);
+                    failures++;
+                }
+                printf("\n");
+                fflush(stdout);
+            }
+        }
+
+        if (target == TARGET_SECURE_RNG) {
+            secure_rng_free((secure_rng_ctx_t *)shared);
+        } else if (target == TARGET_ENTROPY_POOL) {
+            entropy_pool_free((entropy_pool_ctx_t *)shared);
+        } else {
+            for (int t = 0; t < max_threads; t++) qrng_v3_free(per_thread[t]);
+        }
+    }
+
+    if (ncpu < max_threads) {
+        printf("\n  Note: %d threads on %ld CPUs - efficiency beyond %ld threads reflects\n"
+               "  time-slicing, not lock contention.\n", max_threads, ncpu, ncpu);
+    }
+    return failures ? 1 : 0;
+}